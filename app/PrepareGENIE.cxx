@@ -1,5 +1,6 @@
 #include "FitLogger.h"
 #include "PlotUtils.h"
+#include "PrepareUtils.h"
 #include "TFile.h"
 #include "TH1D.h"
 #include "TTree.h"
@@ -25,6 +26,8 @@ double MonoEnergy;
 int gNEvents = -999;
 bool IsMonoE = false;
 bool useNOvAWeights = false;
+int gNWorkers = 1;
+std::string gWorkDir = "";
 
 void PrintOptions();
 void ParseOptions(int argc, char *argv[]);
@@ -33,6 +36,12 @@ void RunGENIEPrepareMono(std::string input, std::string target,
 void RunGENIEPrepare(std::string input, std::string flux, std::string target,
                      std::string output);
 bool CheckConfig(std::string filename);
+void FillModeHists(TChain *tn, TH1D *xsechist, int nevt, TH1D *eventhist,
+                   std::map<std::string, TH1D *> &modexsec,
+                   std::map<std::string, TH1D *> &modecount,
+                   std::vector<std::string> &genieids,
+                   std::vector<std::string> &targetids,
+                   std::vector<std::string> &interids);
 
 int main(int argc, char *argv[]) {
   ParseOptions(argc, argv);
@@ -85,6 +94,89 @@ bool CheckConfig(std::string filename) {
   return ShouldScale;
 }
 
+// Fills the "event" histogram and one "xsec;<mode>" and "count;<mode>"
+// histogram per GENIE interaction summary string
+class GENIEFiller : public PrepareUtils::EventFiller {
+public:
+  GENIEFiller() : genientpl(NULL) {}
+
+  void SetBranchAddresses(TTree *tree) {
+    StopTalking();
+    genientpl = NULL;
+    tree->SetBranchAddress("gmcrec", &genientpl);
+    StartTalking();
+  }
+
+  void Fill(PrepareUtils::PartialHists &hists) {
+    // Hussssch GENIE
+    StopTalking();
+    EventRecord &event = *(genientpl->event);
+    GHepParticle *neu = event.Probe();
+    StartTalking();
+
+    // Get XSec From Spline
+    GHepRecord genie_record = static_cast<GHepRecord>(event);
+    double xsec = (genie_record.XSec() / (1E-38 * genie::units::cm2));
+    std::string mode = genie_record.Summary()->AsString();
+
+    hists.Get("event")->Fill(neu->E());
+    hists.Get("xsec;" + mode)->Fill(neu->E(), xsec);
+    hists.Get("count;" + mode)->Fill(neu->E());
+
+    // Clear Event
+    genientpl->Clear();
+  }
+
+  std::string GetDescription() const { return "GENIE"; }
+
+private:
+  NtpMCEventRecord *genientpl;
+};
+
+// Run the event loop over nevt entries of tn (all if < 0) and unpack the
+// merged histograms into the per-mode maps, keeping GENIE's first-seen
+// mode order.
+void FillModeHists(TChain *tn, TH1D *xsechist, int nevt, TH1D *eventhist,
+                   std::map<std::string, TH1D *> &modexsec,
+                   std::map<std::string, TH1D *> &modecount,
+                   std::vector<std::string> &genieids,
+                   std::vector<std::string> &targetids,
+                   std::vector<std::string> &interids) {
+  GENIEFiller filler;
+  PrepareUtils::PartialHists *hists = PrepareUtils::FillHistograms(
+      tn, filler, xsechist, gNWorkers, gWorkDir, nevt);
+
+  eventhist->Add(hists->Get("event"));
+
+  std::vector<std::string> const &names = hists->GetNames();
+  for (size_t i = 0; i < names.size(); ++i) {
+    if (names[i].compare(0, 5, "xsec;"))
+      continue;
+    std::string mode = names[i].substr(5);
+
+    // Parse Interaction String
+    std::vector<std::string> modevec = GeneralUtils::ParseToStr(mode, ";");
+    std::string targ = (modevec[0] + ";" + modevec[1]);
+
+    // Fill lists of Unique IDS (neutrino and target)
+    if (std::find(targetids.begin(), targetids.end(), targ) ==
+        targetids.end()) {
+      targetids.push_back(targ);
+    }
+    // The full interaction list
+    interids.push_back(mode);
+    genieids.push_back(mode);
+
+    modexsec[mode] = hists->Get(names[i]);
+    modecount[mode] = hists->Get("count;" + mode);
+
+    modexsec[mode]->GetYaxis()->SetTitle(
+        "d#sigma/dE_{#nu} #times 10^{-38} (events weighted by #sigma)");
+    modecount[mode]->GetYaxis()->SetTitle("Number of events in file");
+  }
+  NUIS_LOG(FIT, "Processed all events");
+}
+
 void RunGENIEPrepareMono(std::string input, std::string target,
     std::string output) {
 
@@ -131,11 +223,6 @@ void RunGENIEPrepareMono(std::string input, std::string target,
     NUIS_LOG(FIT, "Found " << nevt << " input entries in " << input);
   }
 
-  StopTalking();
-  NtpMCEventRecord *genientpl = NULL;
-  tn->SetBranchAddress("gmcrec", &genientpl);
-  StartTalking();
-
   // Have the TH1D go from MonoEnergy/2 to MonoEnergy/2
   TH1D *fluxhist =
     new TH1D("flux", "flux", 1000, MonoEnergy / 2., MonoEnergy * 2.);
@@ -155,65 +242,8 @@ void RunGENIEPrepareMono(std::string input, std::string target,
   std::vector<std::string> targetids;
   std::vector<std::string> interids;
 
-  // Loop over all events
-  for (int i = 0; i < nevt; i++) {
-    tn->GetEntry(i);
-
-    StopTalking();
-    EventRecord &event = *(genientpl->event);
-    GHepParticle *neu = event.Probe();
-    StartTalking();
-
-    // Get XSec From Spline
-    GHepRecord genie_record = static_cast<GHepRecord>(event);
-    double xsec = (genie_record.XSec() / (1E-38 * genie::units::cm2));
-
-    // Parse Interaction String
-    std::string mode = genie_record.Summary()->AsString();
-    std::vector<std::string> modevec = GeneralUtils::ParseToStr(mode, ";");
-    std::string targ = (modevec[0] + ";" + modevec[1]);
-    std::string inter = mode;
-
-    // Fill lists of Unique IDS
-    if (std::find(targetids.begin(), targetids.end(), targ) ==
-        targetids.end()) {
-      targetids.push_back(targ);
-    }
-
-    if (std::find(interids.begin(), interids.end(), inter) == interids.end()) {
-      interids.push_back(inter);
-    }
-
-    // Create entries Mode Maps
-    if (modexsec.find(mode) == modexsec.end()) {
-      genieids.push_back(mode);
-
-      modexsec[mode] = (TH1D *)xsechist->Clone();
-      modecount[mode] = (TH1D *)xsechist->Clone();
-
-      modexsec[mode]->GetYaxis()->SetTitle(
-          "d#sigma/dE_{#nu} #times 10^{-38} (events weighted by #sigma)");
-      modecount[mode]->GetYaxis()->SetTitle("Number of events in file");
-    }
-
-    // Fill XSec Histograms
-    modexsec[mode]->Fill(neu->E(), xsec);
-    modecount[mode]->Fill(neu->E());
-
-    // Fill total event hist
-    eventhist->Fill(neu->E());
-
-    // Clear Event
-    genientpl->Clear();
-
-    size_t freq = nevt / 20;
-    if (freq && !(i % freq)) {
-      NUIS_LOG(FIT, "Processed "
-          << i << "/" << nevt << " GENIE events (E: " << neu->E()
-          << " GeV, xsec: " << xsec << " E-38 cm^2/nucleon)");
-    }
-  }
-  NUIS_LOG(FIT, "Processed all events");
+  FillModeHists(tn, xsechist, gNEvents != -999 ? nevt : -1, eventhist,
+                modexsec, modecount, genieids, targetids, interids);
 
   // Check if we need to correct MEC events before possibly deleting the TChain below
   bool MECcorrect = CheckConfig(std::string(tn->GetFile()->GetName()));
@@ -563,11 +593,6 @@ void RunGENIEPrepare(std::string input, std::string flux, std::string target,
     NUIS_LOG(FIT, "Found " << nevt << " input entries in " << input);
   }
 
-  StopTalking();
-  NtpMCEventRecord *genientpl = NULL;
-  tn->SetBranchAddress("gmcrec", &genientpl);
-  StartTalking();
-
   // Make Event and xsec Hist
   TH1D *eventhist = (TH1D *)fluxhist->Clone();
   eventhist->SetDirectory(NULL);
@@ -582,77 +607,8 @@ void RunGENIEPrepare(std::string input, std::string flux, std::string target,
   std::vector<std::string> targetids;
   std::vector<std::string> interids;
 
-  // Loop over all events
-  for (int i = 0; i < nevt; i++) {
-    tn->GetEntry(i);
-
-    // Hussssch GENIE
-    StopTalking();
-    // Get the event
-    EventRecord &event = *(genientpl->event);
-    // Get the neutrino
-    GHepParticle *neu = event.Probe();
-    StartTalking();
-
-    // Get XSec From Spline
-    // Get the GHepRecord
-    GHepRecord genie_record = static_cast<GHepRecord>(event);
-    double xsec = (genie_record.XSec() / (1E-38 * genie::units::cm2));
-
-    // Parse Interaction String
-    std::string mode = genie_record.Summary()->AsString();
-    std::vector<std::string> modevec = GeneralUtils::ParseToStr(mode, ";");
-    std::string targ = (modevec[0] + ";" + modevec[1]);
-    std::string inter = mode;
-
-    // Get target nucleus
-    // Alternative ways of getting the summaries
-    // GHepParticle *target = genie_record.TargetNucleus();
-    // int pdg = target->Pdg();
-
-    // Fill lists of Unique IDS (neutrino and target)
-    if (std::find(targetids.begin(), targetids.end(), targ) ==
-        targetids.end()) {
-      targetids.push_back(targ);
-    }
-
-    // The full interaction list
-    if (std::find(interids.begin(), interids.end(), inter) == interids.end()) {
-      interids.push_back(inter);
-    }
-
-    // Create entries Mode Maps
-    if (modexsec.find(mode) == modexsec.end()) {
-      genieids.push_back(mode);
-
-      modexsec[mode] = (TH1D *)xsechist->Clone();
-      modecount[mode] = (TH1D *)xsechist->Clone();
-
-      modexsec[mode]->SetDirectory(NULL);
-      modecount[mode]->SetDirectory(NULL);
-
-      modexsec[mode]->GetYaxis()->SetTitle(
-          "d#sigma/dE_{#nu} #times 10^{-38} (events weighted by #sigma)");
-      modecount[mode]->GetYaxis()->SetTitle("Number of events in file");
-    }
-
-    // Fill XSec Histograms
-    modexsec[mode]->Fill(neu->E(), xsec);
-    modecount[mode]->Fill(neu->E());
-
-    // Fill total event hist
-    eventhist->Fill(neu->E());
-
-    if (i % (nevt / 20) == 0) {
-      NUIS_LOG(FIT, "Processed "
-          << i << "/" << nevt << " GENIE events (E: " << neu->E()
-          << " GeV, xsec: " << xsec << " E-38 cm^2/nucleon)");
-    }
-
-    // Clear Event
-    genientpl->Clear();
-  }
-  NUIS_LOG(FIT, "Processed all events");
+  FillModeHists(tn, xsechist, gNEvents != -999 ? nevt : -1, eventhist,
+                modexsec, modecount, genieids, targetids, interids);
 
   // Check if we need to correct MEC events before possibly deleting the TChain below
   bool MECcorrect = CheckConfig(std::string(tn->GetFile()->GetName()));
@@ -922,7 +878,8 @@ void PrintOptions() {
     "inputfile1.root,inputfile2.root,inputfile3.root,...] "
     << "[-f flux_root_file.root,flux_hist_name] [-t "
     "target1[frac1],target2[frac2],...]"
-    << "[-n number_of_events (experimental)]" << std::endl
+    << "[-n number_of_events (experimental)] [-j nworkers] [-w workdir]"
+    << std::endl
     << std::endl;
 
   std::cout << "Prepare Mode [Default] : Takes a single GHep file, "
@@ -955,6 +912,13 @@ void PrintOptions() {
   std::cout << " [ -n number_of_evt ] : Run with a reduced number of events "
     "for debugging purposes"
     << std::endl;
+  std::cout << " [ -j nworkers ] : Fill the xsec histograms from ranges of "
+    "the input entries in nworkers parallel processes."
+    << std::endl;
+  std::cout << " [ -w workdir ] : Keep the partial histograms of each entry "
+    "range in workdir. Rerunning with the same workdir only processes the "
+    "ranges that have not finished."
+    << std::endl;
 }
 
 void ParseOptions(int argc, char *argv[]) {
@@ -997,6 +961,12 @@ void ParseOptions(int argc, char *argv[]) {
       } else if (!std::strcmp(argv[i], "-n")) {
         gNEvents = GeneralUtils::StrToInt(argv[i + 1]);
         ++i;
+      } else if (!std::strcmp(argv[i], "-j")) {
+        gNWorkers = GeneralUtils::StrToInt(argv[i + 1]);
+        ++i;
+      } else if (!std::strcmp(argv[i], "-w")) {
+        gWorkDir = argv[i + 1];
+        ++i;
       } else if (!std::strcmp(argv[i], "-m")) {
         MonoEnergy = GeneralUtils::StrToDbl(argv[i + 1]);
         IsMonoE = true;
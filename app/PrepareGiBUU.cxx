@@ -1,5 +1,6 @@
 #include "FitLogger.h"
 #include "PlotUtils.h"
+#include "PrepareUtils.h"
 #include "StatUtils.h"
 #include "TFile.h"
 #include "TH1D.h"
@@ -10,6 +11,8 @@
 std::string fInputFiles = "";
 std::string fOutputFile = "";
 std::string fFluxFile   = "";
+int fNWorkers = 1;
+std::string fWorkDir = "";
 
 void PrintOptions();
 void ParseOptions(int argc, char *argv[]);
@@ -17,6 +20,26 @@ void CreateRateHistogram(std::string inputList, std::string flux,
                          std::string output);
 TH1D* MakeFluxHistFromDatFile(std::string inputDatFile);
 
+// Fills "xsec" weighted by the event weight and "entry" with the neutrino
+// energy
+class GiBUUFiller : public PrepareUtils::EventFiller {
+public:
+  void SetBranchAddresses(TTree *tree) {
+    tree->SetBranchAddress("lepIn_E", &E);
+    tree->SetBranchAddress("weight", &xsec);
+  }
+
+  void Fill(PrepareUtils::PartialHists &hists) {
+    hists.Get("xsec")->Fill(E, xsec);
+    hists.Get("entry")->Fill(E);
+  }
+
+  std::string GetDescription() const { return "GiBUU"; }
+
+private:
+  double E, xsec;
+};
+
 int main(int argc, char *argv[]) {
 
   SETVERBOSITY(FitPar::Config().GetParI("VERBOSITY"));
@@ -84,9 +107,6 @@ void CreateRateHistogram(std::string inputList, std::string flux,
                          std::string output) {
 
   TChain *tn = new TChain("RootTuple");
-  double E, xsec;
-  tn->SetBranchAddress("lepIn_E", &E);
-  tn->SetBranchAddress("weight", &xsec);
 
   std::vector<std::string> inputs = GeneralUtils::ParseToStr(inputList, ",");
   for (std::vector<std::string>::iterator it = inputs.begin();
@@ -119,24 +139,13 @@ void CreateRateHistogram(std::string inputList, std::string flux,
     NUIS_ABORT("NO FLUX SPECIFIED");
   }
 
-  // Make Event Hist
-  TH1D *xsecHist = (TH1D *)fluxHist->Clone();
-  xsecHist->Reset();
-
-  // Make a total cross section hist for shits and giggles
-  TH1D *entryHist = (TH1D *)xsecHist->Clone();
-
-  for (int i = 0; i < nevts; ++i) {
-    tn->GetEntry(i);
-    xsecHist->Fill(E, xsec);
-    entryHist->Fill(E);
-
-    if (i % (nevts / 10) == 0) {
-      NUIS_LOG(FIT, "Processed " << i << "/" << nevts << " GiBUU events."
-                             << "(Enu = " << E << ", xsec = " << xsec << ") ");
-    }
-  }
-  NUIS_LOG(FIT, "Processed all events");
+  // Fill the event and total cross section hists, file ranges in parallel
+  GiBUUFiller filler;
+  PrepareUtils::PartialHists *hists =
+      PrepareUtils::FillHistograms(tn, filler, fluxHist, fNWorkers, fWorkDir);
+  TH1D *xsecHist = hists->Get("xsec");
+  TH1D *entryHist = hists->Get("entry");
+  NUIS_LOG(FIT, "Processed all " << nevts << " events");
   
   // Somewhat annoyingly, have to include the flux width!
   double flux_range = (xsecHist->GetXaxis()->GetBinUpEdge(xsecHist->GetNbinsX()+1) - \
@@ -234,6 +243,14 @@ void PrintOptions() {
   std::cout << "          If more than one input file is given, an output file "
                "must be given"
             << std::endl;
+  std::cout << "    [-j nworkers]" << std::endl;
+  std::cout << "          Fill the rate histograms from ranges of the input "
+               "entries in nworkers parallel processes"
+            << std::endl;
+  std::cout << "    [-w workdir]" << std::endl;
+  std::cout << "          Keep the partial histograms of each entry range in "
+               "workdir, a rerun with the same workdir resumes from them"
+            << std::endl;
 }
 
 void ParseOptions(int argc, char *argv[]) {
@@ -259,6 +276,12 @@ void ParseOptions(int argc, char *argv[]) {
       } else if (!std::strcmp(argv[i], "-f")) {
         fFluxFile = argv[i + 1];
         ++i;
+      } else if (!std::strcmp(argv[i], "-j")) {
+        fNWorkers = GeneralUtils::StrToInt(argv[i + 1]);
+        ++i;
+      } else if (!std::strcmp(argv[i], "-w")) {
+        fWorkDir = argv[i + 1];
+        ++i;
       } else {
         NUIS_ERR(FTL, "ERROR: unknown command line option given! - '"
                         << argv[i] << " " << argv[i + 1] << "'");
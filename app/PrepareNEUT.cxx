@@ -1,5 +1,6 @@
 #include "FitLogger.h"
 #include "PlotUtils.h"
+#include "PrepareUtils.h"
 #include "StatUtils.h"
 #include "TFile.h"
 #include "TH1D.h"
@@ -18,6 +19,8 @@ bool fFluxInGeV = false;
 bool fIsMonoEFlux = false;
 double fMonoEEnergy = 0xdeadbeef;
 double fXSecOverride = 0;
+int fNWorkers = 1;
+std::string fWorkDir = "";
 
 void PrintOptions();
 void ParseOptions(int argc, char *argv[]);
@@ -26,6 +29,37 @@ void AddMonoRateHistogram(std::string inputList, double MonoE,
 void CreateRateHistogram(std::string inputList, std::string flux,
                          std::string output);
 
+// Fills "xsec" weighted by Totcrs and "entry" with the neutrino energy
+class NEUTFiller : public PrepareUtils::EventFiller {
+public:
+  NEUTFiller() : fNeutVect(NULL) {}
+
+  void SetBranchAddresses(TTree *tree) {
+    fNeutVect = NULL;
+    tree->SetBranchAddress("vectorbranch", &fNeutVect);
+  }
+
+  void Fill(PrepareUtils::PartialHists &hists) {
+    NeutPart *part = fNeutVect->PartInfo(0);
+    double E = part->fP.E();
+    double xsec = fNeutVect->Totcrs;
+
+    // Unit conversion
+    if (fFluxInGeV)
+      E *= 1E-3;
+
+    hists.Get("xsec")->Fill(E, xsec);
+    hists.Get("entry")->Fill(E);
+  }
+
+  std::string GetDescription() const {
+    return fFluxInGeV ? "NEUT;GeV" : "NEUT;MeV";
+  }
+
+private:
+  NeutVect *fNeutVect;
+};
+
 //*******************************
 int main(int argc, char *argv[]) {
   //*******************************
@@ -200,9 +234,6 @@ void CreateRateHistogram(std::string inputList, std::string flux,
     NUIS_ABORT("Either the input file is not from NEUT, or it's empty...");
   }
 
-  NeutVect *fNeutVect = NULL;
-  tn->SetBranchAddress("vectorbranch", &fNeutVect);
-
   // Get Flux Hist
   std::vector<std::string> fluxvect = GeneralUtils::ParseToStr(flux, ",");
   TH1D *fluxHist = NULL;
@@ -221,32 +252,13 @@ void CreateRateHistogram(std::string inputList, std::string flux,
     NUIS_LOG(FIT, "Assuming flux histogram is in MeV");
   }
 
-  // Make Event Hist
-  TH1D *xsecHist = (TH1D *)fluxHist->Clone();
-  xsecHist->Reset();
-
-  // Make a total cross section hist for shits and giggles
-  TH1D *entryHist = (TH1D *)xsecHist->Clone();
-
-  for (int i = 0; i < nevts; ++i) {
-    tn->GetEntry(i);
-    NeutPart *part = fNeutVect->PartInfo(0);
-    double E = part->fP.E();
-    double xsec = fNeutVect->Totcrs;
-
-    // Unit conversion
-    if (fFluxInGeV)
-      E *= 1E-3;
-
-    xsecHist->Fill(E, xsec);
-    entryHist->Fill(E);
-
-    if (i % (nevts / 20) == 0) {
-      NUIS_LOG(FIT, "Processed " << i << "/" << nevts << " NEUT events."
-                             << "(Enu = " << E << ", xsec = " << xsec << ") ");
-    }
-  }
-  NUIS_LOG(FIT, "Processed all events");
+  // Fill the event and total cross section hists, file ranges in parallel
+  NEUTFiller filler;
+  PrepareUtils::PartialHists *hists =
+      PrepareUtils::FillHistograms(tn, filler, fluxHist, fNWorkers, fWorkDir);
+  TH1D *xsecHist = hists->Get("xsec");
+  TH1D *entryHist = hists->Get("entry");
+  NUIS_LOG(FIT, "Processed all " << nevts << " events");
 
   xsecHist->Divide(entryHist);
 
@@ -361,6 +373,14 @@ void PrintOptions() {
   std::cout << "          Used to add dummy flux and evt rate histograms to "
                "mono-energetic vectors. Adheres to the -G flag."
             << std::endl;
+  std::cout << "    [-j nworkers]" << std::endl;
+  std::cout << "          Fill the rate histograms from ranges of the input "
+               "entries in nworkers parallel processes"
+            << std::endl;
+  std::cout << "    [-w workdir]" << std::endl;
+  std::cout << "          Keep the partial histograms of each entry range in "
+               "workdir, a rerun with the same workdir resumes from them"
+            << std::endl;
 }
 
 void ParseOptions(int argc, char *argv[]) {
@@ -393,6 +413,12 @@ void ParseOptions(int argc, char *argv[]) {
         fIsMonoEFlux = true;
         fMonoEEnergy = GeneralUtils::StrToDbl(argv[i + 1]);
         ++i;
+      } else if (!std::strcmp(argv[i], "-j")) {
+        fNWorkers = GeneralUtils::StrToInt(argv[i + 1]);
+        ++i;
+      } else if (!std::strcmp(argv[i], "-w")) {
+        fWorkDir = argv[i + 1];
+        ++i;
       } else if (!std::strcmp(argv[i],"-X")){
         fXSecOverride = GeneralUtils::StrToDbl(argv[i + 1]);
 	++i;
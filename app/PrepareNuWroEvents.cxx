@@ -6,6 +6,8 @@
 // #include "params.h"
 #include "FitLogger.h"
 #include "PlotUtils.h"
+#include "PrepareUtils.h"
+#include "TChain.h"
 #include "TFile.h"
 #include "TH1D.h"
 #include "TTree.h"
@@ -13,12 +15,19 @@
 void printInputCommands(char *argv[]) {
   std::cout << "[USAGE]: " << argv[0]
             << " [-h] [-f] [-F <FluxRootFile>,<FluxHistName>[,PDG[,speciesFraction]] [-o output.root] "
+               "[-j nworkers] [-w workdir] "
                "inputfile.root [file2.root ...]"
             << std::endl
             << "\t-h : Print this message." << std::endl
             << "\t-f : Pass -f argument to '$ hadd' invocation." << std::endl
             << "\t-F : Read input flux from input descriptor." << std::endl
             << "\t-o : Write full output to a new file." << std::endl
+            << "\t-j : Fill the event rates from ranges of the input entries "
+               "in <nworkers> parallel processes."
+            << std::endl
+            << "\t-w : Keep partial event rates in <workdir>, a rerun with "
+               "the same workdir resumes from them."
+            << std::endl
             << std::endl;
 };
 void CreateRateHistograms(std::string inputs, bool force_out);
@@ -27,6 +36,8 @@ void HaddNuwroFiles(std::vector<std::string> &inputs, bool force_out);
 bool outputNewFile = false;
 std::string ofile = "";
 bool haveFluxInputs = false;
+int nworkers = 1;
+std::string workdir = "";
 
 struct FluxInputBlob {
   FluxInputBlob(std::string _File, std::string _Hist, int _PDG,
@@ -42,6 +53,58 @@ std::vector<FluxInputBlob> FluxInputs;
 
 bool haddedFiles = false;
 
+// Fills an "evt<pdg>" histogram for every neutrino species and the total
+// "evt0", with matching "nevt<pdg>" and "xsec<pdg>" sums
+class NuWroFiller : public PrepareUtils::EventFiller {
+public:
+  NuWroFiller(std::vector<int> const &allpdg,
+              std::map<int, TH1D *> const &eventlist)
+      : fAllPDG(allpdg), fEventList(eventlist), evt(NULL) {}
+  ~NuWroFiller() { delete evt; }
+
+  void SetBranchAddresses(TTree *tree) {
+    if (!evt)
+      evt = new event();
+    tree->SetBranchAddress("e", &evt);
+  }
+
+  void Fill(PrepareUtils::PartialHists &hists) {
+    // Get Variables
+    double Enu = evt->in[0].t / 1000.0;
+    double TotXSec = evt->weight;
+    int pdg = evt->in[0].pdg;
+
+    if (std::find(fAllPDG.begin(), fAllPDG.end(), pdg) == fAllPDG.end()) {
+      NUIS_ABORT("Not set up to handle PDG: " << pdg << " check your inputs");
+    }
+
+    int fill[2] = {0, pdg};
+    for (int i = 0; i < 2; ++i) {
+      hists.Book(Form("evt%i", fill[i]), fEventList.find(fill[i])->second)
+          ->Fill(Enu);
+      hists.AddSum(Form("nevt%i", fill[i]), 1);
+      hists.AddSum(Form("xsec%i", fill[i]), TotXSec);
+    }
+  }
+
+  // The accepted PDGs and the binning each one is booked with
+  std::string GetDescription() const {
+    std::string desc = "NuWro";
+    for (std::map<int, TH1D *>::const_iterator it = fEventList.begin();
+         it != fEventList.end(); ++it) {
+      TAxis const *axis = it->second->GetXaxis();
+      desc += Form(";%i:%d_%g_%g", it->first, axis->GetNbins(),
+                   axis->GetXmin(), axis->GetXmax());
+    }
+    return desc;
+  }
+
+private:
+  std::vector<int> const &fAllPDG;
+  std::map<int, TH1D *> const &fEventList;
+  event *evt;
+};
+
 TH1D *F2D(TH1F *f) {
   Double_t *bins = new Double_t[f->GetXaxis()->GetNbins() + 1];
   for (Int_t bi_it = 0; bi_it < f->GetXaxis()->GetNbins(); ++bi_it) {
@@ -124,6 +187,10 @@ int main(int argc, char *argv[]) {
     } else if (!std::strcmp(argv[i], "-o")) {
       outputNewFile = true;
       ofile = argv[++i];
+    } else if (!std::strcmp(argv[i], "-j")) {
+      nworkers = GeneralUtils::StrToInt(argv[++i]);
+    } else if (!std::strcmp(argv[i], "-w")) {
+      workdir = argv[++i];
     } else if (!std::strcmp(argv[i], "-F")) {
       std::string inpLine = argv[++i];
       std::vector<std::string> fluxInputDescriptor =
@@ -398,44 +465,23 @@ void CreateRateHistograms(std::string inputs, bool force_out) {
     }
   }
 
-  // Start main event loop to fill plots
-  int nevents = nuwrotree->GetEntries();
-  double Enu = 0.0;
-  double TotXSec = 0.0;
-  // double totaleventmode = 0.0;
-  // double totalevents = 0.0;
-  int pdg = 0;
-  int countwidth = nevents / 50.0;
-  countwidth = countwidth ? countwidth : 1;
-
-  for (int i = 0; i < nevents; i++) {
-    nuwrotree->GetEntry(i);
+  // Start main event loop to fill plots, ranges of entries in parallel
+  TChain chain("treeout");
+  chain.AddFile(inputs.c_str());
+  NuWroFiller filler(allpdg, eventlist);
+  PrepareUtils::PartialHists *hists = PrepareUtils::FillHistograms(
+      &chain, filler, eventlist[0], nworkers, workdir);
 
-    // Get Variables
-    Enu = evt->in[0].t / 1000.0;
-    TotXSec = evt->weight;
-    pdg = evt->in[0].pdg;
-    
-    if (std::find(allpdg.begin(), allpdg.end(), pdg) == allpdg.end()) {
-      NUIS_ABORT("Not set up to handle PDG: " << pdg << " check your inputs");
-    }
-
-    eventlist[0]->Fill(Enu);
-    eventlist[pdg]->Fill(Enu);
-
-    nevtlist[0] += 1;
-    nevtlist[pdg] += 1;
-
-    intxseclist[0] += TotXSec;
-    intxseclist[pdg] += TotXSec;
-
-    if (i % countwidth == 0) {
-      NUIS_LOG(FIT, "Processed " << i << " events "
-                                 << " (" << int(i * 100.0 / nevents) << "%)"
-                                 << " : E, W, PDG = " << Enu << ", " << TotXSec
-                                 << ", " << pdg)
+  for (uint i = 0; i < allpdg.size(); i++) {
+    int pdg = allpdg[i];
+    if (hists->Has(Form("evt%i", pdg))) {
+      eventlist[pdg]->Add(hists->Get(Form("evt%i", pdg)));
     }
+    nevtlist[pdg] = hists->GetSum(Form("nevt%i", pdg));
+    intxseclist[pdg] = hists->GetSum(Form("xsec%i", pdg));
   }
+  NUIS_LOG(FIT, "Processed " << nevtlist[0] << " events");
+  delete hists;
 
   TH1D *zeroevents = (TH1D *)eventlist[0]->Clone();
 
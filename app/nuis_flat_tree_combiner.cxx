@@ -1,16 +1,26 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
 #include <iostream>
+#include <sstream>
 #include <string>
 #include <vector>
 
+#include "TBranch.h"
 #include "TChain.h"
+#include "TChainElement.h"
 #include "TFile.h"
+#include "TLeaf.h"
 #include "TTree.h"
 
+#include "ParallelUtils.h"
+
 std::vector<std::string> inputdescriptors;
 std::string outputfilename;
 std::string treename;
 std::string branchname;
 bool isdouble = true;
+int nworkers = 1;
 
 void SayUsage(char const *argv[]) {
   std::cout
@@ -22,6 +32,8 @@ void SayUsage(char const *argv[]) {
          "branch name\n"
       << "\t-f                                              : xsec weighting "
          "branch is float\n"
+      << "\t-j <nworkers>                                   : merge chunks of "
+         "the input list in parallel\n"
       << std::endl;
 }
 
@@ -44,6 +56,8 @@ void handleOpts(int argc, char const *argv[]) {
       branchname = argv[++opt];
     } else if (std::string(argv[opt]) == "-f") {
       isdouble = false;
+    } else if (std::string(argv[opt]) == "-j") {
+      nworkers = atoi(argv[++opt]);
     } else {
       std::cout << "[ERROR]: Unknown option: " << argv[opt] << std::endl;
       SayUsage(argv);
@@ -53,9 +67,139 @@ void handleOpts(int argc, char const *argv[]) {
   }
 }
 
+// Branch names and leaf types, trees with the same schema can be fast cloned
+std::string GetSchema(TTree *tree) {
+  std::stringstream ss;
+  TObjArray *leaves = tree->GetListOfLeaves();
+  for (int i = 0; i < leaves->GetEntries(); ++i) {
+    TLeaf *leaf = static_cast<TLeaf *>(leaves->At(i));
+    ss << leaf->GetBranch()->GetName() << ":" << leaf->GetName() << ":"
+       << leaf->GetTypeName() << ";";
+  }
+  return ss.str();
+}
+
+TTree *GetTree(TFile &file) {
+  TTree *tree = dynamic_cast<TTree *>(file.Get(treename.c_str()));
+  if (!tree) {
+    std::cout << "[ERROR]: No tree " << treename << " in " << file.GetName()
+              << std::endl;
+    exit(1);
+  }
+  return tree;
+}
+
+// Copy the entries of files into outname. Every column except the weighting
+// branch is moved as compressed baskets, the weighting branch is then
+// rewritten with each file's entries scaled by scales[i].
+class MergeTask : public ParallelUtils::Task {
+public:
+  MergeTask(std::vector<std::vector<std::string> > const &files,
+            std::vector<std::vector<double> > const &scales,
+            std::vector<std::string> const &outnames, bool rescale)
+      : fFiles(files), fScales(scales), fOutNames(outnames),
+        fRescale(rescale) {}
+
+  std::vector<double> Run(int ichunk) {
+    std::vector<std::string> const &files = fFiles[ichunk];
+
+    TFile outfile(fOutNames[ichunk].c_str(), "RECREATE");
+    if (outfile.IsZombie()) {
+      std::cout << "[ERROR]: Cannot open " << fOutNames[ichunk] << std::endl;
+      exit(1);
+    }
+
+    TTree *outtree = NULL;
+    std::string schema;
+    long nfast = 0;
+
+    for (size_t i = 0; i < files.size(); ++i) {
+      TFile infile(files[i].c_str(), "READ");
+      TTree *intree = GetTree(infile);
+      if (fRescale) {
+        intree->SetBranchStatus(branchname.c_str(), 0);
+      }
+
+      if (!outtree) {
+        outfile.cd();
+        outtree = intree->CloneTree(0);
+        outtree->SetDirectory(&outfile);
+        schema = GetSchema(intree);
+      }
+
+      // Files written with a different layout are copied entry by entry
+      bool fast = (GetSchema(intree) == schema);
+      outtree->CopyEntries(intree, -1, fast ? "fast" : "");
+      nfast += fast;
+    }
+
+    if (fRescale) {
+      AddScaleBranch(outtree, files, fScales[ichunk]);
+    }
+
+    double nents = outtree->GetEntries();
+    std::cout << "Merged " << files.size() << " files (" << nfast
+              << " fast cloned) into " << fOutNames[ichunk] << std::endl;
+
+    outfile.cd();
+    outtree->Write("", TObject::kOverwrite);
+    outfile.Close();
+
+    return std::vector<double>(1, nents);
+  }
+
+private:
+  template <typename T>
+  void FillScale(TBranch *outbranch, T &outval,
+                 std::vector<std::string> const &files,
+                 std::vector<double> const &scales) {
+    for (size_t i = 0; i < files.size(); ++i) {
+      TFile infile(files[i].c_str(), "READ");
+      TTree *intree = GetTree(infile);
+
+      // Only the weighting column is read back
+      T inval;
+      intree->SetBranchStatus("*", 0);
+      intree->SetBranchStatus(branchname.c_str(), 1);
+      intree->SetBranchAddress(branchname.c_str(), &inval);
+
+      Long64_t nents = intree->GetEntries();
+      for (Long64_t ent_it = 0; ent_it < nents; ++ent_it) {
+        intree->GetEntry(ent_it);
+        outval = inval * scales[i];
+        outbranch->Fill();
+      }
+    }
+  }
+
+  void AddScaleBranch(TTree *outtree, std::vector<std::string> const &files,
+                      std::vector<double> const &scales) {
+    if (isdouble) {
+      double val;
+      TBranch *br =
+          outtree->Branch(branchname.c_str(), &val,
+                          (branchname + "/D").c_str());
+      FillScale(br, val, files, scales);
+    } else {
+      float val;
+      TBranch *br =
+          outtree->Branch(branchname.c_str(), &val,
+                          (branchname + "/F").c_str());
+      FillScale(br, val, files, scales);
+    }
+    outtree->ResetBranchAddresses();
+  }
+
+  std::vector<std::vector<std::string> > fFiles;
+  std::vector<std::vector<double> > fScales;
+  std::vector<std::string> fOutNames;
+  bool fRescale;
+};
+
 int main(int argc, char const *argv[]) {
   handleOpts(argc, argv);
 
+  // Expand any wildcards in the same way as before
   TChain ch(treename.c_str());
   for (size_t i = 0; i < inputdescriptors.size(); ++i) {
     ch.Add(inputdescriptors[i].c_str());
@@ -63,50 +207,89 @@ int main(int argc, char const *argv[]) {
               << std::endl;
   }
 
-  TFile *outfile = new TFile(outputfilename.c_str(), "RECREATE");
-  std::cout << "Writing to " << outputfilename << std::endl;
-  TTree *outtree = ch.CloneTree(0, "");
-  outtree->SetDirectory(outfile);
-
-  size_t nents = ch.GetEntries();
-  double ntrees = ch.GetNtrees();
-
-  if (isdouble) {
-    double fScaleFactor;
-    ch.SetBranchAddress(branchname.c_str(), &fScaleFactor);
-    std::cout << "recalculating " << branchname << "(double) for " << ntrees
-              << " input trees." << std::endl;
-
-    for (size_t ent_it = 0; ent_it < nents; ++ent_it) {
-      if ((nents/100) && ent_it && !(ent_it % (nents/100))) {
-        std::cout << "Processed " << ent_it << "/" << nents << std::endl;
-      }
+  std::vector<std::string> files;
+  TObjArray *elements = ch.GetListOfFiles();
+  for (int i = 0; i < elements->GetEntries(); ++i) {
+    files.push_back(static_cast<TChainElement *>(elements->At(i))->GetTitle());
+  }
+  if (files.empty()) {
+    std::cout << "[ERROR]: No input files given." << std::endl;
+    SayUsage(argv);
+    exit(1);
+  }
 
-      ch.GetEntry(ent_it);
+  // Metadata pass: entries, schema and weighting branch type of every file.
+  // Nothing but the tree headers is read here.
+  double ntrees = files.size();
+  std::vector<double> scales(files.size(), 1.0 / ntrees);
+  Long64_t nents = 0;
+  for (size_t i = 0; i < files.size(); ++i) {
+    TFile infile(files[i].c_str(), "READ");
+    TTree *intree = GetTree(infile);
 
-      fScaleFactor /= ntrees;
+    TLeaf *leaf = intree->GetLeaf(branchname.c_str());
+    if (!leaf) {
+      std::cout << "[ERROR]: No branch " << branchname << " in " << files[i]
+                << std::endl;
+      exit(1);
+    }
+    std::string type = leaf->GetTypeName();
+    if (type != (isdouble ? "Double_t" : "Float_t")) {
+      std::cout << "[ERROR]: Branch " << branchname << " in " << files[i]
+                << " is " << type << ", use -f for float branches."
+                << std::endl;
+      exit(1);
+    }
+    nents += intree->GetEntries();
+  }
+  std::cout << "recalculating " << branchname << "("
+            << (isdouble ? "double" : "float") << ") for " << ntrees
+            << " input trees with " << nents << " entries." << std::endl;
 
-      outtree->Fill();
+  // Contiguous chunks so the output keeps the input order
+  int nchunks = std::max(1, std::min(nworkers, int(files.size())));
+  std::vector<std::vector<std::string> > chunkfiles(nchunks);
+  std::vector<std::vector<double> > chunkscales(nchunks);
+  std::vector<std::string> chunknames(nchunks, outputfilename);
+  for (size_t i = 0; i < files.size(); ++i) {
+    int ichunk = (i * nchunks) / files.size();
+    chunkfiles[ichunk].push_back(files[i]);
+    chunkscales[ichunk].push_back(scales[i]);
+  }
+  if (nchunks > 1) {
+    for (int i = 0; i < nchunks; ++i) {
+      std::stringstream ss;
+      ss << outputfilename << ".part" << i << ".root";
+      chunknames[i] = ss.str();
     }
-  } else {
-    float fScaleFactor;
-    ch.SetBranchAddress(branchname.c_str(), &fScaleFactor);
-    std::cout << "recalculating " << branchname << "(float) for " << ntrees
-              << " input trees." << std::endl;
-
-    for (size_t ent_it = 0; ent_it < nents; ++ent_it) {
-      if ((nents/100) && ent_it && !(ent_it % (nents/100))) {
-        std::cout << "Processed " << ent_it << "/" << nents << std::endl;
-      }
+  }
 
-      ch.GetEntry(ent_it);
+  MergeTask merge(chunkfiles, chunkscales, chunknames, true);
+  std::vector<std::vector<double> > written =
+      ParallelUtils::RunTasks(merge, nchunks, nchunks);
 
-      fScaleFactor /= ntrees;
+  Long64_t nwritten = 0;
+  for (int i = 0; i < nchunks; ++i) {
+    nwritten += written[i].empty() ? 0 : Long64_t(written[i][0]);
+  }
+  if (nwritten != nents) {
+    std::cout << "[ERROR]: Wrote " << nwritten << " of " << nents
+              << " entries." << std::endl;
+    exit(1);
+  }
 
-      outtree->Fill();
+  // Chunks already carry the rescaled branch so are stitched as they are
+  if (nchunks > 1) {
+    std::vector<std::vector<std::string> > parts(1, chunknames);
+    std::vector<std::string> outname(1, outputfilename);
+    MergeTask stitch(parts, std::vector<std::vector<double> >(1), outname,
+                     false);
+    stitch.Run(0);
+
+    for (int i = 0; i < nchunks; ++i) {
+      remove(chunknames[i].c_str());
     }
   }
 
-  outfile->Write();
-  outfile->Close();
-}
\ No newline at end of file
+  std::cout << "Writing to " << outputfilename << std::endl;
+}
@@ -0,0 +1,480 @@
+// Copyright 2016-2021 L. Pickering, P Stowell, R. Terri, C. Wilkinson, C. Wret
+
+/*******************************************************************************
+ *    This file is part of NUISANCE.
+ *
+ *    NUISANCE is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    NUISANCE is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with NUISANCE.  If not, see <http://www.gnu.org/licenses/>.
+ *******************************************************************************/
+#include "FitEvent.h"
+#include "FitLogger.h"
+#include "GeneralUtils.h"
+#include "JointFCN.h"
+#include "Measurement1D.h"
+#include "NuisConfig.h"
+#include "ParserUtils.h"
+#include "SignalDef.h"
+#include "SplineReader.h"
+#include "StatUtils.h"
+#include "SyntheticInputHandler.h"
+#include "TimingUtils.h"
+
+#include "TDatime.h"
+#include "TRandom3.h"
+#include "TSystem.h"
+
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <unistd.h>
+
+// Global Arguments
+std::string gOptOutputFile = "nuisbench.json";
+std::string gOptFilter = "";
+std::string gOptInput = "SYNTHETIC:NEVENTS=20000,SEED=1";
+std::string gOptSamples =
+    "MiniBooNE_CCQE_XSec_1DQ2_nu,MiniBooNE_CC1pip_XSec_1DQ2_nu";
+std::string gOptMinTime = "0.5";
+int gVerbosity = 0;
+
+// Benchmark fixtures
+const int kNFixtureEvents = 256;
+SyntheticInputHandler *gInput = NULL;
+std::vector<FitEvent *> gEvents;
+TH1D *gDataHist = NULL;
+TH1D *gMCHist = NULL;
+TMatrixDSym *gInvCov = NULL;
+SplineReader *gSplineReader = NULL;
+std::vector<float> gSplineCoeffs;
+int gSplineNPar = 0;
+Measurement1D *gSample = NULL;
+std::vector<double> gSampleXVals;
+JointFCN *gFCN = NULL;
+
+/// Sink so the compiler can't drop the measured calls
+volatile double gSink = 0.0;
+
+/// Single benchmark result in google benchmark JSON units
+struct BenchResult {
+  std::string name;
+  long iterations;
+  double real_time; ///< ns per iteration
+  double cpu_time;  ///< ns per iteration
+};
+std::vector<BenchResult> gResults;
+
+/// Benchmark body, runs the measured code niter times
+typedef void (*BenchFunction)(long niter);
+
+//*******************************
+void PrintSyntax() {
+  //*******************************
+
+  std::cout << "nuisbench [-o out.json] [-f filter] [-i input] [-s samples] "
+               "[-t mintime] [-q con=val] \n";
+  std::cout
+      << "\n Arguments : "
+      << "\n\t[-o out.json]: Output JSON file in google benchmark format."
+      << "\n\t              Default is nuisbench.json"
+      << "\n\t"
+      << "\n\t[-f filter] : Only run benchmarks whose name contains filter."
+      << "\n\t"
+      << "\n\t[-i input]  : Input used for the sample benchmarks. "
+      << "\n\t              Default is " << gOptInput
+      << "\n\t"
+      << "\n\t[-s samples]: Comma separated samples for the JointFCN "
+         "benchmarks."
+      << "\n\t              The first sample must be a Measurement1D."
+      << "\n\t              Default is " << gOptSamples
+      << "\n\t"
+      << "\n\t[-t mintime]: Minimum time in seconds spent on each benchmark."
+      << "\n\t"
+      << "\n\t[-q con=val]: Configuration overrides." << std::endl;
+
+  exit(-1);
+};
+
+//____________________________________________________________________________
+void GetCommandLineArgs(int argc, char **argv) {
+  // Check for -h flag.
+  for (int i = 0; i < argc; i++) {
+    if ((!std::string(argv[i]).compare("-h")) ||
+        (!std::string(argv[i]).compare("-?")) ||
+        (!std::string(argv[i]).compare("--help")))
+      PrintSyntax();
+  }
+
+  std::vector<std::string> args = GeneralUtils::LoadCharToVectStr(argc, argv);
+
+  ParserUtils::ParseArgument(args, "-o", gOptOutputFile, false);
+  ParserUtils::ParseArgument(args, "-f", gOptFilter, false);
+  ParserUtils::ParseArgument(args, "-i", gOptInput, false);
+  ParserUtils::ParseArgument(args, "-s", gOptSamples, false);
+  ParserUtils::ParseArgument(args, "-t", gOptMinTime, false);
+
+  nuisconfig configuration = Config::Get();
+  std::vector<std::string> configargs;
+  ParserUtils::ParseArgument(args, "-q", configargs);
+  for (size_t i = 0; i < configargs.size(); i++) {
+    configuration.OverrideConfig(configargs[i]);
+  }
+
+  ParserUtils::CheckBadArguments(args);
+}
+
+//*******************************
+void RunBenchmark(std::string const &name, BenchFunction func) {
+  //*******************************
+
+  if (!gOptFilter.empty() && name.find(gOptFilter) == std::string::npos)
+    return;
+
+  double mintime = GeneralUtils::StrToDbl(gOptMinTime);
+
+  // Keep per-iteration logging out of the measurement
+  SETVERBOSITY(QUIET);
+
+  // Warm up caches, then grow the iteration count until we pass mintime
+  func(1);
+
+  long niter = 1;
+  double realtime = 0.0;
+  double cputime = 0.0;
+  while (true) {
+    double start = TimingUtils::GetTime();
+    std::clock_t cpustart = std::clock();
+    func(niter);
+    realtime = TimingUtils::GetTime() - start;
+    cputime = double(std::clock() - cpustart) / CLOCKS_PER_SEC;
+
+    if (realtime >= mintime || niter >= 1000000000L)
+      break;
+
+    double mult = realtime > 0.0 ? 1.4 * mintime / realtime : 10.0;
+    mult = std::min(std::max(mult, 2.0), 10.0);
+    niter = long(niter * mult);
+  }
+
+  SETVERBOSITY(gVerbosity);
+
+  BenchResult result;
+  result.name = name;
+  result.iterations = niter;
+  result.real_time = realtime * 1.E9 / double(niter);
+  result.cpu_time = cputime * 1.E9 / double(niter);
+  gResults.push_back(result);
+
+  NUIS_LOG(FIT, Form("%-40s %16.1f ns %16.1f ns %12ld", name.c_str(),
+                     result.real_time, result.cpu_time, niter));
+}
+
+//*******************************
+void WriteResults() {
+  //*******************************
+
+  std::ofstream out(gOptOutputFile.c_str());
+  if (!out.good()) {
+    NUIS_ABORT("Cannot open benchmark output file " << gOptOutputFile);
+  }
+
+  TDatime now;
+  out << "{" << std::endl;
+  out << "  \"context\": {" << std::endl;
+  out << "    \"date\": \"" << now.AsSQLString() << "\"," << std::endl;
+  out << "    \"host_name\": \"" << gSystem->HostName() << "\"," << std::endl;
+  out << "    \"executable\": \"nuisbench\"," << std::endl;
+  out << "    \"num_cpus\": " << sysconf(_SC_NPROCESSORS_ONLN) << ","
+      << std::endl;
+  out << "    \"input\": \"" << gOptInput << "\"," << std::endl;
+  out << "    \"samples\": \"" << gOptSamples << "\"" << std::endl;
+  out << "  }," << std::endl;
+  out << "  \"benchmarks\": [" << std::endl;
+  for (size_t i = 0; i < gResults.size(); i++) {
+    BenchResult const &res = gResults[i];
+    out << std::setprecision(6) << "    {\"name\": \"" << res.name
+        << "\", \"run_name\": \"" << res.name
+        << "\", \"run_type\": \"iteration\", \"repetitions\": 1, "
+           "\"repetition_index\": 0, \"threads\": 1, \"iterations\": "
+        << res.iterations << ", \"real_time\": " << res.real_time
+        << ", \"cpu_time\": " << res.cpu_time << ", \"time_unit\": \"ns\"}"
+        << (i + 1 < gResults.size() ? "," : "") << std::endl;
+  }
+  out << "  ]" << std::endl;
+  out << "}" << std::endl;
+
+  NUIS_LOG(FIT, "Saved benchmark results to " << gOptOutputFile);
+}
+
+//*******************************
+// Fixtures
+//*******************************
+
+void SetupEventFixtures() {
+  gInput = new SyntheticInputHandler("nuisbench", "NEVENTS=100000,SEED=1");
+  for (int i = 0; i < kNFixtureEvents; i++) {
+    FitEvent *event = new FitEvent();
+    event->HardReset();
+    gInput->FillEvent(event, i, false);
+    gEvents.push_back(event);
+  }
+}
+
+void SetupStatFixtures() {
+  const int nbins = 50;
+  TRandom3 rand(1);
+
+  gDataHist = new TH1D("nuisbench_data", "nuisbench_data", nbins, 0.0, 1.0);
+  gMCHist = new TH1D("nuisbench_mc", "nuisbench_mc", nbins, 0.0, 1.0);
+  gDataHist->SetDirectory(NULL);
+  gMCHist->SetDirectory(NULL);
+
+  for (int i = 0; i < nbins; i++) {
+    double val = 1.E-38 * (1.0 + 10.0 * exp(-double(i) / 10.0));
+    gDataHist->SetBinContent(i + 1, val);
+    gDataHist->SetBinError(i + 1, 0.1 * val);
+    gMCHist->SetBinContent(i + 1, val * rand.Gaus(1.05, 0.05));
+  }
+
+  // Diagonal errors with a fully correlated 5% normalisation term
+  TMatrixDSym cov(nbins);
+  for (int i = 0; i < nbins; i++) {
+    for (int j = 0; j < nbins; j++) {
+      double vi = gDataHist->GetBinContent(i + 1) * 1.E38;
+      double vj = gDataHist->GetBinContent(j + 1) * 1.E38;
+      cov(i, j) = 0.0025 * vi * vj;
+      if (i == j)
+        cov(i, j) += 0.01 * vi * vi;
+    }
+  }
+  gInvCov = StatUtils::GetInvert(&cov);
+}
+
+void SetupSplineFixtures() {
+  gSplineReader = new SplineReader();
+
+  nuiskey tspl = Config::CreateKey("spline");
+  tspl.Set("name", "MaCCQE");
+  tspl.Set("form", "1DTSpline3");
+  tspl.Set("points", "-3.0,-2.0,-1.0,0.0,1.0,2.0,3.0");
+  gSplineReader->AddSpline(tspl);
+
+  nuiskey pspl = Config::CreateKey("spline");
+  pspl.Set("name", "MaRES");
+  pspl.Set("form", "1DPol6");
+  pspl.Set("points", "-3.0,-2.0,-1.0,0.0,1.0,2.0,3.0");
+  gSplineReader->AddSpline(pspl);
+
+  std::map<std::string, double> vals;
+  vals["MaCCQE"] = 0.45;
+  vals["MaRES"] = -0.3;
+  gSplineReader->Reconfigure(vals);
+
+  // Near-unit weights with small per-event responses
+  TRandom3 rand(1);
+  gSplineNPar = gSplineReader->GetNPar();
+  gSplineCoeffs.resize(gSplineNPar * kNFixtureEvents);
+  for (int i = 0; i < kNFixtureEvents; i++) {
+    float *coeff = &gSplineCoeffs[i * gSplineNPar];
+    for (int j = 0; j < gSplineNPar; j++) {
+      coeff[j] = (j % 4 == 0 ? 1.0 : 0.0) + rand.Gaus(0.0, 0.02);
+    }
+  }
+}
+
+void SetupSampleFixtures() {
+  std::vector<std::string> samples =
+      GeneralUtils::ParseToStr(gOptSamples, ",");
+
+  std::vector<nuiskey> samplekeys;
+  for (size_t i = 0; i < samples.size(); i++) {
+    nuiskey samplekey = Config::CreateKey("sample");
+    samplekey.Set("name", samples[i]);
+    samplekey.Set("input", gOptInput);
+    samplekey.Set("type", "DEFAULT");
+    samplekeys.push_back(samplekey);
+  }
+
+  // A single norm dial so each DoEval registers a dial change
+  FitBase::GetRW()->IncludeDial(samples[0] + "_norm", kNORM, 1.0);
+
+  gFCN = new JointFCN(samplekeys);
+  gFCN->SetNParams(1);
+
+  gSample = dynamic_cast<Measurement1D *>(gFCN->GetSampleList().front());
+  if (!gSample) {
+    NUIS_ERR(WRN, samples[0] << " is not a Measurement1D, skipping "
+                             << "FillHistograms benchmark.");
+    return;
+  }
+
+  // Prime the variable box and build x values across the MC range
+  gSample->FillVariableBox(gEvents[0]);
+  TRandom3 rand(1);
+  TH1D *mchist = gSample->GetMCHistogram();
+  for (int i = 0; i < kNFixtureEvents; i++) {
+    gSampleXVals.push_back(rand.Uniform(mchist->GetXaxis()->GetXmin(),
+                                        mchist->GetXaxis()->GetXmax()));
+  }
+}
+
+//*******************************
+// Benchmarks
+//*******************************
+
+void BM_SyntheticInput_GetNuisanceEvent(long niter) {
+  for (long i = 0; i < niter; i++) {
+    gSink += gInput->GetNuisanceEvent(i % gInput->GetNEvents())->fNParticles;
+  }
+}
+
+void BM_FitEvent_OrderStack(long niter) {
+  for (long i = 0; i < niter; i++) {
+    gEvents[i % kNFixtureEvents]->OrderStack();
+  }
+}
+
+void BM_SignalDef_isCCINC(long niter) {
+  for (long i = 0; i < niter; i++) {
+    gSink += SignalDef::isCCINC(gEvents[i % kNFixtureEvents], 14);
+  }
+}
+
+void BM_SignalDef_isCC0pi(long niter) {
+  for (long i = 0; i < niter; i++) {
+    gSink += SignalDef::isCC0pi(gEvents[i % kNFixtureEvents], 14);
+  }
+}
+
+void BM_SignalDef_isCCQELike(long niter) {
+  for (long i = 0; i < niter; i++) {
+    gSink += SignalDef::isCCQELike(gEvents[i % kNFixtureEvents], 14);
+  }
+}
+
+void BM_SignalDef_isCC1pi(long niter) {
+  for (long i = 0; i < niter; i++) {
+    gSink += SignalDef::isCC1pi(gEvents[i % kNFixtureEvents], 14, 211);
+  }
+}
+
+void BM_SignalDef_HasProtonKEAboveThreshold(long niter) {
+  for (long i = 0; i < niter; i++) {
+    gSink += SignalDef::HasProtonKEAboveThreshold(
+        gEvents[i % kNFixtureEvents], 110.0);
+  }
+}
+
+void BM_StatUtils_GetChi2FromDiag(long niter) {
+  for (long i = 0; i < niter; i++) {
+    gSink += StatUtils::GetChi2FromDiag(gDataHist, gMCHist);
+  }
+}
+
+void BM_StatUtils_GetChi2FromCov(long niter) {
+  for (long i = 0; i < niter; i++) {
+    gSink += StatUtils::GetChi2FromCov(gDataHist, gMCHist, gInvCov);
+  }
+}
+
+void BM_StatUtils_GetChi2FromEventRate(long niter) {
+  for (long i = 0; i < niter; i++) {
+    gSink += StatUtils::GetChi2FromEventRate(gDataHist, gMCHist);
+  }
+}
+
+void BM_StatUtils_GetLikelihoodFromCov(long niter) {
+  for (long i = 0; i < niter; i++) {
+    gSink += StatUtils::GetLikelihoodFromCov(gDataHist, gMCHist, gInvCov);
+  }
+}
+
+void BM_SplineReader_CalcWeight(long niter) {
+  for (long i = 0; i < niter; i++) {
+    gSink += gSplineReader->CalcWeight(
+        &gSplineCoeffs[(i % kNFixtureEvents) * gSplineNPar]);
+  }
+}
+
+void BM_Measurement1D_FillHistograms(long niter) {
+  for (long i = 0; i < niter; i++) {
+    gSample->SetXVar(gSampleXVals[i % kNFixtureEvents]);
+    gSample->SetSignal(true);
+    gSample->FillHistograms(1.0);
+  }
+  gSample->ResetAll();
+}
+
+void BM_JointFCN_DoEval(long niter) {
+  double x[1];
+  for (long i = 0; i < niter; i++) {
+    x[0] = (i % 2) ? 1.05 : 1.0;
+    gSink += gFCN->DoEval(x);
+  }
+}
+
+void BM_JointFCN_ReconfigureAllEvents(long niter) {
+  for (long i = 0; i < niter; i++) {
+    gFCN->ReconfigureAllEvents();
+    gSink += gFCN->GetLikelihood();
+  }
+}
+
+//*******************************
+int main(int argc, char *argv[]) {
+  //*******************************
+
+  GetCommandLineArgs(argc, argv);
+
+  gVerbosity = Config::GetParI("VERBOSITY");
+  SETVERBOSITY(gVerbosity);
+  SETTRACE(Config::GetParB("TRACE"));
+
+  NUIS_LOG(FIT, "Setting up nuisbench fixtures");
+  SetupEventFixtures();
+  SetupStatFixtures();
+  SetupSplineFixtures();
+  SetupSampleFixtures();
+
+  NUIS_LOG(FIT, "------------");
+  NUIS_LOG(FIT, Form("%-40s %19s %19s %12s", "Benchmark", "Time", "CPU",
+                     "Iterations"));
+
+  RunBenchmark("SyntheticInput_GetNuisanceEvent",
+               BM_SyntheticInput_GetNuisanceEvent);
+  RunBenchmark("FitEvent_OrderStack", BM_FitEvent_OrderStack);
+  RunBenchmark("SignalDef_isCCINC", BM_SignalDef_isCCINC);
+  RunBenchmark("SignalDef_isCC0pi", BM_SignalDef_isCC0pi);
+  RunBenchmark("SignalDef_isCCQELike", BM_SignalDef_isCCQELike);
+  RunBenchmark("SignalDef_isCC1pi", BM_SignalDef_isCC1pi);
+  RunBenchmark("SignalDef_HasProtonKEAboveThreshold",
+               BM_SignalDef_HasProtonKEAboveThreshold);
+  RunBenchmark("StatUtils_GetChi2FromDiag", BM_StatUtils_GetChi2FromDiag);
+  RunBenchmark("StatUtils_GetChi2FromCov", BM_StatUtils_GetChi2FromCov);
+  RunBenchmark("StatUtils_GetChi2FromEventRate",
+               BM_StatUtils_GetChi2FromEventRate);
+  RunBenchmark("StatUtils_GetLikelihoodFromCov",
+               BM_StatUtils_GetLikelihoodFromCov);
+  RunBenchmark("SplineReader_CalcWeight", BM_SplineReader_CalcWeight);
+  if (gSample) {
+    RunBenchmark("Measurement1D_FillHistograms",
+                 BM_Measurement1D_FillHistograms);
+  }
+  RunBenchmark("JointFCN_DoEval", BM_JointFCN_DoEval);
+  RunBenchmark("JointFCN_ReconfigureAllEvents",
+               BM_JointFCN_ReconfigureAllEvents);
+
+  NUIS_LOG(FIT, "------------");
+  WriteResults();
+
+  return 0;
+}
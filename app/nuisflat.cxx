@@ -21,6 +21,7 @@
 #include "GenericFlux_Vectors.h"
 #include "InputUtils.h"
 #include "MeasurementBase.h"
+#include "ParallelUtils.h"
 #include "Smearceptance_Tester.h"
 
 // Global Arguments
@@ -31,6 +32,7 @@ std::string gOptType = "DEFAULT";
 std::string gOptNumberEvents = "NULL";
 std::string gOptCardInput = "";
 std::string gOptOptions = "";
+std::string gOptColumns = "";
 
 // Input Dial Vals
 std::vector<std::string> fParams;              ///< Vector of dial names.
@@ -48,7 +50,7 @@ void PrintSyntax() {
   //*******************************
 
   std::cout << "nuisflat -i input [-f format]  [-o outfile] [-n nevents] [-t "
-               "options] [-q con=val] \n";
+               "options] [-v columns] [-q con=val] \n";
   std::cout
       << "\n Arguments : "
       << "\n\t -i input   : Path to input vector of events to flatten"
@@ -76,6 +78,12 @@ void PrintSyntax() {
       << "\n\t[-t options]: Pass OPTION to the FlatTree sample. "
       << "\n\t              Similar to type field in comparison xml configs."
       << "\n\t"
+      << "\n\t[-v columns]: GenericVectors only. Comma separated variables or "
+         "name=expression"
+      << "\n\t              to compute and save to a columnar file instead "
+         "of the full tree."
+      << "\n\t              {e.g. Q2,Enu_true,nfsp,pdg,Erec=ELep+q0}"
+      << "\n\t"
       << "\n\t[-q con=val]: Configuration overrides." << std::endl;
 
   exit(-1);
@@ -145,6 +153,13 @@ void GetCommandLineArgs(int argc, char **argv) {
   if (gOptOptions != "") {
     NUIS_LOG(FIT, "Read options: \"" << gOptOptions << "\'");
   }
+
+  // Set directly as the expressions may contain '='
+  ParserUtils::ParseArgument(args, "-v", gOptColumns, false);
+  if (gOptColumns != "") {
+    NUIS_LOG(FIT, "Saving columns: " << gOptColumns);
+    configuration.SetConfig("nuisflat_Columns", gOptColumns);
+  }
   return;
 }
 
@@ -165,6 +180,13 @@ int main(int argc, char *argv[]) {
   SETVERBOSITY(verbocount);
   SETTRACE(trace);
 
+  // The columnar writer compresses the columns of each chunk on threads,
+  // which must be enabled before any are started
+  if (!Config::GetParS("nuisflat_Columns").empty() &&
+      ParallelUtils::GetNWorkers("cores") > 1) {
+    ParallelUtils::EnableThreads();
+  }
+
   // Make output file
   TFile *f = new TFile(gOptOutputFile.c_str(), "RECREATE");
   if (f->IsZombie()) {
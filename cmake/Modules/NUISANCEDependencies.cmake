@@ -233,4 +233,25 @@ if (HepMC3_ENABLED)
         "HEPMC3_INSTALL_INTERFACES OFF"
         "HEPMC3_BUILD_STATIC_LIBS OFF"
   )
-endif()
\ No newline at end of file
+endif()
+#### Identifies the build and the generator/reweight versions it links, for
+#### caches of generator predictions that must not outlive either
+
+set(NUISANCE_BUILD_ID "NUISANCE-${NUISANCE_VERSION}")
+find_package(Git QUIET)
+if(GIT_FOUND)
+  execute_process(COMMAND ${GIT_EXECUTABLE} describe --always --dirty
+    WORKING_DIRECTORY ${CMAKE_SOURCE_DIR}
+    OUTPUT_VARIABLE NUISANCE_GIT_DESCRIBE
+    OUTPUT_STRIP_TRAILING_WHITESPACE ERROR_QUIET)
+  if(NUISANCE_GIT_DESCRIBE)
+    set(NUISANCE_BUILD_ID "${NUISANCE_BUILD_ID}-${NUISANCE_GIT_DESCRIBE}")
+  endif()
+endif()
+
+foreach(DEP NEUT GENIE NuWro T2KReWeight NOvARwgt nusystematics Prob3plusplus)
+  if(${DEP}_ENABLED)
+    set(NUISANCE_BUILD_ID "${NUISANCE_BUILD_ID},${DEP}-${${DEP}_VERSION}")
+  endif()
+endforeach()
+cmessage(STATUS "NUISANCE build id: ${NUISANCE_BUILD_ID}")
@@ -60,6 +60,7 @@ ANL_CC1npip_Evt_1DQ2_nu::ANL_CC1npip_Evt_1DQ2_nu(nuiskey samplekey) {
   fScaleFactor = (GetEventHistogram()->Integral() / double(fNEvents));
 
   // Plot Setup -------------------------------------------------------
+  fDeferLoading = true;
   SetDataFromTextFile( fSettings.GetDataInput() );
   SetPoissonErrors();
   SetCovarFromDiagonal();
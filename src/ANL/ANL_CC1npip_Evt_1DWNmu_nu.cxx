@@ -50,6 +50,7 @@ ANL_CC1npip_Evt_1DWNmu_nu::ANL_CC1npip_Evt_1DWNmu_nu(nuiskey samplekey) {
   fScaleFactor = GetEventHistogram()->Integral("width") / (fNEvents + 0.) * 2. / 1.;
 
   // Plot Setup -------------------------------------------------------
+  fDeferLoading = true;
   SetDataFromTextFile( fSettings.GetDataInput() );
   SetPoissonErrors();
   SetCovarFromDiagonal();
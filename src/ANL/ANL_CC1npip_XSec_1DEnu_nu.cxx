@@ -104,6 +104,7 @@ ANL_CC1npip_XSec_1DEnu_nu::ANL_CC1npip_XSec_1DEnu_nu(nuiskey samplekey) {
                   (fNEvents + 0.));
 
   // Plot Setup -------------------------------------------------------
+  fDeferLoading = true;
   SetDataFromTextFile(fSettings.GetDataInput());
   SetCovarFromDiagonal();
 
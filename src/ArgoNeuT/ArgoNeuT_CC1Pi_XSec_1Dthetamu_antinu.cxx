@@ -50,6 +50,7 @@ ArgoNeuT_CC1Pi_XSec_1Dthetamu_antinu::ArgoNeuT_CC1Pi_XSec_1Dthetamu_antinu(nuisk
                  TotalIntegratedFlux("width");
 
   // Plot Setup -------------------------------------------------------
+  fDeferLoading = true;
   SetDataFromTextFile( fSettings.GetDataInput() );
   ScaleData(1E-38);
   SetCovarFromDiagonal();
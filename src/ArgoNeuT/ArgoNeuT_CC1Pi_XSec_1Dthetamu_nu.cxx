@@ -50,6 +50,7 @@ ArgoNeuT_CC1Pi_XSec_1Dthetamu_nu::ArgoNeuT_CC1Pi_XSec_1Dthetamu_nu(nuiskey sampl
                  TotalIntegratedFlux("width");
 
   // Plot Setup -------------------------------------------------------
+  fDeferLoading = true;
   SetDataFromTextFile( fSettings.GetDataInput() );
   ScaleData(1E-38);
   SetCovarFromDiagonal();
@@ -50,6 +50,7 @@ BNL_CC2pi_1pim1pip_Evt_1DWpippim_nu::BNL_CC2pi_1pim1pip_Evt_1DWpippim_nu(nuiskey
   fScaleFactor = GetEventHistogram()->Integral("width")/double(fNEvents) * 2.0 / 1.0 ;
 
   // Plot Setup -------------------------------------------------------
+  fDeferLoading = true;
   SetDataFromTextFile( fSettings.GetDataInput() );
   SetPoissonErrors();
   SetCovarFromDiagonal();
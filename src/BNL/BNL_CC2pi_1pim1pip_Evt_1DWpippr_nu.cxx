@@ -51,6 +51,7 @@ BNL_CC2pi_1pim1pip_Evt_1DWpippr_nu::BNL_CC2pi_1pim1pip_Evt_1DWpippr_nu(nuiskey s
   fScaleFactor = GetEventHistogram()->Integral("width")/double(fNEvents) * 2.0 / 1.0 ;
 
   // Plot Setup -------------------------------------------------------
+  fDeferLoading = true;
   SetDataFromTextFile( fSettings.GetDataInput() );
   SetPoissonErrors();
   SetCovarFromDiagonal();
@@ -89,182 +89,29 @@ void ElectronScattering_DurhamData::SetDataFromName(std::string name) {
   fZCenter = GeneralUtils::StrToDbl(estring);
 
   // Create effective E and Theta bin Edges
-  std::vector<double> thetabinedges;
-  std::vector<double> ebinedges;
-
-  int nthetabins = FitPar::Config().GetParI("Electron_NThetaBins");
-  int nebins = FitPar::Config().GetParI("Electron_NEnergyBins");
-  double thetawidth = FitPar::Config().GetParD("Electron_ThetaWidth");
-  double ewidth = FitPar::Config().GetParD("Electron_EnergyWidth");
-
-  for (int i = -nthetabins; i <= nthetabins; i++) {
-    thetabinedges.push_back(fYCenter + thetawidth * (double(i)));
-  }
-  for (int i = -nebins; i <= nebins; i++) {
-    double newval = fZCenter + ewidth * (double(i));
-
-    if (newval < 0.0) newval = 0.0;
-    if (newval < GetEventHistogram()->GetXaxis()->GetXmin())
-      newval = GetEventHistogram()->GetXaxis()->GetXmin();
-    if (newval > GetEventHistogram()->GetXaxis()->GetXmax())
-      newval = GetEventHistogram()->GetXaxis()->GetXmax();
-    if (std::find(ebinedges.begin(), ebinedges.end(), newval) !=
-        ebinedges.end())
-      continue;
-    ebinedges.push_back(newval);
-  }
-
-  // Determine target
-  std::string target = "";
-  if (!zstring.compare("6") && !astring.compare("12"))
-    target = "12C.dat";
-  else if (!zstring.compare("8") && !astring.compare("16"))
-    target = "16O.dat";
-  else {
-    NUIS_ABORT("Target not supported in electron scattering module!"
-    );
-  }
-
-  // Fill Data Points
-
-  std::string line;
-  std::ifstream mask((FitPar::GetDataBase() + "/Electron/" + target).c_str(),
-                     std::ifstream::in);
-
-  if (!mask.good()) {
-    NUIS_ABORT("Failed to open e-scattering database file: "
-             << (FitPar::GetDataBase() + "/Electron/" + target));
-  }
-  int i = 0;
-
-  std::vector<double> pointx;
-  std::vector<double> errorx;
-  std::vector<double> pointy;
-  std::vector<double> errory;
-  double scalef = 1.E-38 * 1.E5;
-
-  while (std::getline(mask >> std::ws, line, '\n')) {
-    // std::cout << "Line = " << line << std::endl;
-    if (line.empty()) continue;
-
-    std::vector<std::string> lineentries = GeneralUtils::ParseToStr(line, " ");
-    // std::cout << "Checking : " << line << std::endl;
-    if (zstring.compare(lineentries[0])) continue;
-    if (astring.compare(lineentries[1])) continue;
-    if (estring.compare(lineentries[2])) continue;
-    if (tstring.compare(lineentries[3])) continue;
-    if (sstring.compare(lineentries[7])) continue;
-
-    // std::cout << "Registering data point : " << line << std::endl;
-    // std::cout << "Adding Graph Point : " <<
-    // GeneralUtils::StrToDbl(lineentries[4]) << " " <<
-    // GeneralUtils::StrToDbl(lineentries[5]) << std::endl;
-
-    // Loop through x and y points and find a place to insert
-    if (pointx.empty()) {
-      pointx.push_back(GeneralUtils::StrToDbl(lineentries[4]));
-      errorx.push_back(0.0);
-      pointy.push_back(GeneralUtils::StrToDbl(lineentries[5]) * scalef);
-      errory.push_back(GeneralUtils::StrToDbl(lineentries[6]) * scalef);
-
-    } else {
-      for (size_t j = 0; j < pointx.size(); j++) {
-        if (GeneralUtils::StrToDbl(lineentries[4]) < pointx[j] && j == 0) {
-          // std::cout << "Inserting at start point iterator " << std::endl;
-          pointx.insert(pointx.begin() + j,
-                        GeneralUtils::StrToDbl(lineentries[4]));
-          errorx.insert(errorx.begin() + j, 0.0);
-          pointy.insert(pointy.begin() + j,
-                        GeneralUtils::StrToDbl(lineentries[5]) * scalef);
-          errory.insert(errory.begin() + j,
-                        GeneralUtils::StrToDbl(lineentries[6]) * scalef);
-          break;
-
-        } else if (GeneralUtils::StrToDbl(lineentries[4]) > pointx[j] &&
-                   j == pointx.size() - 1) {
-          // std::cout << "Pushing back data point " << std::endl;
-          pointx.push_back(GeneralUtils::StrToDbl(lineentries[4]));
-          errorx.push_back(0.0);
-          pointy.push_back(GeneralUtils::StrToDbl(lineentries[5]) * scalef);
-          errory.push_back(GeneralUtils::StrToDbl(lineentries[6]) * scalef);
-          break;
-
-        } else if (GeneralUtils::StrToDbl(lineentries[4]) > pointx[j - 1] &&
-                   GeneralUtils::StrToDbl(lineentries[4]) < pointx[j]) {
-          // std::cout << "Inserting at point iterator = " << j << std::endl;
-
-          pointx.insert(pointx.begin() + j,
-                        GeneralUtils::StrToDbl(lineentries[4]));
-          errorx.insert(errorx.begin() + j, 0.0);
-          pointy.insert(pointy.begin() + j,
-                        GeneralUtils::StrToDbl(lineentries[5]) * scalef);
-          errory.insert(errory.begin() + j,
-                        GeneralUtils::StrToDbl(lineentries[6]) * scalef);
-          break;
-        }
-      }
-    }
-
-    // pointx.push_back(GeneralUtils::StrToDbl(lineentries[4]));
-    // errorx.push_back(0.0);
-    // pointy.push_back(GeneralUtils::StrToDbl(lineentries[5]));
-    // errory.push_back(GeneralUtils::StrToDbl(lineentries[6]));
-
-    i++;
-  }
-
-  if (!pointx.size() || (pointx.size() != errorx.size()) || !pointy.size() ||
-      (pointy.size() != errory.size())) {
+  std::vector<double> thetabinedges = DurhamDatabase::GetThetaBinEdges(fYCenter);
+  std::vector<double> ebinedges = DurhamDatabase::GetEnergyBinEdges(
+      fZCenter, GetEventHistogram()->GetXaxis()->GetXmin(),
+      GetEventHistogram()->GetXaxis()->GetXmax());
+
+  // Fill Data Points from the shared database
+  DurhamDatabase::DataSet const *data = DurhamDatabase::FindDataSet(
+      zstring, astring, estring, tstring, sstring);
+  if (!data) {
     NUIS_ABORT("Failed to find dataset: " << name << "{"
              << "Z: " << zstring << ", A: " << astring << ", E: " << estring
              << ", CTheta: " << tstring << ", PubID: " << sstring
-             << " } in file: "
-             << (FitPar::GetDataBase() + "/Electron/" + target));
+             << " } in the e-scattering database.");
   }
 
-  // for (uint i  = 0; i < pointx.size(); i++) {
-  //   std::cout << "Q0 Point " << i << " = " << pointx[i] << std::endl;
-  // }
-
-  fDataGraph = new TGraphErrors(pointx.size(), &pointx[0], &pointy[0],
-                                &errorx[0], &errory[0]);
+  std::vector<double> errorx(data->Q0.size(), 0.0);
+  fDataGraph = new TGraphErrors(data->Q0.size(), &data->Q0[0], &data->XSec[0],
+                                &errorx[0], &data->Error[0]);
   fDataGraph->SetNameTitle((fName + "_data_GRAPH").c_str(),
                            (fName + "_data_GRAPH").c_str());
 
   // Now form an effective data and mc histogram
-  std::vector<double> q0binedges;
-  const double* x = fDataGraph->GetX();
-
-  // Loop over graph and get mid way point between each data point.
-  for (int i = 0; i < fDataGraph->GetN(); i++) {
-    // std::cout << "X Point = " << x[i] << std::endl;
-
-    if (i == 0) {
-      // First point set lower width as half distance to point above
-      q0binedges.push_back(x[0] - ((x[1] - x[0]) / 2.0));
-    } else if (i == fDataGraph->GetN() - 1) {
-      // Last point set upper width as half distance to point above.
-      q0binedges.push_back(x[i] - ((x[i] - x[i - 1]) / 2.0));
-      q0binedges.push_back(x[i] + ((x[i] - x[i - 1]) / 2.0));
-    } else {
-      // Set half distance to point below
-      q0binedges.push_back(x[i] - ((x[i] - x[i - 1]) / 2.0));
-    }
-  }
-
-  // Bubble Sort
-
-  // for (uint i  = 0; i < q0binedges.size(); i++) {
-  //   std::cout << "Q0 Edge " << i << " = " << q0binedges[i] << std::endl;
-  // }
-
-  // for (uint i  = 0; i < ebinedges.size(); i++) {
-  //   std::cout << "e Edge " << i << " = " << ebinedges[i] << std::endl;
-  // }
-  // for (uint i  = 0; i < thetabinedges.size(); i++) {
-  //   std::cout << "theta Edge " << i << " = " << thetabinedges[i] <<
-  //   std::endl;
-  // }
+  std::vector<double> q0binedges = DurhamDatabase::GetQ0BinEdges(*data);
 
   // Form the data hist, mchist, etc
   fDataHist = new TH1D((fName + "_data").c_str(), (fName + "_data").c_str(),
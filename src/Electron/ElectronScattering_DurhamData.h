@@ -20,6 +20,7 @@
 #ifndef ElectronScattering_DurhamData_H_SEEN
 #define ElectronScattering_DurhamData_H_SEEN
 
+#include "ElectronScattering_DurhamDatabase.h"
 #include "Measurement1D.h"
 #include "TH3D.h"
 
@@ -43,8 +44,7 @@ void SetDataFromName(std::string name);
   int GetNDOF();
   double GetLikelihood();
   void SetFitOptions(std::string opt);
-  // MeasurementVariableBox* CreateBox() {return new MeasurementVariableBox1D();};
-  // ElectronVariableBox* GetBox() { return static_cast<ElectronVariableBox*>(MeasurementBase::GetBox()); };
+  MeasurementVariableBox* CreateBox() {return new ElectronVariableBox();};
 
   TH1D* GetMCHistogram(void);
   TH1D* GetDataHistogram(void);
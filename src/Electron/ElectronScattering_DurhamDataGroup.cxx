@@ -0,0 +1,328 @@
+// Copyright 2016-2021 L. Pickering, P Stowell, R. Terri, C. Wilkinson, C. Wret
+
+/*******************************************************************************
+*    This file is part of NUISANCE.
+*
+*    NUISANCE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    NUISANCE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with NUISANCE.  If not, see <http://www.gnu.org/licenses/>.
+*******************************************************************************/
+
+#include "ElectronScattering_DurhamDataGroup.h"
+
+#include <algorithm>
+
+//********************************************************************
+ElectronScattering_DurhamDataGroup::ElectronScattering_DurhamDataGroup(
+    nuiskey samplekey) {
+  //********************************************************************
+
+  // Sample overview ---------------------------------------------------
+  std::string descrip =
+      "Electron Scattering Durham Data group sample. \n"
+      "Target: Multiple \n"
+      "Flux: Energy range should cover the data being handled \n"
+      "Signal: Any event with an electron in the final state inside one of "
+      "the data set windows \n";
+  fSettings = LoadSampleSettings(samplekey);
+  fSettings.SetDescription(descrip);
+  fSettings.DefineAllowedSpecies("electron");
+  fSettings.SetTitle("Electron");
+  fSettings.SetAllowedTypes("FIX/DIAG", "FIX,FREE,SHAPE/DIAG/NORM/MASK");
+  fSettings.SetXTitle("Data set q0 bin");
+  fSettings.SetYTitle("#sigma");
+  fIsNoWidth = true;
+  fWindowScale = NULL;
+  fWindowScaleFine = NULL;
+
+  FinaliseSampleSettings();
+
+  // Plot Setup -------------------------------------------------------
+  SetDataFromName(fSettings.GetS("originalname"));
+  SetCovarFromDiagonal();
+
+  // Scaling Setup ---------------------------------------------------
+  // The flux integral is applied per window in ScaleEvents
+  EnuMin = fEnergyEdges.front();
+  EnuMax = fEnergyEdges.back();
+
+  fScaleFactor = GetEventHistogram()->Integral() * 1E-38 / double(fNEvents);
+
+  // Finish up
+  FinaliseMeasurement();
+  SetupWindowScales();
+};
+
+//********************************************************************
+void ElectronScattering_DurhamDataGroup::SetupWindowScales() {
+  //********************************************************************
+
+  // Each window is divided by the flux integrated over its own energy range,
+  // as its ElectronData_ sample is
+  fWindowScale = (TH1D *)fMCHist->Clone((fName + "_window_scale").c_str());
+  fWindowScale->Reset();
+  fWindowScale->SetDirectory(NULL);
+  for (size_t i = 0; i < fWindows.size(); i++) {
+    Window &window = fWindows[i];
+    double flux = TotalIntegratedFlux("width", window.elow, window.ehigh);
+    window.fluxscale = (flux > 0.0) ? 1.0 / flux : 0.0;
+    for (size_t j = 0; j < window.data->Q0.size(); j++) {
+      fWindowScale->SetBinContent(window.offset + j + 1, window.fluxscale);
+    }
+  }
+
+  // Fine bins take the scale of the flat bin they sit in
+  fWindowScaleFine =
+      (TH1D *)fMCFine->Clone((fName + "_window_scale_fine").c_str());
+  fWindowScaleFine->Reset();
+  fWindowScaleFine->SetDirectory(NULL);
+  for (int i = 0; i < fWindowScaleFine->GetNbinsX(); i++) {
+    int bin = fWindowScale->FindBin(fWindowScaleFine->GetBinCenter(i + 1));
+    fWindowScaleFine->SetBinContent(i + 1, fWindowScale->GetBinContent(bin));
+  }
+}
+
+//********************************************************************
+void ElectronScattering_DurhamDataGroup::ScaleEvents() {
+  //********************************************************************
+
+  Measurement1D::ScaleEvents();
+
+  fMCHist->Multiply(fWindowScale);
+  fMCFine->Multiply(fWindowScaleFine);
+  if (fMCHist_Modes)
+    fMCHist_Modes->Multiply(fWindowScale);
+  if (fMCFine_Modes)
+    fMCFine_Modes->Multiply(fWindowScaleFine);
+}
+
+//********************************************************************
+void ElectronScattering_DurhamDataGroup::SetDataFromName(std::string name) {
+  //********************************************************************
+
+  // Data Should be given in the format
+  // ElectronDataGroup_Z_A or ElectronDataGroup_Z_A_Source
+  std::vector<std::string> splitstring = GeneralUtils::ParseToStr(name, "_");
+  if (splitstring.size() < 3) {
+    NUIS_ABORT("Electron group sample " << name
+                                        << " should be named "
+                                           "ElectronDataGroup_Z_A[_Source]");
+  }
+  std::string zstring = splitstring[1];
+  std::string astring = splitstring[2];
+  std::string sstring = (splitstring.size() > 3) ? splitstring[3] : "";
+
+  double emin = GetEventHistogram()->GetXaxis()->GetXmin();
+  double emax = GetEventHistogram()->GetXaxis()->GetXmax();
+
+  // Data sets the input energy range can be compared to
+  std::vector<DurhamDatabase::DataSet> const &datasets =
+      DurhamDatabase::GetDataSets(zstring, astring);
+  int nbins = 0;
+  int nskipped = 0;
+  for (size_t i = 0; i < datasets.size(); i++) {
+    DurhamDatabase::DataSet const &data = datasets[i];
+    if (!sstring.empty() && data.Source != sstring)
+      continue;
+    if (data.Q0.size() < 2 || data.Energy < emin || data.Energy > emax) {
+      nskipped++;
+      continue;
+    }
+
+    std::vector<double> thetaedges =
+        DurhamDatabase::GetThetaBinEdges(data.Angle);
+    std::vector<double> eedges =
+        DurhamDatabase::GetEnergyBinEdges(data.Energy, emin, emax);
+
+    Window window;
+    window.data = &data;
+    window.elow = eedges.front();
+    window.ehigh = eedges.back();
+    window.tlow = thetaedges.front();
+    window.thigh = thetaedges.back();
+    window.q0edges = DurhamDatabase::GetQ0BinEdges(data);
+    window.offset = nbins;
+    window.fluxscale = 0.0;
+    nbins += data.Q0.size();
+    fWindows.push_back(window);
+  }
+
+  if (fWindows.empty()) {
+    NUIS_ABORT("No electron data sets for " << name << " in the input energy "
+                                            << "range " << emin << " -- "
+                                            << emax);
+  }
+  NUIS_LOG(SAM, name << " holds " << fWindows.size() << " data sets with "
+                     << nbins << " points, skipped " << nskipped
+                     << " outside the input energy range or with < 2 points.");
+
+  // Form the flat data and mc histograms
+  fDataHist = new TH1D((fName + "_data").c_str(), (fName + "_data").c_str(),
+                       nbins, 0.0, double(nbins));
+  for (size_t i = 0; i < fWindows.size(); i++) {
+    DurhamDatabase::DataSet const &data = *fWindows[i].data;
+    for (size_t j = 0; j < data.Q0.size(); j++) {
+      fDataHist->SetBinContent(fWindows[i].offset + j + 1, data.XSec[j]);
+      fDataHist->SetBinError(fWindows[i].offset + j + 1, data.Error[j]);
+    }
+  }
+  fMCHist = (TH1D*)fDataHist->Clone("MC");
+  fMCHist->Reset();
+
+  // Energy lookup, each interval lists every window that touches it so an
+  // energy on an interval edge still finds all of its windows
+  for (size_t i = 0; i < fWindows.size(); i++) {
+    fEnergyEdges.push_back(fWindows[i].elow);
+    fEnergyEdges.push_back(fWindows[i].ehigh);
+  }
+  std::sort(fEnergyEdges.begin(), fEnergyEdges.end());
+  fEnergyEdges.erase(std::unique(fEnergyEdges.begin(), fEnergyEdges.end()),
+                     fEnergyEdges.end());
+
+  size_t nintervals = std::max(size_t(1), fEnergyEdges.size() - 1);
+  fEnergyWindows.assign(nintervals, std::vector<int>());
+  for (size_t k = 0; k < nintervals; k++) {
+    double lo = fEnergyEdges[k];
+    double hi = fEnergyEdges[std::min(k + 1, fEnergyEdges.size() - 1)];
+    for (size_t i = 0; i < fWindows.size(); i++) {
+      if (fWindows[i].elow <= hi && fWindows[i].ehigh >= lo)
+        fEnergyWindows[k].push_back(i);
+    }
+  }
+}
+
+//********************************************************************
+void ElectronScattering_DurhamDataGroup::FindBins(double q0, double theta,
+                                                  double E,
+                                                  std::vector<int>& bins) {
+  //********************************************************************
+
+  bins.clear();
+  if (!(E >= fEnergyEdges.front() && E <= fEnergyEdges.back()))
+    return;
+
+  size_t k = std::upper_bound(fEnergyEdges.begin(), fEnergyEdges.end(), E) -
+             fEnergyEdges.begin();
+  k = std::min(k > 0 ? k - 1 : 0, fEnergyWindows.size() - 1);
+
+  std::vector<int> const& candidates = fEnergyWindows[k];
+  for (size_t i = 0; i < candidates.size(); i++) {
+    Window const& window = fWindows[candidates[i]];
+    if (E < window.elow || E > window.ehigh)
+      continue;
+    if (theta < window.tlow || theta > window.thigh)
+      continue;
+
+    // Same as filling a TH1 with these edges, overflow is dropped
+    std::vector<double> const& edges = window.q0edges;
+    if (!(q0 >= edges.front() && q0 < edges.back()))
+      continue;
+    bins.push_back(window.offset +
+                   (std::upper_bound(edges.begin(), edges.end(), q0) -
+                    edges.begin()) - 1);
+  }
+}
+
+//********************************************************************
+void ElectronScattering_DurhamDataGroup::FillEventVariables(FitEvent* event) {
+  //********************************************************************
+
+  if (event->NumFSParticle(11) == 0) return;
+
+  FitParticle* ein = event->PartInfo(0);
+  FitParticle* eout = event->GetHMFSParticle(11);
+
+  double q0 = fabs(ein->fP.E() - eout->fP.E()) / 1000.0;
+  double E = ein->fP.E() / 1000.0;
+  double theta = ein->fP.Vect().Angle(eout->fP.Vect()) * 180. / M_PI;
+
+  fXVar = q0;
+  fYVar = theta;
+  fZVar = E;
+
+  return;
+};
+
+//********************************************************************
+bool ElectronScattering_DurhamDataGroup::isSignal(FitEvent* event) {
+  //********************************************************************
+
+  if (event->NumFSParticle(11) == 0) return false;
+
+  FindBins(fXVar, fYVar, fZVar, fEventBins);
+  return !fEventBins.empty();
+};
+
+//********************************************************************
+void ElectronScattering_DurhamDataGroup::FillHistograms() {
+  //********************************************************************
+
+  if (!Signal) return;
+
+  // One fill per matching window at its flat bin
+  double q0 = fXVar;
+  FindBins(fXVar, fYVar, fZVar, fEventBins);
+  for (size_t i = 0; i < fEventBins.size(); i++) {
+    fXVar = fMCHist->GetBinCenter(fEventBins[i] + 1);
+    Measurement1D::FillHistograms();
+  }
+  fXVar = q0;
+}
+
+//********************************************************************
+int ElectronScattering_DurhamDataGroup::GetBoxBin(
+    MeasurementVariableBox* var) {
+  //********************************************************************
+  FindBins(var->GetX(), var->GetY(), var->GetZ(), fEventBins);
+  return fEventBins.empty() ? -1 : fEventBins[0] + 1;
+}
+
+//********************************************************************
+int ElectronScattering_DurhamDataGroup::GetNDOF() {
+  //********************************************************************
+  return fDataHist->GetNbinsX();
+}
+
+//********************************************************************
+void ElectronScattering_DurhamDataGroup::Write(std::string drawOpts) {
+  //********************************************************************
+  Measurement1D::Write(drawOpts);
+
+  // q0 histogram and data graph for each data set, from the flat histograms
+  for (size_t i = 0; i < fWindows.size(); i++) {
+    Window const& window = fWindows[i];
+    DurhamDatabase::DataSet const& data = *window.data;
+    std::string name =
+        fName + "_" + data.E + "_" + data.Theta + "_" + data.Source;
+
+    TH1D mc((name + "_MC").c_str(), (name + "_MC").c_str(),
+            window.q0edges.size() - 1, &window.q0edges[0]);
+    for (size_t j = 0; j < data.Q0.size(); j++) {
+      mc.SetBinContent(j + 1, fMCHist->GetBinContent(window.offset + j + 1));
+      mc.SetBinError(j + 1, fMCHist->GetBinError(window.offset + j + 1));
+    }
+    mc.Write();
+
+    std::vector<double> errorx(data.Q0.size(), 0.0);
+    TGraphErrors graph(data.Q0.size(), &data.Q0[0], &data.XSec[0], &errorx[0],
+                       &data.Error[0]);
+    graph.SetNameTitle((name + "_data_GRAPH").c_str(),
+                       (name + "_data_GRAPH").c_str());
+    graph.Write();
+  }
+}
+
+double ElectronScattering_DurhamDataGroup::GetLikelihood() { return 0.0; }
+
+void ElectronScattering_DurhamDataGroup::SetFitOptions(std::string opt) {
+  return;
+}
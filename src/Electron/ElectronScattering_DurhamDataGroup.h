@@ -0,0 +1,87 @@
+// Copyright 2016-2021 L. Pickering, P Stowell, R. Terri, C. Wilkinson, C. Wret
+
+/*******************************************************************************
+*    This file is part of NUISANCE.
+*
+*    NUISANCE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    NUISANCE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with NUISANCE.  If not, see <http://www.gnu.org/licenses/>.
+*******************************************************************************/
+
+#ifndef ElectronScattering_DurhamDataGroup_H_SEEN
+#define ElectronScattering_DurhamDataGroup_H_SEEN
+
+#include "ElectronScattering_DurhamDatabase.h"
+#include "Measurement1D.h"
+
+//********************************************************************
+/// Every Durham data set for a target in one sample, named
+/// ElectronDataGroup_Z_A or ElectronDataGroup_Z_A_Source. Data sets are the
+/// same (E, theta) windows as the ElectronData_ samples, laid out one after
+/// another in a flat histogram, and each event is binned into every window
+/// it falls in. This replaces hundreds of ElectronData_ samples, and their
+/// event loops, sharing the same electron input.
+class ElectronScattering_DurhamDataGroup : public Measurement1D {
+//********************************************************************
+
+public:
+
+  ElectronScattering_DurhamDataGroup(nuiskey samplekey);
+  virtual ~ElectronScattering_DurhamDataGroup() {
+    delete fWindowScale;
+    delete fWindowScaleFine;
+  };
+
+  void FillEventVariables(FitEvent *event);
+  void FillHistograms();
+  void ScaleEvents();
+  bool isSignal(FitEvent *event);
+  void Write(std::string drawOpts);
+  int GetNDOF();
+  double GetLikelihood();
+  void SetFitOptions(std::string opt);
+  MeasurementVariableBox* CreateBox() {return new ElectronVariableBox();};
+  int GetBoxBin(MeasurementVariableBox* var);
+
+private:
+
+  /// Selects the data sets and builds the flat data histogram
+  void SetDataFromName(std::string name);
+
+  /// Per bin 1/flux integral of the window each flat bin belongs to
+  void SetupWindowScales();
+
+  /// Flat bins (from 0) of every window holding (q0, theta, E)
+  void FindBins(double q0, double theta, double E, std::vector<int>& bins);
+
+  /// One data set and the region of (q0, theta, E) it is compared in
+  struct Window {
+    DurhamDatabase::DataSet const* data;
+    double elow, ehigh, tlow, thigh;
+    std::vector<double> q0edges;
+    int offset; ///< Flat bin of the first q0 point
+    double fluxscale; ///< 1 / flux integral over [elow, ehigh]
+  };
+  std::vector<Window> fWindows;
+
+  /// Sorted window energy limits, and the windows overlapping each interval
+  /// between neighbouring limits
+  std::vector<double> fEnergyEdges;
+  std::vector<std::vector<int> > fEnergyWindows;
+
+  std::vector<int> fEventBins;
+
+  TH1D *fWindowScale;     ///< fluxscale of each flat bin
+  TH1D *fWindowScaleFine; ///< fluxscale of each fine bin
+};
+
+#endif
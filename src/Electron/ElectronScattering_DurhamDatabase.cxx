@@ -0,0 +1,202 @@
+// Copyright 2016-2021 L. Pickering, P Stowell, R. Terri, C. Wilkinson, C. Wret
+
+/*******************************************************************************
+*    This file is part of NUISANCE.
+*
+*    NUISANCE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    NUISANCE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with NUISANCE.  If not, see <http://www.gnu.org/licenses/>.
+*******************************************************************************/
+
+#include "ElectronScattering_DurhamDatabase.h"
+
+#include "FitLogger.h"
+#include "GeneralUtils.h"
+#include "NuisConfig.h"
+
+#include <algorithm>
+#include <fstream>
+#include <map>
+
+namespace DurhamDatabase {
+
+namespace {
+// Parsed tables, keyed by target file
+std::map<std::string, std::vector<DataSet> > gDataSets;
+
+// Database cross-sections are in 1E-5 of 1E-38 cm^2
+const double kXSecScale = 1.E-38 * 1.E5;
+
+struct ByQ0 {
+  std::vector<double> const &q0;
+  ByQ0(std::vector<double> const &x) : q0(x) {}
+  bool operator()(size_t i, size_t j) const { return q0[i] < q0[j]; }
+};
+
+std::string GetTargetFile(std::string const &Z, std::string const &A) {
+  if (Z == "6" && A == "12")
+    return "12C.dat";
+  if (Z == "8" && A == "16")
+    return "16O.dat";
+  NUIS_ABORT("Target not supported in electron scattering module!");
+}
+
+// Sort the points of a data set in q0 and drop repeated q0 values
+void SortPoints(DataSet &data) {
+  std::vector<size_t> order(data.Q0.size());
+  for (size_t i = 0; i < order.size(); ++i) {
+    order[i] = i;
+  }
+  std::stable_sort(order.begin(), order.end(), ByQ0(data.Q0));
+
+  std::vector<double> q0, xsec, error;
+  for (size_t i = 0; i < order.size(); ++i) {
+    size_t j = order[i];
+    if (!q0.empty() && data.Q0[j] == q0.back())
+      continue;
+    q0.push_back(data.Q0[j]);
+    xsec.push_back(data.XSec[j]);
+    error.push_back(data.Error[j]);
+  }
+  data.Q0.swap(q0);
+  data.XSec.swap(xsec);
+  data.Error.swap(error);
+}
+} // namespace
+
+std::string DataSet::GetName() const {
+  return "ElectronData_" + Z + "_" + A + "_" + E + "_" + Theta + "_" + Source;
+}
+
+std::vector<DataSet> const &GetDataSets(std::string const &Z,
+                                        std::string const &A) {
+  std::string target = GetTargetFile(Z, A);
+  std::map<std::string, std::vector<DataSet> >::iterator it =
+      gDataSets.find(target);
+  if (it != gDataSets.end())
+    return it->second;
+
+  std::string path = FitPar::GetDataBase() + "/Electron/" + target;
+  std::ifstream table(path.c_str(), std::ifstream::in);
+  if (!table.good()) {
+    NUIS_ABORT("Failed to open e-scattering database file: " << path);
+  }
+
+  // Lines are Z A E Theta q0 xsec error source
+  std::vector<DataSet> &datasets = gDataSets[target];
+  std::map<std::string, size_t> index;
+  std::string line;
+  while (std::getline(table >> std::ws, line, '\n')) {
+    if (line.empty())
+      continue;
+
+    std::vector<std::string> entries = GeneralUtils::ParseToStr(line, " ");
+    if (entries.size() < 8)
+      continue;
+
+    std::string key = entries[0] + "_" + entries[1] + "_" + entries[2] + "_" +
+                      entries[3] + "_" + entries[7];
+    std::map<std::string, size_t>::iterator iset = index.find(key);
+    if (iset == index.end()) {
+      DataSet data;
+      data.Z = entries[0];
+      data.A = entries[1];
+      data.E = entries[2];
+      data.Theta = entries[3];
+      data.Source = entries[7];
+      data.Energy = GeneralUtils::StrToDbl(data.E);
+      data.Angle = GeneralUtils::StrToDbl(data.Theta);
+      iset = index.insert(std::make_pair(key, datasets.size())).first;
+      datasets.push_back(data);
+    }
+
+    DataSet &data = datasets[iset->second];
+    data.Q0.push_back(GeneralUtils::StrToDbl(entries[4]));
+    data.XSec.push_back(GeneralUtils::StrToDbl(entries[5]) * kXSecScale);
+    data.Error.push_back(GeneralUtils::StrToDbl(entries[6]) * kXSecScale);
+  }
+
+  for (size_t i = 0; i < datasets.size(); ++i) {
+    SortPoints(datasets[i]);
+  }
+
+  NUIS_LOG(SAM, "Read " << datasets.size()
+                        << " electron scattering data sets from " << path);
+  return datasets;
+}
+
+DataSet const *FindDataSet(std::string const &Z, std::string const &A,
+                           std::string const &E, std::string const &Theta,
+                           std::string const &Source) {
+  std::vector<DataSet> const &datasets = GetDataSets(Z, A);
+  for (size_t i = 0; i < datasets.size(); ++i) {
+    DataSet const &data = datasets[i];
+    if (data.Z == Z && data.A == A && data.E == E && data.Theta == Theta &&
+        data.Source == Source)
+      return &data;
+  }
+  return NULL;
+}
+
+std::vector<double> GetQ0BinEdges(DataSet const &data) {
+  std::vector<double> const &x = data.Q0;
+  if (x.size() < 2) {
+    NUIS_ABORT("Electron data set " << data.GetName() << " has " << x.size()
+                                    << " points, at least 2 are needed to "
+                                       "form q0 bins.");
+  }
+
+  // Mid way between each data point, mirrored at the ends
+  std::vector<double> edges;
+  edges.push_back(x[0] - ((x[1] - x[0]) / 2.0));
+  for (size_t i = 1; i < x.size(); ++i) {
+    edges.push_back(x[i] - ((x[i] - x[i - 1]) / 2.0));
+  }
+  size_t n = x.size() - 1;
+  edges.push_back(x[n] + ((x[n] - x[n - 1]) / 2.0));
+  return edges;
+}
+
+std::vector<double> GetThetaBinEdges(double theta) {
+  int nthetabins = FitPar::Config().GetParI("Electron_NThetaBins");
+  double thetawidth = FitPar::Config().GetParD("Electron_ThetaWidth");
+
+  std::vector<double> edges;
+  for (int i = -nthetabins; i <= nthetabins; i++) {
+    edges.push_back(theta + thetawidth * (double(i)));
+  }
+  return edges;
+}
+
+std::vector<double> GetEnergyBinEdges(double energy, double emin,
+                                      double emax) {
+  int nebins = FitPar::Config().GetParI("Electron_NEnergyBins");
+  double ewidth = FitPar::Config().GetParD("Electron_EnergyWidth");
+
+  std::vector<double> edges;
+  for (int i = -nebins; i <= nebins; i++) {
+    double newval = energy + ewidth * (double(i));
+
+    if (newval < 0.0)
+      newval = 0.0;
+    if (newval < emin)
+      newval = emin;
+    if (newval > emax)
+      newval = emax;
+    if (std::find(edges.begin(), edges.end(), newval) != edges.end())
+      continue;
+    edges.push_back(newval);
+  }
+  return edges;
+}
+
+} // namespace DurhamDatabase
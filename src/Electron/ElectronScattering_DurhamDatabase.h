@@ -0,0 +1,99 @@
+// Copyright 2016-2021 L. Pickering, P Stowell, R. Terri, C. Wilkinson, C. Wret
+
+/*******************************************************************************
+*    This file is part of NUISANCE.
+*
+*    NUISANCE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    NUISANCE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with NUISANCE.  If not, see <http://www.gnu.org/licenses/>.
+*******************************************************************************/
+
+#ifndef ElectronScattering_DurhamDatabase_H_SEEN
+#define ElectronScattering_DurhamDatabase_H_SEEN
+
+#include "MeasurementVariableBox1D.h"
+
+#include <string>
+#include <vector>
+
+/// Access to the Durham electron scattering tables in
+/// FitPar::GetDataBase()/Electron. Each target file is parsed once per
+/// process and split into data sets, one per (Z, A, E, theta, source), so
+/// any number of electron samples can share it.
+namespace DurhamDatabase {
+
+/// One published q0 scan at fixed beam energy and scattering angle.
+struct DataSet {
+  std::string Z, A, E, Theta, Source;
+  double Energy; ///< Beam energy (GeV)
+  double Angle;  ///< Scattering angle (degrees)
+
+  /// Points sorted in q0 (GeV), cross-sections and errors in cm^2
+  std::vector<double> Q0, XSec, Error;
+
+  /// Name as used by the ElectronData_ samples
+  std::string GetName() const;
+};
+
+/// All data sets for a target, aborts if the target has no table.
+std::vector<DataSet> const &GetDataSets(std::string const &Z,
+                                        std::string const &A);
+
+/// Data set matching the strings of an ElectronData_Z_A_E_Theta_Source
+/// name exactly, NULL if there is none.
+DataSet const *FindDataSet(std::string const &Z, std::string const &A,
+                           std::string const &E, std::string const &Theta,
+                           std::string const &Source);
+
+/// q0 bin edges placed half way between neighbouring points, with the
+/// outer edges mirrored. Needs at least two points.
+std::vector<double> GetQ0BinEdges(DataSet const &data);
+
+/// Effective angle bins around a data set, from Electron_NThetaBins and
+/// Electron_ThetaWidth.
+std::vector<double> GetThetaBinEdges(double theta);
+
+/// Effective energy bins around a data set, from Electron_NEnergyBins and
+/// Electron_EnergyWidth, clipped to [emin, emax] and to positive energies.
+std::vector<double> GetEnergyBinEdges(double energy, double emin, double emax);
+
+} // namespace DurhamDatabase
+
+/// Keeps q0, theta and E of signal events so that cached boxes can be binned
+/// again in the electron scans.
+class ElectronVariableBox : public MeasurementVariableBox1D {
+public:
+  inline ElectronVariableBox() { Reset(); };
+  inline void Reset() {
+    fX = -999.9;
+    fY = -999.9;
+    fZ = -999.9;
+  };
+  inline MeasurementVariableBox *CloneSignalBox() {
+    ElectronVariableBox *box = new ElectronVariableBox();
+    box->fX = this->fX;
+    box->fY = this->fY;
+    box->fZ = this->fZ;
+    box->fSampleWeight = this->fSampleWeight;
+    return box;
+  };
+  inline size_t GetMemorySize() { return sizeof(*this); };
+
+  inline double GetY() { return fY; };
+  inline double GetZ() { return fZ; };
+  inline void SetY(double y) { fY = y; };
+  inline void SetZ(double z) { fZ = z; };
+
+  double fY, fZ;
+};
+
+#endif
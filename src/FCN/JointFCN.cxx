@@ -1,6 +1,55 @@
 #include "JointFCN.h"
 #include "FitUtils.h"
+#include "ParallelUtils.h"
+#include "SplineReader.h"
+#include "TMD5.h"
+#include "TRandom3.h"
+#include "TSystem.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <sstream>
 #include <stdio.h>
+#include <unistd.h>
+
+#ifndef NUISANCE_BUILD_ID
+#define NUISANCE_BUILD_ID "unknown"
+#endif
+
+namespace {
+// Owner name for the JointFCN timers
+std::string const gFCNTimerName("JointFCN");
+
+// Every attribute of a key, plus the size and modification time of each
+// existing file named in its input so a remade input changes the string
+std::string DescribeKey(nuiskey key) {
+  std::ostringstream desc;
+  desc << key.GetElementName();
+  std::vector<std::string> attrs = key.GetAllKeys();
+  for (size_t i = 0; i < attrs.size(); i++) {
+    desc << " " << attrs[i] << "=" << key.GetS(attrs[i]);
+  }
+
+  if (key.Has("input")) {
+    std::string input = key.GetS("input") + " ";
+    std::string token;
+    for (size_t i = 0; i < input.size(); i++) {
+      if (!std::strchr(":,;() ", input[i])) {
+        token += input[i];
+        continue;
+      }
+      FileStat_t stat;
+      if (!token.empty() && !gSystem->GetPathInfo(token.c_str(), stat))
+        desc << " " << token << ":" << stat.fSize << ":" << stat.fMtime;
+      token.clear();
+    }
+  }
+  return desc.str();
+}
+} // namespace
 
 //***************************************************
 JointFCN::JointFCN(TFile *outfile) {
@@ -10,6 +59,8 @@ JointFCN::JointFCN(TFile *outfile) {
   if (outfile)
     Config::Get().out = outfile;
 
+  SetupSampleThreads();
+
   std::vector<nuiskey> samplekeys = Config::QueryKeys("sample");
   LoadSamples(samplekeys);
 
@@ -18,15 +69,44 @@ JointFCN::JointFCN(TFile *outfile) {
 
   fCurIter = 0;
   fMCFilled = false;
+  fTimers.SetOwner(&gFCNTimerName);
 
   fIterationTree = false;
   fDialVals = NULL;
   fNDials = 0;
 
   fUsingEventManager = FitPar::Config().GetParB("EventManager");
+  MemoryUtils::SetBudget(FitPar::Config().GetParD("MemoryBudget") * 1E6);
+  fSpillDir = FitPar::Config().GetParS("MemorySpillDir");
+  fSignalCacheDropped = false;
+  fIsAllSplines = false;
+  fSubsampleFraction = 1.0;
+  fUseDialMasks = FitPar::Config().GetParB("DialRelevanceMasks");
+  fNPars = 0;
   fOutputDir->cd();
 }
 
+//***************************************************
+void JointFCN::SetupSampleThreads() {
+  //***************************************************
+
+  // Everything the sample threads share is set up here, before any start
+  fNSampleThreads = ParallelUtils::GetNWorkers("SampleThreads");
+  StatUtils::ReadOptions();
+
+  // Flux debug histograms are written to the current directory, which
+  // sample threads do not have
+  if (fNSampleThreads > 1 && StatUtils::GetOptions().SaveFluxDebug) {
+    NUIS_ERR(WRN, "save_flux_debug writes histograms during ConvertEventRates,"
+                  " running samples serially.");
+    fNSampleThreads = 1;
+  }
+
+  if (fNSampleThreads > 1) {
+    ParallelUtils::EnableThreads();
+  }
+}
+
 //***************************************************
 JointFCN::JointFCN(std::vector<nuiskey> samplekeys, TFile *outfile) {
   //***************************************************
@@ -35,10 +115,12 @@ JointFCN::JointFCN(std::vector<nuiskey> samplekeys, TFile *outfile) {
   if (outfile)
     Config::Get().out = outfile;
 
+  SetupSampleThreads();
   LoadSamples(samplekeys);
 
   fCurIter = 0;
   fMCFilled = false;
+  fTimers.SetOwner(&gFCNTimerName);
 
   fOutputDir->cd();
 
@@ -47,6 +129,13 @@ JointFCN::JointFCN(std::vector<nuiskey> samplekeys, TFile *outfile) {
   fNDials = 0;
 
   fUsingEventManager = FitPar::Config().GetParB("EventManager");
+  MemoryUtils::SetBudget(FitPar::Config().GetParD("MemoryBudget") * 1E6);
+  fSpillDir = FitPar::Config().GetParS("MemorySpillDir");
+  fSignalCacheDropped = false;
+  fIsAllSplines = false;
+  fSubsampleFraction = 1.0;
+  fUseDialMasks = FitPar::Config().GetParB("DialRelevanceMasks");
+  fNPars = 0;
   fOutputDir->cd();
 }
 
@@ -54,6 +143,9 @@ JointFCN::JointFCN(std::vector<nuiskey> samplekeys, TFile *outfile) {
 JointFCN::~JointFCN() {
   //***************************************************
 
+  // Cached boxes must go before the samples that may point at them
+  ClearSignalCache();
+
   // Delete Samples
   for (MeasListConstIter iter = fSamples.begin(); iter != fSamples.end();
        iter++) {
@@ -66,6 +158,11 @@ JointFCN::~JointFCN() {
     delete pull;
   }
 
+  // Cached weight responses were filled for these samples' inputs, which
+  // may be deleted with them
+  if (FitBase::GetRW())
+    FitBase::GetRW()->ClearResponses();
+
   // Sort Tree
   if (fIterationTree)
     DestroyIterationTree();
@@ -184,6 +281,32 @@ void JointFCN::WriteIterationTree() {
   delete[] vals;
 }
 
+//***************************************************
+std::vector<double> JointFCN::GetLastIteration() {
+  //***************************************************
+
+  std::vector<double> iteration;
+  if (!fIterationTree || fIterationValues.empty())
+    return iteration;
+
+  iteration.push_back(fIterationCount.back());
+  iteration.insert(iteration.end(), fIterationValues.back().begin(),
+                   fIterationValues.back().end());
+  return iteration;
+}
+
+//***************************************************
+void JointFCN::AddIteration(std::vector<double> const &iteration) {
+  //***************************************************
+
+  if (!fIterationTree || iteration.empty())
+    return;
+
+  fIterationCount.push_back(int(iteration[0]));
+  fIterationValues.push_back(
+      std::vector<double>(iteration.begin() + 1, iteration.end()));
+}
+
 //***************************************************
 void JointFCN::FillIterationTree(FitWeight *rw) {
   //***************************************************
@@ -214,37 +337,8 @@ void JointFCN::FillIterationTree(FitWeight *rw) {
 double JointFCN::DoEval(const double *x) {
   //***************************************************
 
-  double *par_vals = new double[fNPars];
-
-  for (int i = 0; i < fNPars; ++i) {
-    if (fMirroredParams.count(i)) {
-      if (!fMirroredParams[i].mirror_above &&
-          (x[i] < fMirroredParams[i].mirror_value)) {
-        double xabove = fMirroredParams[i].mirror_value - x[i];
-        par_vals[i] = fMirroredParams[i].mirror_value + xabove;
-        std::cout << "\t--Parameter " << i << " mirrored from " << x[i]
-                  << " -> " << par_vals[i] << std::endl;
-      } else if (fMirroredParams[i].mirror_above &&
-                 (x[i] >= fMirroredParams[i].mirror_value)) {
-        double xabove = x[i] - fMirroredParams[i].mirror_value;
-        par_vals[i] = fMirroredParams[i].mirror_value - xabove;
-        std::cout << "\t--Parameter " << i << " mirrored from " << x[i]
-                  << " -> " << par_vals[i] << std::endl;
-      } else {
-        par_vals[i] = x[i];
-      }
-    } else {
-      par_vals[i] = x[i];
-    }
-  }
-
   // WEIGHT ENGINE
-  fDialChanged = FitBase::GetRW()->HasRWDialChanged(par_vals);
-  FitBase::GetRW()->UpdateWeightEngine(par_vals);
-  if (fDialChanged) {
-    FitBase::GetRW()->Reconfigure();
-    FitBase::EvtManager().ResetWeightFlags();
-  }
+  UpdateDials(x);
   if (LOG_LEVEL(REC)) {
     FitBase::GetRW()->Print();
   }
@@ -264,11 +358,72 @@ double JointFCN::DoEval(const double *x) {
   if (fIterationTree)
     FillIterationTree(FitBase::GetRW());
 
-  delete[] par_vals;
+  fLastEvalPars.assign(x, x + fNPars);
 
   return fLikelihood;
 }
 
+//***************************************************
+double JointFCN::ProbeLikelihood(const double *x) {
+  //***************************************************
+
+  // ReconfigureSamples counts iterations, probes are not iterations
+  UInt_t curiter = fCurIter;
+  UpdateDials(x);
+  ReconfigureSamples();
+  fCurIter = curiter;
+
+  return GetLikelihood();
+}
+
+//***************************************************
+void JointFCN::UpdateDials(const double *x) {
+  //***************************************************
+
+  double *par_vals = new double[fNPars];
+  GetParValues(x, par_vals);
+
+  fDialChanged = FitBase::GetRW()->HasRWDialChanged(par_vals);
+  FitBase::GetRW()->UpdateWeightEngine(par_vals);
+  if (fDialChanged) {
+    FitBase::GetRW()->Reconfigure();
+    FitBase::EvtManager().ResetWeightFlags();
+  }
+  delete[] par_vals;
+}
+
+//***************************************************
+void JointFCN::GetParValues(const double *x, double *par_vals,
+                            double *par_sign) {
+  //***************************************************
+
+  for (int i = 0; i < fNPars; ++i) {
+    par_vals[i] = x[i];
+    if (par_sign)
+      par_sign[i] = 1.0;
+
+    if (!fMirroredParams.count(i))
+      continue;
+
+    if (!fMirroredParams[i].mirror_above &&
+        (x[i] < fMirroredParams[i].mirror_value)) {
+      double xabove = fMirroredParams[i].mirror_value - x[i];
+      par_vals[i] = fMirroredParams[i].mirror_value + xabove;
+    } else if (fMirroredParams[i].mirror_above &&
+               (x[i] >= fMirroredParams[i].mirror_value)) {
+      double xabove = x[i] - fMirroredParams[i].mirror_value;
+      par_vals[i] = fMirroredParams[i].mirror_value - xabove;
+    } else {
+      continue;
+    }
+
+    std::cout << "\t--Parameter " << i << " mirrored from " << x[i]
+              << " -> " << par_vals[i] << std::endl;
+    if (par_sign)
+      par_sign[i] = -1.0;
+  }
+}
+
 //***************************************************
 int JointFCN::GetNDOF() {
   //***************************************************
@@ -322,14 +477,17 @@ double JointFCN::GetLikelihood() {
                           << " : "
                           << "-2logL");
 
+  // Sample likelihoods only depend on each sample's own histograms
+  std::vector<std::vector<double> > samplelikes = GetSampleLikelihoods();
+
   // Loop and add up likelihoods in an uncorrelated way
   double like = 0.0;
   int count = 0;
   for (MeasListConstIter iter = fSamples.begin(); iter != fSamples.end();
        iter++) {
     MeasurementBase *exp = *iter;
-    double newlike = exp->GetLikelihood();
-    int ndof = exp->GetNDOF();
+    double newlike = samplelikes[count][0];
+    int ndof = samplelikes[count][1];
     // Save separate likelihoods
     if (fIterationTree) {
       fSampleLikes[count] = newlike;
@@ -349,7 +507,11 @@ double JointFCN::GetLikelihood() {
   // Loop over pulls
   for (PullListConstIter iter = fPulls.begin(); iter != fPulls.end(); iter++) {
     ParamPull *pull = *iter;
-    double newlike = pull->GetLikelihood();
+    double newlike;
+    {
+      TimingUtils::ScopedTimer timer(pull->GetTimer(TimingUtils::kLikelihood));
+      newlike = pull->GetLikelihood();
+    }
 
     // Save separate likelihoods
     if (fIterationTree) {
@@ -372,6 +534,9 @@ double JointFCN::GetLikelihood() {
 
 void JointFCN::LoadSamples(std::vector<nuiskey> samplekeys) {
   NUIS_LOG(MIN, "Loading Samples : " << samplekeys.size());
+
+  // Share the data release files between samples until all are loaded
+  GeneralUtils::CachedFileScope filescope;
   for (size_t i = 0; i < samplekeys.size(); i++) {
     nuiskey key = samplekeys[i];
 
@@ -385,6 +550,7 @@ void JointFCN::LoadSamples(std::vector<nuiskey> samplekeys) {
 
     fOutputDir->cd();
     MeasurementBase *NewLoadedSample = SampleUtils::CreateSample(key);
+    fSampleConfigs.push_back(DescribeKey(key));
 
     if (!NewLoadedSample) {
       NUIS_ERR(FTL, "Could not load sample provided: " << samplename);
@@ -415,7 +581,7 @@ void JointFCN::LoadPulls(std::vector<nuiskey> pullkeys) {
 void JointFCN::ReconfigureSamples(bool fullconfig) {
   //***************************************************
 
-  int starttime = time(NULL);
+  double starttime = TimingUtils::GetTime();
   NUIS_LOG(REC, "------------");
   NUIS_LOG(REC, "Starting Reconfigure iter. " << this->fCurIter);
   // std::cout << fUsingEventManager << " " << fullconfig << " " << fMCFilled
@@ -453,8 +619,13 @@ void JointFCN::ReconfigureSamples(bool fullconfig) {
   }
 
   fMCFilled = true;
+  double elapsed = TimingUtils::GetTime() - starttime;
+  int reconfid = fTimers.ID(TimingUtils::kReconfigure);
+  if (reconfid != TimingUtils::kNoTimer) {
+    TimingUtils::AddTime(reconfid, elapsed);
+  }
   NUIS_LOG(MIN, "Finished Reconfigure iter. " << fCurIter << " in "
-                                              << time(NULL) - starttime << "s");
+                                              << Form("%.3f", elapsed) << "s");
 
   fCurIter++;
 }
@@ -513,6 +684,77 @@ std::vector<MeasurementBase *> JointFCN::GetSubSampleList() {
   return SampleList;
 }
 
+//***************************************************
+void JointFCN::ClearSignalCache() {
+  //***************************************************
+
+  // Samples keep a pointer to the box they were last filled from, which
+  // after a fast reconfigure is one of ours, so release those first.
+  std::map<MeasurementVariableBox *, MeasurementBase *> current;
+  for (size_t i = 0; i < fSubSampleList.size(); i++) {
+    current[fSubSampleList[i]->GetBox()] = fSubSampleList[i];
+  }
+
+  for (size_t i = 0; i < fSignalEventBoxes.size(); i++) {
+    for (size_t j = 0; j < fSignalEventBoxes[i].size(); j++) {
+      MeasurementVariableBox *box = fSignalEventBoxes[i][j];
+      std::map<MeasurementVariableBox *, MeasurementBase *>::iterator it =
+          current.find(box);
+      if (it != current.end())
+        it->second->ReleaseBox(box);
+      delete box;
+    }
+  }
+
+  // Swap to actually give the memory back
+  std::vector<std::vector<MeasurementVariableBox *> >().swap(fSignalEventBoxes);
+  std::vector<bool>().swap(fSignalEventFlags);
+  std::vector<std::vector<bool> >().swap(fSampleSignalFlags);
+  std::vector<EventMetadata>().swap(fSignalEventMeta);
+  std::vector<double>().swap(fSignalEventInputWeights);
+  std::vector<int>().swap(fDialMaskEnums);
+  std::vector<std::vector<int> >().swap(fDialEvents);
+  std::vector<bool>().swap(fDialAffectsAll);
+  std::vector<double>().swap(fEventWeightCache);
+  std::vector<double>().swap(fWeightCacheDials);
+  std::vector<double>().swap(fSubsampleWeights);
+  fSignalEventSplines.Clear();
+
+  MemoryUtils::ClearCategory(MemoryUtils::kSignalFlags);
+  MemoryUtils::ClearCategory(MemoryUtils::kSignalBoxes);
+  MemoryUtils::ClearCategory(MemoryUtils::kSplineCoeffs);
+  MemoryUtils::ClearCategory(MemoryUtils::kDiskCache);
+}
+
+//***************************************************
+bool JointFCN::ApplyCacheBudget(double cachebytes) {
+  //***************************************************
+
+  double budget = MemoryUtils::GetBudget();
+  if (budget <= 0.0 ||
+      cachebytes + fSignalEventSplines.GetMemoryBytes() <= budget)
+    return true;
+
+  // Spline coefficients are plain floats so can be moved to disk first
+  if (!fSignalEventSplines.IsSpilled() && !fSignalEventSplines.Empty() &&
+      fSignalEventSplines.Spill(fSpillDir)) {
+    NUIS_ERR(WRN, "Signal caches exceed MemoryBudget of "
+                      << int(budget * 1E-6)
+                      << " MB, moving spline coefficients to disk.");
+    if (cachebytes + fSignalEventSplines.GetMemoryBytes() <= budget)
+      return true;
+  }
+
+  // Boxes can't be spilled, so give up on the caches altogether
+  NUIS_ERR(WRN, "Signal caches exceed MemoryBudget of "
+                    << int(budget * 1E-6)
+                    << " MB, dropping them. Inputs will be re-read on every "
+                       "reconfigure.");
+  ClearSignalCache();
+  fSignalCacheDropped = true;
+  return false;
+}
+
 //***************************************************
 void JointFCN::ReconfigureUsingManager() {
   //***************************************************
@@ -528,15 +770,14 @@ void JointFCN::ReconfigureUsingManager() {
     exp->ResetAll();
   }
 
-  // If we are saving signal, reset all containers.
-  bool savesignal = (FitPar::Config().GetParB("SignalReconfigures"));
+  // If we are saving signal, reset all containers. Once the caches have
+  // been dropped for going over the memory budget we keep re-reading inputs.
+  bool savesignal = (FitPar::Config().GetParB("SignalReconfigures")) &&
+                    !fSignalCacheDropped;
 
   if (savesignal) {
     // Reset all of our event signal vectors
-    fSignalEventBoxes.clear();
-    fSignalEventFlags.clear();
-    fSampleSignalFlags.clear();
-    fSignalEventSplines.clear();
+    ClearSignalCache();
   }
 
   // Make sure we have a list of inputs
@@ -568,6 +809,11 @@ void JointFCN::ReconfigureUsingManager() {
   int inputcount = 0;
   inp_iter = fInputList.begin();
 
+  // Running footprint of the signal caches, checked against the budget
+  double cachebytes = 0.0;
+  std::vector<double> sampleboxbytes(fSubSampleList.size(), 0.0);
+  std::vector<double> inputsplinebytes(fInputList.size(), 0.0);
+
   // Loop over each input in manager
   for (; inp_iter != fInputList.end(); inp_iter++) {
     InputHandlerBase *curinput = (*inp_iter);
@@ -653,7 +899,13 @@ void JointFCN::ReconfigureUsingManager() {
         // If signal save a clone of the event box for use later.
         if (savesignal and signal) {
           foundsignal = true;
-          signalboxes.push_back(box->CloneSignalBox());
+          MeasurementVariableBox *sigbox = box->CloneSignalBox();
+          signalboxes.push_back(sigbox);
+          if (sigbox) {
+            double boxbytes = sigbox->GetMemorySize() + sizeof(sigbox);
+            sampleboxbytes[measitercount] += boxbytes;
+            cachebytes += boxbytes;
+          }
         }
 
         // Keep track of Measurement we are on.
@@ -670,31 +922,29 @@ void JointFCN::ReconfigureUsingManager() {
       if (savesignal && foundsignal) {
         fSignalEventBoxes.push_back(signalboxes);
         fSampleSignalFlags.push_back(signalbitset);
+        EventMetadata meta;
+        meta.Mode = curevent->Mode;
+        fSignalEventMeta.push_back(meta);
+        fSignalEventInputWeights.push_back(curevent->InputWeight *
+                                           curevent->CustomWeight);
+        cachebytes += sizeof(signalboxes) + sizeof(signalbitset) +
+                      signalbitset.size() / 8 + 1 + sizeof(EventMetadata) +
+                      sizeof(double);
       }
 
       // If all inputs are splines we can save the spline coefficients
-      // for fast in memory reconfigures later.
+      // for fast in memory reconfigures later. Kept in sync with
+      // fSignalEventBoxes size.
       if (fIsAllSplines && savesignal && foundsignal) {
-        // Make temp vector to push back with
-        std::vector<float> coeff;
-        for (size_t l = 0; l < (UInt_t)curevent->fSplineRead->GetNPar(); l++) {
-          coeff.push_back(curevent->fSplineCoeff[l]);
-        }
+        size_t npar = curevent->fSplineRead->GetNPar();
+        fSignalEventSplines.Push(curevent->fSplineCoeff, npar);
+        inputsplinebytes[inputcount] += npar * sizeof(float) + sizeof(size_t);
+      }
 
-        // Push back to signal event splines. Kept in sync with
-        // fSignalEventBoxes size.
-        // int splinecount = fSignalEventSplines.size();
-        fSignalEventSplines.push_back(coeff);
-
-        // if (splinecount % 1000 == 0) {
-        // std::cout << "Pushed Back Coeff " << splinecount << " : ";
-        // for (size_t l = 0; l < fSignalEventSplines[splinecount].size();
-        // l++)
-        // {
-        // std::cout << " " << fSignalEventSplines[splinecount][l];
-        // }
-        // std::cout << std::endl;
-        // }
+      // Spill or drop the caches if they no longer fit
+      if (savesignal &&
+          !ApplyCacheBudget(cachebytes + fSignalEventFlags.size() / 8)) {
+        savesignal = false;
       }
 
       // Clean up vectors once done with this event
@@ -716,37 +966,42 @@ void JointFCN::ReconfigureUsingManager() {
 
   // Now event loop is finished loop over all Measurements
   // Converting Binned events to XSec Distributions
-  iterSam = fSamples.begin();
-  for (; iterSam != fSamples.end(); iterSam++) {
-    MeasurementBase *exp = (*iterSam);
-    exp->ConvertEventRates();
-  }
+  ConvertSampleRates();
 
-  // Print out statements on approximate memory usage for profiling.
+  // Report the footprint of the saved caches for profiling.
   NUIS_LOG(REC, "Filled " << fillcount << " signal events.");
   if (savesignal) {
-    int mem = ( // sizeof(fSignalEventBoxes) +
-                // fSignalEventBoxes.size() * sizeof(fSignalEventBoxes.at(0)) +
-                  sizeof(MeasurementVariableBox1D) * fillcount) *
-              1E-6;
-    NUIS_LOG(REC, " -> Saved " << fillcount
-                               << " signal boxes for faster access. (~" << mem
-                               << " MB)");
-    if (fIsAllSplines and !fSignalEventSplines.empty()) {
-      int splmem = sizeof(float) * fSignalEventSplines.size() *
-                   fSignalEventSplines[0].size() * 1E-6;
-      NUIS_LOG(REC, " -> Saved "
-                        << fillcount << " " << fSignalEventSplines.size()
-                        << " spline sets into memory. (~" << splmem << " MB)");
+    fSignalEventSplines.Finalise();
+
+    int splinecat = fSignalEventSplines.IsSpilled() ? MemoryUtils::kDiskCache
+                                                    : MemoryUtils::kSplineCoeffs;
+    for (size_t i = 0; i < fInputList.size(); i++) {
+      MemoryUtils::SetUsage(MemoryUtils::kSignalFlags, fInputList[i]->GetName(),
+                            fInputList[i]->GetNEvents() / 8.0);
+      MemoryUtils::SetUsage(splinecat, fInputList[i]->GetName(),
+                            inputsplinebytes[i]);
     }
+    for (size_t i = 0; i < fSubSampleList.size(); i++) {
+      MemoryUtils::SetUsage(MemoryUtils::kSignalBoxes,
+                            fSubSampleList[i]->GetName(), sampleboxbytes[i]);
+    }
+
+    NUIS_LOG(REC, " -> Saved " << fSignalEventBoxes.size()
+                               << " signal events for faster access.");
+    MemoryUtils::PrintSummary();
   }
 
-  // Check SignalReconfigures works for all samples
+  // Check SignalReconfigures works for all samples, always on every event
   if (savesignal) {
+    double subfraction = fSubsampleFraction;
+    fSubsampleFraction = 1.0;
+
     double likefull = GetLikelihood();
     ReconfigureFastUsingManager();
     double likefast = GetLikelihood();
 
+    fSubsampleFraction = subfraction;
+
     if (fabs(likefull - likefast) > 0.0001) {
       NUIS_ERR(FTL, "Fast and Full Likelihoods DIFFER! : " << likefull << " : "
                                                            << likefast);
@@ -759,6 +1014,10 @@ void JointFCN::ReconfigureUsingManager() {
       NUIS_LOG(FIT,
                "Likelihoods for FULL and FAST match. Will use FAST next time.");
     }
+
+    // Leave the samples filled the same way as the next fast reconfigure
+    if (fSubsampleFraction < 1.0)
+      ReconfigureFastUsingManager();
   }
 };
 
@@ -784,15 +1043,10 @@ void JointFCN::ReconfigureFastUsingManager() {
     return;
   }
 
-  bool fFillNuisanceEvent =
-      FitPar::Config().GetParB("FullEventOnSignalReconfigure");
-
   // Setup fast vector iterators.
   std::vector<bool>::iterator inpsig_iter = fSignalEventFlags.begin();
   std::vector<std::vector<MeasurementVariableBox *> >::iterator box_iter =
       fSignalEventBoxes.begin();
-  std::vector<std::vector<float> >::iterator spline_iter =
-      fSignalEventSplines.begin();
   std::vector<std::vector<bool> >::iterator samsig_iter =
       fSampleSignalFlags.begin();
   int splinecount = 0;
@@ -823,9 +1077,12 @@ void JointFCN::ReconfigureFastUsingManager() {
   double *coreeventweights = new double[fSignalEventBoxes.size()];
   splinecount = 0;
 
+  // Events no moved dial can reach keep their last weight
+  std::vector<bool> reweight;
+  bool partial = GetEventsToReweight(reweight);
+
   inp_iter = fInputList.begin();
   inpsig_iter = fSignalEventFlags.begin();
-  spline_iter = fSignalEventSplines.begin();
 
   // Loop over all signal flags
   // For each valid signal flag add one to splinecount
@@ -838,29 +1095,34 @@ void JointFCN::ReconfigureFastUsingManager() {
     InputHandlerBase *curinput = fInputList[iinput];
     BaseFitEvt *curevent = curinput->FirstBaseEvent();
 
+    // Contiguous entries to read are weighted in one engine batch
+    int runfirst = -1;
+    int runsig = 0;
+
     // Loop over the events in each input
     for (int i = 0; i < curinput->GetNEvents(); i++) {
-      double rwweight = 0.0;
-
-      // If the event is a signal event
-      if (fSignalEventFlags[sigcount]) {
-        // Get Event Info
-        if (!fIsAllSplines) {
-          if (fFillNuisanceEvent) {
-            curevent = curinput->GetNuisanceEvent(i);
-          } else {
-            curevent = curinput->GetBaseEvent(i);
-          }
-        } else {
-          curevent->fSplineCoeff = &fSignalEventSplines[splinecount][0];
-        }
+      bool read = false;
+
+      // Events left out of the current subsample are never read
+      if (fSignalEventFlags[sigcount] && !fSubsampleWeights.empty() &&
+          fSubsampleWeights[splinecount] == 0.0) {
+        coreeventweights[splinecount] = 0.0;
+        splinecount++;
 
+      // Signal events untouched by the dials that moved are never read
+      } else if (fSignalEventFlags[sigcount] && partial &&
+                 !reweight[splinecount]) {
+        coreeventweights[splinecount] = fEventWeightCache[splinecount];
+        splinecount++;
+
+      // Spline inputs weight straight from the cached coefficients
+      } else if (fSignalEventFlags[sigcount] && fIsAllSplines) {
+        curevent->fSplineCoeff = fSignalEventSplines.GetRow(splinecount);
         curevent->RWWeight = FitBase::GetRW()->CalcWeight(curevent);
         curevent->Weight =
             curevent->RWWeight * curevent->InputWeight * curevent->CustomWeight;
-        rwweight = curevent->Weight;
+        coreeventweights[splinecount] = curevent->Weight;
 
-        coreeventweights[splinecount] = rwweight;
         if (countwidth && ((splinecount % countwidth) == 0)) {
           NUIS_LOG(REC, curinput->GetName()
                             << " : Processed " << i << " events. W = "
@@ -869,31 +1131,202 @@ void JointFCN::ReconfigureFastUsingManager() {
 
         // #pragma omp atomic
         splinecount++;
+
+      // Other signal events join the current run
+      } else if (fSignalEventFlags[sigcount]) {
+        if (runfirst < 0) {
+          runfirst = i;
+          runsig = splinecount;
+        }
+        read = true;
+        splinecount++;
+      }
+
+      if (!read && runfirst >= 0) {
+        WeightSignalRun(curinput, runfirst, i, runsig, coreeventweights);
+        runfirst = -1;
       }
 
       // #pragma omp atomic
       sigcount++;
     }
+
+    if (runfirst >= 0) {
+      WeightSignalRun(curinput, runfirst, curinput->GetNEvents(), runsig,
+                      coreeventweights);
+    }
   }
 
   NUIS_LOG(SAM, "Processed event weights.");
 
+  if (fUseDialMasks) {
+    fEventWeightCache.assign(coreeventweights, coreeventweights + splinecount);
+    fWeightCacheDials = FitBase::GetRW()->GetDialValues();
+  }
+
+  // The first reconfigure at a new fraction picks the subsample from the
+  // full weights, later ones only computed the kept events.
+  if (fSubsampleFraction < 1.0) {
+    if (fSubsampleWeights.empty())
+      BuildSubsample(coreeventweights, splinecount);
+    for (int i = 0; i < splinecount; i++) {
+      coreeventweights[i] *= fSubsampleWeights[i];
+    }
+  }
+
   // #pragma omp barrier
 
-  // Reset Iterators
-  inpsig_iter = fSignalEventFlags.begin();
-  spline_iter = fSignalEventSplines.begin();
-  box_iter = fSignalEventBoxes.begin();
-  samsig_iter = fSampleSignalFlags.begin();
-  int nsplineweights = splinecount;
-  splinecount = 0;
+  fillcount = FillSignalBoxes(coreeventweights, splinecount);
+
+  // Cleanup coreeventweights
+  delete[] coreeventweights;
+
+  // Print some reconfigure profiling.
+  NUIS_LOG(REC, "Filled " << fillcount << " signal events.");
+}
+
+//***************************************************
+void JointFCN::WeightSignalRun(InputHandlerBase *input, int first, int last,
+                               int sigfirst, double *weights) {
+  //***************************************************
+
+  double *runweights = weights + sigfirst;
+  FitBase::GetRW()->CalcWeights(input, first, last, runweights);
+
+  int countwidth = fSignalEventBoxes.size() / 10;
+  for (int i = 0; i < last - first; i++) {
+    runweights[i] *= fSignalEventInputWeights[sigfirst + i];
+
+    if (countwidth && (((sigfirst + i) % countwidth) == 0)) {
+      NUIS_LOG(REC, input->GetName() << " : Processed " << first + i
+                                     << " events. W = " << runweights[i]
+                                     << std::endl);
+    }
+  }
+}
+
+//***************************************************
+void JointFCN::BuildDialMasks() {
+  //***************************************************
+
+  FitWeight *rw = FitBase::GetRW();
+  fDialMaskEnums = rw->GetDialEnums();
+  size_t ndials = fDialMaskEnums.size();
+  size_t nsignal = fSignalEventMeta.size();
+
+  // Engines are asked once per distinct mode
+  std::map<int, int> groupids;
+  std::vector<int> eventgroups(nsignal);
+  std::vector<size_t> groupfirst;
+  for (size_t e = 0; e < nsignal; e++) {
+    int key = fSignalEventMeta[e].Mode;
+    std::map<int, int>::iterator it = groupids.find(key);
+    if (it == groupids.end()) {
+      it = groupids.insert(std::make_pair(key, int(groupfirst.size()))).first;
+      groupfirst.push_back(e);
+    }
+    eventgroups[e] = it->second;
+  }
+
+  fDialEvents.assign(ndials, std::vector<int>());
+  fDialAffectsAll.assign(ndials, false);
+  for (size_t i = 0; i < ndials; i++) {
+    std::vector<bool> groupaffected(groupfirst.size());
+    for (size_t g = 0; g < groupfirst.size(); g++) {
+      groupaffected[g] = rw->DialAffectsEvent(
+          fDialMaskEnums[i], fSignalEventMeta[groupfirst[g]]);
+    }
+
+    std::vector<int> &events = fDialEvents[i];
+    for (size_t e = 0; e < nsignal; e++) {
+      if (groupaffected[eventgroups[e]])
+        events.push_back(e);
+    }
+
+    // A list of every event gains nothing over the flag
+    if (events.size() == nsignal) {
+      fDialAffectsAll[i] = true;
+      std::vector<int>().swap(events);
+    }
+    NUIS_LOG(REC, "Dial " << rw->GetDialNames()[i] << " reaches "
+                          << (fDialAffectsAll[i] ? nsignal : events.size())
+                          << " of " << nsignal << " signal events.");
+  }
+}
+
+//***************************************************
+bool JointFCN::GetEventsToReweight(std::vector<bool> &reweight) {
+  //***************************************************
+
+  if (!fUseDialMasks || fSignalEventMeta.empty())
+    return false;
+
+  FitWeight *rw = FitBase::GetRW();
+  if (rw->GetDialEnums() != fDialMaskEnums) {
+    BuildDialMasks();
+    return false;
+  }
+
+  // Cache must come from the same signal events and dial list
+  std::vector<double> values = rw->GetDialValues();
+  if (fEventWeightCache.size() != fSignalEventMeta.size() ||
+      fWeightCacheDials.size() != values.size())
+    return false;
+
+  reweight.assign(fSignalEventMeta.size(), false);
+  int nmoved = 0;
+  for (size_t i = 0; i < values.size(); i++) {
+    if (values[i] == fWeightCacheDials[i])
+      continue;
+    if (fDialAffectsAll[i])
+      return false;
+
+    nmoved++;
+    std::vector<int> const &events = fDialEvents[i];
+    for (size_t e = 0; e < events.size(); e++) {
+      reweight[events[e]] = true;
+    }
+  }
+
+  NUIS_LOG(REC, nmoved << " dials moved, reweighting "
+                       << std::count(reweight.begin(), reweight.end(), true)
+                       << " of " << reweight.size() << " signal events.");
+  return true;
+}
+
+//***************************************************
+int JointFCN::FillSignalBoxes(const double *weights, int nweights) {
+  //***************************************************
+
+  // Reset all samples
+  MeasListConstIter iterSam = fSamples.begin();
+  for (; iterSam != fSamples.end(); iterSam++) {
+    MeasurementBase *exp = (*iterSam);
+    exp->ResetAll();
+  }
+
+  // Setup iterators
+  std::vector<std::vector<MeasurementVariableBox *> >::iterator box_iter =
+      fSignalEventBoxes.begin();
+  std::vector<std::vector<bool> >::iterator samsig_iter =
+      fSampleSignalFlags.begin();
+  int countwidth = nweights / 10;
+  int fillcount = 0;
+  bool skipzero = (fSubsampleFraction < 1.0);
 
   // Start of Fast Event Loop ============================
 
   // Start input iterators
   // Loop over number of inputs
-  for (int ispline = 0; ispline < nsplineweights; ispline++) {
-    double rwweight = coreeventweights[ispline];
+  for (int ispline = 0; ispline < nweights; ispline++) {
+    double rwweight = weights[ispline];
+
+    // Events outside the subsample contribute nothing
+    if (skipzero && rwweight == 0.0) {
+      samsig_iter++;
+      box_iter++;
+      continue;
+    }
 
     // Get iterators for this event
     std::vector<bool>::iterator subsamsig_iter = (*samsig_iter).begin();
@@ -916,15 +1349,13 @@ void JointFCN::ReconfigureFastUsingManager() {
       }
     }
 
-    if (ispline % countwidth == 0) {
+    if (countwidth && (ispline % countwidth == 0)) {
       NUIS_LOG(REC, "Filled " << ispline << " sample weights.");
     }
 
     // Iterate over the main signal event containers.
     samsig_iter++;
     box_iter++;
-    spline_iter++;
-    splinecount++;
   }
   // End of Fast Event Loop ===================
 
@@ -932,17 +1363,563 @@ void JointFCN::ReconfigureFastUsingManager() {
 
   // Now loop over all Measurements
   // Convert Binned events
-  iterSam = fSamples.begin();
-  for (; iterSam != fSamples.end(); iterSam++) {
-    MeasurementBase *exp = (*iterSam);
-    exp->ConvertEventRates();
+  ConvertSampleRates();
+
+  return fillcount;
+}
+
+//***************************************************
+void JointFCN::SetSubsampleFraction(double frac) {
+  //***************************************************
+
+  if (frac <= 0.0 || frac >= 1.0) {
+    frac = 1.0;
+  } else if (!fUsingEventManager ||
+             !FitPar::Config().GetParB("SignalReconfigures")) {
+    NUIS_ERR(WRN, "Subsampling needs EventManager=1 and "
+                  "SignalReconfigures=1, using every event.");
+    frac = 1.0;
   }
 
-  // Cleanup coreeventweights
-  delete coreeventweights;
+  // Force the next evaluation to refill at the new fraction
+  fSubsampleFraction = frac;
+  std::vector<double>().swap(fSubsampleWeights);
+  std::vector<double>().swap(fEventWeightCache);
+  fLastEvalPars.clear();
+}
 
-  // Print some reconfigure profiling.
-  NUIS_LOG(REC, "Filled " << fillcount << " signal events.");
+//***************************************************
+void JointFCN::BuildSubsample(const double *weights, int nweights) {
+  //***************************************************
+
+  // Strata are the mode and the bin of every sample an event is signal in
+  std::map<std::vector<int>, int> stratumids;
+  std::vector<std::vector<int> > strata;
+  for (int i = 0; i < nweights; i++) {
+    std::vector<int> key(1, fSignalEventMeta[i].Mode);
+    std::vector<MeasurementVariableBox *>::iterator box_iter =
+        fSignalEventBoxes[i].begin();
+    for (size_t j = 0; j < fSubSampleList.size(); j++) {
+      if (!fSampleSignalFlags[i][j])
+        continue;
+      key.push_back(j);
+      key.push_back(fSubSampleList[j]->GetBoxBin(*box_iter));
+      box_iter++;
+    }
+
+    std::map<std::vector<int>, int>::iterator it = stratumids.find(key);
+    if (it == stratumids.end()) {
+      it = stratumids.insert(std::make_pair(key, int(strata.size()))).first;
+      strata.push_back(std::vector<int>());
+    }
+    strata[it->second].push_back(i);
+  }
+
+  int minevents = FitPar::Config().GetParI("SubsampleMinEvents");
+  TRandom3 rand(FitPar::Config().GetParI("SubsampleSeed"));
+  fSubsampleWeights.assign(nweights, 0.0);
+
+  // Systematic sampling in each stratum with inclusion probabilities half
+  // flat, half proportional to |w|, so rare large weights are kept.
+  int nkept = 0;
+  for (size_t s = 0; s < strata.size(); s++) {
+    std::vector<int> const &events = strata[s];
+    int nevents = events.size();
+    int ntarget = std::max(minevents,
+                           int(std::ceil(fSubsampleFraction * nevents)));
+    if (ntarget >= nevents) {
+      for (int i = 0; i < nevents; i++) {
+        fSubsampleWeights[events[i]] = 1.0;
+      }
+      nkept += nevents;
+      continue;
+    }
+
+    std::vector<double> prob(nevents);
+    std::vector<bool> certain(nevents, false);
+    double nleft = ntarget;
+    bool capped = true;
+    while (capped) {
+      double sumw = 0.0;
+      int nfree = 0;
+      for (int i = 0; i < nevents; i++) {
+        if (certain[i])
+          continue;
+        sumw += std::fabs(weights[events[i]]);
+        nfree++;
+      }
+
+      // Anything that would be drawn with certainty is kept outright
+      capped = false;
+      for (int i = 0; i < nevents; i++) {
+        if (certain[i])
+          continue;
+        double share = 0.5 / nfree;
+        share += (sumw > 0.0) ? 0.5 * std::fabs(weights[events[i]]) / sumw
+                              : 0.5 / nfree;
+        prob[i] = nleft * share;
+        if (prob[i] >= 1.0) {
+          prob[i] = 1.0;
+          certain[i] = true;
+          nleft -= 1.0;
+          capped = true;
+        }
+      }
+    }
+
+    double next = rand.Uniform();
+    double cumulative = 0.0;
+    for (int i = 0; i < nevents; i++) {
+      if (certain[i]) {
+        fSubsampleWeights[events[i]] = 1.0;
+        nkept++;
+        continue;
+      }
+      cumulative += prob[i];
+      if (cumulative > next) {
+        fSubsampleWeights[events[i]] = 1.0 / prob[i];
+        next += 1.0;
+        nkept++;
+      }
+    }
+  }
+
+  // Kish effective sample size of the reweighted subsample and of the full
+  double sumfull = 0.0, sum2full = 0.0, sumsub = 0.0, sum2sub = 0.0;
+  for (int i = 0; i < nweights; i++) {
+    double w = std::fabs(weights[i]);
+    double wsub = w * fSubsampleWeights[i];
+    sumfull += w;
+    sum2full += w * w;
+    sumsub += wsub;
+    sum2sub += wsub * wsub;
+  }
+
+  NUIS_LOG(FIT, "Subsample keeps " << nkept << " of " << nweights
+                                   << " signal events in " << strata.size()
+                                   << " strata.");
+  NUIS_LOG(FIT, " -> Effective events "
+                    << Form("%.1f", sum2sub > 0.0 ? sumsub * sumsub / sum2sub
+                                                  : 0.0)
+                    << " of "
+                    << Form("%.1f", sum2full > 0.0
+                                        ? sumfull * sumfull / sum2full
+                                        : 0.0));
+}
+
+namespace {
+// Evaluates the FCN at one point per task and returns the likelihood, the
+// length of the iteration tree row, the row itself and, if requested, the
+// MC bin contents from the worker.
+class PointEvalTask : public ParallelUtils::Task {
+public:
+  PointEvalTask(JointFCN *fcn, std::vector<std::vector<double> > const &points,
+                bool getbins)
+      : fFCN(fcn), fPoints(points), fGetBins(getbins){};
+
+  std::vector<double> Run(int itask) {
+    std::vector<double> res(1, fFCN->DoEval(&fPoints[itask][0]));
+    std::vector<double> iteration = fFCN->GetLastIteration();
+    res.push_back(iteration.size());
+    res.insert(res.end(), iteration.begin(), iteration.end());
+    if (fGetBins) {
+      std::vector<double> bins = fFCN->GetMCBinContents();
+      res.insert(res.end(), bins.begin(), bins.end());
+    }
+    return res;
+  };
+
+private:
+  JointFCN *fFCN;
+  std::vector<std::vector<double> > const &fPoints;
+  bool fGetBins;
+};
+
+// Converts the event rates of one sample per task. Run on threads, so it
+// must only touch the sample itself.
+class SampleRatesTask : public ParallelUtils::Task {
+public:
+  SampleRatesTask(std::vector<MeasurementBase *> const &samples)
+      : fSamples(samples){};
+
+  std::vector<double> Run(int itask) {
+    double starttime = TimingUtils::GetTime();
+    fSamples[itask]->ConvertEventRates();
+    return std::vector<double>(1, TimingUtils::GetTime() - starttime);
+  };
+
+private:
+  std::vector<MeasurementBase *> const &fSamples;
+};
+
+// Evaluates one sample likelihood per task and returns
+// {likelihood, ndof, seconds}. Run on threads like SampleRatesTask.
+class SampleLikelihoodTask : public ParallelUtils::Task {
+public:
+  SampleLikelihoodTask(std::vector<MeasurementBase *> const &samples)
+      : fSamples(samples){};
+
+  std::vector<double> Run(int itask) {
+    std::vector<double> res(3);
+    double starttime = TimingUtils::GetTime();
+    res[0] = fSamples[itask]->GetLikelihood();
+    res[2] = TimingUtils::GetTime() - starttime;
+    res[1] = fSamples[itask]->GetNDOF();
+    return res;
+  };
+
+private:
+  std::vector<MeasurementBase *> const &fSamples;
+};
+
+// Sample task times are added from the main thread once the threads join.
+void AddSampleTime(int category, MeasurementBase *exp, double seconds) {
+  int id = exp->GetTimer(category);
+  if (id != TimingUtils::kNoTimer)
+    TimingUtils::AddTime(id, seconds);
+}
+
+// Central finite difference of the FCN along one parameter per task.
+class FiniteDiffTask : public ParallelUtils::Task {
+public:
+  FiniteDiffTask(JointFCN *fcn, const double *x, int npars,
+                 std::vector<int> const &pars, std::vector<double> const &steps)
+      : fFCN(fcn), fX(x, x + npars), fPars(pars), fSteps(steps){};
+
+  std::vector<double> Run(int itask) {
+    std::vector<double> xvals = fX;
+    int ipar = fPars[itask];
+
+    xvals[ipar] = fX[ipar] + fSteps[itask];
+    double likeup = fFCN->ProbeLikelihood(&xvals[0]);
+    xvals[ipar] = fX[ipar] - fSteps[itask];
+    double likedown = fFCN->ProbeLikelihood(&xvals[0]);
+
+    return std::vector<double>(1, (likeup - likedown) / (2.0 * fSteps[itask]));
+  };
+
+private:
+  JointFCN *fFCN;
+  std::vector<double> fX;
+  std::vector<int> fPars;
+  std::vector<double> fSteps;
+};
+} // namespace
+
+//***************************************************
+std::vector<double>
+JointFCN::DoEvalPoints(std::vector<std::vector<double> > const &points,
+                       std::vector<std::vector<double> > *mcbins) {
+  //***************************************************
+
+  std::vector<double> likes(points.size());
+  if (mcbins)
+    mcbins->assign(points.size(), std::vector<double>());
+  if (points.empty())
+    return likes;
+
+  // Fill the MC and signal caches here first so the workers inherit them
+  likes[0] = DoEval(&points[0][0]);
+  if (mcbins)
+    (*mcbins)[0] = GetMCBinContents();
+
+  int nworkers = ParallelUtils::GetNWorkers();
+  if (nworkers <= 1 || points.size() <= 2) {
+    for (size_t i = 1; i < points.size(); i++) {
+      likes[i] = DoEval(&points[i][0]);
+      if (mcbins)
+        (*mcbins)[i] = GetMCBinContents();
+    }
+    return likes;
+  }
+
+  std::vector<std::vector<double> > rest(points.begin() + 1, points.end());
+  NUIS_LOG(FIT, "Evaluating " << rest.size() << " points using " << nworkers
+                              << " workers.");
+
+  PointEvalTask task(this, rest, mcbins != NULL);
+  std::vector<std::vector<double> > results =
+      ParallelUtils::RunTasks(task, rest.size(), nworkers);
+
+  for (size_t i = 0; i < results.size(); i++) {
+    likes[i + 1] = results[i][0];
+    std::vector<double>::const_iterator rowend =
+        results[i].begin() + 2 + int(results[i][1]);
+    AddIteration(std::vector<double>(results[i].begin() + 2, rowend));
+    if (mcbins)
+      (*mcbins)[i + 1] = std::vector<double>(rowend, results[i].end());
+  }
+
+  return likes;
+}
+
+//***************************************************
+std::vector<double>
+JointFCN::GetMCBinContents(std::vector<std::string> *names,
+                           std::vector<int> *bins) {
+  //***************************************************
+
+  std::vector<double> contents;
+  for (std::list<MeasurementBase *>::iterator iter = fSamples.begin();
+       iter != fSamples.end(); iter++) {
+    MeasurementBase *exp = *iter;
+    std::vector<TH1 *> mclist = exp->GetMCList();
+    if (mclist.empty() || !mclist[0])
+      continue;
+
+    TH1 *mc = mclist[0];
+    for (int i = 0; i < mc->GetNcells(); i++) {
+      if (mc->IsBinUnderflow(i) || mc->IsBinOverflow(i))
+        continue;
+      contents.push_back(mc->GetBinContent(i));
+      if (names)
+        names->push_back(exp->GetName());
+      if (bins)
+        bins->push_back(i);
+    }
+  }
+  return contents;
+}
+
+//***************************************************
+void JointFCN::DoGradient(const double *x, double *grad) {
+  //***************************************************
+
+  for (int i = 0; i < fNPars; i++) {
+    grad[i] = 0.0;
+  }
+  if (!fNPars)
+    return;
+
+  // Make sure the samples are filled at x before linearising around it
+  std::vector<double> par_vals(fNPars);
+  GetParValues(x, &par_vals[0]);
+
+  bool ateval = fMCFilled && (fLastEvalPars.size() == (UInt_t)fNPars) &&
+                std::equal(fLastEvalPars.begin(), fLastEvalPars.end(), x);
+  std::vector<double> rwvals = FitBase::GetRW()->GetDialValues();
+  for (int i = 0; ateval && i < fNPars && i < (int)rwvals.size(); i++) {
+    ateval = (rwvals[i] == par_vals[i]);
+  }
+  if (!ateval)
+    DoEval(x);
+
+  std::vector<bool> done(fNPars, false);
+  for (int i = 0; i < fNPars; i++) {
+    done[i] = fFixedParams.count(i) && fFixedParams[i];
+  }
+
+  GetSplineGradient(x, grad, done);
+  GetFiniteDiffGradient(x, grad, done);
+
+  if (LOG_LEVEL(MIN)) {
+    for (int i = 0; i < fNPars; i++) {
+      NUIS_LOG(MIN, "dL/dx[" << i << "] = " << grad[i]);
+    }
+  }
+}
+
+//***************************************************
+void JointFCN::GetSplineGradient(const double *x, double *grad,
+                                 std::vector<bool> &done) {
+  //***************************************************
+
+  // Needs the cached spline coefficients from a signal reconfigure. The
+  // subsample weights are not part of the linearisation, so leave those
+  // fits to finite differences.
+  if (!fUsingEventManager || !fIsAllSplines || fSignalEventSplines.Empty() ||
+      fSubsampleFraction < 1.0)
+    return;
+
+  FitWeight *rw = FitBase::GetRW();
+  std::vector<int> dialenums = rw->GetDialEnums();
+  std::vector<std::string> dialnames = rw->GetDialNames();
+
+  // Only spline parameter dials can be taken from the coefficients
+  std::map<std::string, int> parindex;
+  std::vector<int> splinepars;
+  for (int i = 0; i < fNPars && i < (int)dialenums.size(); i++) {
+    if (done[i] ||
+        Reweight::GetDialType(dialenums[i]) != kSPLINEPARAMETER)
+      continue;
+
+    std::vector<std::string> names =
+        GeneralUtils::ParseToStr(dialnames[i], ",");
+    for (size_t j = 0; j < names.size(); j++) {
+      parindex[names[j]] = i;
+    }
+    splinepars.push_back(i);
+  }
+  if (splinepars.empty())
+    return;
+
+  std::vector<double> par_vals(fNPars);
+  std::vector<double> par_sign(fNPars);
+  GetParValues(x, &par_vals[0], &par_sign[0]);
+
+  // Nominal weight and reader of every cached signal event. Readers are
+  // already reconfigured to x by the DoEval call.
+  int nsignal = fSignalEventSplines.GetNRows();
+  std::vector<double> weights(nsignal);
+  std::vector<SplineReader *> readers(nsignal);
+
+  int sigcount = 0;
+  int splinecount = 0;
+  for (size_t iinput = 0; iinput < fInputList.size(); iinput++) {
+    InputHandlerBase *curinput = fInputList[iinput];
+    BaseFitEvt *curevent = curinput->FirstBaseEvent();
+    if (curevent->fSplineRead)
+      curevent->fSplineRead->SetParameterIndices(parindex);
+
+    for (int i = 0; i < curinput->GetNEvents(); i++, sigcount++) {
+      if (!fSignalEventFlags[sigcount])
+        continue;
+
+      curevent->fSplineCoeff = fSignalEventSplines.GetRow(splinecount);
+      weights[splinecount] = rw->CalcWeight(curevent) *
+                             curevent->InputWeight * curevent->CustomWeight;
+      readers[splinecount] = curevent->fSplineRead;
+      splinecount++;
+    }
+  }
+
+  // The prediction is linear in the event weights, so each parameter
+  // needs two refills of the cached boxes at w +/- h dw/dx.
+  double step = FitPar::Config().GetParD("FCNGradientStep");
+  std::vector<double> dweights(nsignal);
+  std::vector<double> shifted(nsignal);
+  std::vector<double> pullgrad = GetPullGradient();
+
+  for (size_t k = 0; k < splinepars.size(); k++) {
+    int ipar = splinepars[k];
+
+    bool hasresponse = false;
+    for (int e = 0; e < nsignal; e++) {
+      dweights[e] = 0.0;
+      if (readers[e] && weights[e] != 0.0) {
+        dweights[e] =
+            weights[e] * par_sign[ipar] *
+            readers[e]->CalcLogDerivative(fSignalEventSplines.GetRow(e), ipar);
+      }
+      hasresponse |= (dweights[e] != 0.0);
+    }
+
+    if (hasresponse) {
+      for (int e = 0; e < nsignal; e++) {
+        shifted[e] = weights[e] + step * dweights[e];
+      }
+      FillSignalBoxes(&shifted[0], nsignal);
+      double likeup = GetSampleLikelihood();
+
+      for (int e = 0; e < nsignal; e++) {
+        shifted[e] = weights[e] - step * dweights[e];
+      }
+      FillSignalBoxes(&shifted[0], nsignal);
+      double likedown = GetSampleLikelihood();
+
+      grad[ipar] += (likeup - likedown) / (2.0 * step);
+    }
+
+    if (ipar < (int)pullgrad.size())
+      grad[ipar] += par_sign[ipar] * pullgrad[ipar];
+    done[ipar] = true;
+  }
+
+  // Leave the samples as they were at x
+  FillSignalBoxes(&weights[0], nsignal);
+}
+
+//***************************************************
+void JointFCN::GetFiniteDiffGradient(const double *x, double *grad,
+                                     std::vector<bool> &done) {
+  //***************************************************
+
+  double step = FitPar::Config().GetParD("FCNGradientStep");
+
+  std::vector<int> pars;
+  std::vector<double> steps;
+  for (int i = 0; i < fNPars; i++) {
+    if (done[i])
+      continue;
+    pars.push_back(i);
+    steps.push_back(step * std::max(1.0, fabs(x[i])));
+  }
+  if (pars.empty())
+    return;
+
+  int nworkers = ParallelUtils::GetNWorkers();
+  NUIS_LOG(MIN, "Finite difference gradient for " << pars.size()
+                                                  << " parameters using "
+                                                  << nworkers << " workers.");
+
+  FiniteDiffTask task(this, x, fNPars, pars, steps);
+  std::vector<std::vector<double> > results =
+      ParallelUtils::RunTasks(task, pars.size(), nworkers);
+
+  for (size_t i = 0; i < pars.size(); i++) {
+    grad[pars[i]] = results[i][0];
+    done[pars[i]] = true;
+  }
+
+  // Serial running moves the samples away from x, put them back.
+  if (nworkers <= 1 || pars.size() <= 1)
+    ProbeLikelihood(x);
+}
+
+//***************************************************
+double JointFCN::GetSampleLikelihood() {
+  //***************************************************
+
+  std::vector<std::vector<double> > samplelikes = GetSampleLikelihoods();
+
+  double like = 0.0;
+  for (size_t i = 0; i < samplelikes.size(); i++) {
+    like += samplelikes[i][0];
+  }
+  return like;
+}
+
+//***************************************************
+void JointFCN::ConvertSampleRates() {
+  //***************************************************
+
+  std::vector<MeasurementBase *> samples(fSamples.begin(), fSamples.end());
+  SampleRatesTask task(samples);
+  std::vector<std::vector<double> > res =
+      ParallelUtils::RunThreads(task, samples.size(), fNSampleThreads);
+
+  for (size_t i = 0; i < samples.size(); i++) {
+    AddSampleTime(TimingUtils::kConvertEventRates, samples[i], res[i][0]);
+  }
+}
+
+//***************************************************
+std::vector<std::vector<double> > JointFCN::GetSampleLikelihoods() {
+  //***************************************************
+
+  std::vector<MeasurementBase *> samples(fSamples.begin(), fSamples.end());
+  SampleLikelihoodTask task(samples);
+  std::vector<std::vector<double> > res =
+      ParallelUtils::RunThreads(task, samples.size(), fNSampleThreads);
+
+  for (size_t i = 0; i < samples.size(); i++) {
+    AddSampleTime(TimingUtils::kLikelihood, samples[i], res[i][2]);
+    res[i].resize(2);
+  }
+  return res;
+}
+
+//***************************************************
+std::vector<double> JointFCN::GetPullGradient() {
+  //***************************************************
+
+  // Pulls are quadratic in the dial values, so take the derivative directly
+  // instead of reconfiguring them at shifted dial values.
+  std::vector<double> grad(FitBase::GetRW()->GetDialNames().size(), 0.0);
+  for (PullListConstIter iter = fPulls.begin(); iter != fPulls.end(); iter++) {
+    (*iter)->AddDialGradient(grad);
+  }
+  return grad;
 }
 
 //***************************************************
@@ -1031,6 +2008,116 @@ void JointFCN::SetFakeData(std::string fakeinput) {
   return;
 }
 
+//***************************************************
+std::string JointFCN::GetFakeDataCacheFile() {
+  //***************************************************
+
+  std::string dir = FitPar::Config().GetParS("FakeDataCacheDir");
+  if (dir.empty())
+    dir = getenv("TMPDIR") ? getenv("TMPDIR") : "/tmp";
+
+  // The build and generator versions, the samples and their inputs, the
+  // global config, and the dials the fake data is made at
+  std::ostringstream desc;
+  desc << NUISANCE_BUILD_ID << "\n";
+  for (size_t i = 0; i < fSampleConfigs.size(); i++) {
+    desc << fSampleConfigs[i] << "\n";
+  }
+  std::vector<nuiskey> configkeys = Config::QueryKeys("config");
+  for (size_t i = 0; i < configkeys.size(); i++) {
+    desc << DescribeKey(configkeys[i]) << "\n";
+  }
+  std::vector<std::string> dialnames = FitBase::GetRW()->GetDialNames();
+  std::vector<double> dialvals = FitBase::GetRW()->GetDialValues();
+  for (size_t i = 0; i < dialnames.size(); i++) {
+    desc << dialnames[i] << "=" << Form("%.17g", dialvals[i]) << "\n";
+  }
+
+  std::string str = desc.str();
+  TMD5 md5;
+  md5.Update((UChar_t const *)str.c_str(), str.size());
+  md5.Final();
+  return dir + "/nuisance_fakedata_" + md5.AsString() + ".root";
+}
+
+//***************************************************
+void JointFCN::SetFakeDataFromMC() {
+  //***************************************************
+
+  bool usecache = FitPar::Config().GetParB("FakeDataCache");
+  std::string cachename = usecache ? GetFakeDataCacheFile() : "";
+
+  if (usecache && !gSystem->AccessPathName(cachename.c_str())) {
+    // Every sample with an MC histogram must have its prediction cached
+    bool complete = true;
+    TFile *cache = new TFile(cachename.c_str(), "READ");
+    for (MeasListConstIter iter = fSamples.begin(); iter != fSamples.end();
+         iter++) {
+      MeasurementBase *exp = *iter;
+      std::vector<TH1 *> mclist = exp->GetMCList();
+      if (!mclist.empty() && mclist[0] &&
+          !cache->Get((exp->GetName() + "_MC").c_str())) {
+        complete = false;
+      }
+    }
+
+    // The MC is not filled by the event loop on a hit, so it is set to the
+    // cached prediction and the next reconfigure is a full one. Fake data
+    // then comes from that MC, as samples only open one fake data file.
+    if (complete) {
+      for (MeasListConstIter iter = fSamples.begin(); iter != fSamples.end();
+           iter++) {
+        MeasurementBase *exp = *iter;
+        std::vector<TH1 *> mclist = exp->GetMCList();
+        if (mclist.empty() || !mclist[0])
+          continue;
+        mclist[0]->Reset();
+        mclist[0]->Add((TH1 *)cache->Get((exp->GetName() + "_MC").c_str()));
+      }
+      fMCFilled = false;
+    }
+    cache->Close();
+    delete cache;
+    fOutputDir->cd();
+
+    if (complete) {
+      NUIS_LOG(FIT, "Loaded fake data predictions from " << cachename);
+      SetFakeData("MC");
+      return;
+    }
+    NUIS_ERR(WRN, "Fake data cache " << cachename
+                                     << " is missing samples, remaking it.");
+  }
+
+  ReconfigureAllEvents();
+  SetFakeData("MC");
+  if (!usecache)
+    return;
+
+  // Written under another name first so a concurrent fit never reads half
+  // a file
+  std::string tmpname = cachename + Form(".%d.tmp", (int)getpid());
+  TFile *cache = new TFile(tmpname.c_str(), "RECREATE");
+  for (MeasListConstIter iter = fSamples.begin(); iter != fSamples.end();
+       iter++) {
+    MeasurementBase *exp = *iter;
+    std::vector<TH1 *> mclist = exp->GetMCList();
+    if (!mclist.empty() && mclist[0]) {
+      mclist[0]->Write((exp->GetName() + "_MC").c_str());
+    }
+  }
+  cache->Close();
+  delete cache;
+  fOutputDir->cd();
+
+  if (std::rename(tmpname.c_str(), cachename.c_str())) {
+    NUIS_ERR(WRN, "Cannot save fake data cache " << cachename);
+    gSystem->Unlink(tmpname.c_str());
+  } else {
+    NUIS_LOG(FIT, "Saved fake data predictions to " << cachename);
+  }
+}
+
 //***************************************************
 void JointFCN::ThrowDataToy() {
   //***************************************************
@@ -1044,6 +2131,29 @@ void JointFCN::ThrowDataToy() {
   return;
 }
 
+//***************************************************
+std::vector<double> JointFCN::ThrowDataToys(int ntoys) {
+  //***************************************************
+
+  // Pulls do not depend on the data so are the same for every toy
+  double pulllike = 0.0;
+  for (PullListConstIter iter = fPulls.begin(); iter != fPulls.end(); iter++) {
+    pulllike += (*iter)->GetLikelihood();
+  }
+
+  std::vector<double> likes(ntoys, pulllike);
+  for (MeasListConstIter iter = fSamples.begin(); iter != fSamples.end();
+       iter++) {
+    MeasurementBase *exp = *iter;
+    std::vector<double> samplelikes = exp->GetDataToyLikelihoods(ntoys);
+    for (int i = 0; i < ntoys; i++) {
+      likes[i] += samplelikes[i];
+    }
+  }
+
+  return likes;
+}
+
 //***************************************************
 std::vector<std::string> JointFCN::GetAllNames() {
   //***************************************************
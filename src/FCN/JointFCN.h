@@ -34,6 +34,7 @@
 #include "NuisKey.h"
 #include "MeasurementVariableBox.h"
 #include "MeasurementVariableBox1D.h"
+#include "MemoryUtils.h"
 
 using namespace FitUtils;
 using namespace FitBase;
@@ -56,6 +57,29 @@ public:
   //! Main Likelihood evaluation FCN
   double DoEval(const double *x);
 
+  //! Likelihood at x for gradient probes. Reconfigures like DoEval but
+  //! records nothing: no iteration count, tree row or last evaluated x.
+  double ProbeLikelihood(const double *x);
+
+  //! Evaluate DoEval at each point, spread across the configured number
+  //! of forked workers which share the already filled event caches. The
+  //! samples are left at one of the points afterwards. If mcbins is given
+  //! it is filled with GetMCBinContents at each point.
+  std::vector<double> DoEvalPoints(std::vector<std::vector<double> > const &points,
+                                   std::vector<std::vector<double> > *mcbins = NULL);
+
+  //! In-range bin contents of each sample's MC histogram after the last
+  //! evaluation, in sample order. Optionally returns the sample name and
+  //! global ROOT bin number of each entry.
+  std::vector<double> GetMCBinContents(std::vector<std::string> *names = NULL,
+                                       std::vector<int> *bins = NULL);
+
+  //! Gradient of DoEval w.r.t. each parameter. Spline parameter dials are
+  //! differentiated from the cached coefficients when every input is a
+  //! spline input, other dials use finite differences spread across the
+  //! configured number of worker processes.
+  void DoGradient(const double *x, double *grad);
+
   //! Func Wrapper for ROOT
   inline double operator() (const std::vector<double> & x) {
     double* x_array = new double[x.size()];
@@ -76,6 +100,12 @@ public:
   //! Writes TTree to fOutput directory
   void WriteIterationTree();
 
+  //! Last saved iteration as {iteration, values...}, empty if not saving
+  std::vector<double> GetLastIteration();
+
+  //! Append an iteration returned by GetLastIteration in another process
+  void AddIteration(std::vector<double> const &iteration);
+
   //! Deletes TTree
   void DestroyIterationTree();
 
@@ -111,6 +141,13 @@ public:
   //! Set Fake data from file/MC
   void SetFakeData(std::string fakeinput);
 
+  //! Reconfigure all events at the current dials and set the data of every
+  //! sample to its MC. With FakeDataCache the predictions are saved, and
+  //! loaded instead of running the event loop when the build, the samples,
+  //! their input files, the config and the dial values all match. A loaded
+  //! prediction also fills the MC, and the next reconfigure is a full one.
+  void SetFakeDataFromMC();
+
   //! Reconfigure looping over duplicate inputs
   void ReconfigureUsingManager();
 
@@ -121,6 +158,9 @@ public:
   /// Throws data according to current stats
   void ThrowDataToy();
 
+  /// Total likelihood of each of ntoys data toys thrown for every sample
+  std::vector<double> ThrowDataToys(int ntoys);
+
   std::vector<MeasurementBase*> GetSubSampleList();
   std::vector<InputHandlerBase*> GetInputList();
 
@@ -138,9 +178,77 @@ public:
   void SetNParams(int npar){
     fNPars = npar;
   }
+  //! Fixed parameters are given a zero gradient without any evaluation
+  void SetParFixed(int ipar, bool fixed){
+    fFixedParams[ipar] = fixed;
+  }
+
+  //! Evaluate fast reconfigures on a stratified subsample of roughly frac
+  //! of the cached signal events, reweighted to the full sample. A frac
+  //! of 1 goes back to using every event.
+  void SetSubsampleFraction(double frac);
+  inline double GetSubsampleFraction() { return fSubsampleFraction; };
 
 private:
 
+  //! Convert minimizer values to dial values, applying any mirroring.
+  //! par_sign is filled with d(dial)/d(x) if given.
+  void GetParValues(const double *x, double *par_vals, double *par_sign = NULL);
+
+  //! Refill all samples from the signal boxes with the given event weights
+  int FillSignalBoxes(const double *weights, int nweights);
+
+  //! Analytic gradient for spline parameters from the cached coefficients
+  void GetSplineGradient(const double *x, double *grad, std::vector<bool> &done);
+
+  //! Parallel central differences for any parameter not yet done
+  void GetFiniteDiffGradient(const double *x, double *grad,
+                             std::vector<bool> &done);
+
+  //! Move the reweight engine to the parameter values x
+  void UpdateDials(const double *x);
+
+  //! Sum of sample likelihoods without pulls
+  double GetSampleLikelihood();
+
+  //! Delete all cached signal boxes, flags and spline coefficients
+  void ClearSignalCache();
+
+  //! Build the lists of cached signal events each dial can reweight
+  void BuildDialMasks();
+
+  //! Fake data cache file named by a hash of everything the samples' MC
+  //! depends on at the current dials
+  std::string GetFakeDataCacheFile();
+
+  //! Flag the cached signal events whose weight can differ from
+  //! fEventWeightCache at the current dials. False if all of them need
+  //! reweighting.
+  bool GetEventsToReweight(std::vector<bool> &reweight);
+
+  //! Choose the events of the current subsample from the full signal
+  //! event weights, filling fSubsampleWeights
+  void BuildSubsample(const double *weights, int nweights);
+
+  //! Weight input entries [first, last), all cached signal events from
+  //! signal index sigfirst on, in one batch into weights[sigfirst...]
+  void WeightSignalRun(InputHandlerBase *input, int first, int last,
+                       int sigfirst, double *weights);
+
+  //! Spill or drop the signal caches if they no longer fit the memory
+  //! budget. Returns false if the caches were dropped.
+  bool ApplyCacheBudget(double cachebytes);
+
+  //! Run ConvertEventRates for every sample, spread over fNSampleThreads
+  void ConvertSampleRates();
+
+  //! Evaluate every sample likelihood, spread over fNSampleThreads.
+  //! Returns {likelihood, ndof} per sample in fSamples order.
+  std::vector<std::vector<double> > GetSampleLikelihoods();
+
+  //! Derivative of the pull terms w.r.t. each dial, at the current values
+  std::vector<double> GetPullGradient();
+
   //! Append the experiments to include in the fit to this list
   std::list<MeasurementBase*> fSamples;
 
@@ -164,15 +272,35 @@ private:
   int *   fSampleNDOF;     //!< NDOF for each individual measurement in list
 
   bool fUsingEventManager; //!< Flag for doing joint comparisons
+  int fNSampleThreads; //!< Threads used for per-sample rates and likelihoods
+  TimingUtils::TimerSet fTimers; //!< Reconfigure timer, registered on first use
 
-  std::vector< std::vector<float> > fSignalEventSplines;
+  //! Read SampleThreads and prepare the shared state the threads use
+  void SetupSampleThreads();
+
+  MemoryUtils::FloatRows fSignalEventSplines;
   std::vector< std::vector<MeasurementVariableBox*> > fSignalEventBoxes;
   std::vector< bool > fSignalEventFlags;
   std::vector< std::vector<bool> > fSampleSignalFlags;
+  std::vector< EventMetadata > fSignalEventMeta; //!< Mode of each cached signal event
+  std::vector< double > fSignalEventInputWeights; //!< InputWeight * CustomWeight of each cached signal event
+
+  bool fUseDialMasks; //!< Only reweight events a moved dial can reach
+  std::vector< int > fDialMaskEnums; //!< Dials the masks were built for
+  std::vector< std::vector<int> > fDialEvents; //!< Cached signal events each dial reaches
+  std::vector< bool > fDialAffectsAll; //!< Dials reaching every cached signal event
+  std::vector< double > fEventWeightCache; //!< Signal event weights from the last fast reconfigure
+  std::vector< double > fWeightCacheDials; //!< Dial values fEventWeightCache was made at
+
+  double fSubsampleFraction; //!< Fraction of signal events in fast reconfigures
+  std::vector< double > fSubsampleWeights; //!< 1/p for kept events, else 0
 
   std::vector<InputHandlerBase*> fInputList;
   std::vector<MeasurementBase*> fSubSampleList;
   bool fIsAllSplines;
+  bool fSignalCacheDropped; //!< Caches exceeded MemoryBudget, always re-read
+  std::string fSpillDir;    //!< Directory for spilled caches
+  std::vector<std::string> fSampleConfigs; //!< Sample keys and input stamps
 
 
   std::vector< int > fIterationCount;
@@ -190,6 +318,8 @@ private:
   std::map<int, mirror_param> fMirroredParams;
   //the number of pars added to the minimizer, should be the same as fNDials
   int fNPars;
+  std::map<int, bool> fFixedParams;  //!< Pars excluded from the gradient
+  std::vector<double> fLastEvalPars; //!< x from the last DoEval call
 };
 
 /*! @} */
@@ -5,10 +5,12 @@
 *  @{  
 */
 
+#include <algorithm>
 #include <iostream>
 #include <vector>
 #include "FitLogger.h"
 #include "JointFCN.h"
+#include "Math/IFunction.h"
 
 
 //! Wrapper for JointFCN to make ROOT minimization behave sensibly.
@@ -77,5 +79,63 @@ class MinimizerFCN{
   
   JointFCN* fFCN;
 };
+
+//! Gradient aware wrapper so minimizers can use JointFCN::DoGradient
+//! instead of their own numerical derivatives.
+class MinimizerGradFCN : public ROOT::Math::IMultiGradFunction {
+ public:
+
+  // Construct from function
+  MinimizerGradFCN(JointFCN* f, unsigned int ndim) {
+    fFCN = f;
+    fNDim = ndim;
+  };
+
+  // Destroy (Doesn't delete FCN)
+  ~MinimizerGradFCN(){};
+
+  ROOT::Math::IMultiGenFunction* Clone() const {
+    return new MinimizerGradFCN(fFCN, fNDim);
+  };
+
+  unsigned int NDim() const { return fNDim; };
+
+  // Full gradient in one call
+  void Gradient(const double* x, double* grad) const {
+    fFCN->DoGradient(x, grad);
+    fGradX.assign(x, x + fNDim);
+    fGrad.assign(grad, grad + fNDim);
+  };
+
+  void FdF(const double* x, double& f, double* grad) const {
+    f = DoEval(x);
+    Gradient(x, grad);
+  };
+
+ private:
+
+  double DoEval(const double* x) const {
+    if (!fFCN) {
+      NUIS_ERR(FTL, "No FCN Found in MinimizerGradFCN!");
+      NUIS_ABORT("Exiting!");
+    }
+    return fFCN->DoEval(x);
+  };
+
+  // Single components reuse the last full gradient at the same x
+  double DoDerivative(const double* x, unsigned int icoord) const {
+    if (fGradX.size() != fNDim ||
+        !std::equal(fGradX.begin(), fGradX.end(), x)) {
+      std::vector<double> grad(fNDim);
+      Gradient(x, &grad[0]);
+    }
+    return fGrad[icoord];
+  };
+
+  JointFCN* fFCN;
+  unsigned int fNDim;
+  mutable std::vector<double> fGradX;
+  mutable std::vector<double> fGrad;
+};
 /*! @} */
 #endif // _MINIMIZER_FCN_H_
@@ -365,6 +365,7 @@
 
 #ifdef Electron_ENABLED
 #include "ElectronScattering_DurhamData.h"
+#include "ElectronScattering_DurhamDataGroup.h"
 #endif
 
 #include "MCStudy_KaonPreSelection.h"
@@ -388,6 +389,7 @@
 #include "TRegexp.h"
 
 #include <dirent.h>
+#include <unordered_map>
 
 // linux
 #include <dlfcn.h>
@@ -626,923 +628,662 @@ MeasurementBase *DynamicSampleFactory::CreateSample(nuiskey &samplekey) {
 DynamicSampleFactory::~DynamicSampleFactory() { Manifests.clear(); }
 
 //! Functions to make it easier for samples to be created and handled.
-namespace SampleUtils {
+namespace {
+typedef MeasurementBase *(*SampleCreator)(nuiskey &);
+typedef std::unordered_map<std::string, SampleCreator> SampleRegistry;
 
-//! Create a given sample given its name, file, type, fakdata(fkdt) file and the
-//! current rw engine and push it back into the list fChain.
-MeasurementBase *CreateSample(std::string name, std::string file,
-                              std::string type, std::string fkdt,
-                              FitWeight *rw) {
-  nuiskey samplekey = Config::CreateKey("sample");
-  samplekey.Set("name", name);
-  samplekey.Set("input", file);
-  samplekey.Set("type", type);
+SampleRegistry gSampleRegistry;
 
-  return CreateSample(samplekey);
+template <typename T> MeasurementBase *CreateFromKey(nuiskey &samplekey) {
+  return new T(samplekey);
 }
 
-MeasurementBase *CreateSample(nuiskey samplekey) {
-  if (DynamicSampleFactory::Get().HasSample(samplekey)) {
-    NUIS_LOG(SAM, "Instantiating dynamic sample...");
+template <typename T> void Register(std::string const &name) {
+  gSampleRegistry.insert(std::make_pair(name, &CreateFromKey<T>));
+}
 
-    MeasurementBase *ds = DynamicSampleFactory::Get().CreateSample(samplekey);
-    if (ds) {
-      NUIS_LOG(SAM, "Done.");
-      return ds;
-    }
-    NUIS_ABORT("Failed to instantiate dynamic sample.");
+//! Samples that are constructed from their key, looked up by exact name.
+//! Filled on first use so sample creation is a single hash lookup instead
+//! of comparing against every known name.
+SampleRegistry const &GetSampleRegistry() {
+  if (!gSampleRegistry.empty()) {
+    return gSampleRegistry;
   }
 
-  FitWeight *rw = FitBase::GetRW();
-  std::string name = samplekey.GetS("name");
-  std::string file = samplekey.GetS("input");
-  std::string type = samplekey.GetS("type");
-  std::string fkdt = "";
-
-  /*
-     ANL CCQE Samples
-  */
-
 #ifdef ANL_ENABLED
-  if (!name.compare("ANL_CCQE_XSec_1DEnu_nu") ||
-      !name.compare("ANL_CCQE_XSec_1DEnu_nu_PRD26") ||
-      !name.compare("ANL_CCQE_XSec_1DEnu_nu_PRL31") ||
-      !name.compare("ANL_CCQE_XSec_1DEnu_nu_PRD16")) {
-    return (new ANL_CCQE_XSec_1DEnu_nu(samplekey));
-  } else if (!name.compare("ANL_CCQE_Evt_1DQ2_nu") ||
-             !name.compare("ANL_CCQE_Evt_1DQ2_nu_PRL31") ||
-             !name.compare("ANL_CCQE_Evt_1DQ2_nu_PRD26") ||
-             !name.compare("ANL_CCQE_Evt_1DQ2_nu_PRD16")) {
-    return (new ANL_CCQE_Evt_1DQ2_nu(samplekey));
-    /*
-      ANL CC1ppip samples
-    */
-  } else if (!name.compare("ANL_CC1ppip_XSec_1DEnu_nu") ||
-             !name.compare("ANL_CC1ppip_XSec_1DEnu_nu_W14Cut") ||
-             !name.compare("ANL_CC1ppip_XSec_1DEnu_nu_Uncorr") ||
-             !name.compare("ANL_CC1ppip_XSec_1DEnu_nu_W14Cut_Uncorr") ||
-             !name.compare("ANL_CC1ppip_XSec_1DEnu_nu_W16Cut_Uncorr")) {
-    return (new ANL_CC1ppip_XSec_1DEnu_nu(samplekey));
-  } else if (!name.compare("ANL_CC1ppip_XSec_1DQ2_nu")) {
-    return (new ANL_CC1ppip_XSec_1DQ2_nu(samplekey));
-  } else if (!name.compare("ANL_CC1ppip_Evt_1DQ2_nu") ||
-             !name.compare("ANL_CC1ppip_Evt_1DQ2_nu_W14Cut")) {
-    return (new ANL_CC1ppip_Evt_1DQ2_nu(samplekey));
-  } else if (!name.compare("ANL_CC1ppip_Evt_1Dppi_nu")) {
-    return (new ANL_CC1ppip_Evt_1Dppi_nu(samplekey));
-  } else if (!name.compare("ANL_CC1ppip_Evt_1Dthpr_nu")) {
-    return (new ANL_CC1ppip_Evt_1Dthpr_nu(samplekey));
-  } else if (!name.compare("ANL_CC1ppip_Evt_1DcosmuStar_nu")) {
-    return (new ANL_CC1ppip_Evt_1DcosmuStar_nu(samplekey));
-  } else if (!name.compare("ANL_CC1ppip_Evt_1DcosthAdler_nu")) {
-    return (new ANL_CC1ppip_Evt_1DcosthAdler_nu(samplekey));
-  } else if (!name.compare("ANL_CC1ppip_Evt_1Dphi_nu")) {
-    return (new ANL_CC1ppip_Evt_1Dphi_nu(samplekey));
-  } else if (!name.compare("ANL_CC1ppip_Evt_1DWNpi_nu")) {
-    return (new ANL_CC1ppip_Evt_1DWNpi_nu(samplekey));
-  } else if (!name.compare("ANL_CC1ppip_Evt_1DWNmu_nu")) {
-    return (new ANL_CC1ppip_Evt_1DWNmu_nu(samplekey));
-  } else if (!name.compare("ANL_CC1ppip_Evt_1DWmupi_nu")) {
-    return (new ANL_CC1ppip_Evt_1DWmupi_nu(samplekey));
-    /*
-      ANL CC1npip sample
-    */
-  } else if (!name.compare("ANL_CC1npip_XSec_1DEnu_nu") ||
-             !name.compare("ANL_CC1npip_XSec_1DEnu_nu_W14Cut") ||
-             !name.compare("ANL_CC1npip_XSec_1DEnu_nu_Uncorr") ||
-             !name.compare("ANL_CC1npip_XSec_1DEnu_nu_W14Cut_Uncorr") ||
-             !name.compare("ANL_CC1npip_XSec_1DEnu_nu_W16Cut_Uncorr")) {
-    return (new ANL_CC1npip_XSec_1DEnu_nu(samplekey));
-  } else if (!name.compare("ANL_CC1npip_Evt_1DQ2_nu") ||
-             !name.compare("ANL_CC1npip_Evt_1DQ2_nu_W14Cut")) {
-    return (new ANL_CC1npip_Evt_1DQ2_nu(samplekey));
-  } else if (!name.compare("ANL_CC1npip_Evt_1Dppi_nu")) {
-    return (new ANL_CC1npip_Evt_1Dppi_nu(samplekey));
-  } else if (!name.compare("ANL_CC1npip_Evt_1DcosmuStar_nu")) {
-    return (new ANL_CC1npip_Evt_1DcosmuStar_nu(samplekey));
-  } else if (!name.compare("ANL_CC1npip_Evt_1DWNpi_nu")) {
-    return (new ANL_CC1npip_Evt_1DWNpi_nu(samplekey));
-  } else if (!name.compare("ANL_CC1npip_Evt_1DWNmu_nu")) {
-    return (new ANL_CC1npip_Evt_1DWNmu_nu(samplekey));
-  } else if (!name.compare("ANL_CC1npip_Evt_1DWmupi_nu")) {
-    return (new ANL_CC1npip_Evt_1DWmupi_nu(samplekey));
-    /*
-      ANL CC1pi0 sample
-    */
-  } else if (!name.compare("ANL_CC1pi0_XSec_1DEnu_nu") ||
-             !name.compare("ANL_CC1pi0_XSec_1DEnu_nu_W14Cut") ||
-             !name.compare("ANL_CC1pi0_XSec_1DEnu_nu_Uncorr") ||
-             !name.compare("ANL_CC1pi0_XSec_1DEnu_nu_W14Cut_Uncorr") ||
-             !name.compare("ANL_CC1pi0_XSec_1DEnu_nu_W16Cut_Uncorr")) {
-    return (new ANL_CC1pi0_XSec_1DEnu_nu(samplekey));
-  } else if (!name.compare("ANL_CC1pi0_Evt_1DQ2_nu") ||
-             !name.compare("ANL_CC1pi0_Evt_1DQ2_nu_W14Cut")) {
-    return (new ANL_CC1pi0_Evt_1DQ2_nu(samplekey));
-  } else if (!name.compare("ANL_CC1pi0_Evt_1DcosmuStar_nu")) {
-    return (new ANL_CC1pi0_Evt_1DcosmuStar_nu(samplekey));
-  } else if (!name.compare("ANL_CC1pi0_Evt_1DWNpi_nu")) {
-    return (new ANL_CC1pi0_Evt_1DWNpi_nu(samplekey));
-  } else if (!name.compare("ANL_CC1pi0_Evt_1DWNmu_nu")) {
-    return (new ANL_CC1pi0_Evt_1DWNmu_nu(samplekey));
-  } else if (!name.compare("ANL_CC1pi0_Evt_1DWmupi_nu")) {
-    return (new ANL_CC1pi0_Evt_1DWmupi_nu(samplekey));
-    /*
-      ANL NC1npip sample
-    */
-  } else if (!name.compare("ANL_NC1npip_Evt_1Dppi_nu")) {
-    return (new ANL_NC1npip_Evt_1Dppi_nu(samplekey));
-    /*
-      ANL NC1ppim sample
-    */
-  } else if (!name.compare("ANL_NC1ppim_XSec_1DEnu_nu")) {
-    return (new ANL_NC1ppim_XSec_1DEnu_nu(samplekey));
-  } else if (!name.compare("ANL_NC1ppim_Evt_1DcosmuStar_nu")) {
-    return (new ANL_NC1ppim_Evt_1DcosmuStar_nu(samplekey));
-    /*
-      ANL CC2pi sample
-    */
-  } else if (!name.compare("ANL_CC2pi_1pim1pip_XSec_1DEnu_nu")) {
-    return (new ANL_CC2pi_1pim1pip_XSec_1DEnu_nu(samplekey));
-  } else if (!name.compare("ANL_CC2pi_1pim1pip_Evt_1Dpmu_nu")) {
-    return (new ANL_CC2pi_1pim1pip_Evt_1Dpmu_nu(samplekey));
-  } else if (!name.compare("ANL_CC2pi_1pim1pip_Evt_1Dppip_nu")) {
-    return (new ANL_CC2pi_1pim1pip_Evt_1Dppip_nu(samplekey));
-  } else if (!name.compare("ANL_CC2pi_1pim1pip_Evt_1Dppim_nu")) {
-    return (new ANL_CC2pi_1pim1pip_Evt_1Dppim_nu(samplekey));
-  } else if (!name.compare("ANL_CC2pi_1pim1pip_Evt_1Dpprot_nu")) {
-    return (new ANL_CC2pi_1pim1pip_Evt_1Dpprot_nu(samplekey));
-
-  } else if (!name.compare("ANL_CC2pi_1pip1pip_XSec_1DEnu_nu")) {
-    return (new ANL_CC2pi_1pip1pip_XSec_1DEnu_nu(samplekey));
-  } else if (!name.compare("ANL_CC2pi_1pip1pip_Evt_1Dpmu_nu")) {
-    return (new ANL_CC2pi_1pip1pip_Evt_1Dpmu_nu(samplekey));
-  } else if (!name.compare("ANL_CC2pi_1pip1pip_Evt_1Dpneut_nu")) {
-    return (new ANL_CC2pi_1pip1pip_Evt_1Dpneut_nu(samplekey));
-  } else if (!name.compare("ANL_CC2pi_1pip1pip_Evt_1DppipHigh_nu")) {
-    return (new ANL_CC2pi_1pip1pip_Evt_1DppipHigh_nu(samplekey));
-  } else if (!name.compare("ANL_CC2pi_1pip1pip_Evt_1DppipLow_nu")) {
-    return (new ANL_CC2pi_1pip1pip_Evt_1DppipLow_nu(samplekey));
-
-  } else if (!name.compare("ANL_CC2pi_1pip1pi0_XSec_1DEnu_nu")) {
-    return (new ANL_CC2pi_1pip1pi0_XSec_1DEnu_nu(samplekey));
-  } else if (!name.compare("ANL_CC2pi_1pip1pi0_Evt_1Dpmu_nu")) {
-    return (new ANL_CC2pi_1pip1pi0_Evt_1Dpmu_nu(samplekey));
-  } else if (!name.compare("ANL_CC2pi_1pip1pi0_Evt_1Dppip_nu")) {
-    return (new ANL_CC2pi_1pip1pi0_Evt_1Dppip_nu(samplekey));
-  } else if (!name.compare("ANL_CC2pi_1pip1pi0_Evt_1Dppi0_nu")) {
-    return (new ANL_CC2pi_1pip1pi0_Evt_1Dppi0_nu(samplekey));
-  } else if (!name.compare("ANL_CC2pi_1pip1pi0_Evt_1Dpprot_nu")) {
-    return (new ANL_CC2pi_1pip1pi0_Evt_1Dpprot_nu(samplekey));
-
-    /*
-      ArgoNeut Samples
-    */
-  } else
+  // ANL CCQE Samples
+  Register<ANL_CCQE_XSec_1DEnu_nu>("ANL_CCQE_XSec_1DEnu_nu");
+  Register<ANL_CCQE_XSec_1DEnu_nu>("ANL_CCQE_XSec_1DEnu_nu_PRD26");
+  Register<ANL_CCQE_XSec_1DEnu_nu>("ANL_CCQE_XSec_1DEnu_nu_PRL31");
+  Register<ANL_CCQE_XSec_1DEnu_nu>("ANL_CCQE_XSec_1DEnu_nu_PRD16");
+  Register<ANL_CCQE_Evt_1DQ2_nu>("ANL_CCQE_Evt_1DQ2_nu");
+  Register<ANL_CCQE_Evt_1DQ2_nu>("ANL_CCQE_Evt_1DQ2_nu_PRL31");
+  Register<ANL_CCQE_Evt_1DQ2_nu>("ANL_CCQE_Evt_1DQ2_nu_PRD26");
+  Register<ANL_CCQE_Evt_1DQ2_nu>("ANL_CCQE_Evt_1DQ2_nu_PRD16");
+  // ANL CC1ppip samples
+  Register<ANL_CC1ppip_XSec_1DEnu_nu>("ANL_CC1ppip_XSec_1DEnu_nu");
+  Register<ANL_CC1ppip_XSec_1DEnu_nu>("ANL_CC1ppip_XSec_1DEnu_nu_W14Cut");
+  Register<ANL_CC1ppip_XSec_1DEnu_nu>("ANL_CC1ppip_XSec_1DEnu_nu_Uncorr");
+  Register<ANL_CC1ppip_XSec_1DEnu_nu>(
+      "ANL_CC1ppip_XSec_1DEnu_nu_W14Cut_Uncorr");
+  Register<ANL_CC1ppip_XSec_1DEnu_nu>(
+      "ANL_CC1ppip_XSec_1DEnu_nu_W16Cut_Uncorr");
+  Register<ANL_CC1ppip_XSec_1DQ2_nu>("ANL_CC1ppip_XSec_1DQ2_nu");
+  Register<ANL_CC1ppip_Evt_1DQ2_nu>("ANL_CC1ppip_Evt_1DQ2_nu");
+  Register<ANL_CC1ppip_Evt_1DQ2_nu>("ANL_CC1ppip_Evt_1DQ2_nu_W14Cut");
+  Register<ANL_CC1ppip_Evt_1Dppi_nu>("ANL_CC1ppip_Evt_1Dppi_nu");
+  Register<ANL_CC1ppip_Evt_1Dthpr_nu>("ANL_CC1ppip_Evt_1Dthpr_nu");
+  Register<ANL_CC1ppip_Evt_1DcosmuStar_nu>("ANL_CC1ppip_Evt_1DcosmuStar_nu");
+  Register<ANL_CC1ppip_Evt_1DcosthAdler_nu>("ANL_CC1ppip_Evt_1DcosthAdler_nu");
+  Register<ANL_CC1ppip_Evt_1Dphi_nu>("ANL_CC1ppip_Evt_1Dphi_nu");
+  Register<ANL_CC1ppip_Evt_1DWNpi_nu>("ANL_CC1ppip_Evt_1DWNpi_nu");
+  Register<ANL_CC1ppip_Evt_1DWNmu_nu>("ANL_CC1ppip_Evt_1DWNmu_nu");
+  Register<ANL_CC1ppip_Evt_1DWmupi_nu>("ANL_CC1ppip_Evt_1DWmupi_nu");
+  // ANL CC1npip sample
+  Register<ANL_CC1npip_XSec_1DEnu_nu>("ANL_CC1npip_XSec_1DEnu_nu");
+  Register<ANL_CC1npip_XSec_1DEnu_nu>("ANL_CC1npip_XSec_1DEnu_nu_W14Cut");
+  Register<ANL_CC1npip_XSec_1DEnu_nu>("ANL_CC1npip_XSec_1DEnu_nu_Uncorr");
+  Register<ANL_CC1npip_XSec_1DEnu_nu>(
+      "ANL_CC1npip_XSec_1DEnu_nu_W14Cut_Uncorr");
+  Register<ANL_CC1npip_XSec_1DEnu_nu>(
+      "ANL_CC1npip_XSec_1DEnu_nu_W16Cut_Uncorr");
+  Register<ANL_CC1npip_Evt_1DQ2_nu>("ANL_CC1npip_Evt_1DQ2_nu");
+  Register<ANL_CC1npip_Evt_1DQ2_nu>("ANL_CC1npip_Evt_1DQ2_nu_W14Cut");
+  Register<ANL_CC1npip_Evt_1Dppi_nu>("ANL_CC1npip_Evt_1Dppi_nu");
+  Register<ANL_CC1npip_Evt_1DcosmuStar_nu>("ANL_CC1npip_Evt_1DcosmuStar_nu");
+  Register<ANL_CC1npip_Evt_1DWNpi_nu>("ANL_CC1npip_Evt_1DWNpi_nu");
+  Register<ANL_CC1npip_Evt_1DWNmu_nu>("ANL_CC1npip_Evt_1DWNmu_nu");
+  Register<ANL_CC1npip_Evt_1DWmupi_nu>("ANL_CC1npip_Evt_1DWmupi_nu");
+  // ANL CC1pi0 sample
+  Register<ANL_CC1pi0_XSec_1DEnu_nu>("ANL_CC1pi0_XSec_1DEnu_nu");
+  Register<ANL_CC1pi0_XSec_1DEnu_nu>("ANL_CC1pi0_XSec_1DEnu_nu_W14Cut");
+  Register<ANL_CC1pi0_XSec_1DEnu_nu>("ANL_CC1pi0_XSec_1DEnu_nu_Uncorr");
+  Register<ANL_CC1pi0_XSec_1DEnu_nu>("ANL_CC1pi0_XSec_1DEnu_nu_W14Cut_Uncorr");
+  Register<ANL_CC1pi0_XSec_1DEnu_nu>("ANL_CC1pi0_XSec_1DEnu_nu_W16Cut_Uncorr");
+  Register<ANL_CC1pi0_Evt_1DQ2_nu>("ANL_CC1pi0_Evt_1DQ2_nu");
+  Register<ANL_CC1pi0_Evt_1DQ2_nu>("ANL_CC1pi0_Evt_1DQ2_nu_W14Cut");
+  Register<ANL_CC1pi0_Evt_1DcosmuStar_nu>("ANL_CC1pi0_Evt_1DcosmuStar_nu");
+  Register<ANL_CC1pi0_Evt_1DWNpi_nu>("ANL_CC1pi0_Evt_1DWNpi_nu");
+  Register<ANL_CC1pi0_Evt_1DWNmu_nu>("ANL_CC1pi0_Evt_1DWNmu_nu");
+  Register<ANL_CC1pi0_Evt_1DWmupi_nu>("ANL_CC1pi0_Evt_1DWmupi_nu");
+  // ANL NC1npip sample
+  Register<ANL_NC1npip_Evt_1Dppi_nu>("ANL_NC1npip_Evt_1Dppi_nu");
+  // ANL NC1ppim sample
+  Register<ANL_NC1ppim_XSec_1DEnu_nu>("ANL_NC1ppim_XSec_1DEnu_nu");
+  Register<ANL_NC1ppim_Evt_1DcosmuStar_nu>("ANL_NC1ppim_Evt_1DcosmuStar_nu");
+  // ANL CC2pi sample
+  Register<ANL_CC2pi_1pim1pip_XSec_1DEnu_nu>(
+      "ANL_CC2pi_1pim1pip_XSec_1DEnu_nu");
+  Register<ANL_CC2pi_1pim1pip_Evt_1Dpmu_nu>("ANL_CC2pi_1pim1pip_Evt_1Dpmu_nu");
+  Register<ANL_CC2pi_1pim1pip_Evt_1Dppip_nu>(
+      "ANL_CC2pi_1pim1pip_Evt_1Dppip_nu");
+  Register<ANL_CC2pi_1pim1pip_Evt_1Dppim_nu>(
+      "ANL_CC2pi_1pim1pip_Evt_1Dppim_nu");
+  Register<ANL_CC2pi_1pim1pip_Evt_1Dpprot_nu>(
+      "ANL_CC2pi_1pim1pip_Evt_1Dpprot_nu");
+  Register<ANL_CC2pi_1pip1pip_XSec_1DEnu_nu>(
+      "ANL_CC2pi_1pip1pip_XSec_1DEnu_nu");
+  Register<ANL_CC2pi_1pip1pip_Evt_1Dpmu_nu>("ANL_CC2pi_1pip1pip_Evt_1Dpmu_nu");
+  Register<ANL_CC2pi_1pip1pip_Evt_1Dpneut_nu>(
+      "ANL_CC2pi_1pip1pip_Evt_1Dpneut_nu");
+  Register<ANL_CC2pi_1pip1pip_Evt_1DppipHigh_nu>(
+      "ANL_CC2pi_1pip1pip_Evt_1DppipHigh_nu");
+  Register<ANL_CC2pi_1pip1pip_Evt_1DppipLow_nu>(
+      "ANL_CC2pi_1pip1pip_Evt_1DppipLow_nu");
+  Register<ANL_CC2pi_1pip1pi0_XSec_1DEnu_nu>(
+      "ANL_CC2pi_1pip1pi0_XSec_1DEnu_nu");
+  Register<ANL_CC2pi_1pip1pi0_Evt_1Dpmu_nu>("ANL_CC2pi_1pip1pi0_Evt_1Dpmu_nu");
+  Register<ANL_CC2pi_1pip1pi0_Evt_1Dppip_nu>(
+      "ANL_CC2pi_1pip1pi0_Evt_1Dppip_nu");
+  Register<ANL_CC2pi_1pip1pi0_Evt_1Dppi0_nu>(
+      "ANL_CC2pi_1pip1pi0_Evt_1Dppi0_nu");
+  Register<ANL_CC2pi_1pip1pi0_Evt_1Dpprot_nu>(
+      "ANL_CC2pi_1pip1pi0_Evt_1Dpprot_nu");
 #endif
+
 #ifdef ArgoNeuT_ENABLED
-    if (!name.compare("ArgoNeuT_CCInc_XSec_1Dpmu_antinu")) {
-      return (new ArgoNeuT_CCInc_XSec_1Dpmu_antinu(samplekey));
-    } else if (!name.compare("ArgoNeuT_CCInc_XSec_1Dpmu_nu")) {
-      return (new ArgoNeuT_CCInc_XSec_1Dpmu_nu(samplekey));
-  } else if (!name.compare("ArgoNeuT_CCInc_XSec_1Dthetamu_antinu")) {
-    return (new ArgoNeuT_CCInc_XSec_1Dthetamu_antinu(samplekey));
-  } else if (!name.compare("ArgoNeuT_CCInc_XSec_1Dthetamu_nu")) {
-    return (new ArgoNeuT_CCInc_XSec_1Dthetamu_nu(samplekey));
-  } else if (!name.compare("ArgoNeuT_CC1Pi_XSec_1Dpmu_nu")) {
-    return (new ArgoNeuT_CC1Pi_XSec_1Dpmu_nu(samplekey));
-  } else if (!name.compare("ArgoNeuT_CC1Pi_XSec_1Dthetamu_nu")) {
-    return (new ArgoNeuT_CC1Pi_XSec_1Dthetamu_nu(samplekey));
-  } else if (!name.compare("ArgoNeuT_CC1Pi_XSec_1Dthetapi_nu")) {
-    return (new ArgoNeuT_CC1Pi_XSec_1Dthetapi_nu(samplekey));
-  } else if (!name.compare("ArgoNeuT_CC1Pi_XSec_1Dthetamupi_nu")) {
-    return (new ArgoNeuT_CC1Pi_XSec_1Dthetamupi_nu(samplekey));
-  } else if (!name.compare("ArgoNeuT_CC1Pi_XSec_1Dpmu_antinu")) {
-    return (new ArgoNeuT_CC1Pi_XSec_1Dpmu_antinu(samplekey));
-  } else if (!name.compare("ArgoNeuT_CC1Pi_XSec_1Dthetamu_antinu")) {
-    return (new ArgoNeuT_CC1Pi_XSec_1Dthetamu_antinu(samplekey));
-  } else if (!name.compare("ArgoNeuT_CC1Pi_XSec_1Dthetapi_antinu")) {
-    return (new ArgoNeuT_CC1Pi_XSec_1Dthetapi_antinu(samplekey));
-  } else if (!name.compare("ArgoNeuT_CC1Pi_XSec_1Dthetamupi_antinu")) {
-    return (new ArgoNeuT_CC1Pi_XSec_1Dthetamupi_antinu(samplekey));
-
-    /*
-      BNL Samples
-    */
-  } else
+  // ArgoNeut Samples
+  Register<ArgoNeuT_CCInc_XSec_1Dpmu_antinu>(
+      "ArgoNeuT_CCInc_XSec_1Dpmu_antinu");
+  Register<ArgoNeuT_CCInc_XSec_1Dpmu_nu>("ArgoNeuT_CCInc_XSec_1Dpmu_nu");
+  Register<ArgoNeuT_CCInc_XSec_1Dthetamu_antinu>(
+      "ArgoNeuT_CCInc_XSec_1Dthetamu_antinu");
+  Register<ArgoNeuT_CCInc_XSec_1Dthetamu_nu>(
+      "ArgoNeuT_CCInc_XSec_1Dthetamu_nu");
+  Register<ArgoNeuT_CC1Pi_XSec_1Dpmu_nu>("ArgoNeuT_CC1Pi_XSec_1Dpmu_nu");
+  Register<ArgoNeuT_CC1Pi_XSec_1Dthetamu_nu>(
+      "ArgoNeuT_CC1Pi_XSec_1Dthetamu_nu");
+  Register<ArgoNeuT_CC1Pi_XSec_1Dthetapi_nu>(
+      "ArgoNeuT_CC1Pi_XSec_1Dthetapi_nu");
+  Register<ArgoNeuT_CC1Pi_XSec_1Dthetamupi_nu>(
+      "ArgoNeuT_CC1Pi_XSec_1Dthetamupi_nu");
+  Register<ArgoNeuT_CC1Pi_XSec_1Dpmu_antinu>(
+      "ArgoNeuT_CC1Pi_XSec_1Dpmu_antinu");
+  Register<ArgoNeuT_CC1Pi_XSec_1Dthetamu_antinu>(
+      "ArgoNeuT_CC1Pi_XSec_1Dthetamu_antinu");
+  Register<ArgoNeuT_CC1Pi_XSec_1Dthetapi_antinu>(
+      "ArgoNeuT_CC1Pi_XSec_1Dthetapi_antinu");
+  Register<ArgoNeuT_CC1Pi_XSec_1Dthetamupi_antinu>(
+      "ArgoNeuT_CC1Pi_XSec_1Dthetamupi_antinu");
 #endif
+
 #ifdef BNL_ENABLED
-      if (!name.compare("BNL_CCQE_XSec_1DEnu_nu")) {
-    return (new BNL_CCQE_XSec_1DEnu_nu(samplekey));
-  } else if (!name.compare("BNL_CCQE_Evt_1DQ2_nu")) {
-    return (new BNL_CCQE_Evt_1DQ2_nu(samplekey));
-
-    /*
-      BNL CC1ppip samples
-    */
-  } else if (!name.compare("BNL_CC1ppip_XSec_1DEnu_nu") ||
-             !name.compare("BNL_CC1ppip_XSec_1DEnu_nu_Uncorr") ||
-             !name.compare("BNL_CC1ppip_XSec_1DEnu_nu_W14Cut") ||
-             !name.compare("BNL_CC1ppip_XSec_1DEnu_nu_W14Cut_Uncorr")) {
-    return (new BNL_CC1ppip_XSec_1DEnu_nu(samplekey));
-  } else if (!name.compare("BNL_CC1ppip_Evt_1DQ2_nu") ||
-             !name.compare("BNL_CC1ppip_Evt_1DQ2_nu_W14Cut")) {
-    return (new BNL_CC1ppip_Evt_1DQ2_nu(samplekey));
-  } else if (!name.compare("BNL_CC1ppip_Evt_1DcosthAdler_nu")) {
-    return (new BNL_CC1ppip_Evt_1DcosthAdler_nu(samplekey));
-  } else if (!name.compare("BNL_CC1ppip_Evt_1Dphi_nu")) {
-    return (new BNL_CC1ppip_Evt_1Dphi_nu(samplekey));
-  } else if (!name.compare("BNL_CC1ppip_Evt_1DWNpi_nu")) {
-    return (new BNL_CC1ppip_Evt_1DWNpi_nu(samplekey));
-  } else if (!name.compare("BNL_CC1ppip_Evt_1DWNmu_nu")) {
-    return (new BNL_CC1ppip_Evt_1DWNmu_nu(samplekey));
-  } else if (!name.compare("BNL_CC1ppip_Evt_1DWmupi_nu")) {
-    return (new BNL_CC1ppip_Evt_1DWmupi_nu(samplekey));
-
-    /*
-      BNL CC1npip samples
-    */
-  } else if (!name.compare("BNL_CC1npip_XSec_1DEnu_nu") ||
-             !name.compare("BNL_CC1npip_XSec_1DEnu_nu_Uncorr")) {
-    return (new BNL_CC1npip_XSec_1DEnu_nu(samplekey));
-  } else if (!name.compare("BNL_CC1npip_Evt_1DQ2_nu")) {
-    return (new BNL_CC1npip_Evt_1DQ2_nu(samplekey));
-  } else if (!name.compare("BNL_CC1npip_Evt_1DWNpi_nu")) {
-    return (new BNL_CC1npip_Evt_1DWNpi_nu(samplekey));
-  } else if (!name.compare("BNL_CC1npip_Evt_1DWNmu_nu")) {
-    return (new BNL_CC1npip_Evt_1DWNmu_nu(samplekey));
-  } else if (!name.compare("BNL_CC1npip_Evt_1DWmupi_nu")) {
-    return (new BNL_CC1npip_Evt_1DWmupi_nu(samplekey));
-    /*
-      BNL CC1pi0 samples
-    */
-  } else if (!name.compare("BNL_CC1pi0_XSec_1DEnu_nu")) {
-    return (new BNL_CC1pi0_XSec_1DEnu_nu(samplekey));
-  } else if (!name.compare("BNL_CC1pi0_Evt_1DQ2_nu")) {
-    return (new BNL_CC1pi0_Evt_1DQ2_nu(samplekey));
-  } else if (!name.compare("BNL_CC1pi0_Evt_1DWNpi_nu")) {
-    return (new BNL_CC1pi0_Evt_1DWNpi_nu(samplekey));
-  } else if (!name.compare("BNL_CC1pi0_Evt_1DWNmu_nu")) {
-    return (new BNL_CC1pi0_Evt_1DWNmu_nu(samplekey));
-  } else if (!name.compare("BNL_CC1pi0_Evt_1DWmupi_nu")) {
-    return (new BNL_CC1pi0_Evt_1DWmupi_nu(samplekey));
-    /*
-      BNL multi-pi
-    */
-  } else if (!name.compare("BNL_CC2pi_1pim1pip_XSec_1DEnu_nu")) {
-     return (new BNL_CC2pi_1pim1pip_XSec_1DEnu_nu(samplekey));
-  } else if (!name.compare("BNL_CC3pi_1pim2pip_XSec_1DEnu_nu")) {
-     return (new BNL_CC3pi_1pim2pip_XSec_1DEnu_nu(samplekey));
-  } else if (!name.compare("BNL_CC4pi_2pim2pip_XSec_1DEnu_nu")) {
-     return (new BNL_CC4pi_2pim2pip_XSec_1DEnu_nu(samplekey));
-  } else if (!name.compare("BNL_CC2pi_1pim1pip_Evt_1DWpippim_nu")) {
-     return (new BNL_CC2pi_1pim1pip_Evt_1DWpippim_nu(samplekey));
-  } else if (!name.compare("BNL_CC2pi_1pim1pip_Evt_1DWpippr_nu")) {
-     return (new BNL_CC2pi_1pim1pip_Evt_1DWpippr_nu(samplekey));
-    /*
-      FNAL Samples
-    */
-  } else
+  // BNL Samples
+  Register<BNL_CCQE_XSec_1DEnu_nu>("BNL_CCQE_XSec_1DEnu_nu");
+  Register<BNL_CCQE_Evt_1DQ2_nu>("BNL_CCQE_Evt_1DQ2_nu");
+  // BNL CC1ppip samples
+  Register<BNL_CC1ppip_XSec_1DEnu_nu>("BNL_CC1ppip_XSec_1DEnu_nu");
+  Register<BNL_CC1ppip_XSec_1DEnu_nu>("BNL_CC1ppip_XSec_1DEnu_nu_Uncorr");
+  Register<BNL_CC1ppip_XSec_1DEnu_nu>("BNL_CC1ppip_XSec_1DEnu_nu_W14Cut");
+  Register<BNL_CC1ppip_XSec_1DEnu_nu>(
+      "BNL_CC1ppip_XSec_1DEnu_nu_W14Cut_Uncorr");
+  Register<BNL_CC1ppip_Evt_1DQ2_nu>("BNL_CC1ppip_Evt_1DQ2_nu");
+  Register<BNL_CC1ppip_Evt_1DQ2_nu>("BNL_CC1ppip_Evt_1DQ2_nu_W14Cut");
+  Register<BNL_CC1ppip_Evt_1DcosthAdler_nu>("BNL_CC1ppip_Evt_1DcosthAdler_nu");
+  Register<BNL_CC1ppip_Evt_1Dphi_nu>("BNL_CC1ppip_Evt_1Dphi_nu");
+  Register<BNL_CC1ppip_Evt_1DWNpi_nu>("BNL_CC1ppip_Evt_1DWNpi_nu");
+  Register<BNL_CC1ppip_Evt_1DWNmu_nu>("BNL_CC1ppip_Evt_1DWNmu_nu");
+  Register<BNL_CC1ppip_Evt_1DWmupi_nu>("BNL_CC1ppip_Evt_1DWmupi_nu");
+  // BNL CC1npip samples
+  Register<BNL_CC1npip_XSec_1DEnu_nu>("BNL_CC1npip_XSec_1DEnu_nu");
+  Register<BNL_CC1npip_XSec_1DEnu_nu>("BNL_CC1npip_XSec_1DEnu_nu_Uncorr");
+  Register<BNL_CC1npip_Evt_1DQ2_nu>("BNL_CC1npip_Evt_1DQ2_nu");
+  Register<BNL_CC1npip_Evt_1DWNpi_nu>("BNL_CC1npip_Evt_1DWNpi_nu");
+  Register<BNL_CC1npip_Evt_1DWNmu_nu>("BNL_CC1npip_Evt_1DWNmu_nu");
+  Register<BNL_CC1npip_Evt_1DWmupi_nu>("BNL_CC1npip_Evt_1DWmupi_nu");
+  // BNL CC1pi0 samples
+  Register<BNL_CC1pi0_XSec_1DEnu_nu>("BNL_CC1pi0_XSec_1DEnu_nu");
+  Register<BNL_CC1pi0_Evt_1DQ2_nu>("BNL_CC1pi0_Evt_1DQ2_nu");
+  Register<BNL_CC1pi0_Evt_1DWNpi_nu>("BNL_CC1pi0_Evt_1DWNpi_nu");
+  Register<BNL_CC1pi0_Evt_1DWNmu_nu>("BNL_CC1pi0_Evt_1DWNmu_nu");
+  Register<BNL_CC1pi0_Evt_1DWmupi_nu>("BNL_CC1pi0_Evt_1DWmupi_nu");
+  // BNL multi-pi
+  Register<BNL_CC2pi_1pim1pip_XSec_1DEnu_nu>(
+      "BNL_CC2pi_1pim1pip_XSec_1DEnu_nu");
+  Register<BNL_CC3pi_1pim2pip_XSec_1DEnu_nu>(
+      "BNL_CC3pi_1pim2pip_XSec_1DEnu_nu");
+  Register<BNL_CC4pi_2pim2pip_XSec_1DEnu_nu>(
+      "BNL_CC4pi_2pim2pip_XSec_1DEnu_nu");
+  Register<BNL_CC2pi_1pim1pip_Evt_1DWpippim_nu>(
+      "BNL_CC2pi_1pim1pip_Evt_1DWpippim_nu");
+  Register<BNL_CC2pi_1pim1pip_Evt_1DWpippr_nu>(
+      "BNL_CC2pi_1pim1pip_Evt_1DWpippr_nu");
 #endif
+
 #ifdef FNAL_ENABLED
-      if (!name.compare("FNAL_CCQE_Evt_1DQ2_nu")) {
-    return (new FNAL_CCQE_Evt_1DQ2_nu(samplekey));
-    /*
-      FNAL CC1ppip
-    */
-  } else if (!name.compare("FNAL_CC1ppip_XSec_1DEnu_nu")) {
-    return (new FNAL_CC1ppip_XSec_1DEnu_nu(samplekey));
-  } else if (!name.compare("FNAL_CC1ppip_XSec_1DQ2_nu")) {
-    return (new FNAL_CC1ppip_XSec_1DQ2_nu(samplekey));
-  } else if (!name.compare("FNAL_CC1ppip_Evt_1DQ2_nu")) {
-    return (new FNAL_CC1ppip_Evt_1DQ2_nu(samplekey));
-    /*
-      FNAL CC1ppim
-    */
-  } else if (!name.compare("FNAL_CC1ppim_XSec_1DEnu_antinu")) {
-    return (new FNAL_CC1ppim_XSec_1DEnu_antinu(samplekey));
-
-    /*
-      BEBC Samples
-    */
-  } else
+  // FNAL Samples
+  Register<FNAL_CCQE_Evt_1DQ2_nu>("FNAL_CCQE_Evt_1DQ2_nu");
+  // FNAL CC1ppip
+  Register<FNAL_CC1ppip_XSec_1DEnu_nu>("FNAL_CC1ppip_XSec_1DEnu_nu");
+  Register<FNAL_CC1ppip_XSec_1DQ2_nu>("FNAL_CC1ppip_XSec_1DQ2_nu");
+  Register<FNAL_CC1ppip_Evt_1DQ2_nu>("FNAL_CC1ppip_Evt_1DQ2_nu");
+  // FNAL CC1ppim
+  Register<FNAL_CC1ppim_XSec_1DEnu_antinu>("FNAL_CC1ppim_XSec_1DEnu_antinu");
 #endif
+
 #ifdef BEBC_ENABLED
-      if (!name.compare("BEBC_CCQE_XSec_1DQ2_nu")) {
-    return (new BEBC_CCQE_XSec_1DQ2_nu(samplekey));
-    /*
-      BEBC CC1ppip samples
-    */
-  } else if (!name.compare("BEBC_CC1ppip_XSec_1DEnu_nu")) {
-    return (new BEBC_CC1ppip_XSec_1DEnu_nu(samplekey));
-  } else if (!name.compare("BEBC_CC1ppip_XSec_1DQ2_nu")) {
-    return (new BEBC_CC1ppip_XSec_1DQ2_nu(samplekey));
-    /*
-      BEBC CC1npip samples
-    */
-  } else if (!name.compare("BEBC_CC1npip_XSec_1DEnu_nu")) {
-    return (new BEBC_CC1npip_XSec_1DEnu_nu(samplekey));
-  } else if (!name.compare("BEBC_CC1npip_XSec_1DQ2_nu")) {
-    return (new BEBC_CC1npip_XSec_1DQ2_nu(samplekey));
-    /*
-      BEBC CC1pi0 samples
-    */
-  } else if (!name.compare("BEBC_CC1pi0_XSec_1DEnu_nu")) {
-    return (new BEBC_CC1pi0_XSec_1DEnu_nu(samplekey));
-  } else if (!name.compare("BEBC_CC1pi0_XSec_1DQ2_nu")) {
-    return (new BEBC_CC1pi0_XSec_1DQ2_nu(samplekey));
-    /*
-      BEBC CC1npim samples
-    */
-  } else if (!name.compare("BEBC_CC1npim_XSec_1DEnu_antinu")) {
-    return (new BEBC_CC1npim_XSec_1DEnu_antinu(samplekey));
-  } else if (!name.compare("BEBC_CC1npim_XSec_1DQ2_antinu")) {
-    return (new BEBC_CC1npim_XSec_1DQ2_antinu(samplekey));
-    /*
-      BEBC CC1ppim samples
-    */
-  } else if (!name.compare("BEBC_CC1ppim_XSec_1DEnu_antinu")) {
-    return (new BEBC_CC1ppim_XSec_1DEnu_antinu(samplekey));
-  } else if (!name.compare("BEBC_CC1ppim_XSec_1DQ2_antinu")) {
-    return (new BEBC_CC1ppim_XSec_1DQ2_antinu(samplekey));
-
-    /*
-      GGM CC1ppip samples
-    */
-  } else
+  // BEBC Samples
+  Register<BEBC_CCQE_XSec_1DQ2_nu>("BEBC_CCQE_XSec_1DQ2_nu");
+  // BEBC CC1ppip samples
+  Register<BEBC_CC1ppip_XSec_1DEnu_nu>("BEBC_CC1ppip_XSec_1DEnu_nu");
+  Register<BEBC_CC1ppip_XSec_1DQ2_nu>("BEBC_CC1ppip_XSec_1DQ2_nu");
+  // BEBC CC1npip samples
+  Register<BEBC_CC1npip_XSec_1DEnu_nu>("BEBC_CC1npip_XSec_1DEnu_nu");
+  Register<BEBC_CC1npip_XSec_1DQ2_nu>("BEBC_CC1npip_XSec_1DQ2_nu");
+  // BEBC CC1pi0 samples
+  Register<BEBC_CC1pi0_XSec_1DEnu_nu>("BEBC_CC1pi0_XSec_1DEnu_nu");
+  Register<BEBC_CC1pi0_XSec_1DQ2_nu>("BEBC_CC1pi0_XSec_1DQ2_nu");
+  // BEBC CC1npim samples
+  Register<BEBC_CC1npim_XSec_1DEnu_antinu>("BEBC_CC1npim_XSec_1DEnu_antinu");
+  Register<BEBC_CC1npim_XSec_1DQ2_antinu>("BEBC_CC1npim_XSec_1DQ2_antinu");
+  // BEBC CC1ppim samples
+  Register<BEBC_CC1ppim_XSec_1DEnu_antinu>("BEBC_CC1ppim_XSec_1DEnu_antinu");
+  Register<BEBC_CC1ppim_XSec_1DQ2_antinu>("BEBC_CC1ppim_XSec_1DQ2_antinu");
 #endif
+
 #ifdef GGM_ENABLED
-      if (!name.compare("GGM_CC1ppip_XSec_1DEnu_nu")) {
-    return (new GGM_CC1ppip_XSec_1DEnu_nu(samplekey));
-  } else if (!name.compare("GGM_CC1ppip_Evt_1DQ2_nu")) {
-    return (new GGM_CC1ppip_Evt_1DQ2_nu(samplekey));
-
-    /*
-      MiniBooNE Samples
-    */
-    /*
-      CCQE
-    */
-  } else
+  // GGM CC1ppip samples
+  Register<GGM_CC1ppip_XSec_1DEnu_nu>("GGM_CC1ppip_XSec_1DEnu_nu");
+  Register<GGM_CC1ppip_Evt_1DQ2_nu>("GGM_CC1ppip_Evt_1DQ2_nu");
 #endif
+
 #ifdef MiniBooNE_ENABLED
-      if (!name.compare("MiniBooNE_CCQE_XSec_1DQ2_nu") ||
-          !name.compare("MiniBooNE_CCQELike_XSec_1DQ2_nu")) {
-    return (new MiniBooNE_CCQE_XSec_1DQ2_nu(samplekey));
-  } else if (!name.compare("MiniBooNE_CCQE_XSec_1DEnu_nu") ||
-             !name.compare("MiniBooNE_CCQELike_XSec_1DEnu_nu")) {
-    return (new MiniBooNE_CCQE_XSec_1DEnu_nu(samplekey));
-  } else if (!name.compare("MiniBooNE_CCQE_XSec_1DQ2_antinu") ||
-             !name.compare("MiniBooNE_CCQELike_XSec_1DQ2_antinu") ||
-             !name.compare("MiniBooNE_CCQE_CTarg_XSec_1DQ2_antinu")) {
-    return (new MiniBooNE_CCQE_XSec_1DQ2_antinu(samplekey));
-
-  } else if (!name.compare("MiniBooNE_CCQE_XSec_2DTcos_nu") ||
-             !name.compare("MiniBooNE_CCQELike_XSec_2DTcos_nu")) {
-    return (new MiniBooNE_CCQE_XSec_2DTcos_nu(samplekey));
-
-  } else if (!name.compare("MiniBooNE_CCQE_XSec_2DTcos_antinu") ||
-             !name.compare("MiniBooNE_CCQELike_XSec_2DTcos_antinu")) {
-    return (new MiniBooNE_CCQE_XSec_2DTcos_antinu(samplekey));
-
-    /*
-      MiniBooNE CC1pi+
-    */
-    // 1D
-  } else if (!name.compare("MiniBooNE_CC1pip_XSec_1DEnu_nu")) {
-    return (new MiniBooNE_CC1pip_XSec_1DEnu_nu(samplekey));
-
-  } else if (!name.compare("MiniBooNE_CC1pip_XSec_1DQ2_nu")) {
-    return (new MiniBooNE_CC1pip_XSec_1DQ2_nu(samplekey));
-
-  } else if (!name.compare("MiniBooNE_CC1pip_XSec_1DTpi_nu")) {
-    return (new MiniBooNE_CC1pip_XSec_1DTpi_nu(samplekey));
-
-  } else if (!name.compare("MiniBooNE_CC1pip_XSec_1DTu_nu")) {
-    return (new MiniBooNE_CC1pip_XSec_1DTu_nu(samplekey));
-
-    // 2D
-  } else if (!name.compare("MiniBooNE_CC1pip_XSec_2DQ2Enu_nu")) {
-    return (new MiniBooNE_CC1pip_XSec_2DQ2Enu_nu(samplekey));
-
-  } else if (!name.compare("MiniBooNE_CC1pip_XSec_2DTpiCospi_nu")) {
-    return (new MiniBooNE_CC1pip_XSec_2DTpiCospi_nu(samplekey));
-
-  } else if (!name.compare("MiniBooNE_CC1pip_XSec_2DTpiEnu_nu")) {
-    return (new MiniBooNE_CC1pip_XSec_2DTpiEnu_nu(samplekey));
-
-  } else if (!name.compare("MiniBooNE_CC1pip_XSec_2DTuCosmu_nu")) {
-    return (new MiniBooNE_CC1pip_XSec_2DTuCosmu_nu(samplekey));
-
-  } else if (!name.compare("MiniBooNE_CC1pip_XSec_2DTuEnu_nu")) {
-    return (new MiniBooNE_CC1pip_XSec_2DTuEnu_nu(samplekey));
-
-    /*
-      MiniBooNE CC1pi0
-    */
-  } else if (!name.compare("MiniBooNE_CC1pi0_XSec_1DEnu_nu")) {
-    return (new MiniBooNE_CC1pi0_XSec_1DEnu_nu(samplekey));
-
-  } else if (!name.compare("MiniBooNE_CC1pi0_XSec_1DQ2_nu")) {
-    return (new MiniBooNE_CC1pi0_XSec_1DQ2_nu(samplekey));
-
-  } else if (!name.compare("MiniBooNE_CC1pi0_XSec_1DTu_nu")) {
-    return (new MiniBooNE_CC1pi0_XSec_1DTu_nu(samplekey));
-
-  } else if (!name.compare("MiniBooNE_CC1pi0_XSec_1Dcosmu_nu")) {
-    return (new MiniBooNE_CC1pi0_XSec_1Dcosmu_nu(samplekey));
-
-  } else if (!name.compare("MiniBooNE_CC1pi0_XSec_1Dcospi0_nu")) {
-    return (new MiniBooNE_CC1pi0_XSec_1Dcospi0_nu(samplekey));
-
-  } else if (!name.compare("MiniBooNE_CC1pi0_XSec_1Dppi0_nu")) {
-    return (new MiniBooNE_CC1pi0_XSec_1Dppi0_nu(samplekey));
-
-  } else if (!name.compare("MiniBooNE_NC1pi0_XSec_1Dcospi0_antinu") ||
-             !name.compare("MiniBooNE_NC1pi0_XSec_1Dcospi0_rhc")) {
-    return (new MiniBooNE_NC1pi0_XSec_1Dcospi0_antinu(samplekey));
-
-  } else if (!name.compare("MiniBooNE_NC1pi0_XSec_1Dcospi0_nu") ||
-             !name.compare("MiniBooNE_NC1pi0_XSec_1Dcospi0_fhc")) {
-    return (new MiniBooNE_NC1pi0_XSec_1Dcospi0_nu(samplekey));
-
-  } else if (!name.compare("MiniBooNE_NC1pi0_XSec_1Dppi0_antinu") ||
-             !name.compare("MiniBooNE_NC1pi0_XSec_1Dppi0_rhc")) {
-    return (new MiniBooNE_NC1pi0_XSec_1Dppi0_antinu(samplekey));
-
-  } else if (!name.compare("MiniBooNE_NC1pi0_XSec_1Dppi0_nu") ||
-             !name.compare("MiniBooNE_NC1pi0_XSec_1Dppi0_fhc")) {
-    return (new MiniBooNE_NC1pi0_XSec_1Dppi0_nu(samplekey));
-
-    /*
-      MiniBooNE NCEL
-    */
-  } else if (!name.compare("MiniBooNE_NCEL_XSec_Treco_nu")) {
-    return (new MiniBooNE_NCEL_XSec_Treco_nu(samplekey));
-  } else
+  // MiniBooNE Samples
+  // CCQE
+  Register<MiniBooNE_CCQE_XSec_1DQ2_nu>("MiniBooNE_CCQE_XSec_1DQ2_nu");
+  Register<MiniBooNE_CCQE_XSec_1DQ2_nu>("MiniBooNE_CCQELike_XSec_1DQ2_nu");
+  Register<MiniBooNE_CCQE_XSec_1DEnu_nu>("MiniBooNE_CCQE_XSec_1DEnu_nu");
+  Register<MiniBooNE_CCQE_XSec_1DEnu_nu>("MiniBooNE_CCQELike_XSec_1DEnu_nu");
+  Register<MiniBooNE_CCQE_XSec_1DQ2_antinu>("MiniBooNE_CCQE_XSec_1DQ2_antinu");
+  Register<MiniBooNE_CCQE_XSec_1DQ2_antinu>(
+      "MiniBooNE_CCQELike_XSec_1DQ2_antinu");
+  Register<MiniBooNE_CCQE_XSec_1DQ2_antinu>(
+      "MiniBooNE_CCQE_CTarg_XSec_1DQ2_antinu");
+  Register<MiniBooNE_CCQE_XSec_2DTcos_nu>("MiniBooNE_CCQE_XSec_2DTcos_nu");
+  Register<MiniBooNE_CCQE_XSec_2DTcos_nu>("MiniBooNE_CCQELike_XSec_2DTcos_nu");
+  Register<MiniBooNE_CCQE_XSec_2DTcos_antinu>(
+      "MiniBooNE_CCQE_XSec_2DTcos_antinu");
+  Register<MiniBooNE_CCQE_XSec_2DTcos_antinu>(
+      "MiniBooNE_CCQELike_XSec_2DTcos_antinu");
+  // MiniBooNE CC1pi+
+  // 1D
+  Register<MiniBooNE_CC1pip_XSec_1DEnu_nu>("MiniBooNE_CC1pip_XSec_1DEnu_nu");
+  Register<MiniBooNE_CC1pip_XSec_1DQ2_nu>("MiniBooNE_CC1pip_XSec_1DQ2_nu");
+  Register<MiniBooNE_CC1pip_XSec_1DTpi_nu>("MiniBooNE_CC1pip_XSec_1DTpi_nu");
+  Register<MiniBooNE_CC1pip_XSec_1DTu_nu>("MiniBooNE_CC1pip_XSec_1DTu_nu");
+  // 2D
+  Register<MiniBooNE_CC1pip_XSec_2DQ2Enu_nu>(
+      "MiniBooNE_CC1pip_XSec_2DQ2Enu_nu");
+  Register<MiniBooNE_CC1pip_XSec_2DTpiCospi_nu>(
+      "MiniBooNE_CC1pip_XSec_2DTpiCospi_nu");
+  Register<MiniBooNE_CC1pip_XSec_2DTpiEnu_nu>(
+      "MiniBooNE_CC1pip_XSec_2DTpiEnu_nu");
+  Register<MiniBooNE_CC1pip_XSec_2DTuCosmu_nu>(
+      "MiniBooNE_CC1pip_XSec_2DTuCosmu_nu");
+  Register<MiniBooNE_CC1pip_XSec_2DTuEnu_nu>(
+      "MiniBooNE_CC1pip_XSec_2DTuEnu_nu");
+  // MiniBooNE CC1pi0
+  Register<MiniBooNE_CC1pi0_XSec_1DEnu_nu>("MiniBooNE_CC1pi0_XSec_1DEnu_nu");
+  Register<MiniBooNE_CC1pi0_XSec_1DQ2_nu>("MiniBooNE_CC1pi0_XSec_1DQ2_nu");
+  Register<MiniBooNE_CC1pi0_XSec_1DTu_nu>("MiniBooNE_CC1pi0_XSec_1DTu_nu");
+  Register<MiniBooNE_CC1pi0_XSec_1Dcosmu_nu>(
+      "MiniBooNE_CC1pi0_XSec_1Dcosmu_nu");
+  Register<MiniBooNE_CC1pi0_XSec_1Dcospi0_nu>(
+      "MiniBooNE_CC1pi0_XSec_1Dcospi0_nu");
+  Register<MiniBooNE_CC1pi0_XSec_1Dppi0_nu>("MiniBooNE_CC1pi0_XSec_1Dppi0_nu");
+  Register<MiniBooNE_NC1pi0_XSec_1Dcospi0_antinu>(
+      "MiniBooNE_NC1pi0_XSec_1Dcospi0_antinu");
+  Register<MiniBooNE_NC1pi0_XSec_1Dcospi0_antinu>(
+      "MiniBooNE_NC1pi0_XSec_1Dcospi0_rhc");
+  Register<MiniBooNE_NC1pi0_XSec_1Dcospi0_nu>(
+      "MiniBooNE_NC1pi0_XSec_1Dcospi0_nu");
+  Register<MiniBooNE_NC1pi0_XSec_1Dcospi0_nu>(
+      "MiniBooNE_NC1pi0_XSec_1Dcospi0_fhc");
+  Register<MiniBooNE_NC1pi0_XSec_1Dppi0_antinu>(
+      "MiniBooNE_NC1pi0_XSec_1Dppi0_antinu");
+  Register<MiniBooNE_NC1pi0_XSec_1Dppi0_antinu>(
+      "MiniBooNE_NC1pi0_XSec_1Dppi0_rhc");
+  Register<MiniBooNE_NC1pi0_XSec_1Dppi0_nu>("MiniBooNE_NC1pi0_XSec_1Dppi0_nu");
+  Register<MiniBooNE_NC1pi0_XSec_1Dppi0_nu>("MiniBooNE_NC1pi0_XSec_1Dppi0_fhc");
+  // MiniBooNE NCEL
+  Register<MiniBooNE_NCEL_XSec_Treco_nu>("MiniBooNE_NCEL_XSec_Treco_nu");
 #endif
 
 #ifdef MicroBooNE_ENABLED
-      /*
-      MicroBooNE Samples
-      */
-      if (!name.compare("MicroBooNE_CCInc_XSec_2DPcos_nu")) {
-    return (new MicroBooNE_CCInc_XSec_2DPcos_nu(samplekey));
-  } else if (!name.compare("MicroBooNE_CC1MuNp_XSec_1DPmu_nu") ||
-             !name.compare("MicroBooNE_CC1MuNp_XSec_1Dcosmu_nu") ||
-             !name.compare("MicroBooNE_CC1MuNp_XSec_1DPp_nu") ||
-             !name.compare("MicroBooNE_CC1MuNp_XSec_1Dcosp_nu") ||
-             !name.compare("MicroBooNE_CC1MuNp_XSec_1Dthetamup_nu")) {
-    return (new MicroBooNE_CC1MuNp_XSec_1D_nu(samplekey));
-  } else
+  // MicroBooNE Samples
+  Register<MicroBooNE_CCInc_XSec_2DPcos_nu>("MicroBooNE_CCInc_XSec_2DPcos_nu");
+  Register<MicroBooNE_CC1MuNp_XSec_1D_nu>("MicroBooNE_CC1MuNp_XSec_1DPmu_nu");
+  Register<MicroBooNE_CC1MuNp_XSec_1D_nu>("MicroBooNE_CC1MuNp_XSec_1Dcosmu_nu");
+  Register<MicroBooNE_CC1MuNp_XSec_1D_nu>("MicroBooNE_CC1MuNp_XSec_1DPp_nu");
+  Register<MicroBooNE_CC1MuNp_XSec_1D_nu>("MicroBooNE_CC1MuNp_XSec_1Dcosp_nu");
+  Register<MicroBooNE_CC1MuNp_XSec_1D_nu>(
+      "MicroBooNE_CC1MuNp_XSec_1Dthetamup_nu");
 #endif
 
 #ifdef MINERvA_ENABLED
-      /*
-      MINERvA Samples
-      */
-      if (!name.compare("MINERvA_CCQE_XSec_1DQ2_nu") ||
-          !name.compare("MINERvA_CCQE_XSec_1DQ2_nu_20deg") ||
-          !name.compare("MINERvA_CCQE_XSec_1DQ2_nu_oldflux") ||
-          !name.compare("MINERvA_CCQE_XSec_1DQ2_nu_20deg_oldflux")) {
-    return (new MINERvA_CCQE_XSec_1DQ2_nu(samplekey));
-
-  } else if (!name.compare("MINERvA_CCQE_XSec_1DQ2_antinu") ||
-             !name.compare("MINERvA_CCQE_XSec_1DQ2_antinu_20deg") ||
-             !name.compare("MINERvA_CCQE_XSec_1DQ2_antinu_oldflux") ||
-             !name.compare("MINERvA_CCQE_XSec_1DQ2_antinu_20deg_oldflux")) {
-    return (new MINERvA_CCQE_XSec_1DQ2_antinu(samplekey));
-
-  } else if (!name.compare("MINERvA_CCQE_XSec_1DQ2_joint_oldflux") ||
-             !name.compare("MINERvA_CCQE_XSec_1DQ2_joint_20deg_oldflux") ||
-             !name.compare("MINERvA_CCQE_XSec_1DQ2_joint") ||
-             !name.compare("MINERvA_CCQE_XSec_1DQ2_joint_20deg")) {
-    return (new MINERvA_CCQE_XSec_1DQ2_joint(samplekey));
-
-  } else if (!name.compare("MINERvA_CC0pi_XSec_1DEe_nue")) {
-    return (new MINERvA_CC0pi_XSec_1DEe_nue(samplekey));
-
-  } else if (!name.compare("MINERvA_CC0pi_XSec_1DQ2_nue")) {
-    return (new MINERvA_CC0pi_XSec_1DQ2_nue(samplekey));
-
-  } else if (!name.compare("MINERvA_CC0pi_XSec_1DThetae_nue")) {
-    return (new MINERvA_CC0pi_XSec_1DThetae_nue(samplekey));
-
-  } else if (!name.compare("MINERvA_CC0pinp_STV_XSec_1Dpmu_nu") ||
-             !name.compare("MINERvA_CC0pinp_STV_XSec_1Dthmu_nu") ||
-             !name.compare("MINERvA_CC0pinp_STV_XSec_1Dpprot_nu") ||
-             !name.compare("MINERvA_CC0pinp_STV_XSec_1Dthprot_nu") ||
-             !name.compare("MINERvA_CC0pinp_STV_XSec_1Dpnreco_nu") ||
-             !name.compare("MINERvA_CC0pinp_STV_XSec_1Ddalphat_nu") ||
-             !name.compare("MINERvA_CC0pinp_STV_XSec_1Ddpt_nu") ||
-             !name.compare("MINERvA_CC0pinp_STV_XSec_1Ddphit_nu")) {
-    return (new MINERvA_CC0pinp_STV_XSec_1D_nu(samplekey));
-
-  } else if (!name.compare("MINERvA_CC0pi_XSec_1DQ2_nu_proton")) {
-    return (new MINERvA_CC0pi_XSec_1DQ2_nu_proton(samplekey));
-
-  } else if (!name.compare("MINERvA_CC0pi_XSec_1DQ2_TgtC_nu") ||
-             !name.compare("MINERvA_CC0pi_XSec_1DQ2_TgtCH_nu") ||
-             !name.compare("MINERvA_CC0pi_XSec_1DQ2_TgtFe_nu") ||
-             !name.compare("MINERvA_CC0pi_XSec_1DQ2_TgtPb_nu")) {
-    return (new MINERvA_CC0pi_XSec_1DQ2_Tgt_nu(samplekey));
-
-  } else if (!name.compare("MINERvA_CC0pi_XSec_1DQ2_TgtRatioC_nu") ||
-             !name.compare("MINERvA_CC0pi_XSec_1DQ2_TgtRatioFe_nu") ||
-             !name.compare("MINERvA_CC0pi_XSec_1DQ2_TgtRatioPb_nu")) {
-    return (new MINERvA_CC0pi_XSec_1DQ2_TgtRatio_nu(samplekey));
-
-    // Dan Ruterbories measurements of late 2018
-  } else if (!name.compare("MINERvA_CC0pi_XSec_2Dptpz_nu")) {
-    return (new MINERvA_CC0pi_XSec_2D_nu(samplekey));
-
-    // } else if (!name.compare("MINERvA_CC0pi_XSec_3DptpzTp_nu")) {
-    // return (new MINERvA_CC0pi_XSec_3DptpzTp_nu(samplekey));
-
-  } else if (!name.compare("MINERvA_CC0pi_XSec_1Dpt_nu") ||
-             !name.compare("MINERvA_CC0pi_XSec_1Dpz_nu") ||
-             !name.compare("MINERvA_CC0pi_XSec_1DQ2QE_nu") ||
-             !name.compare("MINERvA_CC0pi_XSec_1DEnuQE_nu")) {
-    return (new MINERvA_CC0pi_XSec_1D_2018_nu(samplekey));
-
-    // C. Patrick's early 2018 measurements
-  } else if (!name.compare("MINERvA_CC0pi_XSec_2Dptpz_antinu") ||
-             !name.compare("MINERvA_CC0pi_XSec_2DQ2QEEnuQE_antinu") ||
-             !name.compare("MINERvA_CC0pi_XSec_2DQ2QEEnuTrue_antinu")) {
-    return (new MINERvA_CC0pi_XSec_2D_antinu(samplekey));
-
-    /*
-      CC1pi+
-    */
-    // DONE
-  } else if (!name.compare("MINERvA_CC1pip_XSec_1DTpi_nu") ||
-             !name.compare("MINERvA_CC1pip_XSec_1DTpi_nu_20deg") ||
-             !name.compare("MINERvA_CC1pip_XSec_1DTpi_nu_fluxcorr") ||
-             !name.compare("MINERvA_CC1pip_XSec_1DTpi_nu_20deg_fluxcorr")) {
-    return (new MINERvA_CC1pip_XSec_1DTpi_nu(samplekey));
-
-    // DONE
-  } else if (!name.compare("MINERvA_CC1pip_XSec_1Dth_nu") ||
-             !name.compare("MINERvA_CC1pip_XSec_1Dth_nu_20deg") ||
-             !name.compare("MINERvA_CC1pip_XSec_1Dth_nu_fluxcorr") ||
-             !name.compare("MINERvA_CC1pip_XSec_1Dth_nu_20deg_fluxcorr")) {
-    return (new MINERvA_CC1pip_XSec_1Dth_nu(samplekey));
-
-  } else if (!name.compare("MINERvA_CC1pip_XSec_1DTpi_nu_2017") ||
-             !name.compare("MINERvA_CC1pip_XSec_1Dth_nu_2017") ||
-             !name.compare("MINERvA_CC1pip_XSec_1Dpmu_nu_2017") ||
-             !name.compare("MINERvA_CC1pip_XSec_1Dthmu_nu_2017") ||
-             !name.compare("MINERvA_CC1pip_XSec_1DQ2_nu_2017") ||
-             !name.compare("MINERvA_CC1pip_XSec_1DEnu_nu_2017")) {
-    return (new MINERvA_CC1pip_XSec_1D_2017Update(samplekey));
-    /*
-      CC1pi-
-    */
-  } else if (!name.compare("MINERvA_CC1pim_XSec_1DEnu_antinu")) {
-    return (new MINERvA_CC1pim_XSec_1DEnu_antinu(samplekey));
-
-  } else if (!name.compare("MINERvA_CC1pim_XSec_1DQ2_antinu")) {
-    return (new MINERvA_CC1pim_XSec_1DQ2_antinu(samplekey));
-
-  } else if (!name.compare("MINERvA_CC1pim_XSec_1DTpi_antinu")) {
-    return (new MINERvA_CC1pim_XSec_1DTpi_antinu(samplekey));
-
-  } else if (!name.compare("MINERvA_CC1pim_XSec_1Dpmu_antinu")) {
-    return (new MINERvA_CC1pim_XSec_1Dpmu_antinu(samplekey));
-
-  } else if (!name.compare("MINERvA_CC1pim_XSec_1Dth_antinu")) {
-    return (new MINERvA_CC1pim_XSec_1Dth_antinu(samplekey));
-
-  } else if (!name.compare("MINERvA_CC1pim_XSec_1Dthmu_antinu")) {
-    return (new MINERvA_CC1pim_XSec_1Dthmu_antinu(samplekey));
-    /*
-      CCNpi+
-    */
-  } else if (!name.compare("MINERvA_CCNpip_XSec_1Dth_nu") ||
-             !name.compare("MINERvA_CCNpip_XSec_1Dth_nu_2015") ||
-             !name.compare("MINERvA_CCNpip_XSec_1Dth_nu_2016") ||
-             !name.compare("MINERvA_CCNpip_XSec_1Dth_nu_2015_20deg") ||
-             !name.compare("MINERvA_CCNpip_XSec_1Dth_nu_2015_fluxcorr") ||
-             !name.compare("MINERvA_CCNpip_XSec_1Dth_nu_2015_20deg_fluxcorr")) {
-    return (new MINERvA_CCNpip_XSec_1Dth_nu(samplekey));
-
-  } else if (!name.compare("MINERvA_CCNpip_XSec_1DTpi_nu") ||
-             !name.compare("MINERvA_CCNpip_XSec_1DTpi_nu_2015") ||
-             !name.compare("MINERvA_CCNpip_XSec_1DTpi_nu_2016") ||
-             !name.compare("MINERvA_CCNpip_XSec_1DTpi_nu_2015_20deg") ||
-             !name.compare("MINERvA_CCNpip_XSec_1DTpi_nu_2015_fluxcorr") ||
-             !name.compare("MINERvA_CCNpip_XSec_1DTpi_nu_2015_20deg_fluxcorr")) {
-    return (new MINERvA_CCNpip_XSec_1DTpi_nu(samplekey));
-
-  } else if (!name.compare("MINERvA_CCNpip_XSec_1Dthmu_nu")) {
-    return (new MINERvA_CCNpip_XSec_1Dthmu_nu(samplekey));
-
-  } else if (!name.compare("MINERvA_CCNpip_XSec_1Dpmu_nu")) {
-    return (new MINERvA_CCNpip_XSec_1Dpmu_nu(samplekey));
-
-  } else if (!name.compare("MINERvA_CCNpip_XSec_1DQ2_nu")) {
-    return (new MINERvA_CCNpip_XSec_1DQ2_nu(samplekey));
-
-  } else if (!name.compare("MINERvA_CCNpip_XSec_1DEnu_nu")) {
-    return (new MINERvA_CCNpip_XSec_1DEnu_nu(samplekey));
-
-    /*
-      MINERvA CC1pi0 anti-nu
-    */
-    // Done
-  } else if (!name.compare("MINERvA_CC1pi0_XSec_1Dth_antinu") ||
-             !name.compare("MINERvA_CC1pi0_XSec_1Dth_antinu_2015") ||
-             !name.compare("MINERvA_CC1pi0_XSec_1Dth_antinu_2016") ||
-             !name.compare("MINERvA_CC1pi0_XSec_1Dth_antinu_fluxcorr") ||
-             !name.compare("MINERvA_CC1pi0_XSec_1Dth_antinu_2015_fluxcorr") ||
-             !name.compare("MINERvA_CC1pi0_XSec_1Dth_antinu_2016_fluxcorr")) {
-    return (new MINERvA_CC1pi0_XSec_1Dth_antinu(samplekey));
-
-  } else if (!name.compare("MINERvA_CC1pi0_XSec_1Dppi0_antinu") ||
-             !name.compare("MINERvA_CC1pi0_XSec_1Dppi0_antinu_fluxcorr")) {
-    return (new MINERvA_CC1pi0_XSec_1Dppi0_antinu(samplekey));
-
-  } else if (!name.compare("MINERvA_CC1pi0_XSec_1DTpi0_antinu")) {
-    return (new MINERvA_CC1pi0_XSec_1DTpi0_antinu(samplekey));
-
-    // Done
-  } else if (!name.compare("MINERvA_CC1pi0_XSec_1DQ2_antinu")) {
-    return (new MINERvA_CC1pi0_XSec_1DQ2_antinu(samplekey));
-
-    // Done
-  } else if (!name.compare("MINERvA_CC1pi0_XSec_1Dthmu_antinu")) {
-    return (new MINERvA_CC1pi0_XSec_1Dthmu_antinu(samplekey));
-
-    // Done
-  } else if (!name.compare("MINERvA_CC1pi0_XSec_1Dpmu_antinu")) {
-    return (new MINERvA_CC1pi0_XSec_1Dpmu_antinu(samplekey));
-
-    // Done
-  } else if (!name.compare("MINERvA_CC1pi0_XSec_1DEnu_antinu")) {
-    return (new MINERvA_CC1pi0_XSec_1DEnu_antinu(samplekey));
-
-    // MINERvA CC1pi0 nu
-  } else if (!name.compare("MINERvA_CC1pi0_XSec_1DTpi_nu") ||
-             !name.compare("MINERvA_CC1pi0_XSec_1Dth_nu") ||
-             !name.compare("MINERvA_CC1pi0_XSec_1Dpmu_nu") ||
-             !name.compare("MINERvA_CC1pi0_XSec_1Dthmu_nu") ||
-             !name.compare("MINERvA_CC1pi0_XSec_1DQ2_nu") ||
-             !name.compare("MINERvA_CC1pi0_XSec_1DEnu_nu") ||
-             !name.compare("MINERvA_CC1pi0_XSec_1DWexp_nu") ||
-             !name.compare("MINERvA_CC1pi0_XSec_1DPPi0Mass_nu") ||
-             !name.compare("MINERvA_CC1pi0_XSec_1DPPi0MassDelta_nu") ||
-             !name.compare("MINERvA_CC1pi0_XSec_1DCosAdler_nu") ||
-             !name.compare("MINERvA_CC1pi0_XSec_1DPhiAdler_nu")) {
-    return (new MINERvA_CC1pi0_XSec_1D_nu(samplekey));
-
-    /*
-      CCINC
-    */
-  } else if (!name.compare("MINERvA_CCinc_XSec_2DEavq3_nu")) {
-    return (new MINERvA_CCinc_XSec_2DEavq3_nu(samplekey));
-
-  } else if (!name.compare("MINERvA_CCinc_XSec_1Dx_ratio_C12_CH") ||
-             !name.compare("MINERvA_CCinc_XSec_1Dx_ratio_Fe56_CH") ||
-             !name.compare("MINERvA_CCinc_XSec_1Dx_ratio_Pb208_CH")) {
-    return (new MINERvA_CCinc_XSec_1Dx_ratio(samplekey));
-
-  } else if (!name.compare("MINERvA_CCinc_XSec_1DEnu_ratio_C12_CH") ||
-             !name.compare("MINERvA_CCinc_XSec_1DEnu_ratio_Fe56_CH") ||
-             !name.compare("MINERvA_CCinc_XSec_1DEnu_ratio_Pb208_CH")) {
-    return (new MINERvA_CCinc_XSec_1DEnu_ratio(samplekey));
-    /*
-      CCDIS
-    */
-  } else if (!name.compare("MINERvA_CCDIS_XSec_1Dx_ratio_C12_CH") ||
-             !name.compare("MINERvA_CCDIS_XSec_1Dx_ratio_Fe56_CH") ||
-             !name.compare("MINERvA_CCDIS_XSec_1Dx_ratio_Pb208_CH")) {
-    return (new MINERvA_CCDIS_XSec_1Dx_ratio(samplekey));
-
-  } else if (!name.compare("MINERvA_CCDIS_XSec_1DEnu_ratio_C12_CH") ||
-             !name.compare("MINERvA_CCDIS_XSec_1DEnu_ratio_Fe56_CH") ||
-             !name.compare("MINERvA_CCDIS_XSec_1DEnu_ratio_Pb208_CH")) {
-    return (new MINERvA_CCDIS_XSec_1DEnu_ratio(samplekey));
-
-    /*
-      CC-COH
-    */
-  } else if (!name.compare("MINERvA_CCCOHPI_XSec_1DEnu_nu")) {
-    return (new MINERvA_CCCOHPI_XSec_1DEnu_nu(samplekey));
-  } else if (!name.compare("MINERvA_CCCOHPI_XSec_1DEpi_nu")) {
-    return (new MINERvA_CCCOHPI_XSec_1DEpi_nu(samplekey));
-  } else if (!name.compare("MINERvA_CCCOHPI_XSec_1Dth_nu")) {
-    return (new MINERvA_CCCOHPI_XSec_1Dth_nu(samplekey));
-  } else if (!name.compare("MINERvA_CCCOHPI_XSec_1DQ2_nu")) {
-    return (new MINERvA_CCCOHPI_XSec_1DQ2_nu(samplekey));
-  } else if (!name.compare("MINERvA_CCCOHPI_XSec_1DEnu_antinu")) {
-    return (new MINERvA_CCCOHPI_XSec_1DEnu_antinu(samplekey));
-  } else if (!name.compare("MINERvA_CCCOHPI_XSec_1DEpi_antinu")) {
-    return (new MINERvA_CCCOHPI_XSec_1DEpi_antinu(samplekey));
-  } else if (!name.compare("MINERvA_CCCOHPI_XSec_1Dth_antinu")) {
-    return (new MINERvA_CCCOHPI_XSec_1Dth_antinu(samplekey));
-  } else if (!name.compare("MINERvA_CCCOHPI_XSec_1DQ2_antinu")) {
-    return (new MINERvA_CCCOHPI_XSec_1DQ2_antinu(samplekey));
-
-  } else if (!name.compare("MINERvA_CCCOHPI_XSec_1DEnu_joint")) {
-    return (new MINERvA_CCCOHPI_XSec_joint(samplekey));
-  } else if (!name.compare("MINERvA_CCCOHPI_XSec_1DEpi_joint")) {
-    return (new MINERvA_CCCOHPI_XSec_joint(samplekey));
-  } else if (!name.compare("MINERvA_CCCOHPI_XSec_1Dth_joint")) {
-    return (new MINERvA_CCCOHPI_XSec_joint(samplekey));
-  } else if (!name.compare("MINERvA_CCCOHPI_XSec_1DQ2_joint")) {
-    return (new MINERvA_CCCOHPI_XSec_joint(samplekey));
-
-    /*
-    T2K Samples
-    */
-
-  } else
+  // MINERvA Samples
+  Register<MINERvA_CCQE_XSec_1DQ2_nu>("MINERvA_CCQE_XSec_1DQ2_nu");
+  Register<MINERvA_CCQE_XSec_1DQ2_nu>("MINERvA_CCQE_XSec_1DQ2_nu_20deg");
+  Register<MINERvA_CCQE_XSec_1DQ2_nu>("MINERvA_CCQE_XSec_1DQ2_nu_oldflux");
+  Register<MINERvA_CCQE_XSec_1DQ2_nu>(
+      "MINERvA_CCQE_XSec_1DQ2_nu_20deg_oldflux");
+  Register<MINERvA_CCQE_XSec_1DQ2_antinu>("MINERvA_CCQE_XSec_1DQ2_antinu");
+  Register<MINERvA_CCQE_XSec_1DQ2_antinu>(
+      "MINERvA_CCQE_XSec_1DQ2_antinu_20deg");
+  Register<MINERvA_CCQE_XSec_1DQ2_antinu>(
+      "MINERvA_CCQE_XSec_1DQ2_antinu_oldflux");
+  Register<MINERvA_CCQE_XSec_1DQ2_antinu>(
+      "MINERvA_CCQE_XSec_1DQ2_antinu_20deg_oldflux");
+  Register<MINERvA_CCQE_XSec_1DQ2_joint>(
+      "MINERvA_CCQE_XSec_1DQ2_joint_oldflux");
+  Register<MINERvA_CCQE_XSec_1DQ2_joint>(
+      "MINERvA_CCQE_XSec_1DQ2_joint_20deg_oldflux");
+  Register<MINERvA_CCQE_XSec_1DQ2_joint>("MINERvA_CCQE_XSec_1DQ2_joint");
+  Register<MINERvA_CCQE_XSec_1DQ2_joint>("MINERvA_CCQE_XSec_1DQ2_joint_20deg");
+  Register<MINERvA_CC0pi_XSec_1DEe_nue>("MINERvA_CC0pi_XSec_1DEe_nue");
+  Register<MINERvA_CC0pi_XSec_1DQ2_nue>("MINERvA_CC0pi_XSec_1DQ2_nue");
+  Register<MINERvA_CC0pi_XSec_1DThetae_nue>("MINERvA_CC0pi_XSec_1DThetae_nue");
+  Register<MINERvA_CC0pinp_STV_XSec_1D_nu>("MINERvA_CC0pinp_STV_XSec_1Dpmu_nu");
+  Register<MINERvA_CC0pinp_STV_XSec_1D_nu>(
+      "MINERvA_CC0pinp_STV_XSec_1Dthmu_nu");
+  Register<MINERvA_CC0pinp_STV_XSec_1D_nu>(
+      "MINERvA_CC0pinp_STV_XSec_1Dpprot_nu");
+  Register<MINERvA_CC0pinp_STV_XSec_1D_nu>(
+      "MINERvA_CC0pinp_STV_XSec_1Dthprot_nu");
+  Register<MINERvA_CC0pinp_STV_XSec_1D_nu>(
+      "MINERvA_CC0pinp_STV_XSec_1Dpnreco_nu");
+  Register<MINERvA_CC0pinp_STV_XSec_1D_nu>(
+      "MINERvA_CC0pinp_STV_XSec_1Ddalphat_nu");
+  Register<MINERvA_CC0pinp_STV_XSec_1D_nu>("MINERvA_CC0pinp_STV_XSec_1Ddpt_nu");
+  Register<MINERvA_CC0pinp_STV_XSec_1D_nu>(
+      "MINERvA_CC0pinp_STV_XSec_1Ddphit_nu");
+  Register<MINERvA_CC0pi_XSec_1DQ2_nu_proton>(
+      "MINERvA_CC0pi_XSec_1DQ2_nu_proton");
+  Register<MINERvA_CC0pi_XSec_1DQ2_Tgt_nu>("MINERvA_CC0pi_XSec_1DQ2_TgtC_nu");
+  Register<MINERvA_CC0pi_XSec_1DQ2_Tgt_nu>("MINERvA_CC0pi_XSec_1DQ2_TgtCH_nu");
+  Register<MINERvA_CC0pi_XSec_1DQ2_Tgt_nu>("MINERvA_CC0pi_XSec_1DQ2_TgtFe_nu");
+  Register<MINERvA_CC0pi_XSec_1DQ2_Tgt_nu>("MINERvA_CC0pi_XSec_1DQ2_TgtPb_nu");
+  Register<MINERvA_CC0pi_XSec_1DQ2_TgtRatio_nu>(
+      "MINERvA_CC0pi_XSec_1DQ2_TgtRatioC_nu");
+  Register<MINERvA_CC0pi_XSec_1DQ2_TgtRatio_nu>(
+      "MINERvA_CC0pi_XSec_1DQ2_TgtRatioFe_nu");
+  Register<MINERvA_CC0pi_XSec_1DQ2_TgtRatio_nu>(
+      "MINERvA_CC0pi_XSec_1DQ2_TgtRatioPb_nu");
+  // Dan Ruterbories measurements of late 2018
+  Register<MINERvA_CC0pi_XSec_2D_nu>("MINERvA_CC0pi_XSec_2Dptpz_nu");
+  // Register<MINERvA_CC0pi_XSec_3DptpzTp_nu>("MINERvA_CC0pi_XSec_3DptpzTp_nu");
+  Register<MINERvA_CC0pi_XSec_1D_2018_nu>("MINERvA_CC0pi_XSec_1Dpt_nu");
+  Register<MINERvA_CC0pi_XSec_1D_2018_nu>("MINERvA_CC0pi_XSec_1Dpz_nu");
+  Register<MINERvA_CC0pi_XSec_1D_2018_nu>("MINERvA_CC0pi_XSec_1DQ2QE_nu");
+  Register<MINERvA_CC0pi_XSec_1D_2018_nu>("MINERvA_CC0pi_XSec_1DEnuQE_nu");
+  // C. Patrick's early 2018 measurements
+  Register<MINERvA_CC0pi_XSec_2D_antinu>("MINERvA_CC0pi_XSec_2Dptpz_antinu");
+  Register<MINERvA_CC0pi_XSec_2D_antinu>(
+      "MINERvA_CC0pi_XSec_2DQ2QEEnuQE_antinu");
+  Register<MINERvA_CC0pi_XSec_2D_antinu>(
+      "MINERvA_CC0pi_XSec_2DQ2QEEnuTrue_antinu");
+  // CC1pi+
+  Register<MINERvA_CC1pip_XSec_1DTpi_nu>("MINERvA_CC1pip_XSec_1DTpi_nu");
+  Register<MINERvA_CC1pip_XSec_1DTpi_nu>("MINERvA_CC1pip_XSec_1DTpi_nu_20deg");
+  Register<MINERvA_CC1pip_XSec_1DTpi_nu>(
+      "MINERvA_CC1pip_XSec_1DTpi_nu_fluxcorr");
+  Register<MINERvA_CC1pip_XSec_1DTpi_nu>(
+      "MINERvA_CC1pip_XSec_1DTpi_nu_20deg_fluxcorr");
+  Register<MINERvA_CC1pip_XSec_1Dth_nu>("MINERvA_CC1pip_XSec_1Dth_nu");
+  Register<MINERvA_CC1pip_XSec_1Dth_nu>("MINERvA_CC1pip_XSec_1Dth_nu_20deg");
+  Register<MINERvA_CC1pip_XSec_1Dth_nu>("MINERvA_CC1pip_XSec_1Dth_nu_fluxcorr");
+  Register<MINERvA_CC1pip_XSec_1Dth_nu>(
+      "MINERvA_CC1pip_XSec_1Dth_nu_20deg_fluxcorr");
+  Register<MINERvA_CC1pip_XSec_1D_2017Update>(
+      "MINERvA_CC1pip_XSec_1DTpi_nu_2017");
+  Register<MINERvA_CC1pip_XSec_1D_2017Update>(
+      "MINERvA_CC1pip_XSec_1Dth_nu_2017");
+  Register<MINERvA_CC1pip_XSec_1D_2017Update>(
+      "MINERvA_CC1pip_XSec_1Dpmu_nu_2017");
+  Register<MINERvA_CC1pip_XSec_1D_2017Update>(
+      "MINERvA_CC1pip_XSec_1Dthmu_nu_2017");
+  Register<MINERvA_CC1pip_XSec_1D_2017Update>(
+      "MINERvA_CC1pip_XSec_1DQ2_nu_2017");
+  Register<MINERvA_CC1pip_XSec_1D_2017Update>(
+      "MINERvA_CC1pip_XSec_1DEnu_nu_2017");
+  // CC1pi-
+  Register<MINERvA_CC1pim_XSec_1DEnu_antinu>(
+      "MINERvA_CC1pim_XSec_1DEnu_antinu");
+  Register<MINERvA_CC1pim_XSec_1DQ2_antinu>("MINERvA_CC1pim_XSec_1DQ2_antinu");
+  Register<MINERvA_CC1pim_XSec_1DTpi_antinu>(
+      "MINERvA_CC1pim_XSec_1DTpi_antinu");
+  Register<MINERvA_CC1pim_XSec_1Dpmu_antinu>(
+      "MINERvA_CC1pim_XSec_1Dpmu_antinu");
+  Register<MINERvA_CC1pim_XSec_1Dth_antinu>("MINERvA_CC1pim_XSec_1Dth_antinu");
+  Register<MINERvA_CC1pim_XSec_1Dthmu_antinu>(
+      "MINERvA_CC1pim_XSec_1Dthmu_antinu");
+  // CCNpi+
+  Register<MINERvA_CCNpip_XSec_1Dth_nu>("MINERvA_CCNpip_XSec_1Dth_nu");
+  Register<MINERvA_CCNpip_XSec_1Dth_nu>("MINERvA_CCNpip_XSec_1Dth_nu_2015");
+  Register<MINERvA_CCNpip_XSec_1Dth_nu>("MINERvA_CCNpip_XSec_1Dth_nu_2016");
+  Register<MINERvA_CCNpip_XSec_1Dth_nu>(
+      "MINERvA_CCNpip_XSec_1Dth_nu_2015_20deg");
+  Register<MINERvA_CCNpip_XSec_1Dth_nu>(
+      "MINERvA_CCNpip_XSec_1Dth_nu_2015_fluxcorr");
+  Register<MINERvA_CCNpip_XSec_1Dth_nu>(
+      "MINERvA_CCNpip_XSec_1Dth_nu_2015_20deg_fluxcorr");
+  Register<MINERvA_CCNpip_XSec_1DTpi_nu>("MINERvA_CCNpip_XSec_1DTpi_nu");
+  Register<MINERvA_CCNpip_XSec_1DTpi_nu>("MINERvA_CCNpip_XSec_1DTpi_nu_2015");
+  Register<MINERvA_CCNpip_XSec_1DTpi_nu>("MINERvA_CCNpip_XSec_1DTpi_nu_2016");
+  Register<MINERvA_CCNpip_XSec_1DTpi_nu>(
+      "MINERvA_CCNpip_XSec_1DTpi_nu_2015_20deg");
+  Register<MINERvA_CCNpip_XSec_1DTpi_nu>(
+      "MINERvA_CCNpip_XSec_1DTpi_nu_2015_fluxcorr");
+  Register<MINERvA_CCNpip_XSec_1DTpi_nu>(
+      "MINERvA_CCNpip_XSec_1DTpi_nu_2015_20deg_fluxcorr");
+  Register<MINERvA_CCNpip_XSec_1Dthmu_nu>("MINERvA_CCNpip_XSec_1Dthmu_nu");
+  Register<MINERvA_CCNpip_XSec_1Dpmu_nu>("MINERvA_CCNpip_XSec_1Dpmu_nu");
+  Register<MINERvA_CCNpip_XSec_1DQ2_nu>("MINERvA_CCNpip_XSec_1DQ2_nu");
+  Register<MINERvA_CCNpip_XSec_1DEnu_nu>("MINERvA_CCNpip_XSec_1DEnu_nu");
+  // MINERvA CC1pi0 anti-nu
+  Register<MINERvA_CC1pi0_XSec_1Dth_antinu>("MINERvA_CC1pi0_XSec_1Dth_antinu");
+  Register<MINERvA_CC1pi0_XSec_1Dth_antinu>(
+      "MINERvA_CC1pi0_XSec_1Dth_antinu_2015");
+  Register<MINERvA_CC1pi0_XSec_1Dth_antinu>(
+      "MINERvA_CC1pi0_XSec_1Dth_antinu_2016");
+  Register<MINERvA_CC1pi0_XSec_1Dth_antinu>(
+      "MINERvA_CC1pi0_XSec_1Dth_antinu_fluxcorr");
+  Register<MINERvA_CC1pi0_XSec_1Dth_antinu>(
+      "MINERvA_CC1pi0_XSec_1Dth_antinu_2015_fluxcorr");
+  Register<MINERvA_CC1pi0_XSec_1Dth_antinu>(
+      "MINERvA_CC1pi0_XSec_1Dth_antinu_2016_fluxcorr");
+  Register<MINERvA_CC1pi0_XSec_1Dppi0_antinu>(
+      "MINERvA_CC1pi0_XSec_1Dppi0_antinu");
+  Register<MINERvA_CC1pi0_XSec_1Dppi0_antinu>(
+      "MINERvA_CC1pi0_XSec_1Dppi0_antinu_fluxcorr");
+  Register<MINERvA_CC1pi0_XSec_1DTpi0_antinu>(
+      "MINERvA_CC1pi0_XSec_1DTpi0_antinu");
+  Register<MINERvA_CC1pi0_XSec_1DQ2_antinu>("MINERvA_CC1pi0_XSec_1DQ2_antinu");
+  Register<MINERvA_CC1pi0_XSec_1Dthmu_antinu>(
+      "MINERvA_CC1pi0_XSec_1Dthmu_antinu");
+  Register<MINERvA_CC1pi0_XSec_1Dpmu_antinu>(
+      "MINERvA_CC1pi0_XSec_1Dpmu_antinu");
+  Register<MINERvA_CC1pi0_XSec_1DEnu_antinu>(
+      "MINERvA_CC1pi0_XSec_1DEnu_antinu");
+  // MINERvA CC1pi0 nu
+  Register<MINERvA_CC1pi0_XSec_1D_nu>("MINERvA_CC1pi0_XSec_1DTpi_nu");
+  Register<MINERvA_CC1pi0_XSec_1D_nu>("MINERvA_CC1pi0_XSec_1Dth_nu");
+  Register<MINERvA_CC1pi0_XSec_1D_nu>("MINERvA_CC1pi0_XSec_1Dpmu_nu");
+  Register<MINERvA_CC1pi0_XSec_1D_nu>("MINERvA_CC1pi0_XSec_1Dthmu_nu");
+  Register<MINERvA_CC1pi0_XSec_1D_nu>("MINERvA_CC1pi0_XSec_1DQ2_nu");
+  Register<MINERvA_CC1pi0_XSec_1D_nu>("MINERvA_CC1pi0_XSec_1DEnu_nu");
+  Register<MINERvA_CC1pi0_XSec_1D_nu>("MINERvA_CC1pi0_XSec_1DWexp_nu");
+  Register<MINERvA_CC1pi0_XSec_1D_nu>("MINERvA_CC1pi0_XSec_1DPPi0Mass_nu");
+  Register<MINERvA_CC1pi0_XSec_1D_nu>("MINERvA_CC1pi0_XSec_1DPPi0MassDelta_nu");
+  Register<MINERvA_CC1pi0_XSec_1D_nu>("MINERvA_CC1pi0_XSec_1DCosAdler_nu");
+  Register<MINERvA_CC1pi0_XSec_1D_nu>("MINERvA_CC1pi0_XSec_1DPhiAdler_nu");
+  // CCINC
+  Register<MINERvA_CCinc_XSec_2DEavq3_nu>("MINERvA_CCinc_XSec_2DEavq3_nu");
+  Register<MINERvA_CCinc_XSec_1Dx_ratio>("MINERvA_CCinc_XSec_1Dx_ratio_C12_CH");
+  Register<MINERvA_CCinc_XSec_1Dx_ratio>(
+      "MINERvA_CCinc_XSec_1Dx_ratio_Fe56_CH");
+  Register<MINERvA_CCinc_XSec_1Dx_ratio>(
+      "MINERvA_CCinc_XSec_1Dx_ratio_Pb208_CH");
+  Register<MINERvA_CCinc_XSec_1DEnu_ratio>(
+      "MINERvA_CCinc_XSec_1DEnu_ratio_C12_CH");
+  Register<MINERvA_CCinc_XSec_1DEnu_ratio>(
+      "MINERvA_CCinc_XSec_1DEnu_ratio_Fe56_CH");
+  Register<MINERvA_CCinc_XSec_1DEnu_ratio>(
+      "MINERvA_CCinc_XSec_1DEnu_ratio_Pb208_CH");
+  // CCDIS
+  Register<MINERvA_CCDIS_XSec_1Dx_ratio>("MINERvA_CCDIS_XSec_1Dx_ratio_C12_CH");
+  Register<MINERvA_CCDIS_XSec_1Dx_ratio>(
+      "MINERvA_CCDIS_XSec_1Dx_ratio_Fe56_CH");
+  Register<MINERvA_CCDIS_XSec_1Dx_ratio>(
+      "MINERvA_CCDIS_XSec_1Dx_ratio_Pb208_CH");
+  Register<MINERvA_CCDIS_XSec_1DEnu_ratio>(
+      "MINERvA_CCDIS_XSec_1DEnu_ratio_C12_CH");
+  Register<MINERvA_CCDIS_XSec_1DEnu_ratio>(
+      "MINERvA_CCDIS_XSec_1DEnu_ratio_Fe56_CH");
+  Register<MINERvA_CCDIS_XSec_1DEnu_ratio>(
+      "MINERvA_CCDIS_XSec_1DEnu_ratio_Pb208_CH");
+  // CC-COH
+  Register<MINERvA_CCCOHPI_XSec_1DEnu_nu>("MINERvA_CCCOHPI_XSec_1DEnu_nu");
+  Register<MINERvA_CCCOHPI_XSec_1DEpi_nu>("MINERvA_CCCOHPI_XSec_1DEpi_nu");
+  Register<MINERvA_CCCOHPI_XSec_1Dth_nu>("MINERvA_CCCOHPI_XSec_1Dth_nu");
+  Register<MINERvA_CCCOHPI_XSec_1DQ2_nu>("MINERvA_CCCOHPI_XSec_1DQ2_nu");
+  Register<MINERvA_CCCOHPI_XSec_1DEnu_antinu>(
+      "MINERvA_CCCOHPI_XSec_1DEnu_antinu");
+  Register<MINERvA_CCCOHPI_XSec_1DEpi_antinu>(
+      "MINERvA_CCCOHPI_XSec_1DEpi_antinu");
+  Register<MINERvA_CCCOHPI_XSec_1Dth_antinu>(
+      "MINERvA_CCCOHPI_XSec_1Dth_antinu");
+  Register<MINERvA_CCCOHPI_XSec_1DQ2_antinu>(
+      "MINERvA_CCCOHPI_XSec_1DQ2_antinu");
+  Register<MINERvA_CCCOHPI_XSec_joint>("MINERvA_CCCOHPI_XSec_1DEnu_joint");
+  Register<MINERvA_CCCOHPI_XSec_joint>("MINERvA_CCCOHPI_XSec_1DEpi_joint");
+  Register<MINERvA_CCCOHPI_XSec_joint>("MINERvA_CCCOHPI_XSec_1Dth_joint");
+  Register<MINERvA_CCCOHPI_XSec_joint>("MINERvA_CCCOHPI_XSec_1DQ2_joint");
 #endif
-#ifdef T2K_ENABLED
-      if (!name.compare("T2K_CC0pi_XSec_2DPcos_nu_I")) {
-    return (new T2K_CC0pi_XSec_2DPcos_nu_I(samplekey));
-
-  } else if (!name.compare("T2K_CC0pi_XSec_2DPcos_nu_II")) {
-    return (new T2K_CC0pi_XSec_2DPcos_nu_II(samplekey));
-
-  } else if (!name.compare("T2K_CCinc_XSec_2DPcos_nu_nonuniform")) {
-    return (new T2K_CCinc_XSec_2DPcos_nu_nonuniform(samplekey));
-
-  } else if (!name.compare("T2K_CC0pi_XSec_H2O_2DPcos_anu")) {
-    return (new T2K_CC0pi_XSec_H2O_2DPcos_anu(samplekey));
-
-  } else if (!name.compare("T2K_NuMu_CC0pi_O_XSec_2DPcos") ||
-             !name.compare("T2K_NuMu_CC0pi_C_XSec_2DPcos")) {
-    return (new T2K_NuMu_CC0pi_OC_XSec_2DPcos(samplekey));
-
-  } else if (!name.compare("T2K_NuMu_CC0pi_OC_XSec_2DPcos_joint")) {
-    return (new T2K_NuMu_CC0pi_OC_XSec_2DPcos_joint(samplekey));
-
-  } else if (!name.compare("T2K_NuMu_CC0pi_CH_XSec_2DPcos") ||
-             !name.compare("T2K_AntiNuMu_CC0pi_CH_XSec_2DPcos")) {
-    return (new T2K_NuMuAntiNuMu_CC0pi_CH_XSec_2DPcos(samplekey));
-
-  } else if (!name.compare("T2K_NuMuAntiNuMu_CC0pi_CH_XSec_2DPcos_joint")) {
-    return (new T2K_NuMuAntiNuMu_CC0pi_CH_XSec_2DPcos_joint(samplekey));
-
-  } else if (!name.compare("T2K_nueCCinc_XSec_1Dpe_FHC") ||
-             !name.compare("T2K_nueCCinc_XSec_1Dpe_RHC") ||
-             !name.compare("T2K_nuebarCCinc_XSec_1Dpe_RHC")) {
-    return (new T2K_nueCCinc_XSec_1Dpe(samplekey));
-
-  } else if (!name.compare("T2K_nueCCinc_XSec_1Dthe_FHC") ||
-	     !name.compare("T2K_nueCCinc_XSec_1Dthe_RHC") ||
-	     !name.compare("T2K_nuebarCCinc_XSec_1Dthe_RHC")) {
-    return (new T2K_nueCCinc_XSec_1Dthe(samplekey));
-
-  } else if (!name.compare("T2K_nueCCinc_XSec_1Dpe_joint")) {
-    return (new T2K_nueCCinc_XSec_1Dpe_joint(samplekey));
-  } else if (!name.compare("T2K_nueCCinc_XSec_1Dthe_joint")) {
-    return (new T2K_nueCCinc_XSec_1Dthe_joint(samplekey));
-  } else if (!name.compare("T2K_nueCCinc_XSec_joint")) {
-    return (new T2K_nueCCinc_XSec_joint(samplekey));
-
-    /*
-      T2K CC1pi+ CH samples
-    */
-    // Comment these out for now because we don't have the proper data
-
-  } else if (!name.compare("T2K_CC1pip_CH_XSec_2Dpmucosmu_nu")) {
-    return (new T2K_CC1pip_CH_XSec_2Dpmucosmu_nu(samplekey));
-
-  } else if (!name.compare("T2K_CC1pip_CH_XSec_1Dppi_nu")) {
-    return (new T2K_CC1pip_CH_XSec_1Dppi_nu(samplekey));
-
-  } else if (!name.compare("T2K_CC1pip_CH_XSec_1Dthpi_nu")) {
-    return (new T2K_CC1pip_CH_XSec_1Dthpi_nu(samplekey));
-
-  } else if (!name.compare("T2K_CC1pip_CH_XSec_1Dthmupi_nu")) {
-    return (new T2K_CC1pip_CH_XSec_1Dthmupi_nu(samplekey));
-
-  } else if (!name.compare("T2K_CC1pip_CH_XSec_1DQ2_nu")) {
-    return (new T2K_CC1pip_CH_XSec_1DQ2_nu(samplekey));
 
-  } else if (!name.compare("T2K_CC1pip_CH_XSec_1DAdlerPhi_nu")) {
-    return (new T2K_CC1pip_CH_XSec_1DAdlerPhi_nu(samplekey));
-
-  } else if (!name.compare("T2K_CC1pip_CH_XSec_1DCosThAdler_nu")) {
-    return (new T2K_CC1pip_CH_XSec_1DCosThAdler_nu(samplekey));
-
-  } else if (!name.compare("T2K_CCCOH_C12_XSec_1DEnu_nu")) {
-    return (new T2K_CCCOH_C12_XSec_1DEnu_nu(samplekey));
-
-    /*
-      T2K CC1pi+ H2O samples
-    */
-  } else if (!name.compare("T2K_CC1pip_H2O_XSec_1DEnuDelta_nu")) {
-    return (new T2K_CC1pip_H2O_XSec_1DEnuDelta_nu(samplekey));
-
-  } else if (!name.compare("T2K_CC1pip_H2O_XSec_1DEnuMB_nu")) {
-    return (new T2K_CC1pip_H2O_XSec_1DEnuMB_nu(samplekey));
+#ifdef T2K_ENABLED
+  // T2K Samples
+  Register<T2K_CC0pi_XSec_2DPcos_nu_I>("T2K_CC0pi_XSec_2DPcos_nu_I");
+  Register<T2K_CC0pi_XSec_2DPcos_nu_II>("T2K_CC0pi_XSec_2DPcos_nu_II");
+  Register<T2K_CCinc_XSec_2DPcos_nu_nonuniform>(
+      "T2K_CCinc_XSec_2DPcos_nu_nonuniform");
+  Register<T2K_CC0pi_XSec_H2O_2DPcos_anu>("T2K_CC0pi_XSec_H2O_2DPcos_anu");
+  Register<T2K_NuMu_CC0pi_OC_XSec_2DPcos>("T2K_NuMu_CC0pi_O_XSec_2DPcos");
+  Register<T2K_NuMu_CC0pi_OC_XSec_2DPcos>("T2K_NuMu_CC0pi_C_XSec_2DPcos");
+  Register<T2K_NuMu_CC0pi_OC_XSec_2DPcos_joint>(
+      "T2K_NuMu_CC0pi_OC_XSec_2DPcos_joint");
+  Register<T2K_NuMuAntiNuMu_CC0pi_CH_XSec_2DPcos>(
+      "T2K_NuMu_CC0pi_CH_XSec_2DPcos");
+  Register<T2K_NuMuAntiNuMu_CC0pi_CH_XSec_2DPcos>(
+      "T2K_AntiNuMu_CC0pi_CH_XSec_2DPcos");
+  Register<T2K_NuMuAntiNuMu_CC0pi_CH_XSec_2DPcos_joint>(
+      "T2K_NuMuAntiNuMu_CC0pi_CH_XSec_2DPcos_joint");
+  Register<T2K_nueCCinc_XSec_1Dpe>("T2K_nueCCinc_XSec_1Dpe_FHC");
+  Register<T2K_nueCCinc_XSec_1Dpe>("T2K_nueCCinc_XSec_1Dpe_RHC");
+  Register<T2K_nueCCinc_XSec_1Dpe>("T2K_nuebarCCinc_XSec_1Dpe_RHC");
+  Register<T2K_nueCCinc_XSec_1Dthe>("T2K_nueCCinc_XSec_1Dthe_FHC");
+  Register<T2K_nueCCinc_XSec_1Dthe>("T2K_nueCCinc_XSec_1Dthe_RHC");
+  Register<T2K_nueCCinc_XSec_1Dthe>("T2K_nuebarCCinc_XSec_1Dthe_RHC");
+  Register<T2K_nueCCinc_XSec_1Dpe_joint>("T2K_nueCCinc_XSec_1Dpe_joint");
+  Register<T2K_nueCCinc_XSec_1Dthe_joint>("T2K_nueCCinc_XSec_1Dthe_joint");
+  Register<T2K_nueCCinc_XSec_joint>("T2K_nueCCinc_XSec_joint");
+  // T2K CC1pi+ CH samples
+  // Comment these out for now because we don't have the proper data
+  Register<T2K_CC1pip_CH_XSec_2Dpmucosmu_nu>(
+      "T2K_CC1pip_CH_XSec_2Dpmucosmu_nu");
+  Register<T2K_CC1pip_CH_XSec_1Dppi_nu>("T2K_CC1pip_CH_XSec_1Dppi_nu");
+  Register<T2K_CC1pip_CH_XSec_1Dthpi_nu>("T2K_CC1pip_CH_XSec_1Dthpi_nu");
+  Register<T2K_CC1pip_CH_XSec_1Dthmupi_nu>("T2K_CC1pip_CH_XSec_1Dthmupi_nu");
+  Register<T2K_CC1pip_CH_XSec_1DQ2_nu>("T2K_CC1pip_CH_XSec_1DQ2_nu");
+  Register<T2K_CC1pip_CH_XSec_1DAdlerPhi_nu>(
+      "T2K_CC1pip_CH_XSec_1DAdlerPhi_nu");
+  Register<T2K_CC1pip_CH_XSec_1DCosThAdler_nu>(
+      "T2K_CC1pip_CH_XSec_1DCosThAdler_nu");
+  Register<T2K_CCCOH_C12_XSec_1DEnu_nu>("T2K_CCCOH_C12_XSec_1DEnu_nu");
+  // T2K CC1pi+ H2O samples
+  Register<T2K_CC1pip_H2O_XSec_1DEnuDelta_nu>(
+      "T2K_CC1pip_H2O_XSec_1DEnuDelta_nu");
+  Register<T2K_CC1pip_H2O_XSec_1DEnuMB_nu>("T2K_CC1pip_H2O_XSec_1DEnuMB_nu");
+  Register<T2K_CC1pip_H2O_XSec_1Dcosmu_nu>("T2K_CC1pip_H2O_XSec_1Dcosmu_nu");
+  Register<T2K_CC1pip_H2O_XSec_1Dcosmupi_nu>(
+      "T2K_CC1pip_H2O_XSec_1Dcosmupi_nu");
+  Register<T2K_CC1pip_H2O_XSec_1Dcospi_nu>("T2K_CC1pip_H2O_XSec_1Dcospi_nu");
+  Register<T2K_CC1pip_H2O_XSec_1Dpmu_nu>("T2K_CC1pip_H2O_XSec_1Dpmu_nu");
+  Register<T2K_CC1pip_H2O_XSec_1Dppi_nu>("T2K_CC1pip_H2O_XSec_1Dppi_nu");
+  // T2K CC0pi + np CH samples
+  Register<T2K_CC0pinp_STV_XSec_1Ddpt_nu>("T2K_CC0pinp_STV_XSec_1Ddpt_nu");
+  Register<T2K_CC0pinp_STV_XSec_1Ddphit_nu>("T2K_CC0pinp_STV_XSec_1Ddphit_nu");
+  Register<T2K_CC0pinp_STV_XSec_1Ddat_nu>("T2K_CC0pinp_STV_XSec_1Ddat_nu");
+  Register<T2K_CC0piWithProtons_XSec_2018_multidif_0p_1p_Np>(
+      "T2K_CC0piWithProtons_XSec_2018_multidif_0p_1p_Np");
+  Register<T2K_CC0piWithProtons_XSec_2018_multidif_0p_1p_Np>(
+      "T2K_CC0piWithProtons_XSec_2018_multidif_0p_1p");
+  Register<T2K_CC0piWithProtons_XSec_2018_multidif_0p_1p_Np>(
+      "T2K_CC0piWithProtons_XSec_2018_multidif_0p");
+  Register<T2K_CC0piWithProtons_XSec_2018_multidif_0p_1p_Np>(
+      "T2K_CC0piWithProtons_XSec_2018_multidif_1p");
+  Register<T2K_CC0pinp_ifk_XSec_3Dinfp_nu>("T2K_CC0pinp_ifk_XSec_3Dinfp_nu");
+  Register<T2K_CC0pinp_ifk_XSec_3Dinfa_nu>("T2K_CC0pinp_ifk_XSec_3Dinfa_nu");
+  Register<T2K_CC0pinp_ifk_XSec_3Dinfip_nu>("T2K_CC0pinp_ifk_XSec_3Dinfip_nu");
+#endif
 
-  } else if (!name.compare("T2K_CC1pip_H2O_XSec_1Dcosmu_nu")) {
-    return (new T2K_CC1pip_H2O_XSec_1Dcosmu_nu(samplekey));
+#ifdef SciBooNE_ENABLED
+  // SciBooNE COH studies
+  Register<SciBooNE_CCCOH_STOP_NTrks_nu>("SciBooNE_CCCOH_STOP_NTrks_nu");
+  Register<SciBooNE_CCCOH_1TRK_1DQ2_nu>("SciBooNE_CCCOH_1TRK_1DQ2_nu");
+  Register<SciBooNE_CCCOH_1TRK_1Dpmu_nu>("SciBooNE_CCCOH_1TRK_1Dpmu_nu");
+  Register<SciBooNE_CCCOH_1TRK_1Dthetamu_nu>(
+      "SciBooNE_CCCOH_1TRK_1Dthetamu_nu");
+  Register<SciBooNE_CCCOH_MuPr_1DQ2_nu>("SciBooNE_CCCOH_MuPr_1DQ2_nu");
+  Register<SciBooNE_CCCOH_MuPr_1Dpmu_nu>("SciBooNE_CCCOH_MuPr_1Dpmu_nu");
+  Register<SciBooNE_CCCOH_MuPr_1Dthetamu_nu>(
+      "SciBooNE_CCCOH_MuPr_1Dthetamu_nu");
+  Register<SciBooNE_CCCOH_MuPiVA_1DQ2_nu>("SciBooNE_CCCOH_MuPiVA_1DQ2_nu");
+  Register<SciBooNE_CCCOH_MuPiVA_1Dpmu_nu>("SciBooNE_CCCOH_MuPiVA_1Dpmu_nu");
+  Register<SciBooNE_CCCOH_MuPiVA_1Dthetamu_nu>(
+      "SciBooNE_CCCOH_MuPiVA_1Dthetamu_nu");
+  Register<SciBooNE_CCCOH_MuPiNoVA_1DQ2_nu>("SciBooNE_CCCOH_MuPiNoVA_1DQ2_nu");
+  Register<SciBooNE_CCCOH_MuPiNoVA_1Dthetapr_nu>(
+      "SciBooNE_CCCOH_MuPiNoVA_1Dthetapr_nu");
+  Register<SciBooNE_CCCOH_MuPiNoVA_1Dthetapi_nu>(
+      "SciBooNE_CCCOH_MuPiNoVA_1Dthetapi_nu");
+  Register<SciBooNE_CCCOH_MuPiNoVA_1Dthetamu_nu>(
+      "SciBooNE_CCCOH_MuPiNoVA_1Dthetamu_nu");
+  Register<SciBooNE_CCCOH_MuPiNoVA_1Dpmu_nu>(
+      "SciBooNE_CCCOH_MuPiNoVA_1Dpmu_nu");
+  Register<SciBooNE_CCCOH_STOPFINAL_1DQ2_nu>(
+      "SciBooNE_CCCOH_STOPFINAL_1DQ2_nu");
+  Register<SciBooNE_CCInc_XSec_1DEnu_nu>("SciBooNE_CCInc_XSec_1DEnu_nu");
+  Register<SciBooNE_CCInc_XSec_1DEnu_nu>("SciBooNE_CCInc_XSec_1DEnu_nu_NEUT");
+  Register<SciBooNE_CCInc_XSec_1DEnu_nu>("SciBooNE_CCInc_XSec_1DEnu_nu_NUANCE");
+#endif
 
-  } else if (!name.compare("T2K_CC1pip_H2O_XSec_1Dcosmupi_nu")) {
-    return (new T2K_CC1pip_H2O_XSec_1Dcosmupi_nu(samplekey));
+#ifdef K2K_ENABLED
+  // K2K Samples
+  // NC1pi0
+  Register<K2K_NC1pi0_Evt_1Dppi0_nu>("K2K_NC1pi0_Evt_1Dppi0_nu");
+#endif
 
-  } else if (!name.compare("T2K_CC1pip_H2O_XSec_1Dcospi_nu")) {
-    return (new T2K_CC1pip_H2O_XSec_1Dcospi_nu(samplekey));
+  // Fake data and MC studies constructed from their key
+  Register<T2K2017_FakeData>("T2K2017_FakeData");
+  Register<OfficialNIWGPlots>("NIWGOfficialPlots");
+#ifdef Prob3plusplus_ENABLED
+  Register<Simple_Osc>("Simple_Osc");
+  Register<Smear_SVDUnfold_Propagation_Osc>("Smear_SVDUnfold_Propagation_Osc");
+#endif
 
-  } else if (!name.compare("T2K_CC1pip_H2O_XSec_1Dpmu_nu")) {
-    return (new T2K_CC1pip_H2O_XSec_1Dpmu_nu(samplekey));
+  return gSampleRegistry;
+}
+} // namespace
 
-  } else if (!name.compare("T2K_CC1pip_H2O_XSec_1Dppi_nu")) {
-    return (new T2K_CC1pip_H2O_XSec_1Dppi_nu(samplekey));
+namespace SampleUtils {
 
-    /*
-      T2K CC0pi + np CH samples
-    */
-  } else if (!name.compare("T2K_CC0pinp_STV_XSec_1Ddpt_nu")) {
-    return (new T2K_CC0pinp_STV_XSec_1Ddpt_nu(samplekey));
+//! Create a given sample given its name, file, type, fakdata(fkdt) file and the
+//! current rw engine and push it back into the list fChain.
+MeasurementBase *CreateSample(std::string name, std::string file,
+                              std::string type, std::string fkdt,
+                              FitWeight *rw) {
+  nuiskey samplekey = Config::CreateKey("sample");
+  samplekey.Set("name", name);
+  samplekey.Set("input", file);
+  samplekey.Set("type", type);
 
-  } else if (!name.compare("T2K_CC0pinp_STV_XSec_1Ddphit_nu")) {
-    return (new T2K_CC0pinp_STV_XSec_1Ddphit_nu(samplekey));
+  return CreateSample(samplekey);
+}
 
-  } else if (!name.compare("T2K_CC0pinp_STV_XSec_1Ddat_nu")) {
-    return (new T2K_CC0pinp_STV_XSec_1Ddat_nu(samplekey));
+MeasurementBase *CreateSample(nuiskey samplekey) {
+  // Samples copy what they need out of the data release files, which are
+  // closed here unless the caller is loading several samples
+  GeneralUtils::CachedFileScope filescope;
 
-  } else if (!name.compare("T2K_CC0piWithProtons_XSec_2018_multidif_0p_1p_Np") || !name.compare("T2K_CC0piWithProtons_XSec_2018_multidif_0p_1p") || !name.compare("T2K_CC0piWithProtons_XSec_2018_multidif_0p") || !name.compare("T2K_CC0piWithProtons_XSec_2018_multidif_1p")) {
-    return (new T2K_CC0piWithProtons_XSec_2018_multidif_0p_1p_Np(samplekey));
+  if (DynamicSampleFactory::Get().HasSample(samplekey)) {
+    NUIS_LOG(SAM, "Instantiating dynamic sample...");
 
-  } else if (!name.compare("T2K_CC0pinp_ifk_XSec_3Dinfp_nu")) {
-    return (new T2K_CC0pinp_ifk_XSec_3Dinfp_nu(samplekey));
+    MeasurementBase *ds = DynamicSampleFactory::Get().CreateSample(samplekey);
+    if (ds) {
+      NUIS_LOG(SAM, "Done.");
+      return ds;
+    }
+    NUIS_ABORT("Failed to instantiate dynamic sample.");
+  }
 
-  } else if (!name.compare("T2K_CC0pinp_ifk_XSec_3Dinfa_nu")) {
-    return (new T2K_CC0pinp_ifk_XSec_3Dinfa_nu(samplekey));
+  std::string name = samplekey.GetS("name");
 
-  } else if (!name.compare("T2K_CC0pinp_ifk_XSec_3Dinfip_nu")) {
-    return (new T2K_CC0pinp_ifk_XSec_3Dinfip_nu(samplekey));
+  SampleRegistry::const_iterator creator = GetSampleRegistry().find(name);
+  if (creator != GetSampleRegistry().end()) {
+    return creator->second(samplekey);
+  }
 
-    // SciBooNE COH studies
-  } else
-#endif
-#ifdef SciBooNE_ENABLED
-      if (!name.compare("SciBooNE_CCCOH_STOP_NTrks_nu")) {
-    return (new SciBooNE_CCCOH_STOP_NTrks_nu(samplekey));
-
-  } else if (!name.compare("SciBooNE_CCCOH_1TRK_1DQ2_nu")) {
-    return (new SciBooNE_CCCOH_1TRK_1DQ2_nu(samplekey));
-  } else if (!name.compare("SciBooNE_CCCOH_1TRK_1Dpmu_nu")) {
-    return (new SciBooNE_CCCOH_1TRK_1Dpmu_nu(samplekey));
-  } else if (!name.compare("SciBooNE_CCCOH_1TRK_1Dthetamu_nu")) {
-    return (new SciBooNE_CCCOH_1TRK_1Dthetamu_nu(samplekey));
-
-  } else if (!name.compare("SciBooNE_CCCOH_MuPr_1DQ2_nu")) {
-    return (new SciBooNE_CCCOH_MuPr_1DQ2_nu(samplekey));
-  } else if (!name.compare("SciBooNE_CCCOH_MuPr_1Dpmu_nu")) {
-    return (new SciBooNE_CCCOH_MuPr_1Dpmu_nu(samplekey));
-  } else if (!name.compare("SciBooNE_CCCOH_MuPr_1Dthetamu_nu")) {
-    return (new SciBooNE_CCCOH_MuPr_1Dthetamu_nu(samplekey));
-
-  } else if (!name.compare("SciBooNE_CCCOH_MuPiVA_1DQ2_nu")) {
-    return (new SciBooNE_CCCOH_MuPiVA_1DQ2_nu(samplekey));
-  } else if (!name.compare("SciBooNE_CCCOH_MuPiVA_1Dpmu_nu")) {
-    return (new SciBooNE_CCCOH_MuPiVA_1Dpmu_nu(samplekey));
-  } else if (!name.compare("SciBooNE_CCCOH_MuPiVA_1Dthetamu_nu")) {
-    return (new SciBooNE_CCCOH_MuPiVA_1Dthetamu_nu(samplekey));
-
-  } else if (!name.compare("SciBooNE_CCCOH_MuPiNoVA_1DQ2_nu")) {
-    return (new SciBooNE_CCCOH_MuPiNoVA_1DQ2_nu(samplekey));
-  } else if (!name.compare("SciBooNE_CCCOH_MuPiNoVA_1Dthetapr_nu")) {
-    return (new SciBooNE_CCCOH_MuPiNoVA_1Dthetapr_nu(samplekey));
-  } else if (!name.compare("SciBooNE_CCCOH_MuPiNoVA_1Dthetapi_nu")) {
-    return (new SciBooNE_CCCOH_MuPiNoVA_1Dthetapi_nu(samplekey));
-  } else if (!name.compare("SciBooNE_CCCOH_MuPiNoVA_1Dthetamu_nu")) {
-    return (new SciBooNE_CCCOH_MuPiNoVA_1Dthetamu_nu(samplekey));
-  } else if (!name.compare("SciBooNE_CCCOH_MuPiNoVA_1Dpmu_nu")) {
-    return (new SciBooNE_CCCOH_MuPiNoVA_1Dpmu_nu(samplekey));
-
-  } else if (!name.compare("SciBooNE_CCCOH_STOPFINAL_1DQ2_nu")) {
-    return (new SciBooNE_CCCOH_STOPFINAL_1DQ2_nu(samplekey));
-  } else if (!name.compare("SciBooNE_CCInc_XSec_1DEnu_nu") ||
-             !name.compare("SciBooNE_CCInc_XSec_1DEnu_nu_NEUT") ||
-             !name.compare("SciBooNE_CCInc_XSec_1DEnu_nu_NUANCE")) {
-    return (new SciBooNE_CCInc_XSec_1DEnu_nu(samplekey));
-
-    /*
-    K2K Samples
-    */
-    /*
-      NC1pi0
-    */
-  } else
-#endif
-#ifdef K2K_ENABLED
-      if (!name.compare("K2K_NC1pi0_Evt_1Dppi0_nu")) {
-    return (new K2K_NC1pi0_Evt_1Dppi0_nu(samplekey));
+  FitWeight *rw = FitBase::GetRW();
+  std::string file = samplekey.GetS("input");
+  std::string type = samplekey.GetS("type");
+  std::string fkdt = "";
 
-    /*
+  /*
     Fake Studies
-    */
-  } else
-#endif
-      if (name.find("ExpMultDist_CCQE_XSec_1D") != std::string::npos &&
-          name.find("_FakeStudy") != std::string::npos) {
+  */
+  if (name.find("ExpMultDist_CCQE_XSec_1D") != std::string::npos &&
+      name.find("_FakeStudy") != std::string::npos) {
     return (
         new ExpMultDist_CCQE_XSec_1DVar_FakeStudy(name, file, rw, type, fkdt));
   } else if (name.find("ExpMultDist_CCQE_XSec_2D") != std::string::npos &&
@@ -1553,34 +1294,24 @@ MeasurementBase *CreateSample(nuiskey samplekey) {
     return (new GenericFlux_Tester(name, file, rw, type, fkdt));
   } else if (name.find("GenericVectors") != std::string::npos) {
     return (new GenericFlux_Vectors(name, file, rw, type, fkdt));
-  } else if (!name.compare("T2K2017_FakeData")) {
-    return (new T2K2017_FakeData(samplekey));
   } else if (!name.compare("MCStudy_CCQE")) {
     return (new MCStudy_CCQEHistograms(name, file, rw, type, fkdt));
   } else if (!name.compare("ElectronFlux_FlatTree")) {
     return (new ElectronFlux_FlatTree(name, file, rw, type, fkdt));
   } 
 #ifdef Electron_ENABLED
-  else if (name.find("ElectronData_") != std::string::npos) {
+  else if (name.find("ElectronDataGroup_") != std::string::npos) {
+    return new ElectronScattering_DurhamDataGroup(samplekey);
+  } else if (name.find("ElectronData_") != std::string::npos) {
     return new ElectronScattering_DurhamData(samplekey);
   } 
 #endif
   else if (name.find("MuonValidation_") != std::string::npos) {
     return (new MCStudy_MuonValidation(name, file, rw, type, fkdt));
-  } else if (!name.compare("NIWGOfficialPlots")) {
-    return (new OfficialNIWGPlots(samplekey));
   } else if ((name.find("SigmaEnuHists") != std::string::npos) ||
              (name.find("SigmaEnuPerEHists") != std::string::npos)) {
     return (new SigmaEnuHists(samplekey));
-  } 
-#ifdef Prob3plusplus_ENABLED
-  else if (!name.compare("Simple_Osc")) {
-    return (new Simple_Osc(samplekey));
-  } else if (!name.compare("Smear_SVDUnfold_Propagation_Osc")) {
-    return (new Smear_SVDUnfold_Propagation_Osc(samplekey));
-  } 
-#endif
-  else {
+  } else {
     NUIS_ABORT("Error: No such sample: " << name << std::endl);
   }
 
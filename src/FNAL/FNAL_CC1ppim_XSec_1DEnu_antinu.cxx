@@ -32,6 +32,7 @@ FNAL_CC1ppim_XSec_1DEnu_antinu::FNAL_CC1ppim_XSec_1DEnu_antinu(nuiskey samplekey
   fScaleFactor =  GetEventHistogram()->Integral("width")*double(1E-38)/double(fNEvents)*(2./1.);
 
   // Plot Setup -------------------------------------------------------
+  fDeferLoading = true;
   SetDataFromTextFile( fSettings.GetDataInput() );
   SetCovarFromDiagonal();
 
@@ -22,6 +22,7 @@ public:
           box->fQ2 = this->fQ2;
           return box;
         };
+	inline size_t GetMemorySize(){ return sizeof(*this); };
 	double fQ2;
 };
 
@@ -92,8 +92,6 @@ InputHandlerBase* EventManager::AddInput(std::string handle, std::string infile)
 
   fid[file_descriptor[1]] = id;
   finputs[id] = InputUtils::CreateInputHandler(handle, inpType, file_descriptor[1]);
-  frwneeded[id] = std::vector<bool>(finputs[id]->GetNEvents(), true);
-  calc_rw[id] = std::vector<double>(finputs[id]->GetNEvents(), 0.0);
   
   NUIS_LOG(SAM,"Registered " << handle << " with EventManager.");
 
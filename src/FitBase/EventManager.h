@@ -50,8 +50,6 @@ class EventManager {
   FitWeight* fRW;
   std::map< std::string, int > fid;
   std::map< int, InputHandlerBase* > finputs;
-  std::map< int, std::vector< bool > > frwneeded;
-  std::map< int, std::vector< double > > calc_rw;
 
 };
 
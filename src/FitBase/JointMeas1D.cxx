@@ -18,6 +18,8 @@
  *******************************************************************************/
 #include "JointMeas1D.h"
 
+#include <algorithm>
+
 //********************************************************************
 JointMeas1D::JointMeas1D(void) {
   //********************************************************************
@@ -26,6 +28,9 @@ JointMeas1D::JointMeas1D(void) {
   fScaleFactor = -1.0;
   fCurrentNorm = 1.0;
 
+  // Read once here so GetLikelihood does not touch the global config
+  fSaveShapeScaling = FitPar::Config().GetParB("saveshapescaling");
+
   // Histograms
   fDataHist = NULL;
   fDataTrue = NULL;
@@ -157,6 +162,7 @@ JointMeas1D::~JointMeas1D(void) {
     delete fInvert;
   if (fDecomp)
     delete fDecomp;
+  StatUtils::ClearThrowCache(fThrowCache);
 
   for (std::vector<MeasurementBase *>::const_iterator iter = fSubChain.begin();
        iter != fSubChain.end(); iter++) {
@@ -660,6 +666,9 @@ void JointMeas1D::FinaliseMeasurement() {
     fDecomp = StatUtils::GetDecomp(fFullCovar);
   }
 
+  // Drop any covariance caches built before finalising
+  fCovarVersion++;
+
   // Push the diagonals of fFullCovar onto the data histogram
   // Comment out until scaling is used consistently...
   StatUtils::SetDataErrorFromCov(fDataHist, fFullCovar, 1E-38);
@@ -1087,7 +1096,7 @@ double JointMeas1D::GetLikelihood() {
   }
 
   // Return to normal scaling
-  if (fIsShape and !FitPar::Config().GetParB("saveshapescaling")) {
+  if (fIsShape and !fSaveShapeScaling) {
     fMCHist->Scale(1. / scaleF);
     fMCFine->Scale(1. / scaleF);
   }
@@ -1167,6 +1176,7 @@ void JointMeas1D::SetFakeDataValues(std::string fakeOption) {
   if (fDecomp)
     delete fDecomp;
   fDecomp = StatUtils::GetDecomp(fFullCovar);
+  fCovarVersion++;
 
   delete tempdata;
 
@@ -1208,7 +1218,8 @@ void JointMeas1D::ThrowCovariance() {
 
   if (fDataHist)
     delete fDataHist;
-  fDataHist = StatUtils::ThrowHistogram(fDataTrue, fFullCovar);
+  fDataHist = StatUtils::ThrowHistogramFromDecomp(
+      fDataTrue, GetThrowDecomp(), fIsMask ? fMaskHist : NULL);
 
   return;
 };
@@ -1220,7 +1231,51 @@ void JointMeas1D::ThrowDataToy() {
     fDataTrue = (TH1D *)fDataHist->Clone();
   if (fMCHist)
     delete fMCHist;
-  fMCHist = StatUtils::ThrowHistogram(fDataTrue, fFullCovar);
+  fMCHist = StatUtils::ThrowHistogramFromDecomp(fDataTrue, GetThrowDecomp(),
+                                                fIsMask ? fMaskHist : NULL);
+}
+
+//********************************************************************
+std::vector<TH1D *> JointMeas1D::ThrowDataToys(int ntoys) {
+  //********************************************************************
+  if (!fDataTrue)
+    fDataTrue = (TH1D *)fDataHist->Clone();
+  return StatUtils::ThrowHistogramsFromDecomp(
+      fDataTrue, GetThrowDecomp(), ntoys, fIsMask ? fMaskHist : NULL);
+}
+
+//********************************************************************
+std::vector<double> JointMeas1D::GetDataToyLikelihoods(int ntoys) {
+  //********************************************************************
+
+  // Batches bound how many toy histograms are held at once
+  const int batchsize = 1000;
+
+  std::vector<double> likes;
+  while (int(likes.size()) < ntoys) {
+    int nbatch = std::min(batchsize, ntoys - int(likes.size()));
+    std::vector<TH1D *> toys = ThrowDataToys(nbatch);
+    for (size_t i = 0; i < toys.size(); i++) {
+      if (fMCHist)
+        delete fMCHist;
+      fMCHist = toys[i];
+      likes.push_back(GetLikelihood());
+    }
+  }
+
+  return likes;
+}
+
+//********************************************************************
+TMatrixDSym *JointMeas1D::GetThrowDecomp() {
+  //********************************************************************
+
+  if (!fFullCovar) {
+    NUIS_ABORT("No covariance set for " << fName << ", cannot throw toys");
+  }
+
+  return StatUtils::GetThrowDecomp(fThrowCache, fFullCovar, fCovarVersion,
+                                   fIsMask ? fMaskHist : NULL);
 }
 
 /*
@@ -1978,7 +2033,7 @@ void JointMeas1D::SetCovarMatrix(std::string covarFile) {
 
   // Covariance function, only really used when reading in the MB Covariances.
 
-  TFile *tempFile = new TFile(covarFile.c_str(), "READ");
+  TFile *tempFile = GeneralUtils::GetCachedFile(covarFile);
 
   TH2D *covarPlot = new TH2D();
   TH2D *fFullCovarPlot = new TH2D();
@@ -2169,7 +2224,7 @@ void JointMeas1D::SetCovarFromDataFile(std::string covarFile,
 
   NUIS_LOG(SAM, "Getting covariance from " << covarFile << "->" << covName);
 
-  TFile *tempFile = new TFile(covarFile.c_str(), "READ");
+  TFile *tempFile = GeneralUtils::GetCachedFile(covarFile);
   TH2D *covPlot = (TH2D *)tempFile->Get(covName.c_str());
   covPlot->SetDirectory(0);
   // Scale the covariance matrix if it comes in normal units
@@ -409,6 +409,23 @@ public:
   /// so that the likelihood is calculated between data and thrown data
   virtual void ThrowDataToy(void);
 
+  /// \brief Throw ntoys correlated data toys from the true data in one batch
+  ///
+  /// Uses the cached throw decomposition. Caller owns the returned histograms.
+  virtual std::vector<TH1D *> ThrowDataToys(int ntoys);
+
+  /// \brief Likelihoods of ntoys data toys scored in place of the MC
+  ///
+  /// Throws in batches through ThrowDataToys so the decomposition and
+  /// random draws are shared. The last toy is left in fMCHist.
+  virtual std::vector<double> GetDataToyLikelihoods(int ntoys);
+
+  /// \brief Decomposition of the masked covariance used for throws
+  ///
+  /// Cached between calls and only recomputed when fFullCovar, its
+  /// fCovarVersion or the bin mask changes.
+  TMatrixDSym *GetThrowDecomp(void);
+
   /*
     Access Functions
   */
@@ -591,6 +608,7 @@ protected:
   TMatrixDSym *covar;       ///< Inverted Covariance
   TMatrixDSym *fFullCovar;  ///< Full Covariance
   TMatrixDSym *fDecomp;     ///< Decomposed Covariance
+  StatUtils::ThrowCache fThrowCache; ///< Cached masked decomposition for throws
   TMatrixDSym *fCorrel;     ///< Correlation Matrix
   TMatrixDSym *fShapeCovar; ///< Shape-only covariance
 
@@ -613,6 +631,7 @@ protected:
   bool fIsFree;      ///< Flag : Perform normalisation free fit
   bool fIsDiag;      ///< Flag : only include uncorrelated diagonal errors
   bool fIsMask;      ///< Flag : Apply bin masking
+  bool fSaveShapeScaling; ///< Flag : Keep shape scaling after the likelihood
   bool fIsRawEvents; ///< Flag : Are bin contents just event rates
   bool fIsEnu1D;     ///< Flag : Perform Flux Unfolded Scaling
   bool fIsChi2SVD;   ///< Flag : Use alternative Chi2 SVD Method (Do not use)
@@ -18,6 +18,8 @@
  *******************************************************************************/
 #include "Measurement1D.h"
 
+#include <algorithm>
+
 //********************************************************************
 Measurement1D::Measurement1D(void) {
   //********************************************************************
@@ -110,6 +112,7 @@ Measurement1D::~Measurement1D(void) {
     delete fInvert;
   if (fDecomp)
     delete fDecomp;
+  StatUtils::ClearThrowCache(fThrowCache);
 
   delete fResidualHist;
   delete fChi2LessBinHist;
@@ -171,6 +174,8 @@ void Measurement1D::FinaliseSampleSettings() {
 void Measurement1D::CreateDataHistogram(int dimx, double *binx) {
   //********************************************************************
 
+  LoadData();
+
   if (fDataHist)
     delete fDataHist;
 
@@ -182,6 +187,9 @@ void Measurement1D::CreateDataHistogram(int dimx, double *binx) {
 void Measurement1D::SetDataFromTextFile(std::string datafile) {
   //********************************************************************
 
+  if (DeferLoad(kLoadDataText, datafile))
+    return;
+
   NUIS_LOG(SAM, "Reading data from text file: " << datafile);
   fDataHist = PlotUtils::GetTH1DFromFile(
       datafile, fSettings.GetName() + "_data", fSettings.GetFullTitles());
@@ -192,6 +200,9 @@ void Measurement1D::SetDataFromRootFile(std::string datafile,
                                         std::string histname) {
   //********************************************************************
 
+  if (DeferLoad(kLoadDataRoot, datafile, histname))
+    return;
+
   NUIS_LOG(SAM, "Reading data from root file: " << datafile << ";" << histname);
   fDataHist = PlotUtils::GetTH1DFromRootFile(datafile, histname);
   fDataHist->SetNameTitle((fSettings.GetName() + "_data").c_str(),
@@ -204,6 +215,8 @@ void Measurement1D::SetDataFromRootFile(std::string datafile,
 void Measurement1D::SetEmptyData() {
   //********************************************************************
 
+  LoadData();
+
   fDataHist = new TH1D("EMPTY_DATA", "EMPTY_DATA", 1, 0.0, 1.0);
 }
 
@@ -211,6 +224,9 @@ void Measurement1D::SetEmptyData() {
 void Measurement1D::SetPoissonErrors() {
   //********************************************************************
 
+  if (DeferLoad(kLoadPoissonErrors))
+    return;
+
   if (!fDataHist) {
     NUIS_ERR(FTL, "Need a data hist to setup possion errors! ");
     NUIS_ERR(FTL, "Setup Data First!");
@@ -226,6 +242,10 @@ void Measurement1D::SetPoissonErrors() {
 void Measurement1D::SetCovarFromDiagonal(TH1D *data) {
   //********************************************************************
 
+  if (!data && DeferLoad(kLoadDiagonalCovar))
+    return;
+  LoadData();
+
   if (!data and fDataHist) {
     data = fDataHist;
   }
@@ -233,8 +253,7 @@ void Measurement1D::SetCovarFromDiagonal(TH1D *data) {
   if (data) {
     NUIS_LOG(SAM, "Setting diagonal covariance for: " << data->GetName());
     fFullCovar = StatUtils::MakeDiagonalCovarMatrix(data);
-    covar = StatUtils::GetInvert(fFullCovar, true);
-    fDecomp = StatUtils::GetDecomp(fFullCovar);
+    InvertFullCovar();
   } else {
     NUIS_ABORT("No data input provided to set diagonal covar from!");
   }
@@ -244,14 +263,16 @@ void Measurement1D::SetCovarFromDiagonal(TH1D *data) {
 void Measurement1D::SetCovarFromTextFile(std::string covfile, int dim) {
   //********************************************************************
 
+  if (DeferLoad(kLoadCovarText, covfile, "", dim))
+    return;
+
   if (dim == -1) {
     dim = fDataHist->GetNbinsX();
   }
 
   NUIS_LOG(SAM, "Reading covariance from text file: " << covfile);
   fFullCovar = StatUtils::GetCovarFromTextFile(covfile, dim);
-  covar = StatUtils::GetInvert(fFullCovar, true);
-  fDecomp = StatUtils::GetDecomp(fFullCovar);
+  InvertFullCovar();
 }
 
 //********************************************************************
@@ -259,6 +280,9 @@ void Measurement1D::SetCovarFromMultipleTextFiles(std::string covfiles,
                                                   int dim) {
   //********************************************************************
 
+  if (DeferLoad(kLoadCovarMultiText, covfiles, "", dim))
+    return;
+
   if (dim == -1) {
     dim = fDataHist->GetNbinsX();
   }
@@ -272,8 +296,7 @@ void Measurement1D::SetCovarFromMultipleTextFiles(std::string covfiles,
     (*fFullCovar) += (*temp_cov);
     delete temp_cov;
   }
-  covar = StatUtils::GetInvert(fFullCovar, true);
-  fDecomp = StatUtils::GetDecomp(fFullCovar);
+  InvertFullCovar();
 }
 
 //********************************************************************
@@ -281,17 +304,22 @@ void Measurement1D::SetCovarFromRootFile(std::string covfile,
                                          std::string histname) {
   //********************************************************************
 
+  if (DeferLoad(kLoadCovarRoot, covfile, histname))
+    return;
+
   NUIS_LOG(SAM,
            "Reading covariance from root file: " << covfile << ";" << histname);
   fFullCovar = StatUtils::GetCovarFromRootFile(covfile, histname);
-  covar = StatUtils::GetInvert(fFullCovar, true);
-  fDecomp = StatUtils::GetDecomp(fFullCovar);
+  InvertFullCovar();
 }
 
 //********************************************************************
 void Measurement1D::SetCovarInvertFromTextFile(std::string covfile, int dim) {
   //********************************************************************
 
+  if (DeferLoad(kLoadCovarInvertText, covfile, "", dim))
+    return;
+
   if (dim == -1) {
     dim = fDataHist->GetNbinsX();
   }
@@ -307,6 +335,9 @@ void Measurement1D::SetCovarInvertFromRootFile(std::string covfile,
                                                std::string histname) {
   //********************************************************************
 
+  if (DeferLoad(kLoadCovarInvertRoot, covfile, histname))
+    return;
+
   NUIS_LOG(SAM, "Reading inverted covariance from text file: " << covfile << ";"
                                                                << histname);
   covar = StatUtils::GetCovarFromRootFile(covfile, histname);
@@ -318,6 +349,9 @@ void Measurement1D::SetCovarInvertFromRootFile(std::string covfile,
 void Measurement1D::SetCorrelationFromTextFile(std::string covfile, int dim) {
   //********************************************************************
 
+  if (DeferLoad(kLoadCorrText, covfile, "", dim))
+    return;
+
   if (dim == -1)
     dim = fDataHist->GetNbinsX();
   NUIS_LOG(SAM, "Reading data correlations from text file: " << covfile << ";"
@@ -342,8 +376,7 @@ void Measurement1D::SetCorrelationFromTextFile(std::string covfile, int dim) {
   }
 
   // Fill other covars.
-  covar = StatUtils::GetInvert(fFullCovar, true);
-  fDecomp = StatUtils::GetDecomp(fFullCovar);
+  InvertFullCovar();
 
   delete correlation;
 }
@@ -353,6 +386,9 @@ void Measurement1D::SetCorrelationFromMultipleTextFiles(std::string corrfiles,
                                                         int dim) {
   //********************************************************************
 
+  if (DeferLoad(kLoadCorrMultiText, corrfiles, "", dim))
+    return;
+
   if (dim == -1) {
     dim = fDataHist->GetNbinsX();
   }
@@ -374,8 +410,7 @@ void Measurement1D::SetCorrelationFromMultipleTextFiles(std::string corrfiles,
     (*fFullCovar) += (*temp_cov);
     delete temp_cov;
   }
-  covar = StatUtils::GetInvert(fFullCovar, true);
-  fDecomp = StatUtils::GetDecomp(fFullCovar);
+  InvertFullCovar();
 }
 
 //********************************************************************
@@ -383,6 +418,9 @@ void Measurement1D::SetCorrelationFromRootFile(std::string covfile,
                                                std::string histname) {
   //********************************************************************
 
+  if (DeferLoad(kLoadCorrRoot, covfile, histname))
+    return;
+
   NUIS_LOG(SAM, "Reading data correlations from text file: " << covfile << ";"
                                                              << histname);
   TMatrixDSym *correlation = StatUtils::GetCovarFromRootFile(covfile, histname);
@@ -405,8 +443,7 @@ void Measurement1D::SetCorrelationFromRootFile(std::string covfile,
   }
 
   // Fill other covars.
-  covar = StatUtils::GetInvert(fFullCovar, true);
-  fDecomp = StatUtils::GetDecomp(fFullCovar);
+  InvertFullCovar();
 
   delete correlation;
 }
@@ -415,6 +452,9 @@ void Measurement1D::SetCorrelationFromRootFile(std::string covfile,
 void Measurement1D::SetCholDecompFromTextFile(std::string covfile, int dim) {
   //********************************************************************
 
+  if (DeferLoad(kLoadCholText, covfile, "", dim))
+    return;
+
   if (dim == -1) {
     dim = fDataHist->GetNbinsX();
   }
@@ -427,8 +467,7 @@ void Measurement1D::SetCholDecompFromTextFile(std::string covfile, int dim) {
   (*trans) *= (*temp);
 
   fFullCovar = new TMatrixDSym(dim, trans->GetMatrixArray(), "");
-  covar = StatUtils::GetInvert(fFullCovar, true);
-  fDecomp = StatUtils::GetDecomp(fFullCovar);
+  InvertFullCovar();
 
   delete temp;
   delete trans;
@@ -439,6 +478,9 @@ void Measurement1D::SetCholDecompFromRootFile(std::string covfile,
                                               std::string histname) {
   //********************************************************************
 
+  if (DeferLoad(kLoadCholRoot, covfile, histname))
+    return;
+
   NUIS_LOG(SAM, "Reading cholesky decomp from root file: " << covfile << ";"
                                                            << histname);
   TMatrixD *temp = StatUtils::GetMatrixFromRootFile(covfile, histname);
@@ -448,14 +490,15 @@ void Measurement1D::SetCholDecompFromRootFile(std::string covfile,
   (*trans) *= (*temp);
 
   fFullCovar = new TMatrixDSym(temp->GetNrows(), trans->GetMatrixArray(), "");
-  covar = StatUtils::GetInvert(fFullCovar, true);
-  fDecomp = StatUtils::GetDecomp(fFullCovar);
+  InvertFullCovar();
 
   delete temp;
   delete trans;
 }
 
 void Measurement1D::SetShapeCovar() {
+  if (DeferLoad(kLoadShapeCovar))
+    return;
 
   // Return if this is missing any pre-requisites
   if (!fFullCovar)
@@ -474,12 +517,20 @@ void Measurement1D::SetShapeCovar() {
 //********************************************************************
 void Measurement1D::ScaleData(double scale) {
   //********************************************************************
+
+  if (DeferLoad(kLoadScaleData, "", "", -1, scale))
+    return;
+
   fDataHist->Scale(scale);
 }
 
 //********************************************************************
 void Measurement1D::ScaleDataErrors(double scale) {
   //********************************************************************
+
+  if (DeferLoad(kLoadScaleDataErrors, "", "", -1, scale))
+    return;
+
   for (int i = 0; i < fDataHist->GetNbinsX(); i++) {
     fDataHist->SetBinError(i + 1, fDataHist->GetBinError(i + 1) * scale);
   }
@@ -488,15 +539,106 @@ void Measurement1D::ScaleDataErrors(double scale) {
 //********************************************************************
 void Measurement1D::ScaleCovar(double scale) {
   //********************************************************************
+
+  if (DeferLoad(kLoadScaleCovar, "", "", -1, scale))
+    return;
+
   (*fFullCovar) *= scale;
-  (*covar) *= 1.0 / scale;
-  (*fDecomp) *= sqrt(scale);
+  // Not built yet when run from LoadData
+  if (covar)
+    (*covar) *= 1.0 / scale;
+  if (fDecomp)
+    (*fDecomp) *= sqrt(scale);
+}
+
+//********************************************************************
+void Measurement1D::InvertFullCovar() {
+  //********************************************************************
+
+  // Queued covariances are only inverted once, in FinaliseMeasurement,
+  // which may replace the inverse anyway for diagonal or shape-only fits
+  if (fLoadingData) {
+    delete covar;
+    covar = NULL;
+    delete fDecomp;
+    fDecomp = NULL;
+    return;
+  }
+
+  covar = StatUtils::GetInvert(fFullCovar, true);
+  fDecomp = StatUtils::GetDecomp(fFullCovar);
+}
+
+//********************************************************************
+void Measurement1D::RunDataLoad(DataLoad const &load) {
+  //********************************************************************
+
+  switch (load.kind) {
+  case kLoadDataText:
+    SetDataFromTextFile(load.file);
+    break;
+  case kLoadDataRoot:
+    SetDataFromRootFile(load.file, load.name);
+    break;
+  case kLoadPoissonErrors:
+    SetPoissonErrors();
+    break;
+  case kLoadDiagonalCovar:
+    SetCovarFromDiagonal();
+    break;
+  case kLoadCovarText:
+    SetCovarFromTextFile(load.file, load.dim);
+    break;
+  case kLoadCovarMultiText:
+    SetCovarFromMultipleTextFiles(load.file, load.dim);
+    break;
+  case kLoadCovarRoot:
+    SetCovarFromRootFile(load.file, load.name);
+    break;
+  case kLoadCovarInvertText:
+    SetCovarInvertFromTextFile(load.file, load.dim);
+    break;
+  case kLoadCovarInvertRoot:
+    SetCovarInvertFromRootFile(load.file, load.name);
+    break;
+  case kLoadCorrText:
+    SetCorrelationFromTextFile(load.file, load.dim);
+    break;
+  case kLoadCorrMultiText:
+    SetCorrelationFromMultipleTextFiles(load.file, load.dim);
+    break;
+  case kLoadCorrRoot:
+    SetCorrelationFromRootFile(load.file, load.name);
+    break;
+  case kLoadCholText:
+    SetCholDecompFromTextFile(load.file, load.dim);
+    break;
+  case kLoadCholRoot:
+    SetCholDecompFromRootFile(load.file, load.name);
+    break;
+  case kLoadShapeCovar:
+    SetShapeCovar();
+    break;
+  case kLoadScaleData:
+    ScaleData(load.scale);
+    break;
+  case kLoadScaleDataErrors:
+    ScaleDataErrors(load.scale);
+    break;
+  case kLoadScaleCovar:
+    ScaleCovar(load.scale);
+    break;
+  default:
+    MeasurementBase::RunDataLoad(load);
+  }
 }
 
 //********************************************************************
 void Measurement1D::SetBinMask(std::string maskfile) {
   //********************************************************************
 
+  LoadData();
+
   if (!fIsMask)
     return;
   NUIS_LOG(SAM, "Reading bin mask from file: " << maskfile);
@@ -543,6 +685,12 @@ void Measurement1D::FinaliseMeasurement() {
 
   NUIS_LOG(SAM, "Finalising Measurement: " << fName);
 
+  // MC only samples never read their queued data or covariances
+  if (fSettings.GetB("onlymc")) {
+    fDataLoads.clear();
+  }
+  LoadData();
+
   if (fSettings.GetB("onlymc")) {
     if (fDataHist)
       delete fDataHist;
@@ -584,6 +732,9 @@ void Measurement1D::FinaliseMeasurement() {
     fDecomp = StatUtils::GetDecomp(fFullCovar);
   }
 
+  // Drop any covariance caches built before finalising
+  fCovarVersion++;
+
   // Push the diagonals of fFullCovar onto the data histogram
   // Comment this out until the covariance/data scaling is consistent!
   StatUtils::SetDataErrorFromCov(fDataHist, fFullCovar, 1E-38);
@@ -1071,7 +1222,7 @@ double Measurement1D::GetLikelihood() {
   }
 
   // Sort Shape Scaling
-  double scaleF = 0.0;
+  double scaleF = 1.0;
   // TODO Include !fIsRawEvents
   if (fIsShape) {
     // Don't renorm based on width if we are using ShapeNormDecomp
@@ -1079,19 +1230,26 @@ double Measurement1D::GetLikelihood() {
       if (fMCHist->Integral(1, fMCHist->GetNbinsX())) {
         scaleF = fDataHist->Integral(1, fDataHist->GetNbinsX()) /
                  fMCHist->Integral(1, fMCHist->GetNbinsX());
-        fMCHist->Scale(scaleF);
-        fMCFine->Scale(scaleF);
       }
     } else {
       if (fMCHist->Integral(1, fMCHist->GetNbinsX(), "width")) {
         scaleF = fDataHist->Integral(1, fDataHist->GetNbinsX(), "width") /
                  fMCHist->Integral(1, fMCHist->GetNbinsX(), "width");
-        fMCHist->Scale(scaleF);
-        fMCFine->Scale(scaleF);
       }
     }
   }
 
+  // The covariance chi2 applies the shape scaling as a factor on the MC,
+  // the other likelihoods still need fMCHist scaled in place.
+  bool usecovcache = fIsChi2 and !fIsRawEvents and !fIsDiag and
+                     !StatUtils::GetOptions().AddMCErrorToCovar;
+  bool scalemc = fIsShape and !usecovcache;
+  if (scalemc) {
+    fMCHist->Scale(scaleF);
+    fMCFine->Scale(scaleF);
+  }
+  double mcscale = scalemc ? 1.0 : scaleF;
+
   // Likelihood Calculation
   double stat = 0.;
   if (fIsChi2) {
@@ -1100,7 +1258,15 @@ double Measurement1D::GetLikelihood() {
       stat = StatUtils::GetChi2FromEventRate(fDataHist, fMCHist, fMaskHist);
     } else if (fIsDiag) {
       stat = StatUtils::GetChi2FromDiag(fDataHist, fMCHist, fMaskHist);
-    } else if (!fIsDiag and !fIsRawEvents) {
+    } else if (usecovcache) {
+      StatUtils::UpdateCovarCache(fCovarCache, fDataHist, covar,
+                                  fCovarVersion, fMaskHist);
+      stat = StatUtils::GetChi2FromCov(
+          fCovarCache, fDataHist, fMCHist, mcscale,
+          fIsWriting ? fResidualHist : NULL,
+          fIsWriting ? fChi2LessBinHist : NULL);
+    } else {
+      // MC errors are added to the covariance, so it can't be cached
       stat = StatUtils::GetChi2FromCov(fDataHist, fMCHist, covar, fMaskHist, 1,
                                        1E76, fIsWriting ? fResidualHist : NULL);
       if (fChi2LessBinHist && fIsWriting) {
@@ -1126,24 +1292,23 @@ double Measurement1D::GetLikelihood() {
     if (fUseShapeNormDecomp) { // if shape norm, then add the norm penalty from
                                // https://arxiv.org/pdf/2003.00088.pdf
 
-      TH1 *masked_data = StatUtils::ApplyHistogramMasking(fDataHist, fMaskHist);
-      TH1 *masked_mc = StatUtils::ApplyHistogramMasking(fMCHist, fMaskHist);
-      masked_mc->Scale(scaleF);
+      // Masked integrals. The MC is the shape scaled MC scaled by scaleF
+      // once more, as it was when this used scaled histogram copies.
+      double datainteg = 0.0;
+      double mcinteg = 0.0;
+      for (int i = 0; i < fDataHist->GetNbinsX(); i++) {
+        if (fMaskHist and fMaskHist->GetBinContent(i + 1))
+          continue;
+        datainteg += fDataHist->GetBinContent(i + 1);
+        mcinteg += fMCHist->GetBinContent(i + 1);
+      }
+      mcinteg *= mcscale * scaleF;
 
       NUIS_LOG(REC, "Shape Norm Decomp mcinteg: "
-                        << masked_mc->Integral() * 1E38
-                        << ", datainteg: " << masked_data->Integral() * 1E38
-                        << ", normerror: " << fNormError);
-
-      double normpen =
-          std::pow((masked_data->Integral() - masked_mc->Integral()) * 1E38,
-                   2) /
-          fNormError;
+                        << mcinteg * 1E38 << ", datainteg: "
+                        << datainteg * 1E38 << ", normerror: " << fNormError);
 
-      masked_data->SetDirectory(NULL);
-      delete masked_data;
-      masked_mc->SetDirectory(NULL);
-      delete masked_mc;
+      double normpen = std::pow((datainteg - mcinteg) * 1E38, 2) / fNormError;
 
       NUIS_LOG(SAM, "Using Shape/Norm decomposition: Norm penalty "
                         << normpen << " on shape penalty of " << stat);
@@ -1158,7 +1323,7 @@ double Measurement1D::GetLikelihood() {
   }
 
   // Return to normal scaling
-  if (fIsShape) { // and !FitPar::Config().GetParB("saveshapescaling")) {
+  if (scalemc) { // and !FitPar::Config().GetParB("saveshapescaling")) {
     fMCHist->Scale(1. / scaleF);
     fMCFine->Scale(1. / scaleF);
   }
@@ -1239,6 +1404,7 @@ void Measurement1D::SetFakeDataValues(std::string fakeOption) {
   if (fDecomp)
     delete fDecomp;
   fDecomp = StatUtils::GetDecomp(fFullCovar);
+  fCovarVersion++;
 
   delete tempdata;
 
@@ -1282,7 +1448,8 @@ void Measurement1D::ThrowCovariance() {
     fDataTrue = (TH1D *)fDataHist->Clone();
   if (fDataHist)
     delete fDataHist;
-  fDataHist = StatUtils::ThrowHistogram(fDataTrue, fFullCovar);
+  fDataHist = StatUtils::ThrowHistogramFromDecomp(
+      fDataTrue, GetThrowDecomp(), fIsMask ? fMaskHist : NULL);
 
   return;
 };
@@ -1294,7 +1461,51 @@ void Measurement1D::ThrowDataToy() {
     fDataTrue = (TH1D *)fDataHist->Clone();
   if (fMCHist)
     delete fMCHist;
-  fMCHist = StatUtils::ThrowHistogram(fDataTrue, fFullCovar);
+  fMCHist = StatUtils::ThrowHistogramFromDecomp(fDataTrue, GetThrowDecomp(),
+                                                fIsMask ? fMaskHist : NULL);
+}
+
+//********************************************************************
+std::vector<TH1D *> Measurement1D::ThrowDataToys(int ntoys) {
+  //********************************************************************
+  if (!fDataTrue)
+    fDataTrue = (TH1D *)fDataHist->Clone();
+  return StatUtils::ThrowHistogramsFromDecomp(
+      fDataTrue, GetThrowDecomp(), ntoys, fIsMask ? fMaskHist : NULL);
+}
+
+//********************************************************************
+std::vector<double> Measurement1D::GetDataToyLikelihoods(int ntoys) {
+  //********************************************************************
+
+  // Batches bound how many toy histograms are held at once
+  const int batchsize = 1000;
+
+  std::vector<double> likes;
+  while (int(likes.size()) < ntoys) {
+    int nbatch = std::min(batchsize, ntoys - int(likes.size()));
+    std::vector<TH1D *> toys = ThrowDataToys(nbatch);
+    for (size_t i = 0; i < toys.size(); i++) {
+      if (fMCHist)
+        delete fMCHist;
+      fMCHist = toys[i];
+      likes.push_back(GetLikelihood());
+    }
+  }
+
+  return likes;
+}
+
+//********************************************************************
+TMatrixDSym *Measurement1D::GetThrowDecomp() {
+  //********************************************************************
+
+  if (!fFullCovar) {
+    NUIS_ABORT("No covariance set for " << fName << ", cannot throw toys");
+  }
+
+  return StatUtils::GetThrowDecomp(fThrowCache, fFullCovar, fCovarVersion,
+                                   fIsMask ? fMaskHist : NULL);
 }
 
 /*
@@ -1742,7 +1953,7 @@ void Measurement1D::SetCovarMatrix(std::string covarFile) {
 
   // Covariance function, only really used when reading in the MB Covariances.
 
-  TFile *tempFile = new TFile(covarFile.c_str(), "READ");
+  TFile *tempFile = GeneralUtils::GetCachedFile(covarFile);
 
   TH2D *covarPlot = new TH2D();
   TH2D *fFullCovarPlot = new TH2D();
@@ -1931,7 +2142,7 @@ void Measurement1D::SetCovarFromDataFile(std::string covarFile,
 
   NUIS_LOG(SAM, "Getting covariance from " << covarFile << "->" << covName);
 
-  TFile *tempFile = new TFile(covarFile.c_str(), "READ");
+  TFile *tempFile = GeneralUtils::GetCachedFile(covarFile);
   TH2D *covPlot = (TH2D *)tempFile->Get(covName.c_str());
   covPlot->SetDirectory(0);
   // Scale the covariance matrix if it comes in normal units
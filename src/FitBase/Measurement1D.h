@@ -251,6 +251,15 @@ public:
   /// \brief Scale the covariaince and its invert/decomp by some scale factor.
   virtual void ScaleCovar(double scale);
 
+  /// \brief Invert and decompose fFullCovar into covar and fDecomp.
+  ///
+  /// When run from LoadData both are cleared instead and built once in
+  /// FinaliseMeasurement.
+  void InvertFullCovar();
+
+  /// \brief Run a helper call queued while fDeferLoading was set
+  virtual void RunDataLoad(DataLoad const &load);
+
 
 
   /// \brief Setup a bin masking histogram and apply masking to data
@@ -341,6 +350,11 @@ public:
   /// that contains the extra variables.
   virtual MeasurementVariableBox* CreateBox() {return new MeasurementVariableBox1D();};
 
+  /// fMCHist bin for the box X value, matching FillHistograms
+  virtual int GetBoxBin(MeasurementVariableBox* var) {
+    return fIsSingleBin ? 1 : fMCHist->FindFixBin(var->GetX());
+  };
+
   /// \brief Reset all MC histograms
   ///
   /// Resets all standard histograms and those registered to auto
@@ -431,6 +445,23 @@ public:
   /// so that the likelihood is calculated between data and thrown data
   virtual void ThrowDataToy(void);
 
+  /// \brief Throw ntoys correlated data toys from the true data in one batch
+  ///
+  /// Uses the cached throw decomposition. Caller owns the returned histograms.
+  virtual std::vector<TH1D*> ThrowDataToys(int ntoys);
+
+  /// \brief Likelihoods of ntoys data toys scored in place of the MC
+  ///
+  /// Throws in batches through ThrowDataToys so the decomposition and
+  /// random draws are shared. The last toy is left in fMCHist.
+  virtual std::vector<double> GetDataToyLikelihoods(int ntoys);
+
+  /// \brief Decomposition of the masked covariance used for throws
+  ///
+  /// Cached between calls and only recomputed when fFullCovar, its
+  /// fCovarVersion or the bin mask changes.
+  TMatrixDSym* GetThrowDecomp(void);
+
 
   /*
     Access Functions
@@ -603,6 +634,8 @@ protected:
   TMatrixDSym* covar;       ///< Inverted Covariance
   TMatrixDSym* fFullCovar;  ///< Full Covariance
   TMatrixDSym* fDecomp;     ///< Decomposed Covariance
+  StatUtils::ThrowCache fThrowCache; ///< Cached masked decomposition for throws
+  StatUtils::CovarCache fCovarCache; ///< Masked covar for likelihoods
   TMatrixDSym* fCorrel;     ///< Correlation Matrix
 
   TMatrixDSym* fShapeCovar;  ///< Shape-only covariance
@@ -20,6 +20,8 @@
 #include "Measurement2D.h"
 #include "TDecompChol.h"
 
+#include <algorithm>
+
 //********************************************************************
 Measurement2D::Measurement2D(void) {
   //********************************************************************
@@ -29,6 +31,9 @@ Measurement2D::Measurement2D(void) {
   fDecomp = NULL;
   fFullCovar = NULL;
 
+  // Read once here so GetLikelihood does not touch the global config
+  fSaveShapeScaling = FitPar::Config().GetParB("saveshapescaling");
+
   fMCHist = NULL;
   fMCFine = NULL;
   fDataHist = NULL;
@@ -112,6 +117,7 @@ Measurement2D::~Measurement2D(void) {
     delete fInvert;
   if (fDecomp)
     delete fDecomp;
+  StatUtils::ClearThrowCache(fThrowCache);
 
   delete fResidualHist;
   delete fChi2LessBinHist;
@@ -170,6 +176,8 @@ void Measurement2D::FinaliseSampleSettings() {
 
 void Measurement2D::CreateDataHistogram(int dimx, double *binx, int dimy,
                                         double *biny) {
+  LoadData();
+
   if (fDataHist)
     delete fDataHist;
 
@@ -182,6 +190,9 @@ void Measurement2D::CreateDataHistogram(int dimx, double *binx, int dimy,
 
 void Measurement2D::SetDataFromTextFile(std::string data, std::string binx,
                                         std::string biny) {
+  if (DeferLoad(kLoadDataText, data, binx, -1, 1.0, biny))
+    return;
+
   // Get the data hist
   fDataHist = PlotUtils::GetTH2DFromTextFile(data, binx, biny);
   // Set the name properly
@@ -191,6 +202,9 @@ void Measurement2D::SetDataFromTextFile(std::string data, std::string binx,
 
 void Measurement2D::SetDataFromRootFile(std::string datfile,
                                         std::string histname) {
+  if (DeferLoad(kLoadDataRoot, datfile, histname))
+    return;
+
   NUIS_LOG(SAM, "Reading data from root file: " << datfile << ";" << histname);
   fDataHist = PlotUtils::GetTH2DFromRootFile(datfile, histname);
   fDataHist->SetNameTitle((fSettings.GetName() + "_data").c_str(),
@@ -198,6 +212,9 @@ void Measurement2D::SetDataFromRootFile(std::string datfile,
 }
 
 void Measurement2D::SetDataValuesFromTextFile(std::string datfile, TH2D *hist) {
+  if (!hist && DeferLoad(kLoadDataValuesText, datfile))
+    return;
+  LoadData();
 
   NUIS_LOG(SAM, "Setting data values from text file");
   if (!hist)
@@ -218,6 +235,10 @@ void Measurement2D::SetDataValuesFromTextFile(std::string datfile, TH2D *hist) {
 }
 
 void Measurement2D::SetDataErrorsFromTextFile(std::string datfile, TH2D *hist) {
+  if (!hist && DeferLoad(kLoadDataErrorsText, datfile))
+    return;
+  LoadData();
+
   NUIS_LOG(SAM, "Setting data errors from text file");
 
   if (!hist)
@@ -240,6 +261,8 @@ void Measurement2D::SetDataErrorsFromTextFile(std::string datfile, TH2D *hist) {
 }
 
 void Measurement2D::SetMapValuesFromText(std::string dataFile) {
+  if (DeferLoad(kLoadMapText, dataFile))
+    return;
 
   TH2D *hist = fDataHist;
   std::vector<double> edgex;
@@ -261,6 +284,9 @@ void Measurement2D::SetMapValuesFromText(std::string dataFile) {
 void Measurement2D::SetPoissonErrors() {
   //********************************************************************
 
+  if (DeferLoad(kLoadPoissonErrors))
+    return;
+
   if (!fDataHist) {
     NUIS_ERR(FTL, "Need a data hist to setup possion errors! ");
     NUIS_ABORT("Setup Data First!");
@@ -275,6 +301,10 @@ void Measurement2D::SetPoissonErrors() {
 void Measurement2D::SetCovarFromDiagonal(TH2D *data) {
   //********************************************************************
 
+  if (!data && DeferLoad(kLoadDiagonalCovar))
+    return;
+  LoadData();
+
   if (!data and fDataHist) {
     data = fDataHist;
   }
@@ -282,8 +312,7 @@ void Measurement2D::SetCovarFromDiagonal(TH2D *data) {
   if (data) {
     NUIS_LOG(SAM, "Setting diagonal covariance for: " << data->GetName());
     fFullCovar = StatUtils::MakeDiagonalCovarMatrix(data);
-    covar = StatUtils::GetInvert(fFullCovar,true);
-    fDecomp = StatUtils::GetDecomp(fFullCovar);
+    InvertFullCovar();
   } else {
     NUIS_ABORT("No data input provided to set diagonal covar from!");
   }
@@ -299,14 +328,16 @@ void Measurement2D::SetCovarFromDiagonal(TH2D *data) {
 void Measurement2D::SetCovarFromTextFile(std::string covfile, int dim) {
   //********************************************************************
 
+  if (DeferLoad(kLoadCovarText, covfile, "", dim))
+    return;
+
   if (dim == -1) {
     dim = this->GetNDOF();
   }
 
   NUIS_LOG(SAM, "Reading covariance from text file: " << covfile << " " << dim);
   fFullCovar = StatUtils::GetCovarFromTextFile(covfile, dim);
-  covar = StatUtils::GetInvert(fFullCovar,true);
-  fDecomp = StatUtils::GetDecomp(fFullCovar);
+  InvertFullCovar();
 }
 
 //********************************************************************
@@ -314,17 +345,22 @@ void Measurement2D::SetCovarFromRootFile(std::string covfile,
                                          std::string histname) {
   //********************************************************************
 
+  if (DeferLoad(kLoadCovarRoot, covfile, histname))
+    return;
+
   NUIS_LOG(SAM,
            "Reading covariance from text file: " << covfile << ";" << histname);
   fFullCovar = StatUtils::GetCovarFromRootFile(covfile, histname);
-  covar = StatUtils::GetInvert(fFullCovar,true);
-  fDecomp = StatUtils::GetDecomp(fFullCovar);
+  InvertFullCovar();
 }
 
 //********************************************************************
 void Measurement2D::SetCovarInvertFromTextFile(std::string covfile, int dim) {
   //********************************************************************
 
+  if (DeferLoad(kLoadCovarInvertText, covfile, "", dim))
+    return;
+
   if (dim == -1) {
     dim = this->GetNDOF();
   }
@@ -340,6 +376,9 @@ void Measurement2D::SetCovarInvertFromRootFile(std::string covfile,
                                                std::string histname) {
   //********************************************************************
 
+  if (DeferLoad(kLoadCovarInvertRoot, covfile, histname))
+    return;
+
   NUIS_LOG(SAM, "Reading inverted covariance from text file: " << covfile << ";"
                                                                << histname);
   covar = StatUtils::GetCovarFromRootFile(covfile, histname);
@@ -351,6 +390,9 @@ void Measurement2D::SetCovarInvertFromRootFile(std::string covfile,
 void Measurement2D::SetCorrelationFromTextFile(std::string covfile, int dim) {
   //********************************************************************
 
+  if (DeferLoad(kLoadCorrText, covfile, "", dim))
+    return;
+
   if (dim == -1)
     dim = this->GetNDOF();
   NUIS_LOG(SAM, "Reading data correlations from text file: " << covfile << ";"
@@ -375,8 +417,7 @@ void Measurement2D::SetCorrelationFromTextFile(std::string covfile, int dim) {
   }
 
   // Fill other covars.
-  covar = StatUtils::GetInvert(fFullCovar,true);
-  fDecomp = StatUtils::GetDecomp(fFullCovar);
+  InvertFullCovar();
 
   delete correlation;
 }
@@ -386,6 +427,9 @@ void Measurement2D::SetCorrelationFromRootFile(std::string covfile,
                                                std::string histname) {
   //********************************************************************
 
+  if (DeferLoad(kLoadCorrRoot, covfile, histname))
+    return;
+
   NUIS_LOG(SAM, "Reading data correlations from text file: " << covfile << ";"
                                                              << histname);
   TMatrixDSym *correlation = StatUtils::GetCovarFromRootFile(covfile, histname);
@@ -408,8 +452,7 @@ void Measurement2D::SetCorrelationFromRootFile(std::string covfile,
   }
 
   // Fill other covars.
-  covar = StatUtils::GetInvert(fFullCovar,true);
-  fDecomp = StatUtils::GetDecomp(fFullCovar);
+  InvertFullCovar();
 
   delete correlation;
 }
@@ -418,6 +461,9 @@ void Measurement2D::SetCorrelationFromRootFile(std::string covfile,
 void Measurement2D::SetCholDecompFromTextFile(std::string covfile, int dim) {
   //********************************************************************
 
+  if (DeferLoad(kLoadCholText, covfile, "", dim))
+    return;
+
   if (dim == -1) {
     dim = this->GetNDOF();
   }
@@ -430,8 +476,7 @@ void Measurement2D::SetCholDecompFromTextFile(std::string covfile, int dim) {
   (*trans) *= (*temp);
 
   fFullCovar = new TMatrixDSym(dim, trans->GetMatrixArray(), "");
-  covar = StatUtils::GetInvert(fFullCovar,true);
-  fDecomp = StatUtils::GetDecomp(fFullCovar);
+  InvertFullCovar();
 
   delete temp;
   delete trans;
@@ -442,6 +487,9 @@ void Measurement2D::SetCholDecompFromRootFile(std::string covfile,
                                               std::string histname) {
   //********************************************************************
 
+  if (DeferLoad(kLoadCholRoot, covfile, histname))
+    return;
+
   NUIS_LOG(SAM, "Reading cholesky decomp from root file: " << covfile << ";"
                                                            << histname);
   TMatrixD *temp = StatUtils::GetMatrixFromRootFile(covfile, histname);
@@ -451,14 +499,15 @@ void Measurement2D::SetCholDecompFromRootFile(std::string covfile,
   (*trans) *= (*temp);
 
   fFullCovar = new TMatrixDSym(temp->GetNrows(), trans->GetMatrixArray(), "");
-  covar = StatUtils::GetInvert(fFullCovar,true);
-  fDecomp = StatUtils::GetDecomp(fFullCovar);
+  InvertFullCovar();
 
   delete temp;
   delete trans;
 }
 
 void Measurement2D::SetShapeCovar() {
+  if (DeferLoad(kLoadShapeCovar))
+    return;
 
   // Return if this is missing any pre-requisites
   if (!fFullCovar)
@@ -478,12 +527,20 @@ void Measurement2D::SetShapeCovar() {
 //********************************************************************
 void Measurement2D::ScaleData(double scale) {
   //********************************************************************
+
+  if (DeferLoad(kLoadScaleData, "", "", -1, scale))
+    return;
+
   fDataHist->Scale(scale);
 }
 
 //********************************************************************
 void Measurement2D::ScaleDataErrors(double scale) {
   //********************************************************************
+
+  if (DeferLoad(kLoadScaleDataErrors, "", "", -1, scale))
+    return;
+
   for (int i = 0; i < fDataHist->GetNbinsX(); i++) {
     for (int j = 0; j < fDataHist->GetNbinsY(); j++) {
       fDataHist->SetBinError(i + 1, j + 1,
@@ -495,15 +552,109 @@ void Measurement2D::ScaleDataErrors(double scale) {
 //********************************************************************
 void Measurement2D::ScaleCovar(double scale) {
   //********************************************************************
+
+  if (DeferLoad(kLoadScaleCovar, "", "", -1, scale))
+    return;
+
   (*fFullCovar) *= scale;
-  (*covar) *= 1.0 / scale;
-  (*fDecomp) *= sqrt(scale);
+  // Not built yet when run from LoadData
+  if (covar)
+    (*covar) *= 1.0 / scale;
+  if (fDecomp)
+    (*fDecomp) *= sqrt(scale);
+}
+
+//********************************************************************
+void Measurement2D::InvertFullCovar() {
+  //********************************************************************
+
+  // Queued covariances are only inverted once, in FinaliseMeasurement,
+  // which may replace the inverse anyway for diagonal or shape-only fits
+  if (fLoadingData) {
+    delete covar;
+    covar = NULL;
+    delete fDecomp;
+    fDecomp = NULL;
+    return;
+  }
+
+  covar = StatUtils::GetInvert(fFullCovar, true);
+  fDecomp = StatUtils::GetDecomp(fFullCovar);
+}
+
+//********************************************************************
+void Measurement2D::RunDataLoad(DataLoad const &load) {
+  //********************************************************************
+
+  switch (load.kind) {
+  case kLoadDataText:
+    SetDataFromTextFile(load.file, load.name, load.extra);
+    break;
+  case kLoadDataRoot:
+    SetDataFromRootFile(load.file, load.name);
+    break;
+  case kLoadDataValuesText:
+    SetDataValuesFromTextFile(load.file);
+    break;
+  case kLoadDataErrorsText:
+    SetDataErrorsFromTextFile(load.file);
+    break;
+  case kLoadMapText:
+    SetMapValuesFromText(load.file);
+    break;
+  case kLoadPoissonErrors:
+    SetPoissonErrors();
+    break;
+  case kLoadDiagonalCovar:
+    SetCovarFromDiagonal();
+    break;
+  case kLoadCovarText:
+    SetCovarFromTextFile(load.file, load.dim);
+    break;
+  case kLoadCovarRoot:
+    SetCovarFromRootFile(load.file, load.name);
+    break;
+  case kLoadCovarInvertText:
+    SetCovarInvertFromTextFile(load.file, load.dim);
+    break;
+  case kLoadCovarInvertRoot:
+    SetCovarInvertFromRootFile(load.file, load.name);
+    break;
+  case kLoadCorrText:
+    SetCorrelationFromTextFile(load.file, load.dim);
+    break;
+  case kLoadCorrRoot:
+    SetCorrelationFromRootFile(load.file, load.name);
+    break;
+  case kLoadCholText:
+    SetCholDecompFromTextFile(load.file, load.dim);
+    break;
+  case kLoadCholRoot:
+    SetCholDecompFromRootFile(load.file, load.name);
+    break;
+  case kLoadShapeCovar:
+    SetShapeCovar();
+    break;
+  case kLoadScaleData:
+    ScaleData(load.scale);
+    break;
+  case kLoadScaleDataErrors:
+    ScaleDataErrors(load.scale);
+    break;
+  case kLoadScaleCovar:
+    ScaleCovar(load.scale);
+    break;
+  default:
+    MeasurementBase::RunDataLoad(load);
+  }
 }
 
 //********************************************************************
 void Measurement2D::SetBinMask(std::string maskfile) {
   //********************************************************************
 
+  LoadData();
+
   if (!fIsMask)
     return;
   NUIS_LOG(SAM, "Reading bin mask from file: " << maskfile);
@@ -551,6 +702,13 @@ void Measurement2D::FinaliseMeasurement() {
   //********************************************************************
 
   NUIS_LOG(SAM, "Finalising Measurement: " << fName);
+
+  // MC only samples never read their queued data or covariances
+  if (fSettings.GetB("onlymc")) {
+    fDataLoads.clear();
+  }
+  LoadData();
+
   if (fSettings.GetB("onlymc")) {
     if (fDataHist)
       delete fDataHist;
@@ -591,6 +749,9 @@ void Measurement2D::FinaliseMeasurement() {
     fDecomp = StatUtils::GetDecomp(fFullCovar);
   }
 
+  // Drop any covariance caches built before finalising
+  fCovarVersion++;
+
   // If shape only, set covar and fDecomp using the shape-only matrix (if set)
   if (fIsShape && fShapeCovar && FitPar::Config().GetParB("UseShapeCovar")) {
     if (covar)
@@ -1040,11 +1201,18 @@ double Measurement2D::GetLikelihood() {
   // Scale up the results to match each other (Not using width might be
   // inconsistent with Meas1D)
   double scaleF = fDataHist->Integral() / fMCHist->Integral();
-  if (fIsShape) {
+
+  // The covariance chi2 applies the shape scaling as a factor on the MC,
+  // the other likelihoods and saveshapescaling need fMCHist scaled in place.
+  bool usecovcache =
+      fIsChi2 and !fIsDiag and !StatUtils::GetOptions().AddMCErrorToCovar;
+  bool scalemc = fIsShape and (!usecovcache or fSaveShapeScaling);
+  if (scalemc) {
     fMCHist->Scale(scaleF);
     fMCFine->Scale(scaleF);
     // PlotUtils::ScaleNeutModeArray((TH1**)fMCHist_PDG, scaleF);
   }
+  double mcscale = (fIsShape and !scalemc) ? scaleF : 1.0;
 
   if (!fMapHist) {
     fMapHist = StatUtils::GenerateMap(fDataHist);
@@ -1057,7 +1225,15 @@ double Measurement2D::GetLikelihood() {
     if (fIsDiag) {
       chi2 =
           StatUtils::GetChi2FromDiag(fDataHist, fMCHist, fMapHist, fMaskHist);
+    } else if (usecovcache) {
+      StatUtils::UpdateCovarCache(fCovarCache, fDataHist, covar,
+                                  fCovarVersion, fMapHist, fMaskHist);
+      chi2 = StatUtils::GetChi2FromCov(
+          fCovarCache, fDataHist, fMCHist, mcscale,
+          fIsWriting ? fResidualHist : NULL,
+          fIsWriting ? fChi2LessBinHist : NULL);
     } else {
+      // MC errors are added to the covariance, so it can't be cached
       chi2 = StatUtils::GetChi2FromCov(fDataHist, fMCHist, covar, fMapHist,
                                        fMaskHist,
                                        fIsWriting ? fResidualHist : NULL);
@@ -1090,24 +1266,25 @@ double Measurement2D::GetLikelihood() {
     if (fUseShapeNormDecomp) { // if shape norm, then add the norm penalty from
                                // https://arxiv.org/pdf/2003.00088.pdf
 
-      TH2 *masked_data = StatUtils::ApplyHistogramMasking(fDataHist, fMaskHist);
-      TH2 *masked_mc = StatUtils::ApplyHistogramMasking(fMCHist, fMaskHist);
-      masked_mc->Scale(scaleF);
+      // Masked integrals. The MC is the shape scaled MC scaled by scaleF
+      // once more, as it was when this used scaled histogram copies.
+      double datainteg = 0.0;
+      double mcinteg = 0.0;
+      for (int i = 0; i < fDataHist->GetNbinsX(); i++) {
+        for (int j = 0; j < fDataHist->GetNbinsY(); j++) {
+          if (fMaskHist and fMaskHist->GetBinContent(i + 1, j + 1) > 0)
+            continue;
+          datainteg += fDataHist->GetBinContent(i + 1, j + 1);
+          mcinteg += fMCHist->GetBinContent(i + 1, j + 1);
+        }
+      }
+      mcinteg *= mcscale * scaleF;
 
       NUIS_LOG(REC, "ShapeNormDecomp: mcinteg: "
-                           << masked_mc->Integral() * 1E38
-                           << ", datainteg: " << masked_data->Integral() * 1E38
-                           << ", normerror: " << fNormError);
-
-      double normpen =
-          std::pow((masked_data->Integral() - masked_mc->Integral()) * 1E38,
-                   2) /
-          fNormError;
+                        << mcinteg * 1E38 << ", datainteg: "
+                        << datainteg * 1E38 << ", normerror: " << fNormError);
 
-      masked_data->SetDirectory(NULL);
-      delete masked_data;
-      masked_mc->SetDirectory(NULL);
-      delete masked_mc;
+      double normpen = std::pow((datainteg - mcinteg) * 1E38, 2) / fNormError;
 
       NUIS_LOG(REC, "Using Shape/Norm decomposition: Norm penalty "
                         << normpen << " on shape penalty of " << chi2);
@@ -1124,7 +1301,7 @@ double Measurement2D::GetLikelihood() {
   }
 
   // Adjust the shape back to where it was.
-  if (fIsShape and !FitPar::Config().GetParB("saveshapescaling")) {
+  if (scalemc and !fSaveShapeScaling) {
     fMCHist->Scale(1. / scaleF);
     fMCFine->Scale(1. / scaleF);
   }
@@ -1210,6 +1387,7 @@ void Measurement2D::SetFakeDataValues(std::string fakeOption) {
   if (fDecomp)
     delete fDecomp;
   fDecomp = StatUtils::GetDecomp(fFullCovar);
+  fCovarVersion++;
 
   delete tempdata;
 
@@ -1251,7 +1429,8 @@ void Measurement2D::ThrowCovariance() {
 
   if (fDataHist)
     delete fDataHist;
-  fDataHist = StatUtils::ThrowHistogram(fDataTrue, fFullCovar);
+  fDataHist = StatUtils::ThrowHistogramFromDecomp(
+      fDataTrue, GetThrowDecomp(), fMapHist, fIsMask ? fMaskHist : NULL);
 
   return;
 };
@@ -1263,7 +1442,60 @@ void Measurement2D::ThrowDataToy() {
     fDataTrue = (TH2D *)fDataHist->Clone();
   if (fMCHist)
     delete fMCHist;
-  fMCHist = StatUtils::ThrowHistogram(fDataTrue, fFullCovar);
+  fMCHist = StatUtils::ThrowHistogramFromDecomp(
+      fDataTrue, GetThrowDecomp(), fMapHist, fIsMask ? fMaskHist : NULL);
+}
+
+//********************************************************************
+std::vector<TH2D *> Measurement2D::ThrowDataToys(int ntoys) {
+  //********************************************************************
+  if (!fDataTrue)
+    fDataTrue = (TH2D *)fDataHist->Clone();
+  return StatUtils::ThrowHistogramsFromDecomp(
+      fDataTrue, GetThrowDecomp(), ntoys, fMapHist, fIsMask ? fMaskHist : NULL);
+}
+
+//********************************************************************
+std::vector<double> Measurement2D::GetDataToyLikelihoods(int ntoys) {
+  //********************************************************************
+
+  // Batches bound how many toy histograms are held at once
+  const int batchsize = 1000;
+
+  std::vector<double> likes;
+  while (int(likes.size()) < ntoys) {
+    int nbatch = std::min(batchsize, ntoys - int(likes.size()));
+    std::vector<TH2D *> toys = ThrowDataToys(nbatch);
+    for (size_t i = 0; i < toys.size(); i++) {
+      if (fMCHist)
+        delete fMCHist;
+      fMCHist = toys[i];
+      likes.push_back(GetLikelihood());
+    }
+  }
+
+  return likes;
+}
+
+//********************************************************************
+TMatrixDSym *Measurement2D::GetThrowDecomp() {
+  //********************************************************************
+
+  if (!fFullCovar) {
+    NUIS_ABORT("No covariance set for " << fName << ", cannot throw toys");
+  }
+
+  // The covariance is ordered through the bin map
+  if (!fMapHist)
+    fMapHist = StatUtils::GenerateMap(fDataHist);
+
+  TH1I *mask_1D = fIsMask ? StatUtils::MapToMask(fMaskHist, fMapHist) : NULL;
+  TMatrixDSym *decomp = StatUtils::GetThrowDecomp(fThrowCache, fFullCovar,
+                                                  fCovarVersion, mask_1D);
+  if (mask_1D)
+    delete mask_1D;
+
+  return decomp;
 }
 
 /*
@@ -1823,14 +2055,12 @@ void Measurement2D::SetDataValues(std::string dataFile, std::string TH2Dname) {
     NUIS_ABORT("See me at " << __FILE__ << ":" << __LINE__);
 
   } else {
-    TFile *inFile = new TFile(dataFile.c_str(), "READ");
+    TFile *inFile = GeneralUtils::GetCachedFile(dataFile);
     fDataHist = (TH2D *)(inFile->Get(TH2Dname.c_str())->Clone());
     fDataHist->SetDirectory(0);
 
     fDataHist->SetNameTitle((fName + "_data").c_str(),
                             (fName + "_MC" + fPlotTitles).c_str());
-
-    delete inFile;
   }
 
   return;
@@ -1909,7 +2139,7 @@ void Measurement2D::SetCovarMatrix(std::string covarFile) {
   //********************************************************************
 
   // Used to read a covariance matrix from a root file
-  TFile *tempFile = new TFile(covarFile.c_str(), "READ");
+  TFile *tempFile = GeneralUtils::GetCachedFile(covarFile);
 
   // Make plots that we want
   TH2D *covarPlot = new TH2D();
@@ -1976,9 +2206,6 @@ void Measurement2D::SetCovarMatrix(std::string covarFile) {
   TDecompSVD LU = TDecompSVD(*this->covar);
   this->covar = new TMatrixDSym(dim, LU.Invert().GetMatrixArray(), "");
 
-  tempFile->Close();
-  delete tempFile;
-
   return;
 };
 
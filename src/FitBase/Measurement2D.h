@@ -266,6 +266,15 @@ public:
   /// \brief Scale the covariaince and its invert/decomp by some scale factor.
   virtual void ScaleCovar(double scale);
 
+  /// \brief Invert and decompose fFullCovar into covar and fDecomp.
+  ///
+  /// When run from LoadData both are cleared instead and built once in
+  /// FinaliseMeasurement.
+  void InvertFullCovar();
+
+  /// \brief Run a helper call queued while fDeferLoading was set
+  virtual void RunDataLoad(DataLoad const &load);
+
   /// \brief Setup a bin masking histogram and apply masking to data
   ///
   /// \warning REQUIRES DATA HISTOGRAM TO BE SET FIRST
@@ -337,6 +346,11 @@ public:
     return new MeasurementVariableBox2D();
   };
 
+  /// fMCHist bin for the box X and Y values, matching FillHistograms
+  virtual int GetBoxBin(MeasurementVariableBox *var) {
+    return fMCHist->FindFixBin(var->GetX(), var->GetY());
+  };
+
   /// \brief Reset all MC histograms
   ///
   /// Resets all standard histograms and those registered to auto
@@ -426,6 +440,23 @@ public:
   /// so that the likelihood is calculated between data and thrown data
   virtual void ThrowDataToy(void);
 
+  /// \brief Throw ntoys correlated data toys from the true data in one batch
+  ///
+  /// Uses the cached throw decomposition. Caller owns the returned histograms.
+  virtual std::vector<TH2D *> ThrowDataToys(int ntoys);
+
+  /// \brief Likelihoods of ntoys data toys scored in place of the MC
+  ///
+  /// Throws in batches through ThrowDataToys so the decomposition and
+  /// random draws are shared. The last toy is left in fMCHist.
+  virtual std::vector<double> GetDataToyLikelihoods(int ntoys);
+
+  /// \brief Decomposition of the masked covariance used for throws
+  ///
+  /// Cached between calls and only recomputed when fFullCovar, its
+  /// fCovarVersion or the bin mask changes.
+  TMatrixDSym *GetThrowDecomp(void);
+
   /*
     Access Functions
   */
@@ -580,6 +611,8 @@ protected:
   TMatrixDSym *covar;      //!< inverted covariance matrix
   TMatrixDSym *fFullCovar; //!< covariance matrix
   TMatrixDSym *fDecomp;    //!< fDecomposed covariance matrix
+  StatUtils::ThrowCache fThrowCache; //!< cached masked decomposition for throws
+  StatUtils::CovarCache fCovarCache; //!< masked covar for likelihoods
   TMatrixDSym *fCorrel;    //!< correlation matrix
   TMatrixDSym *fShapeCovar;
   double fCovDet;    //!< covariance deteriminant
@@ -598,6 +631,7 @@ protected:
   bool fIsFree;      //!< Flag: Perform normalisation free fit
   bool fIsDiag;      //!< Flag: Only use diagonal bin errors in stats
   bool fIsMask;      //!< Flag: Apply bin masking
+  bool fSaveShapeScaling; //!< Flag: Keep shape scaling after the likelihood
   bool fIsRawEvents; //!< Flag: Only event rates in histograms
   bool fIsEnu;       //!< Needs Enu Unfolding
   bool fIsChi2SVD;   //!< Flag: Chi2 SVD Method (DO NOT USE)
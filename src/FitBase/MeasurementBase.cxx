@@ -48,12 +48,77 @@ MeasurementBase::MeasurementBase(void) {
   fTargetVolume = 0xdeadbeef;
   fTargetMaterialDensity = 0xdeadbeef;
   fEvtRateScaleFactor = 0xdeadbeef;
+  fCovarVersion = 0;
+  fDeferLoading = false;
+  fLoadingData = false;
+
+  fTimers.SetOwner(&fName);
 };
 
 void MeasurementBase::FinaliseMeasurement() {
   // Used to setup default data hists, covars, etc.
 }
 
+//********************************************************************
+bool MeasurementBase::DeferLoad(DataLoadKind kind, std::string const &file,
+                                std::string const &name, int dim,
+                                double scale, std::string const &extra) {
+  //********************************************************************
+
+  if (!fDeferLoading || fLoadingData)
+    return false;
+
+  DataLoad load;
+  load.kind = kind;
+  load.file = file;
+  load.name = name;
+  load.extra = extra;
+  load.dim = dim;
+  load.scale = scale;
+  fDataLoads.push_back(load);
+  return true;
+}
+
+//********************************************************************
+void MeasurementBase::LoadData() {
+  //********************************************************************
+
+  if (fLoadingData || fDataLoads.empty())
+    return;
+
+  // Helpers called from here see fLoadingData and run straight away
+  std::vector<DataLoad> loads;
+  loads.swap(fDataLoads);
+
+  GeneralUtils::CachedFileScope filescope;
+  fLoadingData = true;
+  for (size_t i = 0; i < loads.size(); i++) {
+    RunDataLoad(loads[i]);
+  }
+  fLoadingData = false;
+}
+
+//********************************************************************
+void MeasurementBase::RunDataLoad(DataLoad const &load) {
+  //********************************************************************
+
+  NUIS_ABORT(fName << " queued data load " << load.kind
+                   << " but does not know how to run it.");
+}
+
+//********************************************************************
+std::vector<double> MeasurementBase::GetDataToyLikelihoods(int ntoys) {
+  //********************************************************************
+
+  // Samples without a batch throw fall back to one toy at a time
+  std::vector<double> likes;
+  for (int i = 0; i < ntoys; i++) {
+    ThrowDataToy();
+    likes.push_back(GetLikelihood());
+  }
+  return likes;
+}
+
 //********************************************************************
 // 2nd Level Destructor (Inherits From MeasurementBase.h)
 MeasurementBase::~MeasurementBase(){
@@ -237,8 +302,11 @@ void MeasurementBase::Reconfigure() {
     Mode = cust_event->Mode;
 
     // Extract Measurement Variables
-    this->FillEventVariables(cust_event);
-    Signal = this->isSignal(cust_event);
+    {
+      TimingUtils::ScopedTimer timer(fTimers.ID(TimingUtils::kIsSignal));
+      this->FillEventVariables(cust_event);
+      Signal = this->isSignal(cust_event);
+    }
     if (Signal)
       npassed++;
 
@@ -283,6 +351,7 @@ void MeasurementBase::Reconfigure() {
 
   // Finalise Histograms
   fMCFilled = true;
+  TimingUtils::ScopedTimer timer(fTimers.ID(TimingUtils::kConvertEventRates));
   this->ConvertEventRates();
 }
 
@@ -294,17 +363,20 @@ void MeasurementBase::FillHistogramsFromBox(MeasurementVariableBox *var,
   Weight = weight;
   fEventVariables = var;
 
+  TimingUtils::ScopedTimer timer(fTimers.ID(TimingUtils::kHistFill));
   FillHistograms();
   FillExtraHistograms(var, weight);
 }
 
 void MeasurementBase::FillHistograms(double weight) {
+  TimingUtils::ScopedTimer timer(fTimers.ID(TimingUtils::kHistFill));
   Weight = weight * GetBox()->GetSampleWeight();
   FillHistograms();
   FillExtraHistograms(GetBox(), Weight);
 }
 
 MeasurementVariableBox *MeasurementBase::FillVariableBox(FitEvent *event) {
+  TimingUtils::ScopedTimer timer(fTimers.ID(TimingUtils::kIsSignal));
   GetBox()->Reset();
   Mode = event->Mode;
   Weight = 1.0; // event->Weight;
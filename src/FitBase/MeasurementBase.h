@@ -56,6 +56,7 @@
 #include "GeneralUtils.h"
 #include "PlotUtils.h"
 #include "StatUtils.h"
+#include "TimingUtils.h"
 #include "InputFactory.h"
 #include "FitWeight.h"
 
@@ -141,6 +142,10 @@ public:
   virtual int GetNDOF(void) { return 0; };
   virtual void ThrowCovariance(void) = 0;
   virtual void ThrowDataToy(void) = 0;
+
+  //! Get the likelihood of each of ntoys data throws, each scored in place
+  //! of the MC as ThrowDataToy does. The last toy is left as the MC.
+  virtual std::vector<double> GetDataToyLikelihoods(int ntoys);
   virtual void SetFakeDataValues(std::string fkdt) = 0;
 
   //! Get the total integrated flux between this samples energy range
@@ -213,7 +218,17 @@ public:
 
   virtual MeasurementVariableBox* GetBox();
 
+  /// Forget the current box if it is box. Used before deleting cached
+  /// signal boxes this sample may have last been filled from.
+  inline void ReleaseBox(MeasurementVariableBox* box) {
+    if (fEventVariables == box) fEventVariables = NULL;
+  };
+
   void FillHistogramsFromBox(MeasurementVariableBox* var, double weight);
+
+  ///! MC histogram bin a cached signal box would be filled into, -1 if the
+  /// sample has no single binning. Used to stratify event subsamples.
+  virtual int GetBoxBin(MeasurementVariableBox* var) { (void)var; return -1; };
   /*
     Histogram Access Functions
   */
@@ -239,6 +254,8 @@ public:
   InputHandlerBase* GetInput(void);
 
   std::string GetName(void) { return fName; };
+  //! Cached timer handle for one TimingUtils category of this sample
+  int GetTimer(int category) { return fTimers.ID(category); };
   double GetScaleFactor(void) { return fScaleFactor; };
 
   double GetXVar(void) { return fXVar; };
@@ -312,6 +329,70 @@ protected:
   std::string fName; //!< Name of the sample
   int fEventType;
 
+  TimingUtils::TimerSet fTimers; //!< Hot-path timers keyed by fName
+
+  //! Bumped whenever the covariance matrices are changed in place, so
+  //! caches keyed on it (CovarCache, ThrowCache) refresh. Replaced matrices
+  //! are picked up from StatUtils::GetMatrixSerial, but samples that edit
+  //! their covariance elements after construction must increment it.
+  int fCovarVersion;
+
+  //! Data and covariance helpers of Measurement1D/2D that can be queued
+  enum DataLoadKind {
+    kLoadDataText,
+    kLoadDataRoot,
+    kLoadDataValuesText,
+    kLoadDataErrorsText,
+    kLoadMapText,
+    kLoadPoissonErrors,
+    kLoadDiagonalCovar,
+    kLoadCovarText,
+    kLoadCovarMultiText,
+    kLoadCovarRoot,
+    kLoadCovarInvertText,
+    kLoadCovarInvertRoot,
+    kLoadCorrText,
+    kLoadCorrMultiText,
+    kLoadCorrRoot,
+    kLoadCholText,
+    kLoadCholRoot,
+    kLoadShapeCovar,
+    kLoadScaleData,
+    kLoadScaleDataErrors,
+    kLoadScaleCovar
+  };
+
+  //! One queued helper call and its arguments
+  struct DataLoad {
+    DataLoadKind kind;
+    std::string file;
+    std::string name;
+    std::string extra;
+    int dim;
+    double scale;
+  };
+
+  //! Queue a data or covariance helper call for LoadData. Returns false if
+  //! the helper should run now, i.e. when fDeferLoading is not set or
+  //! LoadData is already running the queue.
+  bool DeferLoad(DataLoadKind kind, std::string const &file = "",
+                 std::string const &name = "", int dim = -1,
+                 double scale = 1.0, std::string const &extra = "");
+
+  //! Run the queued helper calls in order. Called at the start of
+  //! FinaliseMeasurement, and by helpers that cannot be queued.
+  void LoadData();
+
+  //! Run one queued helper call, implemented by Measurement1D/2D
+  virtual void RunDataLoad(DataLoad const &load);
+
+  //! Set in a sample constructor, before any data is set, to queue the
+  //! data and covariance helpers until FinaliseMeasurement. The constructor
+  //! must then not touch the data or covariance itself before finalising.
+  bool fDeferLoading;
+  bool fLoadingData; //!< LoadData is running the queue
+  std::vector<DataLoad> fDataLoads;
+
   double fBeamDistance;  //!< Incoming Particle flight distance (for oscillation
   //! analysis)
   double fScaleFactor;   //!< fScaleFactor applied to events to convert from
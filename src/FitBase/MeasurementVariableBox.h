@@ -6,13 +6,17 @@ class MeasurementVariableBox {
 public:
   
   MeasurementVariableBox() {};
-  ~MeasurementVariableBox() {};
+  virtual ~MeasurementVariableBox() {};
 
   virtual void Reset();
   virtual void FillBoxFromEvent(FitEvent* evt);
   virtual MeasurementVariableBox* CloneSignalBox();
   virtual void Print();
 
+  /// Approximate heap footprint of this box in bytes. Boxes holding extra
+  /// members or containers should override this for memory accounting.
+  inline virtual size_t GetMemorySize(){ return sizeof(*this); };
+
   virtual double GetX();
   virtual double GetY();
   virtual double GetZ();
@@ -12,6 +12,7 @@ public:
   virtual void FillBoxFromEvent(FitEvent* evt);
   virtual MeasurementVariableBox* CloneSignalBox();
   virtual void Print();
+  inline virtual size_t GetMemorySize(){ return sizeof(*this); };
 
   virtual double GetX();
   virtual double GetY();
@@ -32,6 +32,7 @@ ParamPull::ParamPull(std::string name, std::string inputfile, std::string type,
   fName = name;
   fInput = inputfile;
   fType = type;
+  fTimers.SetOwner(&fName);
 
   // Set the pull type
   SetType(fType);
@@ -193,6 +194,7 @@ void ParamPull::SetupHistograms(std::string input) {
   // Sort Covariances
   fInvCovar = StatUtils::GetInvert(fCovar);
   fDecomp = StatUtils::GetDecomp(fCovar);
+  SetupDenseMatrices();
 
   // Create DataTrue for Throws
   fDataTrue = (TH1D *)fDataHist->Clone();
@@ -558,24 +560,43 @@ bool ParamPull::CheckDialsValid() {
 }
 
 //*******************************************************************************
-void ParamPull::Reconfigure() {
+void ParamPull::SetupDenseMatrices() {
   //*******************************************************************************
 
-  FitWeight *rw = FitBase::GetRW();
+  // Plain arrays of the inverse and of the transposed decomposition, so the
+  // pull, its gradient and the throws run over contiguous rows without the
+  // 1E76 rescaling that GetChi2FromCov applies to generic samples.
+  int n = fInvCovar->GetNrows();
+  fInvCovarDense.resize(n * n);
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) {
+      fInvCovarDense[i * n + j] = (*fInvCovar)(i, j);
+    }
+  }
 
-  // Get Dial Names that are valid
-  std::vector<std::string> namevec = rw->GetDialNames();
-  std::vector<double> valuevec = rw->GetDialValues();
+  int nd = fDecomp->GetNrows();
+  fDecompDenseT.resize(nd * nd);
+  for (int i = 0; i < nd; i++) {
+    for (int j = 0; j < nd; j++) {
+      fDecompDenseT[i * nd + j] = (*fDecomp)(j, i);
+    }
+  }
+}
 
-  // Set Bin Values from RW
+//*******************************************************************************
+void ParamPull::BuildDialMap(std::vector<std::string> const &namevec) {
+  //*******************************************************************************
+
+  fDialNames = namevec;
+  fBinDials.assign(fMCHist->GetNbinsX(), -1);
+
+  // Later dials override earlier ones, as when setting the bins directly
   for (UInt_t i = 0; i < namevec.size(); i++) {
 
     // Loop over bins and check name matches
     std::string syst = namevec.at(i);
-    double systval = valuevec.at(i);
     std::vector<std::string> allsyst = GeneralUtils::ParseToStr(syst, ",");
 
-    // Proper Reconf using RW
     for (int j = 0; j < fMCHist->GetNbinsX(); j++) {
 
       // Search for the name of this bin in the corrent dial
@@ -584,7 +605,7 @@ void ParamPull::Reconfigure() {
 
       // Check Full Name
       if (!syst.compare(binname.c_str())) {
-        fMCHist->SetBinContent(j + 1, systval);
+        fBinDials[j] = i;
         break;
       }
 
@@ -594,12 +615,36 @@ void ParamPull::Reconfigure() {
         std::string singlebinname = splitbinname[l];
         for (size_t k = 0; k < allsyst.size(); k++) {
           if (!allsyst[k].compare(singlebinname.c_str())) {
-            fMCHist->SetBinContent(j + 1, systval);
+            fBinDials[j] = i;
           }
         }
       }
     }
   }
+}
+
+//*******************************************************************************
+void ParamPull::Reconfigure() {
+  //*******************************************************************************
+
+  FitWeight *rw = FitBase::GetRW();
+
+  // Get Dial Names that are valid
+  std::vector<std::string> namevec = rw->GetDialNames();
+  std::vector<double> valuevec = rw->GetDialValues();
+
+  // Name matching only needs redoing when the dial list changes
+  if (namevec != fDialNames ||
+      (int)fBinDials.size() != fMCHist->GetNbinsX()) {
+    BuildDialMap(namevec);
+  }
+
+  // Set Bin Values from RW
+  for (int j = 0; j < fMCHist->GetNbinsX(); j++) {
+    if (fBinDials[j] < 0)
+      continue;
+    fMCHist->SetBinContent(j + 1, valuevec.at(fBinDials[j]));
+  }
 
   return;
 };
@@ -674,8 +719,7 @@ double ParamPull::GetLikelihood() {
 
   // Gaussian Calculation with correlations
   case kGausPull:
-    like = StatUtils::GetChi2FromCov(fDataHist, fMCHist, fInvCovar, NULL);
-    like *= 1E-76;
+    like = CalcGausPull(NULL);
     break;
 
   // Default says this has no pull
@@ -689,6 +733,89 @@ double ParamPull::GetLikelihood() {
   return like;
 };
 
+//*******************************************************************************
+double ParamPull::CalcGausPull(std::vector<double> *mcgrad) {
+  //*******************************************************************************
+
+  int n = fInvCovar->GetNrows();
+  if (fDataHist->GetNbinsX() != n || fMCHist->GetNbinsX() < n) {
+    NUIS_ERR(FTL, "Pull " << fName << " has " << fDataHist->GetNbinsX()
+                          << " data bins and " << fMCHist->GetNbinsX()
+                          << " MC bins for a " << n << " x " << n
+                          << " covariance.");
+    NUIS_ABORT("Mismatched pull histograms and covariance.");
+  }
+
+  double const *data = fDataHist->GetArray() + 1;
+  double const *mc = fMCHist->GetArray() + 1;
+  bool svd = StatUtils::GetOptions().UseSVDInverse;
+
+  // Rows with an empty data or MC entry are left out, as in
+  // StatUtils::GetChi2FromCov
+  fResidual.resize(n);
+  fActiveRows.resize(n);
+  for (int i = 0; i < n; i++) {
+    fResidual[i] = data[i] - mc[i];
+    fActiveRows[i] = (data[i] != 0.0 && mc[i] != 0.0);
+    if (fActiveRows[i] && !svd && fInvCovarDense[i * n + i] < 0.0) {
+      NUIS_ERR(FTL, "Negative diagonal in the inverse covariance of pull "
+                        << fName << " at bin " << i + 1 << " : "
+                        << fInvCovarDense[i * n + i]);
+      NUIS_ABORT("Inverse covariance is not positive definite.");
+    }
+  }
+
+  // chi2 = sum_i r_i (Cinv r)_i over the active rows
+  double chi2 = 0.0;
+  fPullRows.assign(n, 0.0);
+  for (int i = 0; i < n; i++) {
+    if (!fActiveRows[i])
+      continue;
+    double const *row = &fInvCovarDense[i * n];
+    double sum = 0.0;
+    for (int j = 0; j < n; j++) {
+      sum += row[j] * fResidual[j];
+    }
+    fPullRows[i] = sum;
+    chi2 += fResidual[i] * sum;
+  }
+
+  // d chi2 / d mc_k = -(Cinv r)_k [k active] - sum_{i active} Cinv_ik r_i
+  if (mcgrad) {
+    mcgrad->assign(n, 0.0);
+    for (int k = 0; k < n; k++) {
+      double const *row = &fInvCovarDense[k * n];
+      double sum = 0.0;
+      for (int i = 0; i < n; i++) {
+        if (fActiveRows[i])
+          sum += row[i] * fResidual[i];
+      }
+      (*mcgrad)[k] = -(sum + fPullRows[k]);
+    }
+  }
+
+  return chi2;
+}
+
+//*******************************************************************************
+void ParamPull::AddDialGradient(std::vector<double> &grad) {
+  //*******************************************************************************
+
+  if (fCalcType != kGausPull)
+    return;
+
+  std::vector<double> mcgrad;
+  CalcGausPull(&mcgrad);
+
+  // Each bin only moves with the dial mapped to it in Reconfigure
+  for (size_t j = 0; j < mcgrad.size() && j < fBinDials.size(); j++) {
+    int idial = fBinDials[j];
+    if (idial < 0 || idial >= (int)grad.size())
+      continue;
+    grad[idial] += mcgrad[j];
+  }
+}
+
 //*******************************************************************************
 int ParamPull::GetNDOF() {
   //*******************************************************************************
@@ -747,8 +874,9 @@ void ParamPull::ThrowCovariance() {
     double binmod = 0.0;
 
     if (fThrowType == kGausThrow) {
+      double const *col = &fDecompDenseT[i * fDecomp->GetNrows()];
       for (int j = 0; j < fDataHist->GetNbinsX(); j++) {
-        binmod += (*fDecomp)(j, i) * randthrows.at(j);
+        binmod += col[j] * randthrows.at(j);
       }
     } else if (fThrowType == kFlatThrow) {
       binmod = randthrows.at(i) - fDataHist->GetBinContent(i + 1);
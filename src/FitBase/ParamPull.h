@@ -50,6 +50,7 @@
 #include "FitWeight.h"
 #include "FitLogger.h"
 #include "EventManager.h"
+#include "TimingUtils.h"
 #include "TVector.h"
 
 using namespace std;
@@ -102,6 +103,11 @@ class ParamPull {
   //! Get likelihood given the current values
   double GetLikelihood(void);
 
+  //! Add the derivative of GetLikelihood w.r.t. each reweight dial value,
+  //! indexed as FitWeight::GetDialNames, to grad. Uses the current MC, so
+  //! Reconfigure must have been called.
+  void AddDialGradient(std::vector<double>& grad);
+
   //! Get NDOF if used in likelihoods
   int GetNDOF(void);
   
@@ -140,6 +146,9 @@ class ParamPull {
   inline std::string GetFileType    (void) const { return fFileType;    };
   inline std::string GetDialOptions (void) const { return fDialOptions; };
 
+  //! Cached timer handle for one TimingUtils category of this pull
+  inline int GetTimer(int category) { return fTimers.ID(category); };
+
   std::map<std::string, int> GetAllDials();
   
   inline TH1D GetDataHist  (void) const { return *fDataHist; };
@@ -155,6 +164,17 @@ class ParamPull {
  private:
 
   void CheckHist(TH1D*);
+
+  //! Copy the inverse and decomposition into the dense arrays
+  void SetupDenseMatrices(void);
+
+  //! Map each bin to the reweight dial that sets it in Reconfigure
+  void BuildDialMap(std::vector<std::string> const& namevec);
+
+  //! Correlated gaussian pull from the dense inverse. If mcgrad is given it
+  //! is filled with the derivative w.r.t. each MC bin.
+  double CalcGausPull(std::vector<double>* mcgrad);
+
   TH1D RemoveBinsNotInString(TH1D hist, std::string mystr);
   TH1I RemoveBinsNotInString(TH1I hist, std::string mystr);
   
@@ -165,6 +185,7 @@ class ParamPull {
   std::string fPlotTitles;  //! Axis format
   std::string fDialOptions; //!< Dial handling options
   std::string fDialSelection; //!< Dial Selection
+  TimingUtils::TimerSet fTimers; //!< Timers keyed by fName
   
   TH1D* fMCHist;    //!< Current MC Histogram
   TH1D* fDataHist;  //!< Current data Histogram
@@ -181,6 +202,15 @@ class ParamPull {
   TMatrixDSym* fInvCovar; //!< Inverted Covariance
   TMatrixDSym* fDecomp;   //!< Decomposition
 
+  std::vector<double> fInvCovarDense; //!< Row-major fInvCovar
+  std::vector<double> fDecompDenseT;  //!< Row-major transpose of fDecomp
+  std::vector<double> fResidual;      //!< Data - MC scratch
+  std::vector<double> fPullRows;      //!< fInvCovar * residual scratch
+  std::vector<char> fActiveRows;      //!< Rows included in the pull
+
+  std::vector<std::string> fDialNames; //!< Dial list fBinDials was built for
+  std::vector<int> fBinDials; //!< Dial index setting each bin, -1 if none
+
   TH1D* fLimitHist;
   
 };
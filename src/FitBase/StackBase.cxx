@@ -1,5 +1,8 @@
 #include "StackBase.h"
 
+#include <algorithm>
+#include <cmath>
+
 void StackBase::AddMode(std::string name, std::string title, int linecolor,
                         int linewidth, int fillstyle) {
 
@@ -17,6 +20,9 @@ void StackBase::AddMode(std::string name, std::string title, int linecolor,
 
 void StackBase::FluxUnfold(TH1D *flux, TH1D *events, double scalefactor,
                            int nevents) {
+  // The 2D scaling depends on the projected contents, so work on the hists
+  SyncHists();
+  fDenseValid = false;
   for (size_t i = 0; i < fAllLabels.size(); i++) {
     if (fNDim == 1) {
       PlotUtils::FluxUnfoldedScaling((TH1D *)fAllHists[i], flux, events,
@@ -69,23 +75,129 @@ void StackBase::SetupStack(TH1 *hist) {
   fYTitle = hist->GetYaxis()->GetTitle();
   fZTitle = hist->GetZaxis()->GetTitle();
 
-  for (size_t i = 0; i < fAllLabels.size(); i++) {
-    fAllHists.push_back(
-        (TH1 *)fTemplate->Clone((fName + "_" + fAllLabels[i]).c_str()));
-  }
+  // Per category hists are only built when first needed
+  fAllHists.assign(fAllLabels.size(), NULL);
+  fUseSumw2 = (fTemplate->GetSumw2N() > 0);
+  SetupDense();
 };
 
+void StackBase::SetupDense() {
+  fNCells = fTemplate->GetNcells();
+
+  fCellWidths.assign(fNCells, 1.0);
+  for (int i = 0; i < fNCells; i++) {
+    int binx, biny, binz;
+    fTemplate->GetBinXYZ(i, binx, biny, binz);
+    fCellWidths[i] = fTemplate->GetXaxis()->GetBinWidth(binx);
+    if (fNDim > 1)
+      fCellWidths[i] *= fTemplate->GetYaxis()->GetBinWidth(biny);
+    if (fNDim > 2)
+      fCellWidths[i] *= fTemplate->GetZaxis()->GetBinWidth(binz);
+  }
+
+  fDenseContent.assign(fAllHists.size() * fNCells, 0.0);
+  fDenseSumw2.assign(fAllHists.size() * fNCells, 0.0);
+  fDenseEntries.assign(fAllHists.size(), 0.0);
+  fDenseValid = true;
+  fHistsValid = false;
+}
+
+void StackBase::SyncHists() {
+  if (fHistsValid)
+    return;
+
+  for (size_t i = 0; i < fAllHists.size(); i++) {
+    if (!fAllHists[i]) {
+      fAllHists[i] =
+          (TH1 *)fTemplate->Clone((fName + "_" + fAllLabels[i]).c_str());
+    }
+
+    TH1 *hist = fAllHists[i];
+    hist->Reset();
+    if (fUseSumw2 and !hist->GetSumw2N())
+      hist->Sumw2();
+
+    double const *content = &fDenseContent[i * fNCells];
+    double const *sumw2 = &fDenseSumw2[i * fNCells];
+    for (int j = 0; j < fNCells; j++) {
+      hist->SetBinContent(j, content[j]);
+    }
+    if (hist->GetSumw2N()) {
+      std::copy(sumw2, sumw2 + fNCells, hist->GetSumw2()->GetArray());
+    }
+
+    hist->ResetStats();
+    hist->SetEntries(fDenseEntries[i]);
+  }
+
+  fHistsValid = true;
+}
+
+void StackBase::SyncDense() {
+  if (fDenseValid)
+    return;
+
+  fDenseContent.resize(fAllHists.size() * fNCells);
+  fDenseSumw2.resize(fAllHists.size() * fNCells);
+  fDenseEntries.resize(fAllHists.size());
+
+  for (size_t i = 0; i < fAllHists.size(); i++) {
+    TH1 *hist = fAllHists[i];
+    fUseSumw2 = fUseSumw2 or (hist->GetSumw2N() > 0);
+
+    for (int j = 0; j < fNCells; j++) {
+      double content = hist->GetBinContent(j);
+      fDenseContent[i * fNCells + j] = content;
+      fDenseSumw2[i * fNCells + j] = hist->GetSumw2N()
+                                         ? hist->GetSumw2()->At(j)
+                                         : std::fabs(content);
+    }
+    fDenseEntries[i] = hist->GetEntries();
+  }
+
+  fDenseValid = true;
+}
+
+int StackBase::GetDenseCell(int binx, int biny, int binz) {
+  if (fNDim == 1)
+    return fTemplate->GetBin(binx);
+  else if (fNDim == 2)
+    return fTemplate->GetBin(binx, biny);
+  return fTemplate->GetBin(binx, biny, binz);
+}
+
 void StackBase::Scale(double sf, std::string opt) {
-  for (size_t i = 0; i < fAllLabels.size(); i++) {
-    // std::cout << "Scaling Stack Hist " << i << " by " << sf << std::endl;
-    fAllHists[i]->Scale(sf, opt.c_str());
+  SyncDense();
+
+  bool width = (opt.find("width") != std::string::npos or
+                opt.find("WIDTH") != std::string::npos);
+  if (sf != 1.0 or width)
+    fUseSumw2 = true;
+
+  size_t ncats = fDenseEntries.size();
+  for (size_t i = 0; i < ncats; i++) {
+    double *content = &fDenseContent[i * fNCells];
+    double *sumw2 = &fDenseSumw2[i * fNCells];
+    for (int j = 0; j < fNCells; j++) {
+      double cellsf = sf;
+      if (width and fCellWidths[j] != 0.0)
+        cellsf /= fCellWidths[j];
+      content[j] *= cellsf;
+      sumw2[j] *= cellsf * cellsf;
+    }
   }
+  fHistsValid = false;
 };
 
 void StackBase::Reset() {
-  for (size_t i = 0; i < fAllLabels.size(); i++) {
-    fAllHists[i]->Reset();
-  }
+  std::fill(fDenseContent.begin(), fDenseContent.end(), 0.0);
+  std::fill(fDenseSumw2.begin(), fDenseSumw2.end(), 0.0);
+  std::fill(fDenseEntries.begin(), fDenseEntries.end(), 0.0);
+  fDenseContent.resize(fAllHists.size() * fNCells, 0.0);
+  fDenseSumw2.resize(fAllHists.size() * fNCells, 0.0);
+  fDenseEntries.resize(fAllHists.size(), 0.0);
+  fDenseValid = true;
+  fHistsValid = false;
 };
 
 void StackBase::FillStack(int index, double x, double y, double z,
@@ -96,16 +208,29 @@ void StackBase::FillStack(int index, double x, double y, double z,
     return;
   }
 
-  if (fNDim == 1)
-    fAllHists[index]->Fill(x, y);
-  else if (fNDim == 2) {
-    // std::cout << "Filling 2D Stack " << index << " " << x << " " << y << " "
-    // << z << std::endl;
-    ((TH2 *)fAllHists[index])->Fill(x, y, z);
+  SyncDense();
+
+  // Same argument conventions as the TH1/TH2/TH3 Fill calls this replaces
+  int cell = 0;
+  double w = weight;
+  if (fNDim == 1) {
+    cell = fTemplate->FindFixBin(x);
+    w = y;
+  } else if (fNDim == 2) {
+    cell = fTemplate->FindFixBin(x, y);
+    w = z;
+  } else if (fNDim == 3) {
+    cell = fTemplate->FindFixBin(x, y, z);
   }
 
-  else if (fNDim == 3)
-    ((TH3 *)fAllHists[index])->Fill(x, y, z, weight);
+  size_t pos = index * fNCells + cell;
+  fDenseContent[pos] += w;
+  fDenseSumw2[pos] += w * w;
+  fDenseEntries[index] += 1.0;
+  if (w != 1.0)
+    fUseSumw2 = true;
+
+  fHistsValid = false;
 }
 
 void StackBase::SetBinContentStack(int index, int binx, int biny, int binz,
@@ -116,13 +241,15 @@ void StackBase::SetBinContentStack(int index, int binx, int biny, int binz,
     return;
   }
 
-  if (fNDim == 1) {
-    fAllHists[index]->SetBinContent(binx, content);
-  } else if (fNDim == 2) {
-    ((TH2 *)fAllHists[index])->SetBinContent(binx, biny, content);
-  } else if (fNDim == 3) {
-    ((TH3 *)fAllHists[index])->SetBinContent(binx, biny, binz, content);
-  }
+  SyncDense();
+
+  size_t pos = index * fNCells + GetDenseCell(binx, biny, binz);
+  fDenseContent[pos] = content;
+  if (!fUseSumw2)
+    fDenseSumw2[pos] = std::fabs(content);
+  fDenseEntries[index] += 1.0;
+
+  fHistsValid = false;
 }
 
 void StackBase::SetBinErrorStack(int index, int binx, int biny, int binz,
@@ -133,18 +260,21 @@ void StackBase::SetBinErrorStack(int index, int binx, int biny, int binz,
     return;
   }
 
-  if (fNDim == 1) {
-    fAllHists[index]->SetBinError(binx, error);
-  } else if (fNDim == 2) {
-    ((TH2 *)fAllHists[index])->SetBinError(binx, biny, error);
-  } else if (fNDim == 3) {
-    ((TH3 *)fAllHists[index])->SetBinError(binx, biny, binz, error);
-  }
+  SyncDense();
+
+  size_t pos = index * fNCells + GetDenseCell(binx, biny, binz);
+  fDenseSumw2[pos] = error * error;
+  fUseSumw2 = true;
+
+  fHistsValid = false;
 }
 
 void StackBase::Write() {
   THStack *st = new THStack();
 
+  // Only point the per category hists are needed
+  SyncHists();
+
   // Loop and add all histograms
   bool saveseparate = FitPar::Config().GetParB("WriteSeparateStacks");
   for (size_t i = 0; i < fAllLabels.size(); i++) {
@@ -175,18 +305,24 @@ void StackBase::Write() {
 };
 
 void StackBase::Multiply(TH1 *hist) {
+  SyncHists();
+  fDenseValid = false;
   for (size_t i = 0; i < fAllLabels.size(); i++) {
     fAllHists[i]->Multiply(hist);
   }
 }
 
 void StackBase::Divide(TH1 *hist) {
+  SyncHists();
+  fDenseValid = false;
   for (size_t i = 0; i < fAllLabels.size(); i++) {
     fAllHists[i]->Divide(hist);
   }
 }
 
 void StackBase::Add(TH1 *hist, double scale) {
+  SyncHists();
+  fDenseValid = false;
   for (size_t i = 0; i < fAllLabels.size(); i++) {
     fAllHists[i]->Add(hist, scale);
   }
@@ -201,15 +337,38 @@ void StackBase::Add(StackBase *hist, double scale) {
     return;
   }
 
-  for (size_t i = 0; i < fAllLabels.size(); i++) {
-    fAllHists[i]->Add(hist->GetHist(i));
+  // Same type means same categories, add the dense arrays directly
+  SyncDense();
+  hist->SyncDense();
+  if (hist->fNCells != fNCells or
+      hist->fDenseContent.size() != fDenseContent.size()) {
+    NUIS_ERR(WRN, "Trying to add StackBases with different binning!");
+    NUIS_ERR(WRN, "Doing nothing...");
+    return;
+  }
+
+  for (size_t i = 0; i < fDenseContent.size(); i++) {
+    fDenseContent[i] += scale * hist->fDenseContent[i];
+    fDenseSumw2[i] += scale * scale * hist->fDenseSumw2[i];
+  }
+  for (size_t i = 0; i < fDenseEntries.size(); i++) {
+    fDenseEntries[i] += hist->fDenseEntries[i];
   }
+  fUseSumw2 = fUseSumw2 or hist->fUseSumw2 or scale != 1.0;
+  fHistsValid = false;
 }
 
-TH1 *StackBase::GetHist(int entry) { return fAllHists[entry]; }
+TH1 *StackBase::GetHist(int entry) {
+  // Callers may modify the returned hist
+  SyncHists();
+  fDenseValid = false;
+  return fAllHists[entry];
+}
 
 TH1 *StackBase::GetHist(std::string label) {
 
+  SyncHists();
+
   TH1 *hist = NULL;
   std::vector<std::string> splitlabels = GeneralUtils::ParseToStr(label, "+");
   for (size_t j = 0; j < splitlabels.size(); j++) {
@@ -229,6 +388,8 @@ TH1 *StackBase::GetHist(std::string label) {
 }
 
 THStack StackBase::GetStack() {
+  SyncHists();
+  fDenseValid = false;
   THStack st = THStack();
   for (size_t i = 0; i < fAllLabels.size(); i++) {
     st.Add(fAllHists[i]);
@@ -237,11 +398,22 @@ THStack StackBase::GetStack() {
 }
 
 void StackBase::AddNewHist(std::string name, TH1 *hist) {
+  if (!fTemplate) {
+    fTemplate = (TH1 *)hist->Clone(fName.c_str());
+    fTemplate->Reset();
+    fNDim = fTemplate->GetDimension();
+    SetupDense();
+  }
+
+  SyncHists();
+  fDenseValid = false;
   AddMode(fAllLabels.size(), name, hist->GetTitle(), hist->GetLineColor());
   fAllHists.push_back((TH1 *)hist->Clone());
 }
 
 void StackBase::AddToCategory(std::string name, TH1 *hist) {
+  SyncHists();
+  fDenseValid = false;
 
   for (size_t i = 0; i < fAllLabels.size(); i++) {
     if (name == fAllLabels[i]) {
@@ -252,5 +424,7 @@ void StackBase::AddToCategory(std::string name, TH1 *hist) {
 }
 
 void StackBase::AddToCategory(int index, TH1 *hist) {
+  SyncHists();
+  fDenseValid = false;
   fAllHists[index]->Add(hist);
 }
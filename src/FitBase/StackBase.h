@@ -13,9 +13,15 @@
 
 #include "PlotUtils.h"
 
+/// Mode stacks keep every category in one dense (category x cell) array
+/// that FillStack, Scale and Reset work on directly. The per category TH1s
+/// in fAllHists are only built, or brought up to date, when something asks
+/// for a histogram (Write, GetHist, GetStack, TH1 arithmetic).
 class StackBase {
 public:
-  StackBase(){};
+  StackBase()
+      : fTemplate(NULL), fNDim(0), fNCells(0), fDenseValid(true),
+        fHistsValid(true), fUseSumw2(false){};
   ~StackBase(){};
 
   virtual void AddMode(std::string name, std::string title, int linecolor = 1,
@@ -74,6 +80,25 @@ public:
   std::vector<std::string> fAllTitles;
   std::vector<std::string> fAllLabels;
   std::vector<TH1 *> fAllHists;
+
+protected:
+  /// Size the dense arrays from fTemplate
+  void SetupDense();
+  /// Copy the dense arrays into fAllHists, building them if needed
+  void SyncHists();
+  /// Copy fAllHists back into the dense arrays
+  void SyncDense();
+  /// Global cell of a bin, as TH1::GetBin on the template
+  int GetDenseCell(int binx, int biny, int binz);
+
+  int fNCells; ///< Cells per category, including under/overflow
+  std::vector<double> fCellWidths;   ///< Bin width/area/volume per cell
+  std::vector<double> fDenseContent; ///< [category * fNCells + cell]
+  std::vector<double> fDenseSumw2;   ///< Sum of squared weights, same layout
+  std::vector<double> fDenseEntries; ///< Entries per category
+  bool fDenseValid; ///< Dense arrays hold the current contents
+  bool fHistsValid; ///< fAllHists hold the current contents
+  bool fUseSumw2;   ///< Materialised hists need Sumw2 errors
 };
 
 /*
@@ -21,6 +21,13 @@
 #include "FitParticle.h"
 #include "GIBUUInputHandler.h"
 
+#include <atomic>
+
+namespace {
+// Events are built on reweighting and input threads
+std::atomic<UInt_t> gNextEventID(0);
+}
+
 BaseFitEvt::BaseFitEvt() {
   Mode = 0;
   probe_E = 0xdeadbeef;
@@ -41,6 +48,9 @@ BaseFitEvt::BaseFitEvt() {
   fGenInfo = NULL;
   fType = 9999;
 
+  fEntry = -1;
+  fEventID = gNextEventID++;
+
 #if defined(NEUT_ENABLED) || defined(NEUT_EVENT_ENABLED)
   fNeutVect = NULL;
 #endif
@@ -110,6 +120,9 @@ BaseFitEvt::BaseFitEvt(const BaseFitEvt *obj) {
   fGenInfo = obj->fGenInfo;
   fType = obj->fType;
 
+  fEntry = obj->fEntry;
+  fEventID = gNextEventID++;
+
 #if defined(NEUT_ENABLED) || defined(NEUT_EVENT_ENABLED)
   fNeutVect = obj->fNeutVect;
 #endif
@@ -151,6 +164,9 @@ BaseFitEvt::BaseFitEvt(BaseFitEvt const &other) {
   fGenInfo = other.fGenInfo;
   fType = other.fType;
 
+  fEntry = other.fEntry;
+  fEventID = gNextEventID++;
+
 #if defined(NEUT_ENABLED) || defined(NEUT_EVENT_ENABLED)
   fNeutVect = other.fNeutVect;
 #endif
@@ -192,6 +208,9 @@ BaseFitEvt BaseFitEvt::operator=(BaseFitEvt const &other) {
   fGenInfo = other.fGenInfo;
   fType = other.fType;
 
+  // Our ID may already have cached quantities for another input's entries
+  fEntry = -1;
+
 #if defined(NEUT_ENABLED) || defined(NEUT_EVENT_ENABLED)
   fNeutVect = other.fNeutVect;
 #endif
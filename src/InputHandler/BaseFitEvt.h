@@ -98,6 +98,10 @@ class BaseFitEvt {
   GeneratorInfoBase* fGenInfo; ///< Generator Variable Box
   UInt_t fType; ///< Generator Event Type
 
+  // Entry Info, lets weight calcs cache per-entry quantities across reads
+  int fEntry; ///< Input entry last read into this event, -1 if unknown
+  UInt_t fEventID; ///< Unique for each event object, not copied
+
 #ifdef NEUT_ENABLED
   /// Setup Event Reading from NEUT Event
   void SetNeutVect(NeutVect* v);
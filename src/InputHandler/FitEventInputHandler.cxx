@@ -127,6 +127,7 @@ FitEvent *FitEventInputHandler::GetNuisanceEvent(const UInt_t entry,
     fNUISANCEEvent->fNParticles++;
   }
 
+  fNUISANCEEvent->fEntry = entry;
   // Setup Input scaling for joint inputs
   fNUISANCEEvent->InputWeight = GetInputWeight(entry);
 
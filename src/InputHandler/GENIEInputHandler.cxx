@@ -266,6 +266,7 @@ FitEvent *GENIEInputHandler::GetNuisanceEvent(const UInt_t ent,
 
   // Run NUISANCE Vector Filler
   if (!lightweight) {
+    TimingUtils::ScopedTimer timer(fTimers.ID(TimingUtils::kKinematics));
     CalcNUISANCEKinematics();
   }
 
@@ -301,6 +302,7 @@ FitEvent *GENIEInputHandler::GetNuisanceEvent(const UInt_t ent,
   }
 #endif
 
+  fNUISANCEEvent->fEntry = entry;
   // Setup Input scaling for joint inputs
   fNUISANCEEvent->InputWeight = GetInputWeight(entry);
 
@@ -139,6 +139,7 @@ FitEvent *GIBUUInputHandler::GetNuisanceEvent(const UInt_t ent,
 
   // Run NUISANCE Vector Filler
   if (!lightweight) {
+    TimingUtils::ScopedTimer timer(fTimers.ID(TimingUtils::kKinematics));
     CalcNUISANCEKinematics();
   }
 #ifdef Prob3plusplus_ENABLED
@@ -159,6 +160,7 @@ FitEvent *GIBUUInputHandler::GetNuisanceEvent(const UInt_t ent,
   }
 #endif
 
+  fNUISANCEEvent->fEntry = entry;
   fNUISANCEEvent->InputWeight *= GetInputWeight(entry);
   fNUISANCEEvent->GiRead = fGiReader;
 
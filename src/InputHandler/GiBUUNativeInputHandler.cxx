@@ -290,6 +290,7 @@ FitEvent *GiBUUNativeInputHandler::GetNuisanceEvent(const UInt_t ent,
 
   // Run NUISANCE Vector Filler
   if (!lightweight) {
+    TimingUtils::ScopedTimer timer(fTimers.ID(TimingUtils::kKinematics));
     CalcNUISANCEKinematics();
   }
 #ifdef Prob3plusplus_ENABLED
@@ -299,6 +300,7 @@ FitEvent *GiBUUNativeInputHandler::GetNuisanceEvent(const UInt_t ent,
   }
 #endif
 
+  fNUISANCEEvent->fEntry = entry;
   fNUISANCEEvent->InputWeight *= GetInputWeight(entry);
 
   return fNUISANCEEvent;
@@ -24,6 +24,7 @@
 #include "NUANCEInputHandler.h"
 #include "SigmaQ0HistogramInputHandler.h"
 #include "SplineInputHandler.h"
+#include "SyntheticInputHandler.h"
 
 #ifdef HepMC3_ENABLED
 #include "NuHepMCInputHandler.h"
@@ -129,6 +130,10 @@ InputHandlerBase *CreateInputHandler(std::string const &handle,
     input = new HistoInputHandler(handle, newinputs);
     break;
 
+  case (kSYNTHETIC_Input):
+    input = new SyntheticInputHandler(handle, newinputs);
+    break;
+
   default:
     break;
   }
@@ -35,6 +35,7 @@ InputHandlerBase::InputHandlerBase() {
   if (FitPar::Config().HasConfig("NSKIPEVENTS")) {
     fSkip = FitPar::Config().GetParI("NSKIPEVENTS");
   }
+  fTimers.SetOwner(&fName);
 };
 
 InputHandlerBase::~InputHandlerBase() {
@@ -167,11 +168,13 @@ std::vector<TH1 *> InputHandlerBase::GetXSecList(void) {
 };
 
 FitEvent *InputHandlerBase::FirstNuisanceEvent() {
+  TimingUtils::ScopedTimer timer(fTimers.ID(TimingUtils::kInputRead));
   fCurrentIndex = 0;
   return GetNuisanceEvent(fCurrentIndex);
 };
 
 FitEvent *InputHandlerBase::NextNuisanceEvent() {
+  TimingUtils::ScopedTimer timer(fTimers.ID(TimingUtils::kInputRead));
   fCurrentIndex++;
   if ((fMaxEvents != -1) && (fCurrentIndex > fMaxEvents)) {
     return NULL;
@@ -181,11 +184,13 @@ FitEvent *InputHandlerBase::NextNuisanceEvent() {
 };
 
 BaseFitEvt *InputHandlerBase::FirstBaseEvent() {
+  TimingUtils::ScopedTimer timer(fTimers.ID(TimingUtils::kInputRead));
   fCurrentIndex = 0;
   return GetBaseEvent(fCurrentIndex);
 };
 
 BaseFitEvt *InputHandlerBase::NextBaseEvent() {
+  TimingUtils::ScopedTimer timer(fTimers.ID(TimingUtils::kInputRead));
   fCurrentIndex++;
 
   if (jointinput and fMaxEvents != -1) {
@@ -24,6 +24,7 @@
  */
 #include "BaseFitEvt.h"
 #include "FitEvent.h"
+#include "TimingUtils.h"
 #include "TH1D.h"
 #include "TTreePerfStats.h"
 
@@ -130,6 +131,9 @@ public:
   bool kRemoveNuclearParticles;
   TTreePerfStats *fTTreePerformance;
   int fSkip;
+
+  /// Hot-path timers for this input, keyed by fName
+  TimingUtils::TimerSet fTimers;
 };
 /*! @} */
 #endif
@@ -59,6 +59,7 @@ enum InputType {
   kJOINT_Input,
   kSIGMAQ0HIST_Input,
   kHISTO_Input,
+  kSYNTHETIC_Input,
   kInvalid_Input,
   kBNSPLN_Input,  // Not sure if this are currently used.
 };
@@ -153,6 +154,9 @@ inline std::ostream &operator<<(std::ostream &os, InputUtils::InputType it) {
   case InputUtils::kHISTO_Input: {
     return os << "kHISTO_Input";
   }
+  case InputUtils::kSYNTHETIC_Input: {
+    return os << "kSYNTHETIC_Input";
+  }
   case InputUtils::kInvalid_Input:
   case InputUtils::kBNSPLN_Input:
   default: { return os << "kInvalid_Input"; }
@@ -39,7 +39,8 @@ InputType ParseInputType(std::string const &inp) {
   // The hard-coded list of supported input generators
   const static std::string filetypes[] = {
       "NEUT",   "NuWro", "GENIE",  "GiBUU", "NUANCE",      "NuHepMC",
-      "EVSPLN", "EMPTY", "FEVENT", "JOINT", "SIGMAQ0HIST", "HISTO"};
+      "EVSPLN", "EMPTY", "FEVENT", "JOINT", "SIGMAQ0HIST", "HISTO",
+      "SYNTHETIC"};
 
   size_t nInputTypes = GeneralUtils::GetArraySize(filetypes);
 
@@ -187,6 +187,7 @@ FitEvent *NEUTInputHandler::GetNuisanceEvent(const UInt_t ent,
 
   // Run NUISANCE Vector Filler
   if (!lightweight) {
+    TimingUtils::ScopedTimer timer(fTimers.ID(TimingUtils::kKinematics));
     CalcNUISANCEKinematics();
   }
 #ifdef Prob3plusplus_ENABLED
@@ -208,6 +209,7 @@ FitEvent *NEUTInputHandler::GetNuisanceEvent(const UInt_t ent,
   }
 #endif
 
+  fNUISANCEEvent->fEntry = entry;
   // Setup Input scaling for joint inputs
   fNUISANCEEvent->InputWeight = GetInputWeight(entry);
 
@@ -142,11 +142,13 @@ FitEvent *NUANCEInputHandler::GetNuisanceEvent(const UInt_t ent,
   // Read Entry from TTree to fill NEUT Vect in BaseFitEvt;
   fNUANCETree->GetEntry(entry);
 
+  fNUISANCEEvent->fEntry = entry;
   // Setup Input scaling for joint inputs
   fNUISANCEEvent->InputWeight = GetInputWeight(entry);
 
   // Run NUISANCE Vector Filler
   if (!lightweight) {
+    TimingUtils::ScopedTimer timer(fTimers.ID(TimingUtils::kKinematics));
     CalcNUISANCEKinematics();
   }
 
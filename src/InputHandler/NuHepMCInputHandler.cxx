@@ -238,6 +238,7 @@ FitEvent *NuHepMCInputHandler::GetNuisanceEvent(const UInt_t entry, bool) {
     return NULL;
   }
 
+  fNUISANCEEvent->fEntry = entry;
   // Setup Input scaling for joint inputs
   if (jointinput) {
     fNUISANCEEvent->InputWeight = GetInputWeight(entry);
@@ -246,7 +247,10 @@ FitEvent *NuHepMCInputHandler::GetNuisanceEvent(const UInt_t entry, bool) {
   }
 
   // Run NUISANCE Vector Filler
-  CalcNUISANCEKinematics();
+  {
+    TimingUtils::ScopedTimer timer(fTimers.ID(TimingUtils::kKinematics));
+    CalcNUISANCEKinematics();
+  }
 
   // Return event pointer
   return fNUISANCEEvent;
@@ -139,6 +139,7 @@ FitEvent *NuWroInputHandler::GetNuisanceEvent(const UInt_t ent,
 
   // Run NUISANCE Vector Filler
   if (!lightweight) {
+    TimingUtils::ScopedTimer timer(fTimers.ID(TimingUtils::kKinematics));
     CalcNUISANCEKinematics();
   }
 #ifdef Prob3plusplus_ENABLED
@@ -151,6 +152,7 @@ FitEvent *NuWroInputHandler::GetNuisanceEvent(const UInt_t ent,
     }
   }
 #endif
+  fNUISANCEEvent->fEntry = entry;
   // Setup Input scaling for joint inputs
   fNUISANCEEvent->InputWeight = GetInputWeight(entry);
   
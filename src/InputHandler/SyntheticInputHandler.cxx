@@ -0,0 +1,413 @@
+// Copyright 2016-2021 L. Pickering, P Stowell, R. Terri, C. Wilkinson, C. Wret
+
+/*******************************************************************************
+ *    This file is part of NUISANCE.
+ *
+ *    NUISANCE is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    NUISANCE is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with NUISANCE.  If not, see <http://www.gnu.org/licenses/>.
+ *******************************************************************************/
+#include "SyntheticInputHandler.h"
+
+#include "PhysConst.h"
+#include "TMath.h"
+
+SyntheticInputHandler::SyntheticInputHandler(std::string const &handle,
+                                             std::string const &rawinputs) {
+  NUIS_LOG(SAM, "Creating SyntheticInputHandler : " << handle);
+
+  fName = handle;
+
+  // Events are built directly as FitEvents
+  fEventType = kINPUTFITEVENT;
+
+  // Setup Defaults incase none given
+  fNEvents = 100000;
+  fSeed = 1;
+  fEnergy = 1.0;
+  fBeamPDG = 14;
+  fTargetA = 12;
+  fTargetZ = 6;
+
+  // SYNTHETIC:NEVENTS=100000,SEED=1,E=1.0,PDG=14,A=12,Z=6
+  std::vector<std::string> parsedinputs =
+      GeneralUtils::ParseToStr(rawinputs, ",");
+  for (size_t i = 0; i < parsedinputs.size(); i++) {
+    if (parsedinputs[i].empty())
+      continue;
+
+    std::vector<std::string> parsedspec =
+        GeneralUtils::ParseToStr(parsedinputs[i], "=");
+    if (parsedspec.size() < 2) {
+      NUIS_ABORT("NO VALUE GIVEN TO SPECIFIER : " << parsedinputs[i]);
+    }
+
+    std::string spec = parsedspec[0];
+    std::string value = parsedspec[1];
+
+    if (!spec.compare("NEVENTS") or !spec.compare("N")) {
+      fNEvents = GeneralUtils::StrToInt(value);
+    } else if (!spec.compare("SEED")) {
+      fSeed = GeneralUtils::StrToInt(value);
+    } else if (!spec.compare("ENERGY") or !spec.compare("E")) {
+      fEnergy = GeneralUtils::StrToDbl(value);
+    } else if (!spec.compare("PDG") or !spec.compare("BEAM")) {
+      fBeamPDG = GeneralUtils::StrToInt(value);
+    } else if (!spec.compare("A")) {
+      fTargetA = GeneralUtils::StrToInt(value);
+    } else if (!spec.compare("Z")) {
+      fTargetZ = GeneralUtils::StrToInt(value);
+    } else {
+      NUIS_ABORT("Unknown argument given to Synthetic InputHandler : "
+                 << spec);
+    }
+  }
+
+  if (fNEvents <= 0 or fEnergy <= 0.0) {
+    NUIS_ABORT("Synthetic InputHandler needs NEVENTS > 0 and E > 0!");
+  }
+
+  if (abs(fBeamPDG) != 12 and abs(fBeamPDG) != 14) {
+    NUIS_ABORT("Synthetic InputHandler only supports PDG=+-12,+-14 beams.");
+  }
+
+  // Flux peaked at fEnergy, cross-section rising linearly in 1E-38 cm2/GeV
+  fFluxHist = new TH1D((fName + "_FLUX").c_str(), (fName + "_FLUX").c_str(),
+                       100, 0.0, 5.0 * fEnergy);
+  fEventHist = new TH1D((fName + "_EVT").c_str(), (fName + "_EVT").c_str(),
+                        100, 0.0, 5.0 * fEnergy);
+  for (int i = 0; i < fFluxHist->GetNbinsX(); i++) {
+    double e = fFluxHist->GetXaxis()->GetBinCenter(i + 1);
+    double flux = e * e * exp(-2.0 * e / fEnergy);
+    fFluxHist->SetBinContent(i + 1, flux);
+    fEventHist->SetBinContent(i + 1, flux * 0.7 * e);
+  }
+  double fluxint = fFluxHist->Integral("width");
+  fFluxHist->Scale(1.0 / fluxint);
+  fEventHist->Scale(1.0 / fluxint);
+
+  // Build cumulative for the energy throws
+  fEventHist->ComputeIntegral();
+
+  fNUISANCEEvent = new FitEvent();
+  fNUISANCEEvent->HardReset();
+  fNUISANCEEvent->SetInputFitEvent();
+
+  Print();
+};
+
+FitEvent *SyntheticInputHandler::GetNuisanceEvent(const UInt_t entry,
+                                                  const bool lightweight) {
+  // Catch too large entries
+  if (entry >= (UInt_t)fNEvents)
+    return NULL;
+
+  FillEvent(fNUISANCEEvent, entry, lightweight);
+
+  fNUISANCEEvent->fEntry = entry;
+  // Setup Input scaling for joint inputs
+  fNUISANCEEvent->InputWeight = GetInputWeight(entry);
+
+  return fNUISANCEEvent;
+}
+
+void SyntheticInputHandler::FillEvent(FitEvent *event, const UInt_t entry,
+                                      const bool lightweight) {
+  // Seed from entry so random access is reproducible
+  UInt_t seed = UInt_t(fSeed) * 1000003u + entry + 1;
+  fRandom.SetSeed(seed ? seed : 1);
+
+  event->ResetEvent();
+  event->SetInputFitEvent();
+
+  double enu = ThrowEnergy() * 1.E3;
+  int mode = ThrowMode(enu);
+
+  event->Mode = mode;
+  event->fEventNo = entry;
+  event->fTargetA = fTargetA;
+  event->fTargetZ = fTargetZ;
+  event->fTargetH = 0;
+  event->fBound = (fTargetA > 1);
+  event->probe_E = enu;
+  event->probe_pdg = fBeamPDG;
+  event->InputWeight = 1.0;
+
+  if (lightweight)
+    return;
+
+  TimingUtils::ScopedTimer timer(fTimers.ID(TimingUtils::kKinematics));
+
+  const double mN = PhysConst::mass_nucleon * 1.E3;
+  const double mpi = PhysConst::mass_cpi * 1.E3;
+  bool nubar = (fBeamPDG < 0);
+  bool iscc = (abs(mode) < 30);
+  int sign = nubar ? -1 : 1;
+  int proton = 2212;
+  int neutron = 2112;
+
+  // Outgoing lepton
+  int leppdg = iscc ? fBeamPDG - sign : fBeamPDG;
+  double mlep = 0.0;
+  if (abs(leppdg) == 11)
+    mlep = PhysConst::mass_electron * 1.E3;
+  else if (abs(leppdg) == 13)
+    mlep = PhysConst::mass_muon * 1.E3;
+
+  // Initial and final hadrons for each channel. Charges follow the nu case
+  // and are swapped for nubar.
+  std::vector<int> inhad;
+  std::vector<int> outhad;
+  switch (abs(mode)) {
+  case 1:
+    inhad.push_back(nubar ? proton : neutron);
+    outhad.push_back(nubar ? neutron : proton);
+    break;
+  case 2:
+    inhad.push_back(neutron);
+    inhad.push_back(proton);
+    outhad.push_back(nubar ? neutron : proton);
+    outhad.push_back(nubar ? neutron : proton);
+    break;
+  case 11:
+    inhad.push_back(nubar ? neutron : proton);
+    outhad.push_back(nubar ? neutron : proton);
+    outhad.push_back(211 * sign);
+    break;
+  case 12:
+    inhad.push_back(nubar ? proton : neutron);
+    outhad.push_back(nubar ? neutron : proton);
+    outhad.push_back(111);
+    break;
+  case 13:
+    inhad.push_back(nubar ? proton : neutron);
+    outhad.push_back(nubar ? proton : neutron);
+    outhad.push_back(211 * sign);
+    break;
+  case 26: {
+    int nuc = (fRandom.Uniform() < 0.5) ? proton : neutron;
+    inhad.push_back(nuc);
+    outhad.push_back(fRandom.Uniform() < 0.5 ? proton : neutron);
+    int npi = 1 + fRandom.Poisson(0.5 + enu / 2.E3);
+    for (int i = 0; i < npi; i++) {
+      double r = fRandom.Uniform();
+      outhad.push_back(r < 0.4 ? 211 * sign : (r < 0.7 ? 111 : -211 * sign));
+    }
+    break;
+  }
+  case 31:
+    inhad.push_back(neutron);
+    outhad.push_back(neutron);
+    outhad.push_back(111);
+    break;
+  case 51:
+  default:
+    inhad.push_back(proton);
+    outhad.push_back(proton);
+    break;
+  }
+
+  // Hadronic energy transfer from a rough Q2 and W throw
+  double Q2 = 0.0;
+  double q0 = 0.0;
+  for (int attempt = 0; attempt < 10; attempt++) {
+    Q2 = fRandom.Exp(abs(mode) > 10 && abs(mode) != 51 ? 4.E5 : 2.5E5);
+    double W = mN;
+    if (abs(mode) == 11 or abs(mode) == 12 or abs(mode) == 13 or
+        abs(mode) == 31) {
+      W = fRandom.Gaus(1232.0, 60.0);
+    } else if (abs(mode) == 26) {
+      double wmax = sqrt(mN * mN + 2.0 * mN * enu);
+      W = fRandom.Uniform(std::min(1400.0, wmax), wmax);
+    } else if (abs(mode) == 2) {
+      W = mN + fRandom.Uniform(20.0, 120.0);
+    }
+    q0 = (W * W - mN * mN + Q2) / (2.0 * mN) + 25.0;
+    if (q0 > 0.0 and q0 < enu - mlep)
+      break;
+    q0 = fRandom.Uniform(0.05, 0.9) * (enu - mlep);
+  }
+
+  double elep = enu - q0;
+  double plep = sqrt(std::max(elep * elep - mlep * mlep, 0.0));
+  double costh = 1.0;
+  if (plep > 0.0) {
+    costh = (2.0 * enu * elep - Q2 - mlep * mlep) / (2.0 * enu * plep);
+  }
+  costh = std::max(-1.0, std::min(1.0, costh));
+  double phi = fRandom.Uniform(0.0, 2.0 * M_PI);
+
+  TVector3 kin(0.0, 0.0, enu);
+  TVector3 kout;
+  kout.SetMagThetaPhi(plep, acos(costh), phi);
+  TVector3 qvec = kin - kout;
+
+  // Initial state
+  AddParticle(event, fBeamPDG, kInitialState, 0.0, kin);
+  for (size_t i = 0; i < inhad.size(); i++) {
+    TVector3 pfermi = SmearDirection(TVector3(0, 0, 1), 1.0) *
+                      fRandom.Uniform(0.0, fTargetA > 1 ? 220.0 : 0.0);
+    AddParticle(event, inhad[i], kInitialState,
+                PhysConst::GetMass(inhad[i]) * 1.E3, pfermi);
+  }
+  if (fTargetA > 1) {
+    int nucpdg = 1000000000 + fTargetZ * 10000 + fTargetA * 10;
+    AddParticle(event, nucpdg, kNuclearInitial, fTargetA * 931.494,
+                TVector3(0, 0, 0));
+  }
+
+  // Outgoing lepton
+  AddParticle(event, leppdg, kFinalState, mlep, kout);
+
+  // Share the kinetic energy left over after hadron masses
+  double avail = q0;
+  for (size_t i = 0; i < inhad.size(); i++)
+    avail += PhysConst::GetMass(inhad[i]) * 1.E3;
+  for (size_t i = 0; i < outhad.size(); i++)
+    avail -= PhysConst::GetMass(outhad[i]) * 1.E3;
+  avail = std::max(avail, 1.0 * outhad.size());
+
+  std::vector<double> frac(outhad.size());
+  double fracsum = 0.0;
+  for (size_t i = 0; i < outhad.size(); i++) {
+    frac[i] = fRandom.Uniform(0.1, 1.0);
+    fracsum += frac[i];
+  }
+
+  for (size_t i = 0; i < outhad.size(); i++) {
+    double mass = PhysConst::GetMass(outhad[i]) * 1.E3;
+    double tkin = avail * frac[i] / fracsum;
+    double mom = sqrt(tkin * tkin + 2.0 * tkin * mass);
+    TVector3 dir = SmearDirection(qvec.Unit(), 0.5);
+
+    // Pion absorption: keep the pre-FSI pion and knock out a nucleon
+    bool ispion = (abs(outhad[i]) == 211 or outhad[i] == 111);
+    if (ispion and fTargetA > 1 and fRandom.Uniform() < 0.2) {
+      AddParticle(event, outhad[i], kFSIState, mass, dir * mom);
+      double tknock = fRandom.Uniform(20.0, std::max(40.0, tkin + mpi));
+      double mknock = PhysConst::mass_proton * 1.E3;
+      AddParticle(event, proton, kFinalState, mknock,
+                  SmearDirection(dir, 1.0) *
+                      sqrt(tknock * tknock + 2.0 * tknock * mknock));
+      continue;
+    }
+
+    // Nucleon rescattering: keep the pre-FSI nucleon and degrade it
+    bool isnucleon = (outhad[i] == proton or outhad[i] == neutron);
+    if (isnucleon and fTargetA > 1 and fRandom.Uniform() < 0.3) {
+      AddParticle(event, outhad[i], kFSIState, mass, dir * mom);
+      double tscat = tkin * fRandom.Uniform(0.3, 0.9);
+      AddParticle(event, outhad[i], kFinalState, mass,
+                  SmearDirection(dir, 0.7) *
+                      sqrt(tscat * tscat + 2.0 * tscat * mass));
+      double tlow = fRandom.Uniform(5.0, 60.0);
+      AddParticle(event, fRandom.Uniform() < 0.5 ? proton : neutron,
+                  kFinalState, mass,
+                  SmearDirection(dir, 2.0) *
+                      sqrt(tlow * tlow + 2.0 * tlow * mass));
+      continue;
+    }
+
+    AddParticle(event, outhad[i], kFinalState, mass, dir * mom);
+  }
+
+  if (fTargetA > 1) {
+    int nremn = fTargetA - int(inhad.size());
+    int zremn = fTargetZ;
+    for (size_t i = 0; i < inhad.size(); i++)
+      zremn -= (inhad[i] == proton);
+    if (nremn > 0) {
+      int remnpdg = 1000000000 + std::max(zremn, 0) * 10000 + nremn * 10;
+      AddParticle(event, remnpdg, kNuclearRemnant, nremn * 931.494,
+                  SmearDirection(TVector3(0, 0, 1), 1.0) *
+                      fRandom.Uniform(0.0, 200.0));
+    }
+  }
+
+  // Run Initial, FSI, Final, Other ordering.
+  event->OrderStack();
+}
+
+double SyntheticInputHandler::ThrowEnergy() {
+  // Inverse CDF from the cached event rate integral
+  double *integral = fEventHist->GetIntegral();
+  int nbins = fEventHist->GetNbinsX();
+  double r = fRandom.Uniform();
+  int bin = TMath::BinarySearch(nbins + 1, integral, r);
+  double low = fEventHist->GetXaxis()->GetBinLowEdge(bin + 1);
+  double width = fEventHist->GetXaxis()->GetBinWidth(bin + 1);
+  return low + width * fRandom.Uniform();
+}
+
+int SyntheticInputHandler::ThrowMode(double enu) {
+  // Relative rates, pion channels turn on above threshold
+  double pifrac = enu > 300.0 ? 1.0 - exp(-(enu - 300.0) / 700.0) : 0.0;
+  double disfrac = enu > 1000.0 ? std::min((enu - 1000.0) / 1000.0, 1.5) : 0.0;
+
+  const int nmodes = 8;
+  int modes[nmodes] = {1, 2, 11, 12, 13, 26, 31, 51};
+  double rates[nmodes] = {1.0,          0.25,          0.55 * pifrac,
+                          0.18 * pifrac, 0.18 * pifrac, 0.8 * disfrac,
+                          0.1 * pifrac, 0.35};
+
+  double total = 0.0;
+  for (int i = 0; i < nmodes; i++)
+    total += rates[i];
+
+  double r = fRandom.Uniform(0.0, total);
+  int mode = modes[nmodes - 1];
+  for (int i = 0; i < nmodes; i++) {
+    if (r < rates[i]) {
+      mode = modes[i];
+      break;
+    }
+    r -= rates[i];
+  }
+
+  return fBeamPDG < 0 ? -mode : mode;
+}
+
+void SyntheticInputHandler::AddParticle(FitEvent *event, int pdg, int state,
+                                        double mass, TVector3 const &mom) {
+  UInt_t i = event->fNParticles;
+  if (i >= event->kMaxParticles) {
+    NUIS_ABORT("Synthetic event has more than " << event->kMaxParticles
+                                                << " particles.");
+  }
+  event->fParticleState[i] = state;
+  event->fParticlePDG[i] = pdg;
+  event->fParticleMom[i][0] = mom.X();
+  event->fParticleMom[i][1] = mom.Y();
+  event->fParticleMom[i][2] = mom.Z();
+  event->fParticleMom[i][3] = sqrt(mom.Mag2() + mass * mass);
+  event->fPrimaryVertex[i] = (state == kInitialState or state == kFinalState);
+  event->fNParticles++;
+}
+
+TVector3 SyntheticInputHandler::SmearDirection(TVector3 const &dir,
+                                               double sigma) {
+  TVector3 out(dir.X() + fRandom.Gaus(0.0, sigma),
+               dir.Y() + fRandom.Gaus(0.0, sigma),
+               dir.Z() + fRandom.Gaus(0.0, sigma));
+  if (out.Mag2() <= 0.0)
+    return dir;
+  return out.Unit();
+}
+
+void SyntheticInputHandler::Print() {
+  NUIS_LOG(SAM, "Synthetic input : " << fName << " NEvents = " << fNEvents
+                                     << " Seed = " << fSeed
+                                     << " E = " << fEnergy << " GeV"
+                                     << " PDG = " << fBeamPDG
+                                     << " Target = " << fTargetA << ","
+                                     << fTargetZ);
+}
@@ -0,0 +1,80 @@
+// Copyright 2016-2021 L. Pickering, P Stowell, R. Terri, C. Wilkinson, C. Wret
+
+/*******************************************************************************
+ *    This file is part of NUISANCE.
+ *
+ *    NUISANCE is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 3 of the License, or
+ *    (at your option) any later version.
+ *
+ *    NUISANCE is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with NUISANCE.  If not, see <http://www.gnu.org/licenses/>.
+ *******************************************************************************/
+#ifndef SYNTHETICINPUTHANDLER_H
+#define SYNTHETICINPUTHANDLER_H
+/*!
+ *  \addtogroup InputHandler
+ *  @{
+ */
+#include "InputHandler.h"
+#include "TRandom3.h"
+#include "TVector3.h"
+
+/// Generator-free input handler that builds reproducible toy neutrino
+/// events for benchmarking and testing.
+///
+/// Each entry is generated from its own seed so random access gives the same
+/// event as sequential reads. By default the event mix roughly follows a
+/// 1 GeV numu beam on C12 (CCQE, 2p2h, CC1pi, DIS, NC) with FSI and remnant
+/// entries in the stack. Kinematics are only approximately conserving.
+///
+/// Spec: SYNTHETIC:NEVENTS=100000,SEED=1,E=1.0,PDG=14,A=12,Z=6
+class SyntheticInputHandler : public InputHandlerBase {
+public:
+  /// Standard constructor given name and inputs
+  SyntheticInputHandler(std::string const &handle,
+                        std::string const &rawinputs);
+  ~SyntheticInputHandler(){};
+
+  /// Returns the generated event for this entry
+  FitEvent *GetNuisanceEvent(const UInt_t entry,
+                             const bool lightweight = false);
+
+  /// Fill any FitEvent with the contents of entry. Used by benchmarks that
+  /// need several events alive at once.
+  void FillEvent(FitEvent *event, const UInt_t entry, const bool lightweight);
+
+  /// Print event information
+  void Print();
+
+private:
+  /// Throw a neutrino energy in GeV from the event rate histogram
+  double ThrowEnergy();
+
+  /// Throw a NEUT-style interaction mode for the current event
+  int ThrowMode(double enu);
+
+  /// Append a particle to the event stack, energy is set from mass and mom.
+  /// Aborts if the stack is full.
+  void AddParticle(FitEvent *event, int pdg, int state, double mass,
+                   TVector3 const &mom);
+
+  /// Random unit vector smeared around dir by sigma per component
+  TVector3 SmearDirection(TVector3 const &dir, double sigma);
+
+  int fSeed;         ///< Base seed, each entry uses fSeed and its index
+  double fEnergy;    ///< Flux peak energy in GeV
+  int fBeamPDG;      ///< Neutrino PDG, sign controls nu/nubar
+  int fTargetA;      ///< Target nucleus A
+  int fTargetZ;      ///< Target nucleus Z
+  TRandom3 fRandom;  ///< Per-entry reseeded generator
+};
+
+/*! @} */
+#endif
@@ -19,6 +19,7 @@
 
 #include "FitLogger.h"
 #include <fcntl.h>
+#include <thread>
 #include <unistd.h>
 
 namespace Logger {
@@ -249,6 +250,15 @@ std::ostream& __OUTERR(int level, const char* filename, const char* funct,
 // ----------- External Logging ----------- //
 void SETEXTERNALVERBOSITY(int level) { Logger::external_verb = (level > 0); }
 
+namespace {
+// Nesting depth of StopTalking calls, output is only restored once the
+// outermost quiet section finishes. Only the main thread redirects the
+// process wide streams, so the depth needs no lock and quiet sections
+// reached from sample threads do nothing.
+int gQuietDepth = 0;
+std::thread::id const gMainThread = std::this_thread::get_id();
+} // namespace
+
 void StopTalking() {
   // Check verbosity set correctly
   if (!Logger::external_verb) return;
@@ -256,6 +266,9 @@ void StopTalking() {
   // Only redirect if we're not debugging
   if (Logger::log_verb == (int)DEB) return;
 
+  if (std::this_thread::get_id() != gMainThread) return;
+  if (gQuietDepth++ > 0) return;
+
   std::cout.rdbuf(Logger::redirect_stream.rdbuf());
   std::cerr.rdbuf(Logger::redirect_stream.rdbuf());
   shhnuisancepythiaitokay_();
@@ -269,6 +282,9 @@ void StartTalking() {
   // Check verbosity set correctly
   if (!Logger::external_verb) return;
 
+  if (std::this_thread::get_id() != gMainThread) return;
+  if (gQuietDepth > 0 && --gQuietDepth > 0) return;
+
   std::cout.rdbuf(Logger::default_cout);
   std::cerr.rdbuf(Logger::default_cerr);
   canihaznuisancepythia_();
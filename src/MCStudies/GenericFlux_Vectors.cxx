@@ -19,6 +19,10 @@
 
 #include "GenericFlux_Vectors.h"
 
+#include "TFormula.h"
+
+#include <cctype>
+
 #ifdef MINERvA_ENABLED
 #include "MINERvA_SignalDef.h"
 #endif
@@ -55,6 +59,14 @@ GenericFlux_Vectors::GenericFlux_Vectors(std::string name,
   NUIS_LOG(SAM, "Running GenericFlux_Vectors saving signal flags? "
 	   << SaveSignalFlags);
 
+  // The full tree computes everything, column output only what it needs
+  fColumns = NULL;
+  fComputeGroup = std::vector<bool>(kNVariableGroups, true);
+  fComputeGroup[kInitParticles] = SavePreFSI;
+  fComputeGroup[kVertParticles] = SavePreFSI;
+  fComputeGroup[kSignalFlags] = SaveSignalFlags;
+  nfsp = ninitp = nvertp = kMAX;
+
   // Set default fitter flags
   fIsDiag = true;
   fIsShape = false;
@@ -98,9 +110,286 @@ GenericFlux_Vectors::GenericFlux_Vectors(std::string name,
     NUIS_ABORT("SCALE FACTOR TOO LOW");
   }
 
-  // Setup our TTrees
-  this->AddEventVariablesToTree();
-  if (SaveSignalFlags) this->AddSignalFlagsToTree();
+  // Setup our TTrees, or the columnar output if only some columns are wanted
+  std::string columns = Config::GetParS("nuisflat_Columns");
+  if (!columns.empty()) {
+    this->AddEventVariablesToColumns(columns);
+  } else {
+    this->AddEventVariablesToTree();
+    if (SaveSignalFlags) this->AddSignalFlagsToTree();
+  }
+}
+
+GenericFlux_Vectors::~GenericFlux_Vectors() {
+  delete fColumns;
+  for (size_t i = 0; i < fColumnExprs.size(); i++) {
+    delete fColumnExprs[i].formula;
+  }
+}
+
+std::vector<GenericFlux_Vectors::ColumnDef>
+GenericFlux_Vectors::GetColumnDefs() {
+  std::vector<ColumnDef> defs;
+
+  defs.push_back(ColumnDef("Mode", 'I', &Mode, kEventInfo));
+  defs.push_back(ColumnDef("cc", 'O', &cc, kEventInfo));
+  defs.push_back(ColumnDef("PDGnu", 'I', &PDGnu, kEventInfo));
+  defs.push_back(ColumnDef("Enu_true", 'F', &Enu_true, kEventInfo));
+  defs.push_back(ColumnDef("tgt", 'I', &tgt, kEventInfo));
+  defs.push_back(ColumnDef("tgta", 'I', &tgta, kEventInfo));
+  defs.push_back(ColumnDef("tgtz", 'I', &tgtz, kEventInfo));
+  defs.push_back(ColumnDef("PDGLep", 'I', &PDGLep, kLepton));
+  defs.push_back(ColumnDef("ELep", 'F', &ELep, kLepton));
+  defs.push_back(ColumnDef("CosLep", 'F', &CosLep, kLepton));
+
+  defs.push_back(ColumnDef("Q2", 'F', &Q2, kLepton));
+  defs.push_back(ColumnDef("q0", 'F', &q0, kLepton));
+  defs.push_back(ColumnDef("q3", 'F', &q3, kLepton));
+  defs.push_back(ColumnDef("Enu_QE", 'F', &Enu_QE, kQERec));
+  defs.push_back(ColumnDef("Q2_QE", 'F', &Q2_QE, kQERec));
+  defs.push_back(ColumnDef("W_nuc_rest", 'F', &W_nuc_rest, kLepton));
+  defs.push_back(ColumnDef("W", 'F', &W, kLepton));
+  defs.push_back(ColumnDef("W_genie", 'F', &W_genie, kGenieW));
+  defs.push_back(ColumnDef("x", 'F', &x, kLepton));
+  defs.push_back(ColumnDef("y", 'F', &y, kLepton));
+  defs.push_back(ColumnDef("Eav", 'F', &Eav, kEavail));
+  defs.push_back(ColumnDef("EavAlt", 'F', &EavAlt, kEavail));
+
+  defs.push_back(ColumnDef("CosThetaAdler", 'F', &CosThetaAdler, kAdler));
+  defs.push_back(ColumnDef("PhiAdler", 'F', &PhiAdler, kAdler));
+
+  defs.push_back(ColumnDef("dalphat", 'F', &dalphat, kSTV));
+  defs.push_back(ColumnDef("dpt", 'F', &dpt, kSTV));
+  defs.push_back(ColumnDef("dphit", 'F', &dphit, kSTV));
+  defs.push_back(ColumnDef("pnreco_C", 'F', &pnreco_C, kSTV));
+
+  defs.push_back(ColumnDef("nfsp", 'I', &nfsp, kFSParticles));
+  defs.push_back(ColumnDef("px", 'F', px, kFSParticles, "nfsp"));
+  defs.push_back(ColumnDef("py", 'F', py, kFSParticles, "nfsp"));
+  defs.push_back(ColumnDef("pz", 'F', pz, kFSParticles, "nfsp"));
+  defs.push_back(ColumnDef("E", 'F', E, kFSParticles, "nfsp"));
+  defs.push_back(ColumnDef("pdg", 'I', pdg, kFSParticles, "nfsp"));
+  defs.push_back(ColumnDef("pdg_rank", 'I', pdg_rank, kFSRank, "nfsp"));
+
+  defs.push_back(ColumnDef("ninitp", 'I', &ninitp, kInitParticles));
+  defs.push_back(ColumnDef("px_init", 'F', px_init, kInitParticles, "ninitp"));
+  defs.push_back(ColumnDef("py_init", 'F', py_init, kInitParticles, "ninitp"));
+  defs.push_back(ColumnDef("pz_init", 'F', pz_init, kInitParticles, "ninitp"));
+  defs.push_back(ColumnDef("E_init", 'F', E_init, kInitParticles, "ninitp"));
+  defs.push_back(ColumnDef("pdg_init", 'I', pdg_init, kInitParticles, "ninitp"));
+
+  defs.push_back(ColumnDef("nvertp", 'I', &nvertp, kVertParticles));
+  defs.push_back(ColumnDef("px_vert", 'F', px_vert, kVertParticles, "nvertp"));
+  defs.push_back(ColumnDef("py_vert", 'F', py_vert, kVertParticles, "nvertp"));
+  defs.push_back(ColumnDef("pz_vert", 'F', pz_vert, kVertParticles, "nvertp"));
+  defs.push_back(ColumnDef("E_vert", 'F', E_vert, kVertParticles, "nvertp"));
+  defs.push_back(ColumnDef("pdg_vert", 'I', pdg_vert, kVertParticles, "nvertp"));
+
+  defs.push_back(ColumnDef("Weight", 'F', &Weight, kEventInfo));
+  defs.push_back(ColumnDef("InputWeight", 'F', &InputWeight, kEventInfo));
+  defs.push_back(ColumnDef("RWWeight", 'F', &RWWeight, kEventInfo));
+  defs.push_back(ColumnDef("fScaleFactor", 'D', &fScaleFactor, kEventInfo));
+  defs.push_back(ColumnDef("CustomWeight", 'F', &CustomWeight, kEventInfo));
+
+  defs.push_back(ColumnDef("flagCCINC", 'O', &flagCCINC, kSignalFlags));
+  defs.push_back(ColumnDef("flagNCINC", 'O', &flagNCINC, kSignalFlags));
+  defs.push_back(ColumnDef("flagCCQE", 'O', &flagCCQE, kSignalFlags));
+  defs.push_back(ColumnDef("flagCC0pi", 'O', &flagCC0pi, kSignalFlags));
+  defs.push_back(ColumnDef("flagCCQELike", 'O', &flagCCQELike, kSignalFlags));
+  defs.push_back(ColumnDef("flagNCEL", 'O', &flagNCEL, kSignalFlags));
+  defs.push_back(ColumnDef("flagNC0pi", 'O', &flagNC0pi, kSignalFlags));
+  defs.push_back(ColumnDef("flagCCcoh", 'O', &flagCCcoh, kSignalFlags));
+  defs.push_back(ColumnDef("flagNCcoh", 'O', &flagNCcoh, kSignalFlags));
+  defs.push_back(ColumnDef("flagCC1pip", 'O', &flagCC1pip, kSignalFlags));
+  defs.push_back(ColumnDef("flagNC1pip", 'O', &flagNC1pip, kSignalFlags));
+  defs.push_back(ColumnDef("flagCC1pim", 'O', &flagCC1pim, kSignalFlags));
+  defs.push_back(ColumnDef("flagNC1pim", 'O', &flagNC1pim, kSignalFlags));
+  defs.push_back(ColumnDef("flagCC1pi0", 'O', &flagCC1pi0, kSignalFlags));
+  defs.push_back(ColumnDef("flagNC1pi0", 'O', &flagNC1pi0, kSignalFlags));
+#ifdef MINERvA_ENABLED
+  defs.push_back(
+      ColumnDef("flagCC0piMINERvA", 'O', &flagCC0piMINERvA, kSignalFlags));
+#endif
+#ifdef T2K_ENABLED
+  defs.push_back(
+      ColumnDef("flagCC0Pi_T2K_AnaI", 'O', &flagCC0Pi_T2K_AnaI, kSignalFlags));
+  defs.push_back(ColumnDef("flagCC0Pi_T2K_AnaII", 'O', &flagCC0Pi_T2K_AnaII,
+                           kSignalFlags));
+#endif
+
+  return defs;
+}
+
+double GenericFlux_Vectors::GetColumnValue(ColumnDef const &def) {
+  switch (def.type) {
+  case 'F':
+    return *static_cast<float *>(def.addr);
+  case 'D':
+    return *static_cast<double *>(def.addr);
+  case 'I':
+    return *static_cast<int *>(def.addr);
+  case 'O':
+    return *static_cast<bool *>(def.addr);
+  default:
+    return 0.0;
+  }
+}
+
+//********************************************************************
+void GenericFlux_Vectors::AddEventVariablesToColumns(
+    std::string const &columns) {
+  //********************************************************************
+
+  // Split on commas outside brackets so expressions can call functions
+  std::vector<std::string> entries(1);
+  int depth = 0;
+  for (size_t i = 0; i < columns.size(); i++) {
+    char c = columns[i];
+    if (c == '(')
+      depth++;
+    if (c == ')')
+      depth--;
+    if (c == ',' && depth == 0) {
+      entries.push_back("");
+    } else if (!isspace(c)) {
+      entries.back() += c;
+    }
+  }
+
+  fColumnDefs = GetColumnDefs();
+  std::map<std::string, int> defindex;
+  for (size_t i = 0; i < fColumnDefs.size(); i++) {
+    defindex[fColumnDefs[i].name] = i;
+  }
+
+  std::string filename = Config::GetParS("nuisflat_ColumnFile");
+  if (filename.empty()) {
+    filename = std::string(Config::Get().out->GetName()) + ".ncol";
+  }
+  fColumns = new ColumnarFile::Writer(
+      filename, Config::GetParI("nuisflat_ColumnChunk"),
+      Config::GetParI("nuisflat_ColumnCompression"));
+
+  std::fill(fComputeGroup.begin(), fComputeGroup.end(), false);
+  fComputeGroup[kEventInfo] = true;
+
+  // Expression values are bound by address so size them up front
+  int nexpr = 0;
+  for (size_t i = 0; i < entries.size(); i++) {
+    if (entries[i].find('=') != std::string::npos)
+      nexpr++;
+  }
+  fColumnExprValues.resize(nexpr);
+
+  for (size_t i = 0; i < entries.size(); i++) {
+    std::string entry = entries[i];
+    if (entry.empty())
+      continue;
+
+    // Plain variables, arrays bring their count column with them
+    size_t eq = entry.find('=');
+    if (eq == std::string::npos) {
+      if (!defindex.count(entry)) {
+        NUIS_ERR(FTL, "Unknown nuisflat column " << entry << ". Available:");
+        for (size_t j = 0; j < fColumnDefs.size(); j++) {
+          NUIS_ERR(FTL, " -> " << fColumnDefs[j].name);
+        }
+        NUIS_ABORT("Use name=expression for derived columns.");
+      }
+
+      ColumnDef const &def = fColumnDefs[defindex[entry]];
+      fComputeGroup[def.group] = true;
+      if (fColumns->GetColumnIndex(def.name) != -1)
+        continue;
+
+      if (def.count.empty()) {
+        fColumns->AddColumn(def.name, def.type, def.addr);
+        continue;
+      }
+
+      int countcol = fColumns->GetColumnIndex(def.count);
+      if (countcol == -1) {
+        ColumnDef const &countdef = fColumnDefs[defindex[def.count]];
+        countcol = fColumns->AddColumn(countdef.name, countdef.type,
+                                       countdef.addr);
+      }
+      fColumns->AddArrayColumn(def.name, def.type, def.addr, countcol, kMAX);
+      continue;
+    }
+
+    // Expressions of scalar columns, evaluated with TFormula parameters
+    std::string alias = entry.substr(0, eq);
+    std::string expr = entry.substr(eq + 1);
+    ColumnExpr colexpr;
+
+    std::string formula;
+    for (size_t c = 0; c < expr.size();) {
+      if (isdigit(expr[c]) || expr[c] == '.') {
+        size_t end = c;
+        while (end < expr.size() &&
+               (isalnum(expr[end]) || expr[end] == '.' ||
+                ((expr[end] == '+' || expr[end] == '-') &&
+                 (expr[end - 1] == 'e' || expr[end - 1] == 'E')))) {
+          end++;
+        }
+        formula += expr.substr(c, end - c);
+        c = end;
+        continue;
+      }
+
+      if (!isalpha(expr[c]) && expr[c] != '_') {
+        formula += expr[c++];
+        continue;
+      }
+
+      size_t end = c;
+      while (end < expr.size() && (isalnum(expr[end]) || expr[end] == '_')) {
+        end++;
+      }
+      std::string token = expr.substr(c, end - c);
+      bool scoped = c >= 2 && expr.compare(c - 2, 2, "::") == 0;
+
+      if (!scoped && defindex.count(token)) {
+        ColumnDef const &def = fColumnDefs[defindex[token]];
+        if (!def.count.empty()) {
+          NUIS_ABORT("nuisflat column " << alias << " uses particle array "
+                                        << token
+                                        << ", expressions only take scalars.");
+        }
+        fComputeGroup[def.group] = true;
+        formula += "[" + token + "]";
+      } else {
+        formula += token;
+      }
+      c = end;
+    }
+
+    colexpr.formula = new TFormula(alias.c_str(), formula.c_str());
+    if (!colexpr.formula->IsValid()) {
+      NUIS_ABORT("Cannot parse nuisflat column " << alias << "=" << expr);
+    }
+    for (int p = 0; p < colexpr.formula->GetNpar(); p++) {
+      std::string parname = colexpr.formula->GetParName(p);
+      if (!defindex.count(parname)) {
+        NUIS_ABORT("Unknown variable " << parname << " in nuisflat column "
+                                       << alias);
+      }
+      colexpr.columns.push_back(defindex[parname]);
+    }
+    colexpr.params.resize(colexpr.columns.size());
+
+    fColumns->AddColumn(alias, 'F', &fColumnExprValues[fColumnExprs.size()]);
+    fColumnExprs.push_back(colexpr);
+  }
+
+  // Dependencies between the groups
+  if (fComputeGroup[kQERec])
+    fComputeGroup[kLepton] = true;
+  if (fComputeGroup[kFSRank])
+    fComputeGroup[kFSParticles] = true;
+
+  NUIS_LOG(SAM, "Saving " << entries.size() << " nuisflat columns to "
+                          << filename);
 }
 
 void GenericFlux_Vectors::AddEventVariablesToTree() {
@@ -191,7 +480,7 @@ void GenericFlux_Vectors::FillEventVariables(FitEvent *event) {
   ResetVariables();
 
   // Fill Signal Variables
-  if (SaveSignalFlags) FillSignalFlags(event);
+  if (fComputeGroup[kSignalFlags]) FillSignalFlags(event);
   NUIS_LOG(DEB, "Filling signal");
 
   // Now fill the information
@@ -210,7 +499,8 @@ void GenericFlux_Vectors::FillEventVariables(FitEvent *event) {
 
   TLorentzVector ISP4 = nu->fP;
 
-  if (lep != NULL) {
+  // Only the groups of variables that are saved get computed
+  if (lep != NULL && fComputeGroup[kLepton]) {
     PDGLep = lep->fPID;
     ELep = lep->fP.E() / 1E3;
     CosLep = cos(nu->fP.Vect().Angle(lep->fP.Vect()));
@@ -220,14 +510,29 @@ void GenericFlux_Vectors::FillEventVariables(FitEvent *event) {
     q0 = (nu->fP - lep->fP).E() / 1E3;
     q3 = (nu->fP - lep->fP).Vect().Mag() / 1E3;
 
+    // Get W_true with assumption of initial state nucleon at rest
+    float m_n = (float)PhysConst::mass_proton;
+    // Q2 assuming nucleon at rest
+    W_nuc_rest = sqrt(-Q2 + 2 * m_n * q0 + m_n * m_n);
+    W = W_nuc_rest; // For want of a better thing to do
+    // True Q2
+    x = Q2 / (2 * m_n * q0);
+    y = 1 - ELep / Enu_true;
+  }
+
+  if (lep != NULL && fComputeGroup[kQERec]) {
     // These assume C12 binding from MINERvA... not ideal
     Enu_QE = FitUtils::EnuQErec(lep->fP, CosLep, 34., true);
     Q2_QE = FitUtils::Q2QErec(lep->fP, CosLep, 34., true);
+  }
 
+  if (lep != NULL && fComputeGroup[kEavail]) {
     Eav = FitUtils::GetErecoil_MINERvA_LowRecoil(event) / 1.E3;
     EavAlt = FitUtils::Eavailable(event) / 1.E3;
+  }
 
-    // Check if this is a 1pi+ or 1pi0 event
+  // Check if this is a 1pi+ or 1pi0 event
+  if (lep != NULL && fComputeGroup[kAdler]) {
     if ((SignalDef::isCC1pi(event, PDGnu, 211) ||
          SignalDef::isCC1pi(event, PDGnu, -211) ||
          SignalDef::isCC1pi(event, PDGnu, 111)) &&
@@ -239,16 +544,9 @@ void GenericFlux_Vectors::FillEventVariables(FitEvent *event) {
       CosThetaAdler = FitUtils::CosThAdler(Pnu, Pmu, Ppi, Pprot);
       PhiAdler = FitUtils::PhiAdler(Pnu, Pmu, Ppi, Pprot);
     }
+  }
 
-    // Get W_true with assumption of initial state nucleon at rest
-    float m_n = (float)PhysConst::mass_proton;
-    // Q2 assuming nucleon at rest
-    W_nuc_rest = sqrt(-Q2 + 2 * m_n * q0 + m_n * m_n);
-    W = W_nuc_rest; // For want of a better thing to do
-    // True Q2
-    x = Q2 / (2 * m_n * q0);
-    y = 1 - ELep / Enu_true;
-
+  if (lep != NULL && fComputeGroup[kSTV]) {
     dalphat = FitUtils::Get_STV_dalphat_HMProton(event, PDGnu, true);
     dpt = FitUtils::Get_STV_dpt_HMProton(event, PDGnu, true);
     dphit = FitUtils::Get_STV_dphit_HMProton(event, PDGnu, true);
@@ -256,16 +554,20 @@ void GenericFlux_Vectors::FillEventVariables(FitEvent *event) {
   }
 
   // Loop over the particles and store all the final state particles in a vector
-  for (UInt_t i = 0; i < event->Npart(); ++i) {
+  bool saveFS = fComputeGroup[kFSParticles];
+  bool saveInit = fComputeGroup[kInitParticles];
+  bool saveVert = fComputeGroup[kVertParticles];
+  for (UInt_t i = 0; (saveFS || saveInit || saveVert) && i < event->Npart();
+       ++i) {
 
-    if (event->PartInfo(i)->fIsAlive &&
+    if (saveFS && event->PartInfo(i)->fIsAlive &&
         event->PartInfo(i)->Status() == kFinalState)
       partList.push_back(event->PartInfo(i));
 
-    if (SavePreFSI && event->fPrimaryVertex[i])
+    if (saveVert && event->fPrimaryVertex[i])
       vertList.push_back(event->PartInfo(i));
 
-    if (SavePreFSI && event->PartInfo(i)->IsInitialState())
+    if (saveInit && event->PartInfo(i)->IsInitialState())
       initList.push_back(event->PartInfo(i));
 
     if (event->PartInfo(i)->IsInitialState()) {
@@ -283,7 +585,9 @@ void GenericFlux_Vectors::FillEventVariables(FitEvent *event) {
     pz[i] = partList[i]->fP.Z() / 1E3;
     E[i] = partList[i]->fP.E() / 1E3;
     pdg[i] = partList[i]->fPID;
-    pdgMap[pdg[i]].push_back(std::make_pair(partList[i]->fP.Vect().Mag(), i));
+    if (fComputeGroup[kFSRank])
+      pdgMap[pdg[i]].push_back(
+          std::make_pair(partList[i]->fP.Vect().Mag(), i));
   }
 
   for (std::map<int, std::vector<std::pair<double, int> > >::iterator iter =
@@ -320,7 +624,7 @@ void GenericFlux_Vectors::FillEventVariables(FitEvent *event) {
   }
 
 #ifdef GENIE_ENABLED
-  if (event->fType == kGENIE) {
+  if (event->fType == kGENIE && fComputeGroup[kGenieW]) {
     EventRecord *gevent = static_cast<EventRecord *>(event->genie_event->event);
     const Interaction *interaction = gevent->Summary();
     const Kinematics &kine = interaction->Kine();
@@ -340,8 +644,22 @@ void GenericFlux_Vectors::FillEventVariables(FitEvent *event) {
     CustomWeightArray[i] = event->CustomWeightArray[i];
   }
 
-  // Fill the eventVariables Tree
-  eventVariables->Fill();
+  // Derived columns only see the variables computed above
+  for (size_t i = 0; i < fColumnExprs.size(); i++) {
+    ColumnExpr &colexpr = fColumnExprs[i];
+    for (size_t p = 0; p < colexpr.columns.size(); p++) {
+      colexpr.params[p] = GetColumnValue(fColumnDefs[colexpr.columns[p]]);
+    }
+    fColumnExprValues[i] = colexpr.formula->EvalPar(
+        NULL, colexpr.params.empty() ? NULL : &colexpr.params[0]);
+  }
+
+  // Fill the eventVariables Tree or the column buffers
+  if (fColumns) {
+    fColumns->Fill();
+  } else {
+    eventVariables->Fill();
+  }
   return;
 };
 
@@ -362,17 +680,20 @@ void GenericFlux_Vectors::ResetVariables() {
   // MINERvA-like ones
   dalphat = dpt = dphit = pnreco_C = -999.99;
 
-  nfsp = ninitp = nvertp = 0;
-  for (int i = 0; i < kMAX; ++i) {
+  // Only the entries used by the last event need resetting
+  for (int i = 0; i < (nfsp < kMAX ? nfsp : kMAX); ++i) {
     px[i] = py[i] = pz[i] = E[i] = -999;
     pdg[i] = pdg_rank[i] = 0;
-
+  }
+  for (int i = 0; i < (ninitp < kMAX ? ninitp : kMAX); ++i) {
     px_init[i] = py_init[i] = pz_init[i] = E_init[i] = -999;
     pdg_init[i] = 0;
-
+  }
+  for (int i = 0; i < (nvertp < kMAX ? nvertp : kMAX); ++i) {
     px_vert[i] = py_vert[i] = pz_vert[i] = E_vert[i] = -999;
     pdg_vert[i] = 0;
   }
+  nfsp = ninitp = nvertp = 0;
 
   Weight = InputWeight = RWWeight = 0.0;
 
@@ -471,8 +792,12 @@ void GenericFlux_Vectors::AddSignalFlagsToTree() {
 
 void GenericFlux_Vectors::Write(std::string drawOpt) {
 
-  // First save the TTree
-  eventVariables->Write();
+  // First save the TTree, or finish the columnar file
+  if (fColumns) {
+    fColumns->Close();
+  } else {
+    eventVariables->Write();
+  }
 
   // Save Flux and Event Histograms too
   GetInput()->GetFluxHistogram()->Write();
@@ -21,13 +21,16 @@
 #define GenericFlux_Vectors_H_SEEN
 #include "Measurement1D.h"
 #include "FitEvent.h"
+#include "ColumnarFile.h"
+
+class TFormula;
 
 class GenericFlux_Vectors : public Measurement1D {
 
 public:
 
   GenericFlux_Vectors(std::string name, std::string inputfile, FitWeight *rw, std::string type, std::string fakeDataFile);
-  virtual ~GenericFlux_Vectors() {};
+  virtual ~GenericFlux_Vectors();
 
   //! Grab info from event
   void FillEventVariables(FitEvent *event);
@@ -61,8 +64,60 @@ public:
   void AddEventVariablesToTree();
   void AddSignalFlagsToTree();
 
+  //! Setup the columnar output from a list of columns and expressions
+  void AddEventVariablesToColumns(std::string const &columns);
+
  private:
 
+  //! Sets of variables that are computed together
+  enum VariableGroup {
+    kEventInfo = 0,
+    kLepton,
+    kQERec,
+    kEavail,
+    kAdler,
+    kSTV,
+    kFSParticles,
+    kFSRank,
+    kInitParticles,
+    kVertParticles,
+    kGenieW,
+    kSignalFlags,
+    kNVariableGroups
+  };
+
+  //! A variable that can be saved as a column
+  struct ColumnDef {
+    ColumnDef(std::string const &n, char t, void *a, int g,
+              std::string const &c = "")
+        : name(n), type(t), addr(a), group(g), count(c) {}
+
+    std::string name;
+    char type;           ///< ROOT leaf code
+    void *addr;
+    int group;           ///< VariableGroup needed to fill it
+    std::string count;   ///< Count column for particle arrays
+  };
+
+  //! A user expression of scalar columns, saved as a float column
+  struct ColumnExpr {
+    TFormula *formula;
+    std::vector<int> columns; ///< Column definition for each parameter
+    std::vector<double> params;
+  };
+
+  //! All variables this sample can save
+  std::vector<ColumnDef> GetColumnDefs();
+
+  //! Value of a scalar column as a double
+  static double GetColumnValue(ColumnDef const &def);
+
+  std::vector<bool> fComputeGroup; ///< Groups filled for each event
+  ColumnarFile::Writer *fColumns;  ///< Columnar output, NULL for the TTree
+  std::vector<ColumnDef> fColumnDefs;
+  std::vector<ColumnExpr> fColumnExprs;
+  std::vector<float> fColumnExprValues;
+
   TTree* eventVariables;
   std::vector<FitParticle*> partList;
   std::vector<FitParticle*> initList;
@@ -30,6 +30,9 @@ public:
     inline void Print(){
         std::cout << "Box Print Size : " << this->fTpiVect.size() << std::endl;
     }
+    inline size_t GetMemorySize(){
+        return sizeof(*this) + fTpiVect.capacity() * sizeof(double);
+    }
 
 	std::vector<double> fTpiVect;
 };
@@ -50,6 +53,9 @@ class NthpiVariableBox1D : public MeasurementVariableBox1D {
         }
         return box;
     }
+  inline size_t GetMemorySize(){
+        return sizeof(*this) + fthpiVect.capacity() * sizeof(double);
+  }
   std::vector<double> fthpiVect;
 };
 
@@ -52,6 +52,7 @@ MINERvA_CC0pi_XSec_1DEe_nue::MINERvA_CC0pi_XSec_1DEe_nue(nuiskey samplekey) {
   fScaleFactor = (GetEventHistogram()->Integral("width") * 1E-38 / (fNEvents + 0.)) / TotalIntegratedFlux();
 
   // Plot Setup -------------------------------------------------------
+  fDeferLoading = true;
   SetDataFromRootFile( fSettings.GetDataInput() );
   SetCovarFromRootFile(fSettings.GetCovarInput() );
   ScaleCovar(1.0 / 1000.0);
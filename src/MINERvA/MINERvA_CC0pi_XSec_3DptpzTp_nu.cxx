@@ -244,7 +244,7 @@ double MINERvA_CC0pi_XSec_3DptpzTp_nu::GetLikelihood() {
   }
 
   // Adjust the shape back to where it was.
-  if (fIsShape and !FitPar::Config().GetParB("saveshapescaling")) {
+  if (fIsShape and !fSaveShapeScaling) {
     fMCHist->Scale(1. / scaleF);
     fMCFine->Scale(1. / scaleF);
   }
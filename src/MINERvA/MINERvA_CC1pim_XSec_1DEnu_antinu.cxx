@@ -59,6 +59,7 @@ MINERvA_CC1pim_XSec_1DEnu_antinu::MINERvA_CC1pim_XSec_1DEnu_antinu(
     / double(fNEvents);
 
   // Plot Setup -------------------------------------------------------
+  fDeferLoading = true;
   SetDataFromRootFile( fSettings.GetDataInput(), "enu_data" );
   SetCovarFromRootFile( fSettings.GetCovarInput(), "enu_covariance" );
 
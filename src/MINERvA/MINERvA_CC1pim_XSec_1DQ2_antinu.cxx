@@ -58,6 +58,7 @@ MINERvA_CC1pim_XSec_1DQ2_antinu::MINERvA_CC1pim_XSec_1DQ2_antinu(
     / double(fNEvents) / TotalIntegratedFlux("width");
 
   // Plot Setup -------------------------------------------------------
+  fDeferLoading = true;
   SetDataFromRootFile( fSettings.GetDataInput(), "q2_data" );
   SetCovarFromRootFile( fSettings.GetCovarInput(), "q2_covariance" );
 
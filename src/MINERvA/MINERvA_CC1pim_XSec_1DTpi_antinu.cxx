@@ -58,6 +58,7 @@ MINERvA_CC1pim_XSec_1DTpi_antinu::MINERvA_CC1pim_XSec_1DTpi_antinu(
     / double(fNEvents) / TotalIntegratedFlux("width");
 
   // Plot Setup -------------------------------------------------------
+  fDeferLoading = true;
   SetDataFromRootFile( fSettings.GetDataInput(), "kinetic_data" );
   SetCovarFromRootFile( fSettings.GetCovarInput(), "kinetic_covariance" );
 
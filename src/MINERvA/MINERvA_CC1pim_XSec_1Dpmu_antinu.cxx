@@ -58,6 +58,7 @@ MINERvA_CC1pim_XSec_1Dpmu_antinu::MINERvA_CC1pim_XSec_1Dpmu_antinu(
     / double(fNEvents) / TotalIntegratedFlux("width");
 
   // Plot Setup -------------------------------------------------------
+  fDeferLoading = true;
   SetDataFromRootFile( fSettings.GetDataInput(), "mmom_data" );
   SetCovarFromRootFile( fSettings.GetCovarInput(), "mmom_covariance" );
 
@@ -59,6 +59,7 @@ MINERvA_CC1pim_XSec_1Dth_antinu::MINERvA_CC1pim_XSec_1Dth_antinu(
     / double(fNEvents) / TotalIntegratedFlux("width");
 
   // Plot Setup -------------------------------------------------------
+  fDeferLoading = true;
   SetDataFromRootFile( fSettings.GetDataInput(), "theta_data" );
   SetCovarFromRootFile( fSettings.GetCovarInput(), "theta_covariance" );
 
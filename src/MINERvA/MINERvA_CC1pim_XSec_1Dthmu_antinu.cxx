@@ -58,6 +58,7 @@ MINERvA_CC1pim_XSec_1Dthmu_antinu::MINERvA_CC1pim_XSec_1Dthmu_antinu(
     / double(fNEvents) / TotalIntegratedFlux("width");
 
   // Plot Setup -------------------------------------------------------
+  fDeferLoading = true;
   SetDataFromRootFile( fSettings.GetDataInput(), "mutheta_data" );
   SetCovarFromRootFile( fSettings.GetCovarInput(), "mutheta_covariance" );
 
@@ -53,6 +53,7 @@ MINERvA_CCCOHPI_XSec_1DEnu_antinu::MINERvA_CCCOHPI_XSec_1DEnu_antinu(nuiskey sam
   fScaleFactor = GetEventHistogram()->Integral("width") * double(1E-38) / double(fNEvents)*13;
    
   // Plot Setup -------------------------------------------------------
+  fDeferLoading = true;
   SetDataFromTextFile( fSettings.GetDataInput() );
   SetCovarFromMultipleTextFiles(fSettings.GetCovarInput());
 
@@ -115,6 +115,7 @@ MINERvA_CCQE_XSec_1DQ2_antinu::MINERvA_CCQE_XSec_1DQ2_antinu(
       7. / TotalIntegratedFlux();
 
   // Plot Setup -------------------------------------------------------
+  fDeferLoading = true;
   SetDataFromTextFile(fSettings.GetDataInput());
 
   // Ergh, the pain of supporting many slightly different versions of the same analysis
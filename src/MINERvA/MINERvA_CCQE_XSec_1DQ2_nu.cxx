@@ -111,6 +111,7 @@ MINERvA_CCQE_XSec_1DQ2_nu::MINERvA_CCQE_XSec_1DQ2_nu(nuiskey samplekey) {
                  TotalIntegratedFlux();
 
   // Plot Setup -------------------------------------------------------
+  fDeferLoading = true;
   SetDataFromTextFile(fSettings.GetDataInput());
 
   // Ergh, the pain of supporting many slightly different versions of the same analysis
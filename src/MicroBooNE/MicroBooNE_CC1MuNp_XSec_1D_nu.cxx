@@ -78,6 +78,7 @@ MicroBooNE_CC1MuNp_XSec_1D_nu::MicroBooNE_CC1MuNp_XSec_1D_nu(nuiskey samplekey)
 
   // Load data ---------------------------------------------------------
   std::string inputFile = FitPar::GetDataBase() + "/MicroBooNE/CC1MuNp/CCNp_data_MC_cov_dataRelease.root";
+  fDeferLoading = true;
   SetDataFromRootFile(inputFile, "DataXsec_" + objSuffix);
   ScaleData(1E-38);
 
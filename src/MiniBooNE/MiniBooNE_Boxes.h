@@ -39,6 +39,10 @@ public:
 		}
 	};
 
+	size_t GetMemorySize() {
+		return sizeof(*this) + fFSPionMom.capacity() * sizeof(double);
+	}
+
 	int fNProtons;
 	int fNNeutrons;
 	int fNIntermediatePions;
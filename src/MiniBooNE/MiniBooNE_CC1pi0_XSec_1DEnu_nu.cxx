@@ -59,6 +59,7 @@ MiniBooNE_CC1pi0_XSec_1DEnu_nu::MiniBooNE_CC1pi0_XSec_1DEnu_nu(
                  double(fNEvents) * (14.08);
 
   // Plot Setup -------------------------------------------------------
+  fDeferLoading = true;
   SetDataFromTextFile(fSettings.GetDataInput());
   SetCorrelationFromTextFile(fSettings.GetCovarInput());
   SetShapeCovar();
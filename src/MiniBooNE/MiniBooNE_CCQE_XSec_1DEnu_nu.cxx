@@ -60,6 +60,7 @@ MiniBooNE_CCQE_XSec_1DEnu_nu::MiniBooNE_CCQE_XSec_1DEnu_nu(nuiskey samplekey) {
       GetEventHistogram()->Integral("width") * double(1E-38) / double(fNEvents) * (14.08/6.0);
 
   // Plot Setup -------------------------------------------------------
+  fDeferLoading = true;
   SetDataFromTextFile(fSettings.GetDataInput());
 
   // Final setup  ---------------------------------------------------
@@ -34,6 +34,8 @@
 #include "nusystematicsWeightEngine.h"
 #endif
 
+#include <algorithm>
+
 void FitWeight::AddRWEngine(int type) {
   NUIS_LOG(FIT, "Adding reweight engine " << type);
   switch (type) {
@@ -102,6 +104,11 @@ void FitWeight::AddRWEngine(int type) {
       NUIS_ABORT("CANNOT ADD RW Engine for unknown dial type: " << type);
       break;
   }
+
+  // Some engines don't name themselves, use the dial type for timing reports
+  if (fAllRW[type]->fCalcName.empty()) {
+    fAllRW[type]->fCalcName = FitBase::ConvDialType(type);
+  }
 }
 
 WeightEngineBase *FitWeight::GetRWEngine(int type) {
@@ -199,6 +206,13 @@ void FitWeight::Reconfigure(bool silent) {
   }
 }
 
+void FitWeight::ClearResponses() {
+  for (std::map<int, WeightEngineBase *>::iterator iter = fAllRW.begin();
+       iter != fAllRW.end(); iter++) {
+    (*iter).second->ClearResponses();
+  }
+}
+
 void FitWeight::SetDialValue(std::string name, double val) {
   // Add extra check, if name not found look for one with name in it.
   int nuisenum = fAllEnums[name];
@@ -279,12 +293,41 @@ double FitWeight::CalcWeight(BaseFitEvt *evt) {
   double rwweight = 1.0;
   for (std::map<int, WeightEngineBase *>::iterator iter = fAllRW.begin();
        iter != fAllRW.end(); iter++) {
+    TimingUtils::ScopedTimer timer(
+        (*iter).second->fTimers.ID(TimingUtils::kWeightCalc));
     double w = (*iter).second->CalcWeight(evt);
     rwweight *= w;
   }
   return rwweight;
 }
 
+void FitWeight::CalcWeights(InputHandlerBase *input, int first, int last,
+                            double *out) {
+  int nevt = last - first;
+  std::fill(out, out + nevt, 1.0);
+  if (nevt <= 0)
+    return;
+
+  std::vector<double> engineweights(nevt);
+  for (std::map<int, WeightEngineBase *>::iterator iter = fAllRW.begin();
+       iter != fAllRW.end(); iter++) {
+    TimingUtils::ScopedTimer timer(
+        (*iter).second->fTimers.ID(TimingUtils::kWeightCalc));
+    (*iter).second->CalcWeights(input, first, last, &engineweights[0]);
+    for (int i = 0; i < nevt; i++) {
+      out[i] *= engineweights[i];
+    }
+  }
+}
+
+bool FitWeight::DialAffectsEvent(int rwenum, EventMetadata const &meta) {
+  std::map<int, WeightEngineBase *>::iterator it =
+      fAllRW.find(Reweight::GetDialType(rwenum));
+  if (it == fAllRW.end())
+    return true;
+  return (*it).second->DialAffectsEvent(rwenum, meta);
+}
+
 void FitWeight::UpdateWeightEngine(const double *x) {
   size_t count = 0;
   for (std::vector<int>::iterator iter = fEnumList.begin();
@@ -25,6 +25,10 @@ public:
   // Update RW Engines
   void Reconfigure(bool silent = false);
 
+  /// Drop every engine's cached per-event responses, e.g. once the inputs
+  /// they were filled from are deleted
+  void ClearResponses();
+
   void SetDialValue(std::string name, double val);
   void SetDialValue(int rwenum, double val);
 
@@ -38,6 +42,14 @@ public:
   bool DialIncluded(int rwenum);
 
   double CalcWeight(BaseFitEvt* evt);
+
+  /// Product of every engine's weights for input entries [first, last)
+  /// into out[0..last-first), one engine batch and timer scope each. Each
+  /// engine reads the entries itself.
+  void CalcWeights(InputHandlerBase* input, int first, int last, double* out);
+
+  /// Whether dial rwenum can change the weight of events like meta
+  bool DialAffectsEvent(int rwenum, EventMetadata const& meta);
   bool HasRWDialChanged(const double* x) { return true; };
   // bool NeedsEventReWeight(const double* x);
 
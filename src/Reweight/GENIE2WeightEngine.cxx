@@ -394,3 +394,35 @@ double GENIEWeightEngine::CalcWeight(BaseFitEvt *evt) {
   // Return rw_weight
   return rw_weight;
 }
+
+void GENIEWeightEngine::CalcWeights(InputHandlerBase *input, int first,
+                                    int last, double *out) {
+  if (!fGenieRW) {
+    NUIS_ABORT("GENIE RW Not Found!" << fGenieRW);
+  }
+
+  // No dials, nothing to read
+  if (fEnumIndex.empty()) {
+    std::fill(out, out + (last - first), 1.0);
+    return;
+  }
+
+  for (int i = first; i < last; i++) {
+    BaseFitEvt *evt = ReadEvent(input, i);
+    if (!evt) {
+      NUIS_ABORT("evt not found : " << evt);
+    }
+
+    // Skip Non GENIE
+    if (evt->fType != kGENIE) {
+      out[i - first] = 1.0;
+      continue;
+    }
+
+    if (!(evt->genie_event) || !(evt->genie_event->event)) {
+      NUIS_ABORT("evt->genie_event GHepRecord not found for entry " << i);
+    }
+
+    out[i - first] = fGenieRW->CalcWeight(*(evt->genie_event->event));
+  }
+}
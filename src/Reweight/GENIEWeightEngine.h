@@ -15,6 +15,8 @@ using namespace genie::rew;
 #include "WeightEngineBase.h"
 #include "FitWeight.h"
 
+#include <algorithm>
+
 class GENIEWeightEngine : public WeightEngineBase {
 public:
 	GENIEWeightEngine(std::string name);
@@ -26,8 +28,16 @@ public:
 
 	void Reconfigure(bool silent = false);
 	double CalcWeight(BaseFitEvt* evt);
+	void CalcWeights(InputHandlerBase* input, int first, int last, double* out);
 	inline bool NeedsEventReWeight() { return true; };
 
+	/// Decided from the channel the GENIE dial names, see
+	/// Reweight::GeneratorDialAffectsMode
+	inline bool DialAffectsEvent(int nuisenum, EventMetadata const& meta) {
+		return Reweight::GeneratorDialAffectsMode(Reweight::ConvDial(nuisenum),
+		                                          meta.Mode);
+	};
+
 	std::vector<genie::rew::GSyst_t> fGENIESysts;
 	genie::rew::GReWeight* fGenieRW;  //!< Genie RW Object
 };
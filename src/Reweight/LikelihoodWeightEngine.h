@@ -5,6 +5,8 @@
 #include "GeneratorUtils.h"
 #include "WeightEngineBase.h"
 
+#include <algorithm>
+
 // Could probably just make a general weight engine for stuff like this...
 
 class LikelihoodWeightEngine : public WeightEngineBase {
@@ -18,7 +20,12 @@ class LikelihoodWeightEngine : public WeightEngineBase {
 		void SetDialValue(int rwenum, double val);
 		void Reconfigure(bool silent = false);
 		inline double CalcWeight(BaseFitEvt* evt) {return 1.0;};
+		inline void CalcWeights(InputHandlerBase* input, int first, int last,
+		                        double* out) {
+			std::fill(out, out + last - first, 1.0);
+		};
 		inline bool NeedsEventReWeight(){ return false; };
+		inline bool DialAffectsEvent(int nuisenum, EventMetadata const& meta) {return false;};
 
 		double GetDialValue(std::string name);
 };
@@ -39,29 +39,29 @@ MINERvAReWeight_QE::~MINERvAReWeight_QE(){};
 //*******************************************************
 
 //*******************************************************
-double MINERvAReWeight_QE::CalcWeight(BaseFitEvt *evt) {
+void MINERvAReWeight_QE::CalcResponses(BaseFitEvt *evt, double *responses) {
   //*******************************************************
+  responses[0] = 0.0;
+
   // Check GENIE
-  if (evt->fType != kGENIE) return 1.0;
+  if (evt->fType != kGENIE) return;
 
   // Extract the GENIE Record
   GHepRecord *ghep = static_cast<GHepRecord *>(evt->genie_event->event);
   const Interaction *interaction = ghep->Summary();
-  // const InitialState& init_state = interaction->InitState();
   const ProcessInfo &proc_info = interaction->ProcInfo();
-  // const Target& tgt = init_state.Tgt();
 
   // If the event is not QE this Calc doesn't handle it
-  if (!proc_info.IsQuasiElastic()) return 1.0;
+  if (!proc_info.IsQuasiElastic()) return;
 
-  // WEIGHT CALCULATIONS -------------
-  double w = 1.0;
-
-  // CCQE Dial
-  if (!proc_info.IsWeakCC()) w *= fCur_NormCCQE;
+  // Flag events the NormCCQE Dial applies to
+  if (!proc_info.IsWeakCC()) responses[0] = 1.0;
+}
 
-  // Return Combined Weight
-  return w;
+//*******************************************************
+double MINERvAReWeight_QE::CalcWeightFromResponses(double const *responses) {
+  //*******************************************************
+  return (responses[0] > 0.5) ? fCur_NormCCQE : 1.0;
 }
 
 //*******************************************************
@@ -113,30 +113,29 @@ MINERvAReWeight_MEC::~MINERvAReWeight_MEC(){};
 //*******************************************************
 
 //*******************************************************
-double MINERvAReWeight_MEC::CalcWeight(BaseFitEvt *evt) {
+void MINERvAReWeight_MEC::CalcResponses(BaseFitEvt *evt, double *responses) {
   //*******************************************************
+  responses[0] = 0.0;
+
   // Check GENIE
-  if (evt->fType != kGENIE)
-    return 1.0;
+  if (evt->fType != kGENIE) return;
 
   // Extract the GENIE Record
   GHepRecord *ghep = static_cast<GHepRecord *>(evt->genie_event->event);
   const Interaction *interaction = ghep->Summary();
-  // const InitialState& init_state = interaction->InitState();
   const ProcessInfo &proc_info = interaction->ProcInfo();
-  // const Target& tgt = init_state.Tgt();
 
   // If the event is not MEC this Calc doesn't handle it
-  if (!proc_info.IsMEC()) return 1.0;
+  if (!proc_info.IsMEC()) return;
 
-  // WEIGHT CALCULATIONS -------------
-  double w = 1.0;
-
-  // CCMEC Dial
-  if (!proc_info.IsWeakCC()) w *= fCur_NormCCMEC;
+  // Flag events the NormCCMEC Dial applies to
+  if (!proc_info.IsWeakCC()) responses[0] = 1.0;
+}
 
-  // Return Combined Weight
-  return w;
+//*******************************************************
+double MINERvAReWeight_MEC::CalcWeightFromResponses(double const *responses) {
+  //*******************************************************
+  return (responses[0] > 0.5) ? fCur_NormCCMEC : 1.0;
 }
 
 //*******************************************************
@@ -189,31 +188,29 @@ MINERvAReWeight_RES::~MINERvAReWeight_RES(){};
 //*******************************************************
 
 //*******************************************************
-double MINERvAReWeight_RES::CalcWeight(BaseFitEvt *evt) {
+void MINERvAReWeight_RES::CalcResponses(BaseFitEvt *evt, double *responses) {
   //*******************************************************
+  responses[0] = 0.0;
 
-  // std::cout << "Caculating RES" << std::endl;
   // Check GENIE
-  if (evt->fType != kGENIE) return 1.0;
+  if (evt->fType != kGENIE) return;
 
   // Extract the GENIE Record
   GHepRecord *ghep = static_cast<GHepRecord *>(evt->genie_event->event);
   const Interaction *interaction = ghep->Summary();
-  // const InitialState& init_state = interaction->InitState();
   const ProcessInfo &proc_info = interaction->ProcInfo();
-  // const Target& tgt = init_state.Tgt();
 
   // If the event is not RES this Calc doesn't handle it
-  if (!proc_info.IsResonant()) return 1.0;
+  if (!proc_info.IsResonant()) return;
 
-  // WEIGHT CALCULATIONS -------------
-  double w = 1.0;
-
-  // CCRES Dial
-  if (proc_info.IsWeakCC()) w *= fCur_NormCCRES;
+  // Flag events the NormCCRES Dial applies to
+  if (proc_info.IsWeakCC()) responses[0] = 1.0;
+}
 
-  // Return Combined Weight
-  return w;
+//*******************************************************
+double MINERvAReWeight_RES::CalcWeightFromResponses(double const *responses) {
+  //*******************************************************
+  return (responses[0] > 0.5) ? fCur_NormCCRES : 1.0;
 }
 
 //*******************************************************
@@ -325,32 +322,26 @@ RikRPA::~RikRPA() {
 }
 
 //*******************************************************
-double RikRPA::CalcWeight(BaseFitEvt *evt) {
+void RikRPA::CalcResponses(BaseFitEvt *evt, double *responses) {
   //*******************************************************
-  // LOG(FIT) << "Calculating RikRPA" << std::endl;
-  // Return 1.0 if not tweaked
-  if (!fTweaked)
-    return 1.0;
-
-  double w = 1.0;
+  for (int i = 0; i < kNResponses; i++) {
+    responses[i] = 0.0;
+  }
+  responses[0] = kNoRPA;
 
   // Extract the GENIE Record
   GHepRecord *ghep = static_cast<GHepRecord *>(evt->genie_event->event);
   const Interaction *interaction = ghep->Summary();
   const InitialState &init_state = interaction->InitState();
   const ProcessInfo &proc_info = interaction->ProcInfo();
-  // const Kinematics &   kine       = interaction->Kine();
-  // const XclsTag &      xcls       = interaction->ExclTag();
   const Target &tgt = init_state.Tgt();
 
-  // If not QE return 1.0
-  // LOG(FIT) << "RikRPA : Event QE = " << proc_info.IsQuasiElastic() <<
-  // std::endl;
+  // If not QE or RES on a nucleus there is nothing to apply
   if (!tgt.IsNucleus()) {
-    return 1.0;
+    return;
   }
   if (!proc_info.IsQuasiElastic() && !proc_info.IsResonant())
-    return 1.0;
+    return;
 
   // Extract Beam and Target PDG
   GHepParticle *neutrino = ghep->Probe();
@@ -363,7 +354,7 @@ double RikRPA::CalcWeight(BaseFitEvt *evt) {
   // Find the enum we need
   int calcenum = GetRPACalcEnum(bpdg, tpdg);
   if (calcenum == -1) 
-    return 1.0;
+    return;
 
   // Check we have the RPA Calc setup for this enum
   // if not, set it up at that point
@@ -381,53 +372,74 @@ double RikRPA::CalcWeight(BaseFitEvt *evt) {
   double q0 = fabs((k1 - k2).E());
   double q3 = fabs((k1 - k2).Vect().Mag());
   double Q2 = fabs((k1 - k2).Mag2());
+  responses[6] = Q2;
 
-  // Quasielastic
+  // Quasielastic, use q0-q3 and RPA Calculator to fill fWeights
   if (proc_info.IsQuasiElastic()) {
-
-    // Now use q0-q3 and RPA Calculator to fill fWeights
     rpacalc->getWeight(q0, q3, fEventWeights);
+    responses[0] = kQERPA;
+    for (int i = 0; i < 5; i++) {
+      responses[i + 1] = fEventWeights[i];
+    }
+  }
+
+  // Resonant Events, use Q2 and RESRPA Calculator
+  if (proc_info.IsResonant()) {
+    responses[0] = kRESRPA;
+    responses[1] = rpacalc->getWeight(Q2);
+  }
+}
+
+//*******************************************************
+double RikRPA::CalcWeightFromResponses(double const *responses) {
+  //*******************************************************
+  double w = 1.0;
+  double Q2 = responses[6];
+
+  // Quasielastic
+  if (responses[0] == kQERPA) {
+    double weights[5];
+    for (int i = 0; i < 5; i++) {
+      weights[i] = responses[i + 1];
+    }
 
     if (fApplyDial_RPACorrection) {
-      w *= fEventWeights[0]; // CV
+      w *= weights[0]; // CV
     }
 
     // Syst Application : kMINERvA_RikRPA_LowQ2
     if (fabs(fCurDial_RPALowQ2) > 0.0) {
-      double interpw = fEventWeights[0];
+      double interpw = weights[0];
 
       if (fCurDial_RPALowQ2 > 0.0 && Q2 < 2.0) {
-        interpw =
-            fEventWeights[0] - (fEventWeights[0] - fEventWeights[1]) *
+        interpw = weights[0] - (weights[0] - weights[1]) *
                                    fCurDial_RPALowQ2; // WLow+
       } else if (fCurDial_RPALowQ2 < 0.0 && Q2 < 2.0) {
-        interpw = fEventWeights[0] - (fEventWeights[2] - fEventWeights[0]) *
-                                         fCurDial_RPALowQ2; // WLow-
+        interpw = weights[0] - (weights[2] - weights[0]) *
+                                   fCurDial_RPALowQ2; // WLow-
       }
-      w *= interpw / fEventWeights[0]; // Div by CV again
+      w *= interpw / weights[0]; // Div by CV again
     }
 
     // Syst Application : kMINERvA_RikRPA_HighQ2
     if (fabs(fCurDial_RPAHighQ2) > 0.0) {
-      double interpw = fEventWeights[0];
+      double interpw = weights[0];
 
       if (fCurDial_RPAHighQ2 > 0.0) {
-        interpw = fEventWeights[0] - (fEventWeights[0] - fEventWeights[3]) *
+        interpw = weights[0] - (weights[0] - weights[3]) *
           fCurDial_RPAHighQ2; // WHigh+
 
       } else if (fCurDial_RPAHighQ2 < 0.0) {
-        interpw = fEventWeights[0] - (fEventWeights[4] - fEventWeights[0]) *
+        interpw = weights[0] - (weights[4] - weights[0]) *
           fCurDial_RPAHighQ2; // WHigh-
       }
-      w *= interpw / fEventWeights[0]; // Div by CV again
+      w *= interpw / weights[0]; // Div by CV again
     }
   }
 
   // Resonant Events
-  if (proc_info.IsResonant()) {
-
-    // Now use Q2 and RESRPA Calculator to fill fWeights
-    double CV = rpacalc->getWeight(Q2);
+  if (responses[0] == kRESRPA) {
+    double CV = responses[1];
 
     if (fApplyDial_RESRPACorrection) {
       w *= CV; // fEventWeights[0];  // CVa
@@ -468,7 +480,7 @@ double RikRPA::CalcWeight(BaseFitEvt *evt) {
 
   // LOG(FIT) << "RPA Weight = " << w << std::endl;
   return w;
-} // namespace reweight
+}
 
 //*******************************************************
 void RikRPA::SetDialValue(std::string name, double val) {
@@ -653,36 +665,31 @@ COHBrandon::COHBrandon() {
 
 COHBrandon::~COHBrandon() {};
 
-double COHBrandon::CalcWeight(BaseFitEvt* evt) {
+void COHBrandon::CalcResponses(BaseFitEvt* evt, double* responses) {
+
+  double pionE = -999.9;
+  responses[0] = pionE;
 
   // Check GENIE
-  if (evt->fType != kGENIE) return 1.0;
+  if (evt->fType != kGENIE) return;
 
   // Extract the GENIE Record
   GHepRecord* ghep = static_cast<GHepRecord*>(evt->genie_event->event);
   const Interaction* interaction = ghep->Summary();
-  //const InitialState& init_state = interaction->InitState();
   const ProcessInfo& proc_info = interaction->ProcInfo();
-  //const Target& tgt = init_state.Tgt();
 
-  // If the event is not QE this Calc doesn't handle it
+  // If the event is not COH this Calc doesn't handle it
   #if GENIE_VERSION >= 301
-  if (!proc_info.IsCoherentProduction()) return 1.0;
+  if (!proc_info.IsCoherentProduction()) return;
   #else
-  if (!proc_info.IsCoherent()) return 1.0;
+  if (!proc_info.IsCoherent()) return;
   #endif
 
-  // WEIGHT CALCULATIONS -------------
-  double w = 1.0;
-  double pionE = -999.9;
-
   TObjArrayIter piter(ghep);
   GHepParticle * p = 0;
-  //int ip = -1;
   while ( (p = (GHepParticle *) piter.Next()) ) {
     int pdgc = p->Pdg();
     int ist  = p->Status();
-    //      if (ghep->Particle(ip)->FirstMother()==0) continue;
     if (pdg::IsPseudoParticle(p->Pdg())) continue;
     if (ist == kIStStableFinalState) {
       if (pdgc == 211 || pdgc == -211 || pdgc == 111) {
@@ -691,7 +698,15 @@ double COHBrandon::CalcWeight(BaseFitEvt* evt) {
       }
     }
   }
-  //    std::cout << "Coherent Pion Energy : " << pionE << std::endl;
+
+  responses[0] = pionE;
+}
+
+double COHBrandon::CalcWeightFromResponses(double const* responses) {
+
+  // WEIGHT CALCULATIONS -------------
+  double w = 1.0;
+  double pionE = responses[0];
 
   // Apply Weight
   if (fApply_COHNorm && pionE > 0.0 && pionE < fCur_COHCut) {
@@ -764,27 +779,22 @@ WEnhancement::WEnhancement() {
 
 WEnhancement::~WEnhancement() {};
 
-double WEnhancement::CalcWeight(BaseFitEvt* evt) {
+void WEnhancement::CalcResponses(BaseFitEvt* evt, double* responses) {
+
+  responses[0] = 0.0;
+  responses[1] = 0.0;
 
   // Check GENIE
-  if (evt->fType != kGENIE) return 1.0;
+  if (evt->fType != kGENIE) return;
 
   // Extract the GENIE Record
   GHepRecord* ghep = static_cast<GHepRecord*>(evt->genie_event->event);
   const Interaction* interaction = ghep->Summary();
-  //const Kinematics &   kine       = interaction->Kine();
-  //const InitialState& init_state = interaction->InitState();
   const ProcessInfo& proc_info = interaction->ProcInfo();
-  //const Target& tgt = init_state.Tgt();
 
-  // If the event is not QE this Calc doesn't handle it
-  if (!proc_info.IsWeakCC()) return 1.0;
-  if (!proc_info.IsResonant()) return 1.0;
-  if (!fApply_Enhancement) return 1.0;
-
-  // WEIGHT CALCULATIONS -------------
-  double w = 1.0;
-  bool isCC1pi0AtVertex = false;
+  // If the event is not CC RES this Calc doesn't handle it
+  if (!proc_info.IsWeakCC()) return;
+  if (!proc_info.IsResonant()) return;
 
   // Get W
   GHepParticle* neutrino = ghep->Probe();
@@ -800,11 +810,9 @@ double WEnhancement::CalcWeight(BaseFitEvt* evt) {
   // The factor of 1000 is necessary for downstream functions
   const double m_p = PhysConst::mass_proton;
   double E_nu = k1.E();
-  //    double hadMass  = kine.W (true);
   double hadMass = sqrt(m_p * m_p + m_mu * m_mu - 2 * m_p * E_mu + \
       2 * E_nu * (m_p - E_mu + p_mu * cos(th_nu_mu)));
 
-
   // Determine if event is CC1pi0 at vertex
   TObjArrayIter piter(ghep);
   GHepParticle * p = 0;
@@ -823,11 +831,21 @@ double WEnhancement::CalcWeight(BaseFitEvt* evt) {
     }
   }
 
-  //    std::cout << "Npi0 = " << pi0 << std::endl;
-  isCC1pi0AtVertex = (pi0 == 1 && piother == 0);
+  responses[0] = (pi0 == 1 && piother == 0);
+  responses[1] = hadMass;
+}
+
+double WEnhancement::CalcWeightFromResponses(double const* responses) {
+
+  if (!fApply_Enhancement) return 1.0;
+
+  // WEIGHT CALCULATIONS -------------
+  double w = 1.0;
+  bool isCC1pi0AtVertex = (responses[0] > 0.5);
+  double hadMass = responses[1];
 
   // Apply Weight
-  if (fApply_Enhancement && isCC1pi0AtVertex) {
+  if (isCC1pi0AtVertex) {
 
     double enhancement = 1.0 + fCur_WNorm * (exp( -0.5 * pow((fCur_WMean - hadMass) / (fCur_WSigma), 2) ));
     w *= enhancement;
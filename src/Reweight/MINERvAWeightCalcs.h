@@ -21,11 +21,15 @@ namespace nuisance {
         MINERvAReWeight_QE();
         virtual ~MINERvAReWeight_QE();
 
-        double CalcWeight(BaseFitEvt* evt);
         void SetDialValue(std::string name, double val);
         void SetDialValue(int rwenum, double val);
         bool IsHandled(int rwenum);
 
+        /// {is NC QE}
+        int GetNResponses(){return 1;};
+        void CalcResponses(BaseFitEvt* evt, double* responses);
+        double CalcWeightFromResponses(double const* responses);
+
         double fTwk_NormCCQE;
         double fCur_NormCCQE;
         double fDef_NormCCQE;
@@ -40,11 +44,15 @@ namespace nuisance {
         MINERvAReWeight_MEC();
         virtual ~MINERvAReWeight_MEC();
 
-        double CalcWeight(BaseFitEvt* evt);
         void SetDialValue(std::string name, double val);
         void SetDialValue(int rwenum, double val);
         bool IsHandled(int rwenum);
 
+        /// {is NC MEC}
+        int GetNResponses(){return 1;};
+        void CalcResponses(BaseFitEvt* evt, double* responses);
+        double CalcWeightFromResponses(double const* responses);
+
         double fTwk_NormCCMEC;
         double fCur_NormCCMEC;
         double fDef_NormCCMEC;
@@ -58,11 +66,15 @@ namespace nuisance {
         MINERvAReWeight_RES();
         virtual ~MINERvAReWeight_RES();
 
-        double CalcWeight(BaseFitEvt* evt);
         void SetDialValue(std::string name, double val);
         void SetDialValue(int rwenum, double val);
         bool IsHandled(int rwenum);
 
+        /// {is CC RES}
+        int GetNResponses(){return 1;};
+        void CalcResponses(BaseFitEvt* evt, double* responses);
+        double CalcWeightFromResponses(double const* responses);
+
         double fTwk_NormCCRES;
         double fCur_NormCCRES;
         double fDef_NormCCRES;
@@ -77,11 +89,15 @@ namespace nuisance {
         RikRPA();
         ~RikRPA();
 
-        double CalcWeight(BaseFitEvt* evt);
         void SetDialValue(std::string name, double val);
         void SetDialValue(int rwenum, double val);
         bool IsHandled(int rwenum);
 
+        /// {process, 5 RPA weights at (q0, q3) or the RES CV, Q2}
+        int GetNResponses(){return fTweaked ? kNResponses : 0;};
+        void CalcResponses(BaseFitEvt* evt, double* responses);
+        double CalcWeightFromResponses(double const* responses);
+
         void SetupRPACalculator(int calcenum);
         int GetRPACalcEnum(int bpdg, int tpdg);
 
@@ -112,6 +128,9 @@ namespace nuisance {
         double* fEventWeights;
         bool fTweaked;
 
+        const static int kNResponses = 7;
+        enum rpaprocenums { kNoRPA, kQERPA, kRESRPA };
+
         const static int kMaxCalculators = 10;
         enum rpacalcenums {
           kNuMuC12,
@@ -134,11 +153,15 @@ namespace nuisance {
         COHBrandon();
         ~COHBrandon();
 
-        double CalcWeight(BaseFitEvt* evt);
         void SetDialValue(std::string name, double val);
         void SetDialValue(int rwenum, double val);
         bool IsHandled(int rwenum);
 
+        /// {leading pion energy, -999.9 if not coherent}
+        int GetNResponses(){return fApply_COHNorm ? 1 : 0;};
+        void CalcResponses(BaseFitEvt* evt, double* responses);
+        double CalcWeightFromResponses(double const* responses);
+
         bool fApply_COHNorm;
 
         double fDef_COHNorm;
@@ -157,11 +180,15 @@ namespace nuisance {
         WEnhancement();
         ~WEnhancement();
 
-        double CalcWeight(BaseFitEvt* evt);
         void SetDialValue(std::string name, double val);
         void SetDialValue(int rwenum, double val);
         bool IsHandled(int rwenum);
 
+        /// {is CC1pi0 at the vertex, hadronic mass}
+        int GetNResponses(){return fApply_Enhancement ? 2 : 0;};
+        void CalcResponses(BaseFitEvt* evt, double* responses);
+        double CalcWeightFromResponses(double const* responses);
+
         bool fTweaked;
 
         bool fApply_Enhancement;
@@ -52,6 +52,10 @@ public:
   };
   bool NeedsEventReWeight() { return false; };
 
+  bool DialAffectsEvent(int rwenum, EventMetadata const &meta) {
+    return ModeToDial(abs(meta.Mode)) == Reweight::RemoveDialType(rwenum);
+  };
+
   double GetDialValue(std::string name) {
     int rwenum = Reweight::ConvDial(name, kMODENORM);
     int mode = Reweight::RemoveDialType(rwenum);
@@ -6,6 +6,8 @@
 
 #include "WeightUtils.h"
 
+#include <algorithm>
+
 NEUTWeightEngine::NEUTWeightEngine(std::string name) {
 
   std::string neut_card = FitPar::Config().GetParS("NEUT_CARD");
@@ -48,6 +50,8 @@ void NEUTWeightEngine::IncludeDial(std::string name, double startval) {
   if (startval != UNDEF_DIAL_VALUE) {
     SetDialValue(nuisenum, startval);
   }
+
+  BuildModeMask();
 }
 
 void NEUTWeightEngine::SetDialValue(int nuisenum, double val) {
@@ -77,19 +81,33 @@ void NEUTWeightEngine::Reconfigure(bool silent) {
     StartTalking();
 }
 
-double NEUTWeightEngine::CalcWeight(BaseFitEvt *evt) {
-  double rw_weight = 1.0;
-
+bool NEUTWeightEngine::IsReached(BaseFitEvt *evt) {
   // Skip Non-NEUT
   if (evt->fType != kNEUT) {
+    return false;
+  }
+
+  // Modes none of our dials reach stay nominal, skip the common block fill.
+  // Lightweight reads leave evt->Mode stale so use the vector's own mode.
+  return ModeReached(evt->fNeutVect->Mode);
+}
+
+double NEUTWeightEngine::CalcNEUTWeight(BaseFitEvt *evt) {
+  neut::CommonBlockIFace::Get().ReadVect(evt->fNeutVect);
+  return fNeutRW->CalcWeight();
+}
+
+double NEUTWeightEngine::CalcWeight(BaseFitEvt *evt) {
+  if (!IsReached(evt)) {
+    if (evt->fType == kNEUT) {
+      WarnModeSkip(evt->fNeutVect->Mode);
+    }
     return 1.0;
   }
 
   // Hush now
   StopTalking();
-
-  neut::CommonBlockIFace::Get().ReadVect(evt->fNeutVect);
-  rw_weight = fNeutRW->CalcWeight();
+  double rw_weight = CalcNEUTWeight(evt);
   // Speak Now
   StartTalking();
 
@@ -101,3 +119,40 @@ double NEUTWeightEngine::CalcWeight(BaseFitEvt *evt) {
   // Return rw_weight
   return rw_weight;
 }
+
+void NEUTWeightEngine::CalcWeights(InputHandlerBase *input, int first,
+                                   int last, double *out) {
+  if (fEnumIndex.empty()) {
+    std::fill(out, out + (last - first), 1.0);
+    return;
+  }
+
+  // Hush once for the whole batch, warn about skipped modes after
+  int skipmode = 0;
+  bool skipped = false;
+  StopTalking();
+  for (int i = first; i < last; i++) {
+    BaseFitEvt *evt = ReadEvent(input, i);
+    if (IsReached(evt)) {
+      out[i - first] = CalcNEUTWeight(evt);
+    } else {
+      out[i - first] = 1.0;
+      if (!skipped && evt->fType == kNEUT) {
+        skipped = true;
+        skipmode = evt->fNeutVect->Mode;
+      }
+    }
+  }
+  StartTalking();
+
+  if (skipped) {
+    WarnModeSkip(skipmode);
+  }
+
+  for (int i = 0; i < last - first; i++) {
+    if (!std::isnormal(out[i])) {
+      NUIS_ERR(WRN, "T2KReWeight returned weight: " << out[i]);
+      out[i] = 0;
+    }
+  }
+}
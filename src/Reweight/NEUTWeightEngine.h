@@ -1,6 +1,7 @@
 #pragma once
 
 #include "WeightEngineBase.h"
+#include "WeightUtils.h"
 
 #ifdef NEUTReWeight_LEGACY_API_ENABLED
 #include "NReWeight.h"
@@ -28,11 +29,25 @@ public:
   void Reconfigure(bool silent = false);
 
   double CalcWeight(BaseFitEvt *evt);
+  void CalcWeights(InputHandlerBase *input, int first, int last, double *out);
 
   inline bool NeedsEventReWeight() { return true; };
 
+  /// Decided from the channel the NEUT dial names, see
+  /// Reweight::GeneratorDialAffectsMode
+  inline bool DialAffectsEvent(int nuisenum, EventMetadata const &meta) {
+    return Reweight::GeneratorDialAffectsMode(Reweight::ConvDial(nuisenum),
+                                              meta.Mode);
+  };
+
 #ifdef NEUTReWeight_LEGACY_API_ENABLED
   std::vector<neut::rew::NSyst_t> fNEUTSysts;
 #endif
   std::unique_ptr<neut::rew::NReWeight> fNeutRW;
+
+private:
+  /// Whether evt is a NEUT event in a mode one of our dials reaches
+  bool IsReached(BaseFitEvt *evt);
+  /// Fills the common blocks from evt and weights them, output not hushed
+  double CalcNEUTWeight(BaseFitEvt *evt);
 };
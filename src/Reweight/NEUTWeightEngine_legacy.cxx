@@ -157,6 +157,8 @@ void NEUTWeightEngine::IncludeDial(std::string name, double startval) {
   if (startval != UNDEF_DIAL_VALUE) {
     SetDialValue(nuisenum, startval);
   }
+
+  BuildModeMask();
 }
 
 void NEUTWeightEngine::SetDialValue(int nuisenum, double val) {
@@ -200,15 +202,17 @@ void NEUTWeightEngine::Reconfigure(bool silent) {
     StartTalking();
 }
 
-double NEUTWeightEngine::CalcWeight(BaseFitEvt *evt) {
-  double rw_weight = 1.0;
+bool NEUTWeightEngine::IsReached(BaseFitEvt *evt) {
   // Skip Non NEUT
   if (evt->fType != kNEUT)
-    return 1.0;
+    return false;
 
-  // Hush now
-  StopTalking();
+  // Modes none of our dials reach stay nominal, skip the common block fill.
+  // Lightweight reads leave evt->Mode stale so use the vector's own mode.
+  return ModeReached(evt->fNeutVect->Mode);
+}
 
+double NEUTWeightEngine::CalcNEUTWeight(BaseFitEvt *evt) {
 #ifdef NEUT_BUILTIN_FILL_NEUT_COMMONS
   // Fill NEUT Common blocks
   NEUTUtils::FillNeutCommons(evt->fNeutVect);
@@ -217,8 +221,19 @@ double NEUTWeightEngine::CalcWeight(BaseFitEvt *evt) {
 #endif
 
   // Call Weight calculation
-  rw_weight = fNeutRW->CalcWeight();
+  return fNeutRW->CalcWeight();
+}
 
+double NEUTWeightEngine::CalcWeight(BaseFitEvt *evt) {
+  if (!IsReached(evt)) {
+    if (evt->fType == kNEUT)
+      WarnModeSkip(evt->fNeutVect->Mode);
+    return 1.0;
+  }
+
+  // Hush now
+  StopTalking();
+  double rw_weight = CalcNEUTWeight(evt);
   // Speak Now
   StartTalking();
 
@@ -230,3 +245,40 @@ double NEUTWeightEngine::CalcWeight(BaseFitEvt *evt) {
   // Return rw_weight
   return rw_weight;
 }
+
+void NEUTWeightEngine::CalcWeights(InputHandlerBase *input, int first,
+                                   int last, double *out) {
+  if (fEnumIndex.empty()) {
+    std::fill(out, out + (last - first), 1.0);
+    return;
+  }
+
+  // Hush once for the whole batch, warn about skipped modes after
+  int skipmode = 0;
+  bool skipped = false;
+  StopTalking();
+  for (int i = first; i < last; i++) {
+    BaseFitEvt *evt = ReadEvent(input, i);
+    if (IsReached(evt)) {
+      out[i - first] = CalcNEUTWeight(evt);
+    } else {
+      out[i - first] = 1.0;
+      if (!skipped && evt->fType == kNEUT) {
+        skipped = true;
+        skipmode = evt->fNeutVect->Mode;
+      }
+    }
+  }
+  StartTalking();
+
+  if (skipped) {
+    WarnModeSkip(skipmode);
+  }
+
+  for (int i = 0; i < last - first; i++) {
+    if (!std::isnormal(out[i])) {
+      NUIS_ERR(WRN, "NEUT returned weight: " << out[i]);
+      out[i] = 0;
+    }
+  }
+}
@@ -7,10 +7,64 @@
 
 #include "WeightEngineBase.h"
 
+#include "MemoryUtils.h"
+
 #include <cmath>
 
 using namespace Reweight;
 
+double NUISANCEWeightCalc::CalcWeight(BaseFitEvt *evt) {
+  int nresp = GetNResponses();
+  if (!nresp)
+    return 1.0;
+
+  std::vector<double> responses(nresp);
+  CalcResponses(evt, &responses[0]);
+  return CalcWeightFromResponses(&responses[0]);
+}
+
+double NUISANCEWeightCalc::GetWeight(BaseFitEvt *evt) {
+  int nresp = GetNResponses();
+  if (!nresp || !fCacheResponses || evt->fEntry < 0)
+    return CalcWeight(evt);
+
+  ResponseCache &cache = fResponseCache[evt->fEventID];
+  size_t entry = evt->fEntry;
+  if (entry >= cache.filled.size()) {
+    size_t nentries = entry + 1;
+    double extra = (nentries - cache.filled.size()) *
+                   (nresp * sizeof(double) + 0.125);
+    if (!MemoryUtils::Fits(extra)) {
+      if (!cache.filled.size()) {
+        fResponseCache.erase(evt->fEventID);
+      }
+      return CalcWeight(evt);
+    }
+
+    cache.filled.resize(nentries, false);
+    cache.values.resize(nentries * nresp);
+    fCacheBytes += extra;
+    MemoryUtils::SetUsage(MemoryUtils::kWeightResponses, fCacheOwner,
+                          fCacheBytes);
+  }
+
+  double *responses = &cache.values[entry * nresp];
+  if (!cache.filled[entry]) {
+    CalcResponses(evt, responses);
+    cache.filled[entry] = true;
+  }
+
+  return CalcWeightFromResponses(responses);
+}
+
+void NUISANCEWeightCalc::ClearResponses() {
+  std::map<UInt_t, ResponseCache>().swap(fResponseCache);
+  if (fCacheBytes > 0) {
+    fCacheBytes = 0;
+    MemoryUtils::SetUsage(MemoryUtils::kWeightResponses, fCacheOwner, 0);
+  }
+}
+
 ModeNormCalc::ModeNormCalc() { fNormRES = 1.0; }
 
 double ModeNormCalc::CalcWeight(BaseFitEvt *evt) {
@@ -48,6 +102,11 @@ bool ModeNormCalc::IsHandled(int rwenum) {
   }
 }
 
+bool ModeNormCalc::AffectsEvent(int rwenum, EventMetadata const &meta) {
+  int mode = abs(meta.Mode);
+  return (mode == 11 or mode == 12 or mode == 13);
+}
+
 //*****************************************************************************
 MINOSRPA::MINOSRPA() {
 
@@ -317,20 +376,26 @@ BeRPACalc::BeRPACalc()
     // U = 1.2
 }
 
-double BeRPACalc::CalcWeight(BaseFitEvt *evt) {
+void BeRPACalc::CalcResponses(BaseFitEvt *evt, double *responses) {
   int mode = abs(evt->Mode);
-  double w = 1.0;
-  if (nParams == 0) {
-    return w;
-  }
 
   // Get Q2
   // Get final state lepton
+  responses[0] = (mode == 1);
+  responses[1] = 0.0;
   if (mode == 1) {
     FitEvent *fevt = static_cast<FitEvent*>(evt);
-    double Q2 = fevt->GetQ2();
-    // Only CCQE events
-    w *= calcRPA(Q2, fBeRPA_A, fBeRPA_B, fBeRPA_D, fBeRPA_E, fBeRPA_U);
+    responses[1] = fevt->GetQ2();
+  }
+}
+
+double BeRPACalc::CalcWeightFromResponses(double const *responses) {
+  double w = 1.0;
+
+  // Only CCQE events
+  if (responses[0] > 0.5) {
+    w *= calcRPA(responses[1], fBeRPA_A, fBeRPA_B, fBeRPA_D, fBeRPA_E,
+                 fBeRPA_U);
   }
 
   return w;
@@ -751,6 +816,26 @@ void GaussianModeCorr::SetDialValue(int rwenum, double val) {
   }
 }
 
+bool GaussianModeCorr::AffectsEvent(int rwenum, EventMetadata const &meta) {
+  int curenum = rwenum % NUIS_DIAL_OFFSET;
+  int mode = abs(meta.Mode);
+
+  if (curenum >= kGaussianCorr_CCQE_norm && curenum <= kGaussianCorr_CCQE_Wq3)
+    return (mode == 1);
+  if ((curenum >= kGaussianCorr_2p2h_norm &&
+       curenum <= kGaussianCorr_2p2h_Wq3) ||
+      (curenum >= kGaussianCorr_2p2h_PPandNN_norm &&
+       curenum <= kGaussianCorr_2p2h_PPandNN_Wq3) ||
+      (curenum >= kGaussianCorr_2p2h_NP_norm &&
+       curenum <= kGaussianCorr_2p2h_NP_Wq3))
+    return (mode == 2);
+  if (curenum >= kGaussianCorr_CC1pi_norm && curenum <= kGaussianCorr_CC1pi_Wq3)
+    return (mode >= 11 && mode <= 13);
+
+  // AllowSuppression reaches every mode
+  return true;
+}
+
 bool GaussianModeCorr::IsHandled(int rwenum) {
   int curenum = rwenum % NUIS_DIAL_OFFSET;
   switch (curenum) {
@@ -3,6 +3,7 @@
 
 #include "BaseFitEvt.h"
 #include "BeRPA.h"
+#include "WeightEngineBase.h"
 #ifdef GENIE_ENABLED
 #ifdef GENIE3_API_ENABLED
 #include "Framework/Conventions/Units.h"
@@ -26,21 +27,56 @@ using namespace genie;
 
 class NUISANCEWeightCalc {
   public:
-    NUISANCEWeightCalc() {};
+    NUISANCEWeightCalc() : fCacheResponses(false), fCacheBytes(0) {};
     virtual ~NUISANCEWeightCalc() {};
 
-    virtual double CalcWeight(BaseFitEvt* evt){return 1.0;};
+    /// Weight for evt at the current dials. Calcs that provide responses
+    /// get this for free from CalcResponses and CalcWeightFromResponses.
+    virtual double CalcWeight(BaseFitEvt* evt);
     virtual void SetDialValue(std::string name, double val){};
     virtual void SetDialValue(int rwenum, double val){};
     virtual bool IsHandled(int rwenum){return false;};
 
+    /// False only if handled dial rwenum can never change the weight of
+    /// events like meta, see WeightEngineBase::DialAffectsEvent
+    virtual bool AffectsEvent(int rwenum, EventMetadata const& meta){return true;};
+
     virtual void Print(){};
 
+    /// Number of dial independent values per event this calc can work its
+    /// weight out from, 0 if it always needs the event itself. Must not
+    /// change between non-zero values.
+    virtual int GetNResponses(){return 0;};
+
+    /// Fill the GetNResponses() values for evt
+    virtual void CalcResponses(BaseFitEvt* evt, double* responses){};
+
+    /// Weight at the current dials from values filled by CalcResponses
+    virtual double CalcWeightFromResponses(double const* responses){return 1.0;};
+
+    /// CalcWeight, with the responses calculated once per input entry and
+    /// kept for later reads of the same entry
+    double GetWeight(BaseFitEvt* evt);
+
+    /// Drop all cached responses
+    void ClearResponses();
+
     std::map<std::string, int> fDialNameIndex;
     std::map<int, int> fDialEnumIndex;
     std::vector<double> fDialValues;
 
     std::string fName;
+    bool fCacheResponses; ///< Keep responses between reads of an entry
+    std::string fCacheOwner; ///< MemoryUtils owner of the cache
+
+  private:
+    /// Responses of every entry read into one event object
+    struct ResponseCache {
+      std::vector<double> values;
+      std::vector<bool> filled;
+    };
+    std::map<UInt_t, ResponseCache> fResponseCache; ///< By BaseFitEvt::fEventID
+    double fCacheBytes; ///< Bytes held by fResponseCache
 };
 
 class ModeNormCalc : public NUISANCEWeightCalc {
@@ -52,6 +88,7 @@ class ModeNormCalc : public NUISANCEWeightCalc {
     void SetDialValue(std::string name, double val);
     void SetDialValue(int rwenum, double val);
     bool IsHandled(int rwenum);
+    bool AffectsEvent(int rwenum, EventMetadata const& meta);
 
     double fNormRES;
 };
@@ -111,11 +148,15 @@ class BeRPACalc : public NUISANCEWeightCalc {
     BeRPACalc();
     ~BeRPACalc(){};
 
-    double CalcWeight(BaseFitEvt* evt);
     void SetDialValue(std::string name, double val);
     void SetDialValue(int rwenum, double val);
     bool IsHandled(int rwenum);
 
+    /// {is CCQE, Q2}
+    int GetNResponses(){return nParams ? 2 : 0;};
+    void CalcResponses(BaseFitEvt* evt, double* responses);
+    double CalcWeightFromResponses(double const* responses);
+
   private:
     // Parameter values
     double fBeRPA_A;
@@ -156,6 +197,7 @@ class GaussianModeCorr : public NUISANCEWeightCalc {
     void SetDialValue(std::string name, double val);
     void SetDialValue(int rwenum, double val);
     bool IsHandled(int rwenum);
+    bool AffectsEvent(int rwenum, EventMetadata const& meta);
     double GetGausWeight(double q0, double q3, double vals[]);
     // Set the Gaussian method (tilt-shift or normal Gaussian parameters)
     void SetMethod(bool method);
@@ -45,6 +45,14 @@ NUISANCEWeightEngine::NUISANCEWeightEngine(std::string name) {
 #endif
 #endif
 
+  // Dial independent per-event responses are kept between reads
+  bool cacheresponses = FitPar::Config().GetParB("CacheWeightResponses");
+  for (size_t i = 0; i < fWeightCalculators.size(); i++) {
+    fWeightCalculators[i]->fCacheResponses = cacheresponses;
+    fWeightCalculators[i]->fCacheOwner =
+        "NUISANCECalc" + GeneralUtils::IntToStr(i);
+  }
+
   // Set Abs Twk Config
   fIsAbsTwk = true;
 };
@@ -98,6 +106,12 @@ void NUISANCEWeightEngine::SetDialValue(std::string name, double val) {
   }
 }
 
+void NUISANCEWeightEngine::ClearResponses() {
+  for (size_t i = 0; i < fWeightCalculators.size(); i++) {
+    fWeightCalculators[i]->ClearResponses();
+  }
+}
+
 void NUISANCEWeightEngine::Reconfigure(bool silent) {
   for (size_t i = 0; i < fNUISANCEEnums.size(); i++) {
     // Is this parameter handled
@@ -131,9 +145,29 @@ double NUISANCEWeightEngine::CalcWeight(BaseFitEvt *evt) {
        iter != fWeightCalculators.end(); iter++) {
     NUISANCEWeightCalc *nuiscalc = static_cast<NUISANCEWeightCalc *>(*iter);
 
-    rw_weight *= nuiscalc->CalcWeight(evt);
+    rw_weight *= nuiscalc->GetWeight(evt);
   }
 
   // Return rw_weight
   return rw_weight;
 }
+
+bool NUISANCEWeightEngine::DialAffectsEvent(int nuisenum,
+                                            EventMetadata const &meta) {
+  std::map<int, std::vector<size_t> >::iterator it = fEnumIndex.find(nuisenum);
+  if (it == fEnumIndex.end())
+    return true;
+
+  // Only the calcs handling one of the dial's parts can move the weight
+  std::vector<size_t> const &indices = it->second;
+  for (size_t i = 0; i < indices.size(); i++) {
+    int singleenum = fNUISANCEEnums[indices[i]];
+    for (size_t j = 0; j < fWeightCalculators.size(); j++) {
+      NUISANCEWeightCalc *nuiscalc = fWeightCalculators[j];
+      if (nuiscalc->IsHandled(singleenum) &&
+          nuiscalc->AffectsEvent(singleenum, meta))
+        return true;
+    }
+  }
+  return false;
+}
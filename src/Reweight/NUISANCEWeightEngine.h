@@ -21,6 +21,8 @@ public:
 	void Reconfigure(bool silent = false);
 
 	double CalcWeight(BaseFitEvt* evt);
+	bool DialAffectsEvent(int nuisenum, EventMetadata const& meta);
+	void ClearResponses();
 
 	inline bool NeedsEventReWeight() { return true; };
 
@@ -5,6 +5,8 @@
 #include "GeneratorUtils.h"
 #include "WeightEngineBase.h"
 
+#include <algorithm>
+
 class SampleNormEngine : public WeightEngineBase {
 	public:
 		SampleNormEngine(std::string name);
@@ -16,7 +18,12 @@ class SampleNormEngine : public WeightEngineBase {
 		
 		void Reconfigure(bool silent = false);
 		inline double CalcWeight(BaseFitEvt* evt) {return 1.0;};
+		inline void CalcWeights(InputHandlerBase* input, int first, int last,
+		                        double* out) {
+			std::fill(out, out + last - first, 1.0);
+		};
 		inline bool NeedsEventReWeight(){ return false; };
+		inline bool DialAffectsEvent(int nuisenum, EventMetadata const& meta) {return false;};
 
 		double GetDialValue(std::string name);
 };
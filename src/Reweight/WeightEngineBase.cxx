@@ -1,5 +1,15 @@
 #include "WeightEngineBase.h"
 
+#include "InputHandler.h"
+#include "NuisConfig.h"
+
+WeightEngineBase::WeightEngineBase() {
+  fTimers.SetOwner(&fCalcName);
+  fFullEventReads = FitPar::Config().GetParB("FullEventOnSignalReconfigure");
+  fUseModeMask = FitPar::Config().GetParB("DialRelevanceMasks");
+  fWarnedModeSkip = false;
+}
+
 bool WeightEngineBase::IsDialIncluded(std::string name) {
   return (fNameIndex.find(name) != fNameIndex.end());
 }
@@ -8,6 +18,54 @@ bool WeightEngineBase::IsDialIncluded(int nuisenum) {
   return (fEnumIndex.find(nuisenum) != fEnumIndex.end());
 }
 
+void WeightEngineBase::CalcWeights(InputHandlerBase *input, int first,
+                                   int last, double *out) {
+  for (int i = first; i < last; i++) {
+    out[i - first] = CalcWeight(ReadEvent(input, i));
+  }
+}
+
+BaseFitEvt *WeightEngineBase::ReadEvent(InputHandlerBase *input, int entry) {
+  TimingUtils::ScopedTimer timer(input->fTimers.ID(TimingUtils::kInputRead));
+  if (fFullEventReads) {
+    return input->GetNuisanceEvent(entry);
+  }
+  return input->GetBaseEvent(entry);
+}
+
+bool WeightEngineBase::ModeReached(int mode) const {
+  size_t index = abs(mode);
+  return (index >= fModeReached.size()) || fModeReached[index];
+}
+
+void WeightEngineBase::BuildModeMask() {
+  if (!fUseModeMask) {
+    fModeReached.clear();
+    return;
+  }
+
+  // NEUT style modes stop below 100
+  fModeReached.assign(100, false);
+  for (size_t m = 0; m < fModeReached.size(); m++) {
+    EventMetadata meta;
+    meta.Mode = m;
+    for (std::map<int, std::vector<size_t> >::iterator it = fEnumIndex.begin();
+         it != fEnumIndex.end() && !fModeReached[m]; ++it) {
+      fModeReached[m] = DialAffectsEvent((*it).first, meta);
+    }
+  }
+}
+
+void WeightEngineBase::WarnModeSkip(int mode) {
+  if (fWarnedModeSkip)
+    return;
+  fWarnedModeSkip = true;
+  NUIS_ERR(WRN, fCalcName << " keeps mode " << mode
+                          << " events, and any others none of its dials "
+                             "reach, at weight 1. Set DialRelevanceMasks=0 "
+                             "to reweight every event.");
+}
+
 double WeightEngineBase::GetDialValue(std::string name) {
   if (!IsDialIncluded(name)) {
     NUIS_ABORT("Dial " << name << " not included in " << fCalcName);
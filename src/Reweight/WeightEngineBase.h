@@ -4,6 +4,7 @@
 #include "BaseFitEvt.h"
 #include "FitLogger.h"
 #include "FitUtils.h"
+#include "TimingUtils.h"
 
 #include <cmath>
 #include <cstdlib>
@@ -20,9 +21,17 @@
 #define UNDEF_DIAL_VALUE -9999.9
 #define NUIS_DIAL_OFFSET 100000
 
+/// Event properties that decide which dials can move an event's weight,
+/// cached once per signal event so relevance checks never re-read inputs.
+struct EventMetadata {
+  int Mode;
+};
+
+class InputHandlerBase;
+
 class WeightEngineBase {
  public:
-  WeightEngineBase(){};
+  WeightEngineBase();
   virtual ~WeightEngineBase(){};
 
   // Functions requiring Override
@@ -42,6 +51,33 @@ class WeightEngineBase {
   virtual double CalcWeight(BaseFitEvt* evt) { return 1.0; };
   virtual bool NeedsEventReWeight() = 0;
 
+  /// Weights of input entries [first, last) into out[0..last-first). The
+  /// engine reads each entry itself through ReadEvent, so it can check its
+  /// state and hush generator output once per batch. Defaults to one
+  /// CalcWeight per entry.
+  virtual void CalcWeights(InputHandlerBase* input, int first, int last,
+                           double* out);
+
+  /// Drop any per-event values cached between reweights. Called when the
+  /// event objects they are keyed on go away.
+  virtual void ClearResponses(){};
+
+  /// False only if dial nuisenum can never change the weight of events
+  /// like meta. Fits skip reweighting such events when only those dials
+  /// move, so when in doubt return true.
+  virtual bool DialAffectsEvent(int nuisenum, EventMetadata const& meta) {
+    return true;
+  };
+
+  /// Whether any included dial can reach events of this mode, from the
+  /// table BuildModeMask fills. True for modes outside the table.
+  bool ModeReached(int mode) const;
+
+  /// Refill fModeReached through DialAffectsEvent. Engines call it after
+  /// including a dial so CalcWeight can skip unreached modes cheaply.
+  /// Leaves the table empty unless DialRelevanceMasks is set.
+  void BuildModeMask();
+
   std::string GetNameFromEnum(int nuisenum);
 
   bool fHasChanged;
@@ -50,8 +86,25 @@ class WeightEngineBase {
   std::vector<double> fValues;
   std::map<int, std::vector<size_t> > fEnumIndex;
   std::map<std::string, std::vector<size_t> > fNameIndex;
+  std::vector<bool> fModeReached; ///< Indexed by |mode|, see ModeReached
 
   std::string fCalcName;
+
+  /// Hot-path timers for this engine, keyed by fCalcName
+  TimingUtils::TimerSet fTimers;
+
+ protected:
+  /// Read entry of input for CalcWeights, as the full NUISANCE event if
+  /// FullEventOnSignalReconfigure is set, else the lightweight base event
+  BaseFitEvt* ReadEvent(InputHandlerBase* input, int entry);
+
+  /// Warn, once per engine, that events of mode are being kept at weight 1
+  /// because none of our dials reach them
+  void WarnModeSkip(int mode);
+
+  bool fFullEventReads; ///< FullEventOnSignalReconfigure when built
+  bool fUseModeMask;    ///< DialRelevanceMasks when built
+  bool fWarnedModeSkip; ///< WarnModeSkip has reported
 };
 
 #endif
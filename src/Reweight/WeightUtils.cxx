@@ -619,3 +619,40 @@ std::string Reweight::ConvDial(int nuisenum) {
   NUIS_LOG(FIT, "Cannot find dial with enum = " << nuisenum);
   return "";
 }
+
+bool Reweight::GeneratorDialAffectsMode(std::string const &name, int mode) {
+  std::vector<std::string> allnames = GeneralUtils::ParseToStr(name, ",");
+  if (allnames.empty())
+    return true;
+  mode = abs(mode);
+
+  for (size_t i = 0; i < allnames.size(); i++) {
+    std::string const &dial = allnames[i];
+    bool reaches = true;
+
+    // Non-resonant background dials act on DIS-like events, keep them
+    // reaching everything. NEUT CCQE dials also feed NC elastic.
+    if (dial.find("NonRES") != std::string::npos) {
+      reaches = true;
+    } else if (dial.find("CCQE") != std::string::npos) {
+      reaches = (mode == 1 || mode == 51 || mode == 52);
+    } else if (dial.find("NCEL") != std::string::npos) {
+      reaches = (mode == 51 || mode == 52);
+    } else if (dial.find("CCRES") != std::string::npos) {
+      reaches = (mode >= 11 && mode <= 25);
+    } else if (dial.find("NCRES") != std::string::npos) {
+      reaches = (mode >= 31 && mode <= 45);
+    } else if (dial.find("RES") != std::string::npos) {
+      reaches = (mode >= 11 && mode <= 25) || (mode >= 31 && mode <= 45);
+    } else if (dial.find("COH") != std::string::npos) {
+      reaches = (mode == 16 || mode == 36);
+    } else if (dial.find("CCMEC") != std::string::npos) {
+      reaches = (mode == 2);
+    }
+
+    if (reaches)
+      return true;
+  }
+
+  return false;
+}
@@ -56,6 +56,11 @@ int CustomEnumFromName(std::string const &name);
 int NUISANCEEnumFromName(std::string const &name, int type);
 int OscillationEnumFromName(std::string const &name);
 
+/// False only if the generator dial name (or comma separated list) can never
+/// change the weight of an event of this mode. Judged from the channel
+/// named in the dial, so dials like FSI or DIS ones reach every mode.
+bool GeneratorDialAffectsMode(std::string const &name, int mode);
+
 static const int kNoDialFound = -1;
 static const int kNoTypeFound = -2;
 static const int kGeneratorNotBuilt = -3;
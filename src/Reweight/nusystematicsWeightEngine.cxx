@@ -18,9 +18,16 @@
 
 #include "nusystematicsWeightEngine.h"
 
+#include <algorithm>
 #include <limits>
 #include <string>
 
+namespace {
+// Knot responses the linear interpolation coefficients are verified over
+const double kKnotMin = 0.0;
+const double kKnotMax = 4.0;
+} // namespace
+
 nusystematicsWeightEngine::nusystematicsWeightEngine() {
   fUseCV = false;
 
@@ -30,9 +37,25 @@ nusystematicsWeightEngine::nusystematicsWeightEngine() {
     NUIS_LOG(DEB, "Set GENIE_XSEC_TUNE=" << Config::GetParS("GENIETune"));
   }
 
+  fCacheResponses = FitPar::Config().GetParB("CacheWeightResponses");
+  fCacheBytes = 0;
+
   Config();
 }
 
+nusystematicsWeightEngine::~nusystematicsWeightEngine() { ClearResponses(); }
+
+void nusystematicsWeightEngine::ClearResponses() {
+  for (auto &cache : fResponseCache) {
+    delete cache.second;
+  }
+  fResponseCache.clear();
+  if (fCacheBytes > 0) {
+    fCacheBytes = 0;
+    MemoryUtils::SetUsage(MemoryUtils::kWeightResponses, "nusystematics", 0);
+  }
+}
+
 void nusystematicsWeightEngine::Config() {
   std::vector<nuiskey> DuneRwtParam = Config::QueryKeys("DUNERwt");
 
@@ -67,6 +90,14 @@ void nusystematicsWeightEngine::IncludeDial(std::string name, double startval) {
 
   if (DuneRwtEnum == kNuSystCVResponse) {
     fUseCV = true;
+  } else if (!fParamIndex.count(DuneRwtEnum)) {
+    fParamIndex[DuneRwtEnum] = fParamIds.size();
+    fParamIds.push_back(DuneRwtEnum);
+    fParamSlots.push_back(EnabledParams.size());
+    fCoeffs.push_back(std::vector<double>());
+    fCoeffVals.push_back(0.0);
+    fCoeffKnots.push_back(-1);
+    fCoeffLinear.push_back(false);
   }
 
   EnabledParams.push_back({DuneRwtEnum, startval});
@@ -151,29 +182,176 @@ bool nusystematicsWeightEngine::NeedsEventReWeight() {
   return false;
 }
 
-double nusystematicsWeightEngine::CalcWeight(BaseFitEvt *evt) {
+void nusystematicsWeightEngine::FillEventResponses(BaseFitEvt *evt,
+                                                   std::vector<float> &row) {
   systtools::event_unit_response_w_cv_t responses =
       DUNErwt.GetEventVariationAndCVResponse(*evt->genie_event->event);
 
-  double weight = 1;
+  double cv = 1;
+  std::vector<std::vector<float> > blocks(fParamIds.size());
   for (auto const &resp : responses) {
     if (!DUNErwt.IsWeightResponse(resp.pid)) {
       continue;
     }
-    if (fUseCV) {
-      weight *= resp.CV_response;
-    } else { // This is very inefficient for fitting, as it recalculates the
-             // spline every time.
-
-      //this is a completely backwards way of doing this loop, but the whole thing is broken anyway.
-      size_t index = GetParamContainerIndex(EnabledParams, resp.pid);
-      if(index != systtools::kParamUnhandled<size_t>){
-      weight *= (resp.CV_response *
-                 DUNErwt.GetParameterResponse(resp.pid, EnabledParams[index].val,
-                                              systtools::event_unit_response_t{
-                                                  {resp.pid, resp.responses}}));
-      }
+    cv *= resp.CV_response;
+
+    auto it = fParamIndex.find(resp.pid);
+    if (it == fParamIndex.end()) {
+      continue;
+    }
+    std::vector<float> &block = blocks[it->second];
+    block.assign(1, resp.CV_response);
+    block.insert(block.end(), resp.responses.begin(), resp.responses.end());
+  }
+
+  row.assign(1, cv);
+  for (auto const &block : blocks) {
+    row.push_back(block.empty() ? -1 : int(block.size()) - 1);
+    if (block.empty()) {
+      row.push_back(1);
+    } else {
+      row.insert(row.end(), block.begin(), block.end());
+    }
+  }
+}
+
+float const *nusystematicsWeightEngine::GetEventResponses(BaseFitEvt *evt) {
+  if (!fCacheResponses || evt->fEntry < 0) {
+    FillEventResponses(evt, fScratchRow);
+    return &fScratchRow[0];
+  }
+
+  ResponseCache *&cache = fResponseCache[evt->fEventID];
+  if (!cache) {
+    cache = new ResponseCache();
+  }
+
+  size_t entry = evt->fEntry;
+  if (entry >= cache->entryrows.size()) {
+    cache->entryrows.resize(entry + 1, -1);
+  }
+  if (cache->entryrows[entry] < 0) {
+    FillEventResponses(evt, fScratchRow);
+    double extra = fScratchRow.size() * sizeof(float);
+    if (!MemoryUtils::Fits(extra)) {
+      return &fScratchRow[0];
+    }
+    cache->entryrows[entry] = cache->rows.GetNRows();
+    cache->rows.Push(&fScratchRow[0], fScratchRow.size());
+    fCacheBytes += extra;
+    MemoryUtils::SetUsage(MemoryUtils::kWeightResponses, "nusystematics",
+                          fCacheBytes);
+  }
+
+  return cache->rows.GetRow(cache->entryrows[entry]);
+}
+
+void nusystematicsWeightEngine::SetupParamCoeffs(size_t iparam, int nknots) {
+  systtools::paramId_t pid = fParamIds[iparam];
+  double val = EnabledParams[fParamSlots[iparam]].val;
+
+  fScratchResponse = systtools::event_unit_response_t{
+      {pid, std::vector<double>(nknots, 0.0)}};
+  std::vector<double> &knots = fScratchResponse.front().responses;
+
+  // The response to each unit knot, on top of the response to none
+  std::vector<double> &coeffs = fCoeffs[iparam];
+  coeffs.assign(nknots + 1, 0.0);
+  coeffs[0] = DUNErwt.GetParameterResponse(pid, val, fScratchResponse);
+  for (int k = 0; k < nknots; k++) {
+    knots[k] = 1;
+    coeffs[k + 1] =
+        DUNErwt.GetParameterResponse(pid, val, fScratchResponse) - coeffs[0];
+    knots[k] = 0;
+  }
+
+  // Any interpolation that isn't linear in the knots is evaluated directly.
+  // Linearity is checked with every knot moved over the whole verified
+  // range, alone and together, so clamped or piecewise responses are
+  // caught; events with knots outside that range are evaluated directly.
+  std::vector<std::vector<double> > points;
+  for (int k = 0; k < nknots; k++) {
+    for (int ip = 0; ip < 5; ip++) {
+      std::vector<double> point(nknots, 0.0);
+      point[k] = kKnotMin + 0.25 * ip * (kKnotMax - kKnotMin);
+      points.push_back(point);
+    }
+  }
+  points.push_back(std::vector<double>(nknots, kKnotMin));
+  points.push_back(std::vector<double>(nknots, kKnotMax));
+  std::vector<double> staggered(nknots);
+  for (int k = 0; k < nknots; k++) {
+    staggered[k] = kKnotMin + std::fmod(1.0 + 0.37 * k, kKnotMax - kKnotMin);
+  }
+  points.push_back(staggered);
+
+  bool linear = true;
+  for (size_t ip = 0; ip < points.size() && linear; ip++) {
+    double expected = coeffs[0];
+    for (int k = 0; k < nknots; k++) {
+      knots[k] = points[ip][k];
+      expected += coeffs[k + 1] * knots[k];
+    }
+    double direct = DUNErwt.GetParameterResponse(pid, val, fScratchResponse);
+    linear = (std::fabs(direct - expected) <=
+              1E-6 * std::max(1.0, std::fabs(direct)));
+  }
+  if (!linear && fCoeffKnots[iparam] < 0) {
+    NUIS_ERR(WRN, "nusystematics parameter " << pid
+                      << " response is not linear in its knots, evaluating "
+                         "it per event.");
+  }
+
+  fCoeffLinear[iparam] = linear;
+  fCoeffVals[iparam] = val;
+  fCoeffKnots[iparam] = nknots;
+}
+
+double nusystematicsWeightEngine::GetParamResponse(size_t iparam,
+                                                   float const *knots,
+                                                   int nknots) {
+  if (fCoeffKnots[iparam] != nknots ||
+      fCoeffVals[iparam] != EnabledParams[fParamSlots[iparam]].val) {
+    SetupParamCoeffs(iparam, nknots);
+  }
+
+  bool inrange = fCoeffLinear[iparam];
+  for (int k = 0; k < nknots && inrange; k++) {
+    inrange = (knots[k] >= kKnotMin && knots[k] <= kKnotMax);
+  }
+
+  if (!inrange) {
+    fScratchResponse.front().pid = fParamIds[iparam];
+    fScratchResponse.front().responses.assign(knots, knots + nknots);
+    return DUNErwt.GetParameterResponse(fParamIds[iparam],
+                                        EnabledParams[fParamSlots[iparam]].val,
+                                        fScratchResponse);
+  }
+
+  std::vector<double> const &coeffs = fCoeffs[iparam];
+  double response = coeffs[0];
+  for (int k = 0; k < nknots; k++) {
+    response += coeffs[k + 1] * knots[k];
+  }
+  return response;
+}
+
+double nusystematicsWeightEngine::CalcWeight(BaseFitEvt *evt) {
+  // Generator level responses are only calculated once per entry, each
+  // iteration then just interpolates the stored knots.
+  float const *row = GetEventResponses(evt);
+  if (fUseCV) {
+    return row[0];
+  }
+
+  double weight = 1;
+  size_t pos = 1;
+  for (size_t iparam = 0; iparam < fParamIds.size(); iparam++) {
+    int nknots = row[pos];
+    if (nknots >= 0) {
+      weight *= row[pos + 1] * GetParamResponse(iparam, row + pos + 2, nknots);
     }
+    pos += 2 + std::max(nknots, 0);
   }
 
   return weight;
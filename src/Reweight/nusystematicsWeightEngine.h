@@ -20,17 +20,20 @@
 *******************************************************************************/
 
 #include "WeightEngineBase.h"
+#include "MemoryUtils.h"
 
 #include "systematicstools/interface/types.hh"
 
 #include "nusystematics/artless/response_helper.hh"
 
 #include <cmath>
+#include <map>
 
 class nusystematicsWeightEngine : public WeightEngineBase {
 
  public:
   nusystematicsWeightEngine();
+  ~nusystematicsWeightEngine();
 
   nusyst::response_helper DUNErwt;
 
@@ -56,11 +59,50 @@ class nusystematicsWeightEngine : public WeightEngineBase {
 
   bool NeedsEventReWeight();
 
+  void ClearResponses();
+
   double CalcWeight(BaseFitEvt* evt);
 
   void Print();
 
   bool fUseCV;
+
+ private:
+  /// Dial independent responses of evt as {CV product, then per enabled
+  /// parameter: nknots (-1 if absent), CV, knots...}
+  void FillEventResponses(BaseFitEvt *evt, std::vector<float> &row);
+
+  /// Cached FillEventResponses row for the entry evt was read from
+  float const *GetEventResponses(BaseFitEvt *evt);
+
+  /// Response of enabled parameter iparam at its current value
+  double GetParamResponse(size_t iparam, float const *knots, int nknots);
+
+  /// Work out the response to parameter iparam at its current value as
+  /// c0 + sum_k c_k knot_k, and check it really is linear in the knots
+  /// over the range of knot responses the coefficients are used for
+  void SetupParamCoeffs(size_t iparam, int nknots);
+
+  std::vector<systtools::paramId_t> fParamIds; ///< Dense index -> id
+  std::vector<size_t> fParamSlots; ///< Dense index -> EnabledParams index
+  std::map<systtools::paramId_t, size_t> fParamIndex; ///< Id -> dense index
+
+  /// Per parameter {c0, c_k...} at fCoeffVals for fCoeffKnots knots
+  std::vector<std::vector<double> > fCoeffs;
+  std::vector<double> fCoeffVals;
+  std::vector<int> fCoeffKnots;
+  std::vector<bool> fCoeffLinear;
+  systtools::event_unit_response_t fScratchResponse;
+
+  /// Responses of every entry read into one event object
+  struct ResponseCache {
+    MemoryUtils::FloatRows rows;
+    std::vector<int> entryrows;
+  };
+  std::map<UInt_t, ResponseCache *> fResponseCache; ///< By BaseFitEvt::fEventID
+  bool fCacheResponses;
+  double fCacheBytes; ///< Bytes held by fResponseCache
+  std::vector<float> fScratchRow;
 };
 
 #endif
@@ -134,6 +134,7 @@ ComparisonRoutines::ComparisonRoutines(int argc, char *argv[]) {
   std::cout << "[ NUISANCE ]: Setting ERROR=" << errorcount << std::endl;
   SETVERBOSITY(verbocount);
   SETTRACE(trace);
+  TimingUtils::SetEnabled(Config::GetParB("TimingReport"));
 
   // Comparison Setup ========================================
 
@@ -384,8 +385,7 @@ void ComparisonRoutines::SetFakeData() {
     UpdateRWEngine(fFakeVals);
 
     FitBase::GetRW()->Reconfigure();
-    fSampleFCN->ReconfigureAllEvents();
-    fSampleFCN->SetFakeData("MC");
+    fSampleFCN->SetFakeDataFromMC();
 
     std::map<std::string, double> CurVals_wmirr;
     for (size_t i = 0; i < fParams.size(); ++i) {
@@ -510,6 +510,8 @@ void ComparisonRoutines::Run() {
     }
   }
 
+  SaveTimingReport();
+
   return;
 }
 
@@ -645,6 +647,18 @@ void ComparisonRoutines::SaveCurrentState(std::string subdir) {
   return;
 }
 
+//*************************************
+void ComparisonRoutines::SaveTimingReport() {
+  //*************************************
+
+  if (!TimingUtils::IsEnabled())
+    return;
+
+  TimingUtils::PrintSummary();
+  TimingUtils::WriteTree(fOutputRootFile);
+  TimingUtils::WriteJSON(fOutputFile + ".timing.json");
+}
+
 //*************************************
 void ComparisonRoutines::SaveNominal() {
   //*************************************
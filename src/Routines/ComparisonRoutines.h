@@ -42,6 +42,7 @@
 #include "NuisKey.h"
 #include "FitLogger.h"
 #include "ParserUtils.h"
+#include "TimingUtils.h"
 
 enum minstate {
   kErrorStatus = -1,
@@ -120,6 +121,9 @@ public:
   /// Save starting predictions into a separate folder
   void SaveNominal();
 
+  /// Print and save the hot-path timing report (config TimingReport)
+  void SaveTimingReport();
+
   /*
     MISC Functions
   */
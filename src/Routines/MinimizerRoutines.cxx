@@ -53,6 +53,7 @@ void MinimizerRoutines::Init() {
   fMinimizer = NULL;
   fMinimizerFCN = NULL;
   fCallFunctor = NULL;
+  fGradFunctor = NULL;
 
   fAllowedRoutines = ("Migrad,Simplex,Combined,"
                       "Brute,Fumili,ConjugateFR,"
@@ -157,6 +158,7 @@ MinimizerRoutines::MinimizerRoutines(int argc, char *argv[]) {
   std::cout << "[ NUISANCE ]: Setting ERROR=" << errorcount << std::endl;
   SETVERBOSITY(verbocount);
   SETTRACE(trace);
+  TimingUtils::SetEnabled(Config::GetParB("TimingReport"));
 
   // Minimizer Setup ========================================
   fOutputRootFile = new TFile(fCompKey.GetS("outputfile").c_str(), "RECREATE");
@@ -400,6 +402,7 @@ void MinimizerRoutines::SetupFCN() {
 
   fMinimizerFCN = new MinimizerFCN(fSampleFCN);
   fCallFunctor = new ROOT::Math::Functor(*fMinimizerFCN, fParams.size());
+  fGradFunctor = new MinimizerGradFCN(fSampleFCN, fParams.size());
 
   fSampleFCN->CreateIterationTree("fit_iterations", FitBase::GetRW());
 
@@ -475,7 +478,12 @@ void MinimizerRoutines::SetupFitter(std::string routine) {
   fMinimizer->SetMaxIterations(FitPar::Config().GetParI("MAXITERATIONS"));
   fMinimizer->SetTolerance(FitPar::Config().GetParD("TOLERANCE"));
   fMinimizer->SetStrategy(FitPar::Config().GetParI("STRATEGY"));
-  fMinimizer->SetFunction(*fCallFunctor);
+  if (FitPar::Config().GetParB("UseFCNGradient")) {
+    NUIS_LOG(FIT, "Passing FCN gradients to the minimizer.");
+    fMinimizer->SetFunction(*fGradFunctor);
+  } else {
+    fMinimizer->SetFunction(*fCallFunctor);
+  }
 
   int ipar = 0;
   // Add Fit Parameters
@@ -508,6 +516,7 @@ void MinimizerRoutines::SetupFitter(std::string routine) {
                                       fMirroredParams[syst].mirror_above);
     }
 
+    fSampleFCN->SetParFixed(ipar, fixed);
     if (fixed) {
       fMinimizer->FixVariable(ipar);
       NUIS_LOG(FIT, "Fixed Param: " << syst);
@@ -548,10 +557,9 @@ void MinimizerRoutines::SetFakeData() {
 
     // Reconfigure the reweight engine
     FitBase::GetRW()->Reconfigure();
-    // Reconfigure all the samples to the new reweight
-    fSampleFCN->ReconfigureAllEvents();
-    // Feed on and set the fake-data in each measurement class
-    fSampleFCN->SetFakeData("MC");
+    // Reconfigure all the samples to the new reweight, or load the cached
+    // predictions, and set the fake-data in each measurement class
+    fSampleFCN->SetFakeDataFromMC();
 
     // Changed the reweight engine values back to the current values
     // So we start the fit at a different value than what we set the fake-data
@@ -609,6 +617,8 @@ void MinimizerRoutines::Run() {
     // Try Routines
     if (routine.find("LowStat") != std::string::npos)
       LowStatRoutine(routine);
+    else if (routine.find("Subsample") != std::string::npos)
+      fitstate = SubsampleRoutine(routine);
     else if (routine == "FixAtLim")
       FixAtLimit();
     else if (routine == "FixAtLimBreak")
@@ -817,6 +827,45 @@ void MinimizerRoutines::LowStatRoutine(std::string routine) {
   return;
 }
 
+//*************************************
+int MinimizerRoutines::SubsampleRoutine(std::string routine) {
+  //*************************************
+
+  NUIS_LOG(FIT, "Running Subsample Routine: " << routine);
+  double fraction = FitPar::Config().GetParD("SubsampleFraction");
+  double growth = FitPar::Config().GetParD("SubsampleGrowth");
+
+  std::string trueroutine = routine;
+  std::string substring = "Subsample";
+  trueroutine.erase(trueroutine.find(substring), substring.length());
+
+  // Each stage starts from the best fit of the one before
+  while (fraction > 0.0 && fraction < 1.0) {
+    NUIS_LOG(FIT, "Fitting on a " << fraction << " event subsample.");
+    fSampleFCN->SetSubsampleFraction(fraction);
+    RunFitRoutine(trueroutine);
+
+    // Compare the approximation with every event at its best fit point
+    double *vals = FitUtils::GetArrayFromMap(fParams, fCurVals);
+    double likesub = fSampleFCN->DoEval(vals);
+    fSampleFCN->SetSubsampleFraction(1.0);
+    double likefull = fSampleFCN->DoEval(vals);
+    delete[] vals;
+
+    NUIS_LOG(FIT, "Subsample " << fraction << " : L(subsample) = " << likesub
+                               << ", L(full) = " << likefull
+                               << ", difference = " << likefull - likesub);
+
+    if (growth <= 1.0)
+      break;
+    fraction *= growth;
+  }
+
+  // Finish on every event
+  fSampleFCN->SetSubsampleFraction(1.0);
+  return RunFitRoutine(trueroutine);
+}
+
 //*************************************
 void MinimizerRoutines::Create1DScans() {
   //*************************************
@@ -848,18 +897,23 @@ void MinimizerRoutines::Create1DScans() {
                  ("Chi2Scan1D_" + fParams[i] + ";" + fParams[i]).c_str(),
                  npoints, limlow, limhigh);
 
-    // Fill bins
+    // Build scan points
+    std::vector<std::vector<double> > points;
     for (int x = 0; x < contour->GetNbinsX(); x++) {
       // Set X Val
       fCurVals[fParams[i]] = contour->GetXaxis()->GetBinCenter(x + 1);
 
-      // Run Eval
       double *vals = FitUtils::GetArrayFromMap(fParams, fCurVals);
-      double chi2 = fSampleFCN->DoEval(vals);
+      points.push_back(std::vector<double>(vals, vals + fParams.size()));
       delete vals;
+    }
 
-      // Fill Contour
-      contour->SetBinContent(x + 1, chi2);
+    // Run Eval, points are independent so spread them over workers
+    std::vector<double> chi2 = fSampleFCN->DoEvalPoints(points);
+
+    // Fill bins
+    for (int x = 0; x < contour->GetNbinsX(); x++) {
+      contour->SetBinContent(x + 1, chi2[x]);
     }
 
     // Save contour
@@ -921,7 +975,8 @@ void MinimizerRoutines::Chi2Scan2D() {
       // Begin Scan
       NUIS_LOG(FIT, "Running scan for " << fParams[i] << " " << fParams[j]);
 
-      // Fill bins
+      // Build scan points
+      std::vector<std::vector<double> > points;
       for (int x = 0; x < contour->GetNbinsX(); x++) {
         // Set X Val
         fCurVals[fParams[i]] = contour->GetXaxis()->GetBinCenter(x + 1);
@@ -931,21 +986,26 @@ void MinimizerRoutines::Chi2Scan2D() {
           // Set Y Val
           fCurVals[fParams[j]] = contour->GetYaxis()->GetBinCenter(y + 1);
 
-          // Run Eval
           double *vals = FitUtils::GetArrayFromMap(fParams, fCurVals);
-          double chi2 = fSampleFCN->DoEval(vals);
+          points.push_back(std::vector<double>(vals, vals + fParams.size()));
           delete vals;
-
-          // Fill Contour
-          contour->SetBinContent(x + 1, y + 1, chi2);
-
-          fCurVals[fParams[j]] = scanmid_j;
         }
 
         fCurVals[fParams[i]] = scanmid_i;
         fCurVals[fParams[j]] = scanmid_j;
       }
 
+      // Run Eval, points are independent so spread them over workers
+      std::vector<double> chi2 = fSampleFCN->DoEvalPoints(points);
+
+      // Fill Contour
+      int ipoint = 0;
+      for (int x = 0; x < contour->GetNbinsX(); x++) {
+        for (int y = 0; y < contour->GetNbinsY(); y++) {
+          contour->SetBinContent(x + 1, y + 1, chi2[ipoint++]);
+        }
+      }
+
       // Save contour
       contour->Write();
 
@@ -1016,6 +1076,19 @@ void MinimizerRoutines::SaveResults() {
   }
 
   SaveCurrentState();
+  SaveTimingReport();
+}
+
+//*************************************
+void MinimizerRoutines::SaveTimingReport() {
+  //*************************************
+
+  if (!TimingUtils::IsEnabled())
+    return;
+
+  TimingUtils::PrintSummary();
+  TimingUtils::WriteTree(fOutputRootFile);
+  TimingUtils::WriteJSON(fOutputFile + ".timing.json");
 }
 
 //*************************************
@@ -1543,11 +1616,9 @@ void MinimizerRoutines::ThrowDataToys() {
   int nthrows = FitPar::Config().GetParI("NToyThrows");
   double maxlike = -1.0;
   double minlike = -1.0;
-  std::vector<double> values;
-  for (int i = 0; i < 1.E4; i++) {
-    fSampleFCN->ThrowDataToy();
-    double like = fSampleFCN->GetLikelihood();
-    values.push_back(like);
+  std::vector<double> values = fSampleFCN->ThrowDataToys(nthrows);
+  for (size_t i = 0; i < values.size(); i++) {
+    double like = values[i];
     if (maxlike == -1.0 or like > maxlike)
       maxlike = like;
     if (minlike == -1.0 or like < minlike)
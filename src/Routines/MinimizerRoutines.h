@@ -58,6 +58,7 @@
 #include "Math/Functor.h"
 #include "FitLogger.h"
 #include "ParserUtils.h"
+#include "TimingUtils.h"
 
 enum minstate {
   kErrorStatus = -1,
@@ -161,6 +162,9 @@ void SetupMinimizerFromXML();
   //! Performs a fit routine where the input.maxevents is set to a much lower value to try and move closer to the best fit minimum.
   void LowStatRoutine(std::string routine);
 
+  //! Runs the routine on growing stratified event subsamples (SubsampleFraction, times SubsampleGrowth each stage) before a final fit on every event, logging the likelihood shift of each approximation.
+  int SubsampleRoutine(std::string routine);
+
   //! Perform a chi2 scan in 1D around the current point
   void Create1DScans();
 
@@ -201,6 +205,9 @@ void SetupMinimizerFromXML();
   void SavePrefit();
 
   void SaveResults();
+
+  //! Print and save the hot-path timing report (config TimingReport)
+  void SaveTimingReport();
   /*
     MISC Functions
   */
@@ -231,6 +238,7 @@ protected:
   JointFCN* fSampleFCN;
   MinimizerFCN* fMinimizerFCN;
   ROOT::Math::Functor* fCallFunctor;
+  MinimizerGradFCN* fGradFunctor;
 
   int nfreepars;
 
@@ -1,18 +1,37 @@
 #include "Math/Minimizer.h"
 
+#include "TDecompChol.h"
+#include "TMatrixDSym.h"
+
 #include "FitLogger.h"
+#include "GeneralUtils.h"
+#include "ParallelUtils.h"
+
+#include <cmath>
+#include <limits>
 
 using ROOT::Math::Minimizer;
 
+/// Metropolis-Hastings sampler usable as a ROOT minimizer.
+///
+/// Several chains can be run at once, each advanced in blocks of
+/// MCMC.BlockSteps steps inside its own forked worker (see ParallelUtils),
+/// so every chain gets a private copy of the FCN state on top of the
+/// signal caches built before the first fork. Between blocks the sampler
+///  - swaps states between adjacent temperatures (MCMC.Temperatures),
+///  - re-tunes each chain's proposal from its own history (Haario adaptive
+///    Metropolis, MCMC.Adaptive),
+///  - computes split R-hat and ESS over the T=1 chains, and stops early once
+///    MCMC.RhatTarget and MCMC.MinESS are both met.
+/// The target density is exp(-FCN / (MCMC.LikelihoodScale * T)).
 class Simple_MH_Sampler : public Minimizer {
   TRandom3 RNJesus;
 
   size_t step_i;
   int moved;
+  int chain_i;
 
   size_t thin;
-  size_t thin_ctr;
-
   size_t discard;
 
   struct Param {
@@ -30,17 +49,43 @@ class Simple_MH_Sampler : public Minimizer {
     double Val, StepWidth, LowLim, UpLim;
   };
 
+  /// State of one chain, only updated in the parent between blocks.
+  struct Chain {
+    double Temperature;
+    double Value;
+    std::vector<double> Params;
+    size_t NSteps;
+    size_t NAccepted;
+    size_t ThinCounter;
+
+    /// Running mean/covariance of all states, over free parameters
+    size_t NHist;
+    std::vector<double> Mean;
+    std::vector<double> Cov;
+    /// Lower triangular proposal Cholesky factor, empty for fixed widths
+    std::vector<double> Chol;
+
+    /// Thinned post burn-in samples for diagnostics, [free param][sample]
+    std::vector<std::vector<double> > Samples;
+  };
+
   std::vector<Param> start_params;
+  std::vector<size_t> free_params;
+  std::vector<Chain> chains;
 
   double curr_value;
   std::vector<double> curr_params;
 
-  double propose_value;
-  std::vector<double> propose_params;
-
   double min_value;
   std::vector<double> min_params;
 
+  double like_scale;
+  size_t block_steps;
+  bool adaptive;
+  size_t adapt_start;
+  double rhat_target;
+  double min_ess;
+
   TGraph trace;
 
   void RestartParams() {
@@ -49,20 +94,288 @@ class Simple_MH_Sampler : public Minimizer {
       curr_params[p_it] = start_params[p_it].Val;
     }
     min_params = curr_params;
-    propose_params = curr_params;
   }
 
   TTree *StepTree;
-
-  void Write();
+  TTree *DiagTree;
 
   ROOT::Math::IMultiGenFunction const *FCN;
 
+  /// Advances one chain by a block of steps in a worker.
+  class BlockTask : public ParallelUtils::Task {
+  public:
+    BlockTask(Simple_MH_Sampler *s, size_t n, std::vector<unsigned> seeds)
+        : fSampler(s), fNSteps(n), fSeeds(seeds) {}
+    std::vector<double> Run(int ichain) {
+      return fSampler->RunBlock(ichain, fNSteps, fSeeds[ichain]);
+    }
+
+  private:
+    Simple_MH_Sampler *fSampler;
+    size_t fNSteps;
+    std::vector<unsigned> fSeeds;
+  };
+
+  bool InLimits(std::vector<double> const &params) const {
+    for (size_t p_it = 0; p_it < start_params.size(); ++p_it) {
+      if ((start_params[p_it].LowLim != 0xdeadbeef) &&
+          (params[p_it] < start_params[p_it].LowLim))
+        return false;
+      if ((start_params[p_it].UpLim != 0xdeadbeef) &&
+          (params[p_it] > start_params[p_it].UpLim))
+        return false;
+    }
+    return true;
+  }
+
+  /// Run nsteps MH steps of chain ichain. Returns (value, moved, params...)
+  /// for every step. Proposals outside the limits are rejected.
+  std::vector<double> RunBlock(int ichain, size_t nsteps, unsigned seed) {
+    Chain const &chain = chains[ichain];
+    TRandom3 rng(seed);
+
+    size_t nfree = free_params.size();
+    double beta = 1.0 / (like_scale * chain.Temperature);
+
+    std::vector<double> params = chain.Params;
+    std::vector<double> propose = params;
+    std::vector<double> z(nfree);
+    double value = chain.Value;
+
+    std::vector<double> out;
+    out.reserve(nsteps * (2 + params.size()));
+
+    for (size_t s_it = 0; s_it < nsteps; ++s_it) {
+      for (size_t i = 0; i < nfree; ++i) {
+        z[i] = rng.Gaus(0.0, 1.0);
+      }
+
+      propose = params;
+      for (size_t i = 0; i < nfree; ++i) {
+        size_t p_it = free_params[i];
+        if (chain.Chol.empty()) {
+          propose[p_it] += start_params[p_it].StepWidth * z[i];
+        } else {
+          for (size_t j = 0; j <= i; ++j) {
+            propose[p_it] += chain.Chol[i * nfree + j] * z[j];
+          }
+        }
+      }
+
+      bool accept = false;
+      if (InLimits(propose)) {
+        double propose_value = (*FCN)(propose.data());
+        if (propose_value != propose_value) {
+          NUIS_ABORT("Chain " << ichain << " proposed a NAN value.");
+        }
+
+        double loga = -beta * (propose_value - value);
+        accept = (loga >= 0.0) || (rng.Uniform(1) < exp(loga));
+        NUIS_LOG(REC, "[" << ichain << ":" << s_it << "] proposed: "
+                          << propose_value << " | current: " << value
+                          << (accept ? " Moved." : " Stayed."));
+        if (accept) {
+          params = propose;
+          value = propose_value;
+        }
+      }
+
+      out.push_back(value);
+      out.push_back(accept);
+      out.insert(out.end(), params.begin(), params.end());
+    }
+    return out;
+  }
+
+  /// Update the chain's running moments with a new state (Welford)
+  void AddToHistory(Chain &chain, std::vector<double> const &params) {
+    size_t nfree = free_params.size();
+    chain.NHist++;
+    std::vector<double> delta(nfree);
+    for (size_t i = 0; i < nfree; ++i) {
+      delta[i] = params[free_params[i]] - chain.Mean[i];
+      chain.Mean[i] += delta[i] / double(chain.NHist);
+    }
+    for (size_t i = 0; i < nfree; ++i) {
+      double d2 = params[free_params[i]] - chain.Mean[i];
+      for (size_t j = 0; j < nfree; ++j) {
+        chain.Cov[i * nfree + j] += delta[j] * d2;
+      }
+    }
+  }
+
+  /// Haario proposal: (2.38^2/d) * (C + eps I) from the chain history
+  void AdaptProposal(Chain &chain) {
+    size_t nfree = free_params.size();
+    if (!adaptive || chain.NHist < adapt_start || chain.NHist < 2)
+      return;
+
+    double sd = 2.38 * 2.38 / double(nfree);
+    TMatrixDSym prop(nfree);
+    for (size_t i = 0; i < nfree; ++i) {
+      for (size_t j = 0; j < nfree; ++j) {
+        prop(i, j) = sd * chain.Cov[i * nfree + j] / double(chain.NHist - 1);
+      }
+      double width = start_params[free_params[i]].StepWidth;
+      prop(i, i) += sd * 1E-6 * width * width;
+    }
+
+    TDecompChol chol(prop);
+    if (!chol.Decompose()) {
+      NUIS_ERR(WRN, "Adaptive proposal not positive definite, keeping the "
+                    "previous proposal.");
+      return;
+    }
+
+    // TDecompChol gives upper triangular U with prop = U^T U
+    TMatrixD U = chol.GetU();
+    chain.Chol.assign(nfree * nfree, 0.0);
+    for (size_t i = 0; i < nfree; ++i) {
+      for (size_t j = 0; j <= i; ++j) {
+        chain.Chol[i * nfree + j] = U(j, i);
+      }
+    }
+  }
+
+  /// Metropolis swaps between adjacent temperatures
+  void SwapChains(size_t iblock) {
+    for (size_t c = iblock % 2; c + 1 < chains.size(); c += 2) {
+      Chain &lo = chains[c];
+      Chain &hi = chains[c + 1];
+      double loga = (1.0 / lo.Temperature - 1.0 / hi.Temperature) *
+                    (lo.Value - hi.Value) / like_scale;
+      if (loga >= 0.0 || RNJesus.Uniform(1) < exp(loga)) {
+        std::swap(lo.Params, hi.Params);
+        std::swap(lo.Value, hi.Value);
+        NUIS_LOG(MIN, "Swapped chains " << c << " (T=" << lo.Temperature
+                                        << ") and " << c + 1 << " (T="
+                                        << hi.Temperature << ")");
+      }
+    }
+  }
+
+  /// Split R-hat over the two halves of every T=1 chain
+  double SplitRhat(size_t ifree) const {
+    std::vector<double> means, vars;
+    size_t n = std::numeric_limits<size_t>::max();
+    for (size_t c = 0; c < chains.size(); ++c) {
+      if (chains[c].Temperature == 1.0)
+        n = std::min(n, chains[c].Samples[ifree].size() / 2);
+    }
+    if (n == std::numeric_limits<size_t>::max() || n < 2)
+      return std::numeric_limits<double>::max();
+
+    for (size_t c = 0; c < chains.size(); ++c) {
+      if (chains[c].Temperature != 1.0)
+        continue;
+      std::vector<double> const &smp = chains[c].Samples[ifree];
+      size_t start = smp.size() - 2 * n;
+      for (size_t half = 0; half < 2; ++half) {
+        double mean = 0.0, var = 0.0;
+        for (size_t k = 0; k < n; ++k) {
+          mean += smp[start + half * n + k];
+        }
+        mean /= double(n);
+        for (size_t k = 0; k < n; ++k) {
+          double d = smp[start + half * n + k] - mean;
+          var += d * d;
+        }
+        means.push_back(mean);
+        vars.push_back(var / double(n - 1));
+      }
+    }
+
+    double W = 0.0, grand = 0.0;
+    for (size_t m = 0; m < means.size(); ++m) {
+      W += vars[m];
+      grand += means[m];
+    }
+    W /= double(means.size());
+    grand /= double(means.size());
+
+    double B = 0.0;
+    for (size_t m = 0; m < means.size(); ++m) {
+      B += (means[m] - grand) * (means[m] - grand);
+    }
+    B *= double(n) / double(means.size() - 1);
+
+    if (W <= 0.0)
+      return std::numeric_limits<double>::max();
+    double varplus = (double(n - 1) / double(n)) * W + B / double(n);
+    return sqrt(varplus / W);
+  }
+
+  /// ESS summed over T=1 chains, Geyer initial positive sequence estimator
+  double EffectiveSampleSize(size_t ifree) const {
+    double ess = 0.0;
+    for (size_t c = 0; c < chains.size(); ++c) {
+      if (chains[c].Temperature != 1.0)
+        continue;
+      std::vector<double> const &smp = chains[c].Samples[ifree];
+      size_t n = smp.size();
+      if (n < 4)
+        continue;
+
+      double mean = 0.0;
+      for (size_t k = 0; k < n; ++k) {
+        mean += smp[k];
+      }
+      mean /= double(n);
+
+      std::vector<double> rho;
+      size_t maxlag = std::min(n / 2, size_t(2000));
+      double var = 0.0;
+      for (size_t lag = 0; lag < maxlag; ++lag) {
+        double acov = 0.0;
+        for (size_t k = 0; k + lag < n; ++k) {
+          acov += (smp[k] - mean) * (smp[k + lag] - mean);
+        }
+        if (!lag) {
+          var = acov;
+          if (var <= 0.0)
+            break;
+        }
+        rho.push_back(acov / var);
+
+        // Stop once a pair sum of autocorrelations goes negative
+        if (lag % 2 && (rho[lag - 1] + rho[lag]) < 0.0)
+          break;
+      }
+      if (var <= 0.0)
+        continue;
+
+      double tau = -1.0;
+      for (size_t k = 0; k + 1 < rho.size(); k += 2) {
+        double pair = rho[k] + rho[k + 1];
+        if (pair < 0.0)
+          break;
+        tau += 2.0 * pair;
+      }
+      ess += double(n) / std::max(tau, 1.0 / double(n));
+    }
+    return ess;
+  }
+
+  void Write();
+
  public:
   Simple_MH_Sampler() : Minimizer(), RNJesus(), trace() {
     thin = Config::GetParI("MCMC.thin");
-    thin_ctr = 0;
+    if (thin < 1)
+      thin = 1;
     discard = Config::GetParI("MCMC.BurnInSteps");
+    like_scale = Config::GetParD("MCMC.LikelihoodScale");
+    block_steps = Config::GetParI("MCMC.BlockSteps");
+    if (block_steps < 1)
+      block_steps = 1;
+    adaptive = Config::GetParB("MCMC.Adaptive");
+    adapt_start = Config::GetParI("MCMC.AdaptStart");
+    rhat_target = Config::GetParD("MCMC.RhatTarget");
+    min_ess = Config::GetParD("MCMC.MinESS");
+    min_value = std::numeric_limits<double>::max();
+    StepTree = NULL;
+    DiagTree = NULL;
+    FCN = NULL;
   }
 
   void SetFunction(ROOT::Math::IMultiGenFunction const &func) { FCN = &func; }
@@ -177,6 +490,7 @@ class Simple_MH_Sampler : public Minimizer {
     return NFree;
   }
 
+
   void AddBranches() {
     TFile *ogf = gFile;
     if (Config::Get().out && Config::Get().out->IsOpen()) {
@@ -185,6 +499,7 @@ class Simple_MH_Sampler : public Minimizer {
 
     StepTree = new TTree("MCMChain", "");
     StepTree->Branch("Step", &step_i, "Step/I");
+    StepTree->Branch("Chain", &chain_i, "Chain/I");
     StepTree->Branch("Value", &curr_value, "Value/D");
     StepTree->Branch("Moved", &moved, "Moved/I");
 
@@ -203,93 +518,108 @@ class Simple_MH_Sampler : public Minimizer {
 
   void Fill() { StepTree->Fill(); }
 
-  void Propose() {
+  void PrintResults() {
+    NUIS_LOG(FIT, "Simple_MH_Sampler State: ");
+    for (size_t c = 0; c < chains.size(); ++c) {
+      NUIS_LOG(FIT, "Chain " << c << " (T=" << chains[c].Temperature
+                             << "): LHood = " << chains[c].Value
+                             << ", acceptance = "
+                             << Form("%.3f", double(chains[c].NAccepted) /
+                                                 double(chains[c].NSteps)));
+    }
     for (size_t p_it = 0; p_it < start_params.size(); ++p_it) {
-      double propose_param = curr_params[p_it];
-
-      if (!start_params[p_it].IsFixed) {
-        size_t attempts = 0;
-        do {
-          if (attempts > 1000) {
-            NUIS_ABORT("After 1000 attempts, failed to throw Gaus("
-                  << start_params[p_it].Val << ", "
-                  << start_params[p_it].StepWidth << ") inside limits: [ "
-                  << start_params[p_it].LowLim << " -- "
-                  << start_params[p_it].UpLim << " ]");
-          }
-
-          double thr =
-              RNJesus.Gaus(curr_params[p_it], start_params[p_it].StepWidth);
+      NUIS_LOG(FIT, "\t[" << p_it
+                      << "]: " << (start_params[p_it].IsFixed ? " FIX" : "FREE")
+                      << " " << chains[0].Params[p_it]);
+    }
+    NUIS_LOG(FIT, "Min LHood: " << min_value);
+  }
 
-          if ((start_params[p_it].LowLim != 0xdeadbeef) &&
-              (thr < start_params[p_it].LowLim)) {
-            attempts++;
-            continue;
-          }
+  /// Unpack a block returned by RunBlock into the chain, the output tree and
+  /// the diagnostics samples.
+  void ProcessBlock(int ichain, std::vector<double> const &block) {
+    Chain &chain = chains[ichain];
+    size_t ndim = start_params.size();
+    size_t stride = 2 + ndim;
+    bool cold = (chain.Temperature == 1.0);
+
+    for (size_t off = 0; off + stride <= block.size(); off += stride) {
+      curr_value = block[off];
+      moved = block[off + 1];
+      curr_params.assign(block.begin() + off + 2, block.begin() + off + stride);
+      step_i = chain.NSteps;
+      chain_i = ichain;
+
+      chain.NSteps++;
+      chain.NAccepted += moved;
+      AddToHistory(chain, curr_params);
+
+      if (curr_value < min_value) {
+        min_value = curr_value;
+        min_params = curr_params;
+      }
 
-          if ((start_params[p_it].UpLim != 0xdeadbeef) &&
-              (thr > start_params[p_it].UpLim)) {
-            attempts++;
-            continue;
-          }
+      if (ichain == 0) {
+        trace.SetPoint(step_i, step_i, curr_value);
+      }
 
-          propose_param = thr;
-          break;
+      if (!cold || step_i < discard)
+        continue;
 
-        } while (true);
+      chain.ThinCounter++;
+      if (chain.ThinCounter == thin) {
+        Fill();
+        for (size_t i = 0; i < free_params.size(); ++i) {
+          chain.Samples[i].push_back(curr_params[free_params[i]]);
+        }
+        chain.ThinCounter = 0;
       }
-
-      propose_params[p_it] = propose_param;
     }
+
+    chain.Value = curr_value;
+    chain.Params = curr_params;
   }
 
-  void Evaluate() {
-    propose_value = exp(-(*FCN)(propose_params.data()) / 10000.0);
-    if (propose_value < min_value) {
-      min_params = propose_params;
+  /// Setup the chains from MCMC.NChains/MCMC.Temperatures
+  void SetupChains() {
+    std::vector<double> temps =
+        GeneralUtils::ParseToDbl(Config::GetParS("MCMC.Temperatures"), ",");
+    if (temps.empty()) {
+      int nchains = Config::GetParI("MCMC.NChains");
+      temps.assign(nchains < 1 ? 1 : nchains, 1.0);
     }
-  }
 
-  void PrintResults() {
-    NUIS_LOG(FIT, "Simple_MH_Sampler State: ");
+    free_params.clear();
     for (size_t p_it = 0; p_it < start_params.size(); ++p_it) {
-      NUIS_LOG(FIT, "\t[" << p_it
-                      << "]: " << (start_params[p_it].IsFixed ? " FIX" : "FREE")
-                      << " " << curr_params[p_it]);
+      if (!start_params[p_it].IsFixed)
+        free_params.push_back(p_it);
     }
-    NUIS_LOG(FIT, "Curr LHood: " << curr_value << ", Min LHood: " << min_value);
-  }
+    size_t nfree = free_params.size();
 
-  void Step() {
-    moved = false;
-
-    if (propose_value != propose_value) {
-      curr_params = propose_params;
-      curr_value = propose_value;
-      PrintResults();
-      NUIS_ABORT("Proposed a NAN value.");
-    }
-
-    std::cout << "[" << step_i << "] proposed: " << propose_value
-              << " | current: " << curr_value << std::endl;
-    double a = propose_value / curr_value;
-    std::cout << "\ta = " << a << std::endl;
-    if (a >= 1.0) {
-      moved = true;
-      std::cout << "\tMoved." << std::endl;
-    } else {
-      double b = RNJesus.Uniform(1);
-      if (b < a) {
-        moved = true;
-        std::cout << "\tMoved (" << b << ")" << std::endl;
-      } else {
-        std::cout << "\tStayed. (" << b << ")" << std::endl;
+    bool hascold = false;
+    chains.clear();
+    for (size_t c = 0; c < temps.size(); ++c) {
+      if (temps[c] <= 0.0) {
+        NUIS_ABORT("MCMC temperatures must be positive: " << temps[c]);
       }
+      hascold |= (temps[c] == 1.0);
+
+      Chain chain;
+      chain.Temperature = temps[c];
+      chain.Params = curr_params;
+      chain.Value = 0.0;
+      chain.NSteps = 0;
+      chain.NAccepted = 0;
+      chain.ThinCounter = 0;
+      chain.NHist = 0;
+      chain.Mean.assign(nfree, 0.0);
+      chain.Cov.assign(nfree * nfree, 0.0);
+      chain.Samples.resize(nfree);
+      chains.push_back(chain);
     }
 
-    if (moved) {
-      curr_params = propose_params;
-      curr_value = propose_value;
+    if (!hascold) {
+      NUIS_ABORT("MCMC.Temperatures needs at least one chain at T=1.");
     }
   }
 
@@ -300,33 +630,88 @@ class Simple_MH_Sampler : public Minimizer {
     }
 
     RestartParams();
-
+    SetupChains();
     AddBranches();
 
+    TFile *ogf = gFile;
+    if (Config::Get().out && Config::Get().out->IsOpen()) {
+      Config::Get().out->cd();
+    }
+    double maxrhat = 0.0, miness = 0.0, acceptance = 0.0;
+    DiagTree = new TTree("MCMCDiagnostics", "");
+    DiagTree->Branch("Step", &step_i, "Step/I");
+    DiagTree->Branch("MaxRhat", &maxrhat, "MaxRhat/D");
+    DiagTree->Branch("MinESS", &miness, "MinESS/D");
+    DiagTree->Branch("Acceptance", &acceptance, "Acceptance/D");
+    if (ogf && ogf->IsOpen()) {
+      ogf->cd();
+    }
+
+    // Evaluate the start point here so every worker inherits the filled
+    // signal caches instead of building its own.
+    double startvalue = (*FCN)(curr_params.data());
+    for (size_t c = 0; c < chains.size(); ++c) {
+      chains[c].Value = startvalue;
+    }
+    min_value = startvalue;
+    min_params = curr_params;
+
     size_t NSteps = Options().MaxIterations();
+    int nworkers = ParallelUtils::GetNWorkers();
     trace.Set(NSteps);
-    NUIS_LOG(FIT, "Running chain for " << NSteps << " steps.");
-    step_i = 0;
-    while (step_i < NSteps) {
-      Propose();
+    NUIS_LOG(FIT, "Running " << chains.size() << " chains for " << NSteps
+                             << " steps in blocks of " << block_steps
+                             << " using " << nworkers << " workers.");
 
-      Evaluate();
+    size_t done = 0;
+    for (size_t iblock = 0; done < NSteps; ++iblock) {
+      size_t nsteps = std::min(block_steps, NSteps - done);
 
-      Step();
+      std::vector<unsigned> seeds(chains.size());
+      for (size_t c = 0; c < chains.size(); ++c) {
+        seeds[c] = RNJesus.Integer(std::numeric_limits<unsigned>::max() - 1) + 1;
+      }
 
-      trace.SetPoint(step_i, step_i, curr_value);
+      BlockTask task(this, nsteps, seeds);
+      std::vector<std::vector<double> > blocks =
+          ParallelUtils::RunTasks(task, chains.size(), nworkers);
 
-      if (step_i >= discard) {
-        thin_ctr++;
-        if (thin_ctr == thin) {
-          Fill();
-          thin_ctr = 0;
-        }
+      for (size_t c = 0; c < chains.size(); ++c) {
+        ProcessBlock(c, blocks[c]);
+        AdaptProposal(chains[c]);
+      }
+      SwapChains(iblock);
+      done += nsteps;
+
+      // Convergence diagnostics over the cold chains
+      maxrhat = 0.0;
+      miness = std::numeric_limits<double>::max();
+      for (size_t i = 0; i < free_params.size(); ++i) {
+        maxrhat = std::max(maxrhat, SplitRhat(i));
+        miness = std::min(miness, EffectiveSampleSize(i));
+      }
+      acceptance = double(chains[0].NAccepted) / double(chains[0].NSteps);
+      step_i = done;
+      DiagTree->Fill();
+
+      NUIS_LOG(FIT, "MCMC step " << done << "/" << NSteps
+                                 << ": max R-hat = " << Form("%.4f", maxrhat)
+                                 << ", min ESS = " << Form("%.1f", miness)
+                                 << ", acceptance = "
+                                 << Form("%.3f", acceptance));
+
+      if (rhat_target > 0.0 && min_ess > 0.0 && maxrhat < rhat_target &&
+          miness >= min_ess) {
+        NUIS_LOG(FIT, "Chains converged after " << done << " steps.");
+        trace.Set(done);
+        break;
       }
-      step_i++;
     }
 
+    PrintResults();
+
     StepTree->Write();
+    DiagTree->Write();
     trace.Write("MCMCTrace");
 
     return true;
@@ -17,6 +17,277 @@
  *    along with NUISANCE.  If not, see <http://www.gnu.org/licenses/>.
  *******************************************************************************/
 #include "SplineRoutines.h"
+#include "ParallelUtils.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <map>
+#include <unistd.h>
+
+namespace {
+// Joins one range of entries from every merged spline set into its own file
+class MergeRangeTask : public ParallelUtils::Task {
+public:
+  MergeRangeTask(SplineMerger *merger, std::string const &base, int nentries,
+                 int ntasks)
+      : fMerger(merger), fBase(base), fNEntries(nentries), fNTasks(ntasks) {}
+
+  std::string GetFileName(int itask) const {
+    return fBase + Form(".mergechunk_%d.root", itask);
+  }
+
+  std::vector<double> Run(int itask) {
+    int first = (Long64_t(fNEntries) * itask) / fNTasks;
+    int last = (Long64_t(fNEntries) * (itask + 1)) / fNTasks;
+    return std::vector<double>(
+        1, fMerger->WriteMergedRange(GetFileName(itask), first, last));
+  }
+
+private:
+  SplineMerger *fMerger;
+  std::string fBase;
+  int fNEntries;
+  int fNTasks;
+};
+
+// Reads the entry count and config hash of each spline coefficient chunk,
+// returns {entries, 1 if the hash matches, 0 if it differs, -1 if missing}
+class CheckChunkTask : public ParallelUtils::Task {
+public:
+  CheckChunkTask(std::string const &base, std::string const &hash)
+      : fBase(base), fHash(hash) {}
+
+  std::string GetFileName(int itask) const {
+    return fBase + Form(".coeffchunk_%d.root", itask);
+  }
+
+  std::vector<double> Run(int itask) {
+    std::vector<double> result;
+    TFile chunkfile(GetFileName(itask).c_str(), "READ");
+    if (chunkfile.IsZombie())
+      return result;
+
+    TTree *splinetree = (TTree *)chunkfile.Get("spline_tree");
+    if (!splinetree)
+      return result;
+    result.push_back(splinetree->GetEntries());
+
+    std::string hash =
+        SplineReader::ReadConfigHash((TTree *)chunkfile.Get("spline_reader"));
+    result.push_back(hash.empty() ? -1 : (hash == fHash));
+    return result;
+  }
+
+private:
+  std::string fBase;
+  std::string fHash;
+};
+
+// Appends the tree of the same name in each file to tree by copying the
+// compressed baskets, without unpacking the entries.
+void AppendTrees(TTree *tree, std::vector<std::string> const &files,
+                 bool remove) {
+  for (size_t i = 0; i < files.size(); i++) {
+    TFile *chunkfile = new TFile(files[i].c_str(), "READ");
+    TTree *chunktree = (TTree *)chunkfile->Get(tree->GetName());
+    if (!chunktree) {
+      NUIS_ABORT("No " << tree->GetName() << " in " << files[i]);
+    }
+    tree->CopyEntries(chunktree, -1, "fast");
+    chunkfile->Close();
+    delete chunkfile;
+
+    if (remove)
+      gSystem->Unlink(files[i].c_str());
+    NUIS_LOG(REC, "Appended " << files[i]);
+  }
+}
+
+// Residual (spline - reweight) sums kept for each dial group and mode:
+// n, sum, sum of squares, max |residual|, sum of reweights, sum of splines
+const int kNResidualStats = 6;
+const int kNModes = 121;
+// Worst events are stored as event, set, reweight, spline weight
+const int kNWorstStats = 4;
+
+int GetModeIndex(int mode) {
+  return std::min(std::max(mode + kNModes / 2, 0), kNModes - 1);
+}
+
+struct ByLargest {
+  std::vector<double> const &val;
+  ByLargest(std::vector<double> const &x) : val(x) {}
+  bool operator()(int i, int j) const { return val[i] > val[j]; }
+};
+
+// Compares spline weights to full reweights for one range of events at
+// every parameter set. Results are the residual sums of each dial group
+// and mode, the summed weights of each set, and the worst events.
+class WeightCompareTask : public ParallelUtils::Task {
+public:
+  WeightCompareTask(FitWeight *rawrw, FitWeight *splrw,
+                    InputUtils::InputType inptype, std::string const &rawfile,
+                    std::string const &splfile,
+                    std::vector<std::vector<double> > const &parsets,
+                    std::vector<int> const &setgroups, int ngroups,
+                    int nworst, std::string const &treebase)
+      : fRawRW(rawrw), fSplRW(splrw), fInpType(inptype), fRawFile(rawfile),
+        fSplFile(splfile), fParSets(parsets), fSetGroups(setgroups),
+        fNGroups(ngroups), fNTasks(1), fNWorst(nworst), fTreeBase(treebase),
+        fPid(-1), fInput(NULL), fOutput(NULL) {}
+
+  /// Number of equal event ranges the events are split into
+  void SetNTasks(int ntasks) { fNTasks = ntasks; }
+
+  /// Opens the raw and spline events in this process, forked workers
+  /// must not share the parent's file offsets. Returns the event count.
+  int Open() {
+    if (fPid != getpid()) {
+      fInput = InputUtils::CreateInputHandler("rawevents", fInpType, fRawFile);
+      fOutput = InputUtils::CreateInputHandler(
+          "splineevents", InputUtils::kEVSPLN_Input, fSplFile);
+      fPid = getpid();
+    }
+    return fInput->GetNEvents();
+  }
+
+  std::string GetTreeFileName(int itask) const {
+    return fTreeBase + Form(".scanchunk_%d.root", itask);
+  }
+
+  std::vector<double> Run(int itask) {
+    int nevents = Open();
+    int first = (Long64_t(nevents) * itask) / fNTasks;
+    int last = (Long64_t(nevents) * (itask + 1)) / fNTasks;
+    int nrange = last - first;
+    int nsets = fParSets.size();
+    bool savetree = !fTreeBase.empty();
+
+    std::vector<double> result(
+        fNGroups * kNModes * kNResidualStats + 2 * nsets, 0.0);
+    double *settotals = &result[fNGroups * kNModes * kNResidualStats];
+
+    std::vector<double> worst(nrange, -1.0);
+    std::vector<int> worstset(nrange, -1);
+    std::vector<double> worstraw(nrange, 0.0);
+    std::vector<double> worstspl(nrange, 0.0);
+    std::vector<double> rawweights;
+    std::vector<double> splweights;
+    if (savetree) {
+      rawweights.resize(size_t(nrange) * nsets);
+      splweights.resize(size_t(nrange) * nsets);
+    }
+
+    for (int iset = 0; iset < nsets && nrange > 0; iset++) {
+      fRawRW->SetAllDials(&fParSets[iset][0], fParSets[iset].size());
+      fRawRW->Reconfigure();
+      fSplRW->SetAllDials(&fParSets[iset][0], fParSets[iset].size());
+      fSplRW->Reconfigure();
+      fOutput->GetNuisanceEvent(first)->fSplineRead->SetNeedsReconfigure(true);
+
+      int group = fSetGroups[iset];
+      for (int k = 0; k < nrange; k++) {
+        FitEvent *rawevent = fInput->GetNuisanceEvent(first + k);
+        FitEvent *splevent = fOutput->GetNuisanceEvent(first + k);
+
+        double raw = fRawRW->CalcWeight(rawevent);
+        double spl = fSplRW->CalcWeight(splevent);
+        double res = spl - raw;
+
+        double *cell = &result[(group * kNModes + GetModeIndex(rawevent->Mode)) *
+                               kNResidualStats];
+        cell[0] += 1.0;
+        cell[1] += res;
+        cell[2] += res * res;
+        cell[3] = std::max(cell[3], std::fabs(res));
+        cell[4] += raw;
+        cell[5] += spl;
+        settotals[2 * iset] += raw;
+        settotals[2 * iset + 1] += spl;
+
+        if (std::fabs(res) > worst[k]) {
+          worst[k] = std::fabs(res);
+          worstset[k] = iset;
+          worstraw[k] = raw;
+          worstspl[k] = spl;
+        }
+        if (savetree) {
+          rawweights[size_t(k) * nsets + iset] = raw;
+          splweights[size_t(k) * nsets + iset] = spl;
+        }
+      }
+    }
+
+    // Worst events in this range, padded with event -1
+    std::vector<int> order(nrange);
+    for (int k = 0; k < nrange; k++) {
+      order[k] = k;
+    }
+    int nkeep = std::min(fNWorst, nrange);
+    std::partial_sort(order.begin(), order.begin() + nkeep, order.end(),
+                      ByLargest(worst));
+    for (int i = 0; i < fNWorst; i++) {
+      int k = (i < nkeep) ? order[i] : -1;
+      result.push_back(k < 0 ? -1 : first + k);
+      result.push_back(k < 0 ? -1 : worstset[k]);
+      result.push_back(k < 0 ? 0.0 : worstraw[k]);
+      result.push_back(k < 0 ? 0.0 : worstspl[k]);
+    }
+
+    if (savetree) {
+      std::vector<double> raw(nsets), spl(nsets), dif(nsets);
+      TFile treefile(GetTreeFileName(itask).c_str(), "RECREATE");
+      TTree *weighttree = new TTree("weightscan", "weightscan");
+      for (int i = 0; i < nsets; i++) {
+        weighttree->Branch(Form("RawWeights_Set_%i", i), &raw[i],
+                           Form("RawWeights_Set_%i/D", i));
+        weighttree->Branch(Form("SplineWeights_Set_%i", i), &spl[i],
+                           Form("SplineWeights_Set_%i/D", i));
+        weighttree->Branch(Form("DifWeights_Set_%i", i), &dif[i],
+                           Form("DifWeights_Set_%i/D", i));
+      }
+      for (int k = 0; k < nrange; k++) {
+        for (int i = 0; i < nsets; i++) {
+          raw[i] = rawweights[size_t(k) * nsets + i];
+          spl[i] = splweights[size_t(k) * nsets + i];
+          dif[i] = spl[i] - raw[i];
+        }
+        weighttree->Fill();
+      }
+      weighttree->Write();
+      treefile.Close();
+    }
+
+    NUIS_LOG(REC, "Compared events " << first << "-" << last << " at "
+                                     << nsets << " parameter sets.");
+    return result;
+  }
+
+private:
+  FitWeight *fRawRW;
+  FitWeight *fSplRW;
+  InputUtils::InputType fInpType;
+  std::string fRawFile;
+  std::string fSplFile;
+  std::vector<std::vector<double> > const &fParSets;
+  std::vector<int> const &fSetGroups;
+  int fNGroups;
+  int fNTasks;
+  int fNWorst;
+  std::string fTreeBase;
+  int fPid;
+  InputHandlerBase *fInput;
+  InputHandlerBase *fOutput;
+};
+
+// Relative difference of the summed spline and reweighted predictions
+double GetBias(double raw, double spl) {
+  if (raw == 0.0)
+    return (spl == 0.0) ? 0.0 : 1.0;
+  return (spl - raw) / raw;
+}
+} // namespace
 
 void SplineRoutines::Init() {
 
@@ -1223,10 +1494,11 @@ void SplineRoutines::BuildEventSplines(int procchunk) {
     outputfile->cd();
     splinetree->Write();
 
+    // Every chunk keeps the spline header so the merge can check its hash
+    splwrite->Write("spline_reader");
+
     if (procchunk == -1 or procchunk == 0) {
       outputfile->cd();
-      splwrite->Write("spline_reader");
-
       TTree *nuisanceevents = (TTree *)weightsfile->Get("nuisance_events");
       nuisanceevents->CloneTree()->Write();
       weighttree->CloneTree()->Write();
@@ -1285,32 +1557,15 @@ void SplineRoutines::MergeEventSplinesChunks() {
                       << outputfilename);
     }
 
-    // Make new outputfile
-    TFile *outputfile = new TFile(outputfilename.c_str(), "RECREATE");
-    outputfile->cd();
-
     // Get Weights File
     TFile *weightsfile =
         new TFile((outputfilename + ".weights.root").c_str(), "READ");
     TTree *weighttree = (TTree *)weightsfile->Get("weight_tree");
 
     // Get SPLWRite Info
-    // splwrite->ReadWeightsFromTree(weighttree);
     int nevents = weighttree->GetEntries();
-    // int countwidth = (nevents / 1000);
-    // int nweights = splwrite->GetNWeights();
     int npar = splwrite->GetNPars();
 
-    // Make counter
-    // int lasttime = time(NULL);
-
-    // Setup Splines To Be Saved into TTree
-    outputfile->cd();
-    TTree *splinetree = new TTree("spline_tree", "spline_tree");
-
-    float *coeff = new float[npar];
-    splinetree->Branch("SplineCoeff", coeff, Form("SplineCoeff[%d]/F", npar));
-
     // Load N Chunks of the Weights into Memory
     // Split into N processing chunks
     int nchunks = FitPar::Config().GetParI("spline_chunks");
@@ -1320,35 +1575,43 @@ void SplineRoutines::MergeEventSplinesChunks() {
       nchunks = nevents / 2;
     int neventsinchunk = nevents / nchunks;
 
-    for (int ichunk = 0; ichunk < nchunks; ichunk++) {
-
-      // Get Output File
-      TFile *chunkfile = new TFile(
-          (outputfilename + std::string(Form(".coeffchunk_%d.root", ichunk)))
-              .c_str());
+    // Check every chunk before writing anything, chunks built from another
+    // spline config would silently shift the coefficients
+    CheckChunkTask check(outputfilename, splwrite->GetConfigHash());
+    std::vector<std::vector<double> > checked = ParallelUtils::RunTasks(
+        check, nchunks, ParallelUtils::GetNWorkers("spline_cores"));
 
-      // Get TTree for spline coeffchunk
-      TTree *splinetreechunk = (TTree *)chunkfile->Get("spline_tree");
+    std::vector<std::string> chunkfiles;
+    for (int ichunk = 0; ichunk < nchunks; ichunk++) {
+      std::string chunkname = check.GetFileName(ichunk);
+      if (checked[ichunk].size() != 2) {
+        NUIS_ABORT("Cannot read spline_tree from chunk " << chunkname);
+      }
+      if (int(checked[ichunk][0]) != neventsinchunk) {
+        NUIS_ABORT("Chunk " << chunkname << " has " << checked[ichunk][0]
+                            << " events, expected " << neventsinchunk);
+      }
+      if (checked[ichunk][1] == 0) {
+        NUIS_ABORT("Chunk " << chunkname
+                            << " was built from a different spline config.");
+      } else if (checked[ichunk][1] < 0) {
+        NUIS_ERR(WRN, "Chunk " << chunkname
+                               << " has no spline config hash to check.");
+      }
+      chunkfiles.push_back(chunkname);
+    }
 
-      // Set Branch Address to coeffchunk
-      float *coeffchunk = new float[npar];
-      splinetreechunk->SetBranchAddress("SplineCoeff", coeffchunk);
+    // Make new outputfile
+    TFile *outputfile = new TFile(outputfilename.c_str(), "RECREATE");
+    outputfile->cd();
 
-      // Loop over nevents in chunk
-      for (int k = 0; k < neventsinchunk; k++) {
-        splinetreechunk->GetEntry(k);
-        for (int j = 0; j < npar; j++) {
-          coeff[j] = coeffchunk[j];
-        }
-        splinetree->Fill();
-      }
+    // Setup Splines To Be Saved into TTree
+    TTree *splinetree = new TTree("spline_tree", "spline_tree");
 
-      // Close up
-      chunkfile->Close();
-      delete coeffchunk;
+    float *coeff = new float[npar];
+    splinetree->Branch("SplineCoeff", coeff, Form("SplineCoeff[%d]/F", npar));
 
-      std::cout << "Merged chunk " << ichunk << std::endl;
-    }
+    AppendTrees(splinetree, chunkfiles, false);
 
     // Save flux and close file
     outputfile->cd();
@@ -1434,13 +1697,42 @@ void SplineRoutines::MergeSplines() {
                     << outputfilename);
   }
 
+  // Get info from inputhandler
+  int nevents = input->GetNEvents();
+  int countwidth = (nevents / 1000);
+  if (countwidth <= 0)
+    countwidth = 1;
+  if (nevents != splmerge->GetNEntries()) {
+    NUIS_ABORT("Event file " << inputfilename << " has " << nevents
+                             << " events but the spline files have "
+                             << splmerge->GetNEntries());
+  }
+
+  // Join the coefficients range by range in workers, before the output
+  // file is open so nothing unwritten is copied into them
+  int nworkers = ParallelUtils::GetNWorkers("spline_cores");
+  int ntasks = std::max(1, std::min(nworkers, nevents));
+  MergeRangeTask merge(splmerge, outputfilename, nevents, ntasks);
+  std::vector<std::vector<double> > merged =
+      ParallelUtils::RunTasks(merge, ntasks, nworkers);
+
+  std::vector<std::string> rangefiles;
+  int nmerged = 0;
+  for (int itask = 0; itask < ntasks; itask++) {
+    if (merged[itask].empty()) {
+      NUIS_ABORT("Failed to merge splines into " << merge.GetFileName(itask));
+    }
+    nmerged += int(merged[itask][0]);
+    rangefiles.push_back(merge.GetFileName(itask));
+  }
+  if (nmerged != nevents) {
+    NUIS_ABORT("Merged " << nmerged << " spline entries, expected " << nevents);
+  }
+
   // Make new outputfile
   TFile *outputfile = new TFile(outputfilename.c_str(), "RECREATE");
   outputfile->cd();
 
-  // Get info from inputhandler
-  int nevents = input->GetNEvents();
-  int countwidth = (nevents / 1000);
   FitEvent *nuisevent = input->FirstNuisanceEvent();
 
   // Setup a TTree to save the event
@@ -1453,21 +1745,18 @@ void SplineRoutines::MergeSplines() {
   // Save the spline reader
   splmerge->Write("spline_reader");
 
-  // Setup the spline TTree
+  // Setup the spline TTree, filled from the merged ranges in order
   TTree *splinetree = new TTree("spline_tree", "spline_tree");
   splmerge->AddCoefficientsToTree(splinetree);
+  AppendTrees(splinetree, rangefiles, true);
 
   int lasttime = time(NULL);
   int i = 0;
   // Loop over all events and fill the TTree
   while (nuisevent) {
 
-    // Calculate the weights for each parameter set
-    splmerge->FillMergedSplines(i);
-
     // Save everything
     eventtree->Fill();
-    splinetree->Fill();
 
     // Logging
     if (i % countwidth == 0) {
@@ -1544,6 +1833,8 @@ void SplineRoutines::TestSplines_1DEventScan() {
 
   std::vector<std::vector<double> > scanparset_vals;
   std::vector<TH1D *> scanparset_hists;
+  std::vector<int> scanparset_groups;
+  std::vector<std::string> parameter_names;
 
   // Loop over all params
   // Add Parameters
@@ -1552,6 +1843,7 @@ void SplineRoutines::TestSplines_1DEventScan() {
 
     // Get Par Name
     std::string name = key.GetS("name");
+    parameter_names.push_back(name);
 
     if (!key.Has("low") or !key.Has("high") or !key.Has("step")) {
       continue;
@@ -1571,6 +1863,7 @@ void SplineRoutines::TestSplines_1DEventScan() {
 
       // Add to vects
       scanparset_vals.push_back(newvals);
+      scanparset_groups.push_back(i);
 
       TH1D *parhist = (TH1D *)parhisttemplate->Clone();
       for (size_t j = 0; j < newvals.size(); j++) {
@@ -1592,179 +1885,8 @@ void SplineRoutines::TestSplines_1DEventScan() {
     std::cout << std::endl;
   }
 
-  // Weight holders
-  double *rawweights = new double[scanparset_vals.size()];
-  double *splweights = new double[scanparset_vals.size()];
-  double *difweights = new double[scanparset_vals.size()];
-  int nweights = scanparset_vals.size();
-  // int NParSets = scanparset_vals.size();
-
-  // Loop over all event I/O
-  std::vector<nuiskey> eventkeys = Config::QueryKeys("events");
-  for (size_t i = 0; i < eventkeys.size(); i++) {
-    nuiskey key = eventkeys.at(i);
-
-    // Get I/O
-    std::string inputfilename = key.GetS("input");
-    if (inputfilename.empty()) {
-      NUIS_ABORT("No input given for set of input events!")
-    }
-
-    std::string outputfilename = key.GetS("output");
-    if (outputfilename.empty()) {
-      outputfilename = inputfilename + ".nuisance.root";
-      NUIS_ERR(WRN, "No output give for set of output events! Saving to "
-                      << outputfilename);
-    }
-
-    // Make a new input handler
-    std::vector<std::string> file_descriptor =
-        GeneralUtils::ParseToStr(inputfilename, ":");
-    if (file_descriptor.size() != 2) {
-      NUIS_ABORT("File descriptor had no filetype declaration: \""
-             << inputfilename << "\". expected \"FILETYPE:file.root\"");
-    }
-    InputUtils::InputType inptype =
-        InputUtils::ParseInputType(file_descriptor[0]);
-
-    // Make handlers for input and output
-    InputHandlerBase *input = InputUtils::CreateInputHandler(
-        "rawevents", inptype, file_descriptor[1]);
-    InputHandlerBase *output = InputUtils::CreateInputHandler(
-        "splineevents", InputUtils::kEVSPLN_Input, outputfilename);
-
-    // Get Base Events for each case.
-    FitEvent *rawevent = input->FirstNuisanceEvent();
-    FitEvent *splevent = output->FirstNuisanceEvent();
-
-    // Setup outputfile
-    std::string outputtest = outputfilename + ".splinetest.1DEventScan.root";
-    TFile *outputtestfile = new TFile(outputtest.c_str(), "RECREATE");
-    outputtestfile->cd();
-
-    // Save Parameter Sets
-    for (size_t i = 0; i < scanparset_hists.size(); i++) {
-      scanparset_hists[i]->Write(Form("Paramater_Set_%i", (int)i));
-    }
-
-    // Save a TTree of weights and differences.
-    TTree *weighttree = new TTree("weightscan", "weightscan");
-
-    // Make a branch for each weight set
-    for (size_t i = 0; i < scanparset_hists.size(); i++) {
-      weighttree->Branch(Form("RawWeights_Set_%i", (int)i), &rawweights[i],
-                         Form("RawWeights_Set_%i/D", (int)i));
-      weighttree->Branch(Form("SplineWeights_Set_%i", (int)i), &splweights[i],
-                         Form("SplineWeights_Set_%i/D", (int)i));
-      weighttree->Branch(Form("DifWeights_Set_%i", (int)i), &difweights[i],
-                         Form("DifWeights_Set_%i/D", (int)i));
-    }
-
-    // Count
-    // int i = 0;
-    int nevents = input->GetNEvents();
-    int lasttime = time(NULL);
-
-    // Load N Chunks of the Weights into Memory
-    // Split into N processing chunks
-    int nchunks = FitPar::Config().GetParI("spline_chunks");
-    if (nchunks <= 0)
-      nchunks = 1;
-    if (nchunks >= nevents / 2)
-      nchunks = nevents / 2;
-
-    std::cout << "Starting NChunks " << nchunks << std::endl;
-    for (int ichunk = 0; ichunk < nchunks; ichunk++) {
-
-      // Skip to only do one processing chunk
-      //      if (procchunk != -1 and procchunk != ichunk) continue;
-
-      NUIS_LOG(FIT, "On Processing Chunk " << ichunk);
-      int neventsinchunk = nevents / nchunks;
-      int loweventinchunk = neventsinchunk * ichunk;
-      // int higheventinchunk = neventsinchunk * (ichunk + 1);
-
-      double **allrawweights = new double *[neventsinchunk];
-      double **allsplweights = new double *[neventsinchunk];
-      double **alldifweights = new double *[neventsinchunk];
-      for (int k = 0; k < neventsinchunk; k++) {
-        allrawweights[k] = new double[nweights];
-        allsplweights[k] = new double[nweights];
-        alldifweights[k] = new double[nweights];
-      }
-
-      // Start Set Processing Here.
-      for (int iset = 0; iset < nweights; iset++) {
-
-        // Reconfigure
-        fRW->SetAllDials(&scanparset_vals[iset][0],
-                         scanparset_vals[iset].size());
-        fRW->Reconfigure();
-
-        // Reconfigure spline RW
-        splweight->SetAllDials(&scanparset_vals[iset][0],
-                               scanparset_vals[iset].size());
-        splweight->Reconfigure();
-
-        splevent->fSplineRead->SetNeedsReconfigure(true);
-
-        // Could reorder this to save the weightconts in order instead of
-        // reconfiguring per event. Loop over all events and fill the TTree
-        for (int i = 0; i < neventsinchunk; i++) {
-
-          rawevent = input->GetNuisanceEvent(i + loweventinchunk);
-          splevent = output->GetNuisanceEvent(i + loweventinchunk);
-
-          allrawweights[i][iset] = fRW->CalcWeight(rawevent);
-          allsplweights[i][iset] = splweight->CalcWeight(splevent);
-          alldifweights[i][iset] =
-              allsplweights[i][iset] - allrawweights[i][iset];
-        }
-
-        std::ostringstream timestring;
-        int timeelapsed = time(NULL) - lasttime;
-        if (timeelapsed) {
-          lasttime = time(NULL);
-
-          int setsleft =
-              (nweights - iset - 1) + (nweights * (nchunks - ichunk - 1));
-          float proj = (float(setsleft) * timeelapsed) / 60 / 60;
-          timestring << setsleft << " sets remaining. Last one took "
-                     << timeelapsed << ". " << proj << " hours remaining.";
-        }
-
-        NUIS_LOG(REC, "Processed Set " << iset << "/" << nweights << " in chunk "
-                                   << ichunk << "/" << nchunks << " "
-                                   << timestring.str());
-      }
-
-      // Fill weights for this chunk into the TTree
-      for (int k = 0; k < neventsinchunk; k++) {
-        for (int l = 0; l < nweights; l++) {
-          rawweights[l] = allrawweights[k][l];
-          splweights[l] = allsplweights[k][l];
-          difweights[l] = alldifweights[k][l];
-        }
-        weighttree->Fill();
-      }
-    }
-
-    // Loop over nchunks
-
-    // Loop over parameter sets
-    // Set All Dials and reconfigure
-
-    // Loop over events in chunk
-    // Fill Chunkweightcontainers
-
-    // Once all dials are done, fill the weight tree
-
-    // Iterator to next chunk
-
-    outputtestfile->cd();
-    weighttree->Write();
-    outputtestfile->Close();
-  }
+  CompareEventWeights("1DEventScan", splweight, scanparset_vals,
+                      scanparset_hists, scanparset_groups, parameter_names);
 }
 
 /*
@@ -2021,12 +2143,31 @@ void SplineRoutines::TestSplines_NDEventThrow() {
     std::cout << std::endl;
   }
 
-  // Weight holders
-  double *rawweights = new double[scanparset_vals.size()];
-  double *splweights = new double[scanparset_vals.size()];
-  double *difweights = new double[scanparset_vals.size()];
-  int nweights = scanparset_vals.size();
-  // int NParSets = scanparset_vals.size();
+  // Every throw moves all dials, so they are summarised together
+  std::vector<int> scanparset_groups(scanparset_vals.size(), 0);
+  CompareEventWeights("NDEventThrow", splweight, scanparset_vals,
+                      scanparset_hists, scanparset_groups,
+                      std::vector<std::string>(1, "throws"));
+}
+
+//*************************************
+void SplineRoutines::CompareEventWeights(
+    std::string const &testname, FitWeight *splweight,
+    std::vector<std::vector<double> > const &parsets,
+    std::vector<TH1D *> const &parhists, std::vector<int> const &setgroups,
+    std::vector<std::string> const &groupnames) {
+  //*************************************
+
+  int nsets = parsets.size();
+  int ngroups = groupnames.size();
+  int nworst = std::max(0, FitPar::Config().GetParI("spline_test_worst"));
+  double restol = FitPar::Config().GetParD("spline_test_tolerance");
+  double biastol = FitPar::Config().GetParD("spline_test_bias_tolerance");
+  bool saveevents = FitPar::Config().GetParB("spline_test_eventtree");
+  int nworkers = ParallelUtils::GetNWorkers("spline_cores");
+
+  int nstats = ngroups * kNModes * kNResidualStats;
+  size_t nresult = nstats + 2 * nsets + nworst * kNWorstStats;
 
   // Loop over all event I/O
   std::vector<nuiskey> eventkeys = Config::QueryKeys("events");
@@ -2056,143 +2197,338 @@ void SplineRoutines::TestSplines_NDEventThrow() {
     InputUtils::InputType inptype =
         InputUtils::ParseInputType(file_descriptor[0]);
 
-    // Make handlers for input and output
-    InputHandlerBase *input = InputUtils::CreateInputHandler(
-        "rawevents", inptype, file_descriptor[1]);
-    InputHandlerBase *output = InputUtils::CreateInputHandler(
-        "splineevents", InputUtils::kEVSPLN_Input, outputfilename);
+    std::string outputtest =
+        outputfilename + ".splinetest." + testname + ".root";
+
+    WeightCompareTask task(fRW, splweight, inptype, file_descriptor[1],
+                           outputfilename, parsets, setgroups, ngroups, nworst,
+                           saveevents ? outputtest : "");
+    int nevents = task.Open();
+
+    // Split into at least one range per worker
+    int ntasks = FitPar::Config().GetParI("spline_chunks");
+    ntasks = std::min(std::max(ntasks, nworkers), nevents);
+    ntasks = std::max(ntasks, 1);
+    task.SetNTasks(ntasks);
+
+    NUIS_LOG(FIT, "Comparing " << nevents << " events at " << nsets
+                               << " parameter sets in " << ntasks
+                               << " ranges using " << nworkers
+                               << " worker(s).");
+    std::vector<std::vector<double> > results =
+        ParallelUtils::RunTasks(task, ntasks, nworkers);
+
+    // Combine the ranges
+    std::vector<double> stats(nstats + 2 * nsets, 0.0);
+    std::vector<std::vector<double> > worstevents;
+    for (int itask = 0; itask < ntasks; itask++) {
+      std::vector<double> const &res = results[itask];
+      if (res.size() != nresult) {
+        NUIS_ABORT("Failed to compare spline weights in event range "
+                   << itask << " of " << outputfilename);
+      }
+      for (size_t j = 0; j < stats.size(); j++) {
+        if (int(j) < nstats && (j % kNResidualStats) == 3)
+          stats[j] = std::max(stats[j], res[j]);
+        else
+          stats[j] += res[j];
+      }
+      for (int w = 0; w < nworst; w++) {
+        double const *worst = &res[nstats + 2 * nsets + w * kNWorstStats];
+        if (worst[0] >= 0)
+          worstevents.push_back(
+              std::vector<double>(worst, worst + kNWorstStats));
+      }
+    }
 
-    // Get Base Events for each case.
-    FitEvent *rawevent = input->FirstNuisanceEvent();
-    FitEvent *splevent = output->FirstNuisanceEvent();
+    std::vector<double> worstres(worstevents.size());
+    std::vector<int> worstorder(worstevents.size());
+    for (size_t w = 0; w < worstevents.size(); w++) {
+      worstres[w] = std::fabs(worstevents[w][3] - worstevents[w][2]);
+      worstorder[w] = w;
+    }
+    int nkeep = std::min(nworst, int(worstevents.size()));
+    std::partial_sort(worstorder.begin(), worstorder.begin() + nkeep,
+                      worstorder.end(), ByLargest(worstres));
 
     // Setup outputfile
-    std::string outputtest = outputfilename + ".splinetest.NDEventThrow.root";
     TFile *outputtestfile = new TFile(outputtest.c_str(), "RECREATE");
     outputtestfile->cd();
 
     // Save Parameter Sets
-    for (size_t i = 0; i < scanparset_hists.size(); i++) {
-      scanparset_hists[i]->Write(Form("Paramater_Set_%i", (int)i));
+    for (size_t j = 0; j < parhists.size(); j++) {
+      parhists[j]->Write(Form("Paramater_Set_%i", (int)j));
+    }
+
+    // Per event weights are only kept when asked for, they grow with
+    // events x sets
+    if (saveevents) {
+      std::vector<double> treevals(3 * nsets);
+      TTree *weighttree = new TTree("weightscan", "weightscan");
+      for (int j = 0; j < nsets; j++) {
+        weighttree->Branch(Form("RawWeights_Set_%i", j), &treevals[3 * j],
+                           Form("RawWeights_Set_%i/D", j));
+        weighttree->Branch(Form("SplineWeights_Set_%i", j),
+                           &treevals[3 * j + 1],
+                           Form("SplineWeights_Set_%i/D", j));
+        weighttree->Branch(Form("DifWeights_Set_%i", j), &treevals[3 * j + 2],
+                           Form("DifWeights_Set_%i/D", j));
+      }
+      std::vector<std::string> treefiles;
+      for (int itask = 0; itask < ntasks; itask++) {
+        treefiles.push_back(task.GetTreeFileName(itask));
+      }
+      AppendTrees(weighttree, treefiles, true);
+      outputtestfile->cd();
+      weighttree->Write();
+    }
+
+    std::string reportname =
+        outputfilename + ".splinetest." + testname + ".report";
+    std::ofstream report(reportname.c_str());
+    report << "# Spline test " << testname << " of " << outputfilename
+           << "\n# tolerance residual " << restol << " bias " << biastol
+           << "\n# dial mode nevents mean rms maxresidual bias status\n";
+
+    // Residuals for each dial group and mode
+    std::string dialname;
+    int mode, pass;
+    double nevt, mean, rms, maxres, bias;
+    TTree *summary = new TTree("residual_summary", "residual_summary");
+    summary->Branch("Dial", &dialname);
+    summary->Branch("Mode", &mode, "Mode/I");
+    summary->Branch("NEvents", &nevt, "NEvents/D");
+    summary->Branch("MeanResidual", &mean, "MeanResidual/D");
+    summary->Branch("RMSResidual", &rms, "RMSResidual/D");
+    summary->Branch("MaxResidual", &maxres, "MaxResidual/D");
+    summary->Branch("Bias", &bias, "Bias/D");
+    summary->Branch("Pass", &pass, "Pass/I");
+
+    int nfailed = 0;
+    int nchecked = 0;
+    for (int g = 0; g < ngroups; g++) {
+      double groupmax = 0.0;
+      double groupsum2 = 0.0;
+      double groupn = 0.0;
+      for (int m = 0; m < kNModes; m++) {
+        double const *cell = &stats[(g * kNModes + m) * kNResidualStats];
+        if (cell[0] <= 0.0)
+          continue;
+
+        dialname = groupnames[g];
+        mode = m - kNModes / 2;
+        nevt = cell[0];
+        mean = cell[1] / cell[0];
+        rms = std::sqrt(cell[2] / cell[0]);
+        maxres = cell[3];
+        bias = GetBias(cell[4], cell[5]);
+        pass = (maxres <= restol && std::fabs(bias) <= biastol);
+        summary->Fill();
+
+        nchecked++;
+        if (!pass)
+          nfailed++;
+        report << dialname << " " << mode << " " << nevt << " " << mean << " "
+               << rms << " " << maxres << " " << bias << " "
+               << (pass ? "PASS" : "FAIL") << "\n";
+
+        groupmax = std::max(groupmax, maxres);
+        groupsum2 += cell[2];
+        groupn += cell[0];
+      }
+      if (groupn > 0.0) {
+        NUIS_LOG(FIT, testname << " " << groupnames[g] << ": max residual "
+                               << groupmax << ", RMS residual "
+                               << std::sqrt(groupsum2 / groupn));
+      }
     }
+    summary->Write();
+
+    // Summed predictions at each set
+    int set;
+    double rawtotal, spltotal;
+    TTree *setsummary = new TTree("set_summary", "set_summary");
+    setsummary->Branch("Set", &set, "Set/I");
+    setsummary->Branch("RawTotal", &rawtotal, "RawTotal/D");
+    setsummary->Branch("SplineTotal", &spltotal, "SplineTotal/D");
+    setsummary->Branch("Bias", &bias, "Bias/D");
+    setsummary->Branch("Pass", &pass, "Pass/I");
+    for (set = 0; set < nsets; set++) {
+      rawtotal = stats[nstats + 2 * set];
+      spltotal = stats[nstats + 2 * set + 1];
+      bias = GetBias(rawtotal, spltotal);
+      pass = (std::fabs(bias) <= biastol);
+      setsummary->Fill();
+
+      nchecked++;
+      if (!pass)
+        nfailed++;
+      report << "set " << set << " " << rawtotal << " " << spltotal << " "
+             << bias << " " << (pass ? "PASS" : "FAIL") << "\n";
+    }
+    setsummary->Write();
+
+    // Largest single event residuals
+    int event;
+    double rawweight, splweightval, residual;
+    TTree *worsttree = new TTree("worst_events", "worst_events");
+    worsttree->Branch("Event", &event, "Event/I");
+    worsttree->Branch("Set", &set, "Set/I");
+    worsttree->Branch("RawWeight", &rawweight, "RawWeight/D");
+    worsttree->Branch("SplineWeight", &splweightval, "SplineWeight/D");
+    worsttree->Branch("Residual", &residual, "Residual/D");
+    for (int w = 0; w < nkeep; w++) {
+      std::vector<double> const &worst = worstevents[worstorder[w]];
+      event = worst[0];
+      set = worst[1];
+      rawweight = worst[2];
+      splweightval = worst[3];
+      residual = splweightval - rawweight;
+      worsttree->Fill();
+      report << "event " << event << " " << set << " " << rawweight << " "
+             << splweightval << " " << residual << "\n";
+    }
+    worsttree->Write();
+
+    report << "result " << (nfailed ? "FAIL" : "PASS") << " " << nfailed
+           << " of " << nchecked << " checks failed\n";
+    report.close();
 
-    // Save a TTree of weights and differences.
-    TTree *weighttree = new TTree("weightscan", "weightscan");
+    outputtestfile->Close();
 
-    // Make a branch for each weight set
-    for (size_t i = 0; i < scanparset_hists.size(); i++) {
-      weighttree->Branch(Form("RawWeights_Set_%i", (int)i), &rawweights[i],
-                         Form("RawWeights_Set_%i/D", (int)i));
-      weighttree->Branch(Form("SplineWeights_Set_%i", (int)i), &splweights[i],
-                         Form("SplineWeights_Set_%i/D", (int)i));
-      weighttree->Branch(Form("DifWeights_Set_%i", (int)i), &difweights[i],
-                         Form("DifWeights_Set_%i/D", (int)i));
+    if (nfailed) {
+      NUIS_ERR(WRN, testname << " failed " << nfailed << " of " << nchecked
+                             << " tolerance checks, see " << reportname);
+    } else {
+      NUIS_LOG(FIT, testname << " passed all " << nchecked
+                             << " tolerance checks, see " << reportname);
     }
+  }
+}
 
-    // Count
-    // int i = 0;
-    int nevents = input->GetNEvents();
-    int lasttime = time(NULL);
-
-    // Load N Chunks of the Weights into Memory
-    // Split into N processing chunks
-    int nchunks = FitPar::Config().GetParI("spline_chunks");
-    if (nchunks <= 0)
-      nchunks = 1;
-    if (nchunks >= nevents / 2)
-      nchunks = nevents / 2;
-
-    std::cout << "Starting NChunks " << nchunks << std::endl;
-    for (int ichunk = 0; ichunk < nchunks; ichunk++) {
-
-      // Skip to only do one processing chunk
-      //      if (procchunk != -1 and procchunk != ichunk) continue;
-
-      NUIS_LOG(FIT, "On Processing Chunk " << ichunk);
-      int neventsinchunk = nevents / nchunks;
-      int loweventinchunk = neventsinchunk * ichunk;
-      // int higheventinchunk = neventsinchunk * (ichunk + 1);
-
-      double **allrawweights = new double *[neventsinchunk];
-      double **allsplweights = new double *[neventsinchunk];
-      double **alldifweights = new double *[neventsinchunk];
-      for (int k = 0; k < neventsinchunk; k++) {
-        allrawweights[k] = new double[nweights];
-        allsplweights[k] = new double[nweights];
-        alldifweights[k] = new double[nweights];
-      }
-
-      // Start Set Processing Here.
-      for (int iset = 0; iset < nweights; iset++) {
-
-        // Reconfigure
-        fRW->SetAllDials(&scanparset_vals[iset][0],
-                         scanparset_vals[iset].size());
-        fRW->Reconfigure();
-
-        // Reconfigure spline RW
-        splweight->SetAllDials(&scanparset_vals[iset][0],
-                               scanparset_vals[iset].size());
-        splweight->Reconfigure();
-
-        splevent->fSplineRead->SetNeedsReconfigure(true);
-
-        // Could reorder this to save the weightconts in order instead of
-        // reconfiguring per event. Loop over all events and fill the TTree
-        for (int i = 0; i < neventsinchunk; i++) {
-
-          rawevent = input->GetNuisanceEvent(i + loweventinchunk);
-          splevent = output->GetNuisanceEvent(i + loweventinchunk);
-
-          allrawweights[i][iset] = fRW->CalcWeight(rawevent);
-          allsplweights[i][iset] = splweight->CalcWeight(splevent);
-          alldifweights[i][iset] =
-              allsplweights[i][iset] - allrawweights[i][iset];
-        }
+//*************************************
+void SplineRoutines::CompareLikelihoods(
+    std::string const &testname,
+    std::vector<std::vector<double> > const &parsets,
+    std::vector<double> const &rawtotals,
+    std::vector<double> const &spltotals,
+    std::vector<std::vector<double> > const &rawbins,
+    std::vector<std::vector<double> > const &splbins,
+    std::vector<std::string> const &binsamples,
+    std::vector<int> const &binnumbers) {
+  //*************************************
 
-        std::ostringstream timestring;
-        int timeelapsed = time(NULL) - lasttime;
-        if (timeelapsed) {
-          lasttime = time(NULL);
+  double tol = FitPar::Config().GetParD("spline_test_likelihood_tolerance");
+  double bintol = FitPar::Config().GetParD("spline_test_bin_tolerance");
 
-          int setsleft =
-              (nweights - iset - 1) + (nweights * (nchunks - ichunk - 1));
-          float proj = (float(setsleft) * timeelapsed) / 60 / 60;
-          timestring << setsleft << " sets remaining. Last one took "
-                     << timeelapsed << ". " << proj << " hours remaining.";
-        }
+  std::string reportname = fOutputFile + ".splinetest." + testname + ".report";
+  std::ofstream report(reportname.c_str());
+  report << "# Spline test " << testname << " of " << fOutputFile
+         << "\n# tolerance likelihood " << tol << " bin " << bintol
+         << "\n# set raw spline difference worstbin reldifference status\n";
 
-        NUIS_LOG(REC, "Processed Set " << iset << "/" << nweights << " in chunk "
-                                   << ichunk << "/" << nchunks << " "
-                                   << timestring.str());
+  int set, pass;
+  double raw, spl, dif;
+  std::vector<double> pars;
+  fOutputRootFile->cd();
+  TTree *summary = new TTree("likelihood_summary", "likelihood_summary");
+  summary->Branch("Set", &set, "Set/I");
+  summary->Branch("Parameters", &pars);
+  summary->Branch("RawLikelihood", &raw, "RawLikelihood/D");
+  summary->Branch("SplineLikelihood", &spl, "SplineLikelihood/D");
+  summary->Branch("Difference", &dif, "Difference/D");
+  summary->Branch("Pass", &pass, "Pass/I");
+
+  // Per bin MC predictions, relative to the raw prediction or, for bins
+  // well below the rest, the sample's mean raw bin
+  int bin;
+  std::string sample;
+  double rawbin, splbin, bindif, binrel;
+  TTree *binsummary = new TTree("bin_summary", "bin_summary");
+  binsummary->Branch("Set", &set, "Set/I");
+  binsummary->Branch("Sample", &sample);
+  binsummary->Branch("Bin", &bin, "Bin/I");
+  binsummary->Branch("RawMC", &rawbin, "RawMC/D");
+  binsummary->Branch("SplineMC", &splbin, "SplineMC/D");
+  binsummary->Branch("Difference", &bindif, "Difference/D");
+  binsummary->Branch("RelDifference", &binrel, "RelDifference/D");
+
+  int nfailed = 0;
+  double maxdif = 0.0;
+  double maxbinrel = 0.0;
+  for (set = 0; set < int(parsets.size()); set++) {
+    pars = parsets[set];
+    raw = rawtotals[set];
+    spl = spltotals[set];
+    dif = spl - raw;
+
+    double worstrel = 0.0;
+    std::string worstbin = "none";
+    if (set < int(rawbins.size()) && set < int(splbins.size()) &&
+        rawbins[set].size() == binsamples.size() &&
+        splbins[set].size() == binsamples.size()) {
+      std::map<std::string, std::pair<double, int> > samplesums;
+      for (size_t i = 0; i < binsamples.size(); i++) {
+        std::pair<double, int> &sum = samplesums[binsamples[i]];
+        sum.first += std::fabs(rawbins[set][i]);
+        sum.second++;
       }
 
-      // Fill weights for this chunk into the TTree
-      for (int k = 0; k < neventsinchunk; k++) {
-        for (int l = 0; l < nweights; l++) {
-          rawweights[l] = allrawweights[k][l];
-          splweights[l] = allsplweights[k][l];
-          difweights[l] = alldifweights[k][l];
+      for (size_t i = 0; i < binsamples.size(); i++) {
+        sample = binsamples[i];
+        bin = binnumbers[i];
+        rawbin = rawbins[set][i];
+        splbin = splbins[set][i];
+        bindif = splbin - rawbin;
+
+        // A sample with no raw MC at all can only be judged on the spline
+        std::pair<double, int> const &sum = samplesums[sample];
+        double scale = std::max(std::fabs(rawbin), sum.first / sum.second);
+        if (scale == 0.0)
+          scale = std::fabs(splbin);
+        binrel = (scale != 0.0) ? bindif / scale : 0.0;
+        binsummary->Fill();
+
+        if (std::fabs(binrel) > worstrel) {
+          worstrel = std::fabs(binrel);
+          worstbin = sample + ":" + GeneralUtils::IntToStr(bin);
         }
-        weighttree->Fill();
       }
-    }
-
-    // Loop over nchunks
-
-    // Loop over parameter sets
-    // Set All Dials and reconfigure
-
-    // Loop over events in chunk
-    // Fill Chunkweightcontainers
-
-    // Once all dials are done, fill the weight tree
-
-    // Iterator to next chunk
-
-    outputtestfile->cd();
-    weighttree->Write();
-    outputtestfile->Close();
+    } else {
+      NUIS_ERR(WRN, testname << " set " << set
+                             << " has mismatched raw/spline MC binning,"
+                                " skipping its bin comparison.");
+    }
+
+    pass = (std::fabs(dif) <= tol && worstrel <= bintol);
+    summary->Fill();
+
+    NUIS_LOG(FIT, "RAW SPLINE DIF = " << raw << " " << spl << " " << dif
+                                      << " (worst bin " << worstbin << " "
+                                      << worstrel << ")");
+    report << set << " " << raw << " " << spl << " " << dif << " " << worstbin
+           << " " << worstrel << " " << (pass ? "PASS" : "FAIL") << "\n";
+    maxdif = std::max(maxdif, std::fabs(dif));
+    maxbinrel = std::max(maxbinrel, worstrel);
+    if (!pass)
+      nfailed++;
+  }
+  summary->Write();
+  binsummary->Write();
+
+  report << "result " << (nfailed ? "FAIL" : "PASS") << " " << nfailed
+         << " of " << parsets.size() << " checks failed\n";
+  report.close();
+
+  if (nfailed) {
+    NUIS_ERR(WRN, testname << " failed " << nfailed << " of " << parsets.size()
+                           << " likelihood checks (max difference " << maxdif
+                           << ", max bin difference " << maxbinrel
+                           << "), see " << reportname);
+  } else {
+    NUIS_LOG(FIT, testname << " passed all likelihood checks (max difference "
+                           << maxdif << ", max bin difference " << maxbinrel
+                           << "), see " << reportname);
   }
 }
 
@@ -2421,18 +2757,26 @@ void SplineRoutines::TestSplines_NDLikelihoodThrow() {
   rawfcn->CreateIterationTree("raw_iterations", fRW);
   splfcn->CreateIterationTree("spl_iterations", splweight);
 
-  // Loop over parameter sets.
-  for (size_t j = 0; j < scanparset_vals.size(); j++) {
+  rawfcn->SetNParams(nomvals.size());
+  splfcn->SetNParams(nomvals.size());
 
-    FitBase::SetRW(fRW);
-    double rawtotal = rawfcn->DoEval(&scanparset_vals[j][0]);
+  // Throws are independent, evaluate each FCN over the worker pool.
+  // The MC predictions are kept at every set for the per bin comparison.
+  std::vector<std::vector<double> > rawbins, splbins;
+  FitBase::SetRW(fRW);
+  std::vector<double> rawtotals =
+      rawfcn->DoEvalPoints(scanparset_vals, &rawbins);
 
-    FitBase::SetRW(splweight);
-    double spltotal = splfcn->DoEval(&scanparset_vals[j][0]);
+  FitBase::SetRW(splweight);
+  std::vector<double> spltotals =
+      splfcn->DoEvalPoints(scanparset_vals, &splbins);
 
-    NUIS_LOG(FIT, "RAW SPLINE DIF = " << rawtotal << " " << spltotal << " "
-                                  << spltotal - rawtotal);
-  }
+  std::vector<std::string> binsamples;
+  std::vector<int> binnumbers;
+  rawfcn->GetMCBinContents(&binsamples, &binnumbers);
+
+  CompareLikelihoods("NDLikelihoodThrow", scanparset_vals, rawtotals, spltotals,
+                     rawbins, splbins, binsamples, binnumbers);
 
   fOutputRootFile->cd();
 
@@ -2568,18 +2912,26 @@ void SplineRoutines::TestSplines_1DLikelihoodScan() {
   rawfcn->CreateIterationTree("raw_iterations", fRW);
   splfcn->CreateIterationTree("spl_iterations", splweight);
 
-  // Loop over parameter sets.
-  for (size_t j = 0; j < scanparset_vals.size(); j++) {
+  rawfcn->SetNParams(nomvals.size());
+  splfcn->SetNParams(nomvals.size());
 
-    FitBase::SetRW(fRW);
-    double rawtotal = rawfcn->DoEval(&scanparset_vals[j][0]);
+  // Scan points are independent, evaluate each FCN over the worker pool.
+  // The MC predictions are kept at every set for the per bin comparison.
+  std::vector<std::vector<double> > rawbins, splbins;
+  FitBase::SetRW(fRW);
+  std::vector<double> rawtotals =
+      rawfcn->DoEvalPoints(scanparset_vals, &rawbins);
 
-    FitBase::SetRW(splweight);
-    double spltotal = splfcn->DoEval(&scanparset_vals[j][0]);
+  FitBase::SetRW(splweight);
+  std::vector<double> spltotals =
+      splfcn->DoEvalPoints(scanparset_vals, &splbins);
 
-    NUIS_LOG(FIT, "RAW SPLINE DIF = " << rawtotal << " " << spltotal << " "
-                                  << spltotal - rawtotal);
-  }
+  std::vector<std::string> binsamples;
+  std::vector<int> binnumbers;
+  rawfcn->GetMCBinContents(&binsamples, &binnumbers);
+
+  CompareLikelihoods("1DLikelihoodScan", scanparset_vals, rawtotals, spltotals,
+                     rawbins, splbins, binsamples, binnumbers);
 
   fOutputRootFile->cd();
 
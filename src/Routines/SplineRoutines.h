@@ -145,6 +145,28 @@ public:
 
 protected:
 
+  /// Compares spline weights to full reweights for every events key at each
+  /// parameter set, spread over spline_cores workers by event range. Writes
+  /// residual summaries per dial group and mode, per set bias and the worst
+  /// events to OUTPUT.splinetest.<testname>.root plus a tolerance report.
+  void CompareEventWeights(std::string const& testname, FitWeight* splweight,
+                           std::vector<std::vector<double> > const& parsets,
+                           std::vector<TH1D*> const& parhists,
+                           std::vector<int> const& setgroups,
+                           std::vector<std::string> const& groupnames);
+
+  /// Saves raw vs spline likelihoods and MC bin contents at each parameter
+  /// set to the output file and checks them against
+  /// spline_test_likelihood_tolerance and spline_test_bin_tolerance.
+  void CompareLikelihoods(std::string const& testname,
+                          std::vector<std::vector<double> > const& parsets,
+                          std::vector<double> const& rawtotals,
+                          std::vector<double> const& spltotals,
+                          std::vector<std::vector<double> > const& rawbins,
+                          std::vector<std::vector<double> > const& splbins,
+                          std::vector<std::string> const& binsamples,
+                          std::vector<int> const& binnumbers);
+
   //! Our Custom ReWeight Object
   FitWeight* rw;
   FitWeight* fRW;
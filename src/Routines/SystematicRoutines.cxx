@@ -354,8 +354,7 @@ void SystematicRoutines::SetFakeData() {
     UpdateRWEngine(fFakeVals);
 
     FitBase::GetRW()->Reconfigure();
-    fSampleFCN->ReconfigureAllEvents();
-    fSampleFCN->SetFakeData("MC");
+    fSampleFCN->SetFakeDataFromMC();
 
     UpdateRWEngine(fCurVals);
 
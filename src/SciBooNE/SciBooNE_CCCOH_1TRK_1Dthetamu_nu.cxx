@@ -40,6 +40,7 @@ SciBooNE_CCCOH_1TRK_1Dthetamu_nu::SciBooNE_CCCOH_1TRK_1Dthetamu_nu(nuiskey sampl
   fSettings.SetHasExtraHistograms(true);
   fSettings.DefineAllowedSpecies("numu");
 
+  fDeferLoading = true;
   SetDataFromTextFile(fSettings.GetDataInput());
   FinaliseSampleSettings();
 
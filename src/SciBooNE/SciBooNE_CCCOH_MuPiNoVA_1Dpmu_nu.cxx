@@ -40,6 +40,7 @@ SciBooNE_CCCOH_MuPiNoVA_1Dpmu_nu::SciBooNE_CCCOH_MuPiNoVA_1Dpmu_nu(nuiskey sampl
   fSettings.SetHasExtraHistograms(true);
   fSettings.DefineAllowedSpecies("numu");
 
+  fDeferLoading = true;
   SetDataFromTextFile(fSettings.GetDataInput());
   FinaliseSampleSettings();
 
@@ -63,6 +63,7 @@ SciBooNE_CCInc_XSec_1DEnu_nu::SciBooNE_CCInc_XSec_1DEnu_nu(nuiskey samplekey) {
       GetEventHistogram()->Integral("width") * double(1E-38) / double(fNEvents);
 
   // Plot Setup -------------------------------------------------------
+  fDeferLoading = true;
   SetDataFromTextFile(fSettings.GetDataInput());
   SetCorrelationFromTextFile(fSettings.GetCovarInput());
   SetShapeCovar();
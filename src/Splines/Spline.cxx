@@ -1,4 +1,5 @@
 #include "Spline.h"
+#include <algorithm>
 using namespace SplineUtils;
 
 // Setup Functions
@@ -37,6 +38,7 @@ Spline::Spline(std::string splname, std::string form, std::string points) {
     fVal.push_back(0.0);
     fValMin.push_back(xmin);
     fValMax.push_back(xmax);
+    fValClamped.push_back(false);
 
     // Define TSpline3 1D iterators here
     if (i == 0) {
@@ -93,11 +95,16 @@ void Spline::Reconfigure(float x, int index) {
   // " << x << " " << index << std::endl;
   fVal[index] = x;
   fOutsideLimits = false;
+  fValClamped[index] = false;
 
-  if (fVal[index] > fValMax[index])
+  if (fVal[index] > fValMax[index]) {
     fVal[index] = fValMax[index];
-  if (fVal[index] < fValMin[index])
+    fValClamped[index] = true;
+  }
+  if (fVal[index] < fValMin[index]) {
     fVal[index] = fValMin[index];
+    fValClamped[index] = true;
+  }
   // std::cout << "Set at edge = " << fVal[index] << " " << index << std::endl;
 }
 
@@ -246,6 +253,63 @@ float Spline::DoEval(const Float_t *par, bool checkresponse) const {
   return 1.0;
 };
 
+float Spline::DoEvalDerivative(const Float_t *par, int index) const {
+
+  if (!par || index < 0 || index >= fNDim || fValClamped[index])
+    return 0.0;
+
+  bool hasresponse = false;
+  for (int i = 0; i < fNPar; i++) {
+    if (par[i] != 0.0) {
+      hasresponse = true;
+      break;
+    }
+  }
+  if (!hasresponse)
+    return 0.0;
+
+  switch (fType) {
+  case k1DPol1:
+  case k1DPol2:
+  case k1DPol3:
+  case k1DPol4:
+  case k1DPol5:
+  case k1DPol6: {
+    float xp = fVal[0];
+    float d = 0.0;
+    for (int i = fNPar - 1; i > 0; i--) {
+      d = d * xp + i * par[i];
+    }
+    return d;
+  }
+  case k1DTSpline3: {
+    // Sets off and fX to the matching knot
+    Spline1DTSpline3(par);
+    float dx = fX - fXScan[off / 4];
+    return par[off + 1] + dx * (2.0 * par[off + 2] + dx * 3.0 * par[off + 3]);
+  }
+  default:
+    break;
+  }
+
+  // No analytic form, take a central difference inside the limits
+  float val = fVal[index];
+  float step = 1E-3 * (fValMax[index] - fValMin[index]);
+  if (step <= 0.0)
+    return 0.0;
+
+  float hi = std::min(val + step, fValMax[index]);
+  float lo = std::max(val - step, fValMin[index]);
+
+  fVal[index] = hi;
+  float whi = DoEval(par, false);
+  fVal[index] = lo;
+  float wlo = DoEval(par, false);
+  fVal[index] = val;
+
+  return (whi - wlo) / (hi - lo);
+}
+
 // Spline Functions
 // ----------------------------------------------
 
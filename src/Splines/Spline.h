@@ -60,6 +60,11 @@ public:
   float DoEval(const Float_t* x, const Float_t* par) const;
   float DoEval(const Float_t* par, bool checkresponse = true) const;
 
+  /// Derivative of the spline response w.r.t. dimension index at the
+  /// current dial values. Analytic for 1D forms, a central difference for
+  /// 2D forms. Zero if the dial is clamped at one of the spline limits.
+  float DoEvalDerivative(const Float_t* par, int index = 0) const;
+
   //  void FitCoeff(int n, double* x, double* y, double* par, bool draw);
   void FitCoeff(std::vector< std::vector<double> > v, std::vector<double> w, float* coeff, bool draw);
 
@@ -101,6 +106,7 @@ public:
   mutable std::vector<float> fVal;
   mutable std::vector<float> fValMin;
   mutable std::vector<float> fValMax;
+  std::vector<bool> fValClamped;  ///< Last Reconfigure was outside limits
 
   mutable std::vector< std::vector<float> > fSplitScan;
 
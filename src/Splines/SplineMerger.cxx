@@ -1,36 +1,57 @@
 #include "SplineMerger.h"
 
+#include "TLeaf.h"
+
 void SplineMerger::AddSplineSetFromFile(TFile* file){
 
   TTree* tr = (TTree*) file->Get("spline_reader");
-  std::vector<std::string>* tempspline = 0;
-  std::vector<std::string>* temptype = 0;
-  std::vector<std::string>* tempform = 0;
-  std::vector<std::string>* temppoints = 0;
-
-
-  // Loop over all splines and add a TString in the TTree for its inputs                                                                                            
-  tr->SetBranchAddress("Spline", &tempspline);
-  tr->SetBranchAddress("Type",   &temptype);
-  tr->SetBranchAddress("Form",   &tempform);
-  tr->SetBranchAddress("Points", &temppoints);
-  tr->GetEntry(0);
-
-  // Copy over                                                                                                                                                                                                                             
-  for (size_t i = 0; i < tempspline->size(); i++){
-    fSpline.push_back(tempspline->at(i));
-    fType.push_back(temptype->at(i));
-    fForm.push_back(tempform->at(i));
-    fPoints.push_back(temppoints->at(i));
+  TTree* coeff = (TTree*) file->Get("spline_tree");
+  if (!tr || !coeff) {
+    NUIS_ABORT("No spline_reader or spline_tree in " << file->GetName());
   }
 
+  // Read checks the stored config hash against the splines
+  SplineReader set;
+  set.Read(tr);
   delete tr;
 
+  // Two sets with the same dial can't be told apart once joined
+  for (size_t i = 0; i < set.fSpline.size(); i++){
+    for (size_t j = 0; j < fSpline.size(); j++){
+      if (set.fSpline[i] == fSpline[j]) {
+        NUIS_ABORT("Spline " << set.fSpline[i] << " in " << file->GetName()
+                   << " is already in another merged spline file.");
+      }
+    }
+  }
+
+  int npar = set.GetNPar();
+  TLeaf* leaf = coeff->GetLeaf("SplineCoeff");
+  if (!leaf || leaf->GetLenStatic() != npar) {
+    NUIS_ABORT("Spline coefficients in " << file->GetName()
+               << " do not match the " << npar
+               << " its spline_reader describes.");
+  }
 
-  // Now Get the coefficients setup.
-  //size_t index = fSplineTreeList.size();
-  fSplineTreeList.push_back( (TTree*) file->Get("spline_tree") );
+  if (fNEntries != -1 && coeff->GetEntries() != fNEntries) {
+    NUIS_ABORT("Spline file " << file->GetName() << " has "
+               << coeff->GetEntries() << " events, earlier files have "
+               << fNEntries);
+  }
+  fNEntries = coeff->GetEntries();
+
+  // Copy over
+  for (size_t i = 0; i < set.fSpline.size(); i++){
+    fSpline.push_back(set.fSpline[i]);
+    fType.push_back(set.fType[i]);
+    fForm.push_back(set.fForm[i]);
+    fPoints.push_back(set.fPoints[i]);
+    fAllSplines.push_back(set.fAllSplines[i]);
+  }
 
+  fSplineFileList.push_back(file->GetName());
+  fSplineSizeList.push_back(npar);
+  fSplineTreeList.push_back(coeff);
 }
 
 void SplineMerger::SetupSplineSet(){
@@ -42,14 +63,12 @@ void SplineMerger::SetupSplineSet(){
   }
 
   // Define Storer
-  fCoEffStorer = new float[fNCoEff];
+  fCoEffStorer.assign(fNCoEff, 0.0);
 
-  // Loop over each TTree and set spline address
+  // Each set reads straight into its slice of the merged entry
   int off = 0;
   for (size_t i = 0; i < fSplineSizeList.size(); i++){
-    float* add = &(fCoEffStorer[off]);
-    TTree* tree = (fSplineTreeList[i]);
-    tree->SetBranchAddress("SplineCoeff", add);
+    fSplineTreeList[i]->SetBranchAddress("SplineCoeff", &fCoEffStorer[off]);
     off += fSplineSizeList[i];
   }
 
@@ -64,14 +83,16 @@ void SplineMerger::GetEntry(int entry){
 
 void SplineMerger::Write(std::string name){
 
-  // Create a TTree with each form and scan points in it.                                                                                                                                                                                  
+  // Create a TTree with each form and scan points in it.
   TTree* tr = new TTree(name.c_str(), name.c_str());
 
-  // Loop over all splines and add a TString in the TTree for its inputs                                                                                                                                                                   
+  // Loop over all splines and add a TString in the TTree for its inputs
   tr->Branch("Spline", &fSpline);
   tr->Branch("Type", &fType);
   tr->Branch("Form", &fForm);
   tr->Branch("Points", &fPoints);
+  std::string hash = GetConfigHash();
+  tr->Branch("ConfigHash", &hash);
   tr->Fill();
   tr->Write();
 
@@ -79,18 +100,54 @@ void SplineMerger::Write(std::string name){
 }
 
 void SplineMerger::AddCoefficientsToTree(TTree* tree){
-  tree->Branch("SplineCoeff", fCoEffStorer, Form("SplineCoeff[%d]/F", fNCoEff));
+  tree->Branch("SplineCoeff", &fCoEffStorer[0], Form("SplineCoeff[%d]/F", fNCoEff));
 }
 
 void SplineMerger::FillMergedSplines(int entry){
   GetEntry(entry);
+}
 
-  size_t count = 0;
-  for (size_t i = 0; i < fSplineSizeList.size(); i++){
-    for (size_t j = 0; j < (UInt_t)fSplineSizeList[i]; j++){
-      fCoEffStorer[count] = fSplineAddressList[i][j];
-      count++;
+int SplineMerger::WriteMergedRange(std::string const& outname, int first,
+                                   int last){
+
+  // Fresh handles, file offsets are shared with the parent after a fork
+  std::vector<TFile*> files;
+  std::vector<float> coeffs(fNCoEff, 0.0);
+  std::vector<TTree*> trees;
+  int off = 0;
+  for (size_t i = 0; i < fSplineFileList.size(); i++){
+    TFile* file = new TFile(fSplineFileList[i].c_str(), "READ");
+    TTree* tree = file ? (TTree*) file->Get("spline_tree") : NULL;
+    if (!tree) {
+      NUIS_ABORT("Failed to reopen spline_tree in " << fSplineFileList[i]);
     }
+    tree->SetBranchAddress("SplineCoeff", &coeffs[off]);
+    off += fSplineSizeList[i];
+    files.push_back(file);
+    trees.push_back(tree);
   }
-}
 
+  TFile* outfile = new TFile(outname.c_str(), "RECREATE");
+  TTree* outtree = new TTree("spline_tree", "spline_tree");
+  outtree->Branch("SplineCoeff", &coeffs[0], Form("SplineCoeff[%d]/F", fNCoEff));
+
+  if (last > fNEntries) last = fNEntries;
+  for (int entry = first; entry < last; entry++){
+    for (size_t i = 0; i < trees.size(); i++){
+      trees[i]->GetEntry(entry);
+    }
+    outtree->Fill();
+  }
+  int nfilled = outtree->GetEntries();
+
+  outfile->cd();
+  outtree->Write();
+  outfile->Close();
+  delete outfile;
+
+  for (size_t i = 0; i < files.size(); i++){
+    files[i]->Close();
+    delete files[i];
+  }
+  return nfilled;
+}
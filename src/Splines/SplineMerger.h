@@ -6,12 +6,18 @@
 
 #include "SplineReader.h"
 
+#include "TFile.h"
+
+/// Joins spline files built for the same events but different dials, so
+/// each merged entry holds the coefficients of every set one after another.
 class SplineMerger : public SplineReader {
  public:
-  SplineMerger(){};
+  SplineMerger() : fNCoEff(0), fNEntries(-1) {};
   ~SplineMerger(){};
 
-  void AddSplineSetFromFile(TFile* file); 
+  /// Add the splines of one file. Every file must hold the same number of
+  /// events and no spline may appear in more than one of them.
+  void AddSplineSetFromFile(TFile* file);
   void SetupSplineSet();
 
   void Write(std::string name);
@@ -20,19 +26,20 @@ class SplineMerger : public SplineReader {
 
   void FillMergedSplines(int entry);
 
-  float* fCoEffStorer;
+  /// Join entries [first, last) into a spline_tree in a new file outname.
+  /// The spline files are opened again here, so this can run in a forked
+  /// worker. Returns the number of entries written.
+  int WriteMergedRange(std::string const& outname, int first, int last);
+
+  inline int GetNEntries() { return fNEntries; };
+
+  std::vector<float> fCoEffStorer;
   int fNCoEff;
+  int fNEntries;
 
-  std::vector< float[1000] > fSplineAddressList;
+  std::vector< std::string > fSplineFileList;
   std::vector< int > fSplineSizeList;
   std::vector< TTree* > fSplineTreeList;
-
-  std::vector< std::vector<double> > fParVect;
-  std::vector< int > fSetIndex;
-  std::vector< double > fWeightList;
-  std::vector< double > fValList;
-
-  
 };
 
 #endif
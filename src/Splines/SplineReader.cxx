@@ -53,6 +53,44 @@ void SplineReader::Read(TTree *tr) {
                                           << " " << fPoints[i]);
     fAllSplines.push_back(Spline(fSpline[i], fForm[i], fPoints[i]));
   }
+
+  std::string hash = ReadConfigHash(tr);
+  if (!hash.empty() && hash != GetConfigHash()) {
+    NUIS_ABORT("Spline header in " << tr->GetName() << " has config hash "
+                                   << hash << " but its splines give "
+                                   << GetConfigHash());
+  }
+}
+
+std::string SplineReader::GetConfigHash() {
+  // 64 bit FNV-1a over every field, with separators so that moving text
+  // between neighbouring fields changes the hash
+  unsigned long long hash = 14695981039346656037ULL;
+  std::vector<std::string> const *fields[4] = {&fSpline, &fType, &fForm,
+                                               &fPoints};
+  for (size_t i = 0; i < fSpline.size(); i++) {
+    for (int f = 0; f < 4; f++) {
+      std::string const &str = (*fields[f])[i];
+      for (size_t c = 0; c <= str.size(); c++) {
+        hash ^= (c < str.size()) ? (unsigned char)str[c] : 0x1f;
+        hash *= 1099511628211ULL;
+      }
+    }
+  }
+  return std::string(Form("%016llx", hash));
+}
+
+std::string SplineReader::ReadConfigHash(TTree *tr) {
+  if (!tr || !tr->GetBranch("ConfigHash"))
+    return "";
+
+  std::string *temphash = 0;
+  tr->SetBranchAddress("ConfigHash", &temphash);
+  tr->GetEntry(0);
+  std::string hash = temphash ? *temphash : "";
+  tr->ResetBranchAddress(tr->GetBranch("ConfigHash"));
+  delete temphash;
+  return hash;
 }
 
 void SplineReader::Reconfigure(std::map<std::string, double> &vals) {
@@ -114,6 +152,51 @@ double SplineReader::CalcWeight(float *coeffs) {
   return rw_weight;
 }
 
+void SplineReader::SetParameterIndices(
+    std::map<std::string, int> const &parindex) {
+
+  fOffsets.clear();
+  fParSplines.clear();
+
+  int off = 0;
+  for (size_t i = 0; i < fAllSplines.size(); i++) {
+    fOffsets.push_back(off);
+    off += fAllSplines[i].GetNPar();
+
+    for (size_t j = 0; j < fAllSplines[i].fSplitNames.size(); j++) {
+      std::map<std::string, int>::const_iterator iter =
+          parindex.find(fAllSplines[i].fSplitNames[j]);
+      if (iter == parindex.end() || iter->second < 0)
+        continue;
+
+      if ((int)fParSplines.size() <= iter->second)
+        fParSplines.resize(iter->second + 1);
+      fParSplines[iter->second].push_back(std::make_pair(int(i), int(j)));
+    }
+  }
+}
+
+double SplineReader::CalcLogDerivative(float *coeffs, int ipar) {
+
+  if (ipar < 0 || ipar >= (int)fParSplines.size())
+    return 0.0;
+
+  double dlogw = 0.0;
+  for (size_t i = 0; i < fParSplines[ipar].size(); i++) {
+    Spline &spl = fAllSplines[fParSplines[ipar][i].first];
+    float *par = &coeffs[fOffsets[fParSplines[ipar][i].first]];
+
+    // CalcWeight resets non-positive weights to nominal, which is flat
+    double w = spl.DoEval(par);
+    if (w <= 0.0)
+      return 0.0;
+
+    dlogw += spl.DoEvalDerivative(par, fParSplines[ipar][i].second) / w;
+  }
+
+  return dlogw;
+}
+
 int SplineReader::GetNPar() {
   int n = 0;
   for (size_t i = 0; i < fAllSplines.size(); i++) {
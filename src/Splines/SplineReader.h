@@ -24,6 +24,23 @@ public:
   int GetNPar();
   double CalcWeight(float* coeffs);
 
+  /// Hash of the spline names, types, forms and knot points, stored with
+  /// the splines so coefficient trees are only ever joined or concatenated
+  /// with ones built from the same configuration.
+  std::string GetConfigHash();
+
+  /// Hash stored in a spline_reader tree, empty for files written before
+  /// hashes were kept.
+  static std::string ReadConfigHash(TTree* tr);
+
+  /// Map spline dimensions onto external parameter indices by dial name.
+  /// Dimensions without an entry in parindex are not differentiated.
+  void SetParameterIndices(std::map<std::string, int> const& parindex);
+
+  /// d(ln weight)/d(par) for external parameter ipar at the current dial
+  /// values. Only the splines driven by ipar are evaluated.
+  double CalcLogDerivative(float* coeffs, int ipar);
+
   std::vector<Spline> fAllSplines;
   std::vector<std::string> fSpline;
   std::vector<std::string> fType;
@@ -35,6 +52,10 @@ public:
 
   bool fNeedsReconfigure;
 
+  std::vector<int> fOffsets;  ///< Coefficient offset of each spline
+  /// (spline, dimension) pairs driven by each external parameter
+  std::vector<std::vector<std::pair<int, int> > > fParSplines;
+
 
 
 };
@@ -15,6 +15,8 @@ void SplineWriter::Write(std::string name) {
   tr->Branch("Type", &fType);
   tr->Branch("Form", &fForm);
   tr->Branch("Points", &fPoints);
+  std::string hash = GetConfigHash();
+  tr->Branch("ConfigHash", &hash);
   tr->Fill();
   tr->Write();
 
@@ -22,6 +22,42 @@
 #include "NuisConfig.h"
 #include "TH1D.h"
 
+#include <algorithm>
+#include <map>
+#include <mutex>
+
+namespace {
+StatUtils::Options gOptions;
+bool gOptionsRead = false;
+} // namespace
+
+//*******************************************************************
+void StatUtils::ReadOptions() {
+  //*******************************************************************
+
+  gOptions.AddMCError = FitPar::Config().GetParB("addmcerror");
+  gOptions.AddMCErrorToCovar = FitPar::Config().GetParB("statutils.addmcerror");
+  gOptions.UseSVDInverse = FitPar::Config().GetParB("UseSVDInverse");
+  gOptions.SaveFluxDebug = FitPar::Config().GetParB("save_flux_debug");
+  gOptionsRead = true;
+
+  if (gOptions.UseSVDInverse) {
+    NUIS_ERR(WRN, "Allowing SVD inverse if matrices are singular, use with "
+                  "extreme caution!");
+  }
+}
+
+//*******************************************************************
+StatUtils::Options const &StatUtils::GetOptions() {
+  //*******************************************************************
+
+  // A function static is initialised exactly once even when first reached
+  // from several threads, unlike a plain flag check
+  static bool const read = gOptionsRead || (ReadOptions(), true);
+  (void)read;
+  return gOptions;
+}
+
 //*******************************************************************
 Double_t StatUtils::GetChi2FromDiag(TH1D *data, TH1D *mc, TH1I *mask) {
   //*******************************************************************
@@ -33,7 +69,7 @@ Double_t StatUtils::GetChi2FromDiag(TH1D *data, TH1D *mc, TH1I *mask) {
   calc_mc->SetDirectory(NULL);
 
   // Add MC Error to data if required
-  if (FitPar::Config().GetParB("addmcerror")) {
+  if (GetOptions().AddMCError) {
     for (int i = 0; i < calc_data->GetNbinsX(); i++) {
       double dterr = calc_data->GetBinError(i + 1);
       double mcerr = calc_mc->GetBinError(i + 1);
@@ -110,12 +146,7 @@ Double_t StatUtils::GetChi2FromCov(TH1D *data, TH1D *mc, TMatrixDSym *invcov,
                                    double covar_scale, TH1D *outchi2perbin) {
   //*******************************************************************
 
-  static bool first = true;
-  static bool UseSVDDecomp = false;
-  if (first) {
-    UseSVDDecomp = FitPar::Config().GetParB("UseSVDInverse");
-    first = false;
-  }
+  bool UseSVDDecomp = GetOptions().UseSVDInverse;
 
   Double_t Chi2 = 0.0;
   TMatrixDSym *calc_cov = (TMatrixDSym *)invcov->Clone("local_invcov");
@@ -143,7 +174,7 @@ Double_t StatUtils::GetChi2FromCov(TH1D *data, TH1D *mc, TMatrixDSym *invcov,
   }
 
   // Add MC Error to data if required
-  if (FitPar::Config().GetParB("statutils.addmcerror")) {
+  if (GetOptions().AddMCErrorToCovar) {
     // Make temp cov
     TMatrixDSym *newcov = StatUtils::GetInvert(calc_cov, true);
 
@@ -291,6 +322,262 @@ Double_t StatUtils::GetChi2FromCov(TH2D *data, TH2D *mc, TMatrixDSym *invcov,
   return Chi2;
 }
 
+namespace {
+// Matrix each serial was handed to, so an ID copied by Clone or left at a
+// reused address is not trusted
+std::mutex gSerialMutex;
+std::map<UInt_t, TMatrixDSym const *> gSerialOwners;
+UInt_t gLastSerial = 0;
+} // namespace
+
+//*******************************************************************
+UInt_t StatUtils::GetMatrixSerial(TMatrixDSym *mat) {
+  //*******************************************************************
+
+  std::lock_guard<std::mutex> lock(gSerialMutex);
+
+  UInt_t serial = mat->GetUniqueID();
+  std::map<UInt_t, TMatrixDSym const *>::iterator owner =
+      gSerialOwners.find(serial);
+  if (serial != 0 && owner != gSerialOwners.end() && owner->second == mat)
+    return serial;
+
+  serial = ++gLastSerial;
+  gSerialOwners[serial] = mat;
+  mat->SetUniqueID(serial);
+  return serial;
+}
+
+//*******************************************************************
+void StatUtils::MarkMatrixChanged(TMatrixDSym *mat) {
+  //*******************************************************************
+
+  std::lock_guard<std::mutex> lock(gSerialMutex);
+  gSerialOwners.erase(mat->GetUniqueID());
+  mat->SetUniqueID(0);
+}
+
+namespace {
+// Whether cache was built from exactly these inputs
+bool IsCovarCacheCurrent(StatUtils::CovarCache const &cache,
+                         TMatrixDSym *invcov, int version,
+                         std::vector<int> const &layout, double covar_scale) {
+  return cache.serial == StatUtils::GetMatrixSerial(invcov) &&
+         cache.version == version &&
+         cache.scale == covar_scale && cache.layout == layout;
+}
+
+// Rebuild cache from invcov, where row i of invcov reads histogram cell
+// rowcells[i] and mask is the flattened bin mask
+void BuildCovarCache(StatUtils::CovarCache &cache, TMatrixDSym *invcov,
+                     int version, std::vector<int> const &rowcells,
+                     TH1I *mask, std::vector<int> const &layout,
+                     double covar_scale) {
+
+  cache.cells.clear();
+  for (size_t i = 0; i < rowcells.size(); i++) {
+    if (mask && mask->GetBinContent(i + 1) > 0.5)
+      continue;
+    cache.cells.push_back(rowcells[i]);
+  }
+
+  TMatrixDSym *calc_cov =
+      mask ? StatUtils::ApplyInvertedMatrixMasking(invcov, mask) : invcov;
+
+  int nbins = cache.cells.size();
+  if (calc_cov->GetNrows() != nbins) {
+    NUIS_ABORT("Masked matrix has " << calc_cov->GetNrows() << " rows but "
+                                    << nbins << " bins are unmasked");
+  }
+
+  double const *elements = calc_cov->GetMatrixArray();
+  cache.invcov.resize(nbins * nbins);
+  for (int i = 0; i < nbins * nbins; i++) {
+    cache.invcov[i] = elements[i] * covar_scale;
+  }
+
+  if (calc_cov != invcov) {
+    delete calc_cov;
+  }
+
+  cache.serial = StatUtils::GetMatrixSerial(invcov);
+  cache.version = version;
+  cache.layout = layout;
+  cache.scale = covar_scale;
+}
+} // namespace
+
+//*******************************************************************
+void StatUtils::UpdateCovarCache(CovarCache &cache, TH1D *data,
+                                 TMatrixDSym *invcov, int version,
+                                 TH1I *mask, double covar_scale) {
+  //*******************************************************************
+
+  int nbins = data->GetNbinsX();
+  if (nbins != invcov->GetNcols()) {
+    NUIS_ERR(WRN, "Inconsistent matrix and data histogram passed to "
+                  "StatUtils::UpdateCovarCache!");
+    NUIS_ABORT("data_hist has " << nbins << " matrix has "
+                                << invcov->GetNcols() << " bins");
+  }
+
+  std::vector<int> layout(1, mask ? 1 : 0);
+  if (mask) {
+    for (int i = 0; i < nbins; i++) {
+      layout.push_back(mask->GetBinContent(i + 1) > 0.5);
+    }
+  }
+
+  if (IsCovarCacheCurrent(cache, invcov, version, layout, covar_scale))
+    return;
+
+  std::vector<int> rowcells(nbins);
+  for (int i = 0; i < nbins; i++) {
+    rowcells[i] = i + 1;
+  }
+
+  BuildCovarCache(cache, invcov, version, rowcells, mask, layout,
+                  covar_scale);
+}
+
+//*******************************************************************
+void StatUtils::UpdateCovarCache(CovarCache &cache, TH2D *data,
+                                 TMatrixDSym *invcov, int version, TH2I *map,
+                                 TH2I *mask, double covar_scale) {
+  //*******************************************************************
+
+  // Generate a simple map
+  bool made_map = false;
+  if (!map) {
+    map = StatUtils::GenerateMap(data);
+    made_map = true;
+  }
+
+  // Same flattening as MapToTH1D and MapToMask
+  int nrows = invcov->GetNrows();
+  int nmapped = 0;
+  std::vector<int> rowcells(nrows, -1);
+  std::vector<int> rowmask(nrows, 0);
+  for (int i = 0; i < map->GetNbinsX(); i++) {
+    for (int j = 0; j < map->GetNbinsY(); j++) {
+      int gb = map->GetBinContent(i + 1, j + 1);
+      if (gb <= 0)
+        continue;
+      nmapped++;
+      if (gb > nrows)
+        continue;
+      rowcells[gb - 1] = data->GetBin(i + 1, j + 1);
+      if (mask)
+        rowmask[gb - 1] = mask->GetBinContent(i + 1, j + 1);
+    }
+  }
+
+  if (nmapped != invcov->GetNcols()) {
+    NUIS_ERR(WRN, "Inconsistent matrix and data histogram passed to "
+                  "StatUtils::UpdateCovarCache!");
+    NUIS_ABORT("mapped data_hist has " << nmapped << " matrix has "
+                                       << invcov->GetNcols() << " bins");
+  }
+
+  std::vector<int> layout(1, mask ? 1 : 0);
+  layout.insert(layout.end(), rowcells.begin(), rowcells.end());
+  layout.insert(layout.end(), rowmask.begin(), rowmask.end());
+
+  if (!IsCovarCacheCurrent(cache, invcov, version, layout, covar_scale)) {
+    TH1I *mask_1D = MapToMask(mask, map);
+    BuildCovarCache(cache, invcov, version, rowcells, mask_1D, layout,
+                    covar_scale);
+    delete mask_1D;
+  }
+
+  if (made_map) {
+    delete map;
+  }
+}
+
+//*******************************************************************
+Double_t StatUtils::GetChi2FromCov(CovarCache const &cache, TH1 *data,
+                                   TH1 *mc, double mcscale,
+                                   TH1 *outchi2perbin, TH1 *outchi2lessbin) {
+  //*******************************************************************
+
+  bool UseSVDDecomp = GetOptions().UseSVDInverse;
+  int nbins = cache.cells.size();
+
+  // As in GetChi2FromCov, rows with zero data or MC do not contribute
+  std::vector<double> res(nbins, 0.0);
+  std::vector<double> rowres(nbins, 0.0);
+  std::vector<bool> active(nbins, false);
+  for (int i = 0; i < nbins; i++) {
+    if (cache.cells[i] < 0)
+      continue;
+    double datav = data->GetBinContent(cache.cells[i]);
+    double mcv = mc->GetBinContent(cache.cells[i]) * mcscale;
+    res[i] = datav - mcv;
+    active[i] = (datav != 0 && mcv != 0);
+    if (active[i])
+      rowres[i] = res[i];
+  }
+
+  Double_t Chi2 = 0.0;
+  std::vector<double> rowchi2(nbins, 0.0);
+  for (int i = 0; i < nbins; i++) {
+    if (!active[i])
+      continue;
+
+    double const *row = &cache.invcov[i * nbins];
+    if (!UseSVDDecomp && row[i] < 0) {
+      NUIS_ABORT("Found negative diagonal covariance element: Covar("
+                 << i << ", " << i << ") = " << row[i] << ", data = "
+                 << data->GetBinContent(cache.cells[i])
+                 << ", mc = " << mc->GetBinContent(cache.cells[i]) * mcscale);
+    }
+
+    double proj = 0.0;
+    for (int j = 0; j < nbins; j++) {
+      proj += row[j] * res[j];
+    }
+    rowchi2[i] = res[i] * proj;
+    Chi2 += rowchi2[i];
+  }
+
+  if (outchi2perbin) {
+    outchi2perbin->Reset();
+    for (int i = 0; i < nbins; i++) {
+      if (cache.cells[i] >= 0)
+        outchi2perbin->SetBinContent(cache.cells[i], rowchi2[i]);
+    }
+  }
+
+  // Masking bin k as well is a Schur complement on the inverse covariance,
+  // which takes q_k * qt_k / P_kk off the chi2, where q = P r and qt is the
+  // same with the skipped rows of r zeroed.
+  if (outchi2lessbin) {
+    for (int k = 0; k < outchi2lessbin->GetNcells(); k++) {
+      if (!outchi2lessbin->IsBinUnderflow(k) &&
+          !outchi2lessbin->IsBinOverflow(k))
+        outchi2lessbin->SetBinContent(k, Chi2);
+    }
+
+    for (int k = 0; k < nbins; k++) {
+      double const *row = &cache.invcov[k * nbins];
+      if (cache.cells[k] < 0 || row[k] == 0.0)
+        continue;
+
+      double proj = 0.0;
+      double rowproj = 0.0;
+      for (int j = 0; j < nbins; j++) {
+        proj += row[j] * res[j];
+        rowproj += row[j] * rowres[j];
+      }
+      outchi2lessbin->SetBinContent(cache.cells[k],
+                                    Chi2 - proj * rowproj / row[k]);
+    }
+  }
+
+  return Chi2;
+}
+
 //*******************************************************************
 Double_t StatUtils::GetChi2FromSVD(TH1D *data, TH1D *mc, TMatrixDSym *cov,
                                    TH1I *mask) {
@@ -675,57 +962,79 @@ Int_t StatUtils::GetNDOF(TH2D *hist, TH2I *map, TH2I *mask) {
   return NDOF;
 };
 
-//*******************************************************************
-TH1D *StatUtils::ThrowHistogram(TH1D *hist, TMatrixDSym *cov, bool throwdiag,
-                                TH1I *mask) {
-  //*******************************************************************
-
-  TH1D *calc_hist =
-      (TH1D *)hist->Clone((std::string(hist->GetName()) + "_THROW").c_str());
-  TMatrixDSym *calc_cov = (TMatrixDSym *)cov->Clone();
-  Double_t correl_val = 0.0;
-
-  // If a mask if applied we need to apply it before the matrix is decomposed
-  if (mask) {
-    calc_cov = ApplyMatrixMasking(cov, mask);
-    calc_hist = ApplyHistogramMasking(calc_hist, mask);
+namespace {
+// Index of each bin in the unmasked throw space, -1 for masked bins
+std::vector<int> GetThrowIndices(int nbins, TH1I *mask, int ndecomp) {
+  std::vector<int> indices(nbins, -1);
+  int index = 0;
+  for (int i = 0; i < nbins; i++) {
+    if (mask && mask->GetBinContent(i + 1) > 0.5)
+      continue;
+    indices[i] = index++;
   }
 
-  // If a covariance is provided we need a preset random vector and a decomp
-  std::vector<Double_t> rand_val;
-  TMatrixDSym *decomp_cov = NULL;
+  if (index != ndecomp) {
+    NUIS_ABORT("Decomposition has " << ndecomp << " rows but there are "
+                                    << index << " unmasked bins to throw");
+  }
+  return indices;
+}
 
-  if (cov) {
-    for (int i = 0; i < hist->GetNbinsX(); i++) {
-      rand_val.push_back(gRandom->Gaus(0.0, 1.0));
+// Number of bins with a valid entry in a 2D map
+int GetNMappedBins(TH2I *map) {
+  int nbins = 0;
+  for (int i = 0; i < map->GetNbinsX(); i++) {
+    for (int j = 0; j < map->GetNbinsY(); j++) {
+      if (map->GetBinContent(i + 1, j + 1) > 0)
+        nbins++;
     }
+  }
+  return nbins;
+}
 
-    // Decomp the matrix
-    decomp_cov = StatUtils::GetDecomp(calc_cov);
+// Add row itoy of a ThrowCorrelatedToys matrix to hist
+void AddThrow(TH1D *hist, TMatrixD const &toys, int itoy,
+              std::vector<int> const &indices) {
+  for (size_t i = 0; i < indices.size(); i++) {
+    if (indices[i] < 0)
+      continue;
+    hist->SetBinContent(i + 1, hist->GetBinContent(i + 1) +
+                                   toys(itoy, indices[i]) * 1E-38);
   }
+}
 
-  // iterate over bins
-  for (int i = 0; i < hist->GetNbinsX(); i++) {
-    // By Default the errors on the histogram are thrown uncorrelated to the
-    // other errors
-    /*
-    if (throwdiag) {
-      calc_hist->SetBinContent(i + 1, (calc_hist->GetBinContent(i + 1) + \
-           gRandom->Gaus(0.0, 1.0) * calc_hist->GetBinError(i + 1)) );
+void AddThrow(TH2D *hist, TMatrixD const &toys, int itoy,
+              std::vector<int> const &indices, TH2I *map) {
+  for (int i = 0; i < map->GetNbinsX(); i++) {
+    for (int j = 0; j < map->GetNbinsY(); j++) {
+      int gb = map->GetBinContent(i + 1, j + 1);
+      if (gb <= 0 || indices[gb - 1] < 0)
+        continue;
+      hist->SetBinContent(i + 1, j + 1,
+                          hist->GetBinContent(i + 1, j + 1) +
+                              toys(itoy, indices[gb - 1]) * 1E-38);
     }
-    */
+  }
+}
+} // namespace
 
-    // If a covariance is provided that is also thrown
-    if (cov) {
-      correl_val = 0.0;
+//*******************************************************************
+TH1D *StatUtils::ThrowHistogram(TH1D *hist, TMatrixDSym *cov, bool throwdiag,
+                                TH1I *mask) {
+  //*******************************************************************
 
-      for (int j = 0; j < hist->GetNbinsX(); j++) {
-        correl_val += rand_val[j] * (*decomp_cov)(j, i);
-      }
-      calc_hist->SetBinContent(
-          i + 1, (calc_hist->GetBinContent(i + 1) + correl_val * 1E-38));
-    }
-  }
+  // Statistical errors are expected to be included in cov, so throwdiag is
+  // currently unused.
+  (void)throwdiag;
+
+  if (!cov)
+    return (TH1D *)hist->Clone((std::string(hist->GetName()) + "_THROW").c_str());
+
+  // If a mask if applied we need to apply it before the matrix is decomposed
+  TMatrixDSym *calc_cov = ApplyMatrixMasking(cov, mask);
+  TMatrixDSym *decomp_cov = StatUtils::GetDecomp(calc_cov);
+
+  TH1D *calc_hist = ThrowHistogramFromDecomp(hist, decomp_cov, mask);
 
   delete calc_cov;
   delete decomp_cov;
@@ -739,20 +1048,130 @@ TH2D *StatUtils::ThrowHistogram(TH2D *hist, TMatrixDSym *cov, TH2I *map,
                                 bool throwdiag, TH2I *mask) {
   //*******************************************************************
 
-  // PLACEHOLDER!!!!!!!!!
-  // Currently no support for throwing 2D Histograms from a covariance
-  (void)hist;
-  (void)cov;
-  (void)map;
   (void)throwdiag;
-  (void)mask;
 
-  // /todo
-  // Sort maps if required
-  // Throw the covariance for a 1D plot
-  // Unmap back to 2D Histogram
+  if (!cov)
+    return (TH2D *)hist->Clone((std::string(hist->GetName()) + "_THROW").c_str());
+
+  bool made_map = false;
+  if (!map) {
+    made_map = true;
+    map = StatUtils::GenerateMap(hist);
+  }
+
+  TMatrixDSym *calc_cov = ApplyMatrixMasking(cov, hist, mask, map);
+  TMatrixDSym *decomp_cov = StatUtils::GetDecomp(calc_cov);
 
-  return hist;
+  TH2D *calc_hist = ThrowHistogramFromDecomp(hist, decomp_cov, map, mask);
+
+  delete calc_cov;
+  delete decomp_cov;
+  if (made_map)
+    delete map;
+
+  return calc_hist;
+}
+
+//*******************************************************************
+TMatrixD StatUtils::ThrowCorrelatedToys(TMatrixDSym const &decomp, int ntoys) {
+  //*******************************************************************
+
+  int nrows = decomp.GetNrows();
+
+  TMatrixD rand_val(ntoys, nrows);
+  for (int k = 0; k < ntoys; k++) {
+    for (int j = 0; j < nrows; j++) {
+      rand_val(k, j) = gRandom->Gaus(0.0, 1.0);
+    }
+  }
+
+  // GetDecomp stores the triangular factor in a TMatrixDSym, so take the raw
+  // elements rather than relying on the symmetric storage.
+  TMatrixD upper(nrows, nrows, decomp.GetMatrixArray());
+
+  return TMatrixD(rand_val, TMatrixD::kMult, upper);
+}
+
+//*******************************************************************
+TH1D *StatUtils::ThrowHistogramFromDecomp(TH1D *hist, TMatrixDSym *decomp,
+                                          TH1I *mask) {
+  //*******************************************************************
+
+  std::vector<int> indices =
+      GetThrowIndices(hist->GetNbinsX(), mask, decomp->GetNrows());
+
+  TH1D *calc_hist =
+      (TH1D *)hist->Clone((std::string(hist->GetName()) + "_THROW").c_str());
+  AddThrow(calc_hist, ThrowCorrelatedToys(*decomp, 1), 0, indices);
+
+  return calc_hist;
+}
+
+//*******************************************************************
+TH2D *StatUtils::ThrowHistogramFromDecomp(TH2D *hist, TMatrixDSym *decomp,
+                                          TH2I *map, TH2I *mask) {
+  //*******************************************************************
+
+  std::vector<TH2D *> throws =
+      ThrowHistogramsFromDecomp(hist, decomp, 1, map, mask);
+  throws[0]->SetName((std::string(hist->GetName()) + "_THROW").c_str());
+  return throws[0];
+}
+
+//*******************************************************************
+std::vector<TH1D *> StatUtils::ThrowHistogramsFromDecomp(TH1D *hist,
+                                                         TMatrixDSym *decomp,
+                                                         int ntoys,
+                                                         TH1I *mask) {
+  //*******************************************************************
+
+  std::vector<int> indices =
+      GetThrowIndices(hist->GetNbinsX(), mask, decomp->GetNrows());
+  TMatrixD toys = ThrowCorrelatedToys(*decomp, ntoys);
+
+  std::vector<TH1D *> throws;
+  for (int k = 0; k < ntoys; k++) {
+    TH1D *calc_hist = (TH1D *)hist->Clone(
+        Form("%s_THROW%i", hist->GetName(), k));
+    AddThrow(calc_hist, toys, k, indices);
+    throws.push_back(calc_hist);
+  }
+
+  return throws;
+}
+
+//*******************************************************************
+std::vector<TH2D *> StatUtils::ThrowHistogramsFromDecomp(TH2D *hist,
+                                                         TMatrixDSym *decomp,
+                                                         int ntoys, TH2I *map,
+                                                         TH2I *mask) {
+  //*******************************************************************
+
+  bool made_map = false;
+  if (!map) {
+    made_map = true;
+    map = StatUtils::GenerateMap(hist);
+  }
+
+  TH1I *mask_1D = StatUtils::MapToMask(mask, map);
+  std::vector<int> indices =
+      GetThrowIndices(GetNMappedBins(map), mask_1D, decomp->GetNrows());
+  TMatrixD toys = ThrowCorrelatedToys(*decomp, ntoys);
+
+  std::vector<TH2D *> throws;
+  for (int k = 0; k < ntoys; k++) {
+    TH2D *calc_hist = (TH2D *)hist->Clone(
+        Form("%s_THROW%i", hist->GetName(), k));
+    AddThrow(calc_hist, toys, k, indices, map);
+    throws.push_back(calc_hist);
+  }
+
+  if (mask_1D)
+    delete mask_1D;
+  if (made_map)
+    delete map;
+
+  return throws;
 }
 
 //*******************************************************************
@@ -970,15 +1389,7 @@ TMatrixDSym *StatUtils::GetInvert(TMatrixDSym *mat, bool rescale) {
     return new_mat;
   }
 
-  static bool first = true;
-  static bool UseSVDDecomp = false;
-  if (first) {
-    UseSVDDecomp = FitPar::Config().GetParB("UseSVDInverse");
-    first = false;
-    if (UseSVDDecomp){
-      NUIS_ERR(WRN, "Allowing SVD inverse if matrices are singular, use with extreme caution!");
-    }
-  }
+  bool UseSVDDecomp = GetOptions().UseSVDInverse;
 
   // Check if this matrix is singular/positive-definite
   bool isWellBehaved = StatUtils::IsMatrixWellBehaved(new_mat);
@@ -1102,6 +1513,49 @@ TMatrixDSym *StatUtils::GetDecomp(TMatrixDSym *mat) {
   return dec_mat;
 }
 
+//*******************************************************************
+TMatrixDSym *StatUtils::GetThrowDecomp(ThrowCache &cache, TMatrixDSym *cov,
+                                       int version, TH1I *mask) {
+  //*******************************************************************
+
+  int nbins = cov->GetNrows();
+  std::vector<bool> masked(nbins, false);
+  for (int i = 0; mask && i < nbins; i++) {
+    masked[i] = (mask->GetBinContent(i + 1) > 0.5);
+  }
+
+  // Reuse the last decomposition unless the covariance or mask changed
+  if (cache.decomp && cache.serial == GetMatrixSerial(cov) &&
+      cache.version == version &&
+      cache.mask == masked) {
+    return cache.decomp;
+  }
+
+  ClearThrowCache(cache);
+
+  TMatrixDSym *calc_cov = StatUtils::ApplyMatrixMasking(cov, mask);
+  cache.decomp = StatUtils::GetDecomp(calc_cov);
+  delete calc_cov;
+
+  cache.serial = GetMatrixSerial(cov);
+  cache.version = version;
+  cache.mask = masked;
+
+  return cache.decomp;
+}
+
+//*******************************************************************
+void StatUtils::ClearThrowCache(ThrowCache &cache) {
+  //*******************************************************************
+
+  if (cache.decomp)
+    delete cache.decomp;
+  cache.decomp = NULL;
+  cache.serial = 0;
+  cache.version = -1;
+  cache.mask.clear();
+}
+
 //*******************************************************************
 void StatUtils::ForceNormIntoCovar(TMatrixDSym *&mat, TH1D *hist, double norm) {
   //*******************************************************************
@@ -1609,7 +2063,7 @@ TMatrixD *StatUtils::GetMatrixFromRootFile(std::string covfile,
   }
 
   // Get file
-  TFile *tempfile = new TFile(splitfile[0].c_str(), "READ");
+  TFile *tempfile = GeneralUtils::GetCachedFile(splitfile[0]);
 
   // Get Object
   StopTalking();
@@ -1625,7 +2079,6 @@ TMatrixD *StatUtils::GetMatrixFromRootFile(std::string covfile,
     TMatrixD *newmat = (TMatrixD *)mat->Clone();
 
     delete mat;
-    tempfile->Close();
 
     return newmat;
   }
@@ -1640,7 +2093,6 @@ TMatrixD *StatUtils::GetMatrixFromRootFile(std::string covfile,
     }
 
     delete matsym;
-    tempfile->Close();
 
     return newmat;
   }
@@ -1655,7 +2107,6 @@ TMatrixD *StatUtils::GetMatrixFromRootFile(std::string covfile,
     }
 
     delete mathist;
-    tempfile->Close();
 
     return newmat;
   }
@@ -30,6 +30,7 @@
 #include <sstream>
 #include <stdlib.h>
 #include <string>
+#include <vector>
 
 // Root Includes
 #include "TDecompChol.h"
@@ -40,6 +41,7 @@
 #include "TH2D.h"
 #include "TH2I.h"
 #include "TMath.h"
+#include "TMatrixD.h"
 #include "TMatrixDSym.h"
 #include "TRandom3.h"
 
@@ -55,6 +57,27 @@
 //! Functions for handling statistics calculations
 namespace StatUtils {
 
+/*
+  Options
+*/
+
+//! Config options used by the chi2 and scaling functions. They are read
+//! once so that samples can be evaluated concurrently without touching the
+//! config.
+struct Options {
+  bool AddMCError;        //!< "addmcerror" : add MC errors in diagonal chi2
+  bool AddMCErrorToCovar; //!< "statutils.addmcerror" : add MC errors to covar
+  bool UseSVDInverse;     //!< "UseSVDInverse" : allow SVD for singular matrices
+  bool SaveFluxDebug;     //!< "save_flux_debug" : write FluxUnfoldedScaling inputs
+};
+
+//! Re-read the options from the global config. Call before starting any
+//! threads that evaluate samples.
+void ReadOptions();
+
+//! Current options, read from the config once if ReadOptions was not called
+Options const &GetOptions();
+
 /*
   Chi2 Functions
 */
@@ -79,6 +102,69 @@ Double_t GetChi2FromCov(TH2D *data, TH2D *mc, TMatrixDSym *invcov,
                         TH2I *map = NULL, TH2I *mask = NULL,
                         TH2D *outchi2perbin = NULL);
 
+//! Serial number of mat, assigned on first use and kept in its TObject
+//! unique ID. A matrix allocated at a freed one's address, or a clone still
+//! carrying its source's ID, gets a fresh serial, so caches keyed on the
+//! serial never mistake one matrix for another.
+UInt_t GetMatrixSerial(TMatrixDSym *mat);
+
+//! Give mat a fresh serial after it was modified in place, so caches built
+//! from its old contents are rebuilt
+void MarkMatrixChanged(TMatrixDSym *mat);
+
+//! Inverse covariance prepared for repeated chi2 evaluations: masked,
+//! multiplied by covar_scale and with each row tied to a histogram cell.
+//! UpdateCovarCache only rebuilds it when its inputs change. The matrix is
+//! identified by GetMatrixSerial; in place changes must either go through
+//! MarkMatrixChanged or bump the owner's covariance version.
+struct CovarCache {
+  CovarCache() : serial(0), version(-1), scale(0) {}
+  std::vector<int> cells;     //!< Histogram cell of each row, -1 if none
+  std::vector<double> invcov; //!< Row-major, cells.size() squared
+  UInt_t serial;              //!< Serial of the matrix the cache was built from
+  int version;                //!< Covariance version the cache was built at
+  std::vector<int> layout;    //!< Mask and map the cache was built from
+  double scale;               //!< covar_scale the cache was built with
+};
+
+//! Bring cache up to date for a 1D data histogram, matrix and mask. The
+//! masked inverse is the same one GetChi2FromCov would build per call.
+void UpdateCovarCache(CovarCache &cache, TH1D *data, TMatrixDSym *invcov,
+                      int version, TH1I *mask = NULL,
+                      double covar_scale = 1E76);
+
+//! Bring cache up to date for a 2D data histogram flattened through map
+void UpdateCovarCache(CovarCache &cache, TH2D *data, TMatrixDSym *invcov,
+                      int version, TH2I *map = NULL, TH2I *mask = NULL,
+                      double covar_scale = 1E76);
+
+//! Decomposition of a masked covariance used to throw toys. Like
+//! CovarCache it is keyed on the matrix serial, its version and the mask.
+struct ThrowCache {
+  ThrowCache() : decomp(NULL), serial(0), version(-1) {}
+  TMatrixDSym *decomp;    //!< Decomposition of the masked covariance
+  UInt_t serial;          //!< Serial of the covariance it was built from
+  int version;            //!< Covariance version the cache was built at
+  std::vector<bool> mask; //!< Bin mask the cache was built with
+};
+
+//! Get the decomposition of cov with the bins in mask removed, rebuilding
+//! cache only when cov, version or the mask changed. Owned by the cache.
+TMatrixDSym *GetThrowDecomp(ThrowCache &cache, TMatrixDSym *cov,
+                            int version, TH1I *mask = NULL);
+
+//! Free the decomposition held by cache
+void ClearThrowCache(ThrowCache &cache);
+
+//! Get Chi2 of data against mcscale * mc from a cached inverse covariance,
+//! without copying histograms or matrices. Gives the same result as
+//! GetChi2FromCov on an mc histogram scaled by mcscale. If given,
+//! outchi2perbin is filled with each bin's row of the quadratic form and
+//! outchi2lessbin with the chi2 after also masking that bin.
+Double_t GetChi2FromCov(CovarCache const &cache, TH1 *data, TH1 *mc,
+                        double mcscale = 1.0, TH1 *outchi2perbin = NULL,
+                        TH1 *outchi2lessbin = NULL);
+
 //! Get Chi2 using an SVD method on the covariance before calculation.
 //! Method suggested by Rex at MiniBooNE. Shown that it doesn't actually work.
 Double_t GetChi2FromSVD(TH1D *data, TH1D *mc, TMatrixDSym *cov,
@@ -148,11 +234,36 @@ TH1D *ThrowHistogram(TH1D *hist, TMatrixDSym *cov, bool throwdiag = true,
                      TH1I *mask = NULL);
 
 //! Given a full covariance for a 2D data set throw the decomposition to
-//! generate fake data. Plots are converted to 1D histograms and the 1D
-//! ThrowHistogram is used, before being converted back to 2D histograms.
+//! generate fake data. The covariance is ordered through map (generated from
+//! hist if NULL), masked bins are removed before the decomposition.
 TH2D *ThrowHistogram(TH2D *hist, TMatrixDSym *cov, TH2I *map = NULL,
                      bool throwdiag = true, TH2I *mask = NULL);
 
+//! Draw ntoys correlated offsets from a decomposition U (cov = U^T U, as
+//! returned by GetDecomp) with one dense product Z U. Row k holds toy k.
+TMatrixD ThrowCorrelatedToys(TMatrixDSym const &decomp, int ntoys);
+
+//! Throw hist from a precomputed decomposition of its covariance. If a mask
+//! is given the decomposition must only span the unmasked bins, and masked
+//! bins are left at their nominal value.
+TH1D *ThrowHistogramFromDecomp(TH1D *hist, TMatrixDSym *decomp,
+                               TH1I *mask = NULL);
+
+//! 2D version of ThrowHistogramFromDecomp. Bins are ordered through map
+//! (generated from hist if NULL), and unmapped bins are left unchanged.
+TH2D *ThrowHistogramFromDecomp(TH2D *hist, TMatrixDSym *decomp,
+                               TH2I *map = NULL, TH2I *mask = NULL);
+
+//! Throw ntoys histograms from a precomputed decomposition in one batch.
+//! Caller owns the returned histograms.
+std::vector<TH1D *> ThrowHistogramsFromDecomp(TH1D *hist, TMatrixDSym *decomp,
+                                              int ntoys, TH1I *mask = NULL);
+
+//! 2D version of ThrowHistogramsFromDecomp
+std::vector<TH2D *> ThrowHistogramsFromDecomp(TH2D *hist, TMatrixDSym *decomp,
+                                              int ntoys, TH2I *map = NULL,
+                                              TH2I *mask = NULL);
+
 /*
   Masking Functions
 */
@@ -70,6 +70,7 @@ T2K_CC0pinp_STV_XSec_1Ddat_nu::T2K_CC0pinp_STV_XSec_1Ddat_nu(
   // ScaleData(1E-38);
   // SetCovarFromDiagonal();
 
+  fDeferLoading = true;
   SetDataFromRootFile(fSettings.GetDataInput());
   SetCorrelationFromRootFile(fSettings.GetCovarInput());
 
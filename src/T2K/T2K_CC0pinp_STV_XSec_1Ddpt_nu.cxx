@@ -70,6 +70,7 @@ T2K_CC0pinp_STV_XSec_1Ddpt_nu::T2K_CC0pinp_STV_XSec_1Ddpt_nu(
   // SetCovarFromDiagonal();
   // ScaleData(1E-38);
 
+  fDeferLoading = true;
   SetDataFromRootFile(fSettings.GetDataInput());
   SetCorrelationFromRootFile(fSettings.GetCovarInput());
   // SetCovarianceFromRootFile(fSettings.GetCovarInput() );
@@ -0,0 +1,43 @@
+// Copyright 2016-2021 L. Pickering, P Stowell, R. Terri, C. Wilkinson, C. Wret
+
+/*******************************************************************************
+*    This file is part of NUISANCE.
+*
+*    NUISANCE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    NUISANCE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with NUISANCE.  If not, see <http://www.gnu.org/licenses/>.
+*******************************************************************************/
+
+#include "T2K_CC0pinp_ifk_3DinfBinning.h"
+
+#include <limits>
+
+SliceBinning
+T2K_CC0pinp_ifk::Get3DinfSliceBinning(std::vector<TH1D *> const &slices) {
+
+  // Each row is {pmu low, pmu high, cos low, cos high}
+  const double inf = std::numeric_limits<double>::infinity();
+  const double cuts[7][4] = {{-inf, inf, -inf, -0.6}, {-inf, 0.25, -0.6, 0.0},
+                             {0.25, inf, -0.6, 0.0},  {-inf, 0.25, 0.0, inf},
+                             {0.25, inf, 0.0, 0.8},   {0.25, 0.75, 0.8, 1.0},
+                             {0.75, inf, 0.8, 1.0}};
+
+  SliceBinning binning(3, true);
+  for (int i = 0; i < 7; i++) {
+    double lows[3] = {-inf, cuts[i][0], cuts[i][2]};
+    double highs[3] = {inf, cuts[i][1], cuts[i][3]};
+    binning.AddSlice(lows, highs, 0, slices[i]);
+  }
+  binning.Finalise();
+
+  return binning;
+}
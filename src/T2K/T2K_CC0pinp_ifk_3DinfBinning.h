@@ -0,0 +1,38 @@
+// Copyright 2016-2021 L. Pickering, P Stowell, R. Terri, C. Wilkinson, C. Wret
+
+/*******************************************************************************
+*    This file is part of NUISANCE.
+*
+*    NUISANCE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    NUISANCE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with NUISANCE.  If not, see <http://www.gnu.org/licenses/>.
+*******************************************************************************/
+#ifndef T2K_CC0PINP_IFK_3DINFBINNING_H_SEEN
+#define T2K_CC0PINP_IFK_3DINFBINNING_H_SEEN
+
+#include "SliceBinning.h"
+
+#include "TH1D.h"
+
+#include <vector>
+
+namespace T2K_CC0pinp_ifk {
+
+/// Slice binning shared by the T2K_CC0pinp_ifk_XSec_3Dinf{a,ip,p} samples.
+/// Slices are in (x, pmu, CosThetaMu) and binned in x, in release bin order
+/// after the out of range bin. slices holds the seven release slice
+/// histograms that give the x edges.
+SliceBinning Get3DinfSliceBinning(std::vector<TH1D *> const &slices);
+
+} // namespace T2K_CC0pinp_ifk
+
+#endif
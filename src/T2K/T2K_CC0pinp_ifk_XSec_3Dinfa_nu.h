@@ -20,6 +20,7 @@
 #define T2K_CC0PINP_IFK_XSEC_3DINFA_NU_H_SEEN
 
 #include "Measurement1D.h"
+#include "T2K_CC0pinp_ifk_3DinfBinning.h"
 
 class T2K_CC0pinp_ifk_XSec_3Dinfa_nu : public Measurement1D {
 public:
@@ -57,8 +58,6 @@ public:
   double pmu, CosThetaMu;
   int fAnalysis;
 
-  double outOfBoundsMC;
-  
   bool fIsSystCov, fIsStatCov, fIsNormCov;
 
   TFile* fInputFile;
@@ -66,7 +65,7 @@ public:
   std::vector<TH1D*> fMCHist_Slices;
   std::vector<TH1D*> fDataHist_Slices;
 
-  void FillMCSlice(double x, double y, double z, double w);
+  SliceBinning fSliceBinning;
   
 };
   
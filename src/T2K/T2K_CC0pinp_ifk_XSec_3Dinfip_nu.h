@@ -20,6 +20,7 @@
 #define T2K_CC0PINP_IFK_XSEC_3DINFIP_NU_H_SEEN
 
 #include "Measurement1D.h"
+#include "T2K_CC0pinp_ifk_3DinfBinning.h"
 
 class T2K_CC0pinp_ifk_XSec_3Dinfip_nu : public Measurement1D {
 public:
@@ -57,7 +58,6 @@ public:
   double pmu, CosThetaMu;
   int fAnalysis;
 
-  double outOfBoundsMC;
 
   bool fIsSystCov, fIsStatCov, fIsNormCov;
 
@@ -66,7 +66,7 @@ public:
   std::vector<TH1D*> fMCHist_Slices;
   std::vector<TH1D*> fDataHist_Slices;
 
-  void FillMCSlice(double x, double y, double z, double w);
+  SliceBinning fSliceBinning;
   
 };
   
@@ -48,8 +48,6 @@ T2K_CC0pinp_ifk_XSec_3Dinfp_nu::T2K_CC0pinp_ifk_XSec_3Dinfp_nu(nuiskey samplekey
 
   fAnalysis = 1;
 
-  outOfBoundsMC = 0.0;
-
   // CCQELike plot information
   fSettings.SetTitle("T2K_CC0pinp_ifk_XSec_3Dinfp_nu");
   fSettings.DefineAllowedSpecies("numu");
@@ -72,6 +70,9 @@ T2K_CC0pinp_ifk_XSec_3Dinfp_nu::T2K_CC0pinp_ifk_XSec_3Dinfp_nu(nuiskey samplekey
   // Final setup  ---------------------------------------------------
   FinaliseMeasurement();
 
+  // Bin widths are applied per event in FillHistograms
+  fIsNoWidth = true;
+
   fSaveFine = false;
 };
 
@@ -93,72 +94,49 @@ void T2K_CC0pinp_ifk_XSec_3Dinfp_nu::FillEventVariables(FitEvent* event){
   double CosThetaMu = cos(Pnu.Vect().Angle(Pmu.Vect()));
   double delta_p = Pp.Vect().Mag()/1000. - FitUtils::ppInfK(Pmu, CosThetaMu, 25, true);
 
-  fXVar = delta_p;
+  // X is the centre of the flat bin so it survives the cached signal box
+  double vars[3] = {delta_p, pmu, CosThetaMu};
+  int bin = fSliceBinning.FindBin(vars);
+  if (bin != SliceBinning::kNoBin)
+    fXVar = fMCHist->GetBinCenter(bin + 1);
   fYVar = pmu;
   fZVar = CosThetaMu;
 
   return;
 };
 
-void T2K_CC0pinp_ifk_XSec_3Dinfp_nu::FillHistograms(){
+void T2K_CC0pinp_ifk_XSec_3Dinfp_nu::FillHistograms() {
 
-  Measurement1D::FillHistograms();
-  if (Signal){
-    FillMCSlice( fXVar, fYVar, fZVar, Weight );
-  }
+  // Weights carry the width along the binned variable, so the flat histogram
+  // and its modes only need the overall scale factor
+  int bin = fMCHist->FindFixBin(fXVar) - 1;
+  if (bin < 0 || bin >= fSliceBinning.GetNBins())
+    return;
 
+  double weight = Weight;
+  Weight /= fSliceBinning.GetBinWidth(bin);
+  Measurement1D::FillHistograms();
+  Weight = weight;
 }
 
+void T2K_CC0pinp_ifk_XSec_3Dinfp_nu::ConvertEventRates() {
 
-void T2K_CC0pinp_ifk_XSec_3Dinfp_nu::ConvertEventRates(){
-
-  for (int i = 0; i < 7; i++){
-    fMCHist_Slices[i]->GetSumw2();
-  }
+  // The out of range bin keeps the raw event weight
+  double outofrange = fMCHist->GetBinContent(1);
 
   // Do standard conversion.
   Measurement1D::ConvertEventRates();
 
-  // First scale MC slices also by their width in Y and Z
-  //MCHist_Slices[0]->Scale(1.0 / 1.00);
-  //MCHist_Slices[1]->Scale(1.0 / 0.60);
-  //MCHist_Slices[2]->Scale(1.0 / 0.10);
-  //MCHist_Slices[3]->Scale(1.0 / 0.10);
-
-
-  // Now Convert into 1D list
-  fMCHist->Reset();
-  //The first bin in the histogram in underflow, so set this and start bincount at 1
-  fMCHist->SetBinContent(1, outOfBoundsMC);
-  int bincount = 1; 
-  for (int i = 0; i < 7; i++){
-    for (int j = 0; j < fDataHist_Slices[i]->GetNbinsX(); j++){
-      fMCHist->SetBinContent(bincount+1, fMCHist_Slices[i]->GetBinContent(j+1));
-      //fMCHist->SetBinError(bincount+1, fMCHist_Slices[i]->GetBinError(j+1));
-      bincount++;
-    }
+  fMCHist->SetBinContent(1, outofrange);
+
+  // Slice histograms are just views of the flat histogram
+  for (int i = 0; i < fSliceBinning.GetNSlices(); i++) {
+    fSliceBinning.FillSliceHist(fMCHist, i, fMCHist_Slices[i]);
   }
 
   return;
 }
 
-void T2K_CC0pinp_ifk_XSec_3Dinfp_nu::FillMCSlice(double x, double y, double z, double w){
-  // x is delta_p
-  // y is pmu
-  // z is CosThetaMu
-
-  if      (z <= -0.6) fMCHist_Slices[0]->Fill(x,w);
-  else if (z >= -0.6 and z < 0.0 and y < 0.25)  fMCHist_Slices[1]->Fill(x,w);
-  else if (z >= -0.6 and z < 0.0 and y > 0.25)  fMCHist_Slices[2]->Fill(x,w);
-  else if (z >= 0.0 and y < 0.25)  fMCHist_Slices[3]->Fill(x,w);
-  else if (z >= 0.0 and z < 0.8 and y >= 0.25)  fMCHist_Slices[4]->Fill(x,w);
-  else if (z >= 0.8 and z < 1.0 and y >= 0.25 and y < 0.75)  fMCHist_Slices[5]->Fill(x,w);
-  else if (z >= 0.8 and z < 1.0 and y >= 0.75)  fMCHist_Slices[6]->Fill(x,w);
-  else outOfBoundsMC += w;
-
-}
-
-
 void T2K_CC0pinp_ifk_XSec_3Dinfp_nu::SetHistograms(){
 
   std::string name = fSettings.GetName();
@@ -180,8 +158,16 @@ void T2K_CC0pinp_ifk_XSec_3Dinfp_nu::SetHistograms(){
 					 name.c_str(), i, fSettings.GetYTitle().c_str()));
 
     SetAutoProcessTH1(fDataHist_Slices[i],kCMD_Write);
-    SetAutoProcessTH1(fMCHist_Slices[i]);
+    SetAutoProcessTH1(fMCHist_Slices[i], kCMD_Write);
     fMCHist_Slices[i]->Reset();
   }
+
+  fSliceBinning = T2K_CC0pinp_ifk::Get3DinfSliceBinning(fDataHist_Slices);
+
+  if (fSliceBinning.GetNBins() != fDataHist->GetNbinsX()) {
+    NUIS_ABORT(name << ": slice binning has " << fSliceBinning.GetNBins()
+                    << " bins but the data has " << fDataHist->GetNbinsX());
+  }
+
   return;
 };
@@ -47,6 +47,7 @@ T2K_CC1pip_H2O_XSec_1DEnuDelta_nu::T2K_CC1pip_H2O_XSec_1DEnuDelta_nu(
       (GetEventHistogram()->Integral("width") * 1E-38) / double(fNEvents);
 
   // Plot Setup -------------------------------------------------------
+  fDeferLoading = true;
   SetDataFromRootFile(fSettings.GetDataInput());
   SetCovarFromRootFile(fSettings.GetCovarInput());
   ScaleCovar(1E76);
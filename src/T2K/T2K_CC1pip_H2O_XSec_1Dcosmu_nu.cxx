@@ -43,6 +43,7 @@ T2K_CC1pip_H2O_XSec_1Dcosmu_nu::T2K_CC1pip_H2O_XSec_1Dcosmu_nu(
                  double(fNEvents) / TotalIntegratedFlux("width");
 
   // Plot Setup -------------------------------------------------------
+  fDeferLoading = true;
   SetDataFromRootFile(fSettings.GetDataInput());
   SetCovarFromRootFile(fSettings.GetCovarInput());
   ScaleCovar(1E76);
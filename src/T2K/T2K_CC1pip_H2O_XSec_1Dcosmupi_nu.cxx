@@ -41,6 +41,7 @@ T2K_CC1pip_H2O_XSec_1Dcosmupi_nu::T2K_CC1pip_H2O_XSec_1Dcosmupi_nu(
                  double(fNEvents) / TotalIntegratedFlux("width");
 
   // Plot Setup -------------------------------------------------------
+  fDeferLoading = true;
   SetDataFromRootFile(fSettings.GetDataInput());
   SetCovarFromRootFile(fSettings.GetCovarInput());
   ScaleCovar(1E76);
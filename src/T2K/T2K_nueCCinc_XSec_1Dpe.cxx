@@ -52,6 +52,7 @@ T2K_nueCCinc_XSec_1Dpe::T2K_nueCCinc_XSec_1Dpe(nuiskey samplekey) {
   fSettings.DefineAllowedTargets("C,H");
   FinaliseSampleSettings();
 
+  fDeferLoading = true;
   SetDataFromTextFile( fSettings.GetDataInput() );
 
   // Scaling Setup ---------------------------------------------------
@@ -52,6 +52,7 @@ T2K_nueCCinc_XSec_1Dthe::T2K_nueCCinc_XSec_1Dthe(nuiskey samplekey) {
   fSettings.DefineAllowedTargets("C,H");
   FinaliseSampleSettings();
 
+  fDeferLoading = true;
   SetDataFromTextFile( fSettings.GetDataInput() );
 
   // Scaling Setup ---------------------------------------------------
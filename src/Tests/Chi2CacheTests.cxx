@@ -0,0 +1,156 @@
+#include "StatUtils.h"
+#include "FitLogger.h"
+
+#include "TH1D.h"
+#include "TH1I.h"
+#include "TRandom3.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace {
+const int kNBins = 8;
+const double kTol = 1E-6;
+
+bool Close(double a, double b) {
+  return std::fabs(a - b) <= kTol * std::max(std::fabs(a), std::fabs(b));
+}
+
+// Correlated covariance in the usual 1E-38 cross-section units
+TMatrixDSym *MakeCovariance(TH1D *data, TRandom3 &rand) {
+  TMatrixDSym *cov = new TMatrixDSym(kNBins);
+  for (int i = 0; i < kNBins; i++) {
+    for (int j = 0; j < kNBins; j++) {
+      double erri = 0.1 * data->GetBinContent(i + 1);
+      double errj = 0.1 * data->GetBinContent(j + 1);
+      double corr = (i == j) ? 1.0 : 0.4 * std::exp(-std::fabs(i - j));
+      (*cov)(i, j) = corr * erri * errj;
+    }
+    (*cov)(i, i) *= 1.0 + 0.2 * rand.Uniform();
+  }
+  return cov;
+}
+
+TH1I *MakeMask(std::vector<int> const &masked) {
+  TH1I *mask = new TH1I("mask", "mask", kNBins, 0, kNBins);
+  mask->SetDirectory(NULL);
+  for (size_t i = 0; i < masked.size(); i++) {
+    mask->SetBinContent(masked[i] + 1, 1);
+  }
+  return mask;
+}
+
+// Uncached chi2 of data against mcscale * mc with the given bins masked
+double ReferenceChi2(TH1D *data, TH1D *mc, double mcscale, TMatrixDSym *invcov,
+                     std::vector<int> const &masked) {
+  TH1D *scaledmc = (TH1D *)mc->Clone("scaledmc");
+  scaledmc->SetDirectory(NULL);
+  scaledmc->Scale(mcscale);
+
+  TH1I *mask = masked.empty() ? NULL : MakeMask(masked);
+  double chi2 = StatUtils::GetChi2FromCov(data, scaledmc, invcov, mask);
+
+  delete mask;
+  delete scaledmc;
+  return chi2;
+}
+
+// The cached chi2 and its N-1 shortcut must give what GetChi2FromCov gives
+bool CompareCachedChi2(StatUtils::CovarCache &cache, TH1D *data, TH1D *mc,
+                       double mcscale, TMatrixDSym *invcov,
+                       std::vector<int> const &masked) {
+  TH1I *mask = masked.empty() ? NULL : MakeMask(masked);
+  StatUtils::UpdateCovarCache(cache, data, invcov, 0, mask);
+  delete mask;
+
+  TH1D lessbin("lessbin", "lessbin", kNBins, 0, kNBins);
+  lessbin.SetDirectory(NULL);
+  double cached =
+      StatUtils::GetChi2FromCov(cache, data, mc, mcscale, NULL, &lessbin);
+  double expected = ReferenceChi2(data, mc, mcscale, invcov, masked);
+
+  bool same = true;
+  if (!Close(cached, expected)) {
+    NUIS_ERR(FTL, "Cached chi2 " << cached << " != " << expected);
+    same = false;
+  }
+
+  for (int k = 0; k < kNBins; k++) {
+    if (std::find(masked.begin(), masked.end(), k) != masked.end())
+      continue;
+
+    std::vector<int> lessmasked = masked;
+    lessmasked.push_back(k);
+    double lessexpected = ReferenceChi2(data, mc, mcscale, invcov, lessmasked);
+    if (!Close(lessbin.GetBinContent(k + 1), lessexpected)) {
+      NUIS_ERR(FTL, "Chi2 without bin " << k << " "
+                                         << lessbin.GetBinContent(k + 1)
+                                         << " != " << lessexpected);
+      same = false;
+    }
+  }
+  return same;
+}
+} // namespace
+
+int main(int argc, char const *argv[]) {
+  SETVERBOSITY(SAM);
+  NUIS_LOG(FIT, "*            Running Chi2 Cache Tests");
+  NUIS_LOG(FIT, "***************************************************");
+
+  TRandom3 rand(4321);
+  TH1D data("data", "data", kNBins, 0, kNBins);
+  TH1D mc("mc", "mc", kNBins, 0, kNBins);
+  data.SetDirectory(NULL);
+  mc.SetDirectory(NULL);
+  for (int i = 0; i < kNBins; i++) {
+    double val = 1E-38 * (1.0 + i);
+    data.SetBinContent(i + 1, val);
+    mc.SetBinContent(i + 1, val * rand.Uniform(0.7, 1.3));
+  }
+
+  TMatrixDSym *cov = MakeCovariance(&data, rand);
+  TMatrixDSym *invcov = StatUtils::GetInvert(cov, true);
+
+  StatUtils::CovarCache cache;
+
+  NUIS_LOG(FIT, "    *        Test cached chi2 and N-1 chi2, no mask");
+  assert(CompareCachedChi2(cache, &data, &mc, 1.0, invcov,
+                           std::vector<int>()));
+  assert(CompareCachedChi2(cache, &data, &mc, 1.15, invcov,
+                           std::vector<int>()));
+
+  NUIS_LOG(FIT, "    *        Test cached chi2 and N-1 chi2, masked bins");
+  std::vector<int> masked;
+  masked.push_back(2);
+  assert(CompareCachedChi2(cache, &data, &mc, 1.0, invcov, masked));
+  masked.push_back(5);
+  assert(CompareCachedChi2(cache, &data, &mc, 0.9, invcov, masked));
+
+  NUIS_LOG(FIT, "    *        Test cache follows replaced matrices");
+  // A fresh matrix, even at the old address, gets a new serial
+  UInt_t oldserial = StatUtils::GetMatrixSerial(invcov);
+  delete invcov;
+  (*cov)(0, 0) *= 2.0;
+  invcov = StatUtils::GetInvert(cov, true);
+  assert(StatUtils::GetMatrixSerial(invcov) != oldserial);
+  assert(CompareCachedChi2(cache, &data, &mc, 1.0, invcov, masked));
+
+  // A clone carries the source's unique ID but not its serial
+  TMatrixDSym *clone = (TMatrixDSym *)invcov->Clone();
+  assert(StatUtils::GetMatrixSerial(clone) !=
+         StatUtils::GetMatrixSerial(invcov));
+  delete clone;
+
+  NUIS_LOG(FIT, "    *        Test cache follows in place changes");
+  oldserial = StatUtils::GetMatrixSerial(invcov);
+  (*invcov) *= 0.5;
+  StatUtils::MarkMatrixChanged(invcov);
+  assert(StatUtils::GetMatrixSerial(invcov) != oldserial);
+  assert(CompareCachedChi2(cache, &data, &mc, 1.0, invcov, masked));
+
+  delete invcov;
+  delete cov;
+  return 0;
+}
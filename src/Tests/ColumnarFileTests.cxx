@@ -0,0 +1,133 @@
+#include "ColumnarFile.h"
+#include "FitLogger.h"
+#include "NuisConfig.h"
+#include "ParallelUtils.h"
+
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace {
+const int kNRows = 53;
+const int kMaxCount = 5;
+
+// Deterministic row contents so the reader can rebuild what was written
+int RowCount(int row) { return row % (kMaxCount + 1); }
+float RowFloat(int row) { return 0.5f * row - 3.0f; }
+double RowDouble(int row) { return 1E-3 * row * row + 1E10; }
+bool RowBool(int row) { return row % 3 == 0; }
+double RowArray(int row, int i) { return row * 10.0 + i; }
+
+template <typename T> T At(std::vector<char> const &data, size_t i) {
+  T val;
+  memcpy(&val, &data[i * sizeof(T)], sizeof(T));
+  return val;
+}
+
+// Write kNRows rows in chunks of chunkrows, read them back and compare
+void RoundTrip(std::string const &filename, size_t chunkrows,
+               int compression) {
+  NUIS_LOG(FIT, "        *        Chunk rows " << chunkrows
+                                               << ", compression "
+                                               << compression);
+
+  int count;
+  float fval;
+  double dval;
+  bool bval;
+  double arr[kMaxCount];
+
+  ColumnarFile::Writer writer(filename, chunkrows, compression);
+  int icount = writer.AddColumn("count", 'I', &count);
+  writer.AddColumn("fval", 'F', &fval);
+  writer.AddColumn("dval", 'D', &dval);
+  writer.AddColumn("bval", 'O', &bval);
+  writer.AddArrayColumn("arr", 'D', arr, icount, kMaxCount);
+
+  for (int row = 0; row < kNRows; row++) {
+    count = RowCount(row);
+    fval = RowFloat(row);
+    dval = RowDouble(row);
+    bval = RowBool(row);
+    for (int i = 0; i < kMaxCount; i++) {
+      arr[i] = (i < count) ? RowArray(row, i) : -1.0;
+    }
+    writer.Fill();
+  }
+  writer.Close();
+  assert(writer.GetNRows() == size_t(kNRows));
+
+  ColumnarFile::Reader reader(filename);
+  assert(reader.GetNColumns() == 5);
+  assert(reader.GetNRows() == size_t(kNRows));
+  assert(reader.GetNChunks() == int((kNRows + chunkrows - 1) / chunkrows));
+  assert(reader.GetColumnIndex("arr") == 4);
+  assert(reader.GetCountColumn(4) == icount);
+  assert(reader.GetColumnType(2) == 'D');
+  assert(reader.GetColumnIndex("missing") == -1);
+
+  int row0 = 0;
+  std::vector<char> data;
+  for (int ichunk = 0; ichunk < reader.GetNChunks(); ichunk++) {
+    size_t nrows = reader.ReadColumn(ichunk, 0, data);
+    assert(data.size() == nrows * sizeof(int));
+    std::vector<int> counts;
+    for (size_t i = 0; i < nrows; i++) {
+      counts.push_back(At<int>(data, i));
+      assert(counts.back() == RowCount(row0 + i));
+    }
+
+    reader.ReadColumn(ichunk, 1, data);
+    for (size_t i = 0; i < nrows; i++) {
+      assert(At<float>(data, i) == RowFloat(row0 + i));
+    }
+
+    reader.ReadColumn(ichunk, 2, data);
+    for (size_t i = 0; i < nrows; i++) {
+      assert(At<double>(data, i) == RowDouble(row0 + i));
+    }
+
+    reader.ReadColumn(ichunk, 3, data);
+    for (size_t i = 0; i < nrows; i++) {
+      assert(At<bool>(data, i) == RowBool(row0 + i));
+    }
+
+    // Array values are packed, count[row] values per row
+    reader.ReadColumn(ichunk, 4, data);
+    size_t ival = 0;
+    for (size_t i = 0; i < nrows; i++) {
+      for (int j = 0; j < counts[i]; j++) {
+        assert(At<double>(data, ival++) == RowArray(row0 + i, j));
+      }
+    }
+    assert(data.size() == ival * sizeof(double));
+
+    row0 += nrows;
+  }
+  assert(row0 == kNRows);
+}
+} // namespace
+
+int main(int argc, char const *argv[]) {
+  SETVERBOSITY(SAM);
+  NUIS_LOG(FIT, "*            Running ColumnarFile Tests");
+  NUIS_LOG(FIT, "***************************************************");
+
+  std::string filename = "ColumnarFileTests.ncol";
+
+  NUIS_LOG(FIT, "    *        Test serial write/read round trip");
+  Config::SetPar("cores", 1);
+  RoundTrip(filename, 7, 0);
+  RoundTrip(filename, 7, 101);
+  RoundTrip(filename, 1000, 101);
+
+  NUIS_LOG(FIT, "    *        Test threaded write/read round trip");
+  ParallelUtils::EnableThreads();
+  Config::SetPar("cores", 4);
+  RoundTrip(filename, 7, 101);
+  RoundTrip(filename, 10, 404);
+
+  remove(filename.c_str());
+  return 0;
+}
@@ -0,0 +1,148 @@
+#include "WeightUtils.h"
+#include "FitLogger.h"
+
+#include <cassert>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace {
+const int kMaxMode = 60;
+
+// A generator dial and the NEUT style modes it is known to change
+struct DialModes {
+  std::string name;
+  std::vector<int> modes;
+};
+
+DialModes Dial(std::string name, int const *modes, int nmodes) {
+  DialModes dial;
+  dial.name = name;
+  dial.modes.assign(modes, modes + nmodes);
+  return dial;
+}
+
+// Every listed mode, either neutrino or anti-neutrino, must be reached
+bool ReachesModes(DialModes const &dial) {
+  bool same = true;
+  for (size_t i = 0; i < dial.modes.size(); i++) {
+    int mode = dial.modes[i];
+    if (!Reweight::GeneratorDialAffectsMode(dial.name, mode) ||
+        !Reweight::GeneratorDialAffectsMode(dial.name, -mode)) {
+      NUIS_ERR(FTL, "Dial " << dial.name << " does not reach mode " << mode);
+      same = false;
+    }
+  }
+  return same;
+}
+
+// Dials outside the channel rules must reach everything
+bool ReachesAll(std::string const &name) {
+  bool same = true;
+  for (int mode = -kMaxMode; mode <= kMaxMode; mode++) {
+    if (!Reweight::GeneratorDialAffectsMode(name, mode)) {
+      NUIS_ERR(FTL, "Dial " << name << " does not reach mode " << mode);
+      same = false;
+    }
+  }
+  return same;
+}
+
+// Masks are only worth having if they leave other channels out
+bool MissesMode(std::string const &name, int mode) {
+  if (Reweight::GeneratorDialAffectsMode(name, mode)) {
+    NUIS_ERR(FTL, "Dial " << name << " should not reach mode " << mode);
+    return false;
+  }
+  return true;
+}
+} // namespace
+
+int main(int argc, char const *argv[]) {
+  SETVERBOSITY(SAM);
+  NUIS_LOG(FIT, "*            Running Dial Mask Tests");
+  NUIS_LOG(FIT, "***************************************************");
+
+  int ccqe[] = {1};
+  int ncel[] = {51, 52};
+  int ccres[] = {11, 12, 13, 17, 22, 23};
+  int ncres[] = {31, 32, 33, 34, 38, 39, 42, 43, 44, 45};
+  int res[] = {11, 12, 13, 31, 32, 33, 34};
+  int coh[] = {16, 36};
+  int ccmec[] = {2};
+  int dis[] = {21, 26, 41, 46};
+
+  std::vector<DialModes> dials;
+
+  // GENIE
+  dials.push_back(Dial("MaCCQE", ccqe, 1));
+  dials.push_back(Dial("NormCCQE", ccqe, 1));
+  dials.push_back(Dial("VecFFCCQEshape", ccqe, 1));
+  dials.push_back(Dial("CCQEPauliSupViaKF", ccqe, 1));
+  dials.push_back(Dial("MaNCEL", ncel, 2));
+  dials.push_back(Dial("EtaNCEL", ncel, 2));
+  dials.push_back(Dial("MaCCRES", ccres, 6));
+  dials.push_back(Dial("MvCCRES", ccres, 6));
+  dials.push_back(Dial("NormCCRES", ccres, 6));
+  dials.push_back(Dial("MaNCRES", ncres, 10));
+  dials.push_back(Dial("NormNCRES", ncres, 10));
+  dials.push_back(Dial("MaCOHpi", coh, 2));
+  dials.push_back(Dial("R0COHpi", coh, 2));
+  dials.push_back(Dial("NormCCMEC", ccmec, 1));
+  dials.push_back(Dial("AhtBY", dis, 4));
+  dials.push_back(Dial("NormDISCC", dis, 4));
+
+  // NEUT
+  dials.push_back(Dial("NXSec_MaCCQE", ccqe, 1));
+  dials.push_back(Dial("NXSec_MaCCQE", ncel, 2));
+  dials.push_back(Dial("NXSec_VecFFCCQE", ccqe, 1));
+  dials.push_back(Dial("NXSec_MaNCEL", ncel, 2));
+  dials.push_back(Dial("NXSec_CA5RES", res, 7));
+  dials.push_back(Dial("NXSec_MaRES", res, 7));
+  dials.push_back(Dial("NXSec_BgSclRES", res, 7));
+  dials.push_back(Dial("NXSec_MaNFFRES", res, 7));
+  dials.push_back(Dial("NXSec_CA5COH", coh, 2));
+  dials.push_back(Dial("NXSec_MaCOHpi", coh, 2));
+  dials.push_back(Dial("NIWGMEC_Norm_C12", ccmec, 1));
+  dials.push_back(Dial("MaCCQE", ncel, 2));
+
+  NUIS_LOG(FIT, "    *        Test GENIE and NEUT dials reach their modes");
+  bool same = true;
+  for (size_t i = 0; i < dials.size(); i++) {
+    same = ReachesModes(dials[i]) && same;
+  }
+  assert(same);
+
+  NUIS_LOG(FIT, "    *        Test FSI and background dials reach every mode");
+  std::string allmodes[] = {"NonRESBGvpCC1pi", "NonRESBGvbarnNC2pi",
+                            "MFP_pi",          "FrAbs_pi",
+                            "FrInel_N",        "FSI_PI_ABS",
+                            "FSI_CEX_LO",      "Theta_Delta2Npi",
+                            "NIWG2014a_pF_C12", ""};
+  for (size_t i = 0; i < sizeof(allmodes) / sizeof(allmodes[0]); i++) {
+    same = ReachesAll(allmodes[i]) && same;
+  }
+  assert(same);
+
+  NUIS_LOG(FIT, "    *        Test channel dials miss other channels");
+  same = MissesMode("MaCCQE", 2) && same;
+  same = MissesMode("MaCCQE", 11) && same;
+  same = MissesMode("MaCCQE", -26) && same;
+  same = MissesMode("NXSec_MaCCQE", 16) && same;
+  same = MissesMode("MaNCEL", 1) && same;
+  same = MissesMode("MaCCRES", 1) && same;
+  same = MissesMode("MaCCRES", 31) && same;
+  same = MissesMode("MaNCRES", 11) && same;
+  same = MissesMode("NXSec_MaRES", 26) && same;
+  same = MissesMode("MaCOHpi", 11) && same;
+  same = MissesMode("NormCCMEC", 1) && same;
+  assert(same);
+
+  NUIS_LOG(FIT, "    *        Test dial lists reach the union of their modes");
+  assert(Reweight::GeneratorDialAffectsMode("MaCCQE,MaCOHpi", 1));
+  assert(Reweight::GeneratorDialAffectsMode("MaCCQE,MaCOHpi", -36));
+  assert(MissesMode("MaCCQE,MaCOHpi", 11));
+  assert(ReachesAll("MaCCQE,MFP_pi"));
+
+  return 0;
+}
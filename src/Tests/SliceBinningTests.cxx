@@ -0,0 +1,134 @@
+#include "SliceBinning.h"
+#include "T2K_CC0pinp_ifk_3DinfBinning.h"
+#include "FitLogger.h"
+
+#include "TH1D.h"
+#include "TRandom3.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace {
+// Bin an event the way the release if-chains did: first slice box that
+// contains it, then a linear search of that slice's edges
+int ReferenceBin(SliceBinning const &binning,
+                 std::vector<std::vector<double> > const &edges,
+                 double const *vars) {
+  int slice = binning.ScanSlices(vars);
+  if (slice < 0)
+    return 0;
+
+  double x = vars[0];
+  for (size_t i = 1; i < edges[slice].size(); i++) {
+    if (x >= edges[slice][i - 1] && x < edges[slice][i])
+      return binning.GetSliceOffset(slice) + i - 1;
+  }
+  return SliceBinning::kNoBin;
+}
+
+bool SameBin(SliceBinning const &binning,
+             std::vector<std::vector<double> > const &edges,
+             double const *vars) {
+  int found = binning.FindBin(vars);
+  int expected = ReferenceBin(binning, edges, vars);
+  if (found != expected) {
+    NUIS_ERR(FTL, "FindBin(" << vars[0] << ", " << vars[1] << ", " << vars[2]
+                             << ") = " << found << ", slice scan gives "
+                             << expected);
+    return false;
+  }
+  return true;
+}
+
+// Each value, plus the nearest doubles either side of it
+void AddWithNeighbours(std::vector<double> &vals, double val) {
+  const double inf = std::numeric_limits<double>::infinity();
+  vals.push_back(val);
+  vals.push_back(std::nextafter(val, -inf));
+  vals.push_back(std::nextafter(val, inf));
+}
+} // namespace
+
+int main(int argc, char const *argv[]) {
+  SETVERBOSITY(SAM);
+  NUIS_LOG(FIT, "*            Running SliceBinning Tests");
+  NUIS_LOG(FIT, "***************************************************");
+
+  // Release style x binnings, each slice different
+  std::vector<TH1D *> slices;
+  std::vector<std::vector<double> > edges;
+  for (int i = 0; i < 7; i++) {
+    std::vector<double> sliceedges;
+    for (int j = 0; j <= 4 + i; j++) {
+      sliceedges.push_back(-0.3 + 0.05 * i + j * (0.12 + 0.01 * i));
+    }
+    edges.push_back(sliceedges);
+    slices.push_back(new TH1D(Form("slice%i", i), Form("slice%i", i),
+                              sliceedges.size() - 1, &sliceedges[0]));
+    slices.back()->SetDirectory(NULL);
+  }
+
+  SliceBinning binning = T2K_CC0pinp_ifk::Get3DinfSliceBinning(slices);
+
+  int nbins = 1;
+  for (size_t i = 0; i < edges.size(); i++) {
+    nbins += edges[i].size() - 1;
+  }
+  assert(binning.GetNBins() == nbins);
+  assert(binning.GetNSlices() == 7);
+
+  NUIS_LOG(FIT, "    *        Test FindBin against ScanSlices, random points");
+  TRandom3 rand(2468);
+  bool same = true;
+  for (int i = 0; i < 200000; i++) {
+    double vars[3] = {rand.Uniform(-0.6, 1.3), rand.Uniform(-0.2, 1.5),
+                      rand.Uniform(-1.2, 1.2)};
+    same = SameBin(binning, edges, vars) && same;
+  }
+  assert(same);
+
+  NUIS_LOG(FIT, "    *        Test FindBin against ScanSlices, boundaries");
+  const double inf = std::numeric_limits<double>::infinity();
+  std::vector<double> xvals, pvals, cvals;
+  for (size_t i = 0; i < edges.size(); i++) {
+    for (size_t j = 0; j < edges[i].size(); j++) {
+      AddWithNeighbours(xvals, edges[i][j]);
+    }
+  }
+  double pcuts[] = {0.0, 0.25, 0.75};
+  double ccuts[] = {-1.0, -0.6, 0.0, 0.8, 1.0};
+  for (int i = 0; i < 3; i++) {
+    AddWithNeighbours(pvals, pcuts[i]);
+  }
+  for (int i = 0; i < 5; i++) {
+    AddWithNeighbours(cvals, ccuts[i]);
+  }
+  xvals.push_back(-inf);
+  xvals.push_back(inf);
+  pvals.push_back(inf);
+  cvals.push_back(-inf);
+  cvals.push_back(inf);
+
+  for (size_t ix = 0; ix < xvals.size(); ix++) {
+    for (size_t ip = 0; ip < pvals.size(); ip++) {
+      for (size_t ic = 0; ic < cvals.size(); ic++) {
+        double vars[3] = {xvals[ix], pvals[ip], cvals[ic]};
+        same = SameBin(binning, edges, vars) && same;
+      }
+    }
+  }
+  assert(same);
+
+  NUIS_LOG(FIT, "    *        Test NaN variables land out of range");
+  double nanvars[3] = {0.1, std::numeric_limits<double>::quiet_NaN(), 0.5};
+  assert(binning.FindBin(nanvars) == 0);
+  assert(binning.ScanSlices(nanvars) == -1);
+
+  for (size_t i = 0; i < slices.size(); i++) {
+    delete slices[i];
+  }
+  return 0;
+}
@@ -0,0 +1,169 @@
+#include "StackBase.h"
+#include "FitLogger.h"
+
+#include "TH1D.h"
+#include "TH2D.h"
+#include "TRandom3.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+namespace {
+const int kNCategories = 4;
+const int kNFills = 2000;
+
+// The per category TH1 stack that StackBase kept before the dense store
+struct ReferenceStack {
+  std::vector<TH1 *> hists;
+
+  ReferenceStack(TH1 *templ) {
+    for (int i = 0; i < kNCategories; i++) {
+      hists.push_back(
+          (TH1 *)templ->Clone(Form("%s_ref%i", templ->GetName(), i)));
+      hists.back()->Reset();
+    }
+  }
+  ~ReferenceStack() {
+    for (size_t i = 0; i < hists.size(); i++) {
+      delete hists[i];
+    }
+  }
+
+  void FillStack(int index, double x, double y, double z) {
+    if (hists[index]->GetDimension() == 1)
+      hists[index]->Fill(x, y);
+    else
+      ((TH2 *)hists[index])->Fill(x, y, z);
+  }
+  void Scale(double sf, std::string opt) {
+    for (size_t i = 0; i < hists.size(); i++)
+      hists[i]->Scale(sf, opt.c_str());
+  }
+  void Multiply(TH1 *hist) {
+    for (size_t i = 0; i < hists.size(); i++)
+      hists[i]->Multiply(hist);
+  }
+  void Divide(TH1 *hist) {
+    for (size_t i = 0; i < hists.size(); i++)
+      hists[i]->Divide(hist);
+  }
+};
+
+bool Close(double a, double b) {
+  return std::fabs(a - b) <= 1E-10 * std::max(std::fabs(a), std::fabs(b));
+}
+
+// Every cell, including under/overflow, must match in content and error
+bool SameContents(StackBase &stack, ReferenceStack &ref, std::string stage) {
+  bool same = true;
+  for (int i = 0; i < kNCategories; i++) {
+    TH1 *hist = stack.GetHist(i);
+    for (int j = 0; j < ref.hists[i]->GetNcells(); j++) {
+      double expected = ref.hists[i]->GetBinContent(j);
+      double experr = ref.hists[i]->GetBinError(j);
+      if (!Close(hist->GetBinContent(j), expected) or
+          !Close(hist->GetBinError(j), experr)) {
+        NUIS_ERR(FTL, "[" << stage << "] Category " << i << " cell " << j
+                          << ": " << hist->GetBinContent(j) << " +/- "
+                          << hist->GetBinError(j) << " != " << expected
+                          << " +/- " << experr);
+        same = false;
+      }
+    }
+  }
+  return same;
+}
+
+void SetupModes(StackBase &stack, std::string name, TH1 *templ) {
+  stack.fName = name;
+  for (int i = 0; i < kNCategories; i++) {
+    stack.AddMode(Form("cat%i", i), Form("Category %i", i), i + 1);
+  }
+  stack.SetupStack(templ);
+}
+
+// Fill, Scale("width"), Multiply and Divide the dense stack and a TH1
+// reference side by side. The checked stack is compared after every step,
+// which also round-trips the dense arrays through the hists, while the
+// unchecked stack only goes through the dense path until the end.
+bool CompareStacks(TH1 *templ, TH1 *factor, TH1 *divisor) {
+  StackBase checked, unchecked;
+  SetupModes(checked, std::string(templ->GetName()) + "_checked", templ);
+  SetupModes(unchecked, std::string(templ->GetName()) + "_unchecked", templ);
+  ReferenceStack ref(templ);
+
+  TRandom3 rand(1234);
+  bool is1D = (templ->GetDimension() == 1);
+  for (int i = 0; i < kNFills; i++) {
+    int index = rand.Integer(kNCategories);
+    double x = rand.Uniform(-0.5, 5.5);
+    double y = is1D ? rand.Uniform(0.1, 2.0) : rand.Uniform(-0.5, 3.5);
+    double z = rand.Uniform(0.1, 2.0);
+    checked.FillStack(index, x, y, z);
+    unchecked.FillStack(index, x, y, z);
+    ref.FillStack(index, x, y, z);
+  }
+
+  bool same = SameContents(checked, ref, "Fill");
+
+  checked.Scale(0.37, "width");
+  unchecked.Scale(0.37, "width");
+  ref.Scale(0.37, "width");
+  same = SameContents(checked, ref, "Scale width") and same;
+  same = SameContents(unchecked, ref, "Dense Scale width") and same;
+
+  checked.Multiply(factor);
+  unchecked.Multiply(factor);
+  ref.Multiply(factor);
+  same = SameContents(checked, ref, "Multiply") and same;
+
+  checked.Divide(divisor);
+  unchecked.Divide(divisor);
+  ref.Divide(divisor);
+  same = SameContents(checked, ref, "Divide") and same;
+
+  // Scaling again after TH1 arithmetic goes back to the dense arrays
+  checked.Scale(2.5);
+  unchecked.Scale(2.5);
+  ref.Scale(2.5, "");
+  same = SameContents(checked, ref, "Scale after Divide") and same;
+  same = SameContents(unchecked, ref, "Dense Scale after Divide") and same;
+
+  return same;
+}
+
+void FillRatio(TH1 *hist, double offset) {
+  for (int j = 0; j < hist->GetNcells(); j++) {
+    hist->SetBinContent(j, offset + 0.1 * j);
+    hist->SetBinError(j, 0.05 * (j % 3 + 1));
+  }
+}
+} // namespace
+
+int main(int argc, char const *argv[]) {
+  SETVERBOSITY(SAM);
+  NUIS_LOG(FIT, "*            Running StackBase Tests");
+  NUIS_LOG(FIT, "***************************************************");
+
+  NUIS_LOG(FIT, "    *        Test 1D variable binning against TH1 stack");
+  double xbins[] = {0.0, 0.5, 1.0, 2.0, 3.5, 5.0};
+  TH1D templ1D("Stack1D", "Stack1D", 5, xbins);
+  TH1D factor1D("Factor1D", "Factor1D", 5, xbins);
+  TH1D divisor1D("Divisor1D", "Divisor1D", 5, xbins);
+  FillRatio(&factor1D, 0.5);
+  FillRatio(&divisor1D, 1.5);
+  assert(CompareStacks(&templ1D, &factor1D, &divisor1D));
+
+  NUIS_LOG(FIT, "    *        Test 2D variable binning against TH1 stack");
+  double ybins[] = {0.0, 1.0, 1.5, 3.0};
+  TH2D templ2D("Stack2D", "Stack2D", 5, xbins, 3, ybins);
+  TH2D factor2D("Factor2D", "Factor2D", 5, xbins, 3, ybins);
+  TH2D divisor2D("Divisor2D", "Divisor2D", 5, xbins, 3, ybins);
+  FillRatio(&factor2D, 0.5);
+  FillRatio(&divisor2D, 1.5);
+  assert(CompareStacks(&templ2D, &factor2D, &divisor2D));
+
+  return 0;
+}
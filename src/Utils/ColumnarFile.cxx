@@ -0,0 +1,414 @@
+// Copyright 2016-2021 L. Pickering, P Stowell, R. Terri, C. Wilkinson, C. Wret
+
+/*******************************************************************************
+*    This file is part of NUISANCE.
+*
+*    NUISANCE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    NUISANCE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with NUISANCE.  If not, see <http://www.gnu.org/licenses/>.
+*******************************************************************************/
+#include "ColumnarFile.h"
+
+#include "FitLogger.h"
+#include "ParallelUtils.h"
+
+#include "RZip.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace ColumnarFile {
+
+namespace {
+const char kMagic[8] = {'N', 'U', 'I', 'S', 'C', 'O', 'L', '1'};
+const char kEndMagic[8] = {'N', 'U', 'I', 'S', 'C', 'O', 'L', 'E'};
+
+// R__zip handles at most 16 MB per call
+const size_t kMaxBlock = 1 << 23;
+
+template <typename T> void Append(std::vector<char> &out, T val) {
+  const char *ptr = reinterpret_cast<const char *>(&val);
+  out.insert(out.end(), ptr, ptr + sizeof(T));
+}
+
+template <typename T> bool Read(FILE *file, T &val) {
+  return fread(&val, sizeof(T), 1, file) == 1;
+}
+
+// Compress each column buffer of a chunk into its on-disk block list.
+class CompressTask : public ParallelUtils::Task {
+public:
+  CompressTask(std::vector<std::vector<char> const *> const &in,
+               int compression)
+      : fIn(in), fOut(in.size()), fCompression(compression) {}
+
+  std::vector<double> Run(int icol) {
+    std::vector<char> const &in = *fIn[icol];
+    std::vector<char> &out = fOut[icol];
+    out.clear();
+
+    uint32_t nblocks = (in.size() + kMaxBlock - 1) / kMaxBlock;
+    Append(out, nblocks);
+
+    std::vector<char> zipped;
+    for (size_t start = 0; start < in.size(); start += kMaxBlock) {
+      int rawbytes = std::min(kMaxBlock, in.size() - start);
+      char *src = const_cast<char *>(&in[start]);
+
+      int storedbytes = 0;
+      if (fCompression > 0) {
+        zipped.resize(rawbytes);
+        int srcsize = rawbytes;
+        int tgtsize = rawbytes;
+        R__zip(fCompression, &srcsize, src, &tgtsize, &zipped[0],
+               &storedbytes);
+      }
+
+      // R__zip gives 0 when the block did not shrink, store it raw
+      Append(out, uint32_t(rawbytes));
+      if (storedbytes > 0 && storedbytes < rawbytes) {
+        Append(out, uint32_t(storedbytes));
+        out.insert(out.end(), zipped.begin(), zipped.begin() + storedbytes);
+      } else {
+        Append(out, uint32_t(rawbytes));
+        out.insert(out.end(), src, src + rawbytes);
+      }
+    }
+    return std::vector<double>();
+  }
+
+  std::vector<char> const &GetOutput(int icol) const { return fOut[icol]; }
+
+private:
+  std::vector<std::vector<char> const *> fIn;
+  std::vector<std::vector<char> > fOut;
+  int fCompression;
+};
+} // namespace
+
+size_t GetTypeSize(char type) {
+  switch (type) {
+  case 'F':
+    return sizeof(float);
+  case 'D':
+    return sizeof(double);
+  case 'I':
+    return sizeof(int);
+  case 'O':
+    return sizeof(bool);
+  default:
+    return 0;
+  }
+}
+
+//********************************************************************
+Writer::Writer(std::string const &filename, size_t chunkrows,
+               int compression)
+    : fFileName(filename), fChunkRows(chunkrows ? chunkrows : 1),
+      fCompression(compression), fHeaderWritten(false), fNChunkRows(0),
+      fNRows(0) {
+  //********************************************************************
+
+  fFile = fopen(filename.c_str(), "wb");
+  if (!fFile) {
+    NUIS_ABORT("Cannot open columnar output file " << filename);
+  }
+}
+
+Writer::~Writer() { Close(); }
+
+//********************************************************************
+int Writer::AddColumn(std::string const &name, char type, void const *addr) {
+  //********************************************************************
+  return AddArrayColumn(name, type, addr, -1, 1);
+}
+
+//********************************************************************
+int Writer::AddArrayColumn(std::string const &name, char type,
+                           void const *addr, int countcolumn, int maxcount) {
+  //********************************************************************
+
+  if (fHeaderWritten) {
+    NUIS_ABORT("Cannot add column " << name << " to " << fFileName
+                                    << " after rows have been filled.");
+  }
+  if (!GetTypeSize(type)) {
+    NUIS_ABORT("Unknown type '" << type << "' for column " << name);
+  }
+  if (GetColumnIndex(name) != -1) {
+    NUIS_ABORT("Column " << name << " added twice to " << fFileName);
+  }
+  if (countcolumn >= int(fColumns.size()) ||
+      (countcolumn >= 0 && fColumns[countcolumn].type != 'I')) {
+    NUIS_ABORT("Array column " << name
+                               << " needs an existing int count column.");
+  }
+
+  Column col;
+  col.name = name;
+  col.type = type;
+  col.typesize = GetTypeSize(type);
+  col.addr = addr;
+  col.countcolumn = countcolumn;
+  col.maxcount = maxcount;
+  fColumns.push_back(col);
+  return fColumns.size() - 1;
+}
+
+int Writer::GetColumnIndex(std::string const &name) const {
+  for (size_t i = 0; i < fColumns.size(); i++) {
+    if (fColumns[i].name == name)
+      return i;
+  }
+  return -1;
+}
+
+//********************************************************************
+void Writer::WriteHeader() {
+  //********************************************************************
+
+  std::vector<char> header(kMagic, kMagic + 8);
+  Append(header, uint32_t(fColumns.size()));
+  for (size_t i = 0; i < fColumns.size(); i++) {
+    Column const &col = fColumns[i];
+    Append(header, uint32_t(col.name.size()));
+    header.insert(header.end(), col.name.begin(), col.name.end());
+    Append(header, col.type);
+    Append(header, int32_t(col.countcolumn));
+    Append(header, uint32_t(col.maxcount));
+  }
+  fwrite(&header[0], 1, header.size(), fFile);
+  fHeaderWritten = true;
+}
+
+//********************************************************************
+void Writer::Fill() {
+  //********************************************************************
+
+  if (!fHeaderWritten)
+    WriteHeader();
+
+  for (size_t i = 0; i < fColumns.size(); i++) {
+    Column &col = fColumns[i];
+
+    size_t n = 1;
+    if (col.countcolumn >= 0) {
+      int count = *static_cast<int const *>(fColumns[col.countcolumn].addr);
+      n = std::max(0, std::min(count, col.maxcount));
+    }
+
+    const char *ptr = static_cast<const char *>(col.addr);
+    col.buffer.insert(col.buffer.end(), ptr, ptr + n * col.typesize);
+  }
+
+  fNRows++;
+  if (++fNChunkRows >= fChunkRows)
+    WriteChunk();
+}
+
+//********************************************************************
+void Writer::WriteChunk() {
+  //********************************************************************
+
+  if (!fNChunkRows)
+    return;
+
+  std::vector<std::vector<char> const *> buffers;
+  for (size_t i = 0; i < fColumns.size(); i++) {
+    buffers.push_back(&fColumns[i].buffer);
+  }
+
+  // Columns are compressed independently so can go over the thread pool
+  CompressTask task(buffers, fCompression);
+  ParallelUtils::RunThreads(task, fColumns.size(),
+                            ParallelUtils::GetNWorkers("cores"));
+
+  fChunkOffsets.push_back(ftell(fFile));
+  uint32_t nrows = fNChunkRows;
+  fwrite(&nrows, sizeof(nrows), 1, fFile);
+  for (size_t i = 0; i < fColumns.size(); i++) {
+    std::vector<char> const &out = task.GetOutput(i);
+    fwrite(&out[0], 1, out.size(), fFile);
+    fColumns[i].buffer.clear();
+  }
+
+  fNChunkRows = 0;
+}
+
+//********************************************************************
+void Writer::Close() {
+  //********************************************************************
+
+  if (!fFile)
+    return;
+
+  if (!fHeaderWritten)
+    WriteHeader();
+  WriteChunk();
+
+  uint64_t footer = ftell(fFile);
+  if (!fChunkOffsets.empty()) {
+    fwrite(&fChunkOffsets[0], sizeof(uint64_t), fChunkOffsets.size(), fFile);
+  }
+  uint32_t nchunks = fChunkOffsets.size();
+  fwrite(&nchunks, sizeof(nchunks), 1, fFile);
+  fwrite(&footer, sizeof(footer), 1, fFile);
+  fwrite(kEndMagic, 1, 8, fFile);
+
+  if (fclose(fFile) != 0) {
+    NUIS_ERR(WRN, "Error closing columnar output file " << fFileName);
+  }
+  fFile = NULL;
+
+  NUIS_LOG(SAM, "Saved " << fNRows << " rows of " << fColumns.size()
+                         << " columns to " << fFileName);
+}
+
+//********************************************************************
+Reader::Reader(std::string const &filename) {
+  //********************************************************************
+
+  fFile = fopen(filename.c_str(), "rb");
+  if (!fFile) {
+    NUIS_ABORT("Cannot open columnar file " << filename);
+  }
+
+  char magic[8];
+  uint32_t ncols = 0;
+  if (fread(magic, 1, 8, fFile) != 8 || memcmp(magic, kMagic, 8) ||
+      !Read(fFile, ncols)) {
+    NUIS_ABORT(filename << " is not a NUISANCE columnar file.");
+  }
+
+  for (uint32_t i = 0; i < ncols; i++) {
+    uint32_t namelen;
+    char type;
+    int32_t countcol;
+    uint32_t maxcount;
+    std::string name;
+
+    bool ok = Read(fFile, namelen);
+    if (ok) {
+      name.resize(namelen);
+      ok = !namelen || fread(&name[0], 1, namelen, fFile) == namelen;
+    }
+    if (!ok || !Read(fFile, type) || !Read(fFile, countcol) ||
+        !Read(fFile, maxcount)) {
+      NUIS_ABORT("Corrupted column header in " << filename);
+    }
+
+    fNames.push_back(name);
+    fTypes.push_back(type);
+    fCountColumns.push_back(countcol);
+  }
+
+  // Chunk index is at the end of the file
+  uint32_t nchunks = 0;
+  uint64_t footer = 0;
+  if (fseek(fFile, -int(sizeof(nchunks) + sizeof(footer) + 8), SEEK_END) ||
+      !Read(fFile, nchunks) || !Read(fFile, footer) ||
+      fread(magic, 1, 8, fFile) != 8 || memcmp(magic, kEndMagic, 8)) {
+    NUIS_ABORT(filename << " has no chunk index, was it closed properly?");
+  }
+
+  fChunkOffsets.resize(nchunks);
+  fseek(fFile, footer, SEEK_SET);
+  if (nchunks && fread(&fChunkOffsets[0], sizeof(uint64_t), nchunks,
+                       fFile) != nchunks) {
+    NUIS_ABORT("Corrupted chunk index in " << filename);
+  }
+
+  fChunkRows.resize(nchunks);
+  for (uint32_t i = 0; i < nchunks; i++) {
+    fseek(fFile, fChunkOffsets[i], SEEK_SET);
+    if (!Read(fFile, fChunkRows[i])) {
+      NUIS_ABORT("Corrupted chunk " << i << " in " << filename);
+    }
+  }
+}
+
+Reader::~Reader() {
+  if (fFile)
+    fclose(fFile);
+}
+
+int Reader::GetColumnIndex(std::string const &name) const {
+  for (size_t i = 0; i < fNames.size(); i++) {
+    if (fNames[i] == name)
+      return i;
+  }
+  return -1;
+}
+
+size_t Reader::GetNRows() const {
+  size_t nrows = 0;
+  for (size_t i = 0; i < fChunkRows.size(); i++) {
+    nrows += fChunkRows[i];
+  }
+  return nrows;
+}
+
+//********************************************************************
+size_t Reader::ReadColumn(int ichunk, int icol, std::vector<char> &data) {
+  //********************************************************************
+
+  data.clear();
+  fseek(fFile, fChunkOffsets[ichunk] + sizeof(uint32_t), SEEK_SET);
+
+  std::vector<unsigned char> stored;
+  for (int i = 0; i <= icol; i++) {
+    uint32_t nblocks;
+    if (!Read(fFile, nblocks)) {
+      NUIS_ABORT("Corrupted chunk " << ichunk << " in columnar file.");
+    }
+
+    for (uint32_t b = 0; b < nblocks; b++) {
+      uint32_t rawbytes, storedbytes;
+      if (!Read(fFile, rawbytes) || !Read(fFile, storedbytes)) {
+        NUIS_ABORT("Corrupted chunk " << ichunk << " in columnar file.");
+      }
+
+      // Skip the columns before the one we want
+      if (i < icol) {
+        fseek(fFile, storedbytes, SEEK_CUR);
+        continue;
+      }
+
+      size_t start = data.size();
+      data.resize(start + rawbytes);
+      if (storedbytes == rawbytes) {
+        if (rawbytes && fread(&data[start], 1, rawbytes, fFile) != rawbytes) {
+          NUIS_ABORT("Truncated chunk " << ichunk << " in columnar file.");
+        }
+        continue;
+      }
+
+      stored.resize(storedbytes);
+      if (fread(&stored[0], 1, storedbytes, fFile) != storedbytes) {
+        NUIS_ABORT("Truncated chunk " << ichunk << " in columnar file.");
+      }
+      int srcsize = storedbytes;
+      int tgtsize = rawbytes;
+      int nout = 0;
+      R__unzip(&srcsize, &stored[0], &tgtsize,
+               reinterpret_cast<unsigned char *>(&data[start]), &nout);
+      if (nout != int(rawbytes)) {
+        NUIS_ABORT("Failed to decompress column " << fNames[icol]
+                                                  << " in chunk " << ichunk);
+      }
+    }
+  }
+
+  return fChunkRows[ichunk];
+}
+
+} // namespace ColumnarFile
@@ -0,0 +1,157 @@
+// Copyright 2016-2021 L. Pickering, P Stowell, R. Terri, C. Wilkinson, C. Wret
+
+/*******************************************************************************
+*    This file is part of NUISANCE.
+*
+*    NUISANCE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    NUISANCE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with NUISANCE.  If not, see <http://www.gnu.org/licenses/>.
+*******************************************************************************/
+#ifndef COLUMNARFILE_H_SEEN
+#define COLUMNARFILE_H_SEEN
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <string>
+#include <vector>
+
+/*!
+ *  \addtogroup Utils
+ *  @{
+ */
+
+/// Chunked columnar event files, used by nuisflat when only a selection of
+/// columns is requested.
+///
+/// Rows are buffered per column and written in chunks of N rows. Every
+/// column of a chunk is compressed on its own with ROOT's R__zip, so
+/// readers only have to touch the columns they use. Layout, all integers
+/// in native (little-endian) byte order:
+///
+///   "NUISCOL1"                                          8 byte magic
+///   uint32 ncolumns
+///   per column: uint32 namelen, char name[namelen], char type,
+///               int32 countcolumn, uint32 maxcount
+///   per chunk:  uint32 nrows
+///               per column: uint32 nblocks
+///                           per block: uint32 rawbytes, uint32 storedbytes,
+///                                      char data[storedbytes]
+///   footer:     uint64 chunkoffset[nchunks], uint32 nchunks,
+///               uint64 footeroffset, "NUISCOLE"
+///
+/// Types follow ROOT leaf codes: 'F' float, 'D' double, 'I' int, 'O' bool
+/// (1 byte). Scalar columns have countcolumn -1. Array columns store, for
+/// each row, as many values as the int column countcolumn holds (at most
+/// maxcount). Blocks with storedbytes == rawbytes are uncompressed, others
+/// are R__zip output and can be read with R__unzip.
+namespace ColumnarFile {
+
+/// Size in bytes of one value of the given type, 0 if unknown
+size_t GetTypeSize(char type);
+
+/// Writes rows of bound variables to a columnar file.
+class Writer {
+public:
+  /// Open filename for writing. Rows are flushed every chunkrows rows,
+  /// each column compressed with ROOT compression setting compression
+  /// (algorithm * 100 + level, 0 to store raw).
+  Writer(std::string const &filename, size_t chunkrows = 100000,
+         int compression = 101);
+  ~Writer();
+
+  /// Bind a scalar column to addr. Returns the column index.
+  int AddColumn(std::string const &name, char type, void const *addr);
+
+  /// Bind an array column to addr, its length per row read from the int
+  /// column countcolumn. Returns the column index.
+  int AddArrayColumn(std::string const &name, char type, void const *addr,
+                     int countcolumn, int maxcount);
+
+  /// Index of a named column, -1 if not present
+  int GetColumnIndex(std::string const &name) const;
+
+  /// Append the current values of all bound variables as a new row
+  void Fill();
+
+  /// Flush any buffered rows and write the footer
+  void Close();
+
+  inline size_t GetNRows() const { return fNRows; };
+  inline std::string const &GetFileName() const { return fFileName; };
+
+private:
+  struct Column {
+    std::string name;
+    char type;
+    size_t typesize;
+    void const *addr;
+    int countcolumn;
+    int maxcount;
+    std::vector<char> buffer;
+  };
+
+  void WriteHeader();
+  void WriteChunk();
+
+  std::string fFileName;
+  FILE *fFile;
+  size_t fChunkRows;
+  int fCompression;
+  bool fHeaderWritten;
+
+  std::vector<Column> fColumns;
+  std::vector<uint64_t> fChunkOffsets;
+  size_t fNChunkRows; ///< Rows in the current chunk
+  size_t fNRows;      ///< Rows written in total
+
+  Writer(Writer const &);
+  Writer &operator=(Writer const &);
+};
+
+/// Random access to the chunks of a columnar file.
+class Reader {
+public:
+  explicit Reader(std::string const &filename);
+  ~Reader();
+
+  inline int GetNColumns() const { return fNames.size(); };
+  inline std::string const &GetColumnName(int icol) const {
+    return fNames[icol];
+  };
+  inline char GetColumnType(int icol) const { return fTypes[icol]; };
+  inline int GetCountColumn(int icol) const { return fCountColumns[icol]; };
+  int GetColumnIndex(std::string const &name) const;
+
+  inline int GetNChunks() const { return fChunkOffsets.size(); };
+  size_t GetNRows() const;
+
+  /// Decompress column icol of chunk ichunk into data, which is resized to
+  /// the raw byte count. Returns the number of rows in the chunk.
+  size_t ReadColumn(int ichunk, int icol, std::vector<char> &data);
+
+private:
+  FILE *fFile;
+  std::vector<std::string> fNames;
+  std::vector<char> fTypes;
+  std::vector<int> fCountColumns;
+  std::vector<uint64_t> fChunkOffsets;
+  std::vector<uint32_t> fChunkRows;
+
+  Reader(Reader const &);
+  Reader &operator=(Reader const &);
+};
+
+} // namespace ColumnarFile
+
+/*! @} */
+#endif
@@ -18,6 +18,11 @@
 *******************************************************************************/
 #include "GeneralUtils.h"
 
+#include "TDirectory.h"
+#include "TFile.h"
+
+#include <map>
+
 std::string GeneralUtils::BoolToStr(bool val) {
   std::ostringstream ss;
   ss << val;
@@ -193,3 +198,53 @@ std::string GeneralUtils::ReplaceAll(std::string const& inp,
   }
   return ss.str();
 }
+
+namespace {
+std::map<std::string, TFile *> gCachedFiles;
+pid_t gCachedFilesPID = 0;
+int gCachedFileScopes = 0;
+}
+
+TFile *GeneralUtils::GetCachedFile(std::string const &filename) {
+  // Forked workers share the parent's file offsets, so never reuse its files
+  if (gCachedFilesPID != getpid()) {
+    CloseCachedFiles();
+    gCachedFilesPID = getpid();
+  }
+
+  std::map<std::string, TFile *>::iterator it = gCachedFiles.find(filename);
+  if (it != gCachedFiles.end()) {
+    return it->second;
+  }
+
+  // Opening a file makes it the current directory, keep the caller's
+  TDirectory *olddir = gDirectory;
+  TFile *file = new TFile(filename.c_str(), "READ");
+  if (olddir) {
+    olddir->cd();
+  }
+
+  if (!file || file->IsZombie()) {
+    NUIS_ABORT("Couldn't open root file: \"" << filename << "\".");
+  }
+
+  gCachedFiles[filename] = file;
+  return file;
+}
+
+void GeneralUtils::CloseCachedFiles() {
+  for (std::map<std::string, TFile *>::iterator it = gCachedFiles.begin();
+       it != gCachedFiles.end(); ++it) {
+    it->second->Close();
+    delete it->second;
+  }
+  gCachedFiles.clear();
+}
+
+GeneralUtils::CachedFileScope::CachedFileScope() { gCachedFileScopes++; }
+
+GeneralUtils::CachedFileScope::~CachedFileScope() {
+  if (!--gCachedFileScopes) {
+    CloseCachedFiles();
+  }
+}
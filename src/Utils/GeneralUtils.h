@@ -33,6 +33,8 @@
 #include <vector>
 #include "FitLogger.h"
 
+class TFile;
+
 /*!
  *  \addtogroup Utils
  *  @{
@@ -129,6 +131,25 @@ size_t IsSmallNum(T const& d) {
 std::string ReplaceAll(std::string const &inp, std::string const &from,
                     std::string const &to);
 
+/// Open a ROOT file for reading through a shared cache, so a data release
+/// holding many histograms and covariances is only opened once. The file is
+/// owned by the cache and must not be closed by the caller. Aborts if the
+/// file cannot be opened.
+TFile *GetCachedFile(std::string const &filename);
+
+/// Close every file opened through GetCachedFile. Objects read from them
+/// without being cloned or detached are deleted with the files.
+void CloseCachedFiles();
+
+/// Keeps the files opened through GetCachedFile open until the outermost
+/// scope ends, then closes them. Sample creation opens one, so loading
+/// several samples inside an outer scope opens each file only once.
+class CachedFileScope {
+public:
+  CachedFileScope();
+  ~CachedFileScope();
+};
+
 }
 
 /*! @} */
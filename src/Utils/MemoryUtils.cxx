@@ -0,0 +1,257 @@
+// Copyright 2016-2021 L. Pickering, P Stowell, R. Terri, C. Wilkinson, C. Wret
+
+/*******************************************************************************
+*    This file is part of NUISANCE.
+*
+*    NUISANCE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    NUISANCE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with NUISANCE.  If not, see <http://www.gnu.org/licenses/>.
+*******************************************************************************/
+#include "MemoryUtils.h"
+
+#include "FitLogger.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <sstream>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace MemoryUtils {
+
+namespace {
+double gBudget = 0.0;
+std::map<std::pair<int, std::string>, double> gUsage;
+std::mutex gUsageMutex;
+
+// Floats staged in memory before being streamed to a spill file
+const size_t kStagingSize = 1 << 22;
+
+bool WriteAll(int fd, const void *buf, size_t size) {
+  const char *ptr = static_cast<const char *>(buf);
+  while (size > 0) {
+    ssize_t n = write(fd, ptr, size);
+    if (n < 0 && errno == EINTR)
+      continue;
+    if (n <= 0)
+      return false;
+    ptr += n;
+    size -= n;
+  }
+  return true;
+}
+
+std::string FormatMB(double bytes) {
+  std::ostringstream out;
+  out << std::fixed << std::setprecision(1) << bytes * 1E-6;
+  return out.str();
+}
+} // namespace
+
+void SetBudget(double bytes) { gBudget = bytes; }
+
+double GetBudget() { return gBudget; }
+
+std::string CategoryName(int category) {
+  switch (category) {
+  case kSignalFlags:
+    return "SignalFlags";
+  case kSignalBoxes:
+    return "SignalBoxes";
+  case kSplineCoeffs:
+    return "SplineCoeffs";
+  case kWeightResponses:
+    return "WeightResps";
+  case kDiskCache:
+    return "DiskCache";
+  default:
+    return "Unknown";
+  }
+}
+
+void SetUsage(int category, std::string const &owner, double bytes) {
+  std::lock_guard<std::mutex> lock(gUsageMutex);
+  gUsage[std::make_pair(category, owner)] = bytes;
+}
+
+void ClearCategory(int category) {
+  std::lock_guard<std::mutex> lock(gUsageMutex);
+  std::map<std::pair<int, std::string>, double>::iterator it = gUsage.begin();
+  while (it != gUsage.end()) {
+    if (it->first.first == category)
+      gUsage.erase(it++);
+    else
+      ++it;
+  }
+}
+
+double GetUsage() {
+  std::lock_guard<std::mutex> lock(gUsageMutex);
+  double total = 0.0;
+  std::map<std::pair<int, std::string>, double>::const_iterator it;
+  for (it = gUsage.begin(); it != gUsage.end(); ++it) {
+    if (it->first.first != kDiskCache)
+      total += it->second;
+  }
+  return total;
+}
+
+bool Fits(double extra) {
+  return (gBudget <= 0.0) || (GetUsage() + extra <= gBudget);
+}
+
+double GetResidentMemory() {
+  std::ifstream statm("/proc/self/statm");
+  double pages = 0.0, resident = 0.0;
+  if (!(statm >> pages >> resident))
+    return 0.0;
+  return resident * sysconf(_SC_PAGESIZE);
+}
+
+void PrintSummary() {
+  if (gUsage.empty())
+    return;
+
+  size_t ownerwidth = 10;
+  std::map<std::pair<int, std::string>, double>::const_iterator it;
+  for (it = gUsage.begin(); it != gUsage.end(); ++it) {
+    ownerwidth = std::max(ownerwidth, it->first.second.size());
+  }
+
+  NUIS_LOG(FIT, "------------");
+  NUIS_LOG(FIT, "Memory Report");
+  NUIS_LOG(FIT, std::left << std::setw(14) << "Category"
+                          << " " << std::setw(ownerwidth) << "Owner"
+                          << " " << std::right << std::setw(12) << "Size [MB]");
+  for (it = gUsage.begin(); it != gUsage.end(); ++it) {
+    if (it->second <= 0.0)
+      continue;
+    NUIS_LOG(FIT, std::left << std::setw(14) << CategoryName(it->first.first)
+                            << " " << std::setw(ownerwidth) << it->first.second
+                            << " " << std::right << std::setw(12)
+                            << FormatMB(it->second));
+  }
+  NUIS_LOG(FIT, "Cached total : " << FormatMB(GetUsage()) << " MB, budget : "
+                                  << (gBudget > 0.0 ? FormatMB(gBudget)
+                                                    : std::string("none"))
+                                  << ", resident : "
+                                  << FormatMB(GetResidentMemory()) << " MB");
+  NUIS_LOG(FIT, "------------");
+}
+
+FloatRows::FloatRows()
+    : fOffsets(1, 0), fFD(-1), fNOnDisk(0), fMap(NULL), fMapSize(0) {}
+
+FloatRows::~FloatRows() { Clear(); }
+
+void FloatRows::Clear() {
+  Unmap();
+  if (fFD >= 0)
+    close(fFD);
+  fFD = -1;
+  fNOnDisk = 0;
+  std::vector<float>().swap(fBuffer);
+  std::vector<size_t>(1, 0).swap(fOffsets);
+}
+
+void FloatRows::Push(const float *vals, size_t n) {
+  fBuffer.insert(fBuffer.end(), vals, vals + n);
+  fOffsets.push_back(fOffsets.back() + n);
+
+  if (IsSpilled() && fBuffer.size() >= kStagingSize)
+    Flush();
+}
+
+void FloatRows::Finalise() {
+  if (!IsSpilled())
+    return;
+
+  Flush();
+  Unmap();
+  if (!fNOnDisk)
+    return;
+
+  // Private mapping so callers holding non-const row pointers can never
+  // write back to the file.
+  fMapSize = fNOnDisk * sizeof(float);
+  void *map = mmap(NULL, fMapSize, PROT_READ | PROT_WRITE, MAP_PRIVATE, fFD, 0);
+  if (map == MAP_FAILED) {
+    NUIS_ABORT("Failed to map " << fMapSize << " bytes of spilled cache.");
+  }
+  fMap = static_cast<float *>(map);
+}
+
+bool FloatRows::Spill(std::string const &dir) {
+  if (IsSpilled())
+    return true;
+
+  std::string spilldir = dir;
+  if (spilldir.empty())
+    spilldir = getenv("TMPDIR") ? getenv("TMPDIR") : "/tmp";
+
+  std::string path = spilldir + "/nuisance_cache_XXXXXX";
+  std::vector<char> name(path.begin(), path.end());
+  name.push_back('\0');
+
+  int fd = mkstemp(&name[0]);
+  if (fd < 0) {
+    NUIS_ERR(WRN, "Cannot create cache spill file in " << spilldir);
+    return false;
+  }
+  // The file lives until the descriptor is closed
+  unlink(&name[0]);
+
+  if (!fBuffer.empty() &&
+      !WriteAll(fd, &fBuffer[0], fBuffer.size() * sizeof(float))) {
+    NUIS_ERR(WRN, "Failed to write cache spill file in " << spilldir);
+    close(fd);
+    return false;
+  }
+
+  fFD = fd;
+  fNOnDisk = fBuffer.size();
+  std::vector<float>().swap(fBuffer);
+  return true;
+}
+
+size_t FloatRows::GetMemoryBytes() const {
+  return fBuffer.capacity() * sizeof(float) +
+         fOffsets.capacity() * sizeof(size_t);
+}
+
+size_t FloatRows::GetDiskBytes() const { return fNOnDisk * sizeof(float); }
+
+void FloatRows::Flush() {
+  if (fBuffer.empty())
+    return;
+  if (!WriteAll(fFD, &fBuffer[0], fBuffer.size() * sizeof(float))) {
+    NUIS_ABORT("Failed to write to cache spill file.");
+  }
+  fNOnDisk += fBuffer.size();
+  fBuffer.clear();
+}
+
+void FloatRows::Unmap() {
+  if (fMap)
+    munmap(fMap, fMapSize);
+  fMap = NULL;
+  fMapSize = 0;
+}
+
+} // namespace MemoryUtils
@@ -0,0 +1,132 @@
+// Copyright 2016-2021 L. Pickering, P Stowell, R. Terri, C. Wilkinson, C. Wret
+
+/*******************************************************************************
+*    This file is part of NUISANCE.
+*
+*    NUISANCE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    NUISANCE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with NUISANCE.  If not, see <http://www.gnu.org/licenses/>.
+*******************************************************************************/
+#ifndef MEMORYUTILS_H_SEEN
+#define MEMORYUTILS_H_SEEN
+
+#include <string>
+#include <vector>
+
+#include <stddef.h>
+
+/*!
+ *  \addtogroup Utils
+ *  @{
+ */
+
+/// Bookkeeping for the large in-memory caches kept during a fit. Owners
+/// (inputs, samples) report their current footprint per category, and
+/// cache builders check it against the configured budget (MemoryBudget in
+/// MB, 0 for no limit) to decide whether to keep, spill or drop a cache.
+namespace MemoryUtils {
+
+/// Kinds of cached data that are accounted separately.
+enum MemoryCategory {
+  kSignalFlags = 0, ///< Per event signal flags for each input
+  kSignalBoxes,     ///< Cloned signal variable boxes for each sample
+  kSplineCoeffs,    ///< Cached spline coefficients held in memory
+  kWeightResponses, ///< Cached dial independent weight engine responses
+  kDiskCache,       ///< Data spilled to disk, not counted in the budget
+  kNMemoryCategories
+};
+
+/// Set the budget in bytes. <= 0 disables the budget.
+void SetBudget(double bytes);
+
+/// Budget in bytes, <= 0 if unlimited.
+double GetBudget();
+
+/// Human readable name of a memory category
+std::string CategoryName(int category);
+
+/// Set the current footprint of an owner in a category, replacing any
+/// previous value. Safe to call from reweighting threads.
+void SetUsage(int category, std::string const &owner, double bytes);
+
+/// Remove all accounting for a category
+void ClearCategory(int category);
+
+/// Total accounted bytes, excluding anything spilled to disk
+double GetUsage();
+
+/// Whether extra bytes on top of the current usage still fit the budget
+bool Fits(double extra = 0.0);
+
+/// Resident set size of this process in bytes, 0 if unknown
+double GetResidentMemory();
+
+/// Print the per owner footprint table with totals and budget
+void PrintSummary();
+
+/// Append-only store of variable length float rows, e.g. per event spline
+/// coefficients. Rows share one contiguous buffer that can be spilled to a
+/// file in a local directory and memory mapped, so the kernel only keeps
+/// the pages that are in use. Rows pushed after a spill are streamed to the
+/// file and become readable once Finalise is called.
+class FloatRows {
+public:
+  FloatRows();
+  ~FloatRows();
+
+  /// Drop all rows and any spill file
+  void Clear();
+
+  /// Append one row
+  void Push(const float *vals, size_t n);
+
+  /// Make all rows readable. Must be called after the last Push.
+  void Finalise();
+
+  /// Move the data to a file in dir. Returns false (and keeps the rows in
+  /// memory) if the file cannot be written.
+  bool Spill(std::string const &dir);
+
+  inline size_t GetNRows() const { return fOffsets.size() - 1; };
+  inline bool Empty() const { return GetNRows() == 0; };
+  inline bool IsSpilled() const { return fFD >= 0; };
+
+  /// Pointer to row i. Only valid after Finalise when spilled.
+  inline float *GetRow(size_t i) {
+    return (fMap ? fMap : &fBuffer[0]) + fOffsets[i];
+  };
+
+  /// Bytes of row data held in memory
+  size_t GetMemoryBytes() const;
+
+  /// Bytes of row data held on disk
+  size_t GetDiskBytes() const;
+
+private:
+  void Flush();
+  void Unmap();
+
+  std::vector<float> fBuffer;    ///< In memory rows, or staging once spilled
+  std::vector<size_t> fOffsets;  ///< Start of each row, plus the end
+  int fFD;                       ///< Spill file descriptor, -1 if in memory
+  size_t fNOnDisk;               ///< Floats written to the spill file
+  float *fMap;                   ///< Mapped spill file after Finalise
+  size_t fMapSize;               ///< Mapped size in bytes
+
+  FloatRows(FloatRows const &);
+  FloatRows &operator=(FloatRows const &);
+};
+
+} // namespace MemoryUtils
+
+/*! @} */
+#endif
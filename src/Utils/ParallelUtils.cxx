@@ -0,0 +1,243 @@
+// Copyright 2016-2021 L. Pickering, P Stowell, R. Terri, C. Wilkinson, C. Wret
+
+/*******************************************************************************
+*    This file is part of NUISANCE.
+*
+*    NUISANCE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    NUISANCE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with NUISANCE.  If not, see <http://www.gnu.org/licenses/>.
+*******************************************************************************/
+#include "ParallelUtils.h"
+
+#include "FitLogger.h"
+#include "NuisConfig.h"
+
+#include "RVersion.h"
+#include "TDirectory.h"
+#include "TROOT.h"
+
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <iostream>
+#include <thread>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace ParallelUtils {
+
+namespace {
+// Write the full buffer, retrying on short writes. Returns false on error.
+bool WriteAll(int fd, const void *buf, size_t size) {
+  const char *ptr = static_cast<const char *>(buf);
+  while (size > 0) {
+    ssize_t n = write(fd, ptr, size);
+    if (n < 0 && errno == EINTR)
+      continue;
+    if (n <= 0)
+      return false;
+    ptr += n;
+    size -= n;
+  }
+  return true;
+}
+
+// Read exactly size bytes. Returns false on EOF or error.
+bool ReadAll(int fd, void *buf, size_t size) {
+  char *ptr = static_cast<char *>(buf);
+  while (size > 0) {
+    ssize_t n = read(fd, ptr, size);
+    if (n < 0 && errno == EINTR)
+      continue;
+    if (n <= 0)
+      return false;
+    ptr += n;
+    size -= n;
+  }
+  return true;
+}
+
+// Worker body: run every nworkers'th task and stream results to fd.
+void RunWorker(Task &task, int ntasks, int iworker, int nworkers, int fd) {
+  for (int i = iworker; i < ntasks; i += nworkers) {
+    std::vector<double> res = task.Run(i);
+    int header[2] = {i, int(res.size())};
+    if (!WriteAll(fd, header, sizeof(header)))
+      _exit(1);
+    if (!res.empty() && !WriteAll(fd, &res[0], res.size() * sizeof(double)))
+      _exit(1);
+  }
+}
+
+// Thread body: pull task indices until none are left. Tasks can have very
+// different costs so they are handed out dynamically rather than strided.
+void RunThread(Task &task, int ntasks, std::atomic<int> &next,
+               std::vector<std::vector<double> > &results) {
+  // gDirectory is thread local once thread safety is enabled, clear it so
+  // histograms made by the tasks are not appended to a shared list.
+  gDirectory = NULL;
+
+  for (int i = next++; i < ntasks; i = next++) {
+    results[i] = task.Run(i);
+  }
+}
+} // namespace
+
+int GetNWorkers(std::string const &key) {
+  int nworkers = Config::GetParI(key);
+  return nworkers < 1 ? 1 : nworkers;
+}
+
+std::vector<std::vector<double> > RunTasks(Task &task, int ntasks,
+                                           int nworkers) {
+  std::vector<std::vector<double> > results(ntasks);
+  if (nworkers > ntasks)
+    nworkers = ntasks;
+
+  if (nworkers <= 1) {
+    for (int i = 0; i < ntasks; i++) {
+      results[i] = task.Run(i);
+    }
+    return results;
+  }
+
+  // Anything still buffered would otherwise be printed once per worker
+  std::cout.flush();
+  std::cerr.flush();
+  fflush(NULL);
+
+  std::vector<pid_t> pids(nworkers, -1);
+  std::vector<int> fds(nworkers, -1);
+
+  for (int iw = 0; iw < nworkers; iw++) {
+    int pipefd[2];
+    if (pipe(pipefd) != 0) {
+      NUIS_ABORT("Failed to create pipe for parallel worker " << iw);
+    }
+
+    pid_t pid = fork();
+    if (pid < 0) {
+      NUIS_ABORT("Failed to fork parallel worker " << iw);
+    }
+
+    if (pid == 0) {
+      close(pipefd[0]);
+      for (int j = 0; j < iw; j++) {
+        close(fds[j]);
+      }
+      RunWorker(task, ntasks, iw, nworkers, pipefd[1]);
+      close(pipefd[1]);
+      // Skip destructors and atexit handlers, they belong to the parent
+      _exit(0);
+    }
+
+    close(pipefd[1]);
+    pids[iw] = pid;
+    fds[iw] = pipefd[0];
+  }
+
+  // Workers only ever block on their own pipe, so draining them one at a
+  // time cannot deadlock.
+  std::vector<bool> done(ntasks, false);
+  for (int iw = 0; iw < nworkers; iw++) {
+    int header[2];
+    while (ReadAll(fds[iw], header, sizeof(header))) {
+      int itask = header[0];
+      int nvals = header[1];
+      if (itask < 0 || itask >= ntasks || nvals < 0) {
+        NUIS_ABORT("Corrupt result from parallel worker " << iw);
+      }
+      results[itask].resize(nvals);
+      if (nvals && !ReadAll(fds[iw], &results[itask][0],
+                            nvals * sizeof(double))) {
+        NUIS_ABORT("Truncated result from parallel worker " << iw);
+      }
+      done[itask] = true;
+    }
+    close(fds[iw]);
+  }
+
+  bool failed = false;
+  for (int iw = 0; iw < nworkers; iw++) {
+    int status = 0;
+    while (waitpid(pids[iw], &status, 0) < 0 && errno == EINTR) {
+    }
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+      NUIS_ERR(FTL, "Parallel worker " << iw << " (pid " << pids[iw]
+                                       << ") did not exit cleanly.");
+      failed = true;
+    }
+  }
+
+  for (int i = 0; i < ntasks && !failed; i++) {
+    if (!done[i]) {
+      NUIS_ERR(FTL, "No result returned for parallel task " << i);
+      failed = true;
+    }
+  }
+
+  if (failed) {
+    NUIS_ABORT("Parallel task run failed.");
+  }
+
+  return results;
+}
+
+namespace {
+bool gThreadsEnabled = false;
+} // namespace
+
+void EnableThreads() {
+  if (gThreadsEnabled)
+    return;
+
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6, 6, 0)
+  ROOT::EnableThreadSafety();
+  gThreadsEnabled = true;
+#else
+  NUIS_ERR(WRN, "ROOT is too old to be thread aware, threaded stages will "
+                "run serially.");
+#endif
+}
+
+std::vector<std::vector<double> > RunThreads(Task &task, int ntasks,
+                                             int nthreads) {
+  std::vector<std::vector<double> > results(ntasks);
+  if (nthreads > ntasks)
+    nthreads = ntasks;
+
+  // Threads are only safe once EnableThreads has run at startup
+  if (!gThreadsEnabled)
+    nthreads = 1;
+
+  if (nthreads <= 1) {
+    for (int i = 0; i < ntasks; i++) {
+      results[i] = task.Run(i);
+    }
+    return results;
+  }
+
+  std::atomic<int> next(0);
+  std::vector<std::thread> threads;
+  for (int it = 0; it < nthreads; it++) {
+    threads.push_back(std::thread(RunThread, std::ref(task), ntasks,
+                                  std::ref(next), std::ref(results)));
+  }
+  for (int it = 0; it < nthreads; it++) {
+    threads[it].join();
+  }
+
+  return results;
+}
+
+} // namespace ParallelUtils
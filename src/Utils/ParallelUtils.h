@@ -0,0 +1,78 @@
+// Copyright 2016-2021 L. Pickering, P Stowell, R. Terri, C. Wilkinson, C. Wret
+
+/*******************************************************************************
+*    This file is part of NUISANCE.
+*
+*    NUISANCE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    NUISANCE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with NUISANCE.  If not, see <http://www.gnu.org/licenses/>.
+*******************************************************************************/
+#ifndef PARALLELUTILS_H_SEEN
+#define PARALLELUTILS_H_SEEN
+
+#include <string>
+#include <vector>
+
+/*!
+ *  \addtogroup Utils
+ *  @{
+ */
+
+/// Worker pools for embarrassingly parallel jobs.
+///
+/// Most of the fit state (FitWeight, Config, the samples) lives in global
+/// singletons, so RunTasks uses fork()ed copies of the current process
+/// instead of threads. Workers can freely change that state while running
+/// their tasks, the parent never sees those changes. Only the vector of
+/// doubles returned by each task is sent back over a pipe.
+///
+/// RunThreads is for the few stages where every task only works on objects
+/// it owns, and the results have to stay in this process.
+namespace ParallelUtils {
+
+/// A set of independent tasks indexed 0..N-1.
+class Task {
+public:
+  virtual ~Task(){};
+
+  /// Run task itask and return its result. Called inside a worker process,
+  /// or in the current process when running serially.
+  virtual std::vector<double> Run(int itask) = 0;
+};
+
+/// Number of workers requested by the given config key (minimum 1).
+int GetNWorkers(std::string const &key = "cores");
+
+/// Run ntasks tasks over up to nworkers forked processes and return the
+/// results in task order. With nworkers <= 1 (or a single task) the tasks
+/// run serially in this process, so any state they change is NOT restored.
+std::vector<std::vector<double> > RunTasks(Task &task, int ntasks,
+                                           int nworkers);
+
+/// Make ROOT thread aware. Must be called once at startup, before any
+/// thread is started, by whoever intends to use RunThreads.
+void EnableThreads();
+
+/// Run ntasks tasks over up to nthreads threads inside this process and
+/// return the results in task order. Unlike RunTasks the tasks share this
+/// process, so each task must only touch state it owns (e.g. one sample's
+/// histograms) and must not read the global config. ROOT objects created
+/// by a task are not attached to any directory. Falls back to running
+/// serially for nthreads <= 1, when ROOT is not thread aware or when
+/// EnableThreads was not called.
+std::vector<std::vector<double> > RunThreads(Task &task, int ntasks,
+                                             int nthreads);
+
+} // namespace ParallelUtils
+
+/*! @} */
+#endif
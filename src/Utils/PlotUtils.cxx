@@ -461,7 +461,7 @@ void PlotUtils::FluxUnfoldedScaling(TH1D *mcHist, TH1D *fhist, TH1D *ehist,
   TH1D *fFluxHist = (TH1D *)fhist->Clone();
 
   std::string name = std::string(mcHist->GetName());
-  if (FitPar::Config().GetParB("save_flux_debug")) {
+  if (StatUtils::GetOptions().SaveFluxDebug) {
 
     mcHist->Write((name + "_UNF_MC").c_str());
     fFluxHist->Write((name + "_UNF_FLUX").c_str());
@@ -520,7 +520,7 @@ void PlotUtils::FluxUnfoldedScaling(TH1D *mcHist, TH1D *fhist, TH1D *ehist,
     pdfflux->SetBinContent(i + 1, fluxint);
   }
 
-  if (FitPar::Config().GetParB("save_flux_debug")) {
+  if (StatUtils::GetOptions().SaveFluxDebug) {
     pdfflux->Write((name + "_UNF_SCALEHIST").c_str());
   }
 
@@ -571,13 +571,10 @@ TH1D *PlotUtils::GetTH1DFromFile(std::string dataFile, std::string title,
 
   // If format is a root file
   if (dataFile.find(".root") != std::string::npos) {
-    TFile *temp_infile = new TFile(dataFile.c_str(), "READ");
+    TFile *temp_infile = GeneralUtils::GetCachedFile(dataFile);
     tempPlot = (TH1D *)temp_infile->Get(title.c_str());
     tempPlot->SetDirectory(0);
 
-    temp_infile->Close();
-    delete temp_infile;
-
     // Else its a space separated txt file
   } else {
     // Make a TGraph Errors
@@ -742,15 +739,14 @@ TH1D *PlotUtils::GetTH1DFromRootFile(std::string file, std::string name) {
     name = tempfile[1];
   }
 
-  TFile *rootHistFile = new TFile(file.c_str(), "READ");
-  TH1D *tempHist = (TH1D *)rootHistFile->Get(name.c_str())->Clone();
-  if (tempHist == NULL) {
+  TFile *rootHistFile = GeneralUtils::GetCachedFile(file);
+  TObject *obj = rootHistFile->Get(name.c_str());
+  if (obj == NULL) {
     NUIS_ABORT("Could not find distribution " << name << " in file " << file);
   }
+  TH1D *tempHist = (TH1D *)obj->Clone();
   tempHist->SetDirectory(0);
 
-  rootHistFile->Close();
-
   return tempHist;
 }
 
@@ -761,13 +757,10 @@ TH2D *PlotUtils::GetTH2DFromRootFile(std::string file, std::string name) {
     name = tempfile[1];
   }
 
-  TFile *rootHistFile = new TFile(file.c_str(), "READ");
+  TFile *rootHistFile = GeneralUtils::GetCachedFile(file);
   TH2D *tempHist = (TH2D *)rootHistFile->Get(name.c_str())->Clone();
   tempHist->SetDirectory(0);
 
-  rootHistFile->Close();
-  delete rootHistFile;
-
   return tempHist;
 }
 
@@ -778,10 +771,7 @@ TH1 *PlotUtils::GetTH1FromRootFile(std::string file, std::string name) {
     name = tempfile[1];
   }
 
-  TFile *rootHistFile = new TFile(file.c_str(), "READ");
-  if (!rootHistFile || rootHistFile->IsZombie()) {
-    NUIS_ABORT("Couldn't open root file: \"" << file << "\".");
-  }
+  TFile *rootHistFile = GeneralUtils::GetCachedFile(file);
   TH1 *tempHist = dynamic_cast<TH1 *>(rootHistFile->Get(name.c_str())->Clone());
   if (!tempHist) {
     NUIS_ABORT("Couldn't retrieve: \"" << name << "\" from root file: \""
@@ -789,9 +779,6 @@ TH1 *PlotUtils::GetTH1FromRootFile(std::string file, std::string name) {
   }
   tempHist->SetDirectory(0);
 
-  rootHistFile->Close();
-  delete rootHistFile;
-
   return tempHist;
 }
 
@@ -802,24 +789,15 @@ TGraph *PlotUtils::GetTGraphFromRootFile(std::string file, std::string name) {
     name = tempfile[1];
   }
 
-  TDirectory *olddir = gDirectory;
-
-  TFile *rootHistFile = new TFile(file.c_str(), "READ");
-  if (!rootHistFile || rootHistFile->IsZombie()) {
-    NUIS_ABORT("Couldn't open root file: \"" << file << "\".");
-  }
-  TDirectory *newdir = gDirectory;
-
+  TFile *rootHistFile = GeneralUtils::GetCachedFile(file);
   TGraph *temp =
       dynamic_cast<TGraph *>(rootHistFile->Get(name.c_str())->Clone());
   if (!temp) {
     NUIS_ABORT("Couldn't retrieve: \"" << name << "\" from root file: \""
                                        << file << "\".");
   }
-  newdir->Remove(temp);
-  olddir->Append(temp);
-  rootHistFile->Close();
-  olddir->cd();
+  // Owned by the caller's directory as before
+  gDirectory->Append(temp);
   return temp;
 }
 
@@ -854,10 +832,7 @@ PlotUtils::GetTH1sFromRootFile(std::string const &descriptor) {
           << fname[1] << "\". Expected hist1|hist2|...");
     }
 
-    TFile *rootHistFile = new TFile(fname[0].c_str(), "READ");
-    if (!rootHistFile || rootHistFile->IsZombie()) {
-      NUIS_ABORT("Couldn't open root file: \"" << fname[0] << "\".");
-    }
+    TFile *rootHistFile = GeneralUtils::GetCachedFile(fname[0]);
 
     for (size_t i = 0; i < histnames.size(); ++i) {
       TH1 *tempHist =
@@ -870,7 +845,6 @@ PlotUtils::GetTH1sFromRootFile(std::string const &descriptor) {
       tempHist->SetDirectory(0);
       hists.push_back(tempHist);
     }
-    rootHistFile->Close();
   }
 
   return hists;
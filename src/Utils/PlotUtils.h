@@ -179,7 +179,7 @@ inline TH* GetTH2FromRootFile(std::string file, std::string name){
     name = tempfile[1];
   }
 
-  TFile *rootHistFile = new TFile(file.c_str(), "READ");
+  TFile *rootHistFile = GeneralUtils::GetCachedFile(file);
   TH *tempHist = dynamic_cast<TH *>(rootHistFile->Get(name.c_str())->Clone());
 
   if(!tempHist){
@@ -188,9 +188,6 @@ inline TH* GetTH2FromRootFile(std::string file, std::string name){
 
   tempHist->SetDirectory(nullptr);
 
-  rootHistFile->Close();
-  delete rootHistFile;
-
   return tempHist;
 }
 
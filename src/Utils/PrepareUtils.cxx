@@ -0,0 +1,352 @@
+// Copyright 2016-2021 L. Pickering, P Stowell, R. Terri, C. Wilkinson, C. Wret
+
+/*******************************************************************************
+*    This file is part of NUISANCE.
+*
+*    NUISANCE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    NUISANCE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with NUISANCE.  If not, see <http://www.gnu.org/licenses/>.
+*******************************************************************************/
+#include "PrepareUtils.h"
+
+#include "FitLogger.h"
+#include "ParallelUtils.h"
+
+#include "TChain.h"
+#include "TFile.h"
+#include "TObjString.h"
+#include "TString.h"
+#include "TSystem.h"
+#include "TTree.h"
+#include "TVectorD.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+
+#include <unistd.h>
+
+namespace PrepareUtils {
+
+//********************************************************************
+PartialHists::PartialHists(TH1D const *templ) {
+  //********************************************************************
+  fTemplate = static_cast<TH1D *>(templ->Clone());
+  fTemplate->SetDirectory(NULL);
+  fTemplate->Reset();
+}
+
+//********************************************************************
+PartialHists::~PartialHists() {
+  //********************************************************************
+  for (std::map<std::string, TH1D *>::iterator it = fHists.begin();
+       it != fHists.end(); ++it) {
+    delete it->second;
+  }
+  delete fTemplate;
+}
+
+//********************************************************************
+TH1D *PartialHists::Get(std::string const &name) {
+  //********************************************************************
+  return Book(name, fTemplate);
+}
+
+//********************************************************************
+TH1D *PartialHists::Book(std::string const &name, TH1D const *templ) {
+  //********************************************************************
+  std::map<std::string, TH1D *>::iterator it = fHists.find(name);
+  if (it != fHists.end())
+    return it->second;
+
+  TH1D *hist = static_cast<TH1D *>(templ->Clone());
+  hist->SetDirectory(NULL);
+  hist->Reset();
+  fNames.push_back(name);
+  fHists[name] = hist;
+  return hist;
+}
+
+//********************************************************************
+bool PartialHists::Has(std::string const &name) const {
+  //********************************************************************
+  return fHists.count(name);
+}
+
+//********************************************************************
+void PartialHists::AddSum(std::string const &name, double val) {
+  //********************************************************************
+  std::map<std::string, double>::iterator it = fSums.find(name);
+  if (it == fSums.end()) {
+    fSumNames.push_back(name);
+    fSums[name] = val;
+  } else {
+    it->second += val;
+  }
+}
+
+//********************************************************************
+double PartialHists::GetSum(std::string const &name) const {
+  //********************************************************************
+  std::map<std::string, double>::const_iterator it = fSums.find(name);
+  return (it == fSums.end()) ? 0.0 : it->second;
+}
+
+//********************************************************************
+void PartialHists::Add(PartialHists const &other) {
+  //********************************************************************
+  for (size_t i = 0; i < other.fNames.size(); ++i) {
+    TH1D const *hist = other.fHists.find(other.fNames[i])->second;
+    Book(other.fNames[i], hist)->Add(hist);
+  }
+  for (size_t i = 0; i < other.fSumNames.size(); ++i) {
+    AddSum(other.fSumNames[i], other.GetSum(other.fSumNames[i]));
+  }
+}
+
+namespace {
+// Mode names contain ';' and '/' so histograms are stored as h0, h1, ...
+// with the names kept in a newline separated list.
+std::string JoinNames(std::vector<std::string> const &names) {
+  std::string joined;
+  for (size_t i = 0; i < names.size(); ++i) {
+    joined += names[i] + "\n";
+  }
+  return joined;
+}
+
+std::vector<std::string> SplitNames(TObjString const *joined) {
+  std::vector<std::string> names;
+  if (!joined)
+    return names;
+  std::stringstream ss(joined->GetString().Data());
+  std::string name;
+  while (std::getline(ss, name)) {
+    names.push_back(name);
+  }
+  return names;
+}
+} // namespace
+
+//********************************************************************
+void PartialHists::Write(std::string const &filename) const {
+  //********************************************************************
+  TFile outfile(filename.c_str(), "RECREATE");
+  if (outfile.IsZombie()) {
+    NUIS_ABORT("Cannot write partial histograms to " << filename);
+  }
+  outfile.cd();
+
+  TObjString names(JoinNames(fNames).c_str());
+  names.Write("names");
+  for (size_t i = 0; i < fNames.size(); ++i) {
+    fHists.find(fNames[i])->second->Write(Form("h%d", int(i)));
+  }
+
+  TObjString sumnames(JoinNames(fSumNames).c_str());
+  sumnames.Write("sumnames");
+  TVectorD sums(fSumNames.size());
+  for (size_t i = 0; i < fSumNames.size(); ++i) {
+    sums[i] = GetSum(fSumNames[i]);
+  }
+  sums.Write("sums");
+
+  outfile.Close();
+}
+
+//********************************************************************
+void PartialHists::Read(std::string const &filename) {
+  //********************************************************************
+  // Adds to any existing contents, so parts can be read one after another
+  TFile infile(filename.c_str(), "READ");
+  if (infile.IsZombie()) {
+    NUIS_ABORT("Cannot read partial histograms from " << filename);
+  }
+
+  std::vector<std::string> names =
+      SplitNames(dynamic_cast<TObjString *>(infile.Get("names")));
+  for (size_t i = 0; i < names.size(); ++i) {
+    TH1D *hist = dynamic_cast<TH1D *>(infile.Get(Form("h%d", int(i))));
+    if (!hist) {
+      NUIS_ABORT("Missing histogram " << names[i] << " in " << filename);
+    }
+    Book(names[i], hist)->Add(hist);
+  }
+
+  std::vector<std::string> sumnames =
+      SplitNames(dynamic_cast<TObjString *>(infile.Get("sumnames")));
+  TVectorD *sums = dynamic_cast<TVectorD *>(infile.Get("sums"));
+  if (!sumnames.empty() &&
+      (!sums || sums->GetNrows() != int(sumnames.size()))) {
+    NUIS_ABORT("Missing scalar sums in " << filename);
+  }
+  for (size_t i = 0; i < sumnames.size(); ++i) {
+    AddSum(sumnames[i], (*sums)[i]);
+  }
+
+  infile.Close();
+}
+
+namespace {
+struct EntryRange {
+  std::string file;
+  Long64_t first;
+  Long64_t last;
+  std::string partname;
+};
+
+// Fills one entry range and writes its partials next to the final part
+// file, renaming only once complete so a killed worker never leaves a part
+// that looks finished.
+class RangeTask : public ParallelUtils::Task {
+public:
+  RangeTask(std::vector<EntryRange> const &ranges, std::string const &treename,
+            EventFiller &filler, TH1D const *templ)
+      : fRanges(ranges), fTreeName(treename), fFiller(filler),
+        fTemplate(templ) {}
+
+  std::vector<double> Run(int itask) {
+    EntryRange const &range = fRanges[itask];
+
+    TFile infile(range.file.c_str(), "READ");
+    TTree *tree = dynamic_cast<TTree *>(infile.Get(fTreeName.c_str()));
+    if (!tree) {
+      NUIS_ABORT("No tree " << fTreeName << " in " << range.file);
+    }
+    fFiller.SetBranchAddresses(tree);
+
+    PartialHists hists(fTemplate);
+    for (Long64_t i = range.first; i < range.last; ++i) {
+      tree->GetEntry(i);
+      fFiller.Fill(hists);
+    }
+
+    std::string tmpname = range.partname + ".tmp";
+    hists.Write(tmpname);
+    if (std::rename(tmpname.c_str(), range.partname.c_str())) {
+      NUIS_ABORT("Cannot move " << tmpname << " to " << range.partname);
+    }
+
+    NUIS_LOG(FIT, "Processed entries " << range.first << "-" << range.last
+                                       << " of " << range.file);
+    return std::vector<double>(1, range.last - range.first);
+  }
+
+private:
+  std::vector<EntryRange> const &fRanges;
+  std::string fTreeName;
+  EventFiller &fFiller;
+  TH1D const *fTemplate;
+};
+} // namespace
+
+//********************************************************************
+PartialHists *FillHistograms(TChain *chain, EventFiller &filler,
+                             TH1D const *templ, int nworkers,
+                             std::string const &workdir, Long64_t maxentries,
+                             Long64_t rangeentries) {
+  //********************************************************************
+  std::string treename = chain->GetName();
+
+  // Part files are only reused for the same input, binning and filler
+  std::string binning =
+      Form("%d_%g_%g", templ->GetNbinsX(), templ->GetXaxis()->GetXmin(),
+           templ->GetXaxis()->GetXmax());
+  std::string options = binning + ";" + filler.GetDescription();
+
+  std::string dir = workdir;
+  bool tempdir = dir.empty();
+  if (tempdir) {
+    char const *tmp = std::getenv("TMPDIR");
+    std::string dirtempl = std::string(tmp ? tmp : "/tmp") + "/nuisprepXXXXXX";
+    std::vector<char> buf(dirtempl.begin(), dirtempl.end());
+    buf.push_back('\0');
+    if (!mkdtemp(&buf[0])) {
+      NUIS_ABORT("Cannot create a temporary directory from " << dirtempl);
+    }
+    dir = &buf[0];
+  } else if (gSystem->AccessPathName(dir.c_str()) &&
+             gSystem->mkdir(dir.c_str(), true)) {
+    NUIS_ABORT("Cannot create work directory " << dir);
+  }
+
+  // Metadata pass, only the tree headers are read
+  std::vector<EntryRange> ranges;
+  Long64_t remaining = maxentries;
+  TObjArray *elements = chain->GetListOfFiles();
+  for (int i = 0; i < elements->GetEntries(); ++i) {
+    std::string file = elements->At(i)->GetTitle();
+
+    TFile infile(file.c_str(), "READ");
+    TTree *tree = dynamic_cast<TTree *>(infile.Get(treename.c_str()));
+    if (!tree) {
+      NUIS_ABORT("No tree " << treename << " in " << file);
+    }
+
+    Long64_t nents = tree->GetEntries();
+    if (maxentries >= 0) {
+      nents = std::min(nents, remaining);
+      remaining -= nents;
+    }
+
+    std::string base = gSystem->BaseName(file.c_str());
+    unsigned hash = TString(file + ";" + options).Hash();
+    for (Long64_t first = 0; first < nents; first += rangeentries) {
+      EntryRange range;
+      range.file = file;
+      range.first = first;
+      range.last = std::min(first + rangeentries, nents);
+      range.partname = dir + "/" + base + Form(".%08x.%lld-%lld.root", hash,
+                                               range.first, range.last);
+      ranges.push_back(range);
+    }
+  }
+
+  // Only fill ranges without a finished part file
+  std::vector<EntryRange> pending;
+  for (size_t i = 0; i < ranges.size(); ++i) {
+    if (gSystem->AccessPathName(ranges[i].partname.c_str())) {
+      pending.push_back(ranges[i]);
+    }
+  }
+  NUIS_LOG(FIT, "Filling " << pending.size() << " of " << ranges.size()
+                           << " entry ranges with " << nworkers
+                           << " worker(s), parts in " << dir);
+
+  RangeTask task(pending, treename, filler, templ);
+  std::vector<std::vector<double> > filled =
+      ParallelUtils::RunTasks(task, pending.size(), nworkers);
+  for (size_t i = 0; i < pending.size(); ++i) {
+    if (filled[i].empty()) {
+      NUIS_ABORT("Failed to fill entries " << pending[i].first << "-"
+                                           << pending[i].last << " of "
+                                           << pending[i].file);
+    }
+  }
+
+  // Merge in range order so the result does not depend on the workers
+  PartialHists *merged = new PartialHists(templ);
+  for (size_t i = 0; i < ranges.size(); ++i) {
+    merged->Read(ranges[i].partname);
+    if (tempdir) {
+      std::remove(ranges[i].partname.c_str());
+    }
+  }
+  if (tempdir) {
+    rmdir(dir.c_str());
+  }
+
+  return merged;
+}
+
+} // namespace PrepareUtils
@@ -0,0 +1,118 @@
+// Copyright 2016-2021 L. Pickering, P Stowell, R. Terri, C. Wilkinson, C. Wret
+
+/*******************************************************************************
+*    This file is part of NUISANCE.
+*
+*    NUISANCE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    NUISANCE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with NUISANCE.  If not, see <http://www.gnu.org/licenses/>.
+*******************************************************************************/
+#ifndef PREPAREUTILS_H_SEEN
+#define PREPAREUTILS_H_SEEN
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "TH1D.h"
+
+class TChain;
+class TTree;
+
+/*!
+ *  \addtogroup Utils
+ *  @{
+ */
+
+/// Shared event loop for the Prepare* input preprocessors.
+///
+/// The entries of every input file are split into fixed size ranges which
+/// are filled by forked workers (ParallelUtils::RunTasks). Each range writes
+/// its partial histograms to a small part file in a work directory and the
+/// parent sums the parts in range order, so the result does not depend on
+/// the number of workers and only one set of partials is held at a time.
+/// Part files that already exist are not refilled, so an interrupted run
+/// given the same work directory resumes where it stopped.
+namespace PrepareUtils {
+
+/// Named histograms, by default with the binning of a template, plus named
+/// scalar sums. Names are kept in the order they were first used.
+class PartialHists {
+public:
+  explicit PartialHists(TH1D const *templ);
+  ~PartialHists();
+
+  /// Histogram called name, created as an empty clone of the template on
+  /// first use. Owned by this object.
+  TH1D *Get(std::string const &name);
+
+  /// As Get, but histograms created here take the binning of templ
+  TH1D *Book(std::string const &name, TH1D const *templ);
+  bool Has(std::string const &name) const;
+  inline std::vector<std::string> const &GetNames() const { return fNames; };
+
+  /// Add val to the scalar sum called name
+  void AddSum(std::string const &name, double val);
+  double GetSum(std::string const &name) const;
+  inline std::vector<std::string> const &GetSumNames() const {
+    return fSumNames;
+  };
+
+  /// Add all histograms and sums of other, new names are appended in the
+  /// order of other.
+  void Add(PartialHists const &other);
+
+  void Write(std::string const &filename) const;
+  void Read(std::string const &filename);
+
+private:
+  TH1D *fTemplate;
+  std::vector<std::string> fNames;
+  std::map<std::string, TH1D *> fHists;
+  std::vector<std::string> fSumNames;
+  std::map<std::string, double> fSums;
+
+  PartialHists(PartialHists const &);
+  PartialHists &operator=(PartialHists const &);
+};
+
+/// Per-generator part of the event loop.
+class EventFiller {
+public:
+  virtual ~EventFiller(){};
+
+  /// Called once for every input tree before its entries are read
+  virtual void SetBranchAddresses(TTree *tree) = 0;
+
+  /// Fill hists from the entry that has just been read
+  virtual void Fill(PartialHists &hists) = 0;
+
+  /// Generator and any options that change what Fill writes. Part files
+  /// are only reused by a filler with the same description.
+  virtual std::string GetDescription() const = 0;
+};
+
+/// Run filler over the first maxentries entries (all if < 0) of every file
+/// in chain using nworkers processes and return the merged histograms.
+/// Part files go to workdir, or to a temporary directory that is removed
+/// afterwards when workdir is empty. Existing part files are reused only for
+/// the same input file, binning and filler description.
+PartialHists *FillHistograms(TChain *chain, EventFiller &filler,
+                             TH1D const *templ, int nworkers = 1,
+                             std::string const &workdir = "",
+                             Long64_t maxentries = -1,
+                             Long64_t rangeentries = 1000000);
+
+} // namespace PrepareUtils
+
+/*! @} */
+#endif
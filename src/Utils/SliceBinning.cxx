@@ -0,0 +1,197 @@
+// Copyright 2016-2021 L. Pickering, P Stowell, R. Terri, C. Wilkinson, C. Wret
+
+/*******************************************************************************
+*    This file is part of NUISANCE.
+*
+*    NUISANCE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    NUISANCE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with NUISANCE.  If not, see <http://www.gnu.org/licenses/>.
+*******************************************************************************/
+#include "SliceBinning.h"
+#include "FitLogger.h"
+
+#include "TH1.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+// Above this many grid cells FindBin falls back to scanning the slices
+const size_t kMaxGridCells = 1 << 20;
+} // namespace
+
+SliceBinning::SliceBinning() : fNDim(0), fOutOfRange(false), fNBins(0) {}
+
+SliceBinning::SliceBinning(int ndim, bool outofrange)
+    : fNDim(ndim), fOutOfRange(outofrange), fNBins(outofrange ? 1 : 0) {
+  if (outofrange) {
+    fWidths.push_back(1.0);
+  }
+}
+
+void SliceBinning::AddSlice(double const *lows, double const *highs, int axis,
+                            std::vector<double> const &edges) {
+  if (axis < 0 || axis >= fNDim) {
+    NUIS_ABORT("SliceBinning: binned axis " << axis << " for slice "
+                                            << fAxes.size() << " outside "
+                                            << fNDim << " variables.");
+  }
+  if (edges.size() < 2) {
+    NUIS_ABORT("SliceBinning: slice " << fAxes.size() << " has no bins.");
+  }
+  for (size_t i = 1; i < edges.size(); ++i) {
+    if (!(edges[i] > edges[i - 1])) {
+      NUIS_ABORT("SliceBinning: slice " << fAxes.size()
+                                        << " edges are not increasing.");
+    }
+  }
+
+  fLows.push_back(std::vector<double>(lows, lows + fNDim));
+  fHighs.push_back(std::vector<double>(highs, highs + fNDim));
+  fAxes.push_back(axis);
+  fEdges.push_back(edges);
+  fOffsets.push_back(fNBins);
+
+  for (size_t i = 1; i < edges.size(); ++i) {
+    fWidths.push_back(edges[i] - edges[i - 1]);
+  }
+  fNBins += edges.size() - 1;
+  fCellSlice.clear();
+}
+
+void SliceBinning::AddSlice(double const *lows, double const *highs, int axis,
+                            TH1 const *hist) {
+  TAxis const *xax = hist->GetXaxis();
+  std::vector<double> edges;
+  for (int i = 0; i <= xax->GetNbins(); ++i) {
+    edges.push_back(xax->GetBinUpEdge(i));
+  }
+  AddSlice(lows, highs, axis, edges);
+}
+
+void SliceBinning::Finalise() {
+  fGridEdges.assign(fNDim, std::vector<double>());
+  fCellSlice.clear();
+
+  size_t ncells = 1;
+  for (int d = 0; d < fNDim; ++d) {
+    std::vector<double> &grid = fGridEdges[d];
+    for (size_t s = 0; s < fAxes.size(); ++s) {
+      if (std::isfinite(fLows[s][d]))
+        grid.push_back(fLows[s][d]);
+      if (std::isfinite(fHighs[s][d]))
+        grid.push_back(fHighs[s][d]);
+    }
+    std::sort(grid.begin(), grid.end());
+    grid.erase(std::unique(grid.begin(), grid.end()), grid.end());
+
+    ncells *= grid.size() + 1;
+    if (ncells > kMaxGridCells) {
+      NUIS_LOG(FIT, "SliceBinning: " << fAxes.size()
+                                     << " slices need too large a lookup "
+                                        "grid, scanning slices instead.");
+      fGridEdges.clear();
+      return;
+    }
+  }
+
+  // Any point strictly inside a cell stands for the whole cell
+  std::vector<double> point(fNDim);
+  std::vector<size_t> cell(fNDim, 0);
+  fCellSlice.resize(ncells);
+  for (size_t icell = 0; icell < ncells; ++icell) {
+    for (int d = 0; d < fNDim; ++d) {
+      std::vector<double> const &grid = fGridEdges[d];
+      size_t k = cell[d];
+      if (grid.empty()) {
+        point[d] = 0.0;
+      } else if (k == 0) {
+        point[d] = grid.front() - 1.0;
+      } else if (k == grid.size()) {
+        point[d] = grid.back() + 1.0;
+      } else {
+        point[d] = 0.5 * (grid[k - 1] + grid[k]);
+      }
+    }
+    fCellSlice[icell] = ScanSlices(&point[0]);
+
+    // Last variable runs fastest, matching the index built in FindBin
+    for (int d = fNDim - 1; d >= 0; --d) {
+      if (++cell[d] <= fGridEdges[d].size())
+        break;
+      cell[d] = 0;
+    }
+  }
+
+  NUIS_LOG(FIT, "SliceBinning: " << fAxes.size() << " slices, " << fNBins
+                                 << " bins, " << ncells << " lookup cells.");
+}
+
+int SliceBinning::ScanSlices(double const *vars) const {
+  for (size_t s = 0; s < fAxes.size(); ++s) {
+    bool inside = true;
+    for (int d = 0; d < fNDim && inside; ++d) {
+      inside = (vars[d] >= fLows[s][d] && vars[d] < fHighs[s][d]);
+    }
+    if (inside)
+      return s;
+  }
+  return -1;
+}
+
+int SliceBinning::FindBin(double const *vars) const {
+  int slice = -1;
+  if (fCellSlice.empty()) {
+    slice = ScanSlices(vars);
+  } else {
+    size_t icell = 0;
+    for (int d = 0; d < fNDim; ++d) {
+      std::vector<double> const &grid = fGridEdges[d];
+      // NaN misses every slice, as it fails every comparison, and so does
+      // +inf, which is never below a slice's upper limit
+      if (std::isnan(vars[d]) || (std::isinf(vars[d]) && vars[d] > 0)) {
+        icell = fCellSlice.size();
+        break;
+      }
+      icell = icell * (grid.size() + 1) +
+              (std::upper_bound(grid.begin(), grid.end(), vars[d]) -
+               grid.begin());
+    }
+    slice = (icell < fCellSlice.size()) ? fCellSlice[icell] : -1;
+  }
+
+  if (slice < 0)
+    return fOutOfRange ? 0 : kNoBin;
+
+  std::vector<double> const &edges = fEdges[slice];
+  double x = vars[fAxes[slice]];
+  if (!(x >= edges.front() && x < edges.back()))
+    return kNoBin;
+
+  return fOffsets[slice] +
+         (std::upper_bound(edges.begin(), edges.end(), x) - edges.begin()) - 1;
+}
+
+void SliceBinning::FillSliceHist(TH1 const *flat, int slice, TH1 *hist) const {
+  int offset = fOffsets[slice];
+  int nbins = GetNSliceBins(slice);
+  if (hist->GetNbinsX() != nbins) {
+    NUIS_ABORT("SliceBinning: slice " << slice << " has " << nbins
+                                      << " bins but histogram "
+                                      << hist->GetName() << " has "
+                                      << hist->GetNbinsX());
+  }
+  for (int i = 0; i < nbins; ++i) {
+    hist->SetBinContent(i + 1, flat->GetBinContent(offset + i + 1));
+    hist->SetBinError(i + 1, flat->GetBinError(offset + i + 1));
+  }
+}
@@ -0,0 +1,112 @@
+// Copyright 2016-2021 L. Pickering, P Stowell, R. Terri, C. Wilkinson, C. Wret
+
+/*******************************************************************************
+*    This file is part of NUISANCE.
+*
+*    NUISANCE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    NUISANCE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with NUISANCE.  If not, see <http://www.gnu.org/licenses/>.
+*******************************************************************************/
+#ifndef SLICEBINNING_H_SEEN
+#define SLICEBINNING_H_SEEN
+
+#include <vector>
+
+class TH1;
+
+/*!
+ *  \addtogroup Utils
+ *  @{
+ */
+
+/// Irregular N-dimensional binning for multi-differential releases, built
+/// from an ordered list of slices. Each slice is a box [low, high) in the
+/// event variables, binned along one of them. Slices are matched in the
+/// order they were added and the first match wins, like the if-chains they
+/// replace.
+///
+/// Slice bins are numbered globally in slice order, after an optional
+/// out-of-range bin 0 for events outside every slice, so a flat histogram
+/// with global bin i in ROOT bin i+1 lines up with the release covariance.
+/// Events inside a slice box but outside its bin edges get no bin, in the
+/// same way a TH1 fill would put them in the under/overflow.
+class SliceBinning {
+public:
+  /// Returned by FindBin when an event has no bin.
+  static const int kNoBin = -1;
+
+  SliceBinning();
+
+  /// Binning over ndim variables. If outofrange is set, global bin 0 holds
+  /// every event that misses all of the slices.
+  SliceBinning(int ndim, bool outofrange);
+
+  /// Add a slice covering lows[i] <= var[i] < highs[i] for each of the ndim
+  /// variables, binned along var[axis] with edges. Use +/-inf for limits
+  /// that are not cut on.
+  void AddSlice(double const *lows, double const *highs, int axis,
+                std::vector<double> const &edges);
+
+  /// As above, taking the edges from a release slice histogram.
+  void AddSlice(double const *lows, double const *highs, int axis,
+                TH1 const *hist);
+
+  /// Build the lookup table, call once after the last AddSlice.
+  void Finalise();
+
+  /// Global bin of an event with variables vars[ndim], or kNoBin.
+  int FindBin(double const *vars) const;
+
+  /// Ordered scan of the slice boxes, first match or -1. FindBin gives the
+  /// same slice from its lookup grid.
+  int ScanSlices(double const *vars) const;
+
+  /// Number of global bins including any out-of-range bin.
+  int GetNBins() const { return fNBins; };
+
+  int GetNSlices() const { return fAxes.size(); };
+
+  /// Global bin of the first bin of a slice
+  int GetSliceOffset(int slice) const { return fOffsets[slice]; };
+
+  int GetNSliceBins(int slice) const { return fEdges[slice].size() - 1; };
+
+  /// Width of a global bin along its slice's binned variable, 1 for the
+  /// out-of-range bin.
+  double GetBinWidth(int bin) const { return fWidths[bin]; };
+
+  /// Copy one slice out of a flat histogram (global bin i in ROOT bin i+1)
+  /// into a histogram with the slice binning, contents and errors.
+  void FillSliceHist(TH1 const *flat, int slice, TH1 *hist) const;
+
+private:
+  int fNDim;
+  bool fOutOfRange;
+  int fNBins;
+
+  // Slice definitions
+  std::vector<std::vector<double> > fLows;
+  std::vector<std::vector<double> > fHighs;
+  std::vector<int> fAxes;
+  std::vector<std::vector<double> > fEdges;
+  std::vector<int> fOffsets;
+  std::vector<double> fWidths;
+
+  // Rectilinear grid over every finite slice limit in each variable. Each
+  // cell lies entirely inside or outside each box, so it maps to a single
+  // slice (or -1), found once in Finalise.
+  std::vector<std::vector<double> > fGridEdges;
+  std::vector<int> fCellSlice;
+};
+
+/*! @} */
+#endif
@@ -0,0 +1,300 @@
+// Copyright 2016-2021 L. Pickering, P Stowell, R. Terri, C. Wilkinson, C. Wret
+
+/*******************************************************************************
+*    This file is part of NUISANCE.
+*
+*    NUISANCE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    NUISANCE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with NUISANCE.  If not, see <http://www.gnu.org/licenses/>.
+*******************************************************************************/
+#include "TimingUtils.h"
+
+#include "FitLogger.h"
+
+#include "TDirectory.h"
+#include "TTree.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <mutex>
+
+namespace TimingUtils {
+
+namespace {
+struct TimerEntry {
+  int category;
+  std::string owner;
+  long calls;
+  double total;
+  double min;
+  double max;
+};
+
+bool gTimingEnabled = false;
+
+// Registrations and merged totals, guarded by gTimerMutex.
+std::mutex gTimerMutex;
+std::vector<TimerEntry> gTimers;
+std::map<std::pair<int, std::string>, int> gTimerIndex;
+
+void ResetEntry(TimerEntry &entry) {
+  entry.calls = 0;
+  entry.total = 0.0;
+  entry.min = std::numeric_limits<double>::max();
+  entry.max = 0.0;
+}
+
+void MergeEntry(TimerEntry &entry, TimerEntry const &other) {
+  entry.calls += other.calls;
+  entry.total += other.total;
+  entry.min = std::min(entry.min, other.min);
+  entry.max = std::max(entry.max, other.max);
+}
+
+// Times added by one thread, indexed by timer handle. AddTime only touches
+// these, and they are merged into gTimers when the thread exits or when it
+// asks for a report, so the hot path takes no lock.
+struct ThreadTimers {
+  std::vector<TimerEntry> entries;
+
+  ~ThreadTimers() { Merge(); };
+
+  void Merge() {
+    std::lock_guard<std::mutex> lock(gTimerMutex);
+    for (size_t i = 0; i < entries.size(); i++) {
+      if (entries[i].calls) {
+        MergeEntry(gTimers[i], entries[i]);
+        ResetEntry(entries[i]);
+      }
+    }
+  };
+};
+
+thread_local ThreadTimers gThreadTimers;
+
+// Copy of the merged timers including this thread's pending times.
+std::vector<TimerEntry> GetMergedTimers() {
+  gThreadTimers.Merge();
+  std::lock_guard<std::mutex> lock(gTimerMutex);
+  return gTimers;
+}
+
+// Sort by category then by descending total time
+bool CompareEntries(TimerEntry const &a, TimerEntry const &b) {
+  if (a.category != b.category)
+    return a.category < b.category;
+  return a.total > b.total;
+}
+
+std::string EscapeJSON(std::string const &str) {
+  std::string out;
+  for (size_t i = 0; i < str.size(); i++) {
+    if (str[i] == '"' || str[i] == '\\')
+      out += '\\';
+    out += str[i];
+  }
+  return out;
+}
+} // namespace
+
+void SetEnabled(bool enabled) { gTimingEnabled = enabled; }
+
+bool IsEnabled() { return gTimingEnabled; }
+
+std::string CategoryName(int category) {
+  switch (category) {
+  case kInputRead:
+    return "InputRead";
+  case kKinematics:
+    return "Kinematics";
+  case kWeightCalc:
+    return "WeightCalc";
+  case kIsSignal:
+    return "IsSignal";
+  case kHistFill:
+    return "HistFill";
+  case kConvertEventRates:
+    return "ConvertEventRates";
+  case kLikelihood:
+    return "Likelihood";
+  case kReconfigure:
+    return "Reconfigure";
+  default:
+    return "Unknown";
+  }
+}
+
+int RegisterTimer(int category, std::string const &owner) {
+  if (!gTimingEnabled)
+    return kNoTimer;
+
+  std::lock_guard<std::mutex> lock(gTimerMutex);
+  std::pair<int, std::string> key(category, owner);
+  std::map<std::pair<int, std::string>, int>::iterator it =
+      gTimerIndex.find(key);
+  if (it != gTimerIndex.end())
+    return it->second;
+
+  TimerEntry entry;
+  entry.category = category;
+  entry.owner = owner;
+  ResetEntry(entry);
+
+  int id = gTimers.size();
+  gTimers.push_back(entry);
+  gTimerIndex[key] = id;
+  return id;
+}
+
+void AddTime(int id, double seconds) {
+  std::vector<TimerEntry> &entries = gThreadTimers.entries;
+  if (id >= int(entries.size())) {
+    TimerEntry empty;
+    ResetEntry(empty);
+    entries.resize(id + 1, empty);
+  }
+
+  TimerEntry &entry = entries[id];
+  entry.calls++;
+  entry.total += seconds;
+  if (seconds < entry.min)
+    entry.min = seconds;
+  if (seconds > entry.max)
+    entry.max = seconds;
+}
+
+void Reset() {
+  for (size_t i = 0; i < gThreadTimers.entries.size(); i++) {
+    ResetEntry(gThreadTimers.entries[i]);
+  }
+
+  std::lock_guard<std::mutex> lock(gTimerMutex);
+  for (size_t i = 0; i < gTimers.size(); i++) {
+    ResetEntry(gTimers[i]);
+  }
+}
+
+void PrintSummary() {
+  std::vector<TimerEntry> sorted = GetMergedTimers();
+  if (sorted.empty())
+    return;
+
+  std::sort(sorted.begin(), sorted.end(), CompareEntries);
+
+  size_t ownerwidth = 10;
+  for (size_t i = 0; i < sorted.size(); i++) {
+    ownerwidth = std::max(ownerwidth, sorted[i].owner.size());
+  }
+
+  NUIS_LOG(FIT, "------------");
+  NUIS_LOG(FIT, "Timing Report");
+  NUIS_LOG(FIT, std::left << std::setw(18) << "Category" << " "
+                          << std::setw(ownerwidth) << "Owner" << " "
+                          << std::right << std::setw(12) << "Calls"
+                          << std::setw(14) << "Total [s]" << std::setw(14)
+                          << "Mean [us]" << std::setw(14) << "Max [us]");
+
+  for (size_t i = 0; i < sorted.size(); i++) {
+    TimerEntry const &entry = sorted[i];
+    if (!entry.calls)
+      continue;
+    double mean = entry.total / double(entry.calls);
+    NUIS_LOG(FIT, std::left << std::setw(18) << CategoryName(entry.category)
+                            << " " << std::setw(ownerwidth) << entry.owner
+                            << " " << std::right << std::setw(12)
+                            << entry.calls << std::setw(14) << std::fixed
+                            << std::setprecision(3) << entry.total
+                            << std::setw(14) << std::setprecision(2)
+                            << mean * 1E6 << std::setw(14) << entry.max * 1E6);
+  }
+  NUIS_LOG(FIT, "------------");
+}
+
+void WriteJSON(std::string const &filename) {
+  std::vector<TimerEntry> timers = GetMergedTimers();
+
+  std::ofstream out(filename.c_str());
+  if (!out.good()) {
+    NUIS_ERR(WRN, "Cannot open timing report file " << filename);
+    return;
+  }
+
+  out << "[" << std::endl;
+  bool first = true;
+  for (size_t i = 0; i < timers.size(); i++) {
+    TimerEntry const &entry = timers[i];
+    if (!entry.calls)
+      continue;
+
+    if (!first)
+      out << "," << std::endl;
+    first = false;
+
+    out << std::setprecision(9) << "  {\"category\": \""
+        << CategoryName(entry.category) << "\", \"owner\": \""
+        << EscapeJSON(entry.owner) << "\", \"calls\": " << entry.calls
+        << ", \"total_s\": " << entry.total
+        << ", \"mean_s\": " << entry.total / double(entry.calls)
+        << ", \"min_s\": " << entry.min << ", \"max_s\": " << entry.max
+        << "}";
+  }
+  out << std::endl << "]" << std::endl;
+
+  NUIS_LOG(FIT, "Saved timing report to " << filename);
+}
+
+void WriteTree(TDirectory *dir) {
+  std::vector<TimerEntry> timers = GetMergedTimers();
+  if (!dir || timers.empty())
+    return;
+
+  TDirectory *curdir = gDirectory;
+  dir->cd();
+
+  std::string category;
+  std::string owner;
+  Long64_t calls;
+  double total, mean, min, max;
+
+  TTree *tree = new TTree("timing_summary", "timing_summary");
+  tree->Branch("category", &category);
+  tree->Branch("owner", &owner);
+  tree->Branch("calls", &calls, "calls/L");
+  tree->Branch("total", &total, "total/D");
+  tree->Branch("mean", &mean, "mean/D");
+  tree->Branch("min", &min, "min/D");
+  tree->Branch("max", &max, "max/D");
+
+  for (size_t i = 0; i < timers.size(); i++) {
+    TimerEntry const &entry = timers[i];
+    if (!entry.calls)
+      continue;
+
+    category = CategoryName(entry.category);
+    owner = entry.owner;
+    calls = entry.calls;
+    total = entry.total;
+    mean = entry.total / double(entry.calls);
+    min = entry.min;
+    max = entry.max;
+    tree->Fill();
+  }
+
+  tree->Write();
+  delete tree;
+  curdir->cd();
+}
+
+} // namespace TimingUtils
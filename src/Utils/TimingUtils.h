@@ -0,0 +1,140 @@
+// Copyright 2016-2021 L. Pickering, P Stowell, R. Terri, C. Wilkinson, C. Wret
+
+/*******************************************************************************
+*    This file is part of NUISANCE.
+*
+*    NUISANCE is free software: you can redistribute it and/or modify
+*    it under the terms of the GNU General Public License as published by
+*    the Free Software Foundation, either version 3 of the License, or
+*    (at your option) any later version.
+*
+*    NUISANCE is distributed in the hope that it will be useful,
+*    but WITHOUT ANY WARRANTY; without even the implied warranty of
+*    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*    GNU General Public License for more details.
+*
+*    You should have received a copy of the GNU General Public License
+*    along with NUISANCE.  If not, see <http://www.gnu.org/licenses/>.
+*******************************************************************************/
+#ifndef TIMINGUTILS_H_SEEN
+#define TIMINGUTILS_H_SEEN
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+class TDirectory;
+
+/*!
+ *  \addtogroup Utils
+ *  @{
+ */
+
+/// Lightweight hot-path instrumentation. Timers are registered once per
+/// (category, owner) pair and then accumulated through integer handles so
+/// the per-event cost is a clock read and an add. Times are accumulated per
+/// thread and merged when the thread exits or a report is made. When the
+/// timing report is disabled (config TimingReport=0) no timers are
+/// registered and every ScopedTimer is a no-op.
+namespace TimingUtils {
+
+/// Stages of the reconfigure loop that are timed separately.
+enum TimerCategory {
+  kInputRead = 0,     ///< InputHandler event read (includes conversion)
+  kKinematics,        ///< Generator -> FitEvent kinematics conversion
+  kWeightCalc,        ///< WeightEngine CalcWeight calls
+  kIsSignal,          ///< Measurement signal definition + variable filling
+  kHistFill,          ///< Measurement histogram filling
+  kConvertEventRates, ///< Measurement scaling to cross-section
+  kLikelihood,        ///< Measurement/pull likelihood evaluation
+  kReconfigure,       ///< Full JointFCN reconfigure
+  kNTimerCategories
+};
+
+/// Handle returned for timers when reporting is switched off.
+const int kNoTimer = -1;
+
+/// Enable or disable timer registration. Call before the first reconfigure.
+void SetEnabled(bool enabled);
+
+/// Return whether timers are being registered and accumulated.
+bool IsEnabled();
+
+/// Human readable name of a timer category
+std::string CategoryName(int category);
+
+/// Register (or look up) the timer for a category/owner pair. Returns
+/// kNoTimer if timing is disabled. Takes a lock, so cache the handle.
+int RegisterTimer(int category, std::string const &owner);
+
+/// Add a single timed call to the given timer handle for this thread
+void AddTime(int id, double seconds);
+
+/// Wall clock time in seconds with sub-microsecond resolution.
+inline double GetTime() {
+  return std::chrono::duration<double>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+/// Reset all accumulated timers but keep registrations
+void Reset();
+
+/// Print the accumulated timers as a table grouped by category
+void PrintSummary();
+
+/// Save timers as a JSON list of {category, owner, calls, total_s, ...}
+void WriteJSON(std::string const &filename);
+
+/// Save timers as a TTree "timing_summary" in the given directory
+void WriteTree(TDirectory *dir);
+
+/// Helper that caches one timer handle per category for a single owner.
+/// The owner name is read through a pointer on first use, so it can point
+/// at a name member that is only filled after construction.
+class TimerSet {
+public:
+  TimerSet() : fOwner(NULL) {
+    for (int i = 0; i < kNTimerCategories; i++)
+      fIDs[i] = kUnregistered;
+  };
+
+  /// Set the name used when the timers are first registered.
+  void SetOwner(std::string const *owner) { fOwner = owner; };
+
+  /// Return the handle for a category, registering it on first call.
+  inline int ID(int category) {
+    if (fIDs[category] == kUnregistered) {
+      fIDs[category] =
+          RegisterTimer(category, fOwner ? *fOwner : std::string("unknown"));
+    }
+    return fIDs[category];
+  };
+
+private:
+  static const int kUnregistered = -2;
+  std::string const *fOwner;
+  int fIDs[kNTimerCategories];
+};
+
+/// Times the enclosing scope and adds it to the given timer handle.
+class ScopedTimer {
+public:
+  explicit ScopedTimer(int id) : fID(id), fStart(0.0) {
+    if (fID != kNoTimer)
+      fStart = GetTime();
+  };
+  ~ScopedTimer() {
+    if (fID != kNoTimer)
+      AddTime(fID, GetTime() - fStart);
+  };
+
+private:
+  int fID;
+  double fStart;
+};
+
+} // namespace TimingUtils
+
+/*! @} */
+#endif